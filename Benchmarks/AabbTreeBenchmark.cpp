@@ -0,0 +1,61 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+#include "SurgSim/DataStructures/AabbTree.h"
+#include "SurgSim/Framework/ApplicationData.h"
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/Quaternion.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/Vector.h"
+
+namespace
+{
+
+/// The broad phase of the mesh/mesh contact calculation alone, the spatial join of the AabbTrees of a triangle mesh and
+/// of a copy of it, slightly rotated around the center of its bounding box so that the two overlap everywhere.
+/// \param state The benchmark state
+/// \param fileName The mesh, in the Geometry directory of the test data
+void AabbTreeSpatialJoin(benchmark::State& state, const std::string& fileName)
+{
+	SurgSim::Framework::ApplicationData data("config.txt");
+	auto mesh = std::make_shared<SurgSim::Math::MeshShape>();
+	mesh->load("Geometry/" + fileName, data);
+	const SurgSim::Math::Vector3d center = mesh->getBoundingBox().center();
+	const SurgSim::Math::RigidTransform3d rotation = SurgSim::Math::makeRigidTranslation(center) *
+			SurgSim::Math::makeRigidTransform(SurgSim::Math::makeRotationQuaternion(0.1,
+					SurgSim::Math::Vector3d(1.0, 1.0, 1.0).normalized()), SurgSim::Math::Vector3d::Zero()) *
+			SurgSim::Math::makeRigidTranslation(-center);
+	auto other = std::dynamic_pointer_cast<SurgSim::Math::MeshShape>(mesh->getTransformed(rotation));
+	SURGSIM_ASSERT(other != nullptr) << "The transformed mesh is not a MeshShape.";
+
+	size_t numPairs = 0;
+	for (auto _ : state)
+	{
+		numPairs = mesh->getAabbTree()->spatialJoin(*other->getAabbTree()).size();
+	}
+	state.counters["Triangles"] = static_cast<double>(mesh->getNumTriangles());
+	state.counters["Pairs"] = static_cast<double>(numPairs);
+}
+
+}
+
+BENCHMARK_CAPTURE(AabbTreeSpatialJoin, Sphere, std::string("sphere.ply"));
+BENCHMARK_CAPTURE(AabbTreeSpatialJoin, Staple, std::string("staple_collision.ply"));
+BENCHMARK_CAPTURE(AabbTreeSpatialJoin, Arm, std::string("arm_collision.ply"));
@@ -0,0 +1,96 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SurgSim/Collision/CollisionPair.h"
+#include "SurgSim/Collision/ShapeCollisionRepresentation.h"
+#include "SurgSim/Framework/BasicSceneElement.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Framework/Scene.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/Vector.h"
+#include "SurgSim/Physics/DcdCollision.h"
+#include "SurgSim/Physics/PhysicsManagerState.h"
+#include "SurgSim/Physics/PrepareCollisionPairs.h"
+
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+
+/// Radius of the Geometry/sphere.ply mesh
+const double radius = 0.05;
+
+/// The discrete contact calculation alone, on the collision pairs prepared once for a row of N triangle meshes of
+/// spheres, each overlapping its neighbors. The shapes are posed once, as done by UpdateCollisionData and
+/// UpdateDcdData. The contacts are cleared before each update, outside of the timings, so that every update
+/// calculates all of them.
+/// \param state The benchmark state, its range(0) is the number of meshes
+void DcdCollisionUpdate(benchmark::State& state)
+{
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+	const size_t numMeshes = static_cast<size_t>(state.range(0));
+	std::vector<std::shared_ptr<SurgSim::Collision::Representation>> representations;
+	for (size_t i = 0; i < numMeshes; ++i)
+	{
+		auto mesh = std::make_shared<SurgSim::Math::MeshShape>();
+		mesh->load("Geometry/sphere.ply");
+		auto collision = std::make_shared<SurgSim::Collision::ShapeCollisionRepresentation>("Collision");
+		collision->setShape(mesh);
+
+		auto element = std::make_shared<SurgSim::Framework::BasicSceneElement>("Mesh" + std::to_string(i));
+		element->setPose(SurgSim::Math::makeRigidTranslation(Vector3d(1.5 * radius * i, 0.0, 0.0)));
+		element->addComponent(collision);
+		runtime->getScene()->addSceneElement(element);
+		collision->updateShapeData();
+		collision->updateDcdData();
+		representations.push_back(collision);
+	}
+
+	auto initialState = std::make_shared<SurgSim::Physics::PhysicsManagerState>();
+	initialState->setCollisionRepresentations(representations);
+	auto prepareCollisionPairs = std::make_shared<SurgSim::Physics::PrepareCollisionPairs>();
+	const auto preparedState = prepareCollisionPairs->update(1e-3, initialState);
+	auto dcdCollision = std::make_shared<SurgSim::Physics::DcdCollision>();
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		for (const auto& pair : preparedState->getCollisionPairs())
+		{
+			pair->clearContacts();
+		}
+		state.ResumeTiming();
+
+		dcdCollision->update(1e-3, preparedState);
+	}
+
+	size_t numContacts = 0;
+	for (const auto& pair : preparedState->getCollisionPairs())
+	{
+		numContacts += pair->getContacts().size();
+	}
+	state.counters["Pairs"] = static_cast<double>(preparedState->getCollisionPairs().size());
+	state.counters["Contacts"] = static_cast<double>(numContacts);
+}
+
+}
+
+BENCHMARK(DcdCollisionUpdate)->RangeMultiplier(4)->Range(2, 32)->UseRealTime();
@@ -0,0 +1,246 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+
+#include "Benchmarks/PhysicsScene.h"
+#include "SurgSim/DataStructures/TriangleMesh.h"
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Framework/BasicSceneElement.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Framework/Scene.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/OdeEquation.h"
+#include "SurgSim/Math/OdeState.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/SphereShape.h"
+#include "SurgSim/Math/Vector.h"
+#include "SurgSim/Physics/DeformableCollisionRepresentation.h"
+#include "SurgSim/Physics/Fem3DElementTetrahedron.h"
+#include "SurgSim/Physics/Fem3DRepresentation.h"
+#include "SurgSim/Physics/PhysicsManager.h"
+#include "SurgSim/Physics/RigidCollisionRepresentation.h"
+#include "SurgSim/Physics/RigidRepresentation.h"
+
+using SurgSim::DataStructures::TriangleMeshPlain;
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+
+/// Edge length (in m) of the cube
+const double cubeSize = 0.1;
+
+/// Number of tetrahedra each cell of the cube is split into
+const size_t tetrahedraPerCell = 6;
+
+/// \return The number of cells per axis of a cube of numTetrahedra tetrahedra
+size_t getNumCellsPerAxis(size_t numTetrahedra)
+{
+	const size_t n = static_cast<size_t>(std::round(std::cbrt(numTetrahedra / tetrahedraPerCell)));
+	SURGSIM_ASSERT(tetrahedraPerCell * n * n * n == numTetrahedra)
+		<< "The number of tetrahedra has to be 6 n^3, for n cells per axis.";
+	return n;
+}
+
+/// Indexes the nodes of a grid of (n + 1)^3 nodes
+size_t nodeIndex(size_t n, const std::array<size_t, 3>& ijk)
+{
+	return (ijk[0] * (n + 1) + ijk[1]) * (n + 1) + ijk[2];
+}
+
+/// A rigid sphere resting on the top of the cube
+std::shared_ptr<SurgSim::Framework::SceneElement> makeSphere()
+{
+	const double radius = 0.25 * cubeSize;
+	auto element = std::make_shared<SurgSim::Framework::BasicSceneElement>("Sphere");
+	element->setPose(SurgSim::Math::makeRigidTranslation(Vector3d(0.0, cubeSize + radius, 0.0)));
+
+	auto physics = std::make_shared<SurgSim::Physics::RigidRepresentation>("Physics");
+	physics->setDensity(5000.0);
+	physics->setShape(std::make_shared<SurgSim::Math::SphereShape>(radius));
+	element->addComponent(physics);
+
+	auto collision = std::make_shared<SurgSim::Physics::RigidCollisionRepresentation>("Collision");
+	physics->setCollisionRepresentation(collision);
+	element->addComponent(collision);
+
+	return element;
+}
+
+/// Builds a cube of n^3 cells on the XZ plane, with its bottom nodes fixed, each cell being split into 6 tetrahedra
+/// around its diagonal (Kuhn triangulation, conforming across the cells). The collision mesh has all the nodes as
+/// vertices, as required by the DeformableCollisionRepresentation, and the boundary faces of the cube as triangles.
+std::shared_ptr<SurgSim::Framework::SceneElement> makeCube(size_t n)
+{
+	auto element = std::make_shared<SurgSim::Framework::BasicSceneElement>("Cube");
+
+	auto physics = std::make_shared<SurgSim::Physics::Fem3DRepresentation>("Physics");
+	physics->setIntegrationScheme(SurgSim::Math::INTEGRATIONSCHEME_EULER_IMPLICIT);
+	physics->setRayleighDampingMass(1.0);
+
+	const double h = cubeSize / static_cast<double>(n);
+	const Vector3d origin(-0.5 * cubeSize, 0.0, -0.5 * cubeSize);
+	auto mesh = std::make_shared<TriangleMeshPlain>();
+	auto state = std::make_shared<SurgSim::Math::OdeState>();
+	state->setNumDof(physics->getNumDofPerNode(), (n + 1) * (n + 1) * (n + 1));
+	std::array<size_t, 3> ijk;
+	for (ijk[0] = 0; ijk[0] <= n; ++ijk[0])
+	{
+		for (ijk[1] = 0; ijk[1] <= n; ++ijk[1])
+		{
+			for (ijk[2] = 0; ijk[2] <= n; ++ijk[2])
+			{
+				const Vector3d position = origin + h * Vector3d(static_cast<double>(ijk[0]),
+										  static_cast<double>(ijk[1]), static_cast<double>(ijk[2]));
+				SurgSim::Math::setSubVector(position, nodeIndex(n, ijk), 3, &state->getPositions());
+				if (ijk[1] == 0)
+				{
+					state->addBoundaryCondition(nodeIndex(n, ijk));
+				}
+				mesh->addVertex(TriangleMeshPlain::VertexType(position));
+			}
+		}
+	}
+	physics->setInitialState(state);
+
+	std::array<size_t, 3> axes = {{0, 1, 2}};
+	for (ijk[0] = 0; ijk[0] < n; ++ijk[0])
+	{
+		for (ijk[1] = 0; ijk[1] < n; ++ijk[1])
+		{
+			for (ijk[2] = 0; ijk[2] < n; ++ijk[2])
+			{
+				// One tetrahedron per path from the cell's first corner to its opposite corner along the axes
+				std::sort(axes.begin(), axes.end());
+				do
+				{
+					std::array<size_t, 3> corner = ijk;
+					std::array<size_t, 4> nodeIds;
+					nodeIds[0] = nodeIndex(n, corner);
+					for (size_t step = 0; step < 3; ++step)
+					{
+						++corner[axes[step]];
+						nodeIds[step + 1] = nodeIndex(n, corner);
+					}
+					auto node = [&state](size_t id) -> Vector3d
+					{
+						return SurgSim::Math::getSubVector(state->getPositions(), id, 3);
+					};
+					if ((node(nodeIds[1]) - node(nodeIds[0])).cross(node(nodeIds[2]) - node(nodeIds[0])).dot(
+							node(nodeIds[3]) - node(nodeIds[0])) < 0.0)
+					{
+						std::swap(nodeIds[2], nodeIds[3]);
+					}
+					auto tetrahedron = std::make_shared<SurgSim::Physics::Fem3DElementTetrahedron>(nodeIds);
+					tetrahedron->setMassDensity(1000.0);
+					tetrahedron->setPoissonRatio(0.45);
+					tetrahedron->setYoungModulus(1.0e5);
+					physics->addFemElement(tetrahedron);
+				}
+				while (std::next_permutation(axes.begin(), axes.end()));
+			}
+		}
+	}
+
+	// Boundary faces, facing outward: on the face normal to the axis a, (b, c) follows a in the direct order
+	for (size_t a = 0; a < 3; ++a)
+	{
+		const size_t b = (a + 1) % 3;
+		const size_t c = (a + 2) % 3;
+		for (size_t side = 0; side <= n; side += n)
+		{
+			for (size_t u = 0; u < n; ++u)
+			{
+				for (size_t v = 0; v < n; ++v)
+				{
+					std::array<size_t, 3> corner;
+					corner[a] = side;
+					corner[b] = u;
+					corner[c] = v;
+					const size_t p00 = nodeIndex(n, corner);
+					++corner[b];
+					const size_t p10 = nodeIndex(n, corner);
+					++corner[c];
+					const size_t p11 = nodeIndex(n, corner);
+					--corner[b];
+					const size_t p01 = nodeIndex(n, corner);
+					std::array<size_t, 3> first = {{p00, p10, p11}};
+					std::array<size_t, 3> second = {{p00, p11, p01}};
+					if (side == 0)
+					{
+						std::swap(first[1], first[2]);
+						std::swap(second[1], second[2]);
+					}
+					mesh->addTriangle(TriangleMeshPlain::TriangleType(first));
+					mesh->addTriangle(TriangleMeshPlain::TriangleType(second));
+				}
+			}
+		}
+	}
+	element->addComponent(physics);
+
+	auto collision = std::make_shared<SurgSim::Physics::DeformableCollisionRepresentation>("Collision");
+	collision->setShape(std::make_shared<SurgSim::Math::MeshShape>(*mesh));
+	physics->setCollisionRepresentation(collision);
+	element->addComponent(collision);
+
+	return element;
+}
+
+/// A soft cube of M tetrahedra, fixed at its bottom, deformed by a rigid sphere resting on it, using the discrete
+/// collision detection pipeline.
+/// The implicit integration assembles and solves the whole FEM system at each update.
+/// \param state The benchmark state, its range(0) is the number of tetrahedra, 6 n^3 for n cells per axis
+void Fem3DCube(benchmark::State& state)
+{
+	const size_t numTetrahedra = static_cast<size_t>(state.range(0));
+
+	SurgSim::Benchmarks::PhysicsScene scene(1000.0, SurgSim::Physics::createDcdPipeline());
+	scene.addSceneElement(makeCube(getNumCellsPerAxis(numTetrahedra)));
+	scene.addSceneElement(makeSphere());
+
+	scene.run(state);
+	state.counters["Tetrahedra"] = static_cast<double>(numTetrahedra);
+}
+
+/// The assembly of the forces, mass, damping and stiffness of the cube of Fem3DCube, at rest, alone.
+/// \param state The benchmark state, its range(0) is the number of tetrahedra, 6 n^3 for n cells per axis
+void Fem3DCubeUpdateFMDK(benchmark::State& state)
+{
+	const size_t numTetrahedra = static_cast<size_t>(state.range(0));
+
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+	auto element = makeCube(getNumCellsPerAxis(numTetrahedra));
+	runtime->getScene()->addSceneElement(element);
+	auto physics = element->getComponents<SurgSim::Physics::Fem3DRepresentation>().front();
+	SURGSIM_ASSERT(physics->wakeUp()) << "The cube could not be woken up.";
+
+	const SurgSim::Math::OdeState& rest = *physics->getCurrentState();
+	for (auto _ : state)
+	{
+		physics->updateFMDK(rest, SurgSim::Math::ODEEQUATIONUPDATE_FMDK);
+	}
+	state.counters["Tetrahedra"] = static_cast<double>(numTetrahedra);
+}
+
+}
+
+BENCHMARK(Fem3DCube)->Arg(48)->Arg(384)->Arg(1296)->Arg(3072)->Iterations(500)->UseRealTime();
+BENCHMARK(Fem3DCubeUpdateFMDK)->Arg(48)->Arg(384)->Arg(1296)->Arg(3072);
@@ -0,0 +1,91 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+#include "SurgSim/Framework/ApplicationData.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/Vector.h"
+
+namespace
+{
+
+/// Loads the mesh of a sphere of 642 vertices and 1280 triangles
+std::shared_ptr<SurgSim::Math::MeshShape> loadSphere()
+{
+	SurgSim::Framework::ApplicationData data("config.txt");
+	auto mesh = std::make_shared<SurgSim::Math::MeshShape>();
+	mesh->load("Geometry/sphere.ply", data);
+	return mesh;
+}
+
+/// Moves a percentage of the vertices of a mesh, spread over the mesh, and returns their ids
+std::vector<size_t> moveVertices(size_t percentage, double offset, SurgSim::Math::MeshShape* mesh)
+{
+	std::vector<size_t> moved;
+	for (size_t id = 0; id < mesh->getNumVertices(); ++id)
+	{
+		if ((id * percentage) % 100 < percentage)
+		{
+			mesh->setVertexPosition(id, mesh->getVertexPosition(id) + SurgSim::Math::Vector3d::Constant(offset));
+			moved.push_back(id);
+		}
+	}
+	return moved;
+}
+
+/// Refits the AabbTree and the normals of a mesh after some of its vertices moved, as done by the
+/// DeformableCollisionRepresentation for each update of its deformable.
+/// \param state The benchmark state, its range(0) is the percentage of moved vertices
+void MeshShapeUpdateMovedVertices(benchmark::State& state)
+{
+	auto mesh = loadSphere();
+	const size_t percentage = static_cast<size_t>(state.range(0));
+	double offset = 1e-4;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		offset = -offset;
+		const std::vector<size_t> moved = moveVertices(percentage, offset, mesh.get());
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(mesh->updateMovedVertices(moved));
+	}
+	state.counters["Vertices"] = static_cast<double>(mesh->getNumVertices());
+}
+
+/// Refits the whole AabbTree and all the normals of a mesh, the reference for MeshShapeUpdateMovedVertices
+void MeshShapeUpdateShapePartial(benchmark::State& state)
+{
+	auto mesh = loadSphere();
+	double offset = 1e-4;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		offset = -offset;
+		moveVertices(100, offset, mesh.get());
+		state.ResumeTiming();
+
+		mesh->updateShapePartial();
+	}
+	state.counters["Vertices"] = static_cast<double>(mesh->getNumVertices());
+}
+
+}
+
+BENCHMARK(MeshShapeUpdateMovedVertices)->Arg(1)->Arg(2)->Arg(5)->Arg(10)->Arg(25)->Arg(100);
+BENCHMARK(MeshShapeUpdateShapePartial);
@@ -0,0 +1,53 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <string>
+
+#include "SurgSim/Framework/ApplicationData.h"
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Math/MlcpGaussSeidelSolver.h"
+#include "SurgSim/Math/MlcpSolution.h"
+#include "SurgSim/Testing/MlcpIO/MlcpTestData.h"
+#include "SurgSim/Testing/MlcpIO/ReadText.h"
+
+namespace
+{
+
+/// The Gauss-Seidel solver alone, on the MLCP problems recorded for its unit tests (MlcpTestData/mlcpTest<N>.txt),
+/// with the same settings as these tests.
+/// \param state The benchmark state, its range(0) is the index of the problem
+void MlcpGaussSeidelSolverSolve(benchmark::State& state)
+{
+	SurgSim::Framework::ApplicationData data("config.txt");
+	const std::string fileName = getTestFileName("mlcpTest", static_cast<int>(state.range(0)), ".txt");
+	MlcpTestData test;
+	SURGSIM_ASSERT(readMlcpTestDataAsText(data.findFile("MlcpTestData/" + fileName), &test))
+		<< "Failed to load " << fileName;
+
+	SurgSim::Math::MlcpGaussSeidelSolver solver(1e-9, 1e-9, 100);
+	SurgSim::Math::MlcpSolution solution;
+	for (auto _ : state)
+	{
+		solution.x.setZero(test.getSize());
+		benchmark::DoNotOptimize(solver.solve(test.problem, &solution));
+	}
+	state.counters["Constraints"] = static_cast<double>(test.getSize());
+	state.counters["SolverIterations"] = static_cast<double>(solution.numIterations);
+}
+
+}
+
+BENCHMARK(MlcpGaussSeidelSolverSolve)->DenseRange(1, 9);
@@ -0,0 +1,73 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Benchmarks/PhysicsScene.h"
+
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Framework/Scene.h"
+#include "SurgSim/Framework/SceneElement.h"
+#include "SurgSim/Physics/Computation.h"
+#include "SurgSim/Physics/PhysicsManager.h"
+
+namespace SurgSim
+{
+namespace Benchmarks
+{
+
+PhysicsScene::PhysicsScene(double rate, const std::vector<std::shared_ptr<Physics::Computation>>& computations) :
+	m_rate(rate),
+	m_runtime(std::make_shared<Framework::Runtime>("config.txt")),
+	m_physicsManager(std::make_shared<Physics::PhysicsManager>())
+{
+	SURGSIM_ASSERT(rate > 0.0) << "The physics rate has to be positive.";
+	m_physicsManager->setRate(rate);
+	m_physicsManager->setComputations(computations);
+	m_runtime->addManager(m_physicsManager);
+}
+
+PhysicsScene::~PhysicsScene()
+{
+	if (m_runtime->isRunning())
+	{
+		m_runtime->stop();
+	}
+}
+
+void PhysicsScene::addSceneElement(const std::shared_ptr<Framework::SceneElement>& element)
+{
+	m_runtime->getScene()->addSceneElement(element);
+}
+
+void PhysicsScene::run(benchmark::State& state)
+{
+	const double period = 1.0 / m_rate;
+	SURGSIM_ASSERT(m_runtime->startLockstep()) << "The runtime could not be started.";
+
+	// The first update wakes up the scene, it should not be part of the timings
+	m_runtime->advanceLockstep(period);
+
+	for (auto _ : state)
+	{
+		m_runtime->advanceLockstep(period);
+	}
+
+	state.SetItemsProcessed(state.iterations());
+	state.counters["RealTimeFactor"] =
+		benchmark::Counter(static_cast<double>(state.iterations()) * period, benchmark::Counter::kIsRate);
+}
+
+}; // namespace Benchmarks
+}; // namespace SurgSim
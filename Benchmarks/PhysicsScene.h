@@ -0,0 +1,82 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BENCHMARKS_PHYSICSSCENE_H
+#define BENCHMARKS_PHYSICSSCENE_H
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace SurgSim
+{
+
+namespace Framework
+{
+class Runtime;
+class SceneElement;
+}
+
+namespace Physics
+{
+class Computation;
+class PhysicsManager;
+}
+
+namespace Benchmarks
+{
+
+/// A headless scene simulated by a physics manager only, run in lockstep by the runtime so that each benchmark
+/// iteration measures exactly one update of the whole physics pipeline (collision detection, contact generation,
+/// constraint solving and integration).
+/// The runtime is created first, so that the scene elements can find their files with its application data.
+class PhysicsScene
+{
+public:
+	/// Constructor
+	/// \param rate The rate (in Hz) of the physics manager
+	/// \param computations The physics pipeline, e.g. Physics::createDcdPipeline()
+	PhysicsScene(double rate, const std::vector<std::shared_ptr<Physics::Computation>>& computations);
+
+	/// Destructor, stops the runtime
+	~PhysicsScene();
+
+	/// \param element The scene element to add, has to be added before run()
+	void addSceneElement(const std::shared_ptr<Framework::SceneElement>& element);
+
+	/// Starts the simulation, and runs one physics update per iteration of the benchmark
+	/// Besides the timings, reports the physics updates as items, and the simulated time per second of wall clock
+	/// time as the "RealTimeFactor" counter.
+	/// \note The physics manager runs on its own thread, the benchmarks have to use real time (UseRealTime()).
+	/// \note The scene evolves from one update to the next (e.g. the objects settle), so the benchmarks have to use a
+	/// fixed number of iterations (Iterations()), for all the runs to measure the same simulated interval.
+	/// \param state The benchmark state
+	void run(benchmark::State& state);
+
+private:
+	/// The rate of the physics manager
+	double m_rate;
+
+	/// The runtime
+	std::shared_ptr<Framework::Runtime> m_runtime;
+
+	/// The physics manager
+	std::shared_ptr<Physics::PhysicsManager> m_physicsManager;
+};
+
+}; // namespace Benchmarks
+}; // namespace SurgSim
+
+#endif // BENCHMARKS_PHYSICSSCENE_H
@@ -0,0 +1,113 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include "Benchmarks/PhysicsScene.h"
+#include "SurgSim/Framework/BasicSceneElement.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/PlaneShape.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/SphereShape.h"
+#include "SurgSim/Math/Vector.h"
+#include "SurgSim/Physics/FixedRepresentation.h"
+#include "SurgSim/Physics/PhysicsManager.h"
+#include "SurgSim/Physics/RigidCollisionRepresentation.h"
+#include "SurgSim/Physics/RigidRepresentation.h"
+
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+
+/// Radius of the spheres, matching the Geometry/sphere0_025.ply mesh
+const double radius = 0.025;
+
+/// Number of spheres per row of a layer
+const size_t spheresPerRow = 8;
+
+std::shared_ptr<SurgSim::Framework::SceneElement> makeFloor()
+{
+	auto element = std::make_shared<SurgSim::Framework::BasicSceneElement>("Floor");
+	auto shape = std::make_shared<SurgSim::Math::PlaneShape>();
+
+	auto physics = std::make_shared<SurgSim::Physics::FixedRepresentation>("Physics");
+	physics->setShape(shape);
+	element->addComponent(physics);
+
+	auto collision = std::make_shared<SurgSim::Physics::RigidCollisionRepresentation>("Collision");
+	physics->setCollisionRepresentation(collision);
+	element->addComponent(collision);
+
+	return element;
+}
+
+std::shared_ptr<SurgSim::Framework::SceneElement> makeSphere(const std::string& name, const Vector3d& position,
+		bool useMesh)
+{
+	auto element = std::make_shared<SurgSim::Framework::BasicSceneElement>(name);
+	element->setPose(SurgSim::Math::makeRigidTranslation(position));
+
+	auto physics = std::make_shared<SurgSim::Physics::RigidRepresentation>("Physics");
+	physics->setDensity(1000.0);
+	physics->setLinearDamping(0.1);
+	physics->setShape(std::make_shared<SurgSim::Math::SphereShape>(radius));
+	element->addComponent(physics);
+
+	auto collision = std::make_shared<SurgSim::Physics::RigidCollisionRepresentation>("Collision");
+	if (useMesh)
+	{
+		auto mesh = std::make_shared<SurgSim::Math::MeshShape>();
+		mesh->load("Geometry/sphere0_025.ply");
+		collision->setShape(mesh);
+	}
+	physics->setCollisionRepresentation(collision);
+	element->addComponent(collision);
+
+	return element;
+}
+
+/// N rigid spheres dropped in layers of 8x8 on a floor, using the discrete collision detection pipeline.
+/// The spheres are stacked in columns slightly apart, so they settle on each other after a few updates and
+/// keep generating sphere/sphere and sphere/plane contacts.
+/// \param state The benchmark state, its range(0) is the number of spheres
+/// \param useMesh true to collide the triangle mesh of the spheres, false to collide the analytic spheres
+void RigidSpheres(benchmark::State& state, bool useMesh)
+{
+	SurgSim::Benchmarks::PhysicsScene scene(1000.0, SurgSim::Physics::createDcdPipeline());
+	scene.addSceneElement(makeFloor());
+
+	const size_t numSpheres = static_cast<size_t>(state.range(0));
+	const double spacing = 2.05 * radius;
+	for (size_t i = 0; i < numSpheres; ++i)
+	{
+		const size_t layer = i / (spheresPerRow * spheresPerRow);
+		const size_t row = (i / spheresPerRow) % spheresPerRow;
+		const size_t column = i % spheresPerRow;
+		const Vector3d position(spacing * column, radius + spacing * layer, spacing * row);
+		scene.addSceneElement(makeSphere("Sphere" + std::to_string(i), position, useMesh));
+	}
+
+	scene.run(state);
+	state.counters["Spheres"] = static_cast<double>(numSpheres);
+}
+
+}
+
+BENCHMARK_CAPTURE(RigidSpheres, Analytic, false)->RangeMultiplier(4)->Range(4, 1024)->Iterations(500)->UseRealTime();
+BENCHMARK_CAPTURE(RigidSpheres, Mesh, true)->RangeMultiplier(4)->Range(4, 256)->Iterations(500)->UseRealTime();
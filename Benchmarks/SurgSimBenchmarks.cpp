@@ -0,0 +1,55 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file SurgSimBenchmarks.cpp
+/// Runs the physics pipeline benchmarks. The results are written as JSON to SurgSimBenchmarks.json, unless
+/// another output is given with --benchmark_out=<file>, all the Google Benchmark options are supported,
+/// e.g. --benchmark_filter=<regex> to run only some of the scenes.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+#include "SurgSim/Framework/Log.h"
+
+int main(int argc, char** argv)
+{
+	std::vector<char*> arguments(argv, argv + argc);
+	bool hasOutput = false;
+	for (const auto& argument : arguments)
+	{
+		hasOutput = hasOutput || std::string(argument).find("--benchmark_out=") == 0;
+	}
+	std::string output = "--benchmark_out=SurgSimBenchmarks.json";
+	std::string format = "--benchmark_out_format=json";
+	if (!hasOutput)
+	{
+		arguments.push_back(&output[0]);
+		arguments.push_back(&format[0]);
+	}
+
+	// The contacts and the solver log at the debug level, keep the output to the results
+	SurgSim::Framework::Logger::getLoggerManager()->setThreshold(SurgSim::Framework::LOG_LEVEL_WARNING);
+
+	int numArguments = static_cast<int>(arguments.size());
+	benchmark::Initialize(&numArguments, arguments.data());
+	if (benchmark::ReportUnrecognizedArguments(numArguments, arguments.data()))
+	{
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
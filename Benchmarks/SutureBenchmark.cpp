@@ -0,0 +1,95 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+#include "Benchmarks/PhysicsScene.h"
+#include "SurgSim/Framework/BasicSceneElement.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/SegmentMeshShape.h"
+#include "SurgSim/Math/Vector.h"
+#include "SurgSim/Physics/DeformableCollisionRepresentation.h"
+#include "SurgSim/Physics/Fem1DRepresentation.h"
+#include "SurgSim/Physics/FixedRepresentation.h"
+#include "SurgSim/Physics/PhysicsManager.h"
+#include "SurgSim/Physics/RigidCollisionRepresentation.h"
+
+namespace
+{
+
+std::shared_ptr<SurgSim::Framework::SceneElement> makeSuture(const std::string& filename)
+{
+	auto element = std::make_shared<SurgSim::Framework::BasicSceneElement>("Suture");
+
+	auto physics = std::make_shared<SurgSim::Physics::Fem1DRepresentation>("Physics");
+	physics->setFemElementType("SurgSim::Physics::Fem1DElementBeam");
+	physics->loadFem(filename);
+	physics->setIntegrationScheme(SurgSim::Math::INTEGRATIONSCHEME_EULER_IMPLICIT);
+	physics->setLinearSolver(SurgSim::Math::LINEARSOLVER_LU);
+	physics->setRayleighDampingMass(5.0);
+	physics->setRayleighDampingStiffness(0.001);
+	element->addComponent(physics);
+
+	auto collision = std::make_shared<SurgSim::Physics::DeformableCollisionRepresentation>("Collision");
+	auto shape = std::make_shared<SurgSim::Math::SegmentMeshShape>();
+	shape->load(filename);
+	shape->setRadius(0.001);
+	collision->setShape(shape);
+	collision->setCollisionDetectionType(SurgSim::Collision::COLLISION_DETECTION_TYPE_CONTINUOUS);
+	collision->setSelfCollisionDetectionType(SurgSim::Collision::COLLISION_DETECTION_TYPE_CONTINUOUS);
+	physics->setCollisionRepresentation(collision);
+	element->addComponent(collision);
+
+	return element;
+}
+
+std::shared_ptr<SurgSim::Framework::SceneElement> makeCylinder(const std::string& filename)
+{
+	auto element = std::make_shared<SurgSim::Framework::BasicSceneElement>("Cylinder");
+	element->setPose(SurgSim::Math::makeRigidTranslation(SurgSim::Math::Vector3d(0.0, -0.1, 0.0)));
+	auto shape = std::make_shared<SurgSim::Math::MeshShape>();
+	shape->load(filename);
+
+	auto physics = std::make_shared<SurgSim::Physics::FixedRepresentation>("Physics");
+	physics->setShape(shape);
+	element->addComponent(physics);
+
+	auto collision = std::make_shared<SurgSim::Physics::RigidCollisionRepresentation>("Collision");
+	collision->setCollisionDetectionType(SurgSim::Collision::COLLISION_DETECTION_TYPE_CONTINUOUS);
+	collision->setShape(shape);
+	physics->setCollisionRepresentation(collision);
+	element->addComponent(collision);
+
+	return element;
+}
+
+/// A beam suture, fixed at one extremity, falling and wrapping around a cylinder, using the continuous collision
+/// detection pipeline, with self collisions.
+/// \param state The benchmark state
+void Suture(benchmark::State& state)
+{
+	SurgSim::Benchmarks::PhysicsScene scene(150.0, SurgSim::Physics::createCcdPipeline());
+	scene.addSceneElement(makeSuture("prolene 3.0-fixedExtremity.ply"));
+	scene.addSceneElement(makeCylinder("cylinder.ply"));
+
+	scene.run(state);
+}
+
+}
+
+BENCHMARK(Suture)->Iterations(300)->UseRealTime();
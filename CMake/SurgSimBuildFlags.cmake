@@ -145,3 +145,14 @@ mark_as_advanced(EIGEN_ALIGNMENT)
 if(NOT EIGEN_ALIGNMENT)
 	add_definitions( -DEIGEN_DONT_ALIGN )
 endif()
+
+# AVX2/FMA code generation, for Eigen (including the fixed-size packets of Fem3DCorotationalTetrahedronBatch).
+# It changes the alignment of the Eigen types, so it needs to be set for the whole build, including the applications.
+option(SURGSIM_USE_AVX2 "Generate AVX2 and FMA instructions (the cpu running the build needs to support them)" OFF)
+if(SURGSIM_USE_AVX2)
+	if(MSVC)
+		set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} /arch:AVX2")
+	else()
+		set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -mavx2 -mfma")
+	endif()
+endif(SURGSIM_USE_AVX2)
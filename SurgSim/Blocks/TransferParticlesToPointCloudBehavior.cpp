@@ -73,6 +73,14 @@ void TransferParticlesToPointCloudBehavior::update(double dt)
 	*m_target->getVertices() = *m_source->getParticles().safeGet();
 }
 
+bool TransferParticlesToPointCloudBehavior::getDeclaredAccesses(std::vector<const Framework::Component*>* reads,
+		std::vector<const Framework::Component*>* writes) const
+{
+	reads->push_back(m_source.get());
+	writes->push_back(m_target.get());
+	return true;
+}
+
 bool TransferParticlesToPointCloudBehavior::doInitialize()
 {
 	return true;
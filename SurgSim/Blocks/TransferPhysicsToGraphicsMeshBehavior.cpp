@@ -140,6 +140,14 @@ void TransferPhysicsToGraphicsMeshBehavior::update(double dt)
 	m_target->getMesh()->dirty();
 }
 
+bool TransferPhysicsToGraphicsMeshBehavior::getDeclaredAccesses(std::vector<const Framework::Component*>* reads,
+		std::vector<const Framework::Component*>* writes) const
+{
+	reads->push_back(m_source.get());
+	writes->push_back(m_target.get());
+	return true;
+}
+
 bool TransferPhysicsToGraphicsMeshBehavior::doInitialize()
 {
 	return true;
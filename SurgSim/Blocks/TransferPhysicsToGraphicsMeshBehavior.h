@@ -97,6 +97,9 @@ class TransferPhysicsToGraphicsMeshBehavior : public Framework::Behavior
 
 	void update(double dt) override;
 
+	bool getDeclaredAccesses(std::vector<const Framework::Component*>* reads,
+							 std::vector<const Framework::Component*>* writes) const override;
+
 private:
 	bool doInitialize() override;
 	bool doWakeUp() override;
@@ -79,6 +79,14 @@ void TransferPhysicsToPointCloudBehavior::update(double dt)
 	}
 }
 
+bool TransferPhysicsToPointCloudBehavior::getDeclaredAccesses(std::vector<const Framework::Component*>* reads,
+		std::vector<const Framework::Component*>* writes) const
+{
+	reads->push_back(m_source.get());
+	writes->push_back(m_target.get());
+	return true;
+}
+
 bool TransferPhysicsToPointCloudBehavior::doInitialize()
 {
 	return true;
@@ -66,6 +66,14 @@ void TransferPhysicsToVerticesBehavior::update(double dt)
 	m_target->setValue("Vertices", m_vertices);
 }
 
+bool TransferPhysicsToVerticesBehavior::getDeclaredAccesses(std::vector<const Framework::Component*>* reads,
+		std::vector<const Framework::Component*>* writes) const
+{
+	reads->push_back(m_source.get());
+	writes->push_back(m_target.get());
+	return true;
+}
+
 bool TransferPhysicsToVerticesBehavior::doInitialize()
 {
 	return true;
@@ -67,6 +67,9 @@ class TransferPhysicsToVerticesBehavior : public Framework::Behavior
 	/// \throws if the type of the "Vertices" property on the target is not DataStructures::VerticesPlain
 	void update(double dt) override;
 
+	bool getDeclaredAccesses(std::vector<const Framework::Component*>* reads,
+							 std::vector<const Framework::Component*>* writes) const override;
+
 	bool doInitialize() override;
 
 	bool doWakeUp() override;
@@ -24,11 +24,17 @@
 #include "SurgSim/Collision/CompoundShapeContact.h"
 #include "SurgSim/Collision/ContactCalculation.h"
 #include "SurgSim/Collision/DefaultContactCalculation.h"
+#include "SurgSim/Collision/GjkEpaContact.h"
 #include "SurgSim/Collision/OctreeCapsuleContact.h"
 #include "SurgSim/Collision/OctreeDoubleSidedPlaneContact.h"
 #include "SurgSim/Collision/OctreePlaneContact.h"
 #include "SurgSim/Collision/OctreeSphereContact.h"
 #include "SurgSim/Collision/OctreeTriangleMeshContact.h"
+#include "SurgSim/Collision/SdfCapsuleContact.h"
+#include "SurgSim/Collision/SdfParticlesContact.h"
+#include "SurgSim/Collision/SdfSegmentMeshContact.h"
+#include "SurgSim/Collision/SdfSphereContact.h"
+#include "SurgSim/Collision/SdfTriangleMeshContact.h"
 #include "SurgSim/Collision/SegmentMeshTriangleMeshContact.h"
 #include "SurgSim/Collision/SegmentSelfContact.h"
 #include "SurgSim/Collision/SphereDoubleSidedPlaneContact.h"
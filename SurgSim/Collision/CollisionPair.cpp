@@ -25,7 +25,8 @@ namespace SurgSim
 namespace Collision
 {
 
-CollisionPair::CollisionPair()
+CollisionPair::CollisionPair() :
+	m_hasCachedContacts(false)
 {
 }
 
@@ -47,6 +48,9 @@ void CollisionPair::setRepresentations(const std::shared_ptr<Representation>& fi
 
 	// Invalidate the current contacts
 	clearContacts();
+	m_contactManifold.clear();
+	m_cachedContacts.clear();
+	m_hasCachedContacts = false;
 	m_representations.first = first;
 	m_representations.second = second;
 	m_isSwapped = false;
@@ -146,6 +150,9 @@ void CollisionPair::swapRepresentations()
 	SURGSIM_ASSERT(!hasContacts()) << "Can't swap representations after contacts have already been calculated";
 	m_isSwapped = !m_isSwapped;
 	std::swap(m_representations.first, m_representations.second);
+	m_contactManifold.clear();
+	m_cachedContacts.clear();
+	m_hasCachedContacts = false;
 }
 
 bool CollisionPair::isSwapped() const
@@ -153,6 +160,39 @@ bool CollisionPair::isSwapped() const
 	return m_isSwapped;
 }
 
+void CollisionPair::cacheContacts()
+{
+	m_cachedContacts.clear();
+	for (const auto& contact : m_contacts)
+	{
+		m_cachedContacts.push_back(std::make_shared<Contact>(*contact));
+	}
+	m_cachedShapeVersions = std::make_pair(m_representations.first->getShapeVersion(),
+										   m_representations.second->getShapeVersion());
+	m_hasCachedContacts = true;
+}
+
+bool CollisionPair::restoreCachedContacts()
+{
+	if (!m_hasCachedContacts || m_cachedShapeVersions.first != m_representations.first->getShapeVersion() ||
+		m_cachedShapeVersions.second != m_representations.second->getShapeVersion())
+	{
+		return false;
+	}
+
+	clearContacts();
+	for (const auto& contact : m_cachedContacts)
+	{
+		m_contacts.push_back(std::make_shared<Contact>(*contact));
+	}
+	return true;
+}
+
+ContactManifold& CollisionPair::getContactManifold()
+{
+	return m_contactManifold;
+}
+
 bool CollisionPair::mayIntersect() const
 {
 	const auto& one = m_representations.first->getBoundingBox();
@@ -19,6 +19,7 @@
 #include <list>
 #include <memory>
 
+#include "SurgSim/Collision/ContactManifold.h"
 #include "SurgSim/Collision/Representation.h"
 #include "SurgSim/DataStructures/Location.h"
 #include "SurgSim/Math/Vector.h"
@@ -154,6 +155,20 @@ class CollisionPair
 	/// \return	true if swapped, false if not.
 	bool isSwapped() const;
 
+	/// Keep a copy of the current contacts, as the result of the contact calculation for the current shapes of the
+	/// representations (see Representation::getShapeVersion).
+	void cacheContacts();
+
+	/// Restore the cached contacts as the current contacts, if neither representation has changed since they were
+	/// cached, in which case the contact calculation can be skipped.
+	/// \return true if the contacts were restored, false if they need to be calculated
+	bool restoreCachedContacts();
+
+	/// The contact manifold, kept across the updates by the contact calculations that support it (see GjkEpaContact),
+	/// it is reset when the representations are set or swapped.
+	/// \return The contact manifold between the first and the second representation
+	ContactManifold& getContactManifold();
+
 	/// \return whether the two represenations might have an intersection
 	/// \note The bounding boxes are taken, if the bounding box is empty it is always considered for collision
 	bool mayIntersect() const;
@@ -168,6 +183,18 @@ class CollisionPair
 	/// List of current contacts
 	std::list<std::shared_ptr<Contact>> m_contacts;
 
+	/// Persistent contact manifold
+	ContactManifold m_contactManifold;
+
+	/// Contacts cached by cacheContacts
+	std::list<std::shared_ptr<Contact>> m_cachedContacts;
+
+	/// The shape versions of the first and second representations when the contacts were cached
+	std::pair<size_t, size_t> m_cachedShapeVersions;
+
+	/// Whether the cached contacts are valid
+	bool m_hasCachedContacts;
+
 	bool m_isSwapped;
 };
 
@@ -224,6 +224,11 @@ void ContactCalculation::initializeTables()
 	ContactCalculation::privateDcdRegister(std::make_shared<Collision::OctreePlaneContact>());
 	ContactCalculation::privateDcdRegister(std::make_shared<Collision::OctreeSphereContact>());
 	ContactCalculation::privateDcdRegister(std::make_shared<Collision::OctreeTriangleMeshContact>());
+	ContactCalculation::privateDcdRegister(std::make_shared<Collision::SdfCapsuleContact>());
+	ContactCalculation::privateDcdRegister(std::make_shared<Collision::SdfParticlesContact>());
+	ContactCalculation::privateDcdRegister(std::make_shared<Collision::SdfSegmentMeshContact>());
+	ContactCalculation::privateDcdRegister(std::make_shared<Collision::SdfSphereContact>());
+	ContactCalculation::privateDcdRegister(std::make_shared<Collision::SdfTriangleMeshContact>());
 	ContactCalculation::privateDcdRegister(std::make_shared<Collision::SegmentMeshTriangleMeshContact>());
 	ContactCalculation::privateDcdRegister(std::make_shared<Collision::SphereSphereContact>());
 	ContactCalculation::privateDcdRegister(std::make_shared<Collision::SphereDoubleSidedPlaneContact>());
@@ -234,6 +239,28 @@ void ContactCalculation::initializeTables()
 	ContactCalculation::privateDcdRegister(std::make_shared<Collision::TriangleMeshSurfaceMeshContact>());
 	ContactCalculation::privateDcdRegister(std::make_shared<Collision::TriangleMeshTriangleMeshContact>());
 
+	// The pairs of convex shapes without a dedicated calculation fall back on the generic one
+	const std::array<int, 4> convexShapes =
+	{
+		Math::SHAPE_TYPE_BOX,
+		Math::SHAPE_TYPE_CAPSULE,
+		Math::SHAPE_TYPE_CYLINDER,
+		Math::SHAPE_TYPE_SPHERE
+	};
+
+	for (size_t i = 0; i < convexShapes.size(); ++i)
+	{
+		for (size_t j = i; j < convexShapes.size(); ++j)
+		{
+			const auto& calculation = m_contactDcdCalculations[convexShapes[i]][convexShapes[j]];
+			if (std::dynamic_pointer_cast<DefaultContactCalculation>(calculation) != nullptr)
+			{
+				ContactCalculation::privateDcdRegister(std::make_shared<Collision::GjkEpaContact>(
+						std::make_pair(convexShapes[i], convexShapes[j])));
+			}
+		}
+	}
+
 	const std::array<int, Math::SHAPE_TYPE_COUNT> allshapes =
 	{
 		Math::SHAPE_TYPE_BOX,
@@ -247,7 +274,8 @@ void ContactCalculation::initializeTables()
 		Math::SHAPE_TYPE_SPHERE,
 		Math::SHAPE_TYPE_SURFACEMESH,
 		Math::SHAPE_TYPE_SEGMENTMESH,
-		Math::SHAPE_TYPE_COMPOUNDSHAPE
+		Math::SHAPE_TYPE_COMPOUNDSHAPE,
+		Math::SHAPE_TYPE_SDF
 	};
 
 	for (auto type : allshapes)
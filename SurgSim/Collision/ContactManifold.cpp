@@ -0,0 +1,179 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Collision/ContactManifold.h"
+
+#include <algorithm>
+
+#include "SurgSim/Framework/Assert.h"
+
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+/// The cosine of the angle beyond which a change of normal invalidates the manifold
+const double normalChangeCosine = 0.98;
+
+/// \return A measure of the area of the contact patch made of 4 points
+double computeArea(const Vector3d& a, const Vector3d& b, const Vector3d& c, const Vector3d& d)
+{
+	return std::max(std::max((a - b).cross(c - d).squaredNorm(), (a - c).cross(b - d).squaredNorm()),
+					(a - d).cross(b - c).squaredNorm());
+}
+}
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+const size_t ContactManifold::MaxNumPoints;
+
+ContactManifold::ContactManifold(double breakingThreshold) :
+	m_normal(Vector3d::Zero())
+{
+	setBreakingThreshold(breakingThreshold);
+}
+
+void ContactManifold::setBreakingThreshold(double threshold)
+{
+	SURGSIM_ASSERT(threshold > 0.0) << "The breaking threshold needs to be positive";
+	m_breakingThreshold = threshold;
+}
+
+double ContactManifold::getBreakingThreshold() const
+{
+	return m_breakingThreshold;
+}
+
+void ContactManifold::refresh(const Math::RigidTransform3d& pose1, const Math::RigidTransform3d& pose2)
+{
+	for (auto point = m_points.begin(); point != m_points.end();)
+	{
+		const Vector3d difference = pose2 * point->localPoint2 - pose1 * point->localPoint1;
+		point->depth = difference.dot(m_normal);
+		if (point->depth < -m_breakingThreshold ||
+			(difference - point->depth * m_normal).squaredNorm() > m_breakingThreshold * m_breakingThreshold)
+		{
+			point = m_points.erase(point);
+		}
+		else
+		{
+			++point;
+		}
+	}
+}
+
+void ContactManifold::addPoint(const Math::RigidTransform3d& pose1, const Math::RigidTransform3d& pose2,
+							   const Vector3d& normal, double depth,
+							   const Vector3d& localPoint1, const Vector3d& localPoint2)
+{
+	if (!m_points.empty() && m_normal.dot(normal) < normalChangeCosine)
+	{
+		clearPoints();
+	}
+	m_normal = normal;
+	refresh(pose1, pose2);
+
+	Point newPoint = {localPoint1, localPoint2, depth};
+	double closestDistance = m_breakingThreshold * m_breakingThreshold;
+	auto closest = m_points.end();
+	for (auto point = m_points.begin(); point != m_points.end(); ++point)
+	{
+		const double distance = (point->localPoint1 - localPoint1).squaredNorm();
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			closest = point;
+		}
+	}
+
+	if (closest != m_points.end())
+	{
+		*closest = newPoint;
+	}
+	else
+	{
+		m_points.push_back(newPoint);
+		if (m_points.size() > MaxNumPoints)
+		{
+			reduce();
+		}
+	}
+}
+
+const std::vector<ContactManifold::Point>& ContactManifold::getPoints() const
+{
+	return m_points;
+}
+
+const Vector3d& ContactManifold::getNormal() const
+{
+	return m_normal;
+}
+
+Math::GjkSimplex* ContactManifold::getSimplex()
+{
+	return &m_simplex;
+}
+
+void ContactManifold::clearPoints()
+{
+	m_points.clear();
+}
+
+void ContactManifold::clear()
+{
+	m_points.clear();
+	m_simplex.clear();
+}
+
+void ContactManifold::reduce()
+{
+	auto deepest = std::max_element(m_points.begin(), m_points.end(), [](const Point & a, const Point & b)
+	{
+		return a.depth < b.depth;
+	});
+	const size_t deepestIndex = std::distance(m_points.begin(), deepest);
+
+	// Remove the point whose removal leaves the largest contact patch
+	size_t removed = (deepestIndex == 0) ? 1 : 0;
+	double largestArea = -1.0;
+	for (size_t candidate = 0; candidate < m_points.size(); ++candidate)
+	{
+		if (candidate == deepestIndex)
+		{
+			continue;
+		}
+		std::vector<Vector3d> remaining;
+		for (size_t i = 0; i < m_points.size(); ++i)
+		{
+			if (i != candidate)
+			{
+				remaining.push_back(m_points[i].localPoint1);
+			}
+		}
+		const double area = computeArea(remaining[0], remaining[1], remaining[2], remaining[3]);
+		if (area > largestArea)
+		{
+			largestArea = area;
+			removed = candidate;
+		}
+	}
+	m_points.erase(m_points.begin() + removed);
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
@@ -0,0 +1,113 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_COLLISION_CONTACTMANIFOLD_H
+#define SURGSIM_COLLISION_CONTACTMANIFOLD_H
+
+#include <vector>
+
+#include "SurgSim/Math/GjkEpa.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/Vector.h"
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+/// Persistent contact manifold between two rigid convex shapes.
+/// A single point is found per update by the narrow phase (e.g. GJK/EPA), the manifold accumulates these points
+/// across the updates, in the local frames of both shapes, to build a stable contact patch of up to MaxNumPoints
+/// points (e.g. the 4 corners of a box resting on another one). The points are refreshed with the new poses on each
+/// update and dropped once they drift apart by more than the breaking threshold.
+/// The manifold also keeps the last GJK simplex, to warm start the next query.
+class ContactManifold
+{
+public:
+	/// The maximum number of points kept in the manifold
+	static const size_t MaxNumPoints = 4;
+
+	/// A point of the manifold
+	struct Point
+	{
+		/// The deepest point of the first shape into the second one, in the first shape local frame
+		Math::Vector3d localPoint1;
+		/// The deepest point of the second shape into the first one, in the second shape local frame
+		Math::Vector3d localPoint2;
+		/// The penetration depth along the manifold normal, negative if the shapes are separated at this point
+		double depth;
+	};
+
+	/// Constructor
+	/// \param breakingThreshold The distance (in m) beyond which the points are dropped from the manifold
+	explicit ContactManifold(double breakingThreshold = 1e-3);
+
+	/// \param threshold The distance (in m) beyond which the points are dropped from the manifold
+	void setBreakingThreshold(double threshold);
+
+	/// \return The distance (in m) beyond which the points are dropped from the manifold
+	double getBreakingThreshold() const;
+
+	/// Refresh the points with the new poses of the shapes, dropping the ones that are no longer valid
+	/// \param pose1, pose2 The poses of the two shapes
+	void refresh(const Math::RigidTransform3d& pose1, const Math::RigidTransform3d& pose2);
+
+	/// Add a new point, replacing the closest one if they are within the breaking threshold, or the one contributing
+	/// the least to the contact patch if the manifold is full.
+	/// The manifold normal is updated, and all the points are dropped if the normal changes significantly.
+	/// \param pose1, pose2 The poses of the two shapes
+	/// \param normal The contact normal, pointing into the first shape
+	/// \param depth The penetration depth
+	/// \param localPoint1, localPoint2 The deepest points, in the respective shape local frames
+	void addPoint(const Math::RigidTransform3d& pose1, const Math::RigidTransform3d& pose2,
+				  const Math::Vector3d& normal, double depth,
+				  const Math::Vector3d& localPoint1, const Math::Vector3d& localPoint2);
+
+	/// \return The points of the manifold
+	const std::vector<Point>& getPoints() const;
+
+	/// \return The contact normal, pointing into the first shape
+	const Math::Vector3d& getNormal() const;
+
+	/// \return The cached simplex, to warm start the GJK queries
+	Math::GjkSimplex* getSimplex();
+
+	/// Remove all the points, keeping the cached simplex
+	void clearPoints();
+
+	/// Remove all the points and the cached simplex
+	void clear();
+
+private:
+	/// Remove the point that contributes the least to the contact patch, keeping the deepest point
+	void reduce();
+
+	/// The distance beyond which the points are dropped
+	double m_breakingThreshold;
+
+	/// The contact normal, pointing into the first shape
+	Math::Vector3d m_normal;
+
+	/// The points
+	std::vector<Point> m_points;
+
+	/// The cached GJK simplex
+	Math::GjkSimplex m_simplex;
+};
+
+}; // namespace Collision
+}; // namespace SurgSim
+
+#endif // SURGSIM_COLLISION_CONTACTMANIFOLD_H
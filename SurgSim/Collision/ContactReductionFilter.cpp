@@ -0,0 +1,252 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Collision/ContactReductionFilter.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "SurgSim/Collision/CollisionPair.h"
+#include "SurgSim/Collision/Representation.h"
+#include "SurgSim/Framework/FrameworkConvert.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/Vector.h"
+
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+
+/// A cluster of contacts, with its deepest contact and the extremes of the contact patch in the tangent plane
+struct Cluster
+{
+	/// Index of the deepest contact, the first one in the cluster
+	size_t seed;
+	/// The tangent directions (t1, -t1, t2, -t2)
+	std::array<Vector3d, 4> directions;
+	/// Indices of the extreme contacts along the directions
+	std::array<size_t, 4> extremes;
+	/// Extents of the contact patch along the directions
+	std::array<double, 4> extents;
+};
+
+}
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+SURGSIM_REGISTER(SurgSim::Framework::Component, SurgSim::Collision::ContactReductionFilter, ContactReductionFilter);
+
+ContactReductionFilter::ContactReductionFilter(const std::string& name) :
+	ContactFilter(name),
+	m_maxNumContacts(16),
+	m_clusterRadius(0.01),
+	m_normalAngle(M_PI / 12.0)
+{
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(ContactReductionFilter, std::shared_ptr<Framework::Component>, Representation,
+									  getRepresentation, setRepresentation);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(ContactReductionFilter, size_t, MaxNumContacts,
+									  getMaxNumContacts, setMaxNumContacts);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(ContactReductionFilter, double, ClusterRadius,
+									  getClusterRadius, setClusterRadius);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(ContactReductionFilter, double, NormalAngle, getNormalAngle, setNormalAngle);
+}
+
+bool ContactReductionFilter::doInitialize()
+{
+	return true;
+}
+
+bool ContactReductionFilter::doWakeUp()
+{
+	return true;
+}
+
+void ContactReductionFilter::setRepresentation(const std::shared_ptr<SurgSim::Framework::Component>& val)
+{
+	SURGSIM_ASSERT(!isAwake()) << "Can't set representation after waking up on " << getFullName();
+	if (val == nullptr)
+	{
+		m_representation = nullptr;
+	}
+	else
+	{
+		m_representation = Framework::checkAndConvert<SurgSim::Collision::Representation>(
+							   val, "SurgSim::Collision::Representation");
+	}
+}
+
+std::shared_ptr<SurgSim::Collision::Representation> ContactReductionFilter::getRepresentation() const
+{
+	return m_representation;
+}
+
+void ContactReductionFilter::setMaxNumContacts(size_t maxNumContacts)
+{
+	SURGSIM_ASSERT(maxNumContacts > 0) << "The maximum number of contacts has to be positive on " << getFullName();
+	m_maxNumContacts = maxNumContacts;
+}
+
+size_t ContactReductionFilter::getMaxNumContacts() const
+{
+	return m_maxNumContacts;
+}
+
+void ContactReductionFilter::setClusterRadius(double radius)
+{
+	SURGSIM_ASSERT(radius >= 0.0) << "The cluster radius can't be negative on " << getFullName();
+	m_clusterRadius = radius;
+}
+
+double ContactReductionFilter::getClusterRadius() const
+{
+	return m_clusterRadius;
+}
+
+void ContactReductionFilter::setNormalAngle(double angle)
+{
+	SURGSIM_ASSERT(angle >= 0.0 && angle <= M_PI) << "The normal angle has to be in [0, pi] on " << getFullName();
+	m_normalAngle = angle;
+}
+
+double ContactReductionFilter::getNormalAngle() const
+{
+	return m_normalAngle;
+}
+
+void ContactReductionFilter::doFilterContacts(const std::shared_ptr<Physics::PhysicsManagerState>&,
+		const std::shared_ptr<CollisionPair>& pair)
+{
+	auto& contacts = pair->getContacts();
+	if (contacts.size() <= m_maxNumContacts)
+	{
+		return;
+	}
+	if (m_representation != nullptr && pair->getFirst() != m_representation &&
+		pair->getSecond() != m_representation)
+	{
+		return;
+	}
+
+	// Locate the contacts, in the same frame as their normals
+	const Math::RigidTransform3d& pose = pair->getFirst()->getPosedShape().getPose();
+	std::list<std::shared_ptr<Contact>> result;
+	std::vector<std::pair<std::shared_ptr<Contact>, Vector3d>> located;
+	located.reserve(contacts.size());
+	for (const auto& contact : contacts)
+	{
+		if (contact->penetrationPoints.first.rigidLocalPosition.hasValue())
+		{
+			located.emplace_back(contact, pose * contact->penetrationPoints.first.rigidLocalPosition.getValue());
+		}
+		else
+		{
+			result.push_back(contact);
+		}
+	}
+	std::stable_sort(located.begin(), located.end(),
+					 [](const std::pair<std::shared_ptr<Contact>, Vector3d>& a,
+						const std::pair<std::shared_ptr<Contact>, Vector3d>& b)
+	{
+		return a.first->depth > b.first->depth;
+	});
+
+	// Greedy clustering, each cluster starts with its deepest contact
+	const double squaredRadius = m_clusterRadius * m_clusterRadius;
+	const double cosAngle = std::cos(m_normalAngle);
+	std::vector<Cluster> clusters;
+	for (size_t i = 0; i < located.size(); ++i)
+	{
+		const auto& contact = located[i].first;
+		const Vector3d& position = located[i].second;
+		auto cluster = std::find_if(clusters.begin(), clusters.end(), [&](const Cluster& c)
+		{
+			return (position - located[c.seed].second).squaredNorm() <= squaredRadius &&
+				   contact->normal.dot(located[c.seed].first->normal) >= cosAngle;
+		});
+
+		if (cluster == clusters.end())
+		{
+			Cluster newCluster;
+			newCluster.seed = i;
+			Vector3d normal = contact->normal, tangent1, tangent2;
+			if (!Math::buildOrthonormalBasis(&normal, &tangent1, &tangent2))
+			{
+				tangent1 = Vector3d::UnitX();
+				tangent2 = Vector3d::UnitY();
+			}
+			newCluster.directions = {{tangent1, -tangent1, tangent2, -tangent2}};
+			newCluster.extremes.fill(i);
+			newCluster.extents.fill(0.0);
+			clusters.push_back(newCluster);
+		}
+		else
+		{
+			const Vector3d offset = position - located[cluster->seed].second;
+			for (size_t k = 0; k < 4; ++k)
+			{
+				const double extent = cluster->directions[k].dot(offset);
+				if (extent > cluster->extents[k])
+				{
+					cluster->extents[k] = extent;
+					cluster->extremes[k] = i;
+				}
+			}
+		}
+	}
+
+	// Keep the deepest contacts of all the clusters first, then the extremes of the patches
+	size_t budget = (m_maxNumContacts > result.size()) ? m_maxNumContacts - result.size() : 0;
+	std::vector<bool> kept(located.size(), false);
+	auto keep = [&budget, &kept](size_t index)
+	{
+		if (budget > 0 && !kept[index])
+		{
+			kept[index] = true;
+			--budget;
+		}
+	};
+	for (const auto& cluster : clusters)
+	{
+		keep(cluster.seed);
+	}
+	for (size_t k = 0; k < 4; ++k)
+	{
+		for (const auto& cluster : clusters)
+		{
+			keep(cluster.extremes[k]);
+		}
+	}
+
+	for (size_t i = 0; i < located.size(); ++i)
+	{
+		if (kept[i])
+		{
+			result.push_back(located[i].first);
+		}
+	}
+	contacts.swap(result);
+}
+
+void ContactReductionFilter::doUpdate(double dt)
+{
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
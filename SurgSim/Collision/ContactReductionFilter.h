@@ -0,0 +1,109 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_COLLISION_CONTACTREDUCTIONFILTER_H
+#define SURGSIM_COLLISION_CONTACTREDUCTIONFILTER_H
+
+#include <memory>
+#include <string>
+
+#include "SurgSim/Collision/ContactFilter.h"
+
+namespace SurgSim
+{
+
+namespace Physics
+{
+class PhysicsManagerState;
+}
+
+namespace Collision
+{
+class CollisionPair;
+class Representation;
+
+SURGSIM_STATIC_REGISTRATION(ContactReductionFilter);
+
+/// Bounds the number of contacts on each collision pair, e.g. for the hundreds of near-duplicate contacts generated
+/// by a mesh resting on a plane or on another mesh, each of them becoming a constraint in the MLCP.
+/// When a pair has more than the maximum number of contacts, the contacts are clustered by spatial proximity and
+/// normal direction, and only a representative set is kept for each cluster: its deepest contact, and the extremes of
+/// the contact patch in the tangent plane, which preserve the support polygon. The deepest contacts of all the
+/// clusters are kept first, then the extremes, up to the maximum number of contacts.
+/// The contacts are located with the rigid local position of their penetration point on the first representation,
+/// contacts without it are always kept.
+class ContactReductionFilter : public ContactFilter
+{
+public:
+	/// Constructor
+	/// \param name Name of the filter
+	explicit ContactReductionFilter(const std::string& name);
+
+	SURGSIM_CLASSNAME(SurgSim::Collision::ContactReductionFilter);
+
+	bool doInitialize() override;
+
+	bool doWakeUp() override;
+
+	/// Restricts the filter to the pairs involving the given representation, can only be used before initialization
+	/// \param val The collision representation, nullptr to filter all the pairs (default)
+	void setRepresentation(const std::shared_ptr<SurgSim::Framework::Component>& val);
+
+	/// \return The collision representation whose pairs are filtered, nullptr if all the pairs are filtered
+	std::shared_ptr<SurgSim::Collision::Representation> getRepresentation() const;
+
+	/// \param maxNumContacts The maximum number of contacts kept on a pair
+	void setMaxNumContacts(size_t maxNumContacts);
+
+	/// \return The maximum number of contacts kept on a pair
+	size_t getMaxNumContacts() const;
+
+	/// \param radius The radius (in m) of the clusters, contacts farther than this from the deepest contact of a
+	/// cluster start a new cluster
+	void setClusterRadius(double radius);
+
+	/// \return The radius (in m) of the clusters
+	double getClusterRadius() const;
+
+	/// \param angle The maximum angle (in rad) between the normals of the contacts in a cluster
+	void setNormalAngle(double angle);
+
+	/// \return The maximum angle (in rad) between the normals of the contacts in a cluster
+	double getNormalAngle() const;
+
+protected:
+	void doFilterContacts(const std::shared_ptr<Physics::PhysicsManagerState>& state,
+						  const std::shared_ptr<CollisionPair>& pair) override;
+
+	void doUpdate(double dt) override;
+
+private:
+	/// Representation whose pairs are filtered, all the pairs if nullptr
+	std::shared_ptr<Collision::Representation> m_representation;
+
+	/// The maximum number of contacts kept on a pair
+	size_t m_maxNumContacts;
+
+	/// The radius of the clusters
+	double m_clusterRadius;
+
+	/// The maximum angle between the normals in a cluster
+	double m_normalAngle;
+};
+
+}; // namespace Collision
+}; // namespace SurgSim
+
+#endif // SURGSIM_COLLISION_CONTACTREDUCTIONFILTER_H
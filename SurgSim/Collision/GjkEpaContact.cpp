@@ -0,0 +1,110 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Collision/GjkEpaContact.h"
+
+#include "SurgSim/Collision/CollisionPair.h"
+#include "SurgSim/Collision/ContactManifold.h"
+#include "SurgSim/Collision/Representation.h"
+#include "SurgSim/DataStructures/Location.h"
+#include "SurgSim/Math/GjkEpa.h"
+
+using SurgSim::DataStructures::Location;
+using SurgSim::Math::Vector3d;
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+GjkEpaContact::GjkEpaContact(const std::pair<int, int>& types) : m_types(types)
+{
+}
+
+std::pair<int, int> GjkEpaContact::getShapeTypes()
+{
+	return m_types;
+}
+
+void GjkEpaContact::doCalculateContact(std::shared_ptr<CollisionPair> pair)
+{
+	SURGSIM_ASSERT(pair->getType() == COLLISION_DETECTION_TYPE_DISCRETE) <<
+			"GjkEpaContact only supports discrete collision detection";
+
+	if (pair->getFirst()->getShapeType() != m_types.first)
+	{
+		pair->swapRepresentations();
+	}
+	SURGSIM_ASSERT(pair->getFirst()->getShapeType() == m_types.first &&
+				   pair->getSecond()->getShapeType() == m_types.second) <<
+						   "Wrong type of objects " << pair->getFirst()->getShapeType() << ", " <<
+						   pair->getSecond()->getShapeType();
+
+	const auto posedShape1 = pair->getFirst()->getPosedShape();
+	const auto posedShape2 = pair->getSecond()->getPosedShape();
+	const Math::RigidTransform3d& pose1 = posedShape1.getPose();
+	const Math::RigidTransform3d& pose2 = posedShape2.getPose();
+
+	ContactManifold& manifold = pair->getContactManifold();
+	Vector3d normal;
+	double depth;
+	Vector3d localPoint1;
+	Vector3d localPoint2;
+	if (Math::calculateGjkEpaPenetration(*posedShape1.getShape(), pose1, *posedShape2.getShape(), pose2,
+										 &normal, &depth, &localPoint1, &localPoint2, manifold.getSimplex()))
+	{
+		manifold.addPoint(pose1, pose2, normal, depth, localPoint1, localPoint2);
+	}
+	else
+	{
+		manifold.refresh(pose1, pose2);
+	}
+
+	for (const auto& point : manifold.getPoints())
+	{
+		if (point.depth > 0.0)
+		{
+			pair->addContact(std::make_shared<Contact>(
+								 COLLISION_DETECTION_TYPE_DISCRETE, point.depth, 1.0, Vector3d::Zero(),
+								 manifold.getNormal(),
+								 std::make_pair(Location(point.localPoint1), Location(point.localPoint2))));
+		}
+	}
+}
+
+std::list<std::shared_ptr<Contact>> GjkEpaContact::doCalculateDcdContact(
+									 const Math::PosedShape<std::shared_ptr<Math::Shape>>& posedShape1,
+									 const Math::PosedShape<std::shared_ptr<Math::Shape>>& posedShape2)
+{
+	std::list<std::shared_ptr<Contact>> contacts;
+
+	Vector3d normal;
+	double depth;
+	Vector3d localPoint1;
+	Vector3d localPoint2;
+	if (Math::calculateGjkEpaPenetration(*posedShape1.getShape(), posedShape1.getPose(),
+										 *posedShape2.getShape(), posedShape2.getPose(),
+										 &normal, &depth, &localPoint1, &localPoint2) && depth > 0.0)
+	{
+		contacts.emplace_back(std::make_shared<Contact>(
+								  COLLISION_DETECTION_TYPE_DISCRETE, depth, 1.0, Vector3d::Zero(), normal,
+								  std::make_pair(Location(localPoint1), Location(localPoint2))));
+	}
+
+	return contacts;
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
@@ -0,0 +1,56 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_COLLISION_GJKEPACONTACT_H
+#define SURGSIM_COLLISION_GJKEPACONTACT_H
+
+#include "SurgSim/Collision/ContactCalculation.h"
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+/// Generic contact calculation between two convex shapes, based on their support functions
+/// (see Math::Shape::getSupportPoint), using GJK and EPA (see Math::calculateGjkEpaPenetration).
+/// It is registered for the pairs of convex shapes that do not have a dedicated contact calculation.
+/// When used on a CollisionPair, the GJK simplex and a persistent contact manifold are kept on the pair across the
+/// updates (see CollisionPair::getContactManifold), warm starting the query and building a stable contact patch of up
+/// to 4 points, e.g. for a box resting on another one. Otherwise, a single contact is generated.
+class GjkEpaContact : public ContactCalculation
+{
+public:
+	/// Constructor
+	/// \param types The pair of convex shape types handled by this instance
+	explicit GjkEpaContact(const std::pair<int, int>& types);
+
+	std::pair<int, int> getShapeTypes() override;
+
+protected:
+	void doCalculateContact(std::shared_ptr<CollisionPair> pair) override;
+
+	std::list<std::shared_ptr<Contact>> doCalculateDcdContact(
+										 const Math::PosedShape<std::shared_ptr<Math::Shape>>& posedShape1,
+										 const Math::PosedShape<std::shared_ptr<Math::Shape>>& posedShape2) override;
+
+private:
+	/// The shape types for this instance
+	std::pair<int, int> m_types;
+};
+
+}; // namespace Collision
+}; // namespace SurgSim
+
+#endif // SURGSIM_COLLISION_GJKEPACONTACT_H
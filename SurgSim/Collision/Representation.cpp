@@ -32,7 +32,8 @@ Representation::Representation(const std::string& name) :
 	m_aabbThreshold(0.01),
 	m_previousDcdPose(Math::RigidTransform3d::Identity()),
 	m_collisionDetectionType(COLLISION_DETECTION_TYPE_DISCRETE),
-	m_selfCollisionDetectionType(COLLISION_DETECTION_TYPE_NONE)
+	m_selfCollisionDetectionType(COLLISION_DETECTION_TYPE_NONE),
+	m_shapeVersion(0)
 {
 	m_previousDcdPose.translation() = Math::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN());
 	m_previousCcdCurrentPose.translation() = Math::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN());
@@ -81,6 +82,11 @@ void Representation::setPosedShapeMotion(const Math::PosedShapeMotion<std::share
 {
 	boost::unique_lock<boost::shared_mutex> lock(m_posedShapeMotionMutex);
 
+	if (posedShapeMotion.second.getShape() != m_posedShapeMotion.second.getShape() ||
+		!posedShapeMotion.second.getPose().isApprox(m_posedShapeMotion.second.getPose()))
+	{
+		++m_shapeVersion;
+	}
 	m_posedShapeMotion = posedShapeMotion;
 }
 
@@ -94,6 +100,17 @@ void Representation::invalidatePosedShapeMotion()
 	boost::unique_lock<boost::shared_mutex> lock(m_posedShapeMotionMutex);
 
 	m_posedShapeMotion.invalidate();
+	++m_shapeVersion;
+}
+
+size_t Representation::getShapeVersion() const
+{
+	return m_shapeVersion;
+}
+
+void Representation::markShapeChanged()
+{
+	++m_shapeVersion;
 }
 
 SurgSim::DataStructures::BufferedValue<ContactMapType>& Representation::getCollisions()
@@ -16,6 +16,7 @@
 #ifndef SURGSIM_COLLISION_REPRESENTATION_H
 #define SURGSIM_COLLISION_REPRESENTATION_H
 
+#include <atomic>
 #include <boost/thread/mutex.hpp>
 #include <list>
 #include <memory>
@@ -96,6 +97,10 @@ class Representation : public SurgSim::Framework::Representation
 	virtual const Math::PosedShape<std::shared_ptr<Math::Shape>>& getPosedShape();
 
 	/// \return the posed shape motion
+	/// \note Only the vertex positions of the shape at the start of the motion (first) are guaranteed to be valid, its
+	/// AabbTree, normals and bounding box may not be updated (see DeformableCollisionRepresentation). The swept
+	/// volumes are bounded by the swept AabbTree of the shape at the end of the motion, see
+	/// MeshShape::getSweptAabbTree().
 	const Math::PosedShapeMotion<std::shared_ptr<Math::Shape>>& getPosedShapeMotion() const;
 
 	/// A map between collision representations and contacts.
@@ -125,6 +130,15 @@ class Representation : public SurgSim::Framework::Representation
 	/// Update the data (the shape) in preparation for a DCD contact calculation
 	virtual void updateDcdData();
 
+	/// \return A counter incremented every time the posed shape of this representation changes, used to detect the
+	/// representations that have not changed since the last contact calculation (see CollisionPair::cacheContacts)
+	size_t getShapeVersion() const;
+
+	/// Notify that the shape has changed, invalidating the contacts cached against this representation.
+	/// The changes of pose or of shape instance are detected when the posed shape is set, the representations whose
+	/// shape is modified in place (e.g. the vertices of a deformable mesh) need to call this after each modification.
+	void markShapeChanged();
+
 	/// Update the data (the motionShape) in preparation for a CCD contact calcul  ation
 	/// \param timeOfImpact the last time of impact, the representation is responsible for managing
 	/// the time correctly
@@ -247,6 +261,9 @@ class Representation : public SurgSim::Framework::Representation
 	/// Mutex to lock write access to m_posedShapeMotion
 	mutable boost::shared_mutex m_posedShapeMotionMutex;
 
+	/// Counter of the changes of the posed shape, read by the collision pairs without locking
+	std::atomic<size_t> m_shapeVersion;
+
 	/// Ignored collision representations
 	std::unordered_set<std::string> m_ignoring;
 
@@ -0,0 +1,76 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Collision/SdfCapsuleContact.h"
+
+#include "SurgSim/Collision/Representation.h"
+#include "SurgSim/DataStructures/Location.h"
+
+using SurgSim::DataStructures::Location;
+using SurgSim::Math::Vector3d;
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+std::pair<int, int> SdfCapsuleContact::getShapeTypes()
+{
+	return std::pair<int, int>(Math::SHAPE_TYPE_SDF, Math::SHAPE_TYPE_CAPSULE);
+}
+
+std::list<std::shared_ptr<Contact>> SdfCapsuleContact::calculateDcdContact(
+									 const Math::SdfShape& sdf,
+									 const Math::RigidTransform3d& sdfPose,
+									 const Math::CapsuleShape& capsule,
+									 const Math::RigidTransform3d& capsulePose) const
+{
+	std::list<std::shared_ptr<Contact>> contacts;
+
+	// The capsule axis, in the sdf frame
+	const Math::RigidTransform3d transform = sdfPose.inverse() * capsulePose;
+	const Vector3d top = transform * capsule.topCenter();
+	const Vector3d bottom = transform * capsule.bottomCenter();
+
+	// The distance field is 1-Lipschitz, no point of the capsule can penetrate if its center is far enough
+	const double radius = capsule.getRadius();
+	if (sdf.getDistance(0.5 * (top + bottom)) > 0.5 * capsule.getLength() + radius)
+	{
+		return contacts;
+	}
+
+	Vector3d axisPoint;
+	const double distance = sdf.getSegmentDistance(top, bottom, &axisPoint);
+	Vector3d gradient;
+	sdf.getDistance(axisPoint, &gradient);
+	if (distance < radius && !gradient.isZero())
+	{
+		gradient.normalize();
+		// The normal goes from the capsule to the sdf
+		const Vector3d normal = -(sdfPose.linear() * gradient);
+
+		std::pair<Location, Location> penetrationPoints;
+		penetrationPoints.first.rigidLocalPosition.setValue(axisPoint - gradient * distance);
+		penetrationPoints.second.rigidLocalPosition.setValue(transform.inverse() * (axisPoint - gradient * radius));
+		contacts.emplace_back(std::make_shared<Contact>(
+								  COLLISION_DETECTION_TYPE_DISCRETE, radius - distance, 1.0,
+								  Vector3d::Zero(), normal, penetrationPoints));
+	}
+
+	return contacts;
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
@@ -0,0 +1,68 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Collision/SdfParticlesContact.h"
+
+#include "SurgSim/Collision/Representation.h"
+#include "SurgSim/DataStructures/Location.h"
+
+using SurgSim::DataStructures::Location;
+using SurgSim::Math::Vector3d;
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+std::pair<int, int> SdfParticlesContact::getShapeTypes()
+{
+	return std::pair<int, int>(Math::SHAPE_TYPE_SDF, Math::SHAPE_TYPE_PARTICLES);
+}
+
+std::list<std::shared_ptr<Contact>> SdfParticlesContact::calculateDcdContact(
+									 const Math::SdfShape& sdf,
+									 const Math::RigidTransform3d& sdfPose,
+									 const Math::ParticlesShape& particles,
+									 const Math::RigidTransform3d&) const
+{
+	std::list<std::shared_ptr<Contact>> contacts;
+
+	const Math::RigidTransform3d inverseSdfPose = sdfPose.inverse();
+	const double radius = particles.getRadius();
+	Vector3d gradient;
+	for (size_t particle = 0; particle < particles.getNumVertices(); ++particle)
+	{
+		const Vector3d position = inverseSdfPose * particles.getVertexPosition(particle);
+		const double distance = sdf.getDistance(position, &gradient);
+		if (distance < radius && !gradient.isZero())
+		{
+			gradient.normalize();
+			// The normal goes from the particle to the sdf
+			const Vector3d normal = -(sdfPose.linear() * gradient);
+
+			std::pair<Location, Location> penetrationPoints;
+			penetrationPoints.first.rigidLocalPosition.setValue(position - gradient * distance);
+			penetrationPoints.second = Location(particle);
+			contacts.emplace_back(std::make_shared<Contact>(
+									  COLLISION_DETECTION_TYPE_DISCRETE, radius - distance, 1.0,
+									  Vector3d::Zero(), normal, penetrationPoints));
+		}
+	}
+
+	return contacts;
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
@@ -0,0 +1,49 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_COLLISION_SDFPARTICLESCONTACT_H
+#define SURGSIM_COLLISION_SDFPARTICLESCONTACT_H
+
+#include <memory>
+
+#include "SurgSim/Collision/ShapeShapeContactCalculation.h"
+#include "SurgSim/Math/ParticlesShape.h"
+#include "SurgSim/Math/SdfShape.h"
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+/// Class to calculate intersections between a signed distance field and particles
+class SdfParticlesContact : public ShapeShapeContactCalculation<Math::SdfShape, Math::ParticlesShape>
+{
+public:
+	using ContactCalculation::calculateDcdContact;
+
+	/// \note The pose of the particles is ignored, the shape being already posed
+	std::list<std::shared_ptr<Contact>> calculateDcdContact(
+										 const Math::SdfShape& sdf,
+										 const Math::RigidTransform3d& sdfPose,
+										 const Math::ParticlesShape& particles,
+										 const Math::RigidTransform3d& particlesPose) const override;
+
+	std::pair<int, int> getShapeTypes() override;
+};
+
+}; // namespace Collision
+}; // namespace SurgSim
+
+#endif // SURGSIM_COLLISION_SDFPARTICLESCONTACT_H
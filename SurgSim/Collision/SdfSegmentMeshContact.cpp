@@ -0,0 +1,97 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Collision/SdfSegmentMeshContact.h"
+
+#include "SurgSim/Collision/Representation.h"
+#include "SurgSim/DataStructures/IndexedLocalCoordinate.h"
+#include "SurgSim/DataStructures/Location.h"
+#include "SurgSim/Math/Geometry.h"
+
+using SurgSim::DataStructures::IndexedLocalCoordinate;
+using SurgSim::DataStructures::Location;
+using SurgSim::Math::Vector2d;
+using SurgSim::Math::Vector3d;
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+std::pair<int, int> SdfSegmentMeshContact::getShapeTypes()
+{
+	return std::pair<int, int>(Math::SHAPE_TYPE_SDF, Math::SHAPE_TYPE_SEGMENTMESH);
+}
+
+std::list<std::shared_ptr<Contact>> SdfSegmentMeshContact::calculateDcdContact(
+									 const Math::SdfShape& sdf,
+									 const Math::RigidTransform3d& sdfPose,
+									 const Math::SegmentMeshShape& segmentMesh,
+									 const Math::RigidTransform3d& segmentMeshPose) const
+{
+	std::list<std::shared_ptr<Contact>> contacts;
+
+	const Math::RigidTransform3d inverseSdfPose = sdfPose.inverse();
+	const double radius = segmentMesh.getRadius();
+	const auto& edges = segmentMesh.getEdges();
+	for (size_t edgeId = 0; edgeId < edges.size(); ++edgeId)
+	{
+		if (!edges[edgeId].isValid)
+		{
+			continue;
+		}
+
+		const auto vertices = segmentMesh.getEdgePositions(edgeId);
+		const Vector3d start = inverseSdfPose * vertices[0];
+		const Vector3d end = inverseSdfPose * vertices[1];
+
+		// The distance field is 1-Lipschitz, no point of the segment can penetrate if its middle is far enough
+		if (sdf.getDistance(0.5 * (start + end)) > 0.5 * (end - start).norm() + radius)
+		{
+			continue;
+		}
+
+		Vector3d axisPoint;
+		const double distance = sdf.getSegmentDistance(start, end, &axisPoint);
+		Vector3d gradient;
+		sdf.getDistance(axisPoint, &gradient);
+		if (distance < radius && !gradient.isZero())
+		{
+			gradient.normalize();
+			// The normal goes from the segment to the sdf
+			const Vector3d normal = -(sdfPose.linear() * gradient);
+			const Vector3d globalAxisPoint = sdfPose * axisPoint;
+
+			std::pair<Location, Location> penetrationPoints;
+			penetrationPoints.first.rigidLocalPosition.setValue(axisPoint - gradient * distance);
+
+			Vector2d barycentricCoordinates;
+			Math::barycentricCoordinates(globalAxisPoint, vertices[0], vertices[1], &barycentricCoordinates);
+			penetrationPoints.second.elementMeshLocalCoordinate.setValue(
+				IndexedLocalCoordinate(edgeId, barycentricCoordinates));
+			penetrationPoints.second.rigidLocalPosition.setValue(
+				segmentMeshPose.inverse() * (globalAxisPoint + normal * radius));
+
+			contacts.emplace_back(std::make_shared<Contact>(
+									  COLLISION_DETECTION_TYPE_DISCRETE, radius - distance, 1.0,
+									  Vector3d::Zero(), normal, penetrationPoints));
+		}
+	}
+
+	return contacts;
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
@@ -0,0 +1,64 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Collision/SdfSphereContact.h"
+
+#include "SurgSim/Collision/Representation.h"
+#include "SurgSim/DataStructures/Location.h"
+
+using SurgSim::DataStructures::Location;
+using SurgSim::Math::Vector3d;
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+std::pair<int, int> SdfSphereContact::getShapeTypes()
+{
+	return std::pair<int, int>(Math::SHAPE_TYPE_SDF, Math::SHAPE_TYPE_SPHERE);
+}
+
+std::list<std::shared_ptr<Contact>> SdfSphereContact::calculateDcdContact(
+									 const Math::SdfShape& sdf,
+									 const Math::RigidTransform3d& sdfPose,
+									 const Math::SphereShape& sphere,
+									 const Math::RigidTransform3d& spherePose) const
+{
+	std::list<std::shared_ptr<Contact>> contacts;
+
+	const Vector3d center = sdfPose.inverse() * spherePose.translation();
+	Vector3d gradient;
+	const double distance = sdf.getDistance(center, &gradient);
+	if (distance < sphere.getRadius() && !gradient.isZero())
+	{
+		gradient.normalize();
+		// The normal goes from the sphere to the sdf
+		const Vector3d normal = -(sdfPose.linear() * gradient);
+
+		std::pair<Location, Location> penetrationPoints;
+		penetrationPoints.first.rigidLocalPosition.setValue(center - gradient * distance);
+		penetrationPoints.second.rigidLocalPosition.setValue(
+			(spherePose.linear().transpose() * normal) * sphere.getRadius());
+		contacts.emplace_back(std::make_shared<Contact>(
+								  COLLISION_DETECTION_TYPE_DISCRETE, sphere.getRadius() - distance, 1.0,
+								  Vector3d::Zero(), normal, penetrationPoints));
+	}
+
+	return contacts;
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
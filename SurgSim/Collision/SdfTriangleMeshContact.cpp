@@ -0,0 +1,104 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Collision/SdfTriangleMeshContact.h"
+
+#include <limits>
+#include <vector>
+
+#include "SurgSim/Collision/Representation.h"
+#include "SurgSim/DataStructures/IndexedLocalCoordinate.h"
+#include "SurgSim/DataStructures/Location.h"
+
+using SurgSim::DataStructures::IndexedLocalCoordinate;
+using SurgSim::DataStructures::Location;
+using SurgSim::Math::Vector3d;
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+std::pair<int, int> SdfTriangleMeshContact::getShapeTypes()
+{
+	return std::pair<int, int>(Math::SHAPE_TYPE_SDF, Math::SHAPE_TYPE_MESH);
+}
+
+std::list<std::shared_ptr<Contact>> SdfTriangleMeshContact::calculateDcdContact(
+									 const Math::SdfShape& sdf,
+									 const Math::RigidTransform3d& sdfPose,
+									 const Math::MeshShape& mesh,
+									 const Math::RigidTransform3d& meshPose) const
+{
+	std::list<std::shared_ptr<Contact>> contacts;
+
+	// The contacts are located on a triangle of the vertex, for the deformable representations to localize them
+	const size_t noTriangle = std::numeric_limits<size_t>::max();
+	std::vector<std::pair<size_t, size_t>> vertexTriangles(mesh.getNumVertices(), std::make_pair(noTriangle, 0));
+	const auto& triangles = mesh.getTriangles();
+	for (size_t triangleId = 0; triangleId < triangles.size(); ++triangleId)
+	{
+		if (triangles[triangleId].isValid)
+		{
+			for (size_t corner = 0; corner < 3; ++corner)
+			{
+				auto& vertexTriangle = vertexTriangles[triangles[triangleId].verticesId[corner]];
+				if (vertexTriangle.first == noTriangle)
+				{
+					vertexTriangle = std::make_pair(triangleId, corner);
+				}
+			}
+		}
+	}
+
+	const Math::RigidTransform3d inverseSdfPose = sdfPose.inverse();
+	const Math::RigidTransform3d inverseMeshPose = meshPose.inverse();
+	Vector3d gradient;
+	for (size_t vertexId = 0; vertexId < mesh.getNumVertices(); ++vertexId)
+	{
+		if (vertexTriangles[vertexId].first == noTriangle)
+		{
+			continue;
+		}
+
+		const Vector3d& globalPosition = mesh.getVertexPosition(vertexId);
+		const Vector3d position = inverseSdfPose * globalPosition;
+		const double distance = sdf.getDistance(position, &gradient);
+		if (distance < 0.0 && !gradient.isZero())
+		{
+			gradient.normalize();
+			// The normal goes from the mesh to the sdf
+			const Vector3d normal = -(sdfPose.linear() * gradient);
+
+			std::pair<Location, Location> penetrationPoints;
+			penetrationPoints.first.rigidLocalPosition.setValue(position - gradient * distance);
+
+			Vector3d barycentricCoordinates = Vector3d::Zero();
+			barycentricCoordinates[vertexTriangles[vertexId].second] = 1.0;
+			penetrationPoints.second.triangleMeshLocalCoordinate.setValue(
+				IndexedLocalCoordinate(vertexTriangles[vertexId].first, barycentricCoordinates));
+			penetrationPoints.second.rigidLocalPosition.setValue(inverseMeshPose * globalPosition);
+
+			contacts.emplace_back(std::make_shared<Contact>(
+									  COLLISION_DETECTION_TYPE_DISCRETE, -distance, 1.0,
+									  Vector3d::Zero(), normal, penetrationPoints));
+		}
+	}
+
+	return contacts;
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
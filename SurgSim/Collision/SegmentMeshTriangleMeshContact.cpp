@@ -15,6 +15,8 @@
 
 #include "SurgSim/Collision/SegmentMeshTriangleMeshContact.h"
 
+#include <vector>
+
 #include "SurgSim/Collision/CollisionPair.h"
 #include "SurgSim/Collision/Representation.h"
 #include "SurgSim/DataStructures/AabbTree.h"
@@ -25,6 +27,7 @@
 #include "SurgSim/Math/MeshShape.h"
 #include "SurgSim/Math/RigidTransform.h"
 #include "SurgSim/Math/SegmentMeshShape.h"
+#include "SurgSim/Math/SweptAabbTree.h"
 
 using SurgSim::DataStructures::Location;
 using SurgSim::DataStructures::TriangleMesh;
@@ -181,8 +184,16 @@ std::list<std::shared_ptr<Contact>>SegmentMeshTriangleMeshContact::calculateCcdC
 	SURGSIM_ASSERT(shape2AtTime0.getNumTriangles() > 0);
 	SURGSIM_ASSERT(shape2AtTime0.getNumTriangles() == shape2AtTime1.getNumTriangles());
 
-	for (size_t edgeId = 0; edgeId < shape1AtTime0.getNumEdges(); edgeId++)
+	// A single tree over the swept volumes of each mesh gives the pairs of primitives that can collide during the
+	// motion, in increasing order of edge then triangle ids
+	std::vector<std::pair<size_t, size_t>> candidates;
+	Math::getSweptCandidates(*Math::getSweptAabbTree(shape1AtTime0, shape1AtTime1),
+							 *Math::getSweptAabbTree(shape2AtTime0, shape2AtTime1), &candidates);
+
+	auto candidate = candidates.begin();
+	while (candidate != candidates.end())
 	{
+		const size_t edgeId = candidate->first;
 		auto edgeT0 = shape1AtTime0.getEdge(edgeId);
 		auto edgeT1 = shape1AtTime1.getEdge(edgeId);
 
@@ -197,14 +208,10 @@ std::list<std::shared_ptr<Contact>>SegmentMeshTriangleMeshContact::calculateCcdC
 		std::pair<Math::Vector3d, Math::Vector3d> sv1 = std::make_pair(
 					shape1AtTime0.getVertexPosition(edgeT0.verticesId[1]),
 					shape1AtTime1.getVertexPosition(edgeT1.verticesId[1]));
-		Math::Aabbd segmentAabb;
-		segmentAabb.extend(sv0.first);
-		segmentAabb.extend(sv0.second);
-		segmentAabb.extend(sv1.first);
-		segmentAabb.extend(sv1.second);
 
-		for (size_t triangleId = 0; triangleId < shape2AtTime0.getNumTriangles(); triangleId++)
+		for (; candidate != candidates.end() && candidate->first == edgeId; ++candidate)
 		{
+			const size_t triangleId = candidate->second;
 			auto triangleT0 = shape2AtTime0.getTriangle(triangleId);
 			auto triangleT1 = shape2AtTime1.getTriangle(triangleId);
 
@@ -225,19 +232,6 @@ std::list<std::shared_ptr<Contact>>SegmentMeshTriangleMeshContact::calculateCcdC
 						shape2AtTime0.getVertexPosition(triangleT0.verticesId[2]),
 						shape2AtTime1.getVertexPosition(triangleT1.verticesId[2]));
 
-			Math::Aabbd triangleAabb;
-			triangleAabb.extend(tv0.first);
-			triangleAabb.extend(tv0.second);
-			triangleAabb.extend(tv1.first);
-			triangleAabb.extend(tv1.second);
-			triangleAabb.extend(tv2.first);
-			triangleAabb.extend(tv2.second);
-
-			if (!SurgSim::Math::doAabbIntersect(segmentAabb, triangleAabb))
-			{
-				continue;
-			}
-
 			double earliestTimeOfImpact = std::numeric_limits<double>::max();
 			double segmentAlpha = -1.0;  //!< Barycentric coordinates of P in the segment sv0sv1
 			//!< P = sv0 + segmentAlpha.sv0sv1
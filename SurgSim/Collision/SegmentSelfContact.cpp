@@ -23,6 +23,7 @@
 #include "SurgSim/Math/MeshShape.h"
 #include "SurgSim/Math/Scalar.h"
 #include "SurgSim/Math/SegmentMeshShape.h"
+#include "SurgSim/Math/SweptAabbTree.h"
 
 using SurgSim::DataStructures::Location;
 using SurgSim::Math::MeshShape;
@@ -106,32 +107,8 @@ std::list<std::shared_ptr<Contact>> SegmentSelfContact::calculateCcdContact(
 	std::set<std::pair<size_t, size_t>> segmentIds;
 
 	// Use a local aabb tree for the movement volume to calculate the first set of possible intersections.
-	auto const& edges1 = segmentShape1.getEdges();
-	auto const& edges2 = segmentShape2.getEdges();
-	const Math::Vector3d halfExtent = Math::Vector3d(segmentShape1.getRadius(), segmentShape1.getRadius(),
-									  segmentShape1.getRadius());
-	SurgSim::DataStructures::AabbTreeData::ItemList items;
-	for (size_t id = 0; id < edges1.size(); ++id)
-	{
-		if (edges1[id].isValid && edges2[id].isValid)
-		{
-			const auto& vertices1 = segmentShape1.getEdgePositions(id);
-			Math::Aabbd aabb((vertices1[0] - halfExtent).eval());
-			aabb.extend((vertices1[0] + halfExtent).eval());
-			aabb.extend((vertices1[1] - halfExtent).eval());
-			aabb.extend((vertices1[1] + halfExtent).eval());
-			const auto& vertices2 = segmentShape2.getEdgePositions(id);
-			aabb.extend((vertices2[0] - halfExtent).eval());
-			aabb.extend((vertices2[0] + halfExtent).eval());
-			aabb.extend((vertices2[1] - halfExtent).eval());
-			aabb.extend((vertices2[1] + halfExtent).eval());
-			items.emplace_back(aabb, id);
-		}
-	}
-	DataStructures::AabbTree tree;
-	tree.set(std::move(items));
-
-	auto intersectionList = tree.spatialJoin(tree);
+	auto tree = Math::getSweptAabbTree(segmentShape1, segmentShape2);
+	auto intersectionList = tree->spatialJoin(*tree);
 	getUniqueCandidates(intersectionList, &segmentIds);
 
 	size_t evaluations = 0;
@@ -15,6 +15,8 @@
 
 #include "SurgSim/Collision/TriangleMeshTriangleMeshContact.h"
 
+#include <vector>
+
 #include "SurgSim/Collision/CollisionPair.h"
 #include "SurgSim/Collision/Representation.h"
 #include "SurgSim/DataStructures/AabbTree.h"
@@ -24,6 +26,7 @@
 #include "SurgSim/Math/Geometry.h"
 #include "SurgSim/Math/MeshShape.h"
 #include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/SweptAabbTree.h"
 
 using SurgSim::DataStructures::Location;
 using SurgSim::DataStructures::TriangleMesh;
@@ -249,27 +252,16 @@ std::list<std::shared_ptr<Contact>> TriangleMeshTriangleMeshContact::calculateCc
 	SURGSIM_ASSERT(shape1AtTime0.getNumTriangles() == shape1AtTime1.getNumTriangles());
 	SURGSIM_ASSERT(shape2AtTime0.getNumTriangles() == shape2AtTime1.getNumTriangles());
 
-	const size_t shape2NumTriangles = shape2AtTime0.getNumTriangles();
-
-	std::vector<Math::Aabbd> shape2_aabbs(shape2NumTriangles);
-
-	for (size_t id = 0; id < shape2NumTriangles; id++)
-	{
-			auto& aabb = shape2_aabbs[id];
-			const auto& triangleT0 = shape2AtTime0.getTriangle(id);
-			aabb.extend(shape2AtTime0.getVertexPosition(triangleT0.verticesId[0]));
-			aabb.extend(shape2AtTime0.getVertexPosition(triangleT0.verticesId[1]));
-			aabb.extend(shape2AtTime0.getVertexPosition(triangleT0.verticesId[2]));
-
-			const auto& triangleT1 = shape2AtTime1.getTriangle(id);
-			aabb.extend(shape2AtTime1.getVertexPosition(triangleT1.verticesId[0]));
-			aabb.extend(shape2AtTime1.getVertexPosition(triangleT1.verticesId[1]));
-			aabb.extend(shape2AtTime1.getVertexPosition(triangleT1.verticesId[2]));
-	}
-
+	// A single tree over the swept volumes of each mesh gives the pairs of triangles that can collide during the
+	// motion, in increasing order of ids
+	std::vector<std::pair<size_t, size_t>> candidates;
+	Math::getSweptCandidates(*Math::getSweptAabbTree(shape1AtTime0, shape1AtTime1),
+							 *Math::getSweptAabbTree(shape2AtTime0, shape2AtTime1), &candidates);
 
-	for (size_t triangle1Id = 0; triangle1Id < shape1AtTime0.getNumTriangles(); triangle1Id++)
+	auto candidate = candidates.begin();
+	while (candidate != candidates.end())
 	{
+		const size_t triangle1Id = candidate->first;
 		const auto& triangle1T0 = shape1AtTime0.getTriangle(triangle1Id);
 		const auto& triangle1T1 = shape1AtTime1.getTriangle(triangle1Id);
 
@@ -283,16 +275,9 @@ std::list<std::shared_ptr<Contact>> TriangleMeshTriangleMeshContact::calculateCc
 			shape1AtTime0.getVertexPosition(triangle1T0.verticesId[2]),
 			shape1AtTime1.getVertexPosition(triangle1T1.verticesId[2]));
 
-		Math::Aabbd triangle1Aabb;
-		triangle1Aabb.extend(t1v0.first);
-		triangle1Aabb.extend(t1v0.second);
-		triangle1Aabb.extend(t1v1.first);
-		triangle1Aabb.extend(t1v1.second);
-		triangle1Aabb.extend(t1v2.first);
-		triangle1Aabb.extend(t1v2.second);
-
-		for (size_t triangle2Id = 0; triangle2Id < shape2AtTime0.getNumTriangles(); triangle2Id++)
+		for (; candidate != candidates.end() && candidate->first == triangle1Id; ++candidate)
 		{
+			const size_t triangle2Id = candidate->second;
 			auto triangle2T0 = shape2AtTime0.getTriangle(triangle2Id);
 			auto triangle2T1 = shape2AtTime1.getTriangle(triangle2Id);
 
@@ -306,13 +291,6 @@ std::list<std::shared_ptr<Contact>> TriangleMeshTriangleMeshContact::calculateCc
 				shape2AtTime0.getVertexPosition(triangle2T0.verticesId[2]),
 				shape2AtTime1.getVertexPosition(triangle2T1.verticesId[2]));
 
-			const Math::Aabbd& triangle2Aabb = shape2_aabbs[triangle2Id];
-
-			if (!SurgSim::Math::doAabbIntersect(triangle1Aabb, triangle2Aabb))
-			{
-				continue;
-			}
-
 			Math::Vector3d t1n = ((t1v1.first - t1v0.first).cross(t1v2.first - t1v0.first));
 			if (t1n.norm() < Math::Geometry::DistanceEpsilon)
 			{
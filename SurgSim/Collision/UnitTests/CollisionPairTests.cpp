@@ -230,5 +230,48 @@ TEST(CollisionPairTests, addContactTest)
 	rep1->retire();
 }
 
+TEST(CollisionPairTests, CachedContactsTest)
+{
+	std::shared_ptr<Representation> rep0 = makeSphereRepresentation(1.0);
+	std::shared_ptr<Representation> rep1 = makeSphereRepresentation(2.0);
+	CollisionPair pair(rep0, rep1);
+
+	EXPECT_FALSE(pair.restoreCachedContacts());
+
+	pair.addDcdContact(0.5, Vector3d::UnitY(), std::make_pair(Location(Vector3d(0.1, 0.2, 0.3)),
+					   Location(Vector3d(0.4, 0.5, 0.6))));
+	pair.cacheContacts();
+	pair.clearContacts();
+
+	// Neither representation has changed
+	ASSERT_TRUE(pair.restoreCachedContacts());
+	ASSERT_EQ(1u, pair.getContacts().size());
+	EXPECT_DOUBLE_EQ(0.5, pair.getContacts().front()->depth);
+	EXPECT_TRUE(pair.getContacts().front()->normal.isApprox(Vector3d::UnitY()));
+
+	// Setting the same pose does not invalidate the contacts
+	const size_t version = rep1->getShapeVersion();
+	rep1->setLocalPose(rep1->getLocalPose());
+	EXPECT_EQ(version, rep1->getShapeVersion());
+	EXPECT_TRUE(pair.restoreCachedContacts());
+
+	// A change of pose does
+	rep1->setLocalPose(Math::makeRigidTranslation(Vector3d(0.0, 0.1, 0.0)));
+	EXPECT_NE(version, rep1->getShapeVersion());
+	EXPECT_FALSE(pair.restoreCachedContacts());
+
+	// As well as a change of the shape itself
+	pair.cacheContacts();
+	EXPECT_TRUE(pair.restoreCachedContacts());
+	rep0->markShapeChanged();
+	EXPECT_FALSE(pair.restoreCachedContacts());
+
+	// Swapping the representations clears the cache
+	pair.cacheContacts();
+	pair.clearContacts();
+	pair.swapRepresentations();
+	EXPECT_FALSE(pair.restoreCachedContacts());
+}
+
 }; // namespace Collision
 }; // namespace SurgSim
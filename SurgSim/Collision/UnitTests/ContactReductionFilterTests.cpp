@@ -0,0 +1,204 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "SurgSim/Collision/CollisionPair.h"
+#include "SurgSim/Collision/ContactReductionFilter.h"
+#include "SurgSim/Collision/ShapeCollisionRepresentation.h"
+#include "SurgSim/DataStructures/Location.h"
+#include "SurgSim/Framework/FrameworkConvert.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/PlaneShape.h"
+#include "SurgSim/Math/Vector.h"
+
+using SurgSim::DataStructures::Location;
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+
+std::shared_ptr<SurgSim::Collision::Contact> makeContact(const Vector3d& position, double depth,
+		const Vector3d& normal)
+{
+	std::pair<Location, Location> penetrationPoints;
+	penetrationPoints.first.rigidLocalPosition.setValue(position);
+	penetrationPoints.second.rigidLocalPosition.setValue(position - normal * depth);
+	return std::make_shared<SurgSim::Collision::Contact>(
+			   SurgSim::Collision::COLLISION_DETECTION_TYPE_DISCRETE, depth, 1.0,
+			   Vector3d::Zero(), normal, penetrationPoints);
+}
+
+}
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+class ContactReductionFilterTest : public testing::Test
+{
+public:
+	void SetUp()
+	{
+		filter = std::make_shared<ContactReductionFilter>("filter");
+		auto rep1 = std::make_shared<ShapeCollisionRepresentation>("rep1");
+		rep1->setShape(std::make_shared<Math::MeshShape>());
+		auto rep2 = std::make_shared<ShapeCollisionRepresentation>("rep2");
+		rep2->setShape(std::make_shared<Math::PlaneShape>());
+		pair = std::make_shared<CollisionPair>(rep1, rep2);
+	}
+
+	std::shared_ptr<Physics::PhysicsManagerState> state;
+	std::shared_ptr<ContactReductionFilter> filter;
+	std::shared_ptr<CollisionPair> pair;
+};
+
+TEST_F(ContactReductionFilterTest, Accessors)
+{
+	EXPECT_EQ(16u, filter->getMaxNumContacts());
+	EXPECT_EQ(nullptr, filter->getRepresentation());
+
+	filter->setValue("MaxNumContacts", static_cast<size_t>(8));
+	EXPECT_EQ(8u, filter->getValue<size_t>("MaxNumContacts"));
+	EXPECT_THROW(filter->setMaxNumContacts(0), Framework::AssertionFailure);
+
+	filter->setValue("ClusterRadius", 0.5);
+	EXPECT_DOUBLE_EQ(0.5, filter->getValue<double>("ClusterRadius"));
+	EXPECT_THROW(filter->setClusterRadius(-1.0), Framework::AssertionFailure);
+
+	filter->setValue("NormalAngle", 0.1);
+	EXPECT_DOUBLE_EQ(0.1, filter->getValue<double>("NormalAngle"));
+	EXPECT_THROW(filter->setNormalAngle(4.0), Framework::AssertionFailure);
+
+	std::shared_ptr<Framework::Component> rep = pair->getFirst();
+	filter->setValue("Representation", rep);
+	EXPECT_EQ(rep, filter->getValue<std::shared_ptr<Representation>>("Representation"));
+}
+
+TEST_F(ContactReductionFilterTest, Serialization)
+{
+	filter->setMaxNumContacts(6);
+	filter->setClusterRadius(0.2);
+	filter->setNormalAngle(0.3);
+
+	YAML::Node node;
+	ASSERT_NO_THROW(node = YAML::convert<Framework::Component>::encode(*filter));
+
+	std::shared_ptr<ContactReductionFilter> newFilter;
+	ASSERT_NO_THROW(newFilter = std::dynamic_pointer_cast<ContactReductionFilter>(
+									node.as<std::shared_ptr<Framework::Component>>()));
+	ASSERT_NE(nullptr, newFilter);
+	EXPECT_EQ(6u, newFilter->getMaxNumContacts());
+	EXPECT_DOUBLE_EQ(0.2, newFilter->getClusterRadius());
+	EXPECT_DOUBLE_EQ(0.3, newFilter->getNormalAngle());
+}
+
+TEST_F(ContactReductionFilterTest, FewContacts)
+{
+	filter->setMaxNumContacts(4);
+	for (int i = 0; i < 4; ++i)
+	{
+		pair->addContact(makeContact(Vector3d(0.001 * i, 0.0, 0.0), 0.01, Vector3d::UnitY()));
+	}
+	filter->filterContacts(state, pair);
+	EXPECT_EQ(4u, pair->getContacts().size());
+}
+
+TEST_F(ContactReductionFilterTest, PatchReduction)
+{
+	// A 11x11 grid of contacts, the deepest one being in the middle
+	filter->setMaxNumContacts(5);
+	filter->setClusterRadius(1.0);
+	for (int i = -5; i <= 5; ++i)
+	{
+		for (int j = -5; j <= 5; ++j)
+		{
+			pair->addContact(makeContact(Vector3d(0.01 * i, 0.0, 0.01 * j), 0.01 - 0.0001 * (i * i + j * j),
+										 Vector3d::UnitY()));
+		}
+	}
+	ASSERT_EQ(121u, pair->getContacts().size());
+
+	filter->filterContacts(state, pair);
+	ASSERT_EQ(5u, pair->getContacts().size());
+
+	// The deepest contact, then the extremes of the patch
+	const auto& contacts = pair->getContacts();
+	EXPECT_DOUBLE_EQ(0.01, contacts.front()->depth);
+	EXPECT_TRUE(contacts.front()->penetrationPoints.first.rigidLocalPosition.getValue().isZero());
+	for (auto contact = std::next(contacts.begin()); contact != contacts.end(); ++contact)
+	{
+		const Vector3d& position = (*contact)->penetrationPoints.first.rigidLocalPosition.getValue();
+		EXPECT_NEAR(0.05, position.cwiseAbs().maxCoeff(), 1e-12);
+	}
+}
+
+TEST_F(ContactReductionFilterTest, Clusters)
+{
+	filter->setMaxNumContacts(6);
+	filter->setClusterRadius(0.1);
+	filter->setNormalAngle(0.1);
+
+	// Two patches far apart, and a patch with a different normal at the same location as the first one
+	for (int i = 0; i < 10; ++i)
+	{
+		pair->addContact(makeContact(Vector3d(0.001 * i, 0.0, 0.0), 0.01 + 0.001 * i, Vector3d::UnitY()));
+		pair->addContact(makeContact(Vector3d(1.0 + 0.001 * i, 0.0, 0.0), 0.02 + 0.001 * i, Vector3d::UnitY()));
+		pair->addContact(makeContact(Vector3d(0.001 * i, 0.0, 0.0), 0.001 * i, Vector3d::UnitX()));
+	}
+	// A contact that can't be located is kept
+	auto contact = makeContact(Vector3d::Zero(), 0.0, Vector3d::UnitY());
+	contact->penetrationPoints.first.rigidLocalPosition.invalidate();
+	pair->addContact(contact);
+
+	filter->filterContacts(state, pair);
+	const auto& contacts = pair->getContacts();
+	ASSERT_EQ(6u, contacts.size());
+	EXPECT_NE(contacts.end(), std::find(contacts.begin(), contacts.end(), contact));
+
+	// The deepest contacts of the 3 clusters are kept first
+	std::vector<double> depths;
+	for (const auto& c : contacts)
+	{
+		depths.push_back(c->depth);
+	}
+	EXPECT_NE(depths.end(), std::find(depths.begin(), depths.end(), 0.01 + 0.001 * 9));
+	EXPECT_NE(depths.end(), std::find(depths.begin(), depths.end(), 0.02 + 0.001 * 9));
+	EXPECT_NE(depths.end(), std::find(depths.begin(), depths.end(), 0.001 * 9));
+}
+
+TEST_F(ContactReductionFilterTest, Representation)
+{
+	filter->setMaxNumContacts(1);
+	filter->setClusterRadius(1.0);
+	filter->setRepresentation(std::make_shared<ShapeCollisionRepresentation>("other"));
+	for (int i = 0; i < 3; ++i)
+	{
+		pair->addContact(makeContact(Vector3d(0.001 * i, 0.0, 0.0), 0.01, Vector3d::UnitY()));
+	}
+
+	filter->filterContacts(state, pair);
+	EXPECT_EQ(3u, pair->getContacts().size());
+
+	filter->setRepresentation(pair->getSecond());
+	filter->filterContacts(state, pair);
+	EXPECT_EQ(1u, pair->getContacts().size());
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
@@ -0,0 +1,202 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "SurgSim/Collision/BoxSphereContact.h"
+#include "SurgSim/Collision/ContactManifold.h"
+#include "SurgSim/Collision/GjkEpaContact.h"
+#include "SurgSim/Collision/UnitTests/ContactCalculationTestsCommon.h"
+#include "SurgSim/Math/BoxShape.h"
+#include "SurgSim/Math/CapsuleShape.h"
+#include "SurgSim/Math/CylinderShape.h"
+#include "SurgSim/Math/SphereShape.h"
+
+using SurgSim::Math::BoxShape;
+using SurgSim::Math::CapsuleShape;
+using SurgSim::Math::CylinderShape;
+using SurgSim::Math::makeRigidTransform;
+using SurgSim::Math::makeRigidTranslation;
+using SurgSim::Math::makeRotationQuaternion;
+using SurgSim::Math::SphereShape;
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+TEST(GjkEpaContactCalculationTests, TableTest)
+{
+	const auto& table = ContactCalculation::getDcdContactTable();
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<GjkEpaContact>(
+				  table[Math::SHAPE_TYPE_BOX][Math::SHAPE_TYPE_BOX]));
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<GjkEpaContact>(
+				  table[Math::SHAPE_TYPE_CYLINDER][Math::SHAPE_TYPE_CAPSULE]));
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<GjkEpaContact>(
+				  table[Math::SHAPE_TYPE_CAPSULE][Math::SHAPE_TYPE_CYLINDER]));
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<GjkEpaContact>(
+				  table[Math::SHAPE_TYPE_CAPSULE][Math::SHAPE_TYPE_CAPSULE]));
+
+	// The dedicated calculations are kept
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<BoxSphereContact>(
+				  table[Math::SHAPE_TYPE_BOX][Math::SHAPE_TYPE_SPHERE]));
+}
+
+TEST(GjkEpaContactCalculationTests, BoxSphereComparisonTest)
+{
+	// Compare with the dedicated box/sphere calculation
+	auto box = std::make_shared<BoxShape>(0.1, 0.2, 0.3);
+	auto sphere = std::make_shared<SphereShape>(0.05);
+	typedef Math::PosedShape<std::shared_ptr<Math::Shape>> PosedShape;
+	GjkEpaContact calculation(std::make_pair(Math::SHAPE_TYPE_BOX, Math::SHAPE_TYPE_SPHERE));
+	BoxSphereContact expectedCalculation;
+
+	std::srand(1);
+	size_t numContacts = 0;
+	for (int i = 0; i < 100; ++i)
+	{
+		const RigidTransform3d boxPose = makeRigidTransform(Quaterniond(Math::Vector4d::Random()).normalized(),
+										 Vector3d::Random() * 0.01);
+		const RigidTransform3d spherePose = makeRigidTranslation(boxPose * Vector3d(0.09 * Vector3d::Random()));
+
+		auto contacts = calculation.calculateDcdContact(PosedShape(box, boxPose), PosedShape(sphere, spherePose));
+		auto expectedContacts = expectedCalculation.calculateDcdContact(PosedShape(box, boxPose),
+								PosedShape(sphere, spherePose));
+		ASSERT_EQ(expectedContacts.size(), contacts.size());
+		if (!contacts.empty())
+		{
+			++numContacts;
+			const auto& contact = contacts.front();
+			const auto& expected = expectedContacts.front();
+			EXPECT_NEAR(expected->depth, contact->depth, 1e-4);
+			EXPECT_TRUE(expected->normal.isApprox(contact->normal, 2e-2));
+			EXPECT_TRUE(contact->penetrationPoints.first.rigidLocalPosition.hasValue());
+			EXPECT_TRUE(contact->penetrationPoints.second.rigidLocalPosition.hasValue());
+		}
+	}
+	EXPECT_LT(50u, numContacts);
+}
+
+TEST(GjkEpaContactCalculationTests, ManifoldTest)
+{
+	// A box resting on a larger one, slightly tilted
+	auto boxRep1 = std::make_shared<ShapeCollisionRepresentation>("Box1");
+	boxRep1->setShape(std::make_shared<BoxShape>(0.1, 0.1, 0.1));
+	auto boxRep2 = std::make_shared<ShapeCollisionRepresentation>("Box2");
+	boxRep2->setShape(std::make_shared<BoxShape>(1.0, 0.1, 1.0));
+	boxRep2->setLocalPose(makeRigidTranslation(Vector3d(0.0, -0.1, 0.0)));
+
+	auto calculation = ContactCalculation::getDcdContactTable()[Math::SHAPE_TYPE_BOX][Math::SHAPE_TYPE_BOX];
+	auto pair = std::make_shared<CollisionPair>(boxRep1, boxRep2);
+
+	// The box rocks on its base, touching with a different corner at each update
+	const std::array<Vector3d, 4> axes = {{Vector3d(1.0, 0.0, 1.0), Vector3d(1.0, 0.0, -1.0),
+			Vector3d(-1.0, 0.0, -1.0), Vector3d(-1.0, 0.0, 1.0)
+		}
+	};
+	for (size_t i = 0; i < 8; ++i)
+	{
+		boxRep1->setLocalPose(makeRigidTransform(makeRotationQuaternion(0.01, axes[i % 4].normalized()),
+								Vector3d(0.0, -0.0005, 0.0)));
+		pair->clearContacts();
+		calculation->calculateContact(pair);
+		EXPECT_GE(ContactManifold::MaxNumPoints, pair->getContacts().size());
+		for (const auto& contact : pair->getContacts())
+		{
+			EXPECT_TRUE(contact->normal.isApprox(Vector3d::UnitY(), 1e-2));
+			EXPECT_LT(0.0, contact->depth);
+		}
+	}
+
+	// The manifold has gathered the 4 corners of the base
+	const auto& points = pair->getContactManifold().getPoints();
+	ASSERT_EQ(4u, points.size());
+	for (const auto& point : points)
+	{
+		EXPECT_NEAR(-0.05, point.localPoint1[1], 1e-3);
+		EXPECT_NEAR(0.05, std::abs(point.localPoint1[0]), 1e-3);
+		EXPECT_NEAR(0.05, std::abs(point.localPoint1[2]), 1e-3);
+	}
+
+	// Resting flat, all the corners are in contact
+	boxRep1->setLocalPose(makeRigidTranslation(Vector3d(0.0, -0.0005, 0.0)));
+	pair->clearContacts();
+	calculation->calculateContact(pair);
+	ASSERT_EQ(4u, pair->getContacts().size());
+	for (const auto& contact : pair->getContacts())
+	{
+		EXPECT_NEAR(0.0005, contact->depth, 1e-6);
+	}
+
+	// Lifting the box breaks the manifold
+	boxRep1->setLocalPose(makeRigidTranslation(Vector3d(0.0, 0.01, 0.0)));
+	pair->clearContacts();
+	calculation->calculateContact(pair);
+	EXPECT_TRUE(pair->getContacts().empty());
+	EXPECT_TRUE(pair->getContactManifold().getPoints().empty());
+}
+
+TEST(GjkEpaContactCalculationTests, ContactManifoldTest)
+{
+	ContactManifold manifold;
+	EXPECT_DOUBLE_EQ(1e-3, manifold.getBreakingThreshold());
+	EXPECT_THROW(manifold.setBreakingThreshold(0.0), SurgSim::Framework::AssertionFailure);
+	manifold.setBreakingThreshold(0.01);
+
+	const RigidTransform3d identity = RigidTransform3d::Identity();
+	const Vector3d normal = Vector3d::UnitY();
+	manifold.addPoint(identity, identity, normal, 0.001, Vector3d(0.0, 0.0, 0.0), Vector3d(0.0, 0.001, 0.0));
+	manifold.addPoint(identity, identity, normal, 0.002, Vector3d(0.005, 0.0, 0.0), Vector3d(0.005, 0.002, 0.0));
+	ASSERT_EQ(1u, manifold.getPoints().size());
+	EXPECT_DOUBLE_EQ(0.002, manifold.getPoints()[0].depth);
+
+	for (int i = 0; i < 5; ++i)
+	{
+		const Vector3d point(0.1 * std::cos(i * 1.2), 0.0, 0.1 * std::sin(i * 1.2));
+		manifold.addPoint(identity, identity, normal, 0.001 * i, point, point + Vector3d(0.0, 0.001 * i, 0.0));
+	}
+	EXPECT_EQ(ContactManifold::MaxNumPoints, manifold.getPoints().size());
+
+	// The points follow the shapes
+	const RigidTransform3d moved = makeRigidTranslation(Vector3d(0.0, 0.001, 0.0));
+	manifold.refresh(moved, identity);
+	for (const auto& point : manifold.getPoints())
+	{
+		EXPECT_NEAR(point.localPoint2[1] - point.localPoint1[1] - 0.001, point.depth, 1e-12);
+	}
+
+	// A sliding motion breaks the points
+	manifold.refresh(makeRigidTranslation(Vector3d(0.02, 0.0, 0.0)), identity);
+	EXPECT_TRUE(manifold.getPoints().empty());
+
+	// A change of normal resets the manifold
+	manifold.addPoint(identity, identity, normal, 0.001, Vector3d::Zero(), Vector3d(0.0, 0.001, 0.0));
+	manifold.addPoint(identity, identity, Vector3d::UnitX(), 0.001, Vector3d(0.1, 0.0, 0.0),
+					  Vector3d(0.101, 0.0, 0.0));
+	EXPECT_EQ(1u, manifold.getPoints().size());
+	EXPECT_TRUE(manifold.getNormal().isApprox(Vector3d::UnitX()));
+
+	manifold.getSimplex()->emplace_back(Vector3d::Zero(), Vector3d::Zero());
+	manifold.clearPoints();
+	EXPECT_TRUE(manifold.getPoints().empty());
+	EXPECT_FALSE(manifold.getSimplex()->empty());
+	manifold.clear();
+	EXPECT_TRUE(manifold.getSimplex()->empty());
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
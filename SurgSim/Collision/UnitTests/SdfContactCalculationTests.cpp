@@ -0,0 +1,278 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+#include "SurgSim/Collision/SdfCapsuleContact.h"
+#include "SurgSim/Collision/SdfParticlesContact.h"
+#include "SurgSim/Collision/SdfSegmentMeshContact.h"
+#include "SurgSim/Collision/SdfSphereContact.h"
+#include "SurgSim/Collision/SdfTriangleMeshContact.h"
+#include "SurgSim/Collision/UnitTests/ContactCalculationTestsCommon.h"
+#include "SurgSim/DataStructures/BinaryCache.h"
+#include "SurgSim/DataStructures/SegmentMesh.h"
+#include "SurgSim/DataStructures/TriangleMesh.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Math/CapsuleShape.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/ParticlesShape.h"
+#include "SurgSim/Math/SdfShape.h"
+#include "SurgSim/Math/SegmentMeshShape.h"
+#include "SurgSim/Math/SphereShape.h"
+
+using SurgSim::DataStructures::SegmentMeshPlain;
+using SurgSim::DataStructures::TriangleMeshPlain;
+using SurgSim::Math::CapsuleShape;
+using SurgSim::Math::makeRigidTransform;
+using SurgSim::Math::makeRigidTranslation;
+using SurgSim::Math::makeRotationQuaternion;
+using SurgSim::Math::MeshShape;
+using SurgSim::Math::ParticlesShape;
+using SurgSim::Math::PosedShape;
+using SurgSim::Math::SdfShape;
+using SurgSim::Math::SegmentMeshShape;
+using SurgSim::Math::SphereShape;
+
+namespace
+{
+const double epsilon = 1e-5;
+}
+
+namespace SurgSim
+{
+namespace Collision
+{
+
+class SdfContactCalculationTests : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		m_runtime = std::make_shared<Framework::Runtime>("config.txt");
+		m_isCacheEnabled = DataStructures::isBinaryCacheEnabled();
+		DataStructures::setBinaryCacheEnabled(false);
+
+		// A cube of side 2 centered on its origin
+		m_sdf = std::make_shared<SdfShape>();
+		m_sdf->setCellSize(0.1);
+		m_sdf->setNarrowBandWidth(0.0);
+		m_sdf->loadMesh("Geometry/Cube.ply");
+
+		m_sdfPose = makeRigidTransform(makeRotationQuaternion(M_PI_2, Vector3d::UnitZ().eval()),
+									   Vector3d(0.0, 0.0, 2.0));
+	}
+
+	void TearDown() override
+	{
+		DataStructures::setBinaryCacheEnabled(m_isCacheEnabled);
+	}
+
+protected:
+	std::shared_ptr<Framework::Runtime> m_runtime;
+	std::shared_ptr<SdfShape> m_sdf;
+	RigidTransform3d m_sdfPose;
+	bool m_isCacheEnabled;
+};
+
+TEST_F(SdfContactCalculationTests, TableTest)
+{
+	const auto& table = ContactCalculation::getDcdContactTable();
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<SdfSphereContact>(
+				  table[Math::SHAPE_TYPE_SDF][Math::SHAPE_TYPE_SPHERE]));
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<SdfCapsuleContact>(
+				  table[Math::SHAPE_TYPE_SDF][Math::SHAPE_TYPE_CAPSULE]));
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<SdfParticlesContact>(
+				  table[Math::SHAPE_TYPE_SDF][Math::SHAPE_TYPE_PARTICLES]));
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<SdfSegmentMeshContact>(
+				  table[Math::SHAPE_TYPE_SDF][Math::SHAPE_TYPE_SEGMENTMESH]));
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<SdfTriangleMeshContact>(
+				  table[Math::SHAPE_TYPE_SDF][Math::SHAPE_TYPE_MESH]));
+	EXPECT_NE(nullptr, std::dynamic_pointer_cast<SdfSphereContact>(
+				  table[Math::SHAPE_TYPE_SPHERE][Math::SHAPE_TYPE_SDF]));
+}
+
+TEST_F(SdfContactCalculationTests, SphereTest)
+{
+	SdfSphereContact calculation;
+	auto sphere = std::make_shared<SphereShape>(0.5);
+	const Vector3d localX = m_sdfPose.linear() * Vector3d::UnitX();
+
+	{
+		SCOPED_TRACE("No intersection");
+		auto contacts = calculation.calculateDcdContact(*m_sdf, m_sdfPose, *sphere,
+						makeRigidTransform(Quaterniond::Identity(), m_sdfPose * Vector3d(1.6, 0.0, 0.0)));
+		EXPECT_TRUE(contacts.empty());
+	}
+
+	{
+		SCOPED_TRACE("Intersection");
+		auto contacts = calculation.calculateDcdContact(*m_sdf, m_sdfPose, *sphere,
+						makeRigidTransform(Quaterniond::Identity(), m_sdfPose * Vector3d(1.3, 0.1, -0.2)));
+		ASSERT_EQ(1u, contacts.size());
+		auto contact = contacts.front();
+		EXPECT_NEAR(0.2, contact->depth, epsilon);
+		EXPECT_TRUE(contact->normal.isApprox(-localX, epsilon));
+		EXPECT_TRUE(contact->penetrationPoints.first.rigidLocalPosition.getValue().isApprox(
+						Vector3d(1.0, 0.1, -0.2), epsilon));
+		EXPECT_TRUE(contact->penetrationPoints.second.rigidLocalPosition.getValue().isApprox(-0.5 * localX, epsilon));
+	}
+
+	{
+		SCOPED_TRACE("Swapped shapes");
+		auto contacts = calculation.calculateDcdContact(
+							PosedShape<std::shared_ptr<Math::Shape>>(sphere,
+									makeRigidTransform(Quaterniond::Identity(), m_sdfPose * Vector3d(1.3, 0.0, 0.0))),
+							PosedShape<std::shared_ptr<Math::Shape>>(m_sdf, m_sdfPose));
+		ASSERT_EQ(1u, contacts.size());
+		EXPECT_NEAR(0.2, contacts.front()->depth, epsilon);
+		EXPECT_TRUE(contacts.front()->normal.isApprox(localX, epsilon));
+	}
+}
+
+TEST_F(SdfContactCalculationTests, CapsuleTest)
+{
+	SdfCapsuleContact calculation;
+	CapsuleShape capsule(1.0, 0.2);
+
+	{
+		SCOPED_TRACE("No intersection");
+		auto contacts = calculation.calculateDcdContact(*m_sdf, m_sdfPose, capsule,
+						m_sdfPose * makeRigidTransform(Quaterniond::Identity(), Vector3d(1.3, 0.0, 0.0)));
+		EXPECT_TRUE(contacts.empty());
+	}
+
+	{
+		SCOPED_TRACE("Intersection of a tilted capsule");
+		// The capsule axis goes from (1.1, -0.5, 0) to (1.5, 0.5, 0) in the sdf frame
+		const Vector3d axis = Vector3d(0.4, 1.0, 0.0).normalized();
+		const Quaterniond rotation = Quaterniond::FromTwoVectors(Vector3d::UnitY(), axis);
+		CapsuleShape tiltedCapsule((Vector3d(0.4, 1.0, 0.0)).norm(), 0.2);
+		auto contacts = calculation.calculateDcdContact(*m_sdf, m_sdfPose, tiltedCapsule,
+						m_sdfPose * makeRigidTransform(rotation, Vector3d(1.3, 0.0, 0.0)));
+		ASSERT_EQ(1u, contacts.size());
+		auto contact = contacts.front();
+		EXPECT_NEAR(0.1, contact->depth, 0.1 * capsule.getRadius());
+		EXPECT_TRUE(contact->normal.isApprox(-(m_sdfPose.linear() * Vector3d::UnitX()), epsilon));
+		EXPECT_NEAR(1.0, contact->penetrationPoints.first.rigidLocalPosition.getValue()[0], epsilon);
+		EXPECT_GT(0.0, contact->penetrationPoints.second.rigidLocalPosition.getValue()[1]);
+	}
+}
+
+TEST_F(SdfContactCalculationTests, ParticlesTest)
+{
+	SdfParticlesContact calculation;
+	ParticlesShape particles(0.2);
+	particles.addVertex(ParticlesShape::VertexType(m_sdfPose * Vector3d(1.1, 0.0, 0.0)));
+	particles.addVertex(ParticlesShape::VertexType(m_sdfPose * Vector3d(5.0, 5.0, 5.0)));
+	particles.addVertex(ParticlesShape::VertexType(m_sdfPose * Vector3d(0.3, 0.0, -1.15)));
+	particles.addVertex(ParticlesShape::VertexType(m_sdfPose * Vector3d(0.0, 0.0, 0.0)));
+	particles.update();
+
+	auto contacts = calculation.calculateDcdContact(*m_sdf, m_sdfPose, particles, RigidTransform3d::Identity());
+	ASSERT_EQ(3u, contacts.size());
+
+	std::array<double, 4> expectedDepths = {{0.1, 0.0, 0.05, 1.2}};
+	for (const auto& contact : contacts)
+	{
+		ASSERT_TRUE(contact->penetrationPoints.second.index.hasValue());
+		const size_t index = contact->penetrationPoints.second.index.getValue();
+		ASSERT_NE(1u, index);
+		EXPECT_NEAR(expectedDepths[index], contact->depth, (index == 3) ? m_sdf->getCellSize() : epsilon);
+		if (index == 2)
+		{
+			EXPECT_TRUE(contact->normal.isApprox(m_sdfPose.linear() * Vector3d::UnitZ(), epsilon));
+		}
+	}
+}
+
+TEST_F(SdfContactCalculationTests, SegmentMeshTest)
+{
+	SdfSegmentMeshContact calculation;
+	auto mesh = std::make_shared<SegmentMeshPlain>();
+	for (size_t i = 0; i < 5; ++i)
+	{
+		mesh->addVertex(SegmentMeshPlain::VertexType(m_sdfPose * Vector3d(1.1, -1.0 + 0.5 * i, 0.0)));
+	}
+	for (size_t i = 0; i < 4; ++i)
+	{
+		std::array<size_t, 2> indices = {{i, i + 1}};
+		mesh->addEdge(SegmentMeshPlain::EdgeType(indices));
+	}
+
+	{
+		SCOPED_TRACE("No intersection");
+		SegmentMeshShape segmentMesh(*mesh, 0.05);
+		auto contacts = calculation.calculateDcdContact(*m_sdf, m_sdfPose, segmentMesh, RigidTransform3d::Identity());
+		EXPECT_TRUE(contacts.empty());
+	}
+
+	{
+		SCOPED_TRACE("Intersection");
+		SegmentMeshShape segmentMesh(*mesh, 0.2);
+		auto contacts = calculation.calculateDcdContact(*m_sdf, m_sdfPose, segmentMesh, RigidTransform3d::Identity());
+		ASSERT_EQ(4u, contacts.size());
+		for (const auto& contact : contacts)
+		{
+			EXPECT_NEAR(0.1, contact->depth, epsilon);
+			EXPECT_TRUE(contact->normal.isApprox(-(m_sdfPose.linear() * Vector3d::UnitX()), epsilon));
+			ASSERT_TRUE(contact->penetrationPoints.second.elementMeshLocalCoordinate.hasValue());
+			EXPECT_GT(4u, contact->penetrationPoints.second.elementMeshLocalCoordinate.getValue().index);
+		}
+	}
+}
+
+TEST_F(SdfContactCalculationTests, TriangleMeshTest)
+{
+	SdfTriangleMeshContact calculation;
+
+	// A cube of side 0.2, overlapping the +x face of the sdf cube by 0.1
+	auto mesh = std::make_shared<TriangleMeshPlain>();
+	for (int i = 0; i < 8; ++i)
+	{
+		mesh->addVertex(TriangleMeshPlain::VertexType(m_sdfPose * Vector3d(1.0 + 0.2 * ((i & 1) - 0.5),
+						0.2 * (((i >> 1) & 1) - 0.5), 0.2 * (((i >> 2) & 1) - 0.5))));
+	}
+	const std::array<std::array<size_t, 3>, 12> triangles = {{
+			{{0, 2, 1}}, {{1, 2, 3}}, {{4, 5, 6}}, {{5, 7, 6}}, {{0, 1, 4}}, {{1, 5, 4}},
+			{{2, 6, 3}}, {{3, 6, 7}}, {{0, 4, 2}}, {{2, 4, 6}}, {{1, 3, 5}}, {{3, 7, 5}}
+		}
+	};
+	for (const auto& triangle : triangles)
+	{
+		mesh->addTriangle(TriangleMeshPlain::TriangleType(triangle));
+	}
+	MeshShape meshShape(*mesh);
+
+	auto contacts = calculation.calculateDcdContact(*m_sdf, m_sdfPose, meshShape, RigidTransform3d::Identity());
+	ASSERT_EQ(4u, contacts.size());
+	for (const auto& contact : contacts)
+	{
+		EXPECT_NEAR(0.1, contact->depth, epsilon);
+		EXPECT_TRUE(contact->normal.isApprox(-(m_sdfPose.linear() * Vector3d::UnitX()), epsilon));
+		ASSERT_TRUE(contact->penetrationPoints.second.triangleMeshLocalCoordinate.hasValue());
+		const auto& coordinate = contact->penetrationPoints.second.triangleMeshLocalCoordinate.getValue();
+		const auto positions = meshShape.getTrianglePositions(coordinate.index);
+		const Vector3d vertex = coordinate.coordinate[0] * positions[0] + coordinate.coordinate[1] * positions[1] +
+								coordinate.coordinate[2] * positions[2];
+		EXPECT_TRUE(vertex.isApprox(contact->penetrationPoints.second.rigidLocalPosition.getValue()));
+		EXPECT_NEAR(0.9, (m_sdfPose.inverse() * vertex)[0], epsilon);
+	}
+}
+
+}; // namespace Collision
+}; // namespace SurgSim
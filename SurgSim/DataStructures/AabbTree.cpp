@@ -16,7 +16,9 @@
 #include "SurgSim/DataStructures/AabbTree.h"
 #include "SurgSim/DataStructures/AabbTreeNode.h"
 
+#include <functional>
 #include <memory>
+#include <set>
 
 namespace SurgSim
 {
@@ -24,14 +26,16 @@ namespace DataStructures
 {
 
 AabbTree::AabbTree() :
-	m_maxObjectsPerNode(3)
+	m_maxObjectsPerNode(3),
+	m_refitIndexValid(false)
 {
 	m_typedRoot = std::make_shared<AabbTreeNode>();
 	setRoot(m_typedRoot);
 }
 
 AabbTree::AabbTree(size_t maxObjectsPerNode) :
-	m_maxObjectsPerNode(maxObjectsPerNode)
+	m_maxObjectsPerNode(maxObjectsPerNode),
+	m_refitIndexValid(false)
 {
 	m_typedRoot = std::make_shared<AabbTreeNode>();
 	setRoot(m_typedRoot);
@@ -45,6 +49,7 @@ AabbTree::~AabbTree()
 void AabbTree::add(const SurgSim::Math::Aabbd& aabb, size_t objectId)
 {
 	m_typedRoot->addData(aabb, objectId, m_maxObjectsPerNode);
+	m_refitIndexValid = false;
 }
 
 void AabbTree::set(const AabbTreeData::ItemList& items)
@@ -52,6 +57,7 @@ void AabbTree::set(const AabbTreeData::ItemList& items)
 	m_typedRoot = std::make_shared<AabbTreeNode>();
 	setRoot(m_typedRoot);
 	m_typedRoot->setData(items, m_maxObjectsPerNode);
+	m_refitIndexValid = false;
 }
 
 void AabbTree::set(AabbTreeData::ItemList&& items)
@@ -59,6 +65,7 @@ void AabbTree::set(AabbTreeData::ItemList&& items)
 	m_typedRoot = std::make_shared<AabbTreeNode>();
 	setRoot(m_typedRoot);
 	m_typedRoot->setData(std::move(items), m_maxObjectsPerNode);
+	m_refitIndexValid = false;
 }
 
 size_t AabbTree::getMaxObjectsPerNode() const
@@ -160,6 +167,111 @@ void AabbTree::updateNodeBounds(const std::vector<Math::Aabbd>& bounds,
 	}
 }
 
+void AabbTree::updateBounds(const std::vector<Math::Aabbd>& bounds, const std::vector<size_t>& items)
+{
+	if (!m_refitIndexValid)
+	{
+		buildRefitIndex();
+	}
+
+	// The deepest nodes are refit first, so that all the dirty children of a node are refit before it
+	std::set<std::pair<size_t, AabbTreeNode*>, std::greater<std::pair<size_t, AabbTreeNode*>>> dirtyNodes;
+	for (size_t item : items)
+	{
+		if (item < m_itemLeaves.size() && m_itemLeaves[item] != nullptr)
+		{
+			dirtyNodes.emplace(m_nodeParents[m_itemLeaves[item]].second, m_itemLeaves[item]);
+		}
+	}
+
+	while (!dirtyNodes.empty())
+	{
+		AabbTreeNode* node = dirtyNodes.begin()->second;
+		dirtyNodes.erase(dirtyNodes.begin());
+
+		const size_t numChildren = node->getNumChildren();
+		if (numChildren > 0)
+		{
+			auto aabb = static_cast<AabbTreeNode*>(node->getChild(0).get())->getAabb();
+			for (size_t i = 1; i < numChildren; ++i)
+			{
+				aabb.extend(static_cast<AabbTreeNode*>(node->getChild(i).get())->getAabb());
+			}
+			node->setAabb(aabb);
+		}
+		else
+		{
+			auto data = static_cast<AabbTreeData*>(node->getData().get());
+			for (auto& item : data->getData())
+			{
+				item.first = bounds[item.second];
+			}
+			data->recalculateAabb();
+			node->setAabb(data->getAabb());
+		}
+
+		const auto& parent = m_nodeParents[node];
+		if (parent.first != nullptr)
+		{
+			dirtyNodes.emplace(parent.second - 1, parent.first);
+		}
+	}
+}
+
+void AabbTree::buildRefitIndex()
+{
+	m_itemLeaves.clear();
+	m_nodeParents.clear();
+	addToRefitIndex(m_typedRoot.get(), nullptr, 0);
+	m_refitIndexValid = true;
+}
+
+void AabbTree::addToRefitIndex(AabbTreeNode* node, AabbTreeNode* parent, size_t depth)
+{
+	m_nodeParents[node] = std::make_pair(parent, depth);
+
+	const size_t numChildren = node->getNumChildren();
+	if (numChildren > 0)
+	{
+		for (size_t i = 0; i < numChildren; ++i)
+		{
+			addToRefitIndex(static_cast<AabbTreeNode*>(node->getChild(i).get()), node, depth + 1);
+		}
+	}
+	else if (node->getData() != nullptr)
+	{
+		for (const auto& item : static_cast<AabbTreeData*>(node->getData().get())->getData())
+		{
+			if (item.second >= m_itemLeaves.size())
+			{
+				m_itemLeaves.resize(item.second + 1, nullptr);
+			}
+			m_itemLeaves[item.second] = node;
+		}
+	}
 }
+
+void AabbTree::getStructure(std::vector<size_t>* structure) const
+{
+	structure->clear();
+	m_typedRoot->appendStructure(structure);
 }
 
+bool AabbTree::setStructure(const std::vector<size_t>& structure, const std::vector<Math::Aabbd>& bounds)
+{
+	m_refitIndexValid = false;
+	m_typedRoot = std::make_shared<AabbTreeNode>();
+	setRoot(m_typedRoot);
+
+	size_t position = 0;
+	if (!m_typedRoot->setStructure(structure, bounds, &position) || position != structure.size())
+	{
+		m_typedRoot = std::make_shared<AabbTreeNode>();
+		setRoot(m_typedRoot);
+		return false;
+	}
+	return true;
+}
+
+}
+}
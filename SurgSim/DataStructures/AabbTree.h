@@ -17,6 +17,7 @@
 #define SURGSIM_DATASTRUCTURES_AABBTREE_H
 
 #include <list>
+#include <unordered_map>
 #include <vector>
 
 #include "SurgSim/DataStructures/Tree.h"
@@ -87,6 +88,24 @@ class AabbTree : public Tree
 
 	void updateNodeBounds(const std::vector<Math::Aabbd>& bounds, SurgSim::DataStructures::AabbTreeNode* node);
 
+	/// Update the bounds of some of the items without rebalancing the tree, only the leaves holding these items and
+	/// their ancestors are refit, this is much faster than updateBounds() when a small part of the items changed.
+	/// \param bounds The AABBs of all the items, indexed by the item ids
+	/// \param items The ids of the items whose AABB changed
+	void updateBounds(const std::vector<Math::Aabbd>& bounds, const std::vector<size_t>& items);
+
+	/// Export the structure of the tree, so that it can be rebuilt by setStructure() without splitting any nodes.
+	/// For each node, in depth first order, the number of children is recorded, for leaves this is followed by the
+	/// number of items and the ids of the items.
+	/// \param [out] structure The structure of the tree
+	void getStructure(std::vector<size_t>* structure) const;
+
+	/// Rebuild the tree from a structure exported by getStructure(), all the tree information will be deleted
+	/// \param structure The structure of the tree
+	/// \param bounds The AABBs of all the items, indexed by the item ids
+	/// \return true if the structure was consistent with the bounds, false otherwise, the tree will be empty then
+	bool setStructure(const std::vector<size_t>& structure, const std::vector<Math::Aabbd>& bounds);
+
 private:
 
 	/// Number of objects in a node that will trigger a split
@@ -94,6 +113,24 @@ class AabbTree : public Tree
 
 	/// A typed version of the root for access without typecasting
 	std::shared_ptr<AabbTreeNode> m_typedRoot;
+
+	/// Build the maps from the items to their leaves and from the nodes to their parents, used by partial updates
+	void buildRefitIndex();
+
+	/// Add the subtree rooted at a node to the refit index
+	/// \param node The root of the subtree
+	/// \param parent The parent of the node, nullptr for the root of the tree
+	/// \param depth The depth of the node
+	void addToRefitIndex(AabbTreeNode* node, AabbTreeNode* parent, size_t depth);
+
+	/// Whether the refit index matches the current structure of the tree
+	bool m_refitIndexValid;
+
+	/// For each item id, the leaf holding this item, nullptr if the item is not in the tree
+	std::vector<AabbTreeNode*> m_itemLeaves;
+
+	/// For each node, its parent and its depth
+	std::unordered_map<AabbTreeNode*, std::pair<AabbTreeNode*, size_t>> m_nodeParents;
 };
 
 }
@@ -169,6 +169,93 @@ void AabbTreeNode::getIntersections(const SurgSim::Math::Aabbd& aabb, std::vecto
 	data->getIntersections(aabb, result);
 }
 
+void AabbTreeNode::appendStructure(std::vector<size_t>* structure)
+{
+	const size_t numChildren = getNumChildren();
+	structure->push_back(numChildren);
+	if (numChildren > 0)
+	{
+		for (size_t i = 0; i < numChildren; ++i)
+		{
+			std::static_pointer_cast<AabbTreeNode>(getChild(i))->appendStructure(structure);
+		}
+	}
+	else
+	{
+		auto data = static_cast<AabbTreeData*>(getData().get());
+		if (data == nullptr)
+		{
+			structure->push_back(0);
+		}
+		else
+		{
+			structure->push_back(data->getSize());
+			for (const auto& item : data->getData())
+			{
+				structure->push_back(item.second);
+			}
+		}
+	}
 }
+
+bool AabbTreeNode::setStructure(const std::vector<size_t>& structure, const std::vector<SurgSim::Math::Aabbd>& bounds,
+								size_t* position)
+{
+	SURGSIM_ASSERT(getNumChildren() == 0) << "Can't call setStructure on a node that already has nodes";
+	SURGSIM_ASSERT(getData() == nullptr) << "Can't call setStructure on a node that already has data.";
+
+	if (*position >= structure.size())
+	{
+		return false;
+	}
+
+	const size_t numChildren = structure[(*position)++];
+	if (numChildren > 0)
+	{
+		m_aabb.setEmpty();
+		for (size_t i = 0; i < numChildren; ++i)
+		{
+			auto child = std::make_shared<AabbTreeNode>();
+			if (!child->setStructure(structure, bounds, position))
+			{
+				return false;
+			}
+			m_aabb.extend(child->getAabb());
+			addChild(child);
+		}
+		m_aabb.sizes().maxCoeff(&m_axis);
+	}
+	else
+	{
+		if (*position >= structure.size())
+		{
+			return false;
+		}
+		const size_t numItems = structure[(*position)++];
+		if (structure.size() - *position < numItems)
+		{
+			return false;
+		}
+
+		m_aabb.setEmpty();
+		if (numItems > 0)
+		{
+			auto data = std::make_shared<AabbTreeData>();
+			for (size_t i = 0; i < numItems; ++i)
+			{
+				const size_t id = structure[(*position)++];
+				if (id >= bounds.size())
+				{
+					return false;
+				}
+				data->add(bounds[id], id);
+			}
+			m_aabb = data->getAabb();
+			setData(data);
+		}
+	}
+	return true;
 }
 
+}
+}
@@ -85,6 +85,19 @@ class AabbTreeNode : public TreeNode
 	/// \param [out] result location to receive the results of the call.
 	void getIntersections(const SurgSim::Math::Aabbd& aabb, std::vector<size_t>* result);
 
+	/// Append the structure of the subtree rooted at this node.
+	/// \param [out] structure The list that receives the structure, see AabbTree::getStructure()
+	void appendStructure(std::vector<size_t>* structure);
+
+	/// Rebuild the subtree rooted at this node, the node needs to be empty and not have any children for this to work.
+	/// \param structure The structure of the tree, see AabbTree::getStructure()
+	/// \param bounds The AABBs of all the items, indexed by the item ids
+	/// \param [in,out] position The position in structure where this node starts, on return the position after
+	///                 the subtree of this node
+	/// \return true if the structure was consistent, false otherwise
+	bool setStructure(const std::vector<size_t>& structure, const std::vector<SurgSim::Math::Aabbd>& bounds,
+					  size_t* position);
+
 protected:
 
 	bool doAccept(TreeVisitor* visitor) override;
@@ -0,0 +1,75 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_DATASTRUCTURES_BINARYCACHE_INL_H
+#define SURGSIM_DATASTRUCTURES_BINARYCACHE_INL_H
+
+#include <cstring>
+
+namespace SurgSim
+{
+namespace DataStructures
+{
+
+template <class T>
+void BinaryCacheWriter::write(const T& value)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached.");
+	writeSection(&value, sizeof(T));
+}
+
+template <class T>
+void BinaryCacheWriter::write(const std::vector<T>& values)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached.");
+	writeSection(values.data(), values.size() * sizeof(T));
+}
+
+template <class T>
+bool BinaryCacheReader::read(T* value)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached.");
+	const char* data;
+	uint64_t size;
+	if (!readSection(&data, &size) || size != sizeof(T))
+	{
+		return false;
+	}
+	std::memcpy(value, data, sizeof(T));
+	return true;
+}
+
+template <class T>
+bool BinaryCacheReader::read(std::vector<T>* values)
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be cached.");
+	const char* data;
+	uint64_t size;
+	if (!readSection(&data, &size) || size % sizeof(T) != 0)
+	{
+		return false;
+	}
+	values->resize(static_cast<size_t>(size / sizeof(T)));
+	if (size > 0)
+	{
+		std::memcpy(values->data(), data, static_cast<size_t>(size));
+	}
+	return true;
+}
+
+}; // namespace DataStructures
+}; // namespace SurgSim
+
+#endif // SURGSIM_DATASTRUCTURES_BINARYCACHE_INL_H
@@ -0,0 +1,364 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/DataStructures/BinaryCache.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "SurgSim/Framework/Log.h"
+
+namespace
+{
+
+/// Identifies a binary cache file
+const char CACHE_MAGIC[8] = {'O', 'S', 'S', 'C', 'A', 'C', 'H', 'E'};
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+std::atomic<bool> cacheEnabled(false);
+
+boost::mutex cacheDirectoryMutex;
+std::string cacheDirectory;
+
+uint64_t hashString(const std::string& value)
+{
+	uint64_t result = FNV_OFFSET_BASIS;
+	for (char c : value)
+	{
+		result ^= static_cast<unsigned char>(c);
+		result *= FNV_PRIME;
+	}
+	return result;
+}
+
+}
+
+namespace SurgSim
+{
+namespace DataStructures
+{
+
+bool computeFileHash(const std::string& fileName, uint64_t* hash)
+{
+	std::ifstream file(fileName, std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	uint64_t result = FNV_OFFSET_BASIS;
+	std::vector<char> buffer(1 << 16);
+	while (file)
+	{
+		file.read(buffer.data(), buffer.size());
+		const std::streamsize count = file.gcount();
+		for (std::streamsize i = 0; i < count; ++i)
+		{
+			result ^= static_cast<unsigned char>(buffer[i]);
+			result *= FNV_PRIME;
+		}
+	}
+
+	*hash = result;
+	return file.eof();
+}
+
+std::string getBinaryCacheFileName(const std::string& fileName, const std::string& typeName)
+{
+	// Only use the unqualified class name, e.g. 'SurgSim::Math::MeshShape' results in 'file.ply.MeshShape.cache'
+	const size_t separator = typeName.rfind(':');
+	const std::string name = (separator == std::string::npos) ? typeName : typeName.substr(separator + 1);
+
+	const std::string directory = getBinaryCacheDirectory();
+	if (directory.empty())
+	{
+		return fileName + "." + name + ".cache";
+	}
+
+	// e.g. 'file.ply.0123456789abcdef.MeshShape.cache', the hash of the absolute path tells apart the assets with
+	// the same name in different directories
+	boost::system::error_code error;
+	boost::filesystem::path path(fileName);
+	const boost::filesystem::path absolutePath = boost::filesystem::canonical(path, error);
+	std::ostringstream cacheName;
+	cacheName << path.filename().string() << "." << std::hex << std::setw(16) << std::setfill('0')
+		<< hashString(error ? boost::filesystem::absolute(path).string() : absolutePath.string())
+		<< "." << name << ".cache";
+	return (boost::filesystem::path(directory) / cacheName.str()).string();
+}
+
+void setBinaryCacheEnabled(bool enabled)
+{
+	cacheEnabled = enabled;
+}
+
+bool isBinaryCacheEnabled()
+{
+	return cacheEnabled;
+}
+
+void setBinaryCacheDirectory(const std::string& directory)
+{
+	boost::lock_guard<boost::mutex> lock(cacheDirectoryMutex);
+	cacheDirectory = directory;
+}
+
+std::string getBinaryCacheDirectory()
+{
+	boost::lock_guard<boost::mutex> lock(cacheDirectoryMutex);
+	return cacheDirectory;
+}
+
+BinaryCacheWriter::BinaryCacheWriter(const std::string& typeName, uint64_t sourceHash)
+{
+	const uint32_t version = BINARY_CACHE_VERSION;
+	const uint32_t typeNameLength = static_cast<uint32_t>(typeName.size());
+
+	m_buffer.insert(m_buffer.end(), CACHE_MAGIC, CACHE_MAGIC + sizeof(CACHE_MAGIC));
+	m_buffer.insert(m_buffer.end(), reinterpret_cast<const char*>(&version),
+					reinterpret_cast<const char*>(&version) + sizeof(version));
+	m_buffer.insert(m_buffer.end(), reinterpret_cast<const char*>(&typeNameLength),
+					reinterpret_cast<const char*>(&typeNameLength) + sizeof(typeNameLength));
+	m_buffer.insert(m_buffer.end(), reinterpret_cast<const char*>(&sourceHash),
+					reinterpret_cast<const char*>(&sourceHash) + sizeof(sourceHash));
+	m_buffer.insert(m_buffer.end(), typeName.begin(), typeName.end());
+}
+
+void BinaryCacheWriter::writeSection(const void* data, uint64_t size)
+{
+	m_buffer.insert(m_buffer.end(), reinterpret_cast<const char*>(&size),
+					reinterpret_cast<const char*>(&size) + sizeof(size));
+	if (size > 0)
+	{
+		m_buffer.insert(m_buffer.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+	}
+}
+
+bool BinaryCacheWriter::save(const std::string& fileName) const
+{
+	boost::system::error_code error;
+	boost::filesystem::path temporary = boost::filesystem::unique_path(fileName + ".%%%%-%%%%", error);
+	if (error)
+	{
+		return false;
+	}
+
+	{
+		std::ofstream file(temporary.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			SURGSIM_LOG_DEBUG(SurgSim::Framework::Logger::getLogger("InputOutput"))
+				<< "Could not open '" << temporary.string() << "' for writing the binary cache.";
+			return false;
+		}
+		file.write(m_buffer.data(), m_buffer.size());
+		if (!file)
+		{
+			file.close();
+			boost::filesystem::remove(temporary, error);
+			return false;
+		}
+	}
+
+	boost::filesystem::rename(temporary, fileName, error);
+	if (error)
+	{
+		boost::filesystem::remove(temporary, error);
+		return false;
+	}
+	return true;
+}
+
+struct BinaryCacheReader::Data
+{
+	boost::interprocess::file_mapping mapping;
+	boost::interprocess::mapped_region region;
+};
+
+BinaryCacheReader::BinaryCacheReader(const std::string& fileName, const std::string& typeName,
+									 uint64_t sourceHash) :
+	BinaryCacheReader(fileName, typeName)
+{
+	if (m_sourceHash != sourceHash)
+	{
+		m_current = nullptr;
+	}
+}
+
+BinaryCacheReader::BinaryCacheReader(const std::string& fileName, const std::string& typeName) :
+	m_current(nullptr),
+	m_end(nullptr),
+	m_sourceHash(0)
+{
+	boost::system::error_code error;
+	if (!boost::filesystem::is_regular_file(fileName, error) || boost::filesystem::file_size(fileName, error) == 0)
+	{
+		return;
+	}
+
+	try
+	{
+		m_data.reset(new Data);
+		m_data->mapping = boost::interprocess::file_mapping(fileName.c_str(), boost::interprocess::read_only);
+		m_data->region = boost::interprocess::mapped_region(m_data->mapping, boost::interprocess::read_only);
+	}
+	catch (const boost::interprocess::interprocess_exception& exception)
+	{
+		SURGSIM_LOG_DEBUG(SurgSim::Framework::Logger::getLogger("InputOutput"))
+			<< "Could not map binary cache '" << fileName << "': " << exception.what();
+		m_data.reset();
+		return;
+	}
+
+	const char* begin = static_cast<const char*>(m_data->region.get_address());
+	const char* end = begin + m_data->region.get_size();
+
+	uint32_t version;
+	uint32_t typeNameLength;
+	uint64_t hash;
+	const size_t headerSize = sizeof(CACHE_MAGIC) + sizeof(version) + sizeof(typeNameLength) + sizeof(hash);
+	if (static_cast<size_t>(end - begin) < headerSize || std::memcmp(begin, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+	{
+		return;
+	}
+
+	const char* current = begin + sizeof(CACHE_MAGIC);
+	std::memcpy(&version, current, sizeof(version));
+	current += sizeof(version);
+	std::memcpy(&typeNameLength, current, sizeof(typeNameLength));
+	current += sizeof(typeNameLength);
+	std::memcpy(&hash, current, sizeof(hash));
+	current += sizeof(hash);
+
+	if (version != BINARY_CACHE_VERSION || typeNameLength != typeName.size() ||
+		static_cast<size_t>(end - current) < typeNameLength ||
+		typeName.compare(0, typeNameLength, current, typeNameLength) != 0)
+	{
+		return;
+	}
+
+	m_current = current + typeNameLength;
+	m_end = end;
+	m_sourceHash = hash;
+}
+
+BinaryCacheReader::~BinaryCacheReader()
+{
+}
+
+bool BinaryCacheReader::isValid() const
+{
+	return m_current != nullptr;
+}
+
+uint64_t BinaryCacheReader::getSourceHash() const
+{
+	return m_sourceHash;
+}
+
+bool BinaryCacheReader::isAtEnd() const
+{
+	return m_current == m_end;
+}
+
+bool BinaryCacheReader::readSection(const char** data, uint64_t* size)
+{
+	if (!isValid() || static_cast<size_t>(m_end - m_current) < sizeof(uint64_t))
+	{
+		return false;
+	}
+
+	uint64_t sectionSize;
+	std::memcpy(&sectionSize, m_current, sizeof(sectionSize));
+	if (static_cast<uint64_t>(m_end - m_current) - sizeof(sectionSize) < sectionSize)
+	{
+		return false;
+	}
+
+	*data = m_current + sizeof(sectionSize);
+	*size = sectionSize;
+	m_current += sizeof(sectionSize) + sectionSize;
+	return true;
+}
+
+namespace
+{
+
+/// Write the binary cache of an asset, creating the cache directory if needed
+void writeBinaryCache(const std::string& cacheFileName, const std::string& typeName, uint64_t sourceHash,
+					  const std::function<void(BinaryCacheWriter*)>& writeCache)
+{
+	boost::system::error_code error;
+	const boost::filesystem::path directory = boost::filesystem::path(cacheFileName).parent_path();
+	if (!directory.empty())
+	{
+		boost::filesystem::create_directories(directory, error);
+	}
+
+	BinaryCacheWriter writer(typeName, sourceHash);
+	writeCache(&writer);
+	SURGSIM_LOG_IF(!writer.save(cacheFileName), SurgSim::Framework::Logger::getLogger("InputOutput"), DEBUG)
+		<< "Could not write the binary cache '" << cacheFileName << "'.";
+}
+
+}
+
+bool loadWithBinaryCache(const std::string& fileName, const std::string& typeName,
+						 const std::function<bool(BinaryCacheReader*)>& readCache,
+						 const std::function<bool(void)>& loadSource,
+						 const std::function<void(BinaryCacheWriter*)>& writeCache)
+{
+	uint64_t hash = 0;
+	if (!isBinaryCacheEnabled() || !computeFileHash(fileName, &hash))
+	{
+		return loadSource();
+	}
+
+	// The cache is only used for the exact content it was written from
+	const std::string cacheFileName = getBinaryCacheFileName(fileName, typeName);
+	{
+		BinaryCacheReader reader(cacheFileName, typeName, hash);
+		if (reader.isValid())
+		{
+			if (readCache(&reader) && reader.isAtEnd())
+			{
+				return true;
+			}
+			SURGSIM_LOG_WARNING(SurgSim::Framework::Logger::getLogger("InputOutput"))
+				<< "The binary cache '" << cacheFileName << "' is corrupted, reloading '" << fileName << "'.";
+		}
+	}
+
+	if (!loadSource())
+	{
+		return false;
+	}
+
+	writeBinaryCache(cacheFileName, typeName, hash, writeCache);
+	return true;
+}
+
+}; // namespace DataStructures
+}; // namespace SurgSim
@@ -0,0 +1,190 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_DATASTRUCTURES_BINARYCACHE_H
+#define SURGSIM_DATASTRUCTURES_BINARYCACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace SurgSim
+{
+namespace DataStructures
+{
+
+/// Version of the binary cache layout, caches written with a different version are ignored
+const uint32_t BINARY_CACHE_VERSION = 3;
+
+/// Compute a 64 bit content hash (FNV-1a) of a file
+/// \param fileName Name of the file to hash
+/// \param [out] hash The hash of the content of the file
+/// \return true if the file could be read, false otherwise
+bool computeFileHash(const std::string& fileName, uint64_t* hash);
+
+/// \param fileName Name of the asset file
+/// \param typeName Name of the type of the cached object, the same file may be cached for different types
+/// \return the name of the binary cache file that accompanies the given asset file, next to the asset file or in the
+///         cache directory when one is set
+std::string getBinaryCacheFileName(const std::string& fileName, const std::string& typeName);
+
+/// Enable or disable the usage of binary caches when loading assets, disabled by default as asset directories may be
+/// read-only or under version control, see setBinaryCacheDirectory()
+/// \param enabled true to read and write binary caches when loading assets
+void setBinaryCacheEnabled(bool enabled);
+
+/// \return true if binary caches are read and written when loading assets
+bool isBinaryCacheEnabled();
+
+/// Set the directory in which the binary caches are written, it is created when the first cache is written.
+/// The cache files are named after the asset files and a hash of their absolute path, so that assets with the same
+/// name in different directories do not share a cache.
+/// \param directory The cache directory, empty (the default) to write the caches next to the asset files
+void setBinaryCacheDirectory(const std::string& directory);
+
+/// \return The directory in which the binary caches are written, empty if they are written next to the asset files
+std::string getBinaryCacheDirectory();
+
+/// Writes a versioned binary cache for an asset.
+/// The cache consists of a header, identifying the type of the asset, the version of the layout and the content
+/// hash of the source file, followed by a sequence of sections. Each section is a block of trivially copyable data,
+/// sections have to be read back by BinaryCacheReader in the order in which they were written.
+class BinaryCacheWriter
+{
+public:
+	/// Constructor
+	/// \param typeName Name of the type of the cached object, usually its class name
+	/// \param sourceHash Content hash of the source file that the cached object was loaded from
+	BinaryCacheWriter(const std::string& typeName, uint64_t sourceHash);
+
+	/// Append a single value as a new section
+	/// \tparam T Type of the value, needs to be trivially copyable
+	/// \param value The value to be written
+	template <class T>
+	void write(const T& value);
+
+	/// Append an array of values as a new section
+	/// \tparam T Type of the values, needs to be trivially copyable
+	/// \param values The values to be written
+	template <class T>
+	void write(const std::vector<T>& values);
+
+	/// Write all the sections to the file, the file is written to a temporary location first and then moved in
+	/// place, so that concurrent readers never see a partially written cache.
+	/// \param fileName Name of the cache file
+	/// \return true if the file was written successfully, false otherwise
+	bool save(const std::string& fileName) const;
+
+private:
+	/// Append a new section
+	/// \param data Pointer to the data of the section
+	/// \param size Size of the section in bytes
+	void writeSection(const void* data, uint64_t size);
+
+	/// The complete content of the cache
+	std::vector<char> m_buffer;
+};
+
+/// Reads a binary cache written by BinaryCacheWriter.
+/// The file is memory mapped, sections are copied out of the mapping as they are read.
+class BinaryCacheReader
+{
+public:
+	/// Constructor, maps the file and validates its header, the source of the cache is checked by the caller
+	/// through getSourceHash()
+	/// \param fileName Name of the cache file
+	/// \param typeName Expected name of the type of the cached object
+	BinaryCacheReader(const std::string& fileName, const std::string& typeName);
+
+	/// Constructor, maps the file and validates its header
+	/// \param fileName Name of the cache file
+	/// \param typeName Expected name of the type of the cached object
+	/// \param sourceHash Expected content hash of the source file
+	BinaryCacheReader(const std::string& fileName, const std::string& typeName, uint64_t sourceHash);
+
+	/// Destructor
+	~BinaryCacheReader();
+
+	/// \return true if the file could be mapped and the header matches the layout version, the type name
+	///         and the source hash, false otherwise
+	bool isValid() const;
+
+	/// \return The content hash of the source file, as written in the header
+	uint64_t getSourceHash() const;
+
+	/// Read a single value from the next section
+	/// \tparam T Type of the value, needs to be trivially copyable
+	/// \param [out] value The value that was read
+	/// \return true if the next section has the size of one T, false otherwise
+	template <class T>
+	bool read(T* value);
+
+	/// Read an array of values from the next section
+	/// \tparam T Type of the values, needs to be trivially copyable
+	/// \param [out] values The values that were read, resized to match the content of the section
+	/// \return true if the section size is a multiple of the size of T, false otherwise
+	template <class T>
+	bool read(std::vector<T>* values);
+
+	/// \return true if all sections have been read
+	bool isAtEnd() const;
+
+private:
+	/// Fetch the next section
+	/// \param [out] data Pointer to the data of the section inside the mapping
+	/// \param [out] size Size of the section in bytes
+	/// \return true if there was a complete section, false otherwise
+	bool readSection(const char** data, uint64_t* size);
+
+	///@{
+	/// Pimpl data, keeps the memory mapping out of the include chain
+	struct Data;
+	std::unique_ptr<Data> m_data;
+	///@}
+
+	/// Current read position
+	const char* m_current;
+
+	/// End of the mapped data
+	const char* m_end;
+
+	/// The content hash of the source file
+	uint64_t m_sourceHash;
+};
+
+/// Load an asset, going through its binary cache if caching is enabled.
+/// If a valid cache for the content of the source file exists, the asset is restored from the cache, otherwise the
+/// asset is loaded from the source file and the cache is written for the next time. The source file is hashed on
+/// every load, its size or modification time do not tell whether it was rewritten with a different content.
+/// \param fileName Name of the source file
+/// \param typeName Name of the type of the asset
+/// \param readCache Restores the asset from a valid cache, returns false if the content of the cache is inconsistent
+/// \param loadSource Loads the asset from the source file, returns false on failure
+/// \param writeCache Writes the content of the loaded asset into the cache
+/// \return true if the asset was loaded, false otherwise
+bool loadWithBinaryCache(const std::string& fileName, const std::string& typeName,
+						 const std::function<bool(BinaryCacheReader*)>& readCache,
+						 const std::function<bool(void)>& loadSource,
+						 const std::function<void(BinaryCacheWriter*)>& writeCache);
+
+}; // namespace DataStructures
+}; // namespace SurgSim
+
+#include "SurgSim/DataStructures/BinaryCache-inl.h"
+
+#endif // SURGSIM_DATASTRUCTURES_BINARYCACHE_H
@@ -48,6 +48,17 @@ std::shared_ptr<OctreeNode<Data>> OctreeNodePlyReaderDelegate<Data>::getOctree()
 	return m_octree;
 }
 
+template <typename Data>
+void OctreeNodePlyReaderDelegate<Data>::processVoxels(const std::string& elementName, size_t first, size_t count,
+		const void* records)
+{
+	const VoxelData* voxels = static_cast<const VoxelData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_octree->addData(SurgSim::Math::Vector3d(voxels[i].x, voxels[i].y, voxels[i].z), m_numLevels);
+	}
+}
+
 template <typename Data>
 void OctreeNodePlyReaderDelegate<Data>::processVoxel(const std::string& elementName)
 {
@@ -68,11 +68,13 @@ bool OctreeNodePlyReaderDelegateBase::registerDelegate(PlyReader* reader)
 	reader->requestScalarProperty("spacing", "y", PlyReader::TYPE_DOUBLE, offsetof(SpacingData, y));
 	reader->requestScalarProperty("spacing", "z", PlyReader::TYPE_DOUBLE, offsetof(SpacingData, z));
 
-	reader->requestElement("voxel",
-						   std::bind(&OctreeNodePlyReaderDelegateBase::beginVoxel, this,
-									 std::placeholders::_1, std::placeholders::_2),
-						   std::bind(&OctreeNodePlyReaderDelegateBase::processVoxel, this, std::placeholders::_1),
-						   nullptr);
+	reader->requestElementBlocks("voxel", sizeof(VoxelData),
+								 std::bind(&OctreeNodePlyReaderDelegateBase::beginVoxels, this,
+										   std::placeholders::_1, std::placeholders::_2),
+								 std::bind(&OctreeNodePlyReaderDelegateBase::processVoxels, this,
+										   std::placeholders::_1, std::placeholders::_2,
+										   std::placeholders::_3, std::placeholders::_4),
+								 nullptr);
 	reader->requestScalarProperty("voxel", "x", PlyReader::TYPE_DOUBLE, offsetof(VoxelData, x));
 	reader->requestScalarProperty("voxel", "y", PlyReader::TYPE_DOUBLE, offsetof(VoxelData, y));
 	reader->requestScalarProperty("voxel", "z", PlyReader::TYPE_DOUBLE, offsetof(VoxelData, z));
@@ -119,7 +121,7 @@ void* OctreeNodePlyReaderDelegateBase::beginSpacing(const std::string& elementNa
 	return &m_spacing;
 }
 
-void* OctreeNodePlyReaderDelegateBase::beginVoxel(const std::string& elementName, size_t count)
+void OctreeNodePlyReaderDelegateBase::beginVoxels(const std::string& elementName, size_t count)
 {
 	SURGSIM_ASSERT(m_haveSpacing) << "Need spacing data for complete octree.";
 	SURGSIM_ASSERT(m_haveBounds) << "Need bounds data for complete octree.";
@@ -137,8 +139,17 @@ void* OctreeNodePlyReaderDelegateBase::beginVoxel(const std::string& elementName
 						  octreeDimensions.array() * spacing.array();
 
 	initializeOctree();
+}
 
-	return &m_voxel;
+void OctreeNodePlyReaderDelegateBase::processVoxels(const std::string& elementName, size_t first, size_t count,
+		const void* records)
+{
+	const VoxelData* voxels = static_cast<const VoxelData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_voxel = voxels[i];
+		processVoxel(elementName);
+	}
 }
 
 }
@@ -64,12 +64,18 @@ class OctreeNodePlyReaderDelegateBase : public PlyReaderDelegate
 
 	/// Callback function, begin the processing of the voxels.
 	/// \param elementName Name of the element.
-	/// \param count Number of bounds entry.
-	/// \return memory for voxel data to the reader.
-	virtual void* beginVoxel(const std::string& elementName, size_t count);
+	/// \param count Number of voxels.
+	virtual void beginVoxels(const std::string& elementName, size_t count);
 
-	/// Callback function to process one voxel. This is left up to the subclasses, they might have to deal with
-	/// data specific processing
+	/// Callback function to process a block of voxels, by default calls processVoxel() for each one of them.
+	/// \param elementName Name of the element.
+	/// \param first Index of the first voxel in the block.
+	/// \param count Number of voxels in the block.
+	/// \param records The VoxelData records for the voxels.
+	virtual void processVoxels(const std::string& elementName, size_t first, size_t count, const void* records);
+
+	/// Process one voxel, the data for the voxel is in m_voxel. This is left up to the subclasses, they might have
+	/// to deal with data specific processing
 	/// \param elementName Name of the element.
 	virtual void processVoxel(const std::string& elementName) = 0;
 
@@ -148,6 +154,8 @@ class OctreeNodePlyReaderDelegate : public OctreeNodePlyReaderDelegateBase
 	/// \return the octree
 	std::shared_ptr<OctreeNode<Data>> getOctree();
 
+	void processVoxels(const std::string& elementName, size_t first, size_t count, const void* records) override;
+
 	void processVoxel(const std::string& elementName) override;
 
 	void initializeOctree() override;
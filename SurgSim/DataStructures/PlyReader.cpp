@@ -14,11 +14,17 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/thread.hpp>
+#include <cstring>
+#include <memory>
 
 #include "SurgSim/DataStructures/PlyReader.h"
 #include "SurgSim/DataStructures/PlyReaderDelegate.h"
 #include "SurgSim/DataStructures/ply.h"
 
+#include "SurgSim/Framework/Barrier.h"
 #include "SurgSim/Framework/Log.h"
 
 #include "SurgSim/Math/Vector.h"
@@ -30,12 +36,369 @@ namespace SurgSim
 namespace DataStructures
 {
 
+namespace
+{
+
+/// Default number of elements per block for elements that are processed in blocks
+const size_t DEFAULT_BLOCK_SIZE = 4096;
+
+/// Sizes of the ply data types, indexed by the PLY_ type constants
+const size_t PLY_TYPE_SIZES[PLY_END_TYPE] = {0, 1, 2, 4, 1, 2, 4, 4, 8};
+
+/// List data is stored with this alignment, to be able to receive any of the ply data types
+const size_t LIST_ALIGNMENT = sizeof(double);
+
+/// Description of a property in the data section of a binary file, and where to store it if it was requested
+struct MappedProperty
+{
+	int externalType;
+	int countExternalType;
+	bool isList;
+	bool isRequested;
+	int dataType;
+	int dataOffset;
+	int countType;
+	int countOffset;
+};
+
+/// Description of an element in the data section of a binary file
+struct MappedElement
+{
+	std::vector<MappedProperty> properties;
+	bool hasLists; ///< true if the element has list properties, the size of the records in the file varies
+	size_t fileSize; ///< For elements without lists, size of one record in the file
+};
+
+/// A block of elements converted from the data section of a binary file
+struct MappedBlock
+{
+	const char* source; ///< Start of the first element of the block in the file
+	size_t first; ///< Index of the first element of the block
+	size_t count; ///< Number of elements in the block
+	std::vector<double> records; ///< Receiving memory, stored as double to be aligned for all types
+	std::vector<double> listData; ///< Receiving memory for the list properties
+};
+
+bool isLittleEndian()
+{
+	const uint16_t probe = 1;
+	return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+/// Read a value from the file
+/// \param source Location of the value
+/// \param type Ply type of the value
+/// \return The value, converted to double which can represent all the ply types exactly
+double readValue(const char* source, int type)
+{
+	switch (type)
+	{
+	case PLY_CHAR:
+		return static_cast<double>(*reinterpret_cast<const int8_t*>(source));
+	case PLY_UCHAR:
+		return static_cast<double>(*reinterpret_cast<const uint8_t*>(source));
+	case PLY_SHORT:
+	{
+		int16_t value;
+		std::memcpy(&value, source, sizeof(value));
+		return static_cast<double>(value);
+	}
+	case PLY_USHORT:
+	{
+		uint16_t value;
+		std::memcpy(&value, source, sizeof(value));
+		return static_cast<double>(value);
+	}
+	case PLY_INT:
+	{
+		int32_t value;
+		std::memcpy(&value, source, sizeof(value));
+		return static_cast<double>(value);
+	}
+	case PLY_UINT:
+	{
+		uint32_t value;
+		std::memcpy(&value, source, sizeof(value));
+		return static_cast<double>(value);
+	}
+	case PLY_FLOAT:
+	{
+		float value;
+		std::memcpy(&value, source, sizeof(value));
+		return static_cast<double>(value);
+	}
+	case PLY_DOUBLE:
+	{
+		double value;
+		std::memcpy(&value, source, sizeof(value));
+		return value;
+	}
+	default:
+		SURGSIM_FAILURE() << "Invalid ply type " << type;
+		return 0.0;
+	}
+}
+
+/// Store a value in the receiving memory
+/// \param value The value
+/// \param type Ply type of the receiving memory
+/// \param destination Location where the value should be stored
+void storeValue(double value, int type, char* destination)
+{
+	switch (type)
+	{
+	case PLY_CHAR:
+		*reinterpret_cast<int8_t*>(destination) = static_cast<int8_t>(value);
+		break;
+	case PLY_UCHAR:
+		*reinterpret_cast<uint8_t*>(destination) = static_cast<uint8_t>(value);
+		break;
+	case PLY_SHORT:
+	{
+		int16_t result = static_cast<int16_t>(value);
+		std::memcpy(destination, &result, sizeof(result));
+		break;
+	}
+	case PLY_USHORT:
+	{
+		uint16_t result = static_cast<uint16_t>(value);
+		std::memcpy(destination, &result, sizeof(result));
+		break;
+	}
+	case PLY_INT:
+	{
+		int32_t result = static_cast<int32_t>(value);
+		std::memcpy(destination, &result, sizeof(result));
+		break;
+	}
+	case PLY_UINT:
+	{
+		uint32_t result = static_cast<uint32_t>(value);
+		std::memcpy(destination, &result, sizeof(result));
+		break;
+	}
+	case PLY_FLOAT:
+	{
+		float result = static_cast<float>(value);
+		std::memcpy(destination, &result, sizeof(result));
+		break;
+	}
+	case PLY_DOUBLE:
+		std::memcpy(destination, &value, sizeof(value));
+		break;
+	default:
+		SURGSIM_FAILURE() << "Invalid ply type " << type;
+	}
+}
+
+/// Convert a value from the file into the receiving memory
+void convertValue(const char* source, int externalType, char* destination, int internalType)
+{
+	if (externalType == internalType)
+	{
+		std::memcpy(destination, source, PLY_TYPE_SIZES[externalType]);
+	}
+	else
+	{
+		storeValue(readValue(source, externalType), internalType, destination);
+	}
+}
+
+/// Find the end of a record in the file
+/// \param element The layout of the element
+/// \param source The start of the record
+/// \param end The end of the mapped file
+/// \param [in,out] listDataSize Incremented by the memory needed for the requested lists of the record
+/// \return The end of the record, nullptr if the record does not fit into the file
+const char* skipRecord(const MappedElement& element, const char* source, const char* end, size_t* listDataSize)
+{
+	if (!element.hasLists)
+	{
+		return (static_cast<size_t>(end - source) >= element.fileSize) ? source + element.fileSize : nullptr;
+	}
+
+	for (const auto& property : element.properties)
+	{
+		if (property.isList)
+		{
+			const size_t countSize = PLY_TYPE_SIZES[property.countExternalType];
+			if (static_cast<size_t>(end - source) < countSize)
+			{
+				return nullptr;
+			}
+			const double count = readValue(source, property.countExternalType);
+			if (count < 0.0)
+			{
+				return nullptr;
+			}
+			const size_t listCount = static_cast<size_t>(count);
+			source += countSize;
+			if (static_cast<size_t>(end - source) / PLY_TYPE_SIZES[property.externalType] < listCount)
+			{
+				return nullptr;
+			}
+			source += listCount * PLY_TYPE_SIZES[property.externalType];
+			if (property.isRequested)
+			{
+				const size_t size = listCount * PLY_TYPE_SIZES[property.dataType];
+				*listDataSize += (size + LIST_ALIGNMENT - 1) / LIST_ALIGNMENT * LIST_ALIGNMENT;
+			}
+		}
+		else
+		{
+			if (static_cast<size_t>(end - source) < PLY_TYPE_SIZES[property.externalType])
+			{
+				return nullptr;
+			}
+			source += PLY_TYPE_SIZES[property.externalType];
+		}
+	}
+	return source;
+}
+
+/// Convert a record from the file into the receiving memory, the record needs to have been validated by skipRecord()
+/// \param element The layout of the element
+/// \param source The start of the record
+/// \param record The receiving memory for the element
+/// \param [in,out] listData The receiving memory for the lists of the element, advanced past the stored lists
+/// \return The end of the record
+const char* convertRecord(const MappedElement& element, const char* source, char* record, char** listData)
+{
+	for (const auto& property : element.properties)
+	{
+		if (property.isList)
+		{
+			const size_t count = static_cast<size_t>(readValue(source, property.countExternalType));
+			source += PLY_TYPE_SIZES[property.countExternalType];
+			if (property.isRequested)
+			{
+				storeValue(static_cast<double>(count), property.countType, record + property.countOffset);
+				void* list = (count > 0) ? *listData : nullptr;
+				std::memcpy(record + property.dataOffset, &list, sizeof(list));
+				for (size_t i = 0; i < count; ++i)
+				{
+					convertValue(source + i * PLY_TYPE_SIZES[property.externalType], property.externalType,
+								 *listData + i * PLY_TYPE_SIZES[property.dataType], property.dataType);
+				}
+				const size_t size = count * PLY_TYPE_SIZES[property.dataType];
+				*listData += (size + LIST_ALIGNMENT - 1) / LIST_ALIGNMENT * LIST_ALIGNMENT;
+			}
+			source += count * PLY_TYPE_SIZES[property.externalType];
+		}
+		else
+		{
+			if (property.isRequested)
+			{
+				convertValue(source, property.externalType, record + property.dataOffset, property.dataType);
+			}
+			source += PLY_TYPE_SIZES[property.externalType];
+		}
+	}
+	return source;
+}
+
+/// Convert all the elements of a block into its receiving memory
+/// \param element The layout of the element
+/// \param recordSize The size of the receiving memory for one element
+/// \param block The block, the receiving memory needs to be allocated already
+void convertBlock(const MappedElement& element, size_t recordSize, MappedBlock* block)
+{
+	const char* source = block->source;
+	char* record = reinterpret_cast<char*>(block->records.data());
+	char* listData = reinterpret_cast<char*>(block->listData.data());
+	for (size_t i = 0; i < block->count; ++i)
+	{
+		source = convertRecord(element, source, record, &listData);
+		record += recordSize;
+	}
+}
+
+/// Worker threads converting the blocks of the batches, created once per parse
+class BlockConverter
+{
+public:
+	/// Constructor
+	/// \param threadCount The number of threads converting a batch, the calling thread included
+	explicit BlockConverter(size_t threadCount) :
+		m_barrier(threadCount),
+		m_element(nullptr),
+		m_recordSize(0),
+		m_blocks(nullptr),
+		m_blockCount(0)
+	{
+		for (size_t i = 1; i < threadCount; ++i)
+		{
+			m_threads.emplace_back([this, i]()
+			{
+				while (m_barrier.wait(true))
+				{
+					if (i < m_blockCount)
+					{
+						convertBlock(*m_element, m_recordSize, &(*m_blocks)[i]);
+					}
+					if (!m_barrier.wait(true))
+					{
+						break;
+					}
+				}
+			});
+		}
+	}
+
+	/// Destructor, stops the worker threads
+	~BlockConverter()
+	{
+		m_barrier.wait(false);
+		for (auto& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	/// Convert a batch of blocks, one per thread, the calling thread takes the first one
+	/// \param element The layout of the element
+	/// \param recordSize The size of the receiving memory for one element
+	/// \param blocks The blocks, the receiving memory needs to be allocated already
+	/// \param blockCount The number of blocks of the batch, at most the number of threads
+	void convert(const MappedElement& element, size_t recordSize, std::vector<MappedBlock>* blocks,
+				 size_t blockCount)
+	{
+		m_element = &element;
+		m_recordSize = recordSize;
+		m_blocks = blocks;
+		m_blockCount = blockCount;
+
+		m_barrier.wait(true);
+		convertBlock(element, recordSize, &(*blocks)[0]);
+		m_barrier.wait(true);
+	}
+
+private:
+	/// Synchronizes the start and the end of the batches, and the end of the workers
+	SurgSim::Framework::Barrier m_barrier;
+
+	/// The worker threads
+	std::vector<boost::thread> m_threads;
+
+	///@{
+	/// The batch being converted, published to the workers by the barrier
+	const MappedElement* m_element;
+	size_t m_recordSize;
+	std::vector<MappedBlock>* m_blocks;
+	size_t m_blockCount;
+	///@}
+};
+
+}
+
 // Pimpl data, keep ply.h out of the SurgSim include chain
 struct PlyReader::Data
 {
 	Data() :
 		plyFile(nullptr),
-		elementNames(nullptr)
+		elementCount(0),
+		elementNames(nullptr),
+		dataStart(0)
 	{
 		types[TYPE_INVALID] = PLY_START_TYPE;
 		types[TYPE_CHAR] = PLY_CHAR;
@@ -54,11 +417,14 @@ struct PlyReader::Data
 	int elementCount;
 	char** elementNames;
 	std::unordered_map<int, int> types;
+
+	/// Position of the data section in the file
+	long dataStart;
 };
 
 
 PlyReader::PlyReader(const std::string& filename) :
-	m_filename(filename), m_data(new Data())
+	m_filename(filename), m_blockSize(DEFAULT_BLOCK_SIZE), m_data(new Data())
 {
 	m_data->plyFile = ply_open_for_reading(
 		filename.data(),
@@ -67,6 +433,11 @@ PlyReader::PlyReader(const std::string& filename) :
 		&m_data->file_type,
 		&m_data->version);
 
+	if (isValid())
+	{
+		m_data->dataStart = ftell(m_data->plyFile->fp);
+	}
+
 	SURGSIM_LOG_IF(!isValid(), SurgSim::Framework::Logger::getLogger("InputOutput"), WARNING) <<
 		"'" << m_filename << "' is an invalid .ply file";
 }
@@ -107,6 +478,7 @@ bool PlyReader::requestElement(const std::string& elementName,
 		info.startElementCallback = startElementCallback;
 		info.endElementCallback = endElementCallback;
 		info.processElementCallback = processElementCallback;
+		info.recordSize = 0;
 
 		m_requestedElements[elementName] = info;
 		result = true;
@@ -115,6 +487,45 @@ bool PlyReader::requestElement(const std::string& elementName,
 	return result;
 }
 
+bool PlyReader::requestElementBlocks(const std::string& elementName, size_t recordSize,
+									 StartBlockElementCallbackType startElementCallback,
+									 ProcessBlockCallbackType processBlockCallback,
+									 StandardCallbackType endElementCallback)
+{
+	SURGSIM_ASSERT(isValid()) << "'" << m_filename << "' is an invalid .ply file";
+	SURGSIM_ASSERT(recordSize > 0) << "The record size for element <" << elementName << "> cannot be 0.";
+	SURGSIM_ASSERT(processBlockCallback != nullptr) <<
+		"Elements that are processed in blocks need a process callback, element <" << elementName << ">.";
+
+	bool result = false;
+
+	if (hasElement(elementName) && m_requestedElements.find(elementName) == m_requestedElements.end())
+	{
+		ElementInfo info;
+		info.name = elementName;
+		info.startBlockElementCallback = startElementCallback;
+		info.processBlockCallback = processBlockCallback;
+		info.endElementCallback = endElementCallback;
+		info.recordSize = recordSize;
+
+		m_requestedElements[elementName] = info;
+		result = true;
+	}
+
+	return result;
+}
+
+void PlyReader::setBlockSize(size_t blockSize)
+{
+	SURGSIM_ASSERT(blockSize > 0) << "The block size cannot be 0.";
+	m_blockSize = blockSize;
+}
+
+size_t PlyReader::getBlockSize() const
+{
+	return m_blockSize;
+}
+
 bool PlyReader::requestScalarProperty(const std::string& elementName, const std::string& propertyName,
 									  int dataType, int dataOffset)
 {
@@ -177,6 +588,21 @@ bool PlyReader::requestProperty(const std::string& elementName,
 		bool doAdd = std::find_if(itBegin, itEnd,
 			[propertyName](PropertyInfo p){return p.propertyName == propertyName;}) == itEnd;
 
+		auto element = m_requestedElements.find(elementName);
+		if (doAdd && element != m_requestedElements.end() && element->second.recordSize > 0)
+		{
+			// Block processing uses memory allocated by the reader, make sure the property fits into the record
+			const size_t recordSize = element->second.recordSize;
+			const size_t dataSize = wantScalar ? PLY_TYPE_SIZES[m_data->types[dataType]] : sizeof(void*);
+			SURGSIM_ASSERT(dataOffset >= 0 && dataOffset + dataSize <= recordSize) <<
+				"The property <" << propertyName << "> does not fit into the record of element <" <<
+				elementName << ">.";
+			SURGSIM_ASSERT(wantScalar ||
+				(countOffset >= 0 && countOffset + PLY_TYPE_SIZES[m_data->types[countType]] <= recordSize)) <<
+				"The count of property <" << propertyName << "> does not fit into the record of element <" <<
+				elementName << ">.";
+		}
+
 		if (doAdd)
 		{
 			PropertyInfo info;
@@ -217,6 +643,28 @@ void PlyReader::parseFile()
 		m_startParseFileCallback();
 	}
 
+	if (isMappedParsing())
+	{
+		parseMapped();
+	}
+	else
+	{
+		parseWithPly();
+	}
+
+	if (m_endParseFileCallback != nullptr)
+	{
+		m_endParseFileCallback();
+	}
+}
+
+bool PlyReader::isMappedParsing() const
+{
+	return isValid() && m_data->file_type == PLY_BINARY_LE && isLittleEndian();
+}
+
+void PlyReader::parseWithPly()
+{
 	char* currentElementName;
 	for (int elementIndex = 0; elementIndex < m_data->elementCount; ++elementIndex)
 	{
@@ -260,49 +708,69 @@ void PlyReader::parseFile()
 				ply_get_property(m_data->plyFile, currentElementName, &requestedProperty);
 			}
 
-			void* readBuffer = elementInfo.startElementCallback(currentElementName, numberOfElements);
-
-			for (int element = 0; element < numberOfElements; ++element)
+			if (elementInfo.processBlockCallback != nullptr)
 			{
-				ply_get_element(m_data->plyFile, readBuffer);
-				if (elementInfo.processElementCallback != nullptr)
+				try
 				{
-					try
+					parseBlocksWithPly(elementInfo, numberOfElements, listOffsets);
+				}
+				catch (const std::exception&)
+				{
+					for (int i = 0; i < propertyCount; ++i)
 					{
-						elementInfo.processElementCallback(currentElementName);
+						free(properties[i]->name);
+						free(properties[i]);
 					}
-					catch (const std::exception&)
+					free(properties);
+					throw;
+				}
+			}
+			else
+			{
+				void* readBuffer = elementInfo.startElementCallback(currentElementName, numberOfElements);
+
+				for (int element = 0; element < numberOfElements; ++element)
+				{
+					ply_get_element(m_data->plyFile, readBuffer);
+					if (elementInfo.processElementCallback != nullptr)
 					{
-						for (size_t i = 0; i<listOffsets.size(); ++i)
+						try
 						{
-							void** item = (void **)((char *)readBuffer + listOffsets[i]); // NOLINT
-							free(item[0]);
+							elementInfo.processElementCallback(currentElementName);
 						}
-						for (int i = 0; i < propertyCount; ++i)
+						catch (const std::exception&)
 						{
-							free(properties[i]->name);
-							free(properties[i]);
+							for (size_t i = 0; i<listOffsets.size(); ++i)
+							{
+								void** item = (void **)((char *)readBuffer + listOffsets[i]); // NOLINT
+								free(item[0]);
+							}
+							for (int i = 0; i < propertyCount; ++i)
+							{
+								free(properties[i]->name);
+								free(properties[i]);
+							}
+							free(properties);
+							throw;
 						}
-						free(properties);
-						throw;
 					}
+
+					// Free the lists that where allocated by plyreader
+					// This gains access to the buffer, where ply.c put the address of
+					// the memory that was allocated to carry the information for the list property
+					// it does that for all properties that where marked as lists
+					for (size_t i = 0; i<listOffsets.size(); ++i)
+					{
+						void** item = (void **)((char *)readBuffer + listOffsets[i]); // NOLINT
+						free(item[0]);
+					}
+
 				}
 
-				// Free the lists that where allocated by plyreader
-				// This gains access to the buffer, where ply.c put the address of
-				// the memory that was allocated to carry the information for the list property
-				// it does that for all properties that where marked as lists
-				for (size_t i = 0; i<listOffsets.size(); ++i)
+				if (elementInfo.endElementCallback != nullptr)
 				{
-					void** item = (void **)((char *)readBuffer + listOffsets[i]); // NOLINT
-					free(item[0]);
+					elementInfo.endElementCallback(currentElementName);
 				}
-
-			}
-
-			if (elementInfo.endElementCallback != nullptr)
-			{
-				elementInfo.endElementCallback(currentElementName);
 			}
 		}
 		else
@@ -323,10 +791,235 @@ void PlyReader::parseFile()
 		}
 		free(properties);
 	}
+}
 
-	if (m_endParseFileCallback != nullptr)
+void PlyReader::parseBlocksWithPly(const ElementInfo& elementInfo, size_t numberOfElements,
+								   const std::vector<int>& listOffsets)
+{
+	if (elementInfo.startBlockElementCallback != nullptr)
 	{
-		m_endParseFileCallback();
+		elementInfo.startBlockElementCallback(elementInfo.name, numberOfElements);
+	}
+
+	const size_t recordSize = elementInfo.recordSize;
+	std::vector<double> records((std::min(m_blockSize, numberOfElements) * recordSize + sizeof(double) - 1) /
+								sizeof(double));
+	char* buffer = reinterpret_cast<char*>(records.data());
+
+	// Free the lists that where allocated by plyreader for the elements of the block
+	auto freeLists = [&listOffsets, buffer, recordSize](size_t count)
+	{
+		for (size_t element = 0; element < count; ++element)
+		{
+			for (size_t i = 0; i < listOffsets.size(); ++i)
+			{
+				void** item = reinterpret_cast<void**>(buffer + element * recordSize + listOffsets[i]);
+				free(item[0]);
+				item[0] = nullptr;
+			}
+		}
+	};
+
+	for (size_t first = 0; first < numberOfElements; first += m_blockSize)
+	{
+		const size_t count = std::min(m_blockSize, numberOfElements - first);
+		std::fill(records.begin(), records.end(), 0.0);
+		for (size_t element = 0; element < count; ++element)
+		{
+			ply_get_element(m_data->plyFile, buffer + element * recordSize);
+		}
+
+		try
+		{
+			elementInfo.processBlockCallback(elementInfo.name, first, count, buffer);
+		}
+		catch (const std::exception&)
+		{
+			freeLists(count);
+			throw;
+		}
+		freeLists(count);
+	}
+
+	if (elementInfo.endElementCallback != nullptr)
+	{
+		elementInfo.endElementCallback(elementInfo.name);
+	}
+}
+
+void PlyReader::parseMapped()
+{
+	boost::interprocess::file_mapping mapping;
+	boost::interprocess::mapped_region region;
+	try
+	{
+		mapping = boost::interprocess::file_mapping(m_filename.c_str(), boost::interprocess::read_only);
+		region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+	}
+	catch (const boost::interprocess::interprocess_exception& exception)
+	{
+		SURGSIM_FAILURE() << "Could not map '" << m_filename << "': " << exception.what();
+	}
+
+	const char* begin = static_cast<const char*>(region.get_address());
+	const char* end = begin + region.get_size();
+	SURGSIM_ASSERT(m_data->dataStart >= 0 && static_cast<size_t>(m_data->dataStart) <= region.get_size()) <<
+		"Invalid data section in '" << m_filename << "'.";
+	const char* current = begin + m_data->dataStart;
+
+	const size_t threadCount = std::max(1u, boost::thread::hardware_concurrency());
+	std::unique_ptr<BlockConverter> converter;
+
+	for (int elementIndex = 0; elementIndex < m_data->elementCount; ++elementIndex)
+	{
+		const PlyElement* plyElement = m_data->plyFile->elems[elementIndex];
+		const std::string elementName(plyElement->name);
+		const size_t numberOfElements = static_cast<size_t>(std::max(0, plyElement->num));
+
+		auto requested = m_requestedElements.find(elementName);
+		const ElementInfo* elementInfo = (requested != m_requestedElements.end()) ? &requested->second : nullptr;
+
+		// Match the properties in the file with the requested properties
+		MappedElement element;
+		element.hasLists = false;
+		element.fileSize = 0;
+		for (int propertyIndex = 0; propertyIndex < plyElement->nprops; ++propertyIndex)
+		{
+			const PlyProperty* plyProperty = plyElement->props[propertyIndex];
+			MappedProperty property = {plyProperty->external_type, plyProperty->count_external,
+									   plyProperty->is_list == PLY_LIST, false, 0, 0, 0, 0};
+			SURGSIM_ASSERT(property.externalType > PLY_START_TYPE && property.externalType < PLY_END_TYPE &&
+						   (!property.isList || (property.countExternalType > PLY_START_TYPE &&
+												 property.countExternalType < PLY_END_TYPE))) <<
+				"Invalid type for property <" << plyProperty->name << "> in '" << m_filename << "'.";
+
+			if (elementInfo != nullptr)
+			{
+				for (const auto& info : elementInfo->requestedProperties)
+				{
+					if (info.propertyName == plyProperty->name)
+					{
+						property.isRequested = true;
+						property.dataType = info.dataType;
+						property.dataOffset = info.dataOffset;
+						property.countType = info.countType;
+						property.countOffset = info.countOffset;
+					}
+				}
+			}
+
+			element.hasLists = element.hasLists || property.isList;
+			element.fileSize += PLY_TYPE_SIZES[property.externalType];
+			element.properties.push_back(property);
+		}
+
+		if (elementInfo == nullptr)
+		{
+			for (size_t i = 0; i < numberOfElements; ++i)
+			{
+				size_t listDataSize = 0;
+				current = skipRecord(element, current, end, &listDataSize);
+				SURGSIM_ASSERT(current != nullptr) << "'" << m_filename << "' is truncated in element <" <<
+					elementName << ">.";
+			}
+		}
+		else if (elementInfo->processBlockCallback == nullptr)
+		{
+			void* readBuffer = elementInfo->startElementCallback(elementName, numberOfElements);
+			std::vector<double> listData;
+			for (size_t i = 0; i < numberOfElements; ++i)
+			{
+				size_t listDataSize = 0;
+				const char* next = skipRecord(element, current, end, &listDataSize);
+				SURGSIM_ASSERT(next != nullptr) << "'" << m_filename << "' is truncated in element <" <<
+					elementName << ">.";
+
+				listData.resize(listDataSize / sizeof(double));
+				char* listPointer = reinterpret_cast<char*>(listData.data());
+				current = convertRecord(element, current, static_cast<char*>(readBuffer), &listPointer);
+
+				if (elementInfo->processElementCallback != nullptr)
+				{
+					elementInfo->processElementCallback(elementName);
+				}
+			}
+
+			if (elementInfo->endElementCallback != nullptr)
+			{
+				elementInfo->endElementCallback(elementName);
+			}
+		}
+		else
+		{
+			if (elementInfo->startBlockElementCallback != nullptr)
+			{
+				elementInfo->startBlockElementCallback(elementName, numberOfElements);
+			}
+
+			const size_t recordSize = elementInfo->recordSize;
+			std::vector<MappedBlock> blocks(threadCount);
+			size_t first = 0;
+			while (first < numberOfElements)
+			{
+				// Locate the blocks of this batch in the file, and allocate their memory
+				size_t blockCount = 0;
+				for (; blockCount < threadCount && first < numberOfElements; ++blockCount)
+				{
+					MappedBlock& block = blocks[blockCount];
+					block.source = current;
+					block.first = first;
+					block.count = std::min(m_blockSize, numberOfElements - first);
+
+					size_t listDataSize = 0;
+					if (element.hasLists)
+					{
+						for (size_t i = 0; i < block.count && current != nullptr; ++i)
+						{
+							current = skipRecord(element, current, end, &listDataSize);
+						}
+					}
+					else if (static_cast<size_t>(end - current) / element.fileSize >= block.count)
+					{
+						current += block.count * element.fileSize;
+					}
+					else
+					{
+						current = nullptr;
+					}
+					SURGSIM_ASSERT(current != nullptr) << "'" << m_filename << "' is truncated in element <" <<
+						elementName << ">.";
+
+					block.records.assign((block.count * recordSize + sizeof(double) - 1) / sizeof(double), 0.0);
+					block.listData.resize(listDataSize / sizeof(double));
+					first += block.count;
+				}
+
+				// Convert the blocks in parallel, the workers are only started for the first batch of several blocks
+				if (blockCount > 1)
+				{
+					if (converter == nullptr)
+					{
+						converter.reset(new BlockConverter(threadCount));
+					}
+					converter->convert(element, recordSize, &blocks, blockCount);
+				}
+				else
+				{
+					convertBlock(element, recordSize, &blocks[0]);
+				}
+
+				for (size_t i = 0; i < blockCount; ++i)
+				{
+					elementInfo->processBlockCallback(elementName, blocks[i].first, blocks[i].count,
+													  blocks[i].records.data());
+				}
+			}
+
+			if (elementInfo->endElementCallback != nullptr)
+			{
+				elementInfo->endElementCallback(elementName);
+			}
+		}
 	}
 }
 
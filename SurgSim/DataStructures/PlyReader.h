@@ -77,6 +77,20 @@ class PlyReaderDelegate;
 /// - The EndElement callback is called whenever processing of the element is concluded, this
 /// 	gives users a chance to finalize processing on their side.
 ///
+/// ## Block processing
+/// Instead of being called for every single element, users can request an element for block processing using
+/// requestElementBlocks(). The reader then allocates the receiving memory itself, one record of the given size per
+/// element, and hands the records over in contiguous blocks of up to getBlockSize() elements. The properties are
+/// requested in the same way as for single elements, the offsets are relative to the start of each record. The
+/// begin callback receives the number of elements from the header, so that users can preallocate their storage.
+/// Memory for list properties is owned by the reader, it is only valid for the duration of the block callback.
+///
+/// ## Binary little endian files
+/// Binary little endian files (on little endian machines) do not go through the C parser for the data section,
+/// the file is memory mapped and the requested properties are converted directly from the mapping. Blocks of the
+/// same element are converted in parallel, the callbacks are still called in file order from the thread calling
+/// parseFile().
+///
 /// ## The delegate
 /// The PlyReaderDelegate interface should be used to create classes that encapsulate the needed
 /// callbacks and their processing.
@@ -110,6 +124,16 @@ class PlyReader
 	/// the name of the element that is being processed.
 	typedef std::function<void (const std::string&)> StandardCallbackType;
 
+	/// The callback that is being used to indicate the start of an element that is processed in blocks, the
+	/// parameters are the name of the element and the number of elements that will be processed.
+	typedef std::function<void (const std::string&, size_t)> StartBlockElementCallbackType;
+
+	/// The callback that is used for processing a block of elements, the parameters are the name of the element,
+	/// the index of the first element in the block, the number of elements in the block and a pointer to the
+	/// records of the block. The records are stored contiguously, with the size that was given in
+	/// requestElementBlocks().
+	typedef std::function<void (const std::string&, size_t, size_t, const void*)> ProcessBlockCallbackType;
+
 	/// Constructor.
 	/// \param	filename	Filename of the .ply file.
 	explicit PlyReader(const std::string& filename);
@@ -134,6 +158,26 @@ class PlyReader
 						std::function<void (const std::string&)> processElementCallback,
 						std::function<void (const std::string&)> endElementCallback);
 
+	/// Request element to be processed in blocks during parsing.
+	/// \param	elementName Name of the element that is needed.
+	/// \param	recordSize Size of the record for one element in bytes, the requested properties are stored in the
+	/// 		record at their offsets.
+	/// \param	startElementCallback The callback to be used when the element is first encountered.
+	/// \param	processBlockCallback The callback to be used when a block of elements of this type has been read.
+	/// \param	endElementCallback The callback to be used when all of the elements of this type have been read.
+	/// \return	true if there is a element elementName in the .ply file and it has not been requested yet.
+	bool requestElementBlocks(const std::string& elementName, size_t recordSize,
+							  StartBlockElementCallbackType startElementCallback,
+							  ProcessBlockCallbackType processBlockCallback,
+							  StandardCallbackType endElementCallback);
+
+	/// Set the maximum number of elements per block for elements that are processed in blocks.
+	/// \param blockSize The number of elements per block, needs to be larger than 0.
+	void setBlockSize(size_t blockSize);
+
+	/// \return the maximum number of elements per block for elements that are processed in blocks.
+	size_t getBlockSize() const;
+
 	/// Request a scalar property for parsing.
 	/// Use this for when you want the information from a scalar property from the .ply file. With this call
 	/// you register the type that you want for storing the data and the offset in the data structure where the
@@ -205,6 +249,10 @@ class PlyReader
 	/// Parse the file.
 	void parseFile();
 
+	/// \return true if the data section of the file is memory mapped and converted in parallel, this is done for
+	/// 		binary little endian files on little endian machines.
+	bool isMappedParsing() const;
+
 private:
 	friend class PlyReaderTests;
 
@@ -226,6 +274,9 @@ class PlyReader
 	/// The name of the .ply file
 	std::string m_filename;
 
+	/// The maximum number of elements per block
+	size_t m_blockSize;
+
 	/// Information about the property on the .ply file.
 	struct PropertyInfo
 	{
@@ -243,11 +294,27 @@ class PlyReader
 		StartElementCallbackType startElementCallback; ///< Callback to be used when the element is first encountered.
 		StandardCallbackType processElementCallback; ///< Callback to be used for each processed element.
 		StandardCallbackType endElementCallback; ///< Callback to be used after all the elements have been processed.
+		StartBlockElementCallbackType startBlockElementCallback; ///< Callback to be used for block processing.
+		ProcessBlockCallbackType processBlockCallback; ///< Callback to be used for each processed block.
+		size_t recordSize; ///< For block processing, size of the receiving record for one element.
 		std::vector<PropertyInfo> requestedProperties; ///< All the properties that are wanted
 	};
 
 	std::unordered_map<std::string, ElementInfo> m_requestedElements;
 
+	/// Parse the data section with the C parser.
+	void parseWithPly();
+
+	/// Parse the data section directly from the memory mapped file.
+	void parseMapped();
+
+	/// Process an element with the C parser in blocks.
+	/// \param elementInfo The requested element.
+	/// \param numberOfElements The number of elements in the file.
+	/// \param listOffsets The offsets of the requested list properties in the record.
+	void parseBlocksWithPly(const ElementInfo& elementInfo, size_t numberOfElements,
+							const std::vector<int>& listOffsets);
+
 	///@{
 	/// Pimpl Data to wrap ply reader local information
 	struct Data;
@@ -16,6 +16,9 @@
 #ifndef SURGSIM_DATASTRUCTURES_TRIANGLEMESH_INL_H
 #define SURGSIM_DATASTRUCTURES_TRIANGLEMESH_INL_H
 
+#include <algorithm>
+#include <type_traits>
+
 #include "SurgSim/Framework/Log.h"
 
 
@@ -278,6 +281,31 @@ bool TriangleMesh<VertexData, EdgeData, TriangleData>::isEqual(const Vertices<Ve
 
 template <class VertexData, class EdgeData, class TriangleData>
 bool TriangleMesh<VertexData, EdgeData, TriangleData>::doLoad(const std::string& fileName)
+{
+	// The cache only holds the positions and the ids, meshes carrying vertex, edge or triangle data are always parsed
+	if (!std::is_same<VertexData, EmptyData>::value || !std::is_same<EdgeData, EmptyData>::value ||
+		!std::is_same<TriangleData, EmptyData>::value)
+	{
+		return loadPly(fileName);
+	}
+
+	return loadWithBinaryCache(fileName, getClassName(),
+		[this](BinaryCacheReader* reader)
+		{
+			if (!loadBinaryCache(reader))
+			{
+				return false;
+			}
+			// Matches the parsing of the .ply file, which updates the mesh at the end of the file
+			this->update();
+			return true;
+		},
+		std::bind(&TriangleMesh::loadPly, this, fileName),
+		std::bind(&TriangleMesh::saveBinaryCache, this, std::placeholders::_1));
+}
+
+template <class VertexData, class EdgeData, class TriangleData>
+bool TriangleMesh<VertexData, EdgeData, TriangleData>::loadPly(const std::string& fileName)
 {
 	PlyReader reader(fileName);
 	if (! reader.isValid())
@@ -299,6 +327,85 @@ bool TriangleMesh<VertexData, EdgeData, TriangleData>::doLoad(const std::string&
 	return true;
 }
 
+template <class VertexData, class EdgeData, class TriangleData>
+void TriangleMesh<VertexData, EdgeData, TriangleData>::saveBinaryCache(BinaryCacheWriter* writer) const
+{
+	const auto& vertices = getVertices();
+	std::vector<double> positions;
+	positions.reserve(3 * vertices.size());
+	for (const auto& vertex : vertices)
+	{
+		positions.insert(positions.end(), vertex.position.data(), vertex.position.data() + 3);
+	}
+
+	std::vector<size_t> edges;
+	edges.reserve(2 * m_edges.size());
+	for (const auto& edge : m_edges)
+	{
+		edges.insert(edges.end(), edge.verticesId.begin(), edge.verticesId.end());
+	}
+
+	std::vector<size_t> triangles;
+	triangles.reserve(3 * m_triangles.size());
+	for (const auto& triangle : m_triangles)
+	{
+		if (triangle.isValid)
+		{
+			triangles.insert(triangles.end(), triangle.verticesId.begin(), triangle.verticesId.end());
+		}
+	}
+
+	writer->write(positions);
+	writer->write(edges);
+	writer->write(triangles);
+}
+
+template <class VertexData, class EdgeData, class TriangleData>
+bool TriangleMesh<VertexData, EdgeData, TriangleData>::loadBinaryCache(BinaryCacheReader* reader)
+{
+	std::vector<double> positions;
+	std::vector<size_t> edges;
+	std::vector<size_t> triangles;
+	if (!reader->read(&positions) || !reader->read(&edges) || !reader->read(&triangles) ||
+		positions.size() % 3 != 0 || edges.size() % 2 != 0 || triangles.size() % 3 != 0)
+	{
+		return false;
+	}
+
+	const size_t numVertices = positions.size() / 3;
+	if (std::any_of(edges.begin(), edges.end(), [numVertices](size_t id) {return id >= numVertices;}) ||
+		std::any_of(triangles.begin(), triangles.end(), [numVertices](size_t id) {return id >= numVertices;}))
+	{
+		return false;
+	}
+
+	this->clear();
+
+	getVertices().reserve(numVertices);
+	for (size_t i = 0; i < positions.size(); i += 3)
+	{
+		addVertex(VertexType(SurgSim::Math::Vector3d(positions[i], positions[i + 1], positions[i + 2])));
+	}
+
+	std::array<size_t, 2> edge;
+	m_edges.reserve(edges.size() / 2);
+	for (size_t i = 0; i < edges.size(); i += 2)
+	{
+		std::copy(edges.begin() + i, edges.begin() + i + 2, edge.begin());
+		addEdge(EdgeType(edge));
+	}
+
+	std::array<size_t, 3> triangle;
+	m_triangles.reserve(triangles.size() / 3);
+	for (size_t i = 0; i < triangles.size(); i += 3)
+	{
+		std::copy(triangles.begin() + i, triangles.begin() + i + 3, triangle.begin());
+		addTriangle(TriangleType(triangle));
+	}
+
+	return true;
+}
+
 template <class VertexData, class EdgeData, class TriangleData>
 void TriangleMesh<VertexData, EdgeData, TriangleData>::doClear()
 {
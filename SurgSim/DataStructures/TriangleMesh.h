@@ -19,6 +19,7 @@
 #include <array>
 #include <memory>
 
+#include "SurgSim/DataStructures/BinaryCache.h"
 #include "SurgSim/DataStructures/EmptyData.h"
 #include "SurgSim/DataStructures/MeshElement.h"
 #include "SurgSim/DataStructures/NormalData.h"
@@ -219,6 +220,23 @@ class TriangleMesh : public Vertices<VertexData>, public SurgSim::Framework::Ass
 
 	bool doLoad(const std::string& fileName) override;
 
+	/// Load the mesh from a .ply file, bypassing the binary cache
+	/// \param fileName Name of the .ply file
+	/// \return true if the file was parsed successfully, false otherwise
+	bool loadPly(const std::string& fileName);
+
+	/// Write the vertex positions, the edges and the triangles of the mesh into a binary cache
+	/// \note The vertex, edge and triangle data are not written, doLoad() only uses the cache for meshes without data
+	/// \param writer The cache writer
+	void saveBinaryCache(BinaryCacheWriter* writer) const;
+
+	/// Replace the vertices, edges and triangles of the mesh with the content of a binary cache written by
+	/// saveBinaryCache(), the mesh is only modified if the content of the cache is consistent.
+	/// \note This does not call update()
+	/// \param reader The cache reader
+	/// \return true if the content of the cache was consistent, false otherwise
+	bool loadBinaryCache(BinaryCacheReader* reader);
+
 	using Vertices<VertexData>::doClearVertices;
 
 	static std::string m_className;
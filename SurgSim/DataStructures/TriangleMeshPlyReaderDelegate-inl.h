@@ -52,11 +52,13 @@ template <class M>
 bool SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::registerDelegate(PlyReader* reader)
 {
 	// Vertex processing
-	reader->requestElement("vertex",
-						   std::bind(&TriangleMeshPlyReaderDelegate::beginVertices, this,
-									 std::placeholders::_1, std::placeholders::_2),
-						   std::bind(&TriangleMeshPlyReaderDelegate::processVertex, this, std::placeholders::_1),
-						   std::bind(&TriangleMeshPlyReaderDelegate::endVertices, this, std::placeholders::_1));
+	reader->requestElementBlocks("vertex", sizeof(VertexData),
+								 std::bind(&TriangleMeshPlyReaderDelegate::beginVertices, this,
+										   std::placeholders::_1, std::placeholders::_2),
+								 std::bind(&TriangleMeshPlyReaderDelegate::processVertices, this,
+										   std::placeholders::_1, std::placeholders::_2,
+										   std::placeholders::_3, std::placeholders::_4),
+								 std::bind(&TriangleMeshPlyReaderDelegate::endVertices, this, std::placeholders::_1));
 	reader->requestScalarProperty("vertex", "x", PlyReader::TYPE_DOUBLE, offsetof(VertexData, x));
 	reader->requestScalarProperty("vertex", "y", PlyReader::TYPE_DOUBLE, offsetof(VertexData, y));
 	reader->requestScalarProperty("vertex", "z", PlyReader::TYPE_DOUBLE, offsetof(VertexData, z));
@@ -74,11 +76,13 @@ bool SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::registerDelegate
 	if (m_hasFaces)
 	{
 		// Face Processing
-		reader->requestElement("face",
-							   std::bind(&TriangleMeshPlyReaderDelegate::beginFaces, this,
-										 std::placeholders::_1, std::placeholders::_2),
-							   std::bind(&TriangleMeshPlyReaderDelegate::processFace, this, std::placeholders::_1),
-							   std::bind(&TriangleMeshPlyReaderDelegate::endFaces, this, std::placeholders::_1));
+		reader->requestElementBlocks("face", sizeof(ListData),
+									 std::bind(&TriangleMeshPlyReaderDelegate::beginFaces, this,
+											   std::placeholders::_1, std::placeholders::_2),
+									 std::bind(&TriangleMeshPlyReaderDelegate::processFaces, this,
+											   std::placeholders::_1, std::placeholders::_2,
+											   std::placeholders::_3, std::placeholders::_4),
+									 nullptr);
 		reader->requestListProperty("face", "vertex_indices",
 									PlyReader::TYPE_UNSIGNED_INT,
 									offsetof(ListData, indices),
@@ -90,11 +94,13 @@ bool SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::registerDelegate
 	if (m_hasEdges)
 	{
 		// Edge Processing
-		reader->requestElement("1d_element",
-							   std::bind(&TriangleMeshPlyReaderDelegate::beginEdges, this,
-										 std::placeholders::_1, std::placeholders::_2),
-							   std::bind(&TriangleMeshPlyReaderDelegate::processEdge, this, std::placeholders::_1),
-							   std::bind(&TriangleMeshPlyReaderDelegate::endEdges, this, std::placeholders::_1));
+		reader->requestElementBlocks("1d_element", sizeof(ListData),
+									 std::bind(&TriangleMeshPlyReaderDelegate::beginEdges, this,
+											   std::placeholders::_1, std::placeholders::_2),
+									 std::bind(&TriangleMeshPlyReaderDelegate::processEdges, this,
+											   std::placeholders::_1, std::placeholders::_2,
+											   std::placeholders::_3, std::placeholders::_4),
+									 nullptr);
 		reader->requestListProperty("1d_element", "vertex_indices",
 									PlyReader::TYPE_UNSIGNED_INT,
 									offsetof(ListData, indices),
@@ -128,13 +134,28 @@ bool SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::fileIsAcceptable
 }
 
 template <class M>
-void* SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::beginVertices(
+void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::beginVertices(
 	const std::string& elementName,
 	size_t vertexCount)
 {
 	m_vertexData.overrun1 = 0l;
 	m_vertexData.overrun2 = 0l;
-	return &m_vertexData;
+	m_mesh->getVertices().reserve(m_mesh->getNumVertices() + vertexCount);
+}
+
+template <class M>
+void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::processVertices(
+	const std::string& elementName,
+	size_t first,
+	size_t count,
+	const void* records)
+{
+	const VertexData* vertexData = static_cast<const VertexData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_vertexData = vertexData[i];
+		processVertex(elementName);
+	}
 }
 
 template <class M>
@@ -153,30 +174,32 @@ void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::endVertices(cons
 }
 
 template <class M>
-void* SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::beginFaces(
+void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::beginFaces(
 	const std::string& elementName,
 	size_t faceCount)
 {
-	m_listData.overrun = 0l;
-	return &m_listData;
-}
-
-template <class M>
-void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::processFace(const std::string& elementName)
-{
-	SURGSIM_ASSERT(m_listData.count == 3) << "Can only process triangle meshes.";
-	std::copy(m_listData.indices, m_listData.indices + 3, m_face.begin());
-
-	typename M::TriangleType triangle(m_face);
-	m_mesh->addTriangle(triangle);
+	m_mesh->getTriangles().reserve(m_mesh->getTriangles().size() + faceCount);
 }
 
 template <class M>
-void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::endFaces(const std::string& elementName)
+void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::processFaces(
+	const std::string& elementName,
+	size_t first,
+	size_t count,
+	const void* records)
 {
-	SURGSIM_ASSERT(m_listData.overrun == 0l)
-			<< "There was an overrun while reading the face structures, it is likely that data "
-			<< "has become corrupted.";
+	const ListData* listData = static_cast<const ListData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		SURGSIM_ASSERT(listData[i].overrun == 0l)
+				<< "There was an overrun while reading the face structures, it is likely that data "
+				<< "has become corrupted.";
+		SURGSIM_ASSERT(listData[i].count == 3) << "Can only process triangle meshes.";
+		std::copy(listData[i].indices, listData[i].indices + 3, m_face.begin());
+
+		typename M::TriangleType triangle(m_face);
+		m_mesh->addTriangle(triangle);
+	}
 }
 
 template <class M>
@@ -192,31 +215,28 @@ bool SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::hasTextureCoordi
 }
 
 template <class M>
-void* SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::beginEdges(const std::string& elementName,
+void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::beginEdges(const std::string& elementName,
 		size_t edgeCount)
 {
-	m_listData.overrun = 0l;
-	return &m_listData;
-}
-
-
-template <class M>
-void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::processEdge(const std::string& elementName)
-{
-	SURGSIM_ASSERT(m_listData.count == 2) << "Edges have to have 2 points.";
-	std::copy(m_listData.indices, m_listData.indices + 2, m_edge.begin());
-
-	typename M::EdgeType edge(m_edge);
-	m_mesh->addEdge(edge);
+	m_mesh->getEdges().reserve(m_mesh->getEdges().size() + edgeCount);
 }
 
-
 template <class M>
-void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::endEdges(const std::string& elementName)
+void SurgSim::DataStructures::TriangleMeshPlyReaderDelegate<M>::processEdges(const std::string& elementName,
+		size_t first, size_t count, const void* records)
 {
-	SURGSIM_ASSERT(m_listData.overrun == 0l)
-			<< "There was an overrun while reading the face structures, it is likely that data "
-			<< "has become corrupted.";
+	const ListData* listData = static_cast<const ListData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		SURGSIM_ASSERT(listData[i].overrun == 0l)
+				<< "There was an overrun while reading the edge structures, it is likely that data "
+				<< "has become corrupted.";
+		SURGSIM_ASSERT(listData[i].count == 2) << "Edges have to have 2 points.";
+		std::copy(listData[i].indices, listData[i].indices + 2, m_edge.begin());
+
+		typename M::EdgeType edge(m_edge);
+		m_mesh->addEdge(edge);
+	}
 }
 
 
@@ -57,13 +57,19 @@ class TriangleMeshPlyReaderDelegate : public PlyReaderDelegate
 	/// \return true if it succeeds, false otherwise.
 	bool fileIsAcceptable(const PlyReader& reader) override;
 
-	/// Callback function, begin the processing of vertices.
+	/// Callback function, begin the processing of vertices, preallocates the vertices of the mesh.
 	/// \param elementName Name of the element.
 	/// \param vertexCount Number of vertices.
-	/// \return memory for vertex data to the reader.
-	void* beginVertices(const std::string& elementName, size_t vertexCount);
+	void beginVertices(const std::string& elementName, size_t vertexCount);
 
-	/// Callback function to process one vertex.
+	/// Callback function to process a block of vertices, calls processVertex() for each one of them.
+	/// \param elementName Name of the element.
+	/// \param first Index of the first vertex in the block.
+	/// \param count Number of vertices in the block.
+	/// \param records The VertexData records for the vertices.
+	void processVertices(const std::string& elementName, size_t first, size_t count, const void* records);
+
+	/// Process one vertex, the data for the vertex is in m_vertexData.
 	/// \param elementName Name of the element.
 	virtual void processVertex(const std::string& elementName);
 
@@ -71,25 +77,29 @@ class TriangleMeshPlyReaderDelegate : public PlyReaderDelegate
 	/// \param elementName Name of the element.
 	void endVertices(const std::string& elementName);
 
-	/// Callback function, begin the processing of faces.
+	/// Callback function, begin the processing of faces, preallocates the triangles of the mesh.
 	/// \param elementName Name of the element.
 	/// \param faceCount Number of faces.
-	/// \return memory for face data to the reader.
-	void* beginFaces(const std::string& elementName, size_t faceCount);
+	void beginFaces(const std::string& elementName, size_t faceCount);
 
-	/// Callback function to process one face.
+	/// Callback function to process a block of faces.
 	/// \param elementName Name of the element.
-	void processFace(const std::string& elementName);
+	/// \param first Index of the first face in the block.
+	/// \param count Number of faces in the block.
+	/// \param records The ListData records for the faces.
+	void processFaces(const std::string& elementName, size_t first, size_t count, const void* records);
 
-	/// Callback function to finalize processing of faces.
+	/// Callback function, begin the processing of edges, preallocates the edges of the mesh.
 	/// \param elementName Name of the element.
-	void endFaces(const std::string& elementName);
-
-	void* beginEdges(const std::string& elementName, size_t edgeCount);
+	/// \param edgeCount Number of edges.
+	void beginEdges(const std::string& elementName, size_t edgeCount);
 
-	void processEdge(const std::string& elementName);
-
-	void endEdges(const std::string& elementName);
+	/// Callback function to process a block of edges.
+	/// \param elementName Name of the element.
+	/// \param first Index of the first edge in the block.
+	/// \param count Number of edges in the block.
+	/// \param records The ListData records for the edges.
+	void processEdges(const std::string& elementName, size_t first, size_t count, const void* records);
 
 	/// Callback function to finalize processing of the mesh
 	void endFile();
@@ -112,13 +122,13 @@ class TriangleMeshPlyReaderDelegate : public PlyReaderDelegate
 		int64_t overrun2; ///< Used to check for buffer overruns
 	} m_vertexData;
 
-	/// Internal structure, the received for data from the "face" element
+	/// Internal structure, the receiver for data from the "face" and "1d_element" elements
 	struct ListData
 	{
 		unsigned int count;
 		unsigned int* indices;
 		int64_t overrun; ///< Used to check for buffer overruns
-	} m_listData;
+	};
 
 	/// The mesh that will be created
 	std::shared_ptr<MeshType> m_mesh;
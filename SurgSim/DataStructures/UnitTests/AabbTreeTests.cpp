@@ -95,6 +95,51 @@ TEST(AabbTreeTests, UpdateTest)
 
 }
 
+TEST(AabbTreeTests, PartialUpdateTest)
+{
+	auto tree = std::make_shared<AabbTree>(3);
+
+	std::vector<Aabbd> boxes;
+	for (int i = 0; i <= 20; ++i)
+	{
+		boxes.emplace_back(Vector3d(static_cast<double>(i) - 0.01, -0.01, -0.01),
+						   Vector3d(static_cast<double>(i) + 0.01, 0.01, 0.01));
+		tree->add(boxes.back(), i);
+	}
+
+	// Grow the last box, only its path to the root is refit
+	boxes[20].extend(Vector3d(25.0, 1.0, 1.0));
+	tree->updateBounds(boxes, std::vector<size_t>(1, 20));
+	EXPECT_TRUE(Aabbd(Vector3d(-0.01, -0.01, -0.01), Vector3d(25.0, 1.0, 1.0)).isApprox(tree->getAabb()))
+			<< tree->getAabb();
+
+	AabbTreeIntersectionVisitor visitor(Aabbd(Vector3d(24.0, 0.5, 0.5), Vector3d(24.5, 0.6, 0.6)));
+	tree->getRoot()->accept(&visitor);
+	ASSERT_EQ(1u, visitor.getIntersections().size());
+	EXPECT_EQ(20u, visitor.getIntersections()[0]);
+
+	// Shrink it back, and move the first one
+	boxes[20] = Aabbd(Vector3d(19.99, -0.01, -0.01), Vector3d(20.01, 0.01, 0.01));
+	boxes[0].translate(Vector3d(0.0, -1.0, 0.0));
+	std::vector<size_t> items;
+	items.push_back(0);
+	items.push_back(20);
+	tree->updateBounds(boxes, items);
+	EXPECT_TRUE(Aabbd(Vector3d(-0.01, -1.01, -0.01), Vector3d(20.01, 0.01, 0.01)).isApprox(tree->getAabb()))
+			<< tree->getAabb();
+
+	// Items that are not in the tree are ignored
+	EXPECT_NO_THROW(tree->updateBounds(boxes, std::vector<size_t>(1, 42)));
+
+	// The index follows changes of the structure
+	boxes.emplace_back(Vector3d(30.0, 0.0, 0.0), Vector3d(31.0, 1.0, 1.0));
+	tree->add(boxes.back(), 21);
+	boxes[21].translate(Vector3d(1.0, 0.0, 0.0));
+	tree->updateBounds(boxes, std::vector<size_t>(1, 21));
+	EXPECT_TRUE(Aabbd(Vector3d(-0.01, -1.01, -0.01), Vector3d(32.0, 1.0, 1.0)).isApprox(tree->getAabb()))
+			<< tree->getAabb();
+}
+
 
 TEST(AabbTreeTests, BuildTest)
 {
@@ -0,0 +1,326 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#include "SurgSim/DataStructures/AabbTree.h"
+#include "SurgSim/DataStructures/BinaryCache.h"
+#include "SurgSim/DataStructures/TriangleMesh.h"
+#include "SurgSim/Framework/ApplicationData.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Math/MeshShape.h"
+
+namespace SurgSim
+{
+namespace DataStructures
+{
+
+TEST(BinaryCacheTests, WriteAndRead)
+{
+	const std::string fileName = "BinaryCacheTests.cache";
+	std::vector<double> values = {1.0, 2.0, 3.0};
+	std::vector<size_t> empty;
+
+	BinaryCacheWriter writer("TestType", 12345);
+	writer.write(42);
+	writer.write(values);
+	writer.write(empty);
+	ASSERT_TRUE(writer.save(fileName));
+
+	{
+		BinaryCacheReader reader(fileName, "TestType", 12345);
+		ASSERT_TRUE(reader.isValid());
+
+		int value = 0;
+		std::vector<double> readValues;
+		std::vector<size_t> readEmpty(3);
+		EXPECT_TRUE(reader.read(&value));
+		EXPECT_EQ(42, value);
+		EXPECT_FALSE(reader.isAtEnd());
+		EXPECT_TRUE(reader.read(&readValues));
+		EXPECT_EQ(values, readValues);
+		EXPECT_TRUE(reader.read(&readEmpty));
+		EXPECT_TRUE(readEmpty.empty());
+		EXPECT_TRUE(reader.isAtEnd());
+		EXPECT_FALSE(reader.read(&value));
+	}
+
+	{
+		BinaryCacheReader reader(fileName, "TestType", 12346);
+		EXPECT_FALSE(reader.isValid());
+	}
+
+	{
+		BinaryCacheReader reader(fileName, "TestType");
+		ASSERT_TRUE(reader.isValid());
+		EXPECT_EQ(12345u, reader.getSourceHash());
+	}
+
+	{
+		BinaryCacheReader reader(fileName, "OtherType", 12345);
+		EXPECT_FALSE(reader.isValid());
+	}
+
+	{
+		BinaryCacheReader reader("NonexistentFile.cache", "TestType", 12345);
+		EXPECT_FALSE(reader.isValid());
+	}
+
+	{
+		// Sections need to be read with the matching size
+		BinaryCacheReader reader(fileName, "TestType", 12345);
+		double value;
+		EXPECT_FALSE(reader.read(&value));
+	}
+
+	boost::filesystem::remove(fileName);
+}
+
+TEST(BinaryCacheTests, FileHash)
+{
+	const std::string fileName = "BinaryCacheTestsHash.txt";
+	uint64_t hash1, hash2, hash3;
+
+	EXPECT_FALSE(computeFileHash("NonexistentFile.txt", &hash1));
+
+	{
+		std::ofstream file(fileName);
+		file << "Some content";
+	}
+	ASSERT_TRUE(computeFileHash(fileName, &hash1));
+	ASSERT_TRUE(computeFileHash(fileName, &hash2));
+	EXPECT_EQ(hash1, hash2);
+
+	{
+		std::ofstream file(fileName);
+		file << "Some other content";
+	}
+	ASSERT_TRUE(computeFileHash(fileName, &hash3));
+	EXPECT_NE(hash1, hash3);
+
+	boost::filesystem::remove(fileName);
+}
+
+TEST(BinaryCacheTests, FileName)
+{
+	EXPECT_EQ("mesh.ply.MeshShape.cache", getBinaryCacheFileName("mesh.ply", "SurgSim::Math::MeshShape"));
+	EXPECT_EQ("mesh.ply.Mesh.cache", getBinaryCacheFileName("mesh.ply", "Mesh"));
+
+	setBinaryCacheDirectory("BinaryCacheTestsDirectory");
+	EXPECT_EQ("BinaryCacheTestsDirectory", getBinaryCacheDirectory());
+	const boost::filesystem::path cacheFileName = getBinaryCacheFileName("mesh.ply", "SurgSim::Math::MeshShape");
+	EXPECT_EQ("BinaryCacheTestsDirectory", cacheFileName.parent_path().string());
+	const std::string cacheName = cacheFileName.filename().string();
+	EXPECT_EQ(0u, cacheName.find("mesh.ply."));
+	EXPECT_EQ(".MeshShape.cache", cacheName.substr(cacheName.size() - 16));
+
+	// Assets with the same name in different directories have different caches
+	EXPECT_NE(cacheFileName.string(), getBinaryCacheFileName("Geometry/mesh.ply", "SurgSim::Math::MeshShape"));
+	EXPECT_EQ(cacheFileName.string(), getBinaryCacheFileName("mesh.ply", "SurgSim::Math::MeshShape"));
+
+	setBinaryCacheDirectory("");
+	EXPECT_EQ("mesh.ply.MeshShape.cache", getBinaryCacheFileName("mesh.ply", "SurgSim::Math::MeshShape"));
+}
+
+TEST(BinaryCacheTests, DisabledByDefault)
+{
+	EXPECT_FALSE(isBinaryCacheEnabled());
+	EXPECT_TRUE(getBinaryCacheDirectory().empty());
+}
+
+TEST(BinaryCacheTests, TriangleMesh)
+{
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+	const std::string fileName = "Geometry/arm_collision.ply";
+	const std::string path = runtime->getApplicationData()->findFile(fileName);
+	const std::string cacheFileName = getBinaryCacheFileName(path, TriangleMeshPlain().getClassName());
+	boost::filesystem::remove(cacheFileName);
+
+	setBinaryCacheEnabled(false);
+	auto expected = std::make_shared<TriangleMeshPlain>();
+	expected->load(fileName);
+	EXPECT_FALSE(boost::filesystem::exists(cacheFileName));
+
+	setBinaryCacheEnabled(true);
+	auto parsed = std::make_shared<TriangleMeshPlain>();
+	parsed->load(fileName);
+	EXPECT_TRUE(boost::filesystem::exists(cacheFileName));
+
+	auto cached = std::make_shared<TriangleMeshPlain>();
+	cached->load(fileName);
+
+	EXPECT_EQ(*expected, *parsed);
+	EXPECT_EQ(*expected, *cached);
+
+	setBinaryCacheEnabled(false);
+	boost::filesystem::remove(cacheFileName);
+}
+
+TEST(BinaryCacheTests, MeshShape)
+{
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+	const std::string fileName = "Geometry/arm_collision.ply";
+	const std::string path = runtime->getApplicationData()->findFile(fileName);
+	const std::string cacheFileName = getBinaryCacheFileName(path, "SurgSim::Math::MeshShape");
+	boost::filesystem::remove(cacheFileName);
+
+	setBinaryCacheEnabled(false);
+	auto expected = std::make_shared<SurgSim::Math::MeshShape>();
+	expected->load(fileName);
+
+	setBinaryCacheEnabled(true);
+	auto parsed = std::make_shared<SurgSim::Math::MeshShape>();
+	parsed->load(fileName);
+	ASSERT_TRUE(boost::filesystem::exists(cacheFileName));
+
+	auto cached = std::make_shared<SurgSim::Math::MeshShape>();
+	cached->load(fileName);
+
+	ASSERT_EQ(expected->getNumTriangles(), cached->getNumTriangles());
+	EXPECT_TRUE(*expected == *cached);
+	for (size_t i = 0; i < expected->getNumTriangles(); ++i)
+	{
+		EXPECT_TRUE(expected->getNormal(i).isApprox(cached->getNormal(i)));
+	}
+	EXPECT_DOUBLE_EQ(expected->getVolume(), cached->getVolume());
+	EXPECT_TRUE(expected->getCenter().isApprox(cached->getCenter()));
+	EXPECT_TRUE(expected->getSecondMomentOfVolume().isApprox(cached->getSecondMomentOfVolume()));
+	EXPECT_TRUE(expected->getBoundingBox().isApprox(cached->getBoundingBox()));
+
+	std::vector<size_t> expectedStructure;
+	std::vector<size_t> cachedStructure;
+	expected->getAabbTree()->getStructure(&expectedStructure);
+	cached->getAabbTree()->getStructure(&cachedStructure);
+	EXPECT_EQ(expectedStructure, cachedStructure);
+	EXPECT_TRUE(expected->getAabbTree()->getAabb().isApprox(cached->getAabbTree()->getAabb()));
+
+	setBinaryCacheEnabled(false);
+	boost::filesystem::remove(cacheFileName);
+}
+
+TEST(BinaryCacheTests, StaleCache)
+{
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+	std::vector<std::string> paths(1, ".");
+	SurgSim::Framework::ApplicationData data(paths);
+	setBinaryCacheEnabled(true);
+
+	auto mesh = std::make_shared<TriangleMeshPlain>();
+	mesh->addVertex(TriangleMeshPlain::VertexType(SurgSim::Math::Vector3d(0.0, 0.0, 0.0)));
+	mesh->addVertex(TriangleMeshPlain::VertexType(SurgSim::Math::Vector3d(1.0, 0.0, 0.0)));
+	mesh->addVertex(TriangleMeshPlain::VertexType(SurgSim::Math::Vector3d(0.0, 1.0, 0.0)));
+	std::array<size_t, 3> ids = {0, 1, 2};
+	mesh->addTriangle(TriangleMeshPlain::TriangleType(ids));
+	mesh->save("BinaryCacheTests.ply");
+
+	auto loaded = std::make_shared<TriangleMeshPlain>();
+	ASSERT_NO_THROW(loaded->load("BinaryCacheTests.ply", data));
+	EXPECT_EQ(3u, loaded->getNumVertices());
+
+	// Changing the source file invalidates the cache
+	mesh->addVertex(TriangleMeshPlain::VertexType(SurgSim::Math::Vector3d(1.0, 1.0, 0.0)));
+	ids = {1, 3, 2};
+	mesh->addTriangle(TriangleMeshPlain::TriangleType(ids));
+	mesh->save("BinaryCacheTests.ply");
+
+	ASSERT_NO_THROW(loaded->load("BinaryCacheTests.ply", data));
+	EXPECT_EQ(4u, loaded->getNumVertices());
+	EXPECT_EQ(2u, loaded->getNumTriangles());
+
+	setBinaryCacheEnabled(false);
+	boost::filesystem::remove(getBinaryCacheFileName(data.findFile("BinaryCacheTests.ply"), mesh->getClassName()));
+	boost::filesystem::remove("BinaryCacheTests.ply");
+}
+
+TEST(BinaryCacheTests, SameSizeRewrite)
+{
+	const std::string fileName = "BinaryCacheTestsRewrite.txt";
+	{
+		std::ofstream file(fileName);
+		file << "content1";
+	}
+	const std::time_t time = boost::filesystem::last_write_time(fileName);
+
+	int value = 0;
+	int numSourceLoads = 0;
+	auto readCache = [&value](BinaryCacheReader* reader) {return reader->read(&value);};
+	auto loadSource = [&value, &numSourceLoads]() {value = numSourceLoads + 1; ++numSourceLoads; return true;};
+	auto writeCache = [&value](BinaryCacheWriter* writer) {writer->write(value);};
+
+	setBinaryCacheEnabled(true);
+	ASSERT_TRUE(loadWithBinaryCache(fileName, "TestType", readCache, loadSource, writeCache));
+	EXPECT_EQ(1, numSourceLoads);
+
+	// An unchanged file uses the cache
+	value = 0;
+	ASSERT_TRUE(loadWithBinaryCache(fileName, "TestType", readCache, loadSource, writeCache));
+	EXPECT_EQ(1, numSourceLoads);
+	EXPECT_EQ(1, value);
+
+	// A file rewritten with a different content of the same size and modification time is loaded from the source
+	{
+		std::ofstream file(fileName);
+		file << "content2";
+	}
+	boost::filesystem::last_write_time(fileName, time);
+	ASSERT_TRUE(loadWithBinaryCache(fileName, "TestType", readCache, loadSource, writeCache));
+	EXPECT_EQ(2, numSourceLoads);
+	EXPECT_EQ(2, value);
+
+	// A touched file with the same content still uses the cache
+	boost::filesystem::last_write_time(fileName, time - 10);
+	value = 0;
+	ASSERT_TRUE(loadWithBinaryCache(fileName, "TestType", readCache, loadSource, writeCache));
+	EXPECT_EQ(2, numSourceLoads);
+	EXPECT_EQ(2, value);
+
+	setBinaryCacheEnabled(false);
+	boost::filesystem::remove(getBinaryCacheFileName(fileName, "TestType"));
+	boost::filesystem::remove(fileName);
+}
+
+TEST(BinaryCacheTests, CacheDirectory)
+{
+	const std::string fileName = "BinaryCacheTestsDirectory.txt";
+	const std::string directory = "BinaryCacheTestsDirectory";
+	{
+		std::ofstream file(fileName);
+		file << "content";
+	}
+
+	int value = 0;
+	auto readCache = [&value](BinaryCacheReader* reader) {return reader->read(&value);};
+	auto loadSource = [&value]() {value = 1; return true;};
+	auto writeCache = [&value](BinaryCacheWriter* writer) {writer->write(value);};
+
+	setBinaryCacheEnabled(true);
+	setBinaryCacheDirectory(directory);
+	ASSERT_TRUE(loadWithBinaryCache(fileName, "TestType", readCache, loadSource, writeCache));
+	EXPECT_TRUE(boost::filesystem::exists(getBinaryCacheFileName(fileName, "TestType")));
+	EXPECT_EQ(directory, boost::filesystem::path(getBinaryCacheFileName(fileName, "TestType")).parent_path().string());
+	setBinaryCacheDirectory("");
+	EXPECT_FALSE(boost::filesystem::exists(getBinaryCacheFileName(fileName, "TestType")));
+
+	setBinaryCacheEnabled(false);
+	boost::filesystem::remove_all(directory);
+	boost::filesystem::remove(fileName);
+}
+
+};
+};
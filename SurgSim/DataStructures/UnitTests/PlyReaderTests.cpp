@@ -161,12 +161,85 @@ class TestData
 	size_t faceInitCount;
 	size_t faceRunningCount;
 
+	void beginVertexBlocks(const std::string& elementName, size_t vertices)
+	{
+		vertexInitCount = vertices;
+		vertexRunningCount = 0;
+		blockCount = 0;
+		endVerticesCalled = false;
+	}
+
+	void newVertexBlock(const std::string& elementName, size_t first, size_t count, const void* records)
+	{
+		EXPECT_EQ(vertexRunningCount, first);
+		++blockCount;
+		const VertexData* data = static_cast<const VertexData*>(records);
+		for (size_t i = 0; i < count; ++i)
+		{
+			EXPECT_EQ(0, data[i].overrun);
+			++vertexRunningCount;
+			vertices.push_back(Vector3d(data[i].x, data[i].y, data[i].z));
+		}
+	}
+
+	void beginFaceBlocks(const std::string& elementName, size_t faces)
+	{
+		faceInitCount = faces;
+		faceRunningCount = 0;
+	}
+
+	void newFaceBlock(const std::string& elementName, size_t first, size_t count, const void* records)
+	{
+		EXPECT_EQ(faceRunningCount, first);
+		const FaceData* data = static_cast<const FaceData*>(records);
+		for (size_t i = 0; i < count; ++i)
+		{
+			EXPECT_EQ(0, data[i].overrun);
+			faceData = data[i];
+			newFace(elementName);
+		}
+	}
+
 	std::vector<Vector3d> vertices;
 	std::vector<std::vector<unsigned int>> faces;
 	std::vector<int> extras;
 	std::vector<unsigned int> natures;
+	size_t blockCount;
 };
 
+void checkTestData(const TestData& testData)
+{
+	EXPECT_EQ(4u, testData.vertexInitCount);
+	EXPECT_EQ(4u, testData.vertexRunningCount);
+	ASSERT_EQ(4u, testData.vertices.size());
+	for (size_t i = 0; i < testData.vertices.size(); ++i)
+	{
+		double sign = (i % 2 == 0) ? 1 : -1;
+		Vector3d expected(static_cast<double>(sign * (i + 1)),
+						  static_cast<double>(sign * (i + 2)),
+						  static_cast<double>(sign * (i + 3)));
+		EXPECT_TRUE(expected.isApprox(testData.vertices[i])) << expected << testData.vertices[i];
+	}
+
+	EXPECT_EQ(4u, testData.faceInitCount);
+	EXPECT_EQ(4u, testData.faceRunningCount);
+	ASSERT_EQ(4u, testData.faces.size());
+	ASSERT_EQ(4u, testData.extras.size());
+	unsigned int expected = 0;
+	for (size_t i = 0; i < testData.faces.size(); ++i)
+	{
+		std::vector<unsigned int> face = testData.faces[i];
+		EXPECT_EQ(i + 1, face.size());
+		EXPECT_EQ(-static_cast<int>(i), testData.extras[i]);
+
+		for (size_t j = 0; j < face.size(); ++j)
+		{
+			EXPECT_EQ(expected, face[j]);
+			++expected;
+		}
+	}
+}
+
 TEST_F(PlyReaderTests, ElementTwoPropertyTest)
 {
 	TestData testData;
@@ -304,5 +377,129 @@ TEST_F(PlyReaderTests, TriangleMeshDelegateTest)
 	EXPECT_EQ(triangle11, mesh->getTriangle(11).verticesId);
 }
 
+TEST_F(PlyReaderTests, MappedParsing)
+{
+	PlyReader asciiReader(findFile("PlyReaderTests/Testdata.ply"));
+	EXPECT_FALSE(asciiReader.isMappedParsing());
+
+	PlyReader binaryReader(findFile("PlyReaderTests/Testdata_binary.ply"));
+	EXPECT_TRUE(binaryReader.isMappedParsing());
+}
+
+TEST_F(PlyReaderTests, BlockReadTest)
+{
+	for (auto fileName : {"PlyReaderTests/Testdata.ply", "PlyReaderTests/Testdata_binary.ply"})
+	{
+		SCOPED_TRACE(fileName);
+		TestData testData;
+		PlyReader reader(findFile(fileName));
+
+		EXPECT_ANY_THROW(reader.setBlockSize(0));
+		reader.setBlockSize(3);
+		EXPECT_EQ(3u, reader.getBlockSize());
+
+		EXPECT_TRUE(reader.requestElementBlocks("vertex", sizeof(TestData::VertexData),
+			std::bind(&TestData::beginVertexBlocks, &testData, std::placeholders::_1, std::placeholders::_2),
+			std::bind(&TestData::newVertexBlock, &testData, std::placeholders::_1, std::placeholders::_2,
+					  std::placeholders::_3, std::placeholders::_4),
+			std::bind(&TestData::endVertices, &testData, std::placeholders::_1)));
+		EXPECT_FALSE(reader.requestElement("vertex",
+										   std::bind(&TestData::beginVertices, &testData,
+												   std::placeholders::_1, std::placeholders::_2),
+										   std::bind(&TestData::newVertex, &testData, std::placeholders::_1),
+										   nullptr));
+		EXPECT_TRUE(reader.requestScalarProperty(
+						"vertex", "x", PlyReader::TYPE_DOUBLE, offsetof(TestData::VertexData, x)));
+		EXPECT_TRUE(reader.requestScalarProperty(
+						"vertex", "y", PlyReader::TYPE_DOUBLE, offsetof(TestData::VertexData, y)));
+		EXPECT_TRUE(reader.requestScalarProperty(
+						"vertex", "z", PlyReader::TYPE_DOUBLE, offsetof(TestData::VertexData, z)));
+		EXPECT_ANY_THROW(reader.requestScalarProperty(
+						"vertex", "nx", PlyReader::TYPE_DOUBLE, sizeof(TestData::VertexData)));
+
+		EXPECT_TRUE(reader.requestElementBlocks("face", sizeof(TestData::FaceData),
+			std::bind(&TestData::beginFaceBlocks, &testData, std::placeholders::_1, std::placeholders::_2),
+			std::bind(&TestData::newFaceBlock, &testData, std::placeholders::_1, std::placeholders::_2,
+					  std::placeholders::_3, std::placeholders::_4),
+			nullptr));
+		EXPECT_TRUE(reader.requestListProperty("face", "vertex_indices",
+											   PlyReader::TYPE_UNSIGNED_INT,
+											   offsetof(TestData::FaceData, faces),
+											   PlyReader::TYPE_UNSIGNED_INT,
+											   offsetof(TestData::FaceData, faceCount)));
+		EXPECT_TRUE(reader.requestScalarProperty(
+						"face", "extra", PlyReader::TYPE_INT, offsetof(TestData::FaceData, extra)));
+
+		ASSERT_NO_THROW(reader.parseFile());
+		EXPECT_EQ(2u, testData.blockCount);
+		EXPECT_TRUE(testData.endVerticesCalled);
+		checkTestData(testData);
+	}
+}
+
+TEST_F(PlyReaderTests, BinaryElementReadTest)
+{
+	TestData testData;
+	PlyReader reader(findFile("PlyReaderTests/Testdata_binary.ply"));
+	EXPECT_TRUE(reader.requestElement("vertex",
+									  std::bind(&TestData::beginVertices, &testData,
+											  std::placeholders::_1, std::placeholders::_2),
+									  std::bind(&TestData::newVertex, &testData, std::placeholders::_1),
+									  std::bind(&TestData::endVertices, &testData, std::placeholders::_1)));
+	EXPECT_TRUE(reader.requestScalarProperty(
+					"vertex", "x", PlyReader::TYPE_DOUBLE, offsetof(TestData::VertexData, x)));
+	EXPECT_TRUE(reader.requestScalarProperty(
+					"vertex", "y", PlyReader::TYPE_DOUBLE, offsetof(TestData::VertexData, y)));
+	EXPECT_TRUE(reader.requestScalarProperty(
+					"vertex", "z", PlyReader::TYPE_DOUBLE, offsetof(TestData::VertexData, z)));
+
+	EXPECT_TRUE(reader.requestElement("face",
+									  std::bind(&TestData::beginFaces, &testData,
+											  std::placeholders::_1, std::placeholders::_2),
+									  std::bind(&TestData::newFace, &testData, std::placeholders::_1),
+									  nullptr));
+	EXPECT_TRUE(reader.requestListProperty("face", "vertex_indices",
+										   PlyReader::TYPE_UNSIGNED_INT,
+										   offsetof(TestData::FaceData, faces),
+										   PlyReader::TYPE_UNSIGNED_INT,
+										   offsetof(TestData::FaceData, faceCount)));
+	EXPECT_TRUE(reader.requestScalarProperty(
+					"face", "extra", PlyReader::TYPE_INT, offsetof(TestData::FaceData, extra)));
+
+	ASSERT_NO_THROW(reader.parseFile());
+	EXPECT_EQ(0L, testData.vertexData.overrun);
+	EXPECT_EQ(0L, testData.faceData.overrun);
+	EXPECT_TRUE(testData.endVerticesCalled);
+	checkTestData(testData);
+}
+
+TEST_F(PlyReaderTests, BinaryTriangleMeshDelegateTest)
+{
+	auto asciiDelegate = std::make_shared<TriangleMeshPlyReaderDelegate<MeshType>>();
+	PlyReader asciiReader(findFile("PlyReaderTests/Cube_with_physics.ply"));
+	ASSERT_TRUE(asciiReader.parseWithDelegate(asciiDelegate));
+
+	for (size_t blockSize : {1, 5, 4096})
+	{
+		auto delegate = std::make_shared<TriangleMeshPlyReaderDelegate<MeshType>>();
+		PlyReader reader(findFile("PlyReaderTests/Cube_with_physics_binary.ply"));
+		reader.setBlockSize(blockSize);
+		EXPECT_NO_THROW(EXPECT_TRUE(reader.parseWithDelegate(delegate)));
+
+		auto mesh = delegate->getMesh();
+		EXPECT_EQ(26u, mesh->getNumVertices());
+		EXPECT_EQ(12u, mesh->getNumTriangles());
+
+		// The binary file stores floats, compare the vertices approximately
+		auto expected = asciiDelegate->getMesh();
+		for (size_t i = 0; i < mesh->getNumVertices(); ++i)
+		{
+			EXPECT_TRUE(expected->getVertexPosition(i).isApprox(mesh->getVertexPosition(i), 1e-6))
+					<< "Block size " << blockSize << ", vertex " << i;
+		}
+		EXPECT_EQ(expected->getTriangles(), mesh->getTriangles());
+	}
+}
+
 } // DataStructures
 } // SurgSim
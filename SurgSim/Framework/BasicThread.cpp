@@ -15,9 +15,15 @@
 
 #include "SurgSim/Framework/BasicThread.h"
 
+#include <algorithm>
+
 #include <boost/thread.hpp>
 #include <boost/thread/barrier.hpp>
 #include <boost/ref.hpp>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 #include "SurgSim/Framework/Assert.h"
 #include "SurgSim/Framework/Clock.h"
 #include "SurgSim/Framework/Log.h"
@@ -28,6 +34,8 @@ namespace SurgSim
 namespace Framework
 {
 
+const size_t BasicThread::OverrunHistogramSize;
+
 BasicThread::BasicThread(const std::string& name) :
 	m_logger(Logger::getLogger(name)),
 	m_name(name),
@@ -36,8 +44,15 @@ BasicThread::BasicThread(const std::string& name) :
 	m_isInitialized(false),
 	m_isRunning(false),
 	m_stopExecution(false),
-	m_isSynchronous(false)
+	m_isSynchronous(false),
+	m_synchronousPeriod(1),
+	m_synchronousPhase(0),
+	m_synchronousStep(0),
+	m_realTimePriority(0),
+	m_busyWaitTime(0.0)
 {
+	resetOverruns();
+
 	// The maximum number of frames in the timer is set to 1,000,000
 	// + If the timer is reset every second, that is enough frame to measure real rates up to 1MHz
 	// + If the timer is reset every minute, that is enough frame to measure real rates up to 16.66KHz
@@ -108,6 +123,8 @@ boost::thread& BasicThread::getThread()
 
 void BasicThread::operator()()
 {
+	applySchedulingConfiguration();
+
 	bool success = executeInitialization();
 	if (! success)
 	{
@@ -135,12 +152,27 @@ void BasicThread::operator()()
 				m_timer.endFrame();
 			}
 
-			// Check for frameTime being > desired update period report error, adjust ...
 			sleepTime = m_period - (Clock::now() - start);
 			if (sleepTime.count() > 0.0)
 			{
 				totalSleepTime += sleepTime;
-				SurgSim::Framework::sleep_until(start + m_period);
+				if (m_busyWaitTime.count() > 0.0)
+				{
+					SurgSim::Framework::sleep_until(start + m_period - m_busyWaitTime);
+					while (Clock::now() < start + m_period)
+					{
+					}
+				}
+				else
+				{
+					SurgSim::Framework::sleep_until(start + m_period);
+				}
+			}
+			else if (!m_isIdle)
+			{
+				++m_overrunCount;
+				const size_t bin = static_cast<size_t>(-10.0 * sleepTime.count() / m_period.count());
+				++m_overrunHistogram[std::min(bin, OverrunHistogramSize - 1)];
 			}
 		}
 		else
@@ -152,7 +184,8 @@ void BasicThread::operator()()
 			bool success = waitForBarrier(true);
 			totalSleepTime += Clock::now() - start;
 
-			if (success && !m_isIdle)
+			const bool isScheduled = (m_synchronousStep++ % m_synchronousPeriod) == m_synchronousPhase;
+			if (success && !m_isIdle && isScheduled)
 			{
 				m_timer.beginFrame();
 				m_isRunning = doUpdate(m_period.count());
@@ -175,7 +208,8 @@ void BasicThread::operator()()
 					<< "Rate: " << numUpdates / totalFrameTime.count() << "Hz / "
 					<<  1.0 / m_period.count() << "Hz, "
 					<< "Average doUpdate: " << (totalFrameTime.count() - totalSleepTime.count()) / numUpdates << "s, "
-					<< "Sleep: " << 100.0 * totalSleepTime.count() / totalFrameTime.count() << "%";
+					<< "Sleep: " << 100.0 * totalSleepTime.count() / totalFrameTime.count() << "%, "
+					<< "Overruns: " << m_overrunCount;
 				totalFrameTime = boost::chrono::duration<double>::zero();
 				totalSleepTime = boost::chrono::duration<double>::zero();
 				numUpdates = 0;
@@ -278,6 +312,15 @@ bool BasicThread::isSynchronous()
 	return m_isSynchronous;
 }
 
+void BasicThread::setSynchronousSchedule(size_t period, size_t phase)
+{
+	SURGSIM_ASSERT(period > 0 && phase < period) << "Invalid synchronous schedule for " << getName() << ", phase "
+			<< phase << " and period " << period;
+	m_synchronousPeriod = period;
+	m_synchronousPhase = phase;
+	m_synchronousStep = 0;
+}
+
 double BasicThread::getCpuTime() const
 {
 	return m_timer.getCumulativeTime();
@@ -293,6 +336,106 @@ void BasicThread::resetCpuTimeAndUpdateCount()
 	m_timer.start();
 }
 
+void BasicThread::setCpuAffinity(const std::vector<size_t>& cpus)
+{
+	m_cpuAffinity = cpus;
+}
+
+std::vector<size_t> BasicThread::getCpuAffinity() const
+{
+	return m_cpuAffinity;
+}
+
+void BasicThread::setRealTimePriority(int priority)
+{
+	SURGSIM_ASSERT(priority >= 0 && priority <= 99) << "The real-time priority of " << m_name
+			<< " has to be in [0, 99], it is " << priority;
+	m_realTimePriority = priority;
+}
+
+int BasicThread::getRealTimePriority() const
+{
+	return m_realTimePriority;
+}
+
+void BasicThread::setBusyWaitTime(double time)
+{
+	SURGSIM_ASSERT(time >= 0.0) << "The busy wait time of " << m_name << " can't be negative.";
+	m_busyWaitTime = boost::chrono::duration<double>(time);
+}
+
+double BasicThread::getBusyWaitTime() const
+{
+	return m_busyWaitTime.count();
+}
+
+size_t BasicThread::getOverrunCount() const
+{
+	return m_overrunCount;
+}
+
+std::vector<size_t> BasicThread::getOverrunHistogram() const
+{
+	std::vector<size_t> histogram;
+	for (const auto& bin : m_overrunHistogram)
+	{
+		histogram.push_back(bin);
+	}
+	return histogram;
+}
+
+void BasicThread::resetOverruns()
+{
+	m_overrunCount = 0;
+	for (auto& bin : m_overrunHistogram)
+	{
+		bin = 0;
+	}
+}
+
+void BasicThread::applySchedulingConfiguration()
+{
+#ifdef __linux__
+	if (!m_cpuAffinity.empty())
+	{
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		size_t numCpus = 0;
+		for (auto cpu : m_cpuAffinity)
+		{
+			// CPU_SET does not check its argument, it would write past the end of the set
+			if (cpu >= CPU_SETSIZE)
+			{
+				SURGSIM_LOG_WARNING(m_logger) << "Ignoring the cpu " << cpu << " in the cpu affinity of " << m_name <<
+					", the cpus are numbered below " << CPU_SETSIZE;
+				continue;
+			}
+			CPU_SET(cpu, &cpuSet);
+			++numCpus;
+		}
+		if (numCpus == 0 || pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0)
+		{
+			SURGSIM_LOG_WARNING(m_logger) << "Could not set the cpu affinity of " << m_name;
+		}
+	}
+
+	if (m_realTimePriority > 0)
+	{
+		sched_param parameters;
+		parameters.sched_priority = m_realTimePriority;
+		if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) != 0)
+		{
+			SURGSIM_LOG_WARNING(m_logger) << "Could not set the real-time priority of " << m_name
+										  << ", running with the default scheduling policy";
+		}
+	}
+#else
+	SURGSIM_LOG_IF(!m_cpuAffinity.empty() || m_realTimePriority > 0, m_logger, WARNING)
+			<< "The cpu affinity and the real-time priority are not supported on this platform, ignored for "
+			<< m_name;
+#endif
+}
+
 bool BasicThread::doUpdate(double dt)
 {
 	return true;
@@ -16,8 +16,11 @@
 #ifndef SURGSIM_FRAMEWORK_BASICTHREAD_H
 #define SURGSIM_FRAMEWORK_BASICTHREAD_H
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/thread.hpp>
 #include <boost/chrono.hpp>
@@ -108,6 +111,12 @@ class BasicThread
 		m_period = boost::chrono::duration<double>(1.0 / val);
 	}
 
+	/// \return The update rate of the thread in hertz (updates per second)
+	double getRate() const
+	{
+		return 1.0 / m_period.count();
+	}
+
 	/// Sets the thread to synchronized execution in concert with the startup
 	/// barrier, the startup barrier has to exist for this call to succeed.
 	/// When the thread is set to run synchronized it will only execute one update at a time
@@ -122,6 +131,13 @@ class BasicThread
 	/// \return	true if synchronized, false if not.
 	bool isSynchronous();
 
+	/// Set the schedule of the updates when running synchronously, the barrier steps are counted from the start of
+	/// the thread, and doUpdate() is only called on the steps n for which (n % period) == phase. This lets threads
+	/// with different rates run in lockstep, in a given order, on the same barrier (see Runtime::startLockstep()).
+	/// \param period The number of barrier steps between two updates
+	/// \param phase The step, in [0, period), on which the update happens
+	void setSynchronousSchedule(size_t period, size_t phase);
+
 	/// \return the cumulated cpu time taken to run all update since last reset or thread creation
 	/// \note Only the latest 1,000,000 frames since last reset are cumulated, so if the timer is never reset,
 	/// \note the Cpu time will not increase past that limit.
@@ -134,6 +150,48 @@ class BasicThread
 	/// Reset the cpu time and the update count to 0
 	void resetCpuTimeAndUpdateCount();
 
+	/// Set the cpus the thread is allowed to run on, e.g. to keep the physics thread away from the graphics thread.
+	/// This is taken into account when the thread starts.
+	/// \note Only supported on Linux, ignored with a warning on the other platforms
+	/// \param cpus The indices of the cpus, empty (default) to let the system decide
+	void setCpuAffinity(const std::vector<size_t>& cpus);
+
+	/// \return The indices of the cpus the thread is allowed to run on, empty if the system decides
+	std::vector<size_t> getCpuAffinity() const;
+
+	/// Set the real-time priority of the thread, this is taken into account when the thread starts.
+	/// \note Only supported on Linux, where a positive priority uses the SCHED_FIFO scheduling policy, this usually
+	/// requires the CAP_SYS_NICE capability. If the policy can't be set the thread runs with the default policy and a
+	/// warning is logged.
+	/// \param priority The priority in [1, 99] for SCHED_FIFO, 0 (default) for the default policy (SCHED_OTHER)
+	void setRealTimePriority(int priority);
+
+	/// \return The real-time priority of the thread, 0 for the default scheduling policy
+	int getRealTimePriority() const;
+
+	/// Set the duration of the busy wait at the end of each period, when running asynchronously. The thread
+	/// sleeps until the last part of the period, and then spins until the start of the next update, which is more
+	/// accurate than waking up from a sleep, at the cost of a busy core.
+	/// \param time The duration (in s) of the busy wait, 0 (default) to only sleep
+	void setBusyWaitTime(double time);
+
+	/// \return The duration (in s) of the busy wait at the end of each period
+	double getBusyWaitTime() const;
+
+	/// The number of bins of the overrun histogram
+	static const size_t OverrunHistogramSize = 10;
+
+	/// \return The number of updates, since last reset or thread creation, that took longer than the period when
+	/// running asynchronously
+	size_t getOverrunCount() const;
+
+	/// \return The histogram of the overruns since last reset or thread creation, the bin i counts the overruns of
+	/// [i, i + 1) tenths of the period, the last bin counts all the overruns of 90% of the period or more
+	std::vector<size_t> getOverrunHistogram() const;
+
+	/// Reset the overrun count and histogram to 0
+	void resetOverruns();
+
 protected:
 
 	/// Timer to measure the actual time taken to doUpdate
@@ -173,6 +231,29 @@ class BasicThread
 	bool m_stopExecution;
 	bool m_isSynchronous;
 
+	///@{
+	/// The schedule of the synchronous updates, and the number of barrier steps taken so far
+	size_t m_synchronousPeriod;
+	size_t m_synchronousPhase;
+	size_t m_synchronousStep;
+	///@}
+
+	///@{
+	/// The cpu affinity, the real-time priority and the busy wait duration of the thread
+	std::vector<size_t> m_cpuAffinity;
+	int m_realTimePriority;
+	boost::chrono::duration<double> m_busyWaitTime;
+	///@}
+
+	///@{
+	/// The overrun count and histogram
+	std::atomic<size_t> m_overrunCount;
+	std::array<std::atomic<size_t>, OverrunHistogramSize> m_overrunHistogram;
+	///@}
+
+	/// Apply the cpu affinity and the real-time priority to the running thread
+	void applySchedulingConfiguration();
+
 	virtual bool doInitialize() = 0;
 	virtual bool doStartUp() = 0;
 
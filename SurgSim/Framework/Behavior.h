@@ -16,6 +16,8 @@
 #ifndef SURGSIM_FRAMEWORK_BEHAVIOR_H
 #define SURGSIM_FRAMEWORK_BEHAVIOR_H
 
+#include <vector>
+
 #include "SurgSim/Framework/Component.h"
 
 namespace SurgSim
@@ -53,6 +55,17 @@ class Behavior: public Component
 
 	/// Specifies which manger will handle this behavior
 	virtual int getTargetManagerType() const { return MANAGER_TYPE_BEHAVIOR; }
+
+	/// Declares the components that are accessed by update(), behaviors that declare their accesses can be updated in
+	/// parallel with the other behaviors that don't access the same components, see BehaviorManager.
+	/// The accesses are expected not to change once the behavior is awake.
+	/// \param [out] reads The components that are read by update()
+	/// \param [out] writes The components that are modified by update()
+	/// \return true if the accesses were declared, false (default) if the behavior has to be updated serially
+	virtual bool getDeclaredAccesses(std::vector<const Component*>* reads, std::vector<const Component*>* writes) const
+	{
+		return false;
+	}
 };
 
 }; //namespace Framework
@@ -15,8 +15,14 @@
 
 #include "SurgSim/Framework/BehaviorManager.h"
 
+#include <future>
+#include <unordered_set>
+
+#include "SurgSim/Framework/Behavior.h"
 #include "SurgSim/Framework/Component.h"
 #include "SurgSim/Framework/Logger.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Framework/ThreadPool.h"
 
 namespace SurgSim
 {
@@ -55,11 +61,93 @@ bool BehaviorManager::executeRemovals(const std::shared_ptr<SurgSim::Framework::
 
 bool BehaviorManager::doUpdate(double dt)
 {
-	processBehaviors(dt);
+	if (m_batchedBehaviors != m_behaviors)
+	{
+		buildBatches();
+	}
+	processBatches(dt);
 	processComponents();
 	return true;
 }
 
+void BehaviorManager::buildBatches()
+{
+	m_batchedBehaviors = m_behaviors;
+	m_batches.clear();
+
+	std::unordered_set<const Component*> batchReads;
+	std::unordered_set<const Component*> batchWrites;
+	bool isParallelBatch = false;
+	std::vector<const Component*> reads;
+	std::vector<const Component*> writes;
+	for (const auto& behavior : m_behaviors)
+	{
+		reads.clear();
+		writes.clear();
+		if (!behavior->getDeclaredAccesses(&reads, &writes))
+		{
+			m_batches.emplace_back(1, behavior);
+			isParallelBatch = false;
+			continue;
+		}
+
+		bool isConflicting = false;
+		for (const auto* component : writes)
+		{
+			isConflicting |= (batchReads.count(component) > 0 || batchWrites.count(component) > 0);
+		}
+		for (const auto* component : reads)
+		{
+			isConflicting |= (batchWrites.count(component) > 0);
+		}
+		if (!isParallelBatch || isConflicting)
+		{
+			m_batches.emplace_back();
+			batchReads.clear();
+			batchWrites.clear();
+			isParallelBatch = true;
+		}
+		m_batches.back().push_back(behavior);
+		batchReads.insert(reads.begin(), reads.end());
+		batchWrites.insert(writes.begin(), writes.end());
+	}
+
+	SURGSIM_LOG_DEBUG(m_logger) << m_behaviors.size() << " behaviors updated in " << m_batches.size() << " batches";
+}
+
+void BehaviorManager::processBatches(double dt)
+{
+	auto threadPool = Runtime::getThreadPool();
+	std::vector<std::future<void>> tasks;
+	for (const auto& batch : m_batches)
+	{
+		if (batch.size() == 1)
+		{
+			if (batch.front()->isActive())
+			{
+				batch.front()->update(dt);
+			}
+			continue;
+		}
+
+		for (const auto& behavior : batch)
+		{
+			if (behavior->isActive())
+			{
+				tasks.push_back(threadPool->enqueue<void>([dt, &behavior]()
+				{
+					behavior->update(dt);
+				}));
+			}
+		}
+		for (auto& task : tasks)
+		{
+			task.get();
+		}
+		tasks.clear();
+	}
+}
+
 int BehaviorManager::getType() const
 {
 	return MANAGER_TYPE_BEHAVIOR;
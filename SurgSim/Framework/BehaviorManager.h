@@ -17,6 +17,7 @@
 #define SURGSIM_FRAMEWORK_BEHAVIORMANAGER_H
 
 #include <memory>
+#include <vector>
 
 #include "SurgSim/Framework/ComponentManager.h"
 
@@ -25,10 +26,16 @@ namespace SurgSim
 namespace Framework
 {
 
+class Behavior;
+
 /// Manager to handle Behaviors. The manager will collect all the behaviors
 /// in the scene through addComponent/removeComponent calls. All the
 /// behaviors will be update once per period (default 30Hz) once the
 /// BehaviorManager is started.
+/// The behaviors that declare their accesses (see Behavior::getDeclaredAccesses()) are updated in parallel, on the
+/// runtime's thread pool, in batches of consecutive behaviors that don't write to a component accessed by another
+/// behavior of the batch. The behaviors that don't declare their accesses are updated serially, and the order of the
+/// updates is kept between the batches, as well as between conflicting behaviors.
 class BehaviorManager : public ComponentManager
 {
 public:
@@ -45,6 +52,19 @@ class BehaviorManager : public ComponentManager
 	bool doInitialize() override;
 	bool doStartUp() override;
 	bool doUpdate(double dt) override;
+
+	/// Build the batches of behaviors that can be updated in parallel
+	void buildBatches();
+
+	/// Update the behaviors, batch by batch
+	/// \param dt The time step
+	void processBatches(double dt);
+
+	/// The behaviors the batches were built with
+	std::vector<std::shared_ptr<Behavior>> m_batchedBehaviors;
+
+	/// The batches of behaviors, in update order
+	std::vector<std::vector<std::shared_ptr<Behavior>>> m_batches;
 };
 
 
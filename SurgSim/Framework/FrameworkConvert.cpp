@@ -20,15 +20,226 @@
 #include "SurgSim/Framework/Scene.h"
 #include "SurgSim/Framework/Asset.h"
 
+#include <atomic>
 #include <boost/uuid/uuid_io.hpp>
+#include <exception>
+#include <future>
+#include <numeric>
 
 #include "SurgSim/Framework/Runtime.h"
 #include "SurgSim/Framework/ApplicationData.h"
+#include "SurgSim/Framework/ThreadPool.h"
 
 namespace
 {
 const std::string NamePropertyName = "Name";
 const std::string IdPropertyName = "Id";
+
+/// Resolve the INCLUDE entries of a list of scene elements and collect the nodes of all scene elements
+/// \param node The sequence of scene elements or a single scene element
+/// \param stack The files that are currently being included, used to detect inclusion loops
+/// \param [out] nodes The nodes of all scene elements, in the order in which they appear
+void collectSceneElementNodes(const YAML::Node& node, std::vector<std::string>* stack,
+							  std::vector<YAML::Node>* nodes)
+{
+	if (node.IsSequence())
+	{
+		for (auto element = node.begin(); element != node.end(); ++element)
+		{
+			if (element->IsMap() && element->begin()->first.as<std::string>() == "INCLUDE")
+			{
+				auto file = element->begin()->second.as<std::string>();
+				auto data = SurgSim::Framework::Runtime::getApplicationData();
+				SURGSIM_ASSERT(data->tryFindFile(file, &file))
+						<< "Could not find include file " << file;
+
+				SURGSIM_ASSERT(std::find(stack->cbegin(), stack->cend(), file) == stack->cend())
+						<< "Found inclusion loop File: " << file << " included from " << stack->back()
+						<< " is already included.";
+
+				auto included = YAML::LoadFile(file);
+				stack->push_back(file);
+				collectSceneElementNodes(included, stack, nodes);
+				stack->pop_back();
+			}
+			else
+			{
+				// Nodes of the same document share their memory, even reading from them is not thread safe, each
+				// scene element gets its own copy so that it can be decoded concurrently with the others
+				nodes->push_back(YAML::Clone(*element));
+			}
+		}
+	}
+	else if (node.IsMap())
+	{
+		nodes->push_back(YAML::Clone(node));
+	}
+	else
+	{
+		SURGSIM_FAILURE()
+				<< "Trying to decode std::vector<std::shared_ptr<SceneElement>> but the received node is neither "
+				<< "a sequence nor a map";
+	}
+}
+
+/// Collect the ids of all the components that are defined or referenced in a node
+/// \param node The node to search
+/// \param [out] ids The ids that were found
+void collectComponentIds(const YAML::Node& node, std::vector<std::string>* ids)
+{
+	if (node.IsMap())
+	{
+		for (auto it = node.begin(); it != node.end(); ++it)
+		{
+			if (it->first.IsScalar() && it->first.Scalar() == IdPropertyName && it->second.IsScalar())
+			{
+				ids->push_back(it->second.Scalar());
+			}
+			else
+			{
+				collectComponentIds(it->second, ids);
+			}
+		}
+	}
+	else if (node.IsSequence())
+	{
+		for (auto it = node.begin(); it != node.end(); ++it)
+		{
+			collectComponentIds(*it, ids);
+		}
+	}
+}
+
+/// Partition the scene elements into groups that can be decoded independently of each other, scene elements that
+/// share a component id end up in the same group
+/// \param nodes The nodes of the scene elements
+/// \return The groups, each group holds the indices of its scene elements in increasing order
+std::vector<std::vector<size_t>> groupSceneElementNodes(const std::vector<YAML::Node>& nodes)
+{
+	std::vector<size_t> parents(nodes.size());
+	std::iota(parents.begin(), parents.end(), 0);
+	auto findRoot = [&parents](size_t index)
+	{
+		while (parents[index] != index)
+		{
+			parents[index] = parents[parents[index]];
+			index = parents[index];
+		}
+		return index;
+	};
+
+	std::unordered_map<std::string, size_t> owners;
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		std::vector<std::string> ids;
+		collectComponentIds(nodes[i], &ids);
+		for (const auto& id : ids)
+		{
+			auto owner = owners.find(id);
+			if (owner == owners.end())
+			{
+				owners[id] = i;
+			}
+			else
+			{
+				parents[findRoot(i)] = findRoot(owner->second);
+			}
+		}
+	}
+
+	std::vector<std::vector<size_t>> groups;
+	std::unordered_map<size_t, size_t> groupIndices;
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		size_t root = findRoot(i);
+		auto groupIndex = groupIndices.find(root);
+		if (groupIndex == groupIndices.end())
+		{
+			groupIndices[root] = groups.size();
+			groups.emplace_back(1, i);
+		}
+		else
+		{
+			groups[groupIndex->second].push_back(i);
+		}
+	}
+	return groups;
+}
+
+/// Decode the scene elements, independent groups of scene elements are decoded concurrently
+/// \param nodes The nodes of the scene elements
+/// \param [out] elements The decoded scene elements are appended in the order of the nodes
+/// \param progress If set, called with the number of decoded scene elements and their total number
+void decodeSceneElementNodes(const std::vector<YAML::Node>& nodes,
+							 std::vector<std::shared_ptr<SurgSim::Framework::SceneElement>>* elements,
+							 const std::function<void(size_t, size_t)>& progress)
+{
+	std::vector<std::shared_ptr<SurgSim::Framework::SceneElement>> decoded(nodes.size());
+	std::atomic<size_t> count(0);
+	auto decodeGroup = [&nodes, &decoded, &count, &progress](const std::vector<size_t>& group)
+	{
+		for (size_t index : group)
+		{
+			decoded[index] = nodes[index].as<std::shared_ptr<SurgSim::Framework::SceneElement>>();
+			size_t done = ++count;
+			if (progress != nullptr)
+			{
+				progress(done, nodes.size());
+			}
+		}
+	};
+
+	auto groups = groupSceneElementNodes(nodes);
+
+	// The calling thread decodes the first group itself, all the other groups go to the ThreadPool. A thread of the
+	// ThreadPool cannot wait on other tasks of the ThreadPool without risking a deadlock, it decodes all the groups.
+	auto threadPool = SurgSim::Framework::Runtime::getThreadPool();
+	size_t numInlineGroups = groups.size();
+	std::vector<std::future<void>> tasks;
+	if (groups.size() > 1 && !threadPool->isWorkerThread())
+	{
+		numInlineGroups = 1;
+		for (auto group = groups.cbegin() + 1; group != groups.cend(); ++group)
+		{
+			tasks.push_back(threadPool->enqueue<void>([&decodeGroup, group]() {decodeGroup(*group);}));
+		}
+	}
+
+	// All the tasks have to be finished before leaving, they refer to local data
+	std::exception_ptr failure;
+	try
+	{
+		for (size_t i = 0; i < numInlineGroups; ++i)
+		{
+			decodeGroup(groups[i]);
+		}
+	}
+	catch (...)
+	{
+		failure = std::current_exception();
+	}
+	for (auto& task : tasks)
+	{
+		try
+		{
+			task.get();
+		}
+		catch (...)
+		{
+			if (failure == nullptr)
+			{
+				failure = std::current_exception();
+			}
+		}
+	}
+	if (failure != nullptr)
+	{
+		std::rethrow_exception(failure);
+	}
+
+	elements->insert(elements->end(), decoded.begin(), decoded.end());
+}
+
 }
 
 namespace YAML
@@ -71,6 +282,7 @@ bool convert<std::shared_ptr<SurgSim::Framework::Component>>::decode(
 			if (data[IdPropertyName].IsDefined())
 			{
 				std::string id = data[IdPropertyName].as<std::string>();
+				boost::lock_guard<boost::mutex> lock(getRegistryMutex());
 				RegistryType& registry = getRegistry();
 				auto sharedComponent = registry.find(id);
 				if (sharedComponent != registry.end())
@@ -88,7 +300,7 @@ bool convert<std::shared_ptr<SurgSim::Framework::Component>>::decode(
 				else
 				{
 					rhs = factory.create(className, name);
-					getRegistry()[id] = rhs;
+					registry[id] = rhs;
 				}
 			}
 			else
@@ -114,6 +326,12 @@ convert<std::shared_ptr<SurgSim::Framework::Component>>::RegistryType&
 	return registry;
 }
 
+boost::mutex& convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistryMutex()
+{
+	static boost::mutex mutex;
+	return mutex;
+}
+
 Node convert<SurgSim::Framework::Component>::encode(const SurgSim::Framework::Component& rhs)
 {
 	YAML::Node data(rhs.encode());
@@ -151,51 +369,10 @@ bool YAML::convert<std::vector<std::shared_ptr<SurgSim::Framework::SceneElement>
 	std::vector<std::shared_ptr<SurgSim::Framework::SceneElement>>& rhs, // NOLINT
 	std::vector<std::string>* stack)
 {
-	std::unique_ptr<std::vector<std::string>> localStack;
-	if (node.IsSequence())
-	{
-		if (stack == nullptr)
-		{
-			localStack.reset(new std::vector<std::string>());
-			stack = localStack.get();
-		}
-		for (auto element = node.begin(); element != node.end(); ++element)
-		{
-			if (element->IsMap() && element->begin()->first.as<std::string>() == "INCLUDE")
-			{
-
-				auto file = element->begin()->second.as<std::string>();
-				auto data = SurgSim::Framework::Runtime::getApplicationData();
-				SURGSIM_ASSERT(data->tryFindFile(file, &file))
-						<< "Could not find include file " << file;
-
-				SURGSIM_ASSERT(std::find(stack->cbegin(), stack->cend(), file) == stack->cend())
-						<< "Found inclusion loop File: " << file << " included from " << stack->back()
-						<< " is already included.";
-
-				auto included = YAML::LoadFile(file);
-				stack->push_back(file);
-				YAML::convert<std::vector<std::shared_ptr<SurgSim::Framework::SceneElement>>>::decode(
-					included, rhs, stack);
-				stack->pop_back();
-			}
-			else
-			{
-				rhs.push_back(element->as<std::shared_ptr<SurgSim::Framework::SceneElement>>());
-			}
-		}
-	}
-	else if (node.IsMap())
-	{
-		rhs.push_back(node.as<std::shared_ptr<SurgSim::Framework::SceneElement>>());
-	}
-	else
-	{
-		SURGSIM_FAILURE()
-				<< "Trying to decode std::vector<std::shared_ptr<SceneElement>> but the received node is neither "
-				<< "a sequence nor a map";
-		return false;
-	}
+	std::vector<Node> nodes;
+	std::vector<std::string> localStack;
+	collectSceneElementNodes(node, (stack == nullptr) ? &localStack : stack, &nodes);
+	decodeSceneElementNodes(nodes, &rhs, nullptr);
 	return true;
 }
 
@@ -268,3 +445,21 @@ bool YAML::convert<std::shared_ptr<SurgSim::Framework::Asset>>::decode(
 }
 
 }
+
+namespace SurgSim
+{
+namespace Framework
+{
+
+void decodeSceneElements(const YAML::Node& node, std::vector<std::shared_ptr<SceneElement>>* elements,
+						 const std::function<void(size_t, size_t)>& progress)
+{
+	SURGSIM_ASSERT(elements != nullptr) << "Can't decode scene elements into nullptr.";
+	std::vector<YAML::Node> nodes;
+	std::vector<std::string> stack;
+	collectSceneElementNodes(node, &stack, &nodes);
+	decodeSceneElementNodes(nodes, elements, progress);
+}
+
+}; // namespace Framework
+}; // namespace SurgSim
@@ -16,8 +16,11 @@
 #ifndef SURGSIM_FRAMEWORK_FRAMEWORKCONVERT_H
 #define SURGSIM_FRAMEWORK_FRAMEWORKCONVERT_H
 
+#include <boost/thread/mutex.hpp>
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 
@@ -29,6 +32,19 @@ class Asset;
 class Component;
 class SceneElement;
 class Scene;
+
+/// Decode a list of scene elements, resolving the INCLUDE entries first.
+/// Scene elements that are connected through components with the same id depend on each other, these are decoded
+/// in the order in which they appear on one thread. Independent scene elements are decoded concurrently on the
+/// ThreadPool of the Runtime, so that the assets they load (meshes, FEMs, octrees, ...) are read in parallel.
+/// \param node A sequence of scene elements or a single scene element
+/// \param [out] elements The decoded scene elements are appended in the order in which they appear in the file
+/// \param progress If set, called with the number of decoded scene elements and their total number after each scene
+///        element has been decoded, this may be called from the threads of the ThreadPool
+/// \throws SurgSim::Framework::AssertionFailure or YAML::Exception if any of the scene elements failed to decode,
+///         the first failure is rethrown once all the scene elements have been processed
+void decodeSceneElements(const YAML::Node& node, std::vector<std::shared_ptr<SceneElement>>* elements,
+						 const std::function<void(size_t, size_t)>& progress = nullptr);
 }
 }
 
@@ -73,6 +89,9 @@ struct convert<std::shared_ptr<SurgSim::Framework::Component>>
 
 	/// \return The static registry for shared instances
 	static RegistryType& getRegistry();
+
+	/// \return The mutex that guards the registry, scene elements may be decoded concurrently
+	static boost::mutex& getRegistryMutex();
 };
 
 /// Override of the convert structure for an Component, use this form to write out a full version
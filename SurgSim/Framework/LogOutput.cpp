@@ -15,8 +15,13 @@
 
 #include "SurgSim/Framework/LogOutput.h"
 
+#include <boost/chrono.hpp>
 #include <boost/thread/locks.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <sstream>
 
 #include "SurgSim/Framework/Assert.h"
 #include "SurgSim/Framework/Logger.h"
@@ -71,6 +76,179 @@ bool StreamOutput::writeMessage(const std::string& message)
 	return result;
 }
 
+const size_t AsyncOutput::MaxMessageLength;
+
+AsyncOutput::AsyncOutput(std::shared_ptr<LogOutput> output, size_t capacity) :
+	m_output(output),
+	m_slots(new Slot[capacity]),
+	m_mask(capacity - 1),
+	m_enqueuePosition(0),
+	m_dequeuePosition(0),
+	m_writtenCount(0),
+	m_droppedCount(0),
+	m_failedCount(0),
+	m_truncatedCount(0),
+	m_reportedDroppedCount(0),
+	m_running(true)
+{
+	SURGSIM_ASSERT(m_output != nullptr) << "AsyncOutput needs an output to write to.";
+	SURGSIM_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0)
+		<< "The capacity of an AsyncOutput needs to be a power of 2, " << capacity << " is not.";
+
+	for (size_t i = 0; i < capacity; ++i)
+	{
+		m_slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	m_thread = boost::thread(&AsyncOutput::run, this);
+}
+
+AsyncOutput::~AsyncOutput()
+{
+	m_running = false;
+	m_thread.join();
+}
+
+bool AsyncOutput::writeMessage(const std::string& message)
+{
+	// Bounded multi producer queue, a producer claims a position by advancing m_enqueuePosition, the slot is free
+	// if its sequence number matches the position, and is published by setting the sequence to position + 1
+	size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+	Slot* slot;
+	while (true)
+	{
+		slot = &m_slots[position & m_mask];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+		if (difference == 0)
+		{
+			if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (difference < 0)
+		{
+			++m_droppedCount;
+			return false;
+		}
+		else
+		{
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	// Copy into the preallocated record, the writer thread polls for it
+	slot->length = std::min(message.size(), MaxMessageLength);
+	std::memcpy(slot->message, message.data(), slot->length);
+	if (message.size() > MaxMessageLength)
+	{
+		std::memcpy(slot->message + MaxMessageLength - 3, "...", 3);
+		++m_truncatedCount;
+	}
+	slot->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+void AsyncOutput::flush()
+{
+	const size_t target = m_enqueuePosition.load();
+	while (m_writtenCount < target && m_running)
+	{
+		boost::this_thread::sleep_for(boost::chrono::milliseconds(1));
+	}
+}
+
+size_t AsyncOutput::getDroppedMessageCount() const
+{
+	return m_droppedCount;
+}
+
+size_t AsyncOutput::getFailedMessageCount() const
+{
+	return m_failedCount;
+}
+
+size_t AsyncOutput::getTruncatedMessageCount() const
+{
+	return m_truncatedCount;
+}
+
+size_t AsyncOutput::getCapacity() const
+{
+	return m_mask + 1;
+}
+
+void AsyncOutput::run()
+{
+	// Producers never signal, poll the buffer and back off while it is empty
+	int64_t backoff = 0;
+	while (m_running)
+	{
+		if (drain() > 0)
+		{
+			backoff = 0;
+		}
+		else
+		{
+			backoff = std::min(backoff + 1, static_cast<int64_t>(10));
+			boost::this_thread::sleep_for(boost::chrono::milliseconds(backoff));
+		}
+	}
+
+	// Write out everything that was queued before the shutdown
+	drain();
+}
+
+size_t AsyncOutput::drain()
+{
+	size_t count = 0;
+	while (true)
+	{
+		Slot& slot = m_slots[m_dequeuePosition & m_mask];
+		if (slot.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+		{
+			break;
+		}
+
+		std::string message(slot.message, slot.length);
+		slot.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+		++m_dequeuePosition;
+
+		try
+		{
+			if (!m_output->writeMessage(message))
+			{
+				++m_failedCount;
+			}
+		}
+		catch (...)
+		{
+			++m_failedCount;
+		}
+		++m_writtenCount;
+		++count;
+	}
+
+	const size_t dropped = m_droppedCount;
+	if (dropped != m_reportedDroppedCount)
+	{
+		std::stringstream report;
+		report << "AsyncOutput dropped " << dropped - m_reportedDroppedCount << " messages.";
+		m_reportedDroppedCount = dropped;
+		try
+		{
+			m_output->writeMessage(report.str());
+		}
+		catch (...)
+		{
+			// The output is failing, there is nobody to tell
+		}
+	}
+
+	return count;
+}
+
 }; // namespace Framework
 }; // namespace SurgSim
 
@@ -16,8 +16,12 @@
 #ifndef SURGSIM_FRAMEWORK_LOGOUTPUT_H
 #define SURGSIM_FRAMEWORK_LOGOUTPUT_H
 
+#include <atomic>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <fstream>
+#include <memory>
+#include <string>
 
 namespace SurgSim
 {
@@ -89,6 +93,96 @@ class StreamOutput : public LogOutput
 	boost::mutex m_mutex;
 };
 
+/// Class to output logging information asynchronously, messages are queued in a bounded lock-free ring buffer and
+/// written to another output by a background thread. writeMessage() never waits on the wrapped output or on a lock,
+/// and does not allocate, the messages are copied into fixed size records preallocated in the buffer. This makes it
+/// safe to use from threads that must not be stalled, e.g. the physics thread. The writer thread polls the buffer,
+/// backing off up to 10 ms while it is empty.
+/// Messages longer than MaxMessageLength are truncated. When the buffer is full new messages are dropped and counted,
+/// the writer thread reports the number of dropped messages through the wrapped output. All the queued messages are
+/// written before the output is destroyed.
+class AsyncOutput : public LogOutput
+{
+public:
+
+	/// Constructor, starts the writer thread
+	/// \param output The output that the messages are written to by the writer thread
+	/// \param capacity The maximum number of queued messages, needs to be a power of 2
+	explicit AsyncOutput(std::shared_ptr<LogOutput> output, size_t capacity = 4096);
+
+	/// The maximum length of a queued message, longer ones are truncated and end with "..."
+	static const size_t MaxMessageLength = 512;
+
+	/// Destructor, writes all the queued messages and stops the writer thread
+	~AsyncOutput();
+
+	/// Queue a message for writing, does not block
+	/// \param message to be written out
+	/// \return true if the message was queued, false if it was dropped because the buffer was full
+	bool writeMessage(const std::string& message) override;
+
+	/// Block until all the messages that were queued before this call have been written
+	void flush();
+
+	/// \return The number of messages that were dropped because the buffer was full
+	size_t getDroppedMessageCount() const;
+
+	/// \return The number of messages that the wrapped output failed to write
+	size_t getFailedMessageCount() const;
+
+	/// \return The number of messages that were truncated to MaxMessageLength
+	size_t getTruncatedMessageCount() const;
+
+	/// \return The maximum number of queued messages
+	size_t getCapacity() const;
+
+private:
+	/// Loop of the writer thread
+	void run();
+
+	/// Write all the queued messages to the wrapped output
+	/// \return The number of messages that were written
+	size_t drain();
+
+	/// Entry of the ring buffer, the sequence number tells producers and the writer whether the slot is free
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		size_t length;
+		char message[MaxMessageLength];
+	};
+
+	std::shared_ptr<LogOutput> m_output;
+
+	std::unique_ptr<Slot[]> m_slots;
+	size_t m_mask;
+
+	/// Next position to be claimed by a producer
+	std::atomic<size_t> m_enqueuePosition;
+
+	/// Next position to be read, only used by the writer thread
+	size_t m_dequeuePosition;
+
+	/// Number of messages that have been handed to the wrapped output
+	std::atomic<size_t> m_writtenCount;
+
+	/// Number of messages dropped because the buffer was full
+	std::atomic<size_t> m_droppedCount;
+
+	/// Number of messages the wrapped output failed to write
+	std::atomic<size_t> m_failedCount;
+
+	/// Number of messages longer than MaxMessageLength, cut to fit in their record
+	std::atomic<size_t> m_truncatedCount;
+
+	/// Number of dropped messages that have been reported, only used by the writer thread
+	size_t m_reportedDroppedCount;
+
+	std::atomic<bool> m_running;
+
+	boost::thread m_thread;
+};
+
 }; // namespace Framework
 }; // namespace SurgSim
 
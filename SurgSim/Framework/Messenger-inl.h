@@ -0,0 +1,180 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_FRAMEWORK_MESSENGER_INL_H
+#define SURGSIM_FRAMEWORK_MESSENGER_INL_H
+
+#include <algorithm>
+#include <type_traits>
+
+#include <boost/thread/lock_guard.hpp>
+
+#include "SurgSim/Framework/Assert.h"
+
+namespace SurgSim
+{
+namespace Framework
+{
+
+/// Typed channel, with a multiple producers, single consumer lock-free queue holding the payloads by value
+template <class T>
+class Messenger::ChannelData : public Messenger::ChannelBase
+{
+public:
+	static_assert(std::is_trivially_copyable<T>::value, "The payload of a typed channel has to be trivially copyable");
+
+	typedef std::function<void(const ChannelEvent<T>&)> Callback;
+	typedef std::pair<std::weak_ptr<Component>, Callback> Subscriber;
+
+	ChannelData(const std::string& name, size_t id, size_t capacity) :
+		ChannelBase(name, id),
+		queue(capacity)
+	{
+	}
+
+	void dispatch(Messenger* messenger, const std::vector<Messenger::Subscriber>& broadcast) override
+	{
+		std::vector<Subscriber> receivers;
+		{
+			boost::lock_guard<boost::mutex> lock(mutex);
+			subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+											 [](const Subscriber& s) {return s.first.expired();}), subscribers.end());
+			receivers = subscribers;
+		}
+		const std::vector<Messenger::Subscriber> named = messenger->getSubscribers(name);
+
+		ChannelEvent<T> event;
+		while (queue.pop(event))
+		{
+			for (const auto& subscriber : receivers)
+			{
+				if (subscriber.first.lock() != nullptr)
+				{
+					subscriber.second(event);
+				}
+			}
+			if (!named.empty() || !broadcast.empty())
+			{
+				const Event adapted(name, "", event.time, event.data);
+				messenger->sendEvent(adapted, named);
+				messenger->sendEvent(adapted, broadcast);
+			}
+		}
+	}
+
+	void unsubscribe(const std::shared_ptr<Component>& subscriber) override
+	{
+		boost::lock_guard<boost::mutex> lock(mutex);
+		subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [&subscriber](const Subscriber& s)
+		{
+			return s.first.lock() == subscriber;
+		}), subscribers.end());
+	}
+
+	/// The queued events
+	boost::lockfree::queue<ChannelEvent<T>, boost::lockfree::fixed_sized<false>> queue;
+
+	/// The subscribers of the channel
+	std::vector<Subscriber> subscribers;
+
+	/// Mutex to protect the subscribers
+	boost::mutex mutex;
+};
+
+template <class T>
+bool Messenger::Channel<T>::isValid() const
+{
+	return m_data != nullptr;
+}
+
+template <class T>
+size_t Messenger::Channel<T>::getId() const
+{
+	SURGSIM_ASSERT(isValid()) << "The channel has not been registered.";
+	return m_data->id;
+}
+
+template <class T>
+const std::string& Messenger::Channel<T>::getName() const
+{
+	SURGSIM_ASSERT(isValid()) << "The channel has not been registered.";
+	return m_data->name;
+}
+
+template <class T>
+Messenger::Channel<T> Messenger::registerChannel(const std::string& name, size_t capacity)
+{
+	boost::lock_guard<boost::mutex> lock(m_channelMutex);
+
+	Channel<T> channel;
+	auto found = m_channelsByName.find(name);
+	if (found != m_channelsByName.end())
+	{
+		channel.m_data = std::dynamic_pointer_cast<ChannelData<T>>(found->second);
+		SURGSIM_ASSERT(channel.m_data != nullptr)
+			<< "The channel " << name << " has already been registered with another payload type.";
+	}
+	else
+	{
+		channel.m_data = std::make_shared<ChannelData<T>>(name, m_channels.size(), capacity);
+		m_channels.push_back(channel.m_data);
+		m_channelsByName[name] = channel.m_data;
+	}
+	return channel;
+}
+
+template <class T>
+void Messenger::publish(const Channel<T>& channel, const T& data)
+{
+	SURGSIM_ASSERT(channel.isValid()) << "The channel has not been registered.";
+	ChannelEvent<T> event;
+	event.time = m_timer.getCurrentTime();
+	event.data = data;
+	channel.m_data->queue.push(event);
+}
+
+template <class T>
+void Messenger::subscribe(const Channel<T>& channel, const std::shared_ptr<SurgSim::Framework::Component>& subscriber,
+						  const std::function<void(const ChannelEvent<T>&)>& callback)
+{
+	SURGSIM_ASSERT(channel.isValid()) << "The channel has not been registered.";
+	SURGSIM_ASSERT(subscriber != nullptr) << "Subscriber can't be nullptr.";
+	SURGSIM_ASSERT(callback != nullptr) << "Callback can't be nullptr.";
+
+	boost::lock_guard<boost::mutex> lock(channel.m_data->mutex);
+	auto& subscribers = channel.m_data->subscribers;
+	auto entry = std::find_if(subscribers.begin(), subscribers.end(),
+							  [&subscriber](const typename ChannelData<T>::Subscriber& s)
+	{
+		return s.first.lock() == subscriber;
+	});
+	if (entry == subscribers.end())
+	{
+		subscribers.emplace_back(subscriber, callback);
+	}
+}
+
+template <class T>
+void Messenger::unsubscribe(const Channel<T>& channel, const std::shared_ptr<SurgSim::Framework::Component>& subscriber)
+{
+	SURGSIM_ASSERT(channel.isValid()) << "The channel has not been registered.";
+	SURGSIM_ASSERT(subscriber != nullptr) << "Subscriber can't be nullptr.";
+	channel.m_data->unsubscribe(subscriber);
+}
+
+}; // namespace Framework
+}; // namespace SurgSim
+
+#endif // SURGSIM_FRAMEWORK_MESSENGER_INL_H
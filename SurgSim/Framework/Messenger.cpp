@@ -54,6 +54,16 @@ struct Expired
 
 }
 
+Messenger::ChannelBase::ChannelBase(const std::string& name, size_t id) :
+	name(name),
+	id(id)
+{
+}
+
+Messenger::ChannelBase::~ChannelBase()
+{
+}
+
 Messenger::Messenger()
 {
 	m_timer.setMaxNumberOfFrames(1);
@@ -88,6 +98,16 @@ void Messenger::update()
 		sendEvent(event, subscribers);
 		sendEvent(event, broadcast);
 	}
+
+	std::vector<std::shared_ptr<ChannelBase>> channels;
+	{
+		boost::lock_guard<boost::mutex> lock(m_channelMutex);
+		channels = m_channels;
+	}
+	for (const auto& channel : channels)
+	{
+		channel->dispatch(this, broadcast);
+	}
 }
 
 void Messenger::publish(const std::string& event, const std::string& sender, const boost::any& data)
@@ -166,6 +186,19 @@ void Messenger::unsubscribe(const std::shared_ptr<SurgSim::Framework::Component>
 			std::remove_if(subscribers.begin(), subscribers.end(), Contains(subscriber)), subscribers.end()
 		);
 	}
+
+	boost::lock_guard<boost::mutex> channelLock(m_channelMutex);
+	for (const auto& channel : m_channels)
+	{
+		channel->unsubscribe(subscriber);
+	}
+}
+
+std::vector<Messenger::Subscriber> Messenger::getSubscribers(const std::string& event)
+{
+	boost::lock_guard<boost::mutex> lock(m_subscriberMutex);
+	auto found = m_subscribers.find(event);
+	return (found != m_subscribers.end()) ? found->second : std::vector<Subscriber>();
 }
 
 void Messenger::sendEvent(const Event& event, const std::vector<Subscriber>& subscribers)
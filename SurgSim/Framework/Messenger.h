@@ -21,8 +21,14 @@
 #include "SurgSim/Framework/Timer.h"
 #include "SurgSim/Framework/Component.h"
 
+#include <boost/lockfree/queue.hpp>
 #include <boost/thread/mutex.hpp>
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace SurgSim
 {
 namespace Framework
@@ -37,8 +43,20 @@ namespace Framework
 /// The event structure sent to the receiver contains the senders full name, the actual name of the event, the time
 /// that the event was received by the messenger (this based on a local clock inside the messenger) and
 /// some optional data. To decode the data the receiver has to know what type the original data was in.
+///
+/// For high frequency events, typed channels avoid the string comparisons, the allocations and the locking of the
+/// string based events. A channel is registered once with a name and a payload type, see registerChannel(), and gets
+/// an integer id. Publishing to a channel pushes the payload by value on the lock-free queue of the channel, it
+/// doesn't lock and doesn't allocate once the queue has grown to its working size. The payload type has to be
+/// trivially copyable, e.g. a plain struct of numbers or of enums. The queued events are sent to the
+/// subscribers of the channel during update(), channel by channel, after the string based events. The subscribers
+/// to the name of the channel, and to all events, receive them too as Event objects, with the payload in the data.
 class Messenger
 {
+private:
+	template <class T>
+	class ChannelData;
+
 public:
 
 	/// Datastructure to contain basic event data
@@ -56,6 +74,35 @@ class Messenger
 
 	typedef std::function<void(const Event&)> EventCallback; /// To receive events this is the format of the callback
 
+	/// Event sent on a typed channel
+	template <class T>
+	struct ChannelEvent
+	{
+		double time; /// Time the event is published
+		T data; /// Data
+	};
+
+	/// Handle of a typed channel, see registerChannel()
+	template <class T>
+	class Channel
+	{
+	public:
+		/// \return true if the handle refers to a registered channel
+		bool isValid() const;
+
+		/// \return The integer id of the channel
+		size_t getId() const;
+
+		/// \return The name of the channel
+		const std::string& getName() const;
+
+	private:
+		friend class Messenger;
+
+		/// The channel
+		std::shared_ptr<ChannelData<T>> m_data;
+	};
+
 
 	Messenger();
 
@@ -99,7 +146,63 @@ class Messenger
 	/// \param subscriber The subscriber that wants to be unsubscribed
 	void unsubscribe(const std::shared_ptr<SurgSim::Framework::Component>& subscriber);
 
+	/// Register a typed channel, registering an existing name returns the existing channel
+	/// \tparam T The type of the payload, it has to be trivially copyable
+	/// \param name The name of the channel
+	/// \param capacity The initial capacity of the queue of the channel, it grows if needed
+	/// \return The handle to the channel
+	/// \throws SurgSim::Framework::AssertionFailure if the name is registered with another payload type
+	template <class T>
+	Channel<T> registerChannel(const std::string& name, size_t capacity = 1024);
+
+	/// Put an event on a typed channel, this is lock-free and can be called from any thread
+	/// \param channel The channel
+	/// \param data The payload
+	template <class T>
+	void publish(const Channel<T>& channel, const T& data);
+
+	/// Subscribe to receiving the events of a typed channel
+	/// \param channel The channel
+	/// \param subscriber The component receiving the callback
+	/// \param callback The function to be called when the event occurs
+	template <class T>
+	void subscribe(const Channel<T>& channel, const std::shared_ptr<SurgSim::Framework::Component>& subscriber,
+				   const std::function<void(const ChannelEvent<T>&)>& callback);
+
+	/// Unsubscribe from receiving the events of a typed channel
+	/// \param channel The channel
+	/// \param subscriber The subscriber that wants to be unsubscribed
+	template <class T>
+	void unsubscribe(const Channel<T>& channel, const std::shared_ptr<SurgSim::Framework::Component>& subscriber);
+
 private:
+	/// Base class of the typed channels
+	class ChannelBase
+	{
+	public:
+		/// Constructor
+		/// \param name The name of the channel
+		/// \param id The id of the channel
+		ChannelBase(const std::string& name, size_t id);
+
+		virtual ~ChannelBase();
+
+		/// Send the queued events to the subscribers
+		/// \param messenger The messenger, for the subscribers to the name of the channel
+		/// \param broadcast The subscribers to all events
+		virtual void dispatch(Messenger* messenger,
+							  const std::vector<std::pair<std::weak_ptr<Component>, EventCallback>>& broadcast) = 0;
+
+		/// Remove all the subscriptions of the given subscriber
+		/// \param subscriber The subscriber
+		virtual void unsubscribe(const std::shared_ptr<Component>& subscriber) = 0;
+
+		/// The name of the channel
+		const std::string name;
+
+		/// The id of the channel
+		const size_t id;
+	};
 
 	/// Local timer for global wall-clock
 	SurgSim::Framework::Timer m_timer;
@@ -121,11 +224,26 @@ class Messenger
 	/// Mutex to protect list of events
 	boost::mutex m_eventMutex;
 
+	/// Typed channels, in the order of their ids
+	std::vector<std::shared_ptr<ChannelBase>> m_channels;
+
+	/// Typed channels, by name
+	std::unordered_map<std::string, std::shared_ptr<ChannelBase>> m_channelsByName;
+
+	/// Mutex to protect the typed channels registration
+	boost::mutex m_channelMutex;
+
 	/// Post an event to all its receivers
 	void sendEvent(const Event& event, const std::vector<Subscriber>& receivers);
 
+	/// \param event The name of the event
+	/// \return The subscribers to the event
+	std::vector<Subscriber> getSubscribers(const std::string& event);
+
 };
 }
 }
 
-#endif
\ No newline at end of file
+#include "SurgSim/Framework/Messenger-inl.h"
+
+#endif
@@ -16,6 +16,9 @@
 #include <boost/thread/thread.hpp>
 #include <boost/thread/locks.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 #include "SurgSim/Framework/Runtime.h"
 
 #include "SurgSim/Framework/ApplicationData.h"
@@ -38,7 +41,13 @@ std::shared_ptr<ApplicationData> Runtime::m_applicationData;
 Runtime::Runtime() :
 	m_isRunning(false),
 	m_isPaused(false),
-	m_isStopped(false)
+	m_isStopped(false),
+	m_isLockstep(false),
+	m_lockstepPeriod(0.0),
+	m_lockstepRounds(0),
+	m_lockstepSteps(0),
+	m_loadedElements(0),
+	m_totalElements(0)
 {
 	initSearchPaths("");
 }
@@ -46,13 +55,25 @@ Runtime::Runtime() :
 Runtime::Runtime(const std::string& configFilePath) :
 	m_isRunning(false),
 	m_isPaused(false),
-	m_isStopped(false)
+	m_isStopped(false),
+	m_isLockstep(false),
+	m_lockstepPeriod(0.0),
+	m_lockstepRounds(0),
+	m_lockstepSteps(0),
+	m_loadedElements(0),
+	m_totalElements(0)
 {
 	initSearchPaths(configFilePath);
 }
 
 Runtime::~Runtime()
 {
+	// The loading thread still refers to the runtime
+	if (m_loading.valid())
+	{
+		m_loading.wait();
+	}
+
 	// Kill all threads
 	stop();
 }
@@ -79,6 +100,54 @@ std::vector<std::weak_ptr<ComponentManager>> Runtime::getManagers() const
 }
 
 
+void Runtime::configureManagers(const YAML::Node& node)
+{
+	SURGSIM_ASSERT(!m_isRunning) << "Cannot configure the managers once the runtime is running";
+	SURGSIM_ASSERT(node.IsMap()) << "The manager configuration has to be a map of manager names to configurations";
+
+	for (auto entry = node.begin(); entry != node.end(); ++entry)
+	{
+		const std::string name = entry->first.as<std::string>();
+		auto manager = std::find_if(m_managers.begin(), m_managers.end(),
+									[&name](const std::shared_ptr<ComponentManager>& m)
+		{
+			return m->getName() == name;
+		});
+		SURGSIM_ASSERT(manager != m_managers.end()) << "Cannot configure the unknown manager " << name;
+
+		const YAML::Node& configuration = entry->second;
+		if (configuration["Rate"])
+		{
+			(*manager)->setRate(configuration["Rate"].as<double>());
+		}
+		if (configuration["CpuAffinity"])
+		{
+			(*manager)->setCpuAffinity(configuration["CpuAffinity"].as<std::vector<size_t>>());
+		}
+		if (configuration["RealTimePriority"])
+		{
+			(*manager)->setRealTimePriority(configuration["RealTimePriority"].as<int>());
+		}
+		if (configuration["BusyWaitTime"])
+		{
+			(*manager)->setBusyWaitTime(configuration["BusyWaitTime"].as<double>());
+		}
+	}
+}
+
+void Runtime::loadManagerConfiguration(const std::string& fileName)
+{
+	YAML::Node node;
+	if (tryLoadNode(fileName, &node))
+	{
+		configureManagers(node);
+	}
+	else
+	{
+		SURGSIM_FAILURE() << "Could not load the manager configuration from the YAML file: " << fileName;
+	}
+}
+
 SurgSim::Framework::Messenger& Runtime::getMessenger()
 {
 	return m_messenger;
@@ -157,6 +226,9 @@ bool Runtime::start(bool paused)
 
 	SURGSIM_ASSERT(m_isStopped == false) << "This runtime has already been stopped, it cannot be started again.";
 
+	// The managers should only receive the components of the scene once all of them are initialized
+	waitForLoading();
+
 	// Gather all the Components from the currently known SceneElements to add them
 	// collectively.
 	// HS-2013-dec-12 This construct cause a bug as this also gathers the elements to be processed
@@ -166,15 +238,18 @@ bool Runtime::start(bool paused)
 	m_isRunning = true;
 	m_isPaused = paused;
 
-	// Start Messenger Thread
-	m_messengerThread = boost::thread([this]()
+	// Start Messenger Thread, in lockstep mode the messages are delivered at the end of each step
+	if (!m_isLockstep)
 	{
-		while (this->m_isRunning)
+		m_messengerThread = boost::thread([this]()
 		{
-			m_messenger.update();
-			boost::this_thread::sleep(boost::posix_time::milliseconds(200));
-		}
-	});
+			while (this->m_isRunning)
+			{
+				m_messenger.update();
+				boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+			}
+		});
+	}
 
 	std::vector<std::shared_ptr<ComponentManager>>::iterator it;
 	m_barrier.reset(new Barrier(m_managers.size() + 1));
@@ -210,7 +285,12 @@ bool Runtime::stop()
 		return false;
 	}
 
-	if (isPaused())
+	if (m_isLockstep && m_isRunning)
+	{
+		// Release the managers from the barrier, this ends their update loop
+		m_barrier->wait(false);
+	}
+	else if (isPaused())
 	{
 		resume();
 	}
@@ -226,7 +306,10 @@ bool Runtime::stop()
 	}
 
 	// Wait for the messenger to run through and deliver the last pending messages
-	m_messengerThread.join();
+	if (m_messengerThread.joinable())
+	{
+		m_messengerThread.join();
+	}
 	m_messenger.update();
 
 	// Give all threads time to run through update
@@ -282,6 +365,87 @@ void Runtime::step()
 	}
 }
 
+void Runtime::setLockstepRate(const std::shared_ptr<ComponentManager>& manager, double rate)
+{
+	SURGSIM_ASSERT(!m_isRunning) << "Cannot set the lockstep rate of a manager once the runtime is running";
+	SURGSIM_ASSERT(rate >= 0.0) << "The lockstep rate of " << manager->getName() << " cannot be negative";
+	m_lockstepRates[manager.get()] = rate;
+}
+
+bool Runtime::startLockstep()
+{
+	SURGSIM_ASSERT(!m_isRunning) << "The runtime is already running";
+
+	std::vector<double> rates;
+	double maxRate = 0.0;
+	for (const auto& manager : m_managers)
+	{
+		auto rate = m_lockstepRates.find(manager.get());
+		rates.push_back((rate != m_lockstepRates.end()) ? rate->second : manager->getRate());
+		maxRate = std::max(maxRate, rates.back());
+	}
+	SURGSIM_ASSERT(maxRate > 0.0) << "The lockstep mode needs at least one manager with a positive rate";
+
+	// One barrier round per manager, and a last round without updates, so that all the updates of a step are done
+	// when the runtime passes the barrier for the last round
+	m_lockstepRounds = m_managers.size() + 1;
+	m_lockstepPeriod = 1.0 / maxRate;
+	m_lockstepSteps = 0;
+	for (size_t i = 0; i < m_managers.size(); ++i)
+	{
+		if (rates[i] > 0.0)
+		{
+			const size_t ratio = std::max(static_cast<size_t>(std::round(maxRate / rates[i])), static_cast<size_t>(1));
+			m_managers[i]->setRate(maxRate / ratio);
+			m_managers[i]->setSynchronousSchedule(m_lockstepRounds * ratio, i);
+		}
+		else
+		{
+			m_managers[i]->setIdle(true);
+		}
+	}
+
+	m_isLockstep = true;
+	return start(true);
+}
+
+void Runtime::advanceLockstep(double time)
+{
+	SURGSIM_ASSERT(m_isLockstep && m_isRunning) << "The runtime is not running in lockstep mode";
+
+	const size_t numSteps = static_cast<size_t>(std::round(time / m_lockstepPeriod));
+	for (size_t step = 0; step < numSteps; ++step)
+	{
+		for (size_t round = 0; round < m_lockstepRounds; ++round)
+		{
+			m_barrier->wait(true);
+		}
+		m_messenger.update();
+		++m_lockstepSteps;
+	}
+}
+
+double Runtime::getLockstepTime() const
+{
+	return m_lockstepSteps * m_lockstepPeriod;
+}
+
+bool Runtime::isLockstep() const
+{
+	return m_isLockstep;
+}
+
+bool Runtime::executeLockstep(double duration)
+{
+	bool result = startLockstep();
+	if (result)
+	{
+		advanceLockstep(duration);
+		result = stop();
+	}
+	return result;
+}
+
 bool Runtime::isRunning() const
 {
 	return m_isRunning;
@@ -388,7 +552,12 @@ void Runtime::loadScene(const std::string& fileName)
 	boost::lock_guard<boost::mutex> lock(m_sceneHandling);
 	if (tryLoadNode(fileName, &node))
 	{
-		YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistry().clear();
+		{
+			boost::lock_guard<boost::mutex> registryLock(
+				YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistryMutex());
+			YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistry().clear();
+		}
+		resetLoadingProgress();
 		m_scene = std::make_shared<Scene>(getSharedPtr());
 		m_scene->decode(node);
 	}
@@ -399,6 +568,66 @@ void Runtime::loadScene(const std::string& fileName)
 
 }
 
+void Runtime::loadSceneAsync(const std::string& fileName)
+{
+	SURGSIM_ASSERT(!isLoading()) << "Can't load " << fileName << ", a scene is already being loaded.";
+	resetLoadingProgress();
+	m_loading = std::async(std::launch::async, [this, fileName]() {loadScene(fileName);}).share();
+}
+
+bool Runtime::isLoading() const
+{
+	return m_loading.valid() && m_loading.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void Runtime::waitForLoading()
+{
+	if (m_loading.valid())
+	{
+		auto loading = m_loading;
+		m_loading = std::shared_future<void>();
+		loading.get();
+	}
+}
+
+double Runtime::getLoadingProgress() const
+{
+	size_t total = m_totalElements;
+	if (total == 0)
+	{
+		return isLoading() ? 0.0 : 1.0;
+	}
+	return static_cast<double>(m_loadedElements) / static_cast<double>(total);
+}
+
+void Runtime::setLoadingProgressCallback(LoadingProgressCallbackType callback)
+{
+	boost::lock_guard<boost::mutex> lock(m_loadingProgressMutex);
+	m_loadingProgressCallback = callback;
+}
+
+void Runtime::resetLoadingProgress()
+{
+	boost::lock_guard<boost::mutex> lock(m_loadingProgressMutex);
+	m_loadedElements = 0;
+	m_totalElements = 0;
+}
+
+void Runtime::updateLoadingProgress(size_t loaded, size_t total)
+{
+	// Scene elements are decoded concurrently, only report the progress once it is reached
+	boost::lock_guard<boost::mutex> lock(m_loadingProgressMutex);
+	if (loaded > m_loadedElements)
+	{
+		m_loadedElements = loaded;
+		m_totalElements = total;
+		if (m_loadingProgressCallback != nullptr)
+		{
+			m_loadingProgressCallback(loaded, total);
+		}
+	}
+}
+
 void Runtime::addSceneElements(const std::string& fileName)
 {
 	SURGSIM_LOG_DEBUG(Logger::getLogger("Runtime")) << "Adding scene elements from " << fileName;
@@ -429,7 +658,11 @@ std::vector<std::shared_ptr<SceneElement>> Runtime::duplicateSceneElements(const
 	boost::lock_guard<boost::mutex> lock(m_sceneHandling);
 
 	// Use a temporary registry
-	std::swap(YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistry(), registry);
+	{
+		boost::lock_guard<boost::mutex> registryLock(
+			YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistryMutex());
+		std::swap(YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistry(), registry);
+	}
 
 	bool success = false;
 	if (tryLoadNode(fileName, &node) && tryConvertElements(fileName, node, &result))
@@ -438,7 +671,11 @@ std::vector<std::shared_ptr<SceneElement>> Runtime::duplicateSceneElements(const
 	}
 
 	// restore the original registry
-	std::swap(YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistry(), registry);
+	{
+		boost::lock_guard<boost::mutex> registryLock(
+			YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistryMutex());
+		std::swap(YAML::convert<std::shared_ptr<SurgSim::Framework::Component>>::getRegistry(), registry);
+	}
 
 	if (!success)
 	{
@@ -481,7 +718,12 @@ bool Runtime::tryConvertElements(const std::string& filename, const YAML::Node&
 	{
 		try
 		{
-			*elements = node.as<std::vector<std::shared_ptr<SceneElement>>>();
+			resetLoadingProgress();
+			elements->clear();
+			decodeSceneElements(node, elements, std::bind(&Runtime::updateLoadingProgress, this,
+														  std::placeholders::_1, std::placeholders::_2));
+			SURGSIM_LOG_DEBUG(Logger::getLogger("Runtime"))
+					<< "Decoded " << elements->size() << " scene elements from " << filename;
 			result = true;
 		}
 		catch (YAML::Exception e)
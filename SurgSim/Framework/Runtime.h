@@ -18,6 +18,8 @@
 
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -54,6 +56,10 @@ class Runtime : public std::enable_shared_from_this<Runtime>
 {
 public:
 
+	/// Type of the callback that reports the loading progress, receives the number of scene elements that have been
+	/// decoded and the total number of scene elements that are being loaded
+	typedef std::function<void(size_t, size_t)> LoadingProgressCallbackType;
+
 	/// Default constructor.
 	Runtime();
 
@@ -72,6 +78,24 @@ class Runtime : public std::enable_shared_from_this<Runtime>
 	/// \return All the managers from the runtime
 	std::vector<std::weak_ptr<ComponentManager>> getManagers() const;
 
+	/// Configure the threads of the managers, from a map of manager names to thread configurations, e.g.
+	/// \code
+	/// Physics Manager:
+	///   Rate: 1000.0
+	///   CpuAffinity: [2, 3]
+	///   RealTimePriority: 80
+	///   BusyWaitTime: 0.0001
+	/// \endcode
+	/// All the entries are optional, see the corresponding BasicThread setters. Can't be used once running.
+	/// \param node The configuration
+	/// \throws If the node is not a map, or refers to an unknown manager
+	void configureManagers(const YAML::Node& node);
+
+	/// Configure the threads of the managers from the given file, \sa configureManagers()
+	/// \param fileName The name of the configuration file, needs to be found
+	/// \throws If the file cannot be found or is an invalid YAML file
+	void loadManagerConfiguration(const std::string& fileName);
+
 	/// \return The first manager of type T that is found nullptr otherwise
 	template <class T>
 	std::shared_ptr<T> getManager() const;
@@ -93,7 +117,8 @@ class Runtime : public std::enable_shared_from_this<Runtime>
 	/// Start all the threads and block until one of them quits
 	bool execute();
 
-	/// Start all the threads non returns after the startup as succeeded
+	/// Start all the threads non returns after the startup as succeeded, if a scene is being loaded
+	/// asynchronously this waits for the loading to finish, the managers only receive components that are ready.
 	/// \return	true if it succeeds, false if it fails.
 	bool start(bool paused = false);
 
@@ -112,6 +137,37 @@ class Runtime : public std::enable_shared_from_this<Runtime>
 	/// Make all managers execute 1 update loop, afterwards they will wait for another step() call or resume()
 	void step();
 
+	/// Set the rate of a manager in lockstep mode, overriding the rate of the manager, can only be used before
+	/// the runtime is started
+	/// \param manager The manager
+	/// \param rate The rate in hertz, 0 if the manager should not be updated at all (e.g. graphics in a headless run)
+	void setLockstepRate(const std::shared_ptr<ComponentManager>& manager, double rate);
+
+	/// Start all the managers in lockstep mode, for headless, deterministic and faster than real-time execution.
+	/// Rather than sleeping to keep their rate, the managers are stepped synchronously on a fixed virtual clock, with
+	/// the period of the fastest manager. Slower managers are updated every n steps, where n is the ratio of the
+	/// rates, their rate is adjusted to make n an integer. Within a step, the managers are updated one after the
+	/// other, in the order they were added, and the messages are delivered at the end of the step.
+	/// Use advanceLockstep() to run the simulation and stop() to end it.
+	/// \note The managers are expected to keep running, a manager that stops on its own stalls the lockstep.
+	/// \return true if it succeeds, false if it fails.
+	bool startLockstep();
+
+	/// Run the simulation in lockstep mode, blocks until all the updates are done
+	/// \param time The virtual time (in s) to run for, rounded to a number of steps
+	void advanceLockstep(double time);
+
+	/// \return The virtual time (in s) elapsed since the start of the lockstep mode
+	double getLockstepTime() const;
+
+	/// \return true if the runtime was started in lockstep mode
+	bool isLockstep() const;
+
+	/// Start all the managers in lockstep mode, run for the given virtual time and stop, \sa startLockstep()
+	/// \param duration The virtual time (in s) to run for
+	/// \return true if it succeeds, false if it fails.
+	bool executeLockstep(double duration);
+
 	/// Stops the simulation.
 	/// The call will wait for all the threads to finish, except for any threads that have been detached.
 	/// \warning This function is not thread safe, if stop is called when there are threads that are not waiting,
@@ -151,6 +207,27 @@ class Runtime : public std::enable_shared_from_this<Runtime>
 	/// \throws If the file cannot be found or is an invalid YAML file
 	void loadScene(const std::string& fileName);
 
+	/// Loads the scene from the given file on a separate thread and returns immediately, \sa loadScene().
+	/// The scene must not be accessed until the loading has finished, start() waits for the loading to finish.
+	/// \param fileName the filename of the scene to be loaded, needs to be found
+	void loadSceneAsync(const std::string& fileName);
+
+	/// \return true if a scene is being loaded asynchronously
+	bool isLoading() const;
+
+	/// Block until the asynchronous loading of a scene has finished
+	/// \throws If the loading failed, rethrows the exception that occurred during the loading
+	void waitForLoading();
+
+	/// \return The fraction of the scene elements of the current, or last, load operation that have been decoded,
+	///         between 0 and 1
+	double getLoadingProgress() const;
+
+	/// Set a callback that reports the progress of loading scene elements, it is called after each scene element
+	/// has been decoded, \note The callback may be called concurrently from the threads of the ThreadPool.
+	/// \param callback The callback, receives the number of decoded scene elements and their total number
+	void setLoadingProgressCallback(LoadingProgressCallbackType callback);
+
 	/// Adds the scene elements from the file to the current scene
 	/// The file format should be just a list of sceneElements
 	/// \code
@@ -209,9 +286,21 @@ class Runtime : public std::enable_shared_from_this<Runtime>
 	bool tryConvertElements(const std::string& fileName, const YAML::Node& node,
 							std::vector<std::shared_ptr<SceneElement>>* elements);
 
+	/// Reset the loading progress, before scene elements are decoded
+	void resetLoadingProgress();
+
+	/// Update the loading progress, called by the Scene or the Runtime after each scene element was decoded
+	/// \param loaded The number of decoded scene elements
+	/// \param total The total number of scene elements that are being decoded
+	void updateLoadingProgress(size_t loaded, size_t total);
+
 	/// Gets a shared pointer to the runtime.
 	/// \return	The shared pointer.
 	std::shared_ptr<Runtime> getSharedPtr();
+
+	/// The scene reports the loading progress while it decodes its scene elements
+	friend class Scene;
+
 	std::atomic<bool> m_isRunning;
 	std::vector<std::shared_ptr<ComponentManager>> m_managers;
 	std::shared_ptr<Scene> m_scene;
@@ -227,6 +316,27 @@ class Runtime : public std::enable_shared_from_this<Runtime>
 	bool m_isPaused;
 
 	bool m_isStopped;
+
+	///@{
+	/// Lockstep mode, the rates overriding the managers' rates, the virtual clock period, the number of barrier
+	/// rounds per step and the number of steps taken so far
+	bool m_isLockstep;
+	std::map<ComponentManager*, double> m_lockstepRates;
+	double m_lockstepPeriod;
+	size_t m_lockstepRounds;
+	size_t m_lockstepSteps;
+	///@}
+
+	/// The asynchronous loading operation, if any
+	std::shared_future<void> m_loading;
+
+	///@{
+	/// Progress of the current load operation
+	std::atomic<size_t> m_loadedElements;
+	std::atomic<size_t> m_totalElements;
+	LoadingProgressCallbackType m_loadingProgressCallback;
+	boost::mutex m_loadingProgressMutex;
+	///@}
 };
 
 template <class T>
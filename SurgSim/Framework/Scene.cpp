@@ -16,6 +16,7 @@
 #include "SurgSim/Framework/Scene.h"
 
 #include <boost/thread/locks.hpp>
+#include <functional>
 #include <set>
 #include <utility>
 #include <vector>
@@ -153,7 +154,12 @@ bool Scene::decode(const YAML::Node& node)
 
 		if (data["SceneElements"].IsDefined())
 		{
-			auto sceneElements = data["SceneElements"].as<std::vector<std::shared_ptr<SceneElement>>>();
+			// Independent scene elements are decoded concurrently, the runtime reports the progress
+			auto runtime = getRuntime();
+			SURGSIM_ASSERT(runtime) << "Runtime pointer is expired, cannot decode the Scene.";
+			std::vector<std::shared_ptr<SceneElement>> sceneElements;
+			decodeSceneElements(data["SceneElements"], &sceneElements, std::bind(&Runtime::updateLoadingProgress,
+								runtime, std::placeholders::_1, std::placeholders::_2));
 
 			std::for_each(sceneElements.begin(), sceneElements.end(),
 						  [&](std::shared_ptr<SceneElement> element)
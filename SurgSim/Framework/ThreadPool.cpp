@@ -71,5 +71,18 @@ ThreadPool::~ThreadPool()
 	}
 }
 
+bool ThreadPool::isWorkerThread() const
+{
+	const boost::thread::id id = boost::this_thread::get_id();
+	for (const auto& thread : m_threads)
+	{
+		if (thread.get_id() == id)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 };
 };
@@ -81,6 +81,10 @@ class ThreadPool
 	template <class R>
 	std::future<R> enqueue(std::function<R()> function);
 
+	/// \return true if called from one of the worker threads, i.e. from a task, which must not wait for the tasks
+	/// queued after it.
+	bool isWorkerThread() const;
+
 private:
 	/// @{
 	/// Prevent default copy construction and default assignment
@@ -23,6 +23,7 @@
 
 #include <gtest/gtest.h>
 #include <boost/thread.hpp>
+#include <numeric>
 
 
 #include "SurgSim/Framework/BasicThread.h"
@@ -33,6 +34,35 @@ namespace SurgSim
 namespace Framework
 {
 
+namespace
+{
+/// Thread whose updates take longer than its period
+class SlowThread : public BasicThread
+{
+public:
+	SlowThread() : BasicThread("SlowThread")
+	{
+	}
+
+private:
+	bool doInitialize() override
+	{
+		return true;
+	}
+
+	bool doStartUp() override
+	{
+		return true;
+	}
+
+	bool doUpdate(double dt) override
+	{
+		boost::this_thread::sleep(boost::posix_time::milliseconds(15));
+		return true;
+	}
+};
+}
+
 TEST(BasicThreadTest, Instantiation)
 {
 	MockThread m;
@@ -153,6 +183,98 @@ TEST(BasicThreadTest, SynchronousThread)
 	m.stop();
 }
 
+TEST(BasicThreadTest, SynchronousSchedule)
+{
+	MockThread m(10);
+	EXPECT_THROW(m.setSynchronousSchedule(0, 0), SurgSim::Framework::AssertionFailure);
+	EXPECT_THROW(m.setSynchronousSchedule(2, 2), SurgSim::Framework::AssertionFailure);
+
+	// Update on every second step, starting with the second one
+	m.setSynchronousSchedule(2, 1);
+	std::shared_ptr<Barrier> barrier = std::make_shared<Barrier>(2);
+	m.start(barrier, true);
+
+	barrier->wait(true);
+	barrier->wait(true);
+	barrier->wait(true);
+	boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+	EXPECT_EQ(10, m.count);
+
+	barrier->wait(true);
+	boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+	EXPECT_EQ(9, m.count);
+
+	barrier->wait(true);
+	boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+	EXPECT_EQ(9, m.count);
+
+	barrier->wait(true);
+	boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+	EXPECT_EQ(8, m.count);
+
+	barrier->wait(false);
+	boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+	m.stop();
+}
+
+TEST(BasicThreadTest, SchedulingConfiguration)
+{
+	MockThread m(-1);
+	EXPECT_TRUE(m.getCpuAffinity().empty());
+	EXPECT_EQ(0, m.getRealTimePriority());
+	EXPECT_DOUBLE_EQ(0.0, m.getBusyWaitTime());
+
+	m.setCpuAffinity(std::vector<size_t>(1, 0));
+	EXPECT_EQ(std::vector<size_t>(1, 0), m.getCpuAffinity());
+	EXPECT_THROW(m.setRealTimePriority(-1), SurgSim::Framework::AssertionFailure);
+	EXPECT_THROW(m.setRealTimePriority(100), SurgSim::Framework::AssertionFailure);
+	m.setRealTimePriority(10);
+	EXPECT_EQ(10, m.getRealTimePriority());
+	m.setRealTimePriority(0);
+	EXPECT_THROW(m.setBusyWaitTime(-1.0), SurgSim::Framework::AssertionFailure);
+	m.setBusyWaitTime(0.001);
+	EXPECT_DOUBLE_EQ(0.001, m.getBusyWaitTime());
+
+	m.setRate(100.0);
+	m.start();
+	boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+	m.stop();
+	EXPECT_GT(0, m.count);
+
+	// The cpus that can't be in a cpu set are ignored
+	MockThread outOfRange(-1);
+	outOfRange.setCpuAffinity(std::vector<size_t>(1, 1u << 20));
+	outOfRange.setRate(100.0);
+	outOfRange.start();
+	boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+	outOfRange.stop();
+	EXPECT_GT(0, outOfRange.count);
+}
+
+TEST(BasicThreadTest, Overruns)
+{
+	SlowThread thread;
+	EXPECT_EQ(0u, thread.getOverrunCount());
+	ASSERT_EQ(BasicThread::OverrunHistogramSize, thread.getOverrunHistogram().size());
+
+	thread.setRate(100.0);
+	thread.start();
+	boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+	thread.stop();
+
+	// Each update overruns by about half the period
+	const size_t count = thread.getOverrunCount();
+	EXPECT_LT(0u, count);
+	auto histogram = thread.getOverrunHistogram();
+	EXPECT_EQ(count, std::accumulate(histogram.begin(), histogram.end(), static_cast<size_t>(0)));
+	EXPECT_EQ(0u, histogram[0]);
+
+	thread.resetOverruns();
+	EXPECT_EQ(0u, thread.getOverrunCount());
+	histogram = thread.getOverrunHistogram();
+	EXPECT_EQ(0u, std::accumulate(histogram.begin(), histogram.end(), static_cast<size_t>(0)));
+}
+
 TEST(BasicThreadTest, PauseResumeUpdateTest)
 {
 	MockThread m(100000000);
@@ -15,6 +15,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "boost/thread/thread.hpp"
 
 #include "SurgSim/Framework/BehaviorManager.h"
@@ -25,6 +29,59 @@ using SurgSim::Framework::Runtime;
 using SurgSim::Framework::Scene;
 using SurgSim::Framework::SceneElement;
 
+namespace
+{
+
+/// Behavior logging its updates, that can declare its accesses
+class AccessBehavior : public SurgSim::Framework::Behavior
+{
+public:
+	AccessBehavior(const std::string& name, std::vector<std::string>* log, boost::mutex* mutex) :
+		Behavior(name),
+		isDeclared(true),
+		m_log(log),
+		m_mutex(mutex)
+	{
+	}
+
+	bool doInitialize() override
+	{
+		return true;
+	}
+
+	bool doWakeUp() override
+	{
+		return true;
+	}
+
+	void update(double dt) override
+	{
+		boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+		boost::lock_guard<boost::mutex> lock(*m_mutex);
+		m_log->push_back(getName());
+		threadId = boost::this_thread::get_id();
+	}
+
+	bool getDeclaredAccesses(std::vector<const SurgSim::Framework::Component*>* outReads,
+							 std::vector<const SurgSim::Framework::Component*>* outWrites) const override
+	{
+		outReads->insert(outReads->end(), reads.begin(), reads.end());
+		outWrites->insert(outWrites->end(), writes.begin(), writes.end());
+		return isDeclared;
+	}
+
+	bool isDeclared;
+	std::vector<const SurgSim::Framework::Component*> reads;
+	std::vector<const SurgSim::Framework::Component*> writes;
+	boost::thread::id threadId;
+
+private:
+	std::vector<std::string>* m_log;
+	boost::mutex* m_mutex;
+};
+
+}
+
 TEST(BehaviorManagerTest, BehaviorInitTest)
 {
 	std::shared_ptr<Runtime> runtime(new Runtime());
@@ -93,3 +150,62 @@ TEST(BehaviorManagerTest, UpdateTest)
 
 	runtime->stop();
 }
+
+TEST(BehaviorManagerTest, ParallelUpdateTest)
+{
+	auto runtime = std::make_shared<Runtime>();
+	auto behaviorManager = std::make_shared<BehaviorManager>();
+	runtime->addManager(behaviorManager);
+	runtime->setLockstepRate(behaviorManager, 100.0);
+
+	auto element = std::make_shared<MockSceneElement>();
+	auto component1 = std::make_shared<MockComponent>("Component1");
+	auto component2 = std::make_shared<MockComponent>("Component2");
+	element->addComponent(component1);
+	element->addComponent(component2);
+
+	std::vector<std::string> log;
+	boost::mutex mutex;
+	std::vector<std::shared_ptr<AccessBehavior>> behaviors;
+	std::vector<std::shared_ptr<SceneElement>> elements;
+	for (int i = 0; i < 6; ++i)
+	{
+		// One element per behavior, to keep the order of the behaviors
+		behaviors.push_back(std::make_shared<AccessBehavior>(std::to_string(i), &log, &mutex));
+		elements.push_back(std::make_shared<MockSceneElement>("Element" + std::to_string(i)));
+		elements.back()->addComponent(behaviors.back());
+	}
+	// 0 and 1 write to different components, 2 reads what 0 writes, 3 doesn't declare its accesses, 4 and 5 read
+	// the same component
+	behaviors[0]->writes.push_back(component1.get());
+	behaviors[1]->writes.push_back(component2.get());
+	behaviors[2]->reads.push_back(component1.get());
+	behaviors[3]->isDeclared = false;
+	behaviors[4]->reads.push_back(component2.get());
+	behaviors[5]->reads.push_back(component2.get());
+	runtime->getScene()->addSceneElement(element);
+	for (const auto& behaviorElement : elements)
+	{
+		runtime->getScene()->addSceneElement(behaviorElement);
+	}
+
+	ASSERT_TRUE(runtime->startLockstep());
+	runtime->advanceLockstep(0.01);
+	runtime->stop();
+
+	ASSERT_EQ(6u, log.size());
+	auto position = [&log](const std::string& name)
+	{
+		return std::find(log.begin(), log.end(), name) - log.begin();
+	};
+	EXPECT_GT(position("2"), position("0"));
+	EXPECT_EQ(3, position("3"));
+	EXPECT_LT(3, position("4"));
+	EXPECT_LT(3, position("5"));
+
+	// The behaviors that don't declare their accesses are updated on the manager thread
+	EXPECT_NE(behaviors[3]->threadId, behaviors[0]->threadId);
+	EXPECT_NE(behaviors[3]->threadId, behaviors[1]->threadId);
+	EXPECT_NE(behaviors[3]->threadId, behaviors[4]->threadId);
+	EXPECT_NE(behaviors[3]->threadId, behaviors[5]->threadId);
+}
@@ -20,11 +20,18 @@
 #include "SurgSim/Framework/Log.h"
 
 #include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <string>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
 
+using SurgSim::Framework::AsyncOutput;
 using SurgSim::Framework::Logger;
 using SurgSim::Framework::FileOutput;
 
@@ -345,3 +352,190 @@ TEST_F(FileOutputTest, Write)
 
 	EXPECT_EQ("TestMessage",message);
 }
+
+namespace
+{
+
+/// Output that keeps all the messages, writing can be held up to fill the buffer of an AsyncOutput
+class CollectingOutput : public SurgSim::Framework::LogOutput
+{
+public:
+	CollectingOutput() : isBlocked(false)
+	{
+	}
+
+	bool writeMessage(const std::string& message) override
+	{
+		while (isBlocked)
+		{
+			boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+		}
+		boost::lock_guard<boost::mutex> lock(mutex);
+		messages.push_back(message);
+		return true;
+	}
+
+	std::atomic<bool> isBlocked;
+	boost::mutex mutex;
+	std::vector<std::string> messages;
+};
+
+}
+
+TEST(AsyncOutputTest, Constructor)
+{
+	auto output = std::make_shared<CollectingOutput>();
+	EXPECT_ANY_THROW(AsyncOutput(output, 0));
+	EXPECT_ANY_THROW(AsyncOutput(output, 1000));
+	EXPECT_ANY_THROW(AsyncOutput(nullptr, 1024));
+
+	AsyncOutput asyncOutput(output, 1024);
+	EXPECT_EQ(1024u, asyncOutput.getCapacity());
+	EXPECT_EQ(0u, asyncOutput.getDroppedMessageCount());
+	EXPECT_EQ(0u, asyncOutput.getFailedMessageCount());
+	EXPECT_EQ(0u, asyncOutput.getTruncatedMessageCount());
+}
+
+TEST(AsyncOutputTest, ConcurrentWrite)
+{
+	const size_t numThreads = 4;
+	const size_t numMessages = 200;
+	auto output = std::make_shared<CollectingOutput>();
+	AsyncOutput asyncOutput(output, 2048);
+
+	std::vector<boost::thread> threads;
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		threads.emplace_back([&asyncOutput, i, numMessages]()
+		{
+			for (size_t j = 0; j < numMessages; ++j)
+			{
+				EXPECT_TRUE(asyncOutput.writeMessage(std::to_string(i) + " " + std::to_string(j)));
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	asyncOutput.flush();
+
+	ASSERT_EQ(numThreads * numMessages, output->messages.size());
+	EXPECT_EQ(0u, asyncOutput.getDroppedMessageCount());
+
+	// Messages from one thread keep their order
+	std::vector<size_t> next(numThreads, 0);
+	for (const auto& message : output->messages)
+	{
+		std::stringstream stream(message);
+		size_t thread, index;
+		stream >> thread >> index;
+		ASSERT_LT(thread, numThreads);
+		EXPECT_EQ(next[thread]++, index);
+	}
+}
+
+TEST(AsyncOutputTest, DropWhenFull)
+{
+	auto output = std::make_shared<CollectingOutput>();
+	{
+		AsyncOutput asyncOutput(output, 4);
+
+		// The writer thread polls the buffer, takes the first message and then blocks in the output
+		output->isBlocked = true;
+		EXPECT_TRUE(asyncOutput.writeMessage("Blocking"));
+		boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+
+		for (int i = 0; i < 4; ++i)
+		{
+			EXPECT_TRUE(asyncOutput.writeMessage("Queued"));
+		}
+		EXPECT_FALSE(asyncOutput.writeMessage("Dropped"));
+		EXPECT_FALSE(asyncOutput.writeMessage("Dropped"));
+		EXPECT_EQ(2u, asyncOutput.getDroppedMessageCount());
+
+		output->isBlocked = false;
+		asyncOutput.flush();
+		EXPECT_EQ(5u, std::count_if(output->messages.begin(), output->messages.end(),
+			[](const std::string& message) {return message == "Blocking" || message == "Queued";}));
+
+		EXPECT_TRUE(asyncOutput.writeMessage("AfterDrop"));
+	}
+
+	// The drop is reported and the destructor writes out the remaining messages
+	ASSERT_FALSE(output->messages.empty());
+	EXPECT_EQ("AfterDrop", output->messages.back());
+	EXPECT_EQ(1u, std::count_if(output->messages.begin(), output->messages.end(),
+		[](const std::string& message) {return isContained("dropped 2 messages", message);}));
+}
+
+namespace
+{
+
+/// Output that fails to write every other message
+class FailingOutput : public SurgSim::Framework::LogOutput
+{
+public:
+	FailingOutput() : count(0)
+	{
+	}
+
+	bool writeMessage(const std::string& message) override
+	{
+		++count;
+		if (count % 4 == 0)
+		{
+			throw std::runtime_error("Failing output");
+		}
+		return (count % 2 == 0);
+	}
+
+	size_t count;
+};
+
+}
+
+TEST(AsyncOutputTest, FailingOutput)
+{
+	auto output = std::make_shared<FailingOutput>();
+	AsyncOutput asyncOutput(output, 16);
+	for (int i = 0; i < 8; ++i)
+	{
+		EXPECT_TRUE(asyncOutput.writeMessage("Message"));
+	}
+	asyncOutput.flush();
+
+	// The failures of the wrapped output are not counted as drops of the buffer
+	EXPECT_EQ(0u, asyncOutput.getDroppedMessageCount());
+	EXPECT_EQ(6u, asyncOutput.getFailedMessageCount());
+}
+
+TEST(AsyncOutputTest, Truncate)
+{
+	auto output = std::make_shared<CollectingOutput>();
+	AsyncOutput asyncOutput(output, 16);
+	const std::string longMessage(AsyncOutput::MaxMessageLength + 10, 'a');
+	const std::string maxMessage(AsyncOutput::MaxMessageLength, 'b');
+	EXPECT_TRUE(asyncOutput.writeMessage(longMessage));
+	EXPECT_TRUE(asyncOutput.writeMessage(maxMessage));
+	asyncOutput.flush();
+
+	ASSERT_EQ(2u, output->messages.size());
+	EXPECT_EQ(longMessage.substr(0, AsyncOutput::MaxMessageLength - 3) + "...", output->messages[0]);
+	EXPECT_EQ(maxMessage, output->messages[1]);
+	EXPECT_EQ(1u, asyncOutput.getTruncatedMessageCount());
+}
+
+TEST(AsyncOutputTest, LoggerIntegration)
+{
+	auto output = std::make_shared<CollectingOutput>();
+	auto asyncOutput = std::make_shared<AsyncOutput>(output);
+	auto logger = Logger::getLogger("AsyncTestLogger");
+	logger->setOutput(asyncOutput);
+
+	SURGSIM_LOG_WARNING(logger) << "Asynchronous message";
+	asyncOutput->flush();
+
+	ASSERT_EQ(1u, output->messages.size());
+	EXPECT_TRUE(isContained("Asynchronous message", output->messages[0]));
+}
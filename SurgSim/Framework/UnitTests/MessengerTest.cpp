@@ -16,6 +16,7 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <boost/thread.hpp>
 
 #include "SurgSim/Framework/BasicSceneElement.h"
 #include "SurgSim/Framework/Messenger.h"
@@ -293,7 +294,81 @@ TEST_F(MessengerTest, LifeTime)
 	ASSERT_NO_THROW(messenger.update());
 }
 
+namespace
+{
+struct Score
+{
+	int points;
+	double value;
+};
+}
+
+TEST_F(MessengerTest, ChannelRegistration)
+{
+	Messenger::Channel<Score> invalid;
+	EXPECT_FALSE(invalid.isValid());
+	EXPECT_ANY_THROW(messenger.publish(invalid, Score()));
+
+	auto channel = messenger.registerChannel<Score>("score");
+	EXPECT_TRUE(channel.isValid());
+	EXPECT_EQ("score", channel.getName());
+
+	auto other = messenger.registerChannel<int>("other");
+	EXPECT_NE(channel.getId(), other.getId());
+
+	// Registering again returns the same channel, with the same type only
+	EXPECT_EQ(channel.getId(), messenger.registerChannel<Score>("score").getId());
+	EXPECT_ANY_THROW(messenger.registerChannel<int>("score"));
+}
+
+TEST_F(MessengerTest, ChannelMessages)
+{
+	auto channel = messenger.registerChannel<Score>("score", 16);
 
+	int count = 0;
+	int points = 0;
+	EXPECT_ANY_THROW(messenger.subscribe<Score>(channel, receiver1, nullptr));
+	messenger.subscribe<Score>(channel, receiver1, [&count, &points](const Messenger::ChannelEvent<Score>& event)
+	{
+		++count;
+		points += event.data.points;
+	});
+
+	// The string subscribers receive the events of the channel with the same name
+	EXPECT_CALL(*receiver2, onEventA(::testing::Field(&Messenger::Event::name, ::testing::Eq("score"))))
+	.Times(::testing::Exactly(4000));
+	messenger.subscribe("score", receiver2, std::bind(&MockReceiver::onEventA, receiver2.get(), std::placeholders::_1));
+
+	// Publish from several threads at once, the queue grows beyond its initial capacity
+	std::vector<std::shared_ptr<boost::thread>> threads;
+	for (int i = 0; i < 4; ++i)
+	{
+		threads.push_back(std::make_shared<boost::thread>([this, channel]()
+		{
+			for (int j = 0; j < 1000; ++j)
+			{
+				Score score = {1, 0.5};
+				messenger.publish(channel, score);
+			}
+		}));
+	}
+	for (auto& thread : threads)
+	{
+		thread->join();
+	}
+	EXPECT_EQ(0, count);
+
+	messenger.update();
+	EXPECT_EQ(4000, count);
+	EXPECT_EQ(4000, points);
+
+	// Unsubscribing removes the channel subscriptions too
+	messenger.unsubscribe(receiver1);
+	messenger.publish(channel, Score());
+	messenger.unsubscribe(receiver2);
+	messenger.update();
+	EXPECT_EQ(4000, count);
+}
 
 }
 }
\ No newline at end of file
@@ -14,14 +14,18 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
 #include "SurgSim/Framework/Runtime.h"
 #include "SurgSim/Framework/Scene.h"
 #include "SurgSim/Framework/SceneElement.h"
+#include "SurgSim/Framework/Timer.h"
 #include "MockObjects.h"  //NOLINT
 
 using SurgSim::Framework::Runtime;
 using SurgSim::Framework::Scene;
 using SurgSim::Framework::Logger;
+using SurgSim::Framework::Timer;
 
 TEST(RuntimeTest, Constructor)
 {
@@ -200,6 +204,96 @@ TEST(RuntimeTest, PauseResume)
 	runtime->stop();
 }
 
+TEST(RuntimeTest, Lockstep)
+{
+	auto runtime = std::make_shared<Runtime>();
+	auto physics = std::make_shared<MockManager>();
+	auto behavior = std::make_shared<MockManager>();
+	auto graphics = std::make_shared<MockManager>();
+	auto other = std::make_shared<MockManager>();
+	physics->setRate(1000.0);
+	behavior->setRate(100.0);
+	graphics->setRate(60.0);
+	other->setRate(300.0);
+
+	runtime->addManager(graphics);
+	runtime->addManager(physics);
+	runtime->addManager(behavior);
+	runtime->addManager(other);
+	runtime->setLockstepRate(graphics, 0.0);
+	EXPECT_THROW(runtime->setLockstepRate(graphics, -1.0), SurgSim::Framework::AssertionFailure);
+
+	ASSERT_TRUE(runtime->startLockstep());
+	EXPECT_TRUE(runtime->isLockstep());
+	EXPECT_TRUE(runtime->isRunning());
+	EXPECT_THROW(runtime->setLockstepRate(graphics, 1.0), SurgSim::Framework::AssertionFailure);
+
+	// The rates are adjusted to be integer ratios of the fastest one
+	EXPECT_DOUBLE_EQ(1000.0, physics->getRate());
+	EXPECT_DOUBLE_EQ(100.0, behavior->getRate());
+	EXPECT_DOUBLE_EQ(1000.0 / 3.0, other->getRate());
+
+	runtime->advanceLockstep(0.1);
+	EXPECT_NEAR(0.1, runtime->getLockstepTime(), 1e-12);
+	EXPECT_EQ(100, physics->count);
+	EXPECT_EQ(10, behavior->count);
+	EXPECT_EQ(34, other->count);
+	EXPECT_EQ(0, graphics->count);
+
+	// Runs faster than real-time
+	Timer timer;
+	timer.start();
+	runtime->advanceLockstep(9.9);
+	timer.endFrame();
+	EXPECT_NEAR(10.0, runtime->getLockstepTime(), 1e-9);
+	EXPECT_LT(timer.getCumulativeTime(), 10.0);
+	EXPECT_EQ(10000, physics->count);
+	EXPECT_EQ(1000, behavior->count);
+	EXPECT_EQ(0, graphics->count);
+
+	EXPECT_TRUE(runtime->stop());
+	EXPECT_FALSE(runtime->isRunning());
+	EXPECT_TRUE(physics->didBeforeStop);
+	EXPECT_TRUE(graphics->didBeforeStop);
+}
+
+TEST(RuntimeTest, ExecuteLockstep)
+{
+	auto runtime = std::make_shared<Runtime>();
+	auto manager = std::make_shared<MockManager>();
+	manager->setRate(100.0);
+	runtime->addManager(manager);
+
+	EXPECT_TRUE(runtime->executeLockstep(1.0));
+	EXPECT_EQ(100, manager->count);
+	EXPECT_FALSE(runtime->isRunning());
+}
+
+TEST(RuntimeTest, ConfigureManagers)
+{
+	auto runtime = std::make_shared<Runtime>();
+	auto manager = std::make_shared<MockManager>();
+	runtime->addManager(manager);
+
+	YAML::Node node = YAML::Load("{" + manager->getName() + ": "
+								 "{Rate: 500.0, CpuAffinity: [0], RealTimePriority: 0, BusyWaitTime: 0.0001}}");
+	ASSERT_NO_THROW(runtime->configureManagers(node));
+	EXPECT_DOUBLE_EQ(500.0, manager->getRate());
+	EXPECT_EQ(std::vector<size_t>(1, 0), manager->getCpuAffinity());
+	EXPECT_EQ(0, manager->getRealTimePriority());
+	EXPECT_DOUBLE_EQ(0.0001, manager->getBusyWaitTime());
+
+	EXPECT_ANY_THROW(runtime->configureManagers(YAML::Load("{Unknown Manager: {Rate: 10.0}}")));
+	EXPECT_ANY_THROW(runtime->configureManagers(YAML::Load("[1, 2]")));
+	EXPECT_ANY_THROW(runtime->loadManagerConfiguration("Nonexistent.yaml"));
+
+	runtime->start();
+	boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+	EXPECT_ANY_THROW(runtime->configureManagers(node));
+	runtime->stop();
+	EXPECT_LT(0, manager->count);
+}
+
 TEST(RuntimeTest, AddComponentAddDuringRuntime)
 {
 	std::shared_ptr<Runtime> runtime = std::make_shared<Runtime>();
@@ -274,6 +368,48 @@ TEST(RuntimeTest, LoadAndAddScene)
 	EXPECT_EQ(4u, scene2->getSceneElements().size());
 }
 
+TEST(RuntimeTest, LoadSceneAsync)
+{
+	auto runtime = std::make_shared<Runtime>("config.txt");
+	auto manager = std::make_shared<MockManager>();
+	runtime->addManager(manager);
+
+	std::vector<size_t> progress;
+	boost::mutex mutex;
+	runtime->setLoadingProgressCallback([&progress, &mutex](size_t loaded, size_t total)
+	{
+		boost::lock_guard<boost::mutex> lock(mutex);
+		progress.push_back(loaded);
+		EXPECT_EQ(2u, total);
+	});
+
+	ASSERT_NO_THROW(runtime->loadSceneAsync("SceneTestData/scene.yaml"));
+	EXPECT_ANY_THROW(runtime->loadSceneAsync("SceneTestData/scene.yaml"));
+
+	// start() waits for the scene, all the components are handed to the managers
+	ASSERT_TRUE(runtime->start());
+	EXPECT_FALSE(runtime->isLoading());
+	EXPECT_DOUBLE_EQ(1.0, runtime->getLoadingProgress());
+	EXPECT_EQ(std::vector<size_t>({1, 2}), progress);
+	ASSERT_EQ(2u, runtime->getScene()->getSceneElements().size());
+	for (const auto& element : runtime->getScene()->getSceneElements())
+	{
+		auto components = element->getComponents<MockComponent>();
+		ASSERT_EQ(1u, components.size());
+		EXPECT_TRUE(components[0]->isAwake()) << components[0]->getFullName();
+	}
+	runtime->stop();
+}
+
+TEST(RuntimeTest, LoadSceneAsyncFailure)
+{
+	auto runtime = std::make_shared<Runtime>("config.txt");
+	ASSERT_NO_THROW(runtime->loadSceneAsync("SceneTestData/bad.yaml"));
+	EXPECT_ANY_THROW(runtime->waitForLoading());
+	EXPECT_FALSE(runtime->isLoading());
+	EXPECT_NO_THROW(runtime->waitForLoading());
+}
+
 TEST(RuntimeTest, LoadAndDuplicate)
 {
 	auto runtime = std::make_shared<Runtime>("config.txt");
@@ -15,11 +15,16 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <future>
+
 #include "SurgSim/Framework/Runtime.h"
 #include "SurgSim/Framework/Scene.h"
 #include "SurgSim/Framework/SceneElement.h"
 #include "SurgSim/Framework/BasicSceneElement.h"
 #include "SurgSim/Framework/FrameworkConvert.h"
+#include "SurgSim/Framework/ThreadPool.h"
 #include "SurgSim/Framework/UnitTests/MockObjects.h"
 #include "SurgSim/Testing/Utilities.h"
 
@@ -184,6 +189,99 @@ TEST(SceneTest, LoadSceneTest)
 	EXPECT_TRUE(component->isLocalActive());
 }
 
+TEST(SceneTest, DecodeSceneElements)
+{
+	auto runtime = std::make_shared<Runtime>("config.txt");
+	YAML::convert<std::shared_ptr<Component>>::getRegistry().clear();
+
+	// element0 and element2 share a component and have to be decoded in order, element1 is independent
+	std::string yaml =
+		"- SurgSim::Framework::BasicSceneElement:\n"
+		"    Name: element0\n"
+		"    Components:\n"
+		"      - MockComponent: {Name: shared, Id: 0b9eb4a5-4d3a-4bd2-9d80-1e8b1bd5f5d3}\n"
+		"- SurgSim::Framework::BasicSceneElement:\n"
+		"    Name: element1\n"
+		"    Components:\n"
+		"      - MockComponent: {Name: single, Id: 3c4e5d6a-6f56-4c1e-8f0c-2d6e1bb0b7a1}\n"
+		"- SurgSim::Framework::BasicSceneElement:\n"
+		"    Name: element2\n"
+		"    Components:\n"
+		"      - MockComponent: {Name: shared, Id: 0b9eb4a5-4d3a-4bd2-9d80-1e8b1bd5f5d3}\n";
+
+	std::atomic<size_t> calls(0);
+	std::atomic<size_t> total(0);
+	std::vector<std::shared_ptr<SceneElement>> elements;
+	ASSERT_NO_THROW(decodeSceneElements(YAML::Load(yaml), &elements, [&calls, &total](size_t, size_t count)
+	{
+		++calls;
+		total = count;
+	}));
+
+	ASSERT_EQ(3u, elements.size());
+	EXPECT_EQ("element0", elements[0]->getName());
+	EXPECT_EQ("element1", elements[1]->getName());
+	EXPECT_EQ("element2", elements[2]->getName());
+	EXPECT_EQ(3u, calls);
+	EXPECT_EQ(3u, total);
+
+	ASSERT_NE(nullptr, elements[0]->getComponent("shared"));
+	EXPECT_EQ(elements[0]->getComponent("shared"), elements[2]->getComponent("shared"));
+	EXPECT_NE(nullptr, elements[1]->getComponent("single"));
+
+	std::string bad =
+		"- SurgSim::Framework::BasicSceneElement:\n"
+		"    Name: element0\n"
+		"- SurgSim::Framework::BasicSceneElement:\n"
+		"    Name: element1\n"
+		"    Components:\n"
+		"      - NotAComponent: {Name: component}\n";
+	elements.clear();
+	EXPECT_ANY_THROW(decodeSceneElements(YAML::Load(bad), &elements));
+	EXPECT_TRUE(elements.empty());
+}
+
+TEST(SceneTest, DecodeFromThreadPool)
+{
+	auto runtime = std::make_shared<Runtime>("config.txt");
+	YAML::convert<std::shared_ptr<Component>>::getRegistry().clear();
+
+	std::string yaml =
+		"SurgSim::Framework::Scene:\n"
+		"  SceneElements:\n"
+		"    - SurgSim::Framework::BasicSceneElement:\n"
+		"        Name: element0\n"
+		"        Components:\n"
+		"          - MockComponent: {Name: component0, Id: 6d2c1f0e-8a43-4b7e-9c15-3f1a2b4c5d60}\n"
+		"    - SurgSim::Framework::BasicSceneElement:\n"
+		"        Name: element1\n"
+		"        Components:\n"
+		"          - MockComponent: {Name: component1, Id: 6d2c1f0e-8a43-4b7e-9c15-3f1a2b4c5d61}\n"
+		"    - SurgSim::Framework::BasicSceneElement:\n"
+		"        Name: element2\n"
+		"        Components:\n"
+		"          - MockComponent: {Name: component2, Id: 6d2c1f0e-8a43-4b7e-9c15-3f1a2b4c5d62}\n";
+
+	std::vector<std::pair<size_t, size_t>> progress;
+	runtime->setLoadingProgressCallback([&progress](size_t loaded, size_t total)
+	{
+		progress.emplace_back(loaded, total);
+	});
+
+	// A thread of the ThreadPool decodes all the scene elements itself, instead of waiting on the ThreadPool
+	auto scene = std::make_shared<Scene>(runtime);
+	auto node = YAML::Load(yaml);
+	auto task = Runtime::getThreadPool()->enqueue<bool>([&scene, &node]() {return scene->decode(node);});
+	ASSERT_EQ(std::future_status::ready, task.wait_for(std::chrono::seconds(10)));
+	EXPECT_TRUE(task.get());
+
+	ASSERT_EQ(3u, scene->getSceneElements().size());
+	EXPECT_EQ("element0", scene->getSceneElements()[0]->getName());
+	EXPECT_EQ("element2", scene->getSceneElements()[2]->getName());
+	ASSERT_EQ(3u, progress.size());
+	EXPECT_EQ(std::make_pair(size_t(3), size_t(3)), progress.back());
+}
+
 TEST(SceneTest, SceneElementGroups)
 {
 
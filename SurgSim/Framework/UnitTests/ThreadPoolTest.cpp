@@ -75,5 +75,17 @@ TEST(ThreadPoolTest, AddLotsOfTasks)
 	EXPECT_EQ(expectedTotal, total);
 }
 
+TEST(ThreadPoolTest, IsWorkerThread)
+{
+	ThreadPool pool(2);
+	EXPECT_FALSE(pool.isWorkerThread());
+
+	ThreadPool other(1);
+	std::future<bool> result = pool.enqueue<bool>([&pool]() { return pool.isWorkerThread(); });
+	std::future<bool> otherResult = pool.enqueue<bool>([&other]() { return other.isWorkerThread(); });
+	EXPECT_TRUE(result.get());
+	EXPECT_FALSE(otherResult.get());
+}
+
 };
 };
@@ -139,5 +139,11 @@ bool BoxShape::isValid() const
 	return (m_size.minCoeff() >= 0);
 }
 
+Vector3d BoxShape::getSupportPoint(const Vector3d& direction) const
+{
+	const Vector3d halfSize = 0.5 * m_size;
+	return (direction.array() >= 0.0).select(halfSize, -halfSize);
+}
+
 }; // namespace Math
 }; // namespace SurgSim
@@ -83,6 +83,8 @@ class BoxShape: public Shape
 	/// \return True if size along X, Y, Z are bigger than or equal to 0; Otherwise, false.
 	bool isValid() const override;
 
+	Vector3d getSupportPoint(const Vector3d& direction) const override;
+
 protected:
 	// Setters in 'protected' sections are for serialization purpose only.
 
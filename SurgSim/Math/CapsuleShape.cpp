@@ -124,6 +124,17 @@ bool CapsuleShape::isValid() const
 	return (m_length >= 0) && (m_radius >= 0);
 }
 
+Vector3d CapsuleShape::getSupportPoint(const Vector3d& direction) const
+{
+	Vector3d result((direction[1] >= 0.0) ? topCenter() : bottomCenter());
+	const double norm = direction.norm();
+	if (norm > 0.0)
+	{
+		result += direction * (m_radius / norm);
+	}
+	return result;
+}
+
 void CapsuleShape::updateAabb()
 {
 	m_aabb.setEmpty();
@@ -94,5 +94,17 @@ bool CylinderShape::isValid() const
 	return (m_length >= 0) && (m_radius >= 0);
 }
 
+Vector3d CylinderShape::getSupportPoint(const Vector3d& direction) const
+{
+	Vector3d result(0.0, (direction[1] >= 0.0) ? 0.5 * m_length : -0.5 * m_length, 0.0);
+	const double radialNorm = std::sqrt(direction[0] * direction[0] + direction[2] * direction[2]);
+	if (radialNorm > 0.0)
+	{
+		result[0] = direction[0] * m_radius / radialNorm;
+		result[2] = direction[2] * m_radius / radialNorm;
+	}
+	return result;
+}
+
 }; // namespace Math
 }; // namespace SurgSim
@@ -65,6 +65,8 @@ class CylinderShape: public Shape
 	/// \return True if length and radius are bigger than or equal to 0; Otherwise, false.
 	bool isValid() const override;
 
+	Vector3d getSupportPoint(const Vector3d& direction) const override;
+
 protected:
 	// Setters in 'protected' sections are for serialization purpose only.
 
@@ -0,0 +1,625 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Math/GjkEpa.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "SurgSim/Math/Geometry.h"
+#include "SurgSim/Math/Matrix.h"
+#include "SurgSim/Math/Shape.h"
+
+namespace
+{
+/// The maximum number of iterations of GJK
+const size_t maxGjkIterations = 64;
+
+/// The maximum number of iterations of EPA
+const size_t maxEpaIterations = 128;
+
+/// The distance under which the shapes are considered in contact
+const double epsilon = SurgSim::Math::Geometry::DistanceEpsilon;
+
+/// The relative tolerance on the distance for GJK to converge
+const double gjkTolerance = 1e-8;
+
+/// The relative tolerance on the depth for EPA to converge, curved shapes needing many iterations to converge
+const double epaTolerance = 1e-4;
+}
+
+namespace SurgSim
+{
+namespace Math
+{
+
+namespace
+{
+
+/// A vertex of the Minkowski difference, with the points of the shapes it comes from
+struct Vertex
+{
+	/// The vertex, in world coordinates
+	Vector3d point;
+	/// The point of the first shape, in its local frame
+	Vector3d localPoint1;
+	/// The point of the second shape, in its local frame
+	Vector3d localPoint2;
+};
+
+/// The Minkowski difference of two posed shapes, shape1 - shape2
+class MinkowskiDifference
+{
+public:
+	MinkowskiDifference(const Shape& shape1, const RigidTransform3d& pose1,
+						const Shape& shape2, const RigidTransform3d& pose2) :
+		m_shape1(shape1), m_pose1(pose1), m_shape2(shape2), m_pose2(pose2)
+	{
+	}
+
+	/// \return The vertex of the Minkowski difference furthest along a direction
+	Vertex getSupport(const Vector3d& direction) const
+	{
+		return getVertex(m_shape1.getSupportPoint(m_pose1.linear().transpose() * direction),
+						 m_shape2.getSupportPoint(-(m_pose2.linear().transpose() * direction)));
+	}
+
+	/// \return The vertex of the Minkowski difference corresponding to two local points
+	Vertex getVertex(const Vector3d& localPoint1, const Vector3d& localPoint2) const
+	{
+		Vertex vertex;
+		vertex.localPoint1 = localPoint1;
+		vertex.localPoint2 = localPoint2;
+		vertex.point = m_pose1 * localPoint1 - m_pose2 * localPoint2;
+		return vertex;
+	}
+
+private:
+	const Shape& m_shape1;
+	const RigidTransform3d& m_pose1;
+	const Shape& m_shape2;
+	const RigidTransform3d& m_pose2;
+};
+
+/// \return The barycentric coordinate along ab of the closest point to the origin
+double closestOnSegment(const Vector3d& a, const Vector3d& b)
+{
+	const Vector3d ab = b - a;
+	const double squaredLength = ab.squaredNorm();
+	if (squaredLength <= epsilon * epsilon)
+	{
+		return 0.0;
+	}
+	return std::min(std::max(-a.dot(ab) / squaredLength, 0.0), 1.0);
+}
+
+/// \return The barycentric coordinates of the closest point to the origin on the triangle abc, the coordinates of
+/// the vertices not supporting this point being exactly 0
+Vector3d closestOnTriangle(const Vector3d& a, const Vector3d& b, const Vector3d& c)
+{
+	// Voronoi regions of the triangle, see Ericson, Real-Time Collision Detection, 5.1.5
+	const Vector3d ab = b - a;
+	const Vector3d ac = c - a;
+	const double d1 = -ab.dot(a);
+	const double d2 = -ac.dot(a);
+	if (d1 <= 0.0 && d2 <= 0.0)
+	{
+		return Vector3d(1.0, 0.0, 0.0);
+	}
+
+	const double d3 = -ab.dot(b);
+	const double d4 = -ac.dot(b);
+	if (d3 >= 0.0 && d4 <= d3)
+	{
+		return Vector3d(0.0, 1.0, 0.0);
+	}
+
+	const double vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0 && d1 - d3 > 0.0)
+	{
+		const double v = d1 / (d1 - d3);
+		return Vector3d(1.0 - v, v, 0.0);
+	}
+
+	const double d5 = -ab.dot(c);
+	const double d6 = -ac.dot(c);
+	if (d6 >= 0.0 && d5 <= d6)
+	{
+		return Vector3d(0.0, 0.0, 1.0);
+	}
+
+	const double vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0 && d2 - d6 > 0.0)
+	{
+		const double w = d2 / (d2 - d6);
+		return Vector3d(1.0 - w, 0.0, w);
+	}
+
+	const double va = d3 * d6 - d5 * d4;
+	if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0 && (d4 - d3) + (d5 - d6) > 0.0)
+	{
+		const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		return Vector3d(0.0, 1.0 - w, w);
+	}
+
+	const double sum = va + vb + vc;
+	if (sum > 0.0)
+	{
+		const double v = vb / sum;
+		const double w = vc / sum;
+		return Vector3d(1.0 - v - w, v, w);
+	}
+
+	// Degenerate triangle, take the closest of its edges
+	const std::array<double, 3> t = {{closestOnSegment(a, b), closestOnSegment(b, c), closestOnSegment(c, a)}};
+	const std::array<Vector3d, 3> coordinates = {{
+			Vector3d(1.0 - t[0], t[0], 0.0), Vector3d(0.0, 1.0 - t[1], t[1]), Vector3d(t[2], 0.0, 1.0 - t[2])
+		}
+	};
+	Vector3d best = coordinates[0];
+	double bestDistance = std::numeric_limits<double>::max();
+	for (const auto& coordinate : coordinates)
+	{
+		const double distance = (coordinate[0] * a + coordinate[1] * b + coordinate[2] * c).squaredNorm();
+		if (distance < bestDistance)
+		{
+			bestDistance = distance;
+			best = coordinate;
+		}
+	}
+	return best;
+}
+
+/// The 4 faces of a tetrahedron, each followed by its opposite vertex
+const std::array<std::array<size_t, 4>, 4> tetrahedronFaces = {{
+		{{0, 1, 2, 3}}, {{0, 3, 1, 2}}, {{0, 2, 3, 1}}, {{1, 3, 2, 0}}
+	}
+};
+
+/// \return The signed volume (times 6) of the tetrahedron abcd
+double tetrahedronVolume(const Vector3d& a, const Vector3d& b, const Vector3d& c, const Vector3d& d)
+{
+	return (b - a).cross(c - a).dot(d - a);
+}
+
+/// Find the closest point to the origin on a simplex, and reduce the simplex to the vertices supporting this point
+/// \param [in,out] simplex The simplex
+/// \param [out] closest The closest point to the origin
+/// \return true if the simplex is a tetrahedron containing the origin
+bool reduceSimplex(std::vector<Vertex>* simplex, Vector3d* closest)
+{
+	std::vector<Vertex>& vertices = *simplex;
+	std::array<double, 4> weights = {{1.0, 0.0, 0.0, 0.0}};
+	bool containsOrigin = false;
+
+	if (vertices.size() == 2)
+	{
+		const double t = closestOnSegment(vertices[0].point, vertices[1].point);
+		weights[0] = 1.0 - t;
+		weights[1] = t;
+	}
+	else if (vertices.size() == 3)
+	{
+		const Vector3d coordinates = closestOnTriangle(vertices[0].point, vertices[1].point, vertices[2].point);
+		std::copy(coordinates.data(), coordinates.data() + 3, weights.begin());
+	}
+	else if (vertices.size() == 4)
+	{
+		double scale = 0.0;
+		for (size_t i = 1; i < 4; ++i)
+		{
+			scale = std::max(scale, (vertices[i].point - vertices[0].point).norm());
+		}
+		const double volume = tetrahedronVolume(vertices[0].point, vertices[1].point, vertices[2].point,
+												vertices[3].point);
+		const bool isDegenerate = std::abs(volume) <= 1e-12 * scale * scale * scale;
+
+		double bestDistance = std::numeric_limits<double>::max();
+		bool isOutside = false;
+		for (const auto& face : tetrahedronFaces)
+		{
+			const Vector3d& a = vertices[face[0]].point;
+			const Vector3d& b = vertices[face[1]].point;
+			const Vector3d& c = vertices[face[2]].point;
+			const Vector3d normal = (b - a).cross(c - a);
+			if (isDegenerate || normal.dot(a) * normal.dot(vertices[face[3]].point - a) > 0.0)
+			{
+				// The origin is on the other side of the face than the opposite vertex
+				isOutside = true;
+				const Vector3d coordinates = closestOnTriangle(a, b, c);
+				const double distance = (coordinates[0] * a + coordinates[1] * b + coordinates[2] * c).squaredNorm();
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					weights.fill(0.0);
+					for (size_t i = 0; i < 3; ++i)
+					{
+						weights[face[i]] = coordinates[i];
+					}
+				}
+			}
+		}
+
+		if (!isOutside)
+		{
+			containsOrigin = true;
+			const Vector3d zero = Vector3d::Zero();
+			weights[0] = tetrahedronVolume(zero, vertices[1].point, vertices[2].point, vertices[3].point) / volume;
+			weights[1] = tetrahedronVolume(vertices[0].point, zero, vertices[2].point, vertices[3].point) / volume;
+			weights[2] = tetrahedronVolume(vertices[0].point, vertices[1].point, zero, vertices[3].point) / volume;
+			weights[3] = 1.0 - weights[0] - weights[1] - weights[2];
+		}
+	}
+
+	std::vector<Vertex> reduced;
+	closest->setZero();
+	for (size_t i = 0; i < vertices.size(); ++i)
+	{
+		if (weights[i] > 0.0 || containsOrigin)
+		{
+			reduced.push_back(vertices[i]);
+			*closest += weights[i] * vertices[i].point;
+		}
+	}
+	if (containsOrigin)
+	{
+		closest->setZero();
+	}
+	vertices.swap(reduced);
+	return containsOrigin;
+}
+
+/// \return The weights of the vertices of a simplex for a point on it
+std::vector<double> computeWeights(const std::vector<Vertex>& vertices, const Vector3d& point)
+{
+	std::vector<double> weights(vertices.size(), 0.0);
+	if (vertices.size() == 1)
+	{
+		weights[0] = 1.0;
+	}
+	else if (vertices.size() == 2)
+	{
+		const double t = closestOnSegment(vertices[0].point - point, vertices[1].point - point);
+		weights[0] = 1.0 - t;
+		weights[1] = t;
+	}
+	else if (vertices.size() >= 3)
+	{
+		const Vector3d coordinates = closestOnTriangle(vertices[0].point - point, vertices[1].point - point,
+									 vertices[2].point - point);
+		std::copy(coordinates.data(), coordinates.data() + 3, weights.begin());
+	}
+	return weights;
+}
+
+/// Run GJK on the Minkowski difference
+/// \param difference The Minkowski difference
+/// \param [in,out] simplex The simplex to start from, the final simplex
+/// \param [out] closest The closest point of the Minkowski difference to the origin
+/// \return true if the shapes intersect
+bool runGjk(const MinkowskiDifference& difference, std::vector<Vertex>* simplex, Vector3d* closest)
+{
+	if (simplex->empty())
+	{
+		simplex->push_back(difference.getSupport(Vector3d::UnitX()));
+	}
+	bool containsOrigin = reduceSimplex(simplex, closest);
+
+	for (size_t iteration = 0; iteration < maxGjkIterations; ++iteration)
+	{
+		const double squaredDistance = closest->squaredNorm();
+		if (containsOrigin || squaredDistance <= epsilon * epsilon)
+		{
+			return true;
+		}
+
+		const Vertex vertex = difference.getSupport(-*closest);
+		if (squaredDistance - closest->dot(vertex.point) <= gjkTolerance * squaredDistance)
+		{
+			return false;
+		}
+		for (const auto& existing : *simplex)
+		{
+			if ((existing.point - vertex.point).squaredNorm() <= epsilon * epsilon)
+			{
+				return false;
+			}
+		}
+
+		simplex->push_back(vertex);
+		containsOrigin = reduceSimplex(simplex, closest);
+	}
+
+	return containsOrigin || closest->squaredNorm() <= epsilon * epsilon;
+}
+
+/// Complete a simplex containing the origin into a tetrahedron containing the origin
+/// \param difference The Minkowski difference
+/// \param [in,out] vertices The simplex
+/// \return true if a non-degenerate tetrahedron containing the origin has been found
+bool completeTetrahedron(const MinkowskiDifference& difference, std::vector<Vertex>* vertices)
+{
+	if (vertices->size() == 1)
+	{
+		for (size_t axis = 0; axis < 6 && vertices->size() == 1; ++axis)
+		{
+			const Vector3d direction = ((axis % 2 == 0) ? 1.0 : -1.0) * Vector3d::Unit(axis / 2);
+			const Vertex vertex = difference.getSupport(direction);
+			if ((vertex.point - (*vertices)[0].point).squaredNorm() > epsilon * epsilon)
+			{
+				vertices->push_back(vertex);
+			}
+		}
+	}
+
+	if (vertices->size() == 2)
+	{
+		const Vector3d line = ((*vertices)[1].point - (*vertices)[0].point).normalized();
+		Eigen::Index axis;
+		line.cwiseAbs().minCoeff(&axis);
+		Vector3d direction = line.cross(Vector3d::Unit(axis)).normalized();
+		const Matrix33d rotation = makeRotationMatrix(M_PI / 3.0, line);
+		for (size_t i = 0; i < 6 && vertices->size() == 2; ++i)
+		{
+			const Vertex vertex = difference.getSupport(direction);
+			if (line.cross(vertex.point - (*vertices)[0].point).squaredNorm() > epsilon * epsilon)
+			{
+				vertices->push_back(vertex);
+			}
+			direction = rotation * direction;
+		}
+	}
+
+	if (vertices->size() == 3)
+	{
+		const Vector3d& a = (*vertices)[0].point;
+		const Vector3d normal = ((*vertices)[1].point - a).cross((*vertices)[2].point - a).normalized();
+		Vertex vertex = difference.getSupport(normal);
+		if (std::abs(normal.dot(vertex.point - a)) <= epsilon)
+		{
+			vertex = difference.getSupport(-normal);
+		}
+		if (std::abs(normal.dot(vertex.point - a)) > epsilon)
+		{
+			vertices->push_back(vertex);
+		}
+	}
+
+	if (vertices->size() != 4)
+	{
+		return false;
+	}
+
+	for (const auto& face : tetrahedronFaces)
+	{
+		const Vector3d& a = (*vertices)[face[0]].point;
+		const Vector3d normal = ((*vertices)[face[1]].point - a).cross((*vertices)[face[2]].point - a).normalized();
+		double originSide = -normal.dot(a);
+		double oppositeSide = normal.dot((*vertices)[face[3]].point - a);
+		if (std::abs(oppositeSide) <= epsilon || originSide * oppositeSide < -epsilon * std::abs(oppositeSide))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/// A face of the EPA polytope
+struct Face
+{
+	std::array<size_t, 3> vertices;
+	Vector3d normal;
+	double distance;
+};
+
+/// Run EPA on the Minkowski difference
+/// \param difference The Minkowski difference
+/// \param vertices The GJK simplex, containing the origin
+/// \param [out] normal The normal of the closest face of the Minkowski difference to the origin
+/// \param [out] depth The distance of that face
+/// \param [out] localPoint1, localPoint2 The points of the shapes corresponding to the origin projected on that face
+/// \return true if the penetration could be found
+bool runEpa(const MinkowskiDifference& difference, std::vector<Vertex> vertices, Vector3d* normal, double* depth,
+			Vector3d* localPoint1, Vector3d* localPoint2)
+{
+	if (!completeTetrahedron(difference, &vertices))
+	{
+		return false;
+	}
+
+	// Orient the tetrahedron for all its faces to point outward
+	if (tetrahedronVolume(vertices[0].point, vertices[1].point, vertices[2].point, vertices[3].point) > 0.0)
+	{
+		std::swap(vertices[1], vertices[2]);
+	}
+
+	auto makeFace = [&vertices](size_t i, size_t j, size_t k, Face* face)
+	{
+		const Vector3d normal = (vertices[j].point - vertices[i].point).cross(vertices[k].point - vertices[i].point);
+		const double norm = normal.norm();
+		if (norm <= epsilon * epsilon)
+		{
+			return false;
+		}
+		face->vertices = {{i, j, k}};
+		face->normal = normal / norm;
+		face->distance = face->normal.dot(vertices[i].point);
+		return true;
+	};
+
+	std::vector<Face> faces;
+	for (const auto& tetrahedronFace : tetrahedronFaces)
+	{
+		Face face;
+		if (makeFace(tetrahedronFace[0], tetrahedronFace[1], tetrahedronFace[2], &face))
+		{
+			faces.push_back(face);
+		}
+	}
+
+	auto findClosest = [&faces]()
+	{
+		return std::min_element(faces.begin(), faces.end(), [](const Face & a, const Face & b)
+		{
+			return a.distance < b.distance;
+		});
+	};
+
+	std::vector<std::pair<size_t, size_t>> horizon;
+	for (size_t iteration = 0; iteration < maxEpaIterations && !faces.empty(); ++iteration)
+	{
+		const Face closest = *findClosest();
+		const Vertex vertex = difference.getSupport(closest.normal);
+		const double supportDistance = closest.normal.dot(vertex.point);
+		if (supportDistance - closest.distance <= std::max(epsilon, epaTolerance * supportDistance))
+		{
+			break;
+		}
+
+		// Remove the faces seen from the new vertex, keeping the edges of the hole they leave
+		const size_t newVertex = vertices.size();
+		vertices.push_back(vertex);
+		horizon.clear();
+		for (auto face = faces.begin(); face != faces.end();)
+		{
+			if (face->normal.dot(vertex.point - vertices[face->vertices[0]].point) > 0.0)
+			{
+				for (size_t i = 0; i < 3; ++i)
+				{
+					const std::pair<size_t, size_t> edge(face->vertices[i], face->vertices[(i + 1) % 3]);
+					auto reversed = std::find(horizon.begin(), horizon.end(), std::make_pair(edge.second, edge.first));
+					if (reversed != horizon.end())
+					{
+						horizon.erase(reversed);
+					}
+					else
+					{
+						horizon.push_back(edge);
+					}
+				}
+				face = faces.erase(face);
+			}
+			else
+			{
+				++face;
+			}
+		}
+
+		for (const auto& edge : horizon)
+		{
+			Face face;
+			if (makeFace(edge.first, edge.second, newVertex, &face))
+			{
+				faces.push_back(face);
+			}
+		}
+	}
+
+	if (faces.empty())
+	{
+		return false;
+	}
+
+	const Face& closest = *findClosest();
+	const std::vector<Vertex> faceVertices = {
+		vertices[closest.vertices[0]], vertices[closest.vertices[1]], vertices[closest.vertices[2]]
+	};
+	const std::vector<double> weights = computeWeights(faceVertices, closest.normal * closest.distance);
+	localPoint1->setZero();
+	localPoint2->setZero();
+	for (size_t i = 0; i < 3; ++i)
+	{
+		*localPoint1 += weights[i] * faceVertices[i].localPoint1;
+		*localPoint2 += weights[i] * faceVertices[i].localPoint2;
+	}
+	*normal = -closest.normal;
+	*depth = std::max(closest.distance, 0.0);
+	return true;
+}
+
+/// \return The vertices of a cached simplex
+std::vector<Vertex> getVertices(const MinkowskiDifference& difference, const GjkSimplex* simplex)
+{
+	std::vector<Vertex> vertices;
+	if (simplex != nullptr)
+	{
+		for (const auto& points : *simplex)
+		{
+			vertices.push_back(difference.getVertex(points.first, points.second));
+		}
+	}
+	return vertices;
+}
+
+/// Cache the vertices of a simplex
+void setVertices(const std::vector<Vertex>& vertices, GjkSimplex* simplex)
+{
+	if (simplex != nullptr)
+	{
+		simplex->clear();
+		for (const auto& vertex : vertices)
+		{
+			simplex->emplace_back(vertex.localPoint1, vertex.localPoint2);
+		}
+	}
+}
+
+}
+
+double calculateGjkDistance(const Shape& shape1, const RigidTransform3d& pose1,
+							const Shape& shape2, const RigidTransform3d& pose2,
+							Vector3d* localPoint1, Vector3d* localPoint2, GjkSimplex* simplex)
+{
+	const MinkowskiDifference difference(shape1, pose1, shape2, pose2);
+	std::vector<Vertex> vertices = getVertices(difference, simplex);
+
+	double distance = 0.0;
+	Vector3d closest;
+	if (!runGjk(difference, &vertices, &closest))
+	{
+		distance = closest.norm();
+		const std::vector<double> weights = computeWeights(vertices, closest);
+		localPoint1->setZero();
+		localPoint2->setZero();
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			*localPoint1 += weights[i] * vertices[i].localPoint1;
+			*localPoint2 += weights[i] * vertices[i].localPoint2;
+		}
+	}
+
+	setVertices(vertices, simplex);
+	return distance;
+}
+
+bool calculateGjkEpaPenetration(const Shape& shape1, const RigidTransform3d& pose1,
+								const Shape& shape2, const RigidTransform3d& pose2,
+								Vector3d* normal, double* depth, Vector3d* localPoint1, Vector3d* localPoint2,
+								GjkSimplex* simplex)
+{
+	const MinkowskiDifference difference(shape1, pose1, shape2, pose2);
+	std::vector<Vertex> vertices = getVertices(difference, simplex);
+
+	Vector3d closest;
+	bool result = runGjk(difference, &vertices, &closest) &&
+				  runEpa(difference, vertices, normal, depth, localPoint1, localPoint2);
+
+	setVertices(vertices, simplex);
+	return result;
+}
+
+}; // namespace Math
+}; // namespace SurgSim
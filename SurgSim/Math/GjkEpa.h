@@ -0,0 +1,71 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_MATH_GJKEPA_H
+#define SURGSIM_MATH_GJKEPA_H
+
+#include <utility>
+#include <vector>
+
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/Vector.h"
+
+namespace SurgSim
+{
+namespace Math
+{
+
+class Shape;
+
+/// A simplex of the Minkowski difference of two shapes, each vertex being stored as the pair of points it comes from,
+/// in the local frames of the two shapes. As such, it remains meaningful when the shapes move, and can be used to
+/// warm start a query on the same shapes in their new poses.
+typedef std::vector<std::pair<Vector3d, Vector3d>> GjkSimplex;
+
+/// Calculate the distance between two convex shapes, using the Gilbert-Johnson-Keerthi algorithm.
+/// The shapes only need to provide a support function (see Shape::getSupportPoint).
+/// \param shape1, pose1 The first shape and its pose
+/// \param shape2, pose2 The second shape and its pose
+/// \param [out] localPoint1, localPoint2 The closest points, in the local frames of their shapes, if the shapes are
+///        separated
+/// \param [in,out] simplex Optional, the simplex of a previous query on the same shapes to start from, replaced by the
+///        final simplex
+/// \return The distance between the shapes, 0 if they intersect
+double calculateGjkDistance(const Shape& shape1, const RigidTransform3d& pose1,
+							const Shape& shape2, const RigidTransform3d& pose2,
+							Vector3d* localPoint1, Vector3d* localPoint2, GjkSimplex* simplex = nullptr);
+
+/// Calculate the penetration of two convex shapes, using the Gilbert-Johnson-Keerthi algorithm to detect the
+/// intersection, and the Expanding Polytope Algorithm to find the penetration depth.
+/// The shapes only need to provide a support function (see Shape::getSupportPoint).
+/// \param shape1, pose1 The first shape and its pose
+/// \param shape2, pose2 The second shape and its pose
+/// \param [out] normal The penetration normal, pointing into the first shape, i.e. moving the first shape by
+///        depth * normal separates the shapes
+/// \param [out] depth The penetration depth
+/// \param [out] localPoint1, localPoint2 The deepest points of each shape into the other one, in the local frames of
+///        their shapes
+/// \param [in,out] simplex Optional, the simplex of a previous query on the same shapes to start from, replaced by the
+///        final GJK simplex
+/// \return true if the shapes intersect, false otherwise (the outputs are not set)
+bool calculateGjkEpaPenetration(const Shape& shape1, const RigidTransform3d& pose1,
+								const Shape& shape2, const RigidTransform3d& pose2,
+								Vector3d* normal, double* depth, Vector3d* localPoint1, Vector3d* localPoint2,
+								GjkSimplex* simplex = nullptr);
+
+}; // namespace Math
+}; // namespace SurgSim
+
+#endif // SURGSIM_MATH_GJKEPA_H
@@ -13,9 +13,46 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include "SurgSim/Framework/Assert.h"
 #include "SurgSim/Math/LinearSparseSolveAndInverse.h"
 
+namespace
+{
+
+/// \return true if the two matrices have the same size and the same sparsity pattern
+bool hasSamePattern(const SurgSim::Math::SparseMatrix& matrix, const SurgSim::Math::SparseMatrix& other)
+{
+	if ((matrix.outerSize() != other.outerSize()) || (matrix.innerSize() != other.innerSize()) ||
+		(matrix.outerSize() <= 1))
+	{
+		return false;
+	}
+
+	const auto* innerIndices = matrix.innerIndexPtr();
+	const auto* outerIndices = matrix.outerIndexPtr();
+	const auto* otherInnerIndices = other.innerIndexPtr();
+	const auto* otherOuterIndices = other.outerIndexPtr();
+	for (Eigen::Index outerLoop = 0; outerLoop < matrix.outerSize(); ++outerLoop)
+	{
+		if (outerIndices[outerLoop + 1] != otherOuterIndices[outerLoop + 1])
+		{
+			return false;
+		}
+		for (auto innerLoop = outerIndices[outerLoop]; innerLoop < outerIndices[outerLoop + 1]; ++innerLoop)
+		{
+			if (innerIndices[innerLoop] != otherInnerIndices[innerLoop])
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+}
+
 namespace SurgSim
 {
 
@@ -31,41 +68,8 @@ Matrix LinearSparseSolveAndInverse::getInverse() const
 void LinearSparseSolveAndInverseLU::setMatrix(const SparseMatrix& matrix)
 {
 	SURGSIM_ASSERT(matrix.cols() == matrix.rows()) << "Cannot inverse a non square matrix";
-	bool sameMatrix = false;
+	const bool sameMatrix = hasSamePattern(matrix, m_matrix);
 
-	const auto* innerIndices = matrix.innerIndexPtr();
-	const auto* outerIndices = matrix.outerIndexPtr();
-	const auto* storedInnerIndices = m_matrix.innerIndexPtr();
-	const auto* storedOuterIndices = m_matrix.outerIndexPtr();
-	if ((matrix.outerSize() == m_matrix.outerSize()) && (matrix.innerSize() == m_matrix.innerSize()) &&
-		(matrix.outerSize() > 1))
-	{
-		sameMatrix = true;
-		for (Eigen::Index outerLoop = 0; outerLoop < matrix.outerSize() - 1; ++outerLoop)
-		{
-			if ((outerIndices[outerLoop] != storedOuterIndices[outerLoop]) ||
-				(outerIndices[outerLoop + 1] != storedOuterIndices[outerLoop + 1]))
-			{
-				sameMatrix = false;
-				break;
-			}
-			for (auto innerLoop = outerIndices[outerLoop];
-				innerLoop < outerIndices[outerLoop + 1];
-				++innerLoop)
-			{
-				if (innerIndices[innerLoop] != storedInnerIndices[innerLoop])
-				{
-					sameMatrix = false;
-					break;
-				}
-			}
-			if (!sameMatrix)
-			{
-				break;
-			}
-		}
-	}
-	
 	if (sameMatrix)
 	{
 		m_solver.factorize(matrix);
@@ -128,6 +132,421 @@ Matrix LinearSparseSolveAndInverseCG::solve(const Matrix& b) const
 	return m_solver.solve(b);
 }
 
+LinearSparseSolveAndInversePCG::LinearSparseSolveAndInversePCG() :
+	m_preconditioner(PRECONDITIONER_BLOCK_JACOBI),
+	m_blockSize(3),
+	m_tolerance(1.0e-6),
+	m_maxIterations(100),
+	m_warmStart(true),
+	m_iterations(0),
+	m_error(0.0)
+{
+}
+
+void LinearSparseSolveAndInversePCG::setPreconditioner(PcgPreconditioner preconditioner)
+{
+	m_preconditioner = preconditioner;
+}
+
+PcgPreconditioner LinearSparseSolveAndInversePCG::getPreconditioner() const
+{
+	return m_preconditioner;
+}
+
+void LinearSparseSolveAndInversePCG::setBlockSize(size_t size)
+{
+	SURGSIM_ASSERT(size > 0) << "The block size of the block Jacobi preconditioner cannot be 0";
+	m_blockSize = size;
+}
+
+size_t LinearSparseSolveAndInversePCG::getBlockSize() const
+{
+	return m_blockSize;
+}
+
+void LinearSparseSolveAndInversePCG::setTolerance(double tolerance)
+{
+	SURGSIM_ASSERT(tolerance >= 0.0) << "The tolerance cannot be negative";
+	m_tolerance = tolerance;
+}
+
+double LinearSparseSolveAndInversePCG::getTolerance() const
+{
+	return m_tolerance;
+}
+
+void LinearSparseSolveAndInversePCG::setMaxIterations(Eigen::Index iterations)
+{
+	SURGSIM_ASSERT(iterations >= 0) << "The maximum number of iterations cannot be negative";
+	m_maxIterations = iterations;
+}
+
+Eigen::Index LinearSparseSolveAndInversePCG::getMaxIterations() const
+{
+	return m_maxIterations;
+}
+
+void LinearSparseSolveAndInversePCG::setWarmStart(bool warmStart)
+{
+	m_warmStart = warmStart;
+	if (!m_warmStart)
+	{
+		resetWarmStart();
+	}
+}
+
+bool LinearSparseSolveAndInversePCG::isWarmStarting() const
+{
+	return m_warmStart;
+}
+
+void LinearSparseSolveAndInversePCG::resetWarmStart()
+{
+	m_previousSolution.resize(0);
+}
+
+void LinearSparseSolveAndInversePCG::setMatrix(const SparseMatrix& matrix)
+{
+	SURGSIM_ASSERT(matrix.cols() == matrix.rows()) << "Cannot inverse a non square matrix";
+	m_matrix = matrix;
+
+	if (m_preconditioner == PRECONDITIONER_INCOMPLETE_CHOLESKY)
+	{
+		m_incompleteCholesky.compute(matrix);
+		SURGSIM_ASSERT(m_incompleteCholesky.info() == Eigen::Success) <<
+			"The incomplete Cholesky factorization failed, the matrix needs to be symmetric positive definite";
+	}
+	else
+	{
+		const Eigen::Index size = static_cast<Eigen::Index>(m_blockSize);
+		SURGSIM_ASSERT(matrix.rows() % size == 0) << "The matrix size (" << matrix.rows() <<
+			") is not a multiple of the block size (" << m_blockSize << ")";
+
+		m_blockInverses.resize(size, matrix.cols());
+		for (Eigen::Index index = 0; index < matrix.cols(); index += size)
+		{
+			Matrix block = matrix.block(index, index, size, size);
+			Eigen::FullPivLU<Matrix> lu(block);
+			SURGSIM_ASSERT(lu.isInvertible()) << "The diagonal block at " << index << " is singular";
+			m_blockInverses.block(0, index, size, size) = lu.inverse();
+		}
+	}
+
+	if (m_previousSolution.size() != matrix.cols())
+	{
+		resetWarmStart();
+	}
+}
+
+void LinearSparseSolveAndInversePCG::applyPreconditioner(const Vector& residual, Vector* result) const
+{
+	if (m_preconditioner == PRECONDITIONER_INCOMPLETE_CHOLESKY)
+	{
+		*result = m_incompleteCholesky.solve(residual);
+	}
+	else
+	{
+		const Eigen::Index size = m_blockInverses.rows();
+		result->resize(residual.size());
+		for (Eigen::Index index = 0; index < residual.size(); index += size)
+		{
+			result->segment(index, size).noalias() =
+				m_blockInverses.block(0, index, size, size) * residual.segment(index, size);
+		}
+	}
+}
+
+Matrix LinearSparseSolveAndInversePCG::solve(const Matrix& b) const
+{
+	SURGSIM_ASSERT(b.rows() == m_matrix.rows()) << "The right-hand side has " << b.rows() <<
+		" rows, the matrix has " << m_matrix.rows();
+
+	const Eigen::Index maxIterations = (m_maxIterations > 0) ? m_maxIterations : 2 * m_matrix.cols();
+	const bool useWarmStart = m_warmStart && b.cols() == 1 && m_previousSolution.size() == b.rows();
+
+	Matrix x(b.rows(), b.cols());
+	Vector residual, preconditioned, direction, product;
+	m_iterations = 0;
+	m_error = 0.0;
+
+	for (Eigen::Index column = 0; column < b.cols(); ++column)
+	{
+		const double rhsNorm = b.col(column).norm();
+		if (rhsNorm == 0.0)
+		{
+			x.col(column).setZero();
+			continue;
+		}
+
+		if (useWarmStart)
+		{
+			x.col(column) = m_previousSolution;
+			residual = b.col(column) - m_matrix * x.col(column);
+		}
+		else
+		{
+			x.col(column).setZero();
+			residual = b.col(column);
+		}
+
+		const double threshold = m_tolerance * rhsNorm;
+		double residualNorm = residual.norm();
+		Eigen::Index iteration = 0;
+		if (residualNorm > threshold)
+		{
+			applyPreconditioner(residual, &preconditioned);
+			direction = preconditioned;
+			double rho = residual.dot(preconditioned);
+
+			while (iteration < maxIterations)
+			{
+				product.noalias() = m_matrix * direction;
+				const double curvature = direction.dot(product);
+				if (curvature <= 0.0)
+				{
+					break;
+				}
+
+				const double alpha = rho / curvature;
+				x.col(column) += alpha * direction;
+				residual -= alpha * product;
+				++iteration;
+
+				residualNorm = residual.norm();
+				if (residualNorm <= threshold)
+				{
+					break;
+				}
+
+				applyPreconditioner(residual, &preconditioned);
+				const double rhoNew = residual.dot(preconditioned);
+				direction = preconditioned + (rhoNew / rho) * direction;
+				rho = rhoNew;
+			}
+		}
+
+		m_iterations = std::max(m_iterations, iteration);
+		m_error = std::max(m_error, residualNorm / rhsNorm);
+	}
+
+	if (m_warmStart && b.cols() == 1)
+	{
+		m_previousSolution = x.col(0);
+	}
+
+	return x;
+}
+
+Eigen::Index LinearSparseSolveAndInversePCG::getIterations() const
+{
+	return m_iterations;
+}
+
+double LinearSparseSolveAndInversePCG::getError() const
+{
+	return m_error;
+}
+
+LinearSparseSolveAndInverseTriDiagonalBlock::LinearSparseSolveAndInverseTriDiagonalBlock() :
+	m_blockSize(3),
+	m_bandwidth(0),
+	m_groupSize(0)
+{
+}
+
+void LinearSparseSolveAndInverseTriDiagonalBlock::setBlockSize(size_t size)
+{
+	SURGSIM_ASSERT(size > 0) << "The block size cannot be 0";
+	m_blockSize = size;
+}
+
+size_t LinearSparseSolveAndInverseTriDiagonalBlock::getBlockSize() const
+{
+	return m_blockSize;
+}
+
+size_t LinearSparseSolveAndInverseTriDiagonalBlock::getBandwidth() const
+{
+	return m_bandwidth;
+}
+
+void LinearSparseSolveAndInverseTriDiagonalBlock::setMatrix(const SparseMatrix& matrix)
+{
+	SURGSIM_ASSERT(matrix.cols() == matrix.rows()) << "Cannot inverse a non square matrix";
+	const Eigen::Index size = matrix.rows();
+	const Eigen::Index blockSize = static_cast<Eigen::Index>(m_blockSize);
+	SURGSIM_ASSERT(size % blockSize == 0) <<
+		"The matrix size (" << size << ") is not a multiple of the block size (" << m_blockSize << ")";
+	m_matrix = matrix;
+
+	// Detect the block bandwidth, ignoring the explicit zeros (e.g. the boundary conditions)
+	Eigen::Index bandwidth = 0;
+	for (Eigen::Index col = 0; col < matrix.outerSize(); ++col)
+	{
+		for (SparseMatrix::InnerIterator it(matrix, col); it; ++it)
+		{
+			if (it.value() != 0.0)
+			{
+				bandwidth = std::max(bandwidth, std::abs(it.row() / blockSize - it.col() / blockSize));
+			}
+		}
+	}
+	m_bandwidth = static_cast<size_t>(bandwidth);
+
+	// Grouping bandwidth consecutive blocks makes the matrix block tri-diagonal, the last group can be smaller
+	m_groupSize = blockSize * std::max(bandwidth, static_cast<Eigen::Index>(1));
+	const Eigen::Index numGroups = (size + m_groupSize - 1) / m_groupSize;
+	auto groupSize = [this, size](Eigen::Index group)
+	{
+		return std::min(m_groupSize, size - group * m_groupSize);
+	};
+
+	std::vector<Matrix> diagonalBlocks(numGroups), lowerBlocks(numGroups);
+	m_upperBlocks.resize(numGroups);
+	for (Eigen::Index group = 0; group < numGroups; ++group)
+	{
+		diagonalBlocks[group].setZero(groupSize(group), groupSize(group));
+		if (group > 0)
+		{
+			lowerBlocks[group].setZero(groupSize(group), groupSize(group - 1));
+		}
+		if (group < numGroups - 1)
+		{
+			m_upperBlocks[group].setZero(groupSize(group), groupSize(group + 1));
+		}
+	}
+	for (Eigen::Index col = 0; col < matrix.outerSize(); ++col)
+	{
+		const Eigen::Index colGroup = col / m_groupSize;
+		const Eigen::Index colInGroup = col - colGroup * m_groupSize;
+		for (SparseMatrix::InnerIterator it(matrix, col); it; ++it)
+		{
+			const Eigen::Index rowGroup = it.row() / m_groupSize;
+			const Eigen::Index rowInGroup = it.row() - rowGroup * m_groupSize;
+			if (rowGroup == colGroup)
+			{
+				diagonalBlocks[rowGroup](rowInGroup, colInGroup) = it.value();
+			}
+			else if (rowGroup == colGroup + 1)
+			{
+				lowerBlocks[rowGroup](rowInGroup, colInGroup) = it.value();
+			}
+			else if (rowGroup + 1 == colGroup)
+			{
+				m_upperBlocks[rowGroup](rowInGroup, colInGroup) = it.value();
+			}
+		}
+	}
+
+	// Block LU factorization (forward elimination of the block Thomas algorithm):
+	// D'_0 = D_0, W_i = L_i.D'_{i-1}^-1 and D'_i = D_i - W_i.U_{i-1}
+	m_diagonalBlocks.resize(numGroups);
+	m_multipliers.resize(numGroups);
+	for (Eigen::Index group = 0; group < numGroups; ++group)
+	{
+		if (group > 0)
+		{
+			Matrix lowerTransposed = lowerBlocks[group].transpose();
+			Matrix multiplierTransposed = m_diagonalBlocks[group - 1].transpose().solve(lowerTransposed);
+			m_multipliers[group] = multiplierTransposed.transpose();
+			diagonalBlocks[group].noalias() -= m_multipliers[group] * m_upperBlocks[group - 1];
+		}
+		m_diagonalBlocks[group].compute(diagonalBlocks[group]);
+		SURGSIM_ASSERT(std::abs(m_diagonalBlocks[group].determinant()) > 0.0) <<
+			"The matrix cannot be factorized without pivoting across blocks, the diagonal block " << group <<
+			" of the elimination is singular";
+	}
+}
+
+Matrix LinearSparseSolveAndInverseTriDiagonalBlock::solve(const Matrix& b) const
+{
+	SURGSIM_ASSERT(b.rows() == m_matrix.rows()) << "The right-hand side does not match the matrix size";
+	const Eigen::Index numGroups = static_cast<Eigen::Index>(m_diagonalBlocks.size());
+	if (numGroups == 0)
+	{
+		return Matrix(0, b.cols());
+	}
+
+	Matrix x = b;
+	auto group = [this, &x](Eigen::Index index)
+	{
+		return x.middleRows(index * m_groupSize, m_diagonalBlocks[index].rows());
+	};
+
+	// Forward substitution, y_i = b_i - W_i.y_{i-1}
+	for (Eigen::Index index = 1; index < numGroups; ++index)
+	{
+		group(index).noalias() -= m_multipliers[index] * group(index - 1);
+	}
+
+	// Backward substitution, x_i = D'_i^-1.(y_i - U_i.x_{i+1})
+	group(numGroups - 1) = m_diagonalBlocks[numGroups - 1].solve(group(numGroups - 1));
+	for (Eigen::Index index = numGroups - 2; index >= 0; --index)
+	{
+		group(index).noalias() -= m_upperBlocks[index] * group(index + 1);
+		group(index) = m_diagonalBlocks[index].solve(group(index));
+	}
+
+	return x;
+}
+
+Matrix LinearSparseSolveAndInverseTriDiagonalBlock::getInverse() const
+{
+	return solve(Matrix::Identity(m_matrix.rows(), m_matrix.cols()));
+}
+
+LinearSparseSolveAndInverseMixedPrecisionLU::LinearSparseSolveAndInverseMixedPrecisionLU() :
+	m_refinementIterations(1)
+{
+}
+
+void LinearSparseSolveAndInverseMixedPrecisionLU::setRefinementIterations(size_t iterations)
+{
+	m_refinementIterations = iterations;
+}
+
+size_t LinearSparseSolveAndInverseMixedPrecisionLU::getRefinementIterations() const
+{
+	return m_refinementIterations;
+}
+
+void LinearSparseSolveAndInverseMixedPrecisionLU::setMatrix(const SparseMatrix& matrix)
+{
+	SURGSIM_ASSERT(matrix.cols() == matrix.rows()) << "Cannot inverse a non square matrix";
+	const bool samePattern = hasSamePattern(matrix, m_matrix);
+	m_matrix = matrix;
+
+	Eigen::SparseMatrix<float> singlePrecisionMatrix = matrix.cast<float>();
+	if (!samePattern)
+	{
+		m_solver.analyzePattern(singlePrecisionMatrix);
+	}
+	m_solver.factorize(singlePrecisionMatrix);
+	SURGSIM_ASSERT(m_solver.info() == Eigen::Success) << m_solver.lastErrorMessage();
+}
+
+Matrix LinearSparseSolveAndInverseMixedPrecisionLU::solve(const Matrix& b) const
+{
+	Eigen::MatrixXf singlePrecisionB = b.cast<float>();
+	Eigen::MatrixXf singlePrecisionX = m_solver.solve(singlePrecisionB);
+	Matrix x = singlePrecisionX.cast<double>();
+
+	for (size_t iteration = 0; iteration < m_refinementIterations; ++iteration)
+	{
+		Eigen::MatrixXf residual = (b - m_matrix * x).cast<float>();
+		Eigen::MatrixXf correction = m_solver.solve(residual);
+		x += correction.cast<double>();
+	}
+
+	return x;
+}
+
+Matrix LinearSparseSolveAndInverseMixedPrecisionLU::getInverse() const
+{
+	Eigen::MatrixXf inverse = m_solver.solve(Eigen::MatrixXf::Identity(m_matrix.rows(), m_matrix.cols()));
+	return inverse.cast<double>();
+}
+
 }; // namespace Math
 
 }; // namespace SurgSim
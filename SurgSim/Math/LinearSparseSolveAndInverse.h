@@ -21,11 +21,14 @@
 #pragma warning(disable:4244)
 #endif
 
+#include <Eigen/LU>
 #include <Eigen/SparseCore>
 #include <unordered_map>
+#include <vector>
 
 #include <boost/assign/list_of.hpp> // for 'map_list_of()'
 
+#include "SurgSim/Framework/Accessible.h"
 #include "SurgSim/Math/Matrix.h"
 #include "SurgSim/Math/SparseMatrix.h"
 #include "SurgSim/Math/Vector.h"
@@ -42,13 +45,25 @@ enum LinearSolver
 {
 	LINEARSOLVER_LU = 0,
 	LINEARSOLVER_CONJUGATEGRADIENT,
+	LINEARSOLVER_PRECONDITIONEDCONJUGATEGRADIENT,
+	LINEARSOLVER_TRIDIAGONALBLOCK,
+	LINEARSOLVER_MIXEDPRECISIONLU,
 	MAX_LINEARSOLVER
 };
 
 const std::unordered_map<LinearSolver, std::string, std::hash<int>> LinearSolverNames =
 			boost::assign::map_list_of
 			(LINEARSOLVER_LU, "LINEARSOLVER_LU")
-			(LINEARSOLVER_CONJUGATEGRADIENT, "LINEARSOLVER_CONJUGATEGRADIENT");
+			(LINEARSOLVER_CONJUGATEGRADIENT, "LINEARSOLVER_CONJUGATEGRADIENT")
+			(LINEARSOLVER_PRECONDITIONEDCONJUGATEGRADIENT, "LINEARSOLVER_PRECONDITIONEDCONJUGATEGRADIENT")
+			(LINEARSOLVER_TRIDIAGONALBLOCK, "LINEARSOLVER_TRIDIAGONALBLOCK")
+			(LINEARSOLVER_MIXEDPRECISIONLU, "LINEARSOLVER_MIXEDPRECISIONLU");
+
+/// The preconditioners supported by LinearSparseSolveAndInversePCG
+/// PRECONDITIONER_BLOCK_JACOBI: Inverse of the diagonal blocks of the matrix, the block size is set with
+/// LinearSparseSolveAndInversePCG::setBlockSize()
+/// PRECONDITIONER_INCOMPLETE_CHOLESKY: Incomplete Cholesky factorization of the matrix, with zero fill-in
+enum PcgPreconditioner : SURGSIM_ENUM_TYPE;
 
 /// LinearSparseSolveAndInverse aims at performing an efficient linear system resolution and
 /// calculating its inverse matrix at the same time.
@@ -122,10 +137,188 @@ class LinearSparseSolveAndInverseCG : public LinearSparseSolveAndInverse
 	Eigen::ConjugateGradient<SparseMatrix> m_solver;
 };
 
+/// Derivation for a preconditioned conjugate gradient solver, aimed at large symmetric positive definite systems
+/// that cannot afford the fill-in of a sparse LU factorization.
+/// The solution of the last single right-hand side solve is used as the initial guess of the next one, so that
+/// systems that change little from one time step to the next (e.g. the velocity increment of an implicit ode
+/// solver) converge in a few iterations. Solves with several right-hand sides always start from zero.
+/// For hard real-time use, a tolerance of 0 makes every solve run exactly the maximum number of iterations.
+class LinearSparseSolveAndInversePCG : public LinearSparseSolveAndInverse
+{
+public:
+	/// Constructor
+	LinearSparseSolveAndInversePCG();
+
+	/// Set the preconditioner, takes effect on the next setMatrix call
+	/// \param preconditioner The new preconditioner
+	void setPreconditioner(PcgPreconditioner preconditioner);
+
+	/// \return The preconditioner
+	PcgPreconditioner getPreconditioner() const;
+
+	/// Set the size of the diagonal blocks of the block Jacobi preconditioner, usually the number of dof per node.
+	/// Takes effect on the next setMatrix call.
+	/// \param size The new block size, the matrix size needs to be a multiple of it
+	void setBlockSize(size_t size);
+
+	/// \return The size of the diagonal blocks of the block Jacobi preconditioner
+	size_t getBlockSize() const;
+
+	/// Set the convergence tolerance, relative to the norm of the right-hand side
+	/// \param tolerance The new convergence tolerance, 0 to always run the maximum number of iterations.
+	/// Defaults to 1e-6.
+	void setTolerance(double tolerance);
+
+	/// \return The convergence tolerance
+	double getTolerance() const;
+
+	/// Set the maximum number of iterations, i.e. the iteration budget of each solve
+	/// \param iterations The new maximum number of iterations, 0 to use twice the size of the system.
+	/// Defaults to 100.
+	void setMaxIterations(Eigen::Index iterations);
+
+	/// \return The maximum number of iterations
+	Eigen::Index getMaxIterations() const;
+
+	/// Enable or disable the use of the previous solution as initial guess
+	/// \param warmStart True to use the previous solution as initial guess
+	void setWarmStart(bool warmStart);
+
+	/// \return True if the previous solution is used as initial guess
+	bool isWarmStarting() const;
+
+	/// Discard the previous solution, the next solve will start from zero
+	void resetWarmStart();
+
+	void setMatrix(const SparseMatrix& matrix) override;
+
+	Matrix solve(const Matrix& b) const override;
+
+	/// \return The number of iterations of the last solve, the largest over all the right-hand sides
+	Eigen::Index getIterations() const;
+
+	/// \return The relative residual |b - A.x| / |b| of the last solve, the largest over all the right-hand sides
+	double getError() const;
+
+private:
+	/// Apply the preconditioner
+	/// \param residual The residual to precondition
+	/// \param [out] result The preconditioned residual
+	void applyPreconditioner(const Vector& residual, Vector* result) const;
+
+	PcgPreconditioner m_preconditioner;
+	size_t m_blockSize;
+	double m_tolerance;
+	Eigen::Index m_maxIterations;
+	bool m_warmStart;
+
+	/// The inverses of the diagonal blocks, side by side, for the block Jacobi preconditioner
+	Matrix m_blockInverses;
+
+	/// The factorization for the incomplete Cholesky preconditioner
+	Eigen::IncompleteCholesky<double> m_incompleteCholesky;
+
+	///@{
+	/// Solve results, kept for warm starting and for the metrics
+	mutable Vector m_previousSolution;
+	mutable Eigen::Index m_iterations;
+	mutable double m_error;
+	///@}
+};
+
+/// Derivation for block banded matrices, as produced by 1D models (beams, mass-spring chains), solved in O(n) with
+/// a block Thomas algorithm (block LU factorization without pivoting across blocks).
+/// The block bandwidth (largest distance, in blocks, between a non-zero entry and the diagonal) is detected on each
+/// setMatrix call, and groups of bandwidth consecutive blocks are treated as single blocks, turning any block banded
+/// matrix into a block tri-diagonal one. Solving k right-hand sides (e.g. the compliance columns needed by k
+/// constraints) costs O(n.k).
+/// \note The diagonal blocks of the elimination need to be invertible, which is the case for the symmetric positive
+///       definite (or diagonally dominant) system matrices of the ode solvers.
+class LinearSparseSolveAndInverseTriDiagonalBlock : public LinearSparseSolveAndInverse
+{
+public:
+	/// Constructor
+	LinearSparseSolveAndInverseTriDiagonalBlock();
+
+	/// Set the size of the blocks, usually the number of dof per node. Takes effect on the next setMatrix call.
+	/// \param size The new block size, the matrix size needs to be a multiple of it
+	void setBlockSize(size_t size);
+
+	/// \return The size of the blocks
+	size_t getBlockSize() const;
+
+	/// \return The block bandwidth of the matrix provided on the last setMatrix call, i.e. the largest distance, in
+	///         blocks, between a non-zero entry and the diagonal
+	size_t getBandwidth() const;
+
+	void setMatrix(const SparseMatrix& matrix) override;
+
+	Matrix solve(const Matrix& b) const override;
+
+	Matrix getInverse() const override;
+
+private:
+	size_t m_blockSize;
+	size_t m_bandwidth;
+
+	/// The size of the blocks of the tri-diagonal decomposition, i.e. the block size times the bandwidth
+	Eigen::Index m_groupSize;
+
+	/// The LU factorization of the diagonal blocks of the elimination
+	std::vector<Eigen::PartialPivLU<Matrix>> m_diagonalBlocks;
+
+	/// The blocks above the diagonal
+	std::vector<Matrix> m_upperBlocks;
+
+	/// The elimination multipliers, i.e. the blocks below the diagonal times the inverse of the previous diagonal block
+	std::vector<Matrix> m_multipliers;
+};
+
+/// Derivation for a sparse LU solver with a mixed precision factorization.
+/// The LU factors are computed and stored in single precision (float), which halves the memory and bandwidth of the
+/// stored factors and of the triangular solves only. The inputs and outputs stay in double precision so that the
+/// solver can be used as any other one (ode solvers, compliance matrices, constraints), the matrices and states of
+/// the representation using it are unchanged.
+/// The double precision matrix is also kept, to compute the residuals of the iterative refinement steps, each one
+/// solving for the correction of a residual with the single precision factors.
+/// The fill-reducing ordering and the symbolic analysis are only computed when the sparsity pattern of the matrix
+/// changes, the other setMatrix calls only factorize the new values.
+/// \note Suited for models whose accuracy matters less than their cost, e.g. purely visual soft tissues.
+class LinearSparseSolveAndInverseMixedPrecisionLU : public LinearSparseSolveAndInverse
+{
+public:
+	/// Constructor
+	LinearSparseSolveAndInverseMixedPrecisionLU();
+
+	/// Set the number of iterative refinement steps of each solve
+	/// \param iterations The number of refinement steps, 0 to use the single precision solution directly
+	void setRefinementIterations(size_t iterations);
+
+	/// \return The number of iterative refinement steps of each solve
+	size_t getRefinementIterations() const;
+
+	void setMatrix(const SparseMatrix& matrix) override;
+
+	Matrix solve(const Matrix& b) const override;
+
+	/// \note The inverse is computed with the single precision factors only, refining its n columns would cost n
+	/// sparse products and solves per refinement step.
+	Matrix getInverse() const override;
+
+private:
+	size_t m_refinementIterations;
+
+	Eigen::SparseLU<Eigen::SparseMatrix<float>> m_solver;
+};
+
 }; // namespace Math
 
 }; // namespace SurgSim
 
+SURGSIM_SERIALIZABLE_ENUM(SurgSim::Math::PcgPreconditioner,
+						  (PRECONDITIONER_BLOCK_JACOBI)
+						  (PRECONDITIONER_INCOMPLETE_CHOLESKY))
+
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
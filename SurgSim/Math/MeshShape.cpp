@@ -15,6 +15,9 @@
 
 #include "SurgSim/Math/MeshShape.h"
 
+#include <algorithm>
+#include <array>
+
 #include "SurgSim/DataStructures/AabbTree.h"
 #include "SurgSim/DataStructures/AabbTreeData.h"
 #include "SurgSim/DataStructures/AabbTreeNode.h"
@@ -85,6 +88,73 @@ bool MeshShape::calculateNormals()
 	return result;
 }
 
+bool MeshShape::calculateNormals(const std::vector<size_t>& triangleIds)
+{
+	bool result = true;
+	for (size_t id : triangleIds)
+	{
+		auto vertices = getTrianglePositions(id);
+		SurgSim::Math::Vector3d normal = (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]);
+		if (normal.isZero())
+		{
+			SURGSIM_LOG_WARNING(SurgSim::Framework::Logger::getLogger("Math/MeshShape")) <<
+					"MeshShape::calculateNormals unable to calculate normals. For example, for triangle #" << id <<
+					" with vertices:" << std::endl << "1: " << vertices[0].transpose() << std::endl <<
+					"2: " << vertices[1].transpose() << std::endl << "3: " << vertices[2].transpose();
+			result = false;
+			break;
+		}
+		normal.normalize();
+		getTriangle(id).data.normal = normal;
+	}
+	return result;
+}
+
+bool MeshShape::updateMovedVertices(const std::vector<size_t>& vertexIds)
+{
+	// Refitting the tree node by node costs more than refitting it all at once when more than a tenth of the
+	// triangles moved, the moved vertices touch at least as large a fraction of the triangles
+	if (10 * vertexIds.size() > getNumVertices())
+	{
+		updateAabbTree();
+		return calculateNormals();
+	}
+
+	const auto& triangles = getTriangles();
+	if (m_vertexTriangles.size() != getNumVertices())
+	{
+		m_vertexTriangles.assign(getNumVertices(), std::vector<size_t>());
+		for (size_t id = 0; id < triangles.size(); ++id)
+		{
+			if (triangles[id].isValid)
+			{
+				for (size_t vertexId : triangles[id].verticesId)
+				{
+					m_vertexTriangles[vertexId].push_back(id);
+				}
+			}
+		}
+	}
+
+	m_movedTriangles.clear();
+	for (size_t vertexId : vertexIds)
+	{
+		m_movedTriangles.insert(m_movedTriangles.end(), m_vertexTriangles[vertexId].begin(),
+								m_vertexTriangles[vertexId].end());
+	}
+	std::sort(m_movedTriangles.begin(), m_movedTriangles.end());
+	m_movedTriangles.erase(std::unique(m_movedTriangles.begin(), m_movedTriangles.end()), m_movedTriangles.end());
+
+	if (10 * m_movedTriangles.size() > getNumTriangles())
+	{
+		updateAabbTree();
+		return calculateNormals();
+	}
+
+	updateAabbTree(m_movedTriangles);
+	return calculateNormals(m_movedTriangles);
+}
+
 void MeshShape::updateShape()
 {
 	doUpdate();
@@ -105,11 +175,100 @@ bool MeshShape::doUpdate()
 
 bool MeshShape::doLoad(const std::string& fileName)
 {
-	if (!SurgSim::DataStructures::TriangleMesh<EmptyData, EmptyData, NormalData>::doLoad(fileName))
+	return SurgSim::DataStructures::loadWithBinaryCache(fileName, getClassName(),
+		std::bind(&MeshShape::loadShapeBinaryCache, this, std::placeholders::_1),
+		[this, &fileName]()
+		{
+			return loadPly(fileName) && update();
+		},
+		std::bind(&MeshShape::saveShapeBinaryCache, this, std::placeholders::_1));
+}
+
+void MeshShape::saveShapeBinaryCache(SurgSim::DataStructures::BinaryCacheWriter* writer) const
+{
+	saveBinaryCache(writer);
+
+	std::vector<double> normals;
+	normals.reserve(3 * getNumTriangles());
+	for (const auto& triangle : getTriangles())
+	{
+		if (triangle.isValid)
+		{
+			normals.insert(normals.end(), triangle.data.normal.data(), triangle.data.normal.data() + 3);
+		}
+	}
+	writer->write(normals);
+
+	std::array<double, 3> center;
+	std::array<double, 9> secondMomentOfVolume;
+	Eigen::Map<Vector3d>(center.data()) = m_center;
+	Eigen::Map<Matrix33d>(secondMomentOfVolume.data()) = m_secondMomentOfVolume;
+	writer->write(m_volume);
+	writer->write(center);
+	writer->write(secondMomentOfVolume);
+
+	// The triangles are compacted in the cache, the structure of the tree is only valid without deleted triangles
+	std::vector<size_t> structure;
+	if (m_aabbTree != nullptr && getNumTriangles() == getTriangles().size())
+	{
+		m_aabbTree->getStructure(&structure);
+	}
+	writer->write(structure);
+}
+
+bool MeshShape::loadShapeBinaryCache(SurgSim::DataStructures::BinaryCacheReader* reader)
+{
+	if (!loadBinaryCache(reader))
 	{
 		return false;
 	}
-	return update();
+
+	std::vector<double> normals;
+	double volume;
+	std::array<double, 3> center;
+	std::array<double, 9> secondMomentOfVolume;
+	std::vector<size_t> structure;
+	if (!reader->read(&normals) || normals.size() != 3 * getNumTriangles() ||
+		!reader->read(&volume) || !reader->read(&center) || !reader->read(&secondMomentOfVolume) ||
+		!reader->read(&structure))
+	{
+		return false;
+	}
+
+	auto& triangles = getTriangles();
+	for (size_t id = 0; id < triangles.size(); ++id)
+	{
+		triangles[id].data.normal = Eigen::Map<const Vector3d>(normals.data() + 3 * id);
+	}
+
+	m_volume = volume;
+	m_center = Eigen::Map<const Vector3d>(center.data());
+	m_secondMomentOfVolume = Eigen::Map<const Matrix33d>(secondMomentOfVolume.data());
+
+	if (structure.empty())
+	{
+		buildAabbTree();
+	}
+	else
+	{
+		std::vector<Aabbd> bounds(triangles.size());
+		for (size_t id = 0; id < triangles.size(); ++id)
+		{
+			auto vertices = getTrianglePositions(id);
+			bounds[id] = SurgSim::Math::makeAabb(vertices[0], vertices[1], vertices[2]);
+		}
+
+		m_aabbTree = std::make_shared<SurgSim::DataStructures::AabbTree>();
+		if (!m_aabbTree->setStructure(structure, bounds))
+		{
+			return false;
+		}
+		m_aabb = m_aabbTree->getAabb();
+		m_aabbCache = std::move(bounds);
+		m_vertexTriangles.clear();
+	}
+
+	return true;
 }
 
 int MeshShape::getType() const
@@ -240,6 +399,16 @@ const std::shared_ptr<const SurgSim::DataStructures::AabbTree> MeshShape::getAab
 	return m_aabbTree;
 }
 
+void MeshShape::setSweptAabbTree(std::shared_ptr<const SurgSim::DataStructures::AabbTree> tree)
+{
+	m_sweptAabbTree = tree;
+}
+
+std::shared_ptr<const SurgSim::DataStructures::AabbTree> MeshShape::getSweptAabbTree() const
+{
+	return m_sweptAabbTree;
+}
+
 void MeshShape::buildAabbTree()
 {
 	m_aabbTree = std::make_shared<SurgSim::DataStructures::AabbTree>();
@@ -248,16 +417,22 @@ void MeshShape::buildAabbTree()
 
 	auto const& triangles = getTriangles();
 
+	// The cache is kept in sync with the tree, partial updates read the bounds of all the triangles in a leaf
+	m_aabbCache.resize(triangles.size());
 	for (size_t id = 0, count = triangles.size(); id < count; ++id)
 	{
 		if (triangles[id].isValid)
 		{
 			auto vertices = getTrianglePositions(id);
-			items.emplace_back(SurgSim::Math::makeAabb(vertices[0], vertices[1], vertices[2]), id);
+			m_aabbCache[id] = SurgSim::Math::makeAabb(vertices[0], vertices[1], vertices[2]);
+			items.emplace_back(m_aabbCache[id], id);
 		}
 	}
 	m_aabbTree->set(std::move(items));
 	m_aabb = m_aabbTree->getAabb();
+
+	// The topology might have changed, the adjacency will be rebuilt when needed
+	m_vertexTriangles.clear();
 }
 
 void MeshShape::setPose(const RigidTransform3d& pose)
@@ -298,5 +473,23 @@ void MeshShape::updateAabbTree()
 	m_aabb = m_aabbTree->getAabb();
 }
 
+void MeshShape::updateAabbTree(const std::vector<size_t>& triangleIds)
+{
+	if (m_aabbCache.size() != getTriangles().size())
+	{
+		updateAabbTree();
+		return;
+	}
+
+	for (size_t id : triangleIds)
+	{
+		auto vertices = getTrianglePositions(id);
+		m_aabbCache[id] = SurgSim::Math::makeAabb(vertices[0], vertices[1], vertices[2]);
+	}
+
+	m_aabbTree->updateBounds(m_aabbCache, triangleIds);
+	m_aabb = m_aabbTree->getAabb();
+}
+
 }; // namespace Math
 }; // namespace SurgSim
@@ -93,6 +93,15 @@ class MeshShape : public VerticesShape, public SurgSim::DataStructures::Triangle
 	/// \return The object's associated AabbTree
 	const std::shared_ptr<const SurgSim::DataStructures::AabbTree> getAabbTree() const;
 
+	/// Set the AabbTree over the volume swept by the triangles during the motion ending with this shape, so that the
+	/// continuous collision detection does not rebuild it for every pair (see buildSweptAabbTree())
+	/// \param tree The swept tree, kept up to date by the owner of the motion, nullptr if there is none
+	void setSweptAabbTree(std::shared_ptr<const SurgSim::DataStructures::AabbTree> tree);
+
+	/// \return The AabbTree over the volume swept by the triangles during the motion ending with this shape, nullptr
+	///         if none was set
+	std::shared_ptr<const SurgSim::DataStructures::AabbTree> getSweptAabbTree() const;
+
 	bool isValid() const override;
 
 	void setPose(const RigidTransform3d& pose) override;
@@ -109,6 +118,24 @@ class MeshShape : public VerticesShape, public SurgSim::DataStructures::Triangle
 	/// \return true on success, or false if any triangle has an indeterminate normal.
 	bool calculateNormals();
 
+	/// Update the AabbTree for some of the triangles, without rebalancing the tree, only the nodes holding these
+	/// triangles and their ancestors are refit
+	/// \param triangleIds The ids of the triangles whose vertices moved
+	void updateAabbTree(const std::vector<size_t>& triangleIds);
+
+	/// Calculate normals for some of the triangles.
+	/// \note Normals will be normalized.
+	/// \param triangleIds The ids of the triangles whose vertices moved
+	/// \return true on success, or false if any of these triangles has an indeterminate normal.
+	bool calculateNormals(const std::vector<size_t>& triangleIds);
+
+	/// Update the AabbTree and the normals after some of the vertices moved, only the triangles using these vertices
+	/// are recomputed, this is much faster than updateShapePartial() when a small part of a large mesh deforms.
+	/// When more than a tenth of the triangles moved, the whole tree and all the normals are recomputed instead.
+	/// \param vertexIds The ids of the vertices that moved
+	/// \return true on success, or false if any of the affected triangles has an indeterminate normal.
+	bool updateMovedVertices(const std::vector<size_t>& vertexIds);
+
 	void updateShape() override;
 	void updateShapePartial() override;
 
@@ -131,9 +158,28 @@ class MeshShape : public VerticesShape, public SurgSim::DataStructures::Triangle
 	SurgSim::Math::Matrix33d m_secondMomentOfVolume;
 
 private:
+	/// Write the mesh, its normals, its volume integrals and its AabbTree into a binary cache
+	/// \param writer The cache writer
+	void saveShapeBinaryCache(SurgSim::DataStructures::BinaryCacheWriter* writer) const;
+
+	/// Restore the mesh, its normals, its volume integrals and its AabbTree from a binary cache written by
+	/// saveShapeBinaryCache(), this avoids parsing the .ply file and rebuilding the AabbTree
+	/// \param reader The cache reader
+	/// \return true if the content of the cache was consistent, false otherwise
+	bool loadShapeBinaryCache(SurgSim::DataStructures::BinaryCacheReader* reader);
+
 	/// The aabb tree used to accelerate collision detection against the mesh
 	std::shared_ptr<SurgSim::DataStructures::AabbTree> m_aabbTree;
 	std::vector<SurgSim::Math::Aabbd> m_aabbCache;
+
+	/// The aabb tree over the swept volume of the triangles, used by the continuous collision detection
+	std::shared_ptr<const SurgSim::DataStructures::AabbTree> m_sweptAabbTree;
+
+	/// For each vertex, the ids of the valid triangles using it, built on demand by updateMovedVertices()
+	std::vector<std::vector<size_t>> m_vertexTriangles;
+
+	/// The affected triangles in updateMovedVertices(), kept to avoid reallocations
+	std::vector<size_t> m_movedTriangles;
 };
 
 }; // Math
@@ -0,0 +1,673 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Math/MlcpColoredGaussSeidelSolver.h"
+
+#include <algorithm>
+#include <future>
+#include <math.h>
+
+#include <boost/thread.hpp>
+
+#include "SurgSim/Framework/Log.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Framework/ThreadPool.h"
+#include "SurgSim/Math/Valid.h"
+
+namespace
+{
+
+/// \return The number of atomic constraints of a constraint type
+size_t getNumAtomicConstraints(SurgSim::Math::MlcpConstraintType type)
+{
+	switch (type)
+	{
+		case SurgSim::Math::MLCP_BILATERAL_1D_CONSTRAINT:
+		case SurgSim::Math::MLCP_UNILATERAL_3D_FRICTIONLESS_CONSTRAINT:
+			return 1;
+		case SurgSim::Math::MLCP_BILATERAL_2D_CONSTRAINT:
+		case SurgSim::Math::MLCP_BILATERAL_FRICTIONLESS_SLIDING_CONSTRAINT:
+			return 2;
+		case SurgSim::Math::MLCP_BILATERAL_3D_CONSTRAINT:
+		case SurgSim::Math::MLCP_UNILATERAL_3D_FRICTIONAL_CONSTRAINT:
+		case SurgSim::Math::MLCP_BILATERAL_FRICTIONAL_SLIDING_CONSTRAINT:
+			return 3;
+		default:
+			SURGSIM_FAILURE() << "unknown constraint type [" << type << "]";
+			return 0;
+	}
+}
+
+/// \return The number of atomic constraints enforced with the leading bilateral constraints, i.e. without the
+/// frictional ones, 0 for the bilateral constraints which are not enforced
+size_t getNumEnforcedAtomicConstraints(SurgSim::Math::MlcpConstraintType type)
+{
+	switch (type)
+	{
+		case SurgSim::Math::MLCP_UNILATERAL_3D_FRICTIONLESS_CONSTRAINT:
+		case SurgSim::Math::MLCP_UNILATERAL_3D_FRICTIONAL_CONSTRAINT:
+			return 1;
+		case SurgSim::Math::MLCP_BILATERAL_FRICTIONLESS_SLIDING_CONSTRAINT:
+		case SurgSim::Math::MLCP_BILATERAL_FRICTIONAL_SLIDING_CONSTRAINT:
+			return 2;
+		default:
+			return 0;
+	}
+}
+
+}
+
+namespace SurgSim
+{
+namespace Math
+{
+
+MlcpColoredGaussSeidelSolver::MlcpColoredGaussSeidelSolver() :
+	m_epsilonConvergence(1e-4),
+	m_contactTolerance(2e-5),
+	m_maxIterations(30),
+	m_minConstraintsPerTask(32),
+	m_maxNumTasks(std::max(1u, boost::thread::hardware_concurrency())),
+	m_threadPool(SurgSim::Framework::Runtime::getThreadPool()),
+	m_logger(SurgSim::Framework::Logger::getLogger("Math/MlcpColoredGaussSeidelSolver"))
+{
+}
+
+MlcpColoredGaussSeidelSolver::MlcpColoredGaussSeidelSolver(double epsilonConvergence, double contactTolerance,
+		size_t maxIterations) :
+	m_epsilonConvergence(epsilonConvergence),
+	m_contactTolerance(contactTolerance),
+	m_maxIterations(maxIterations),
+	m_minConstraintsPerTask(32),
+	m_maxNumTasks(std::max(1u, boost::thread::hardware_concurrency())),
+	m_threadPool(SurgSim::Framework::Runtime::getThreadPool()),
+	m_logger(SurgSim::Framework::Logger::getLogger("Math/MlcpColoredGaussSeidelSolver"))
+{
+}
+
+MlcpColoredGaussSeidelSolver::~MlcpColoredGaussSeidelSolver()
+{
+}
+
+double MlcpColoredGaussSeidelSolver::getEpsilonConvergence() const
+{
+	return m_epsilonConvergence;
+}
+
+void MlcpColoredGaussSeidelSolver::setEpsilonConvergence(double precision)
+{
+	m_epsilonConvergence = precision;
+}
+
+double MlcpColoredGaussSeidelSolver::getContactTolerance() const
+{
+	return m_contactTolerance;
+}
+
+void MlcpColoredGaussSeidelSolver::setContactTolerance(double tolerance)
+{
+	m_contactTolerance = tolerance;
+}
+
+size_t MlcpColoredGaussSeidelSolver::getMaxIterations() const
+{
+	return m_maxIterations;
+}
+
+void MlcpColoredGaussSeidelSolver::setMaxIterations(size_t maxIterations)
+{
+	m_maxIterations = maxIterations;
+}
+
+size_t MlcpColoredGaussSeidelSolver::getMinConstraintsPerTask() const
+{
+	return m_minConstraintsPerTask;
+}
+
+void MlcpColoredGaussSeidelSolver::setMinConstraintsPerTask(size_t numConstraints)
+{
+	SURGSIM_ASSERT(numConstraints > 0) << "The minimum number of constraints per task has to be positive.";
+	m_minConstraintsPerTask = numConstraints;
+}
+
+size_t MlcpColoredGaussSeidelSolver::getMaxNumTasks() const
+{
+	return m_maxNumTasks;
+}
+
+void MlcpColoredGaussSeidelSolver::setMaxNumTasks(size_t numTasks)
+{
+	SURGSIM_ASSERT(numTasks > 0) << "The maximum number of tasks has to be positive.";
+	m_maxNumTasks = numTasks;
+}
+
+size_t MlcpColoredGaussSeidelSolver::getNumColors() const
+{
+	return m_colors.size();
+}
+
+bool MlcpColoredGaussSeidelSolver::solve(const MlcpProblem& problem, MlcpSolution* solution)
+{
+	MlcpSolution::Vector& initialGuessAndSolution = solution->x;
+	size_t* iteration = &solution->numIterations;
+	bool* validConvergence = &solution->validConvergence;
+	bool* validSignorini = &solution->validSignorini;
+	double* convergenceCriteria = &solution->convergenceCriteria;
+	double* initialConvergenceCriteria = &solution->initialConvergenceCriteria;
+
+	solution->maxIterations = m_maxIterations;
+	solution->epsilonConvergence = m_epsilonConvergence;
+	solution->contactTolerance = m_contactTolerance;
+
+	buildColors(problem);
+	m_systems.resize(m_maxNumTasks);
+
+	// Loop until it converges or maxIterations are reached
+	*iteration = 0;
+	*validSignorini = true;
+
+	calculateConvergenceCriteria(problem, initialGuessAndSolution, solution->initialConstraintConvergenceCriteria,
+								 initialConvergenceCriteria, validSignorini);
+
+	// If it is already converged, fill the output and return true.
+	if (*initialConvergenceCriteria <= m_epsilonConvergence && *validSignorini)
+	{
+		*validConvergence = true;
+		*convergenceCriteria = *initialConvergenceCriteria;
+		return true;
+	}
+
+	do
+	{
+		// The constraints of a color don't read the forces written by the others
+		for (const auto& color : m_colors)
+		{
+			parallelFor(color.size(), [this, &problem, &initialGuessAndSolution, &color](size_t task, size_t begin,
+						size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					updateConstraint(problem, &initialGuessAndSolution, m_blocks[color[i]], &m_systems[task]);
+				}
+			});
+		}
+
+		calculateConvergenceCriteria(problem, initialGuessAndSolution, solution->constraintConvergenceCriteria,
+									 convergenceCriteria, validSignorini);
+		++(*iteration);
+
+		// If we have an incredibly high convergence criteria value, the displacements are going to be very large,
+		// causing problems in the next iteration, so we should break out here.
+		if (!SurgSim::Math::isValid(*convergenceCriteria) || *convergenceCriteria > 1.0)
+		{
+			SURGSIM_LOG_WARNING(m_logger) << "Convergence (" << *convergenceCriteria <<
+										  ") is NaN, infinite, or greater than 1.0! MLCP is exploding after " <<
+										  *iteration << " colored Gauss Seidel iterations!!";
+			break;
+		}
+	}
+	while ((!(*validSignorini) || (*convergenceCriteria > m_epsilonConvergence)) && *iteration < m_maxIterations);
+
+	*validConvergence = SurgSim::Math::isValid(*convergenceCriteria) && *convergenceCriteria <= 1.0;
+
+	SURGSIM_LOG_IF(*convergenceCriteria >= sqrt(m_epsilonConvergence), m_logger, WARNING) <<
+			"Convergence criteria (" << *convergenceCriteria << ") is greater than " << sqrt(m_epsilonConvergence) <<
+			" at end of " << *iteration << " colored Gauss Seidel iterations.";
+	SURGSIM_LOG_IF(*convergenceCriteria > *initialConvergenceCriteria, m_logger, WARNING) <<
+			"Convergence criteria (" << *convergenceCriteria << ") is greater than before " << *iteration <<
+			" colored Gauss Seidel iterations (" << *initialConvergenceCriteria << ").";
+	SURGSIM_LOG_IF(!(*validSignorini), m_logger, WARNING) <<
+			"Signorini not verified after " << *iteration << " colored Gauss Seidel iterations.";
+
+	return (SurgSim::Math::isValid(*convergenceCriteria) && *convergenceCriteria <= m_epsilonConvergence);
+}
+
+void MlcpColoredGaussSeidelSolver::buildColors(const MlcpProblem& problem)
+{
+	const MlcpProblem::Matrix& A = problem.A;
+	const size_t numConstraints = problem.constraintTypes.size();
+
+	// The constraint of each atomic constraint
+	std::vector<size_t> rowConstraints;
+	rowConstraints.reserve(problem.getSize());
+	for (size_t constraint = 0; constraint < numConstraints; ++constraint)
+	{
+		rowConstraints.insert(rowConstraints.end(), getNumAtomicConstraints(problem.constraintTypes[constraint]),
+							  constraint);
+	}
+	const size_t size = rowConstraints.size();
+	SURGSIM_ASSERT(size == problem.getSize()) << "The constraint types describe " << size <<
+		" atomic constraints, the problem has " << problem.getSize();
+
+	// Find the coupling pattern in one pass over A, a task per range of columns
+	m_newPattern.assign(numConstraints * numConstraints, 0);
+	parallelFor(numConstraints, [this, &A, &rowConstraints, numConstraints, size](size_t, size_t begin, size_t end)
+	{
+		const size_t columnBegin = std::lower_bound(rowConstraints.begin(), rowConstraints.end(), begin) -
+								   rowConstraints.begin();
+		const size_t columnEnd = std::lower_bound(rowConstraints.begin(), rowConstraints.end(), end) -
+								 rowConstraints.begin();
+		for (size_t column = columnBegin; column < columnEnd; ++column)
+		{
+			char* pattern = &m_newPattern[rowConstraints[column] * numConstraints];
+			for (size_t row = 0; row < size; ++row)
+			{
+				if (A(row, column) != 0.0)
+				{
+					pattern[rowConstraints[row]] = 1;
+				}
+			}
+		}
+	});
+
+	if (m_newPattern == m_pattern && problem.constraintTypes == m_constraintTypes)
+	{
+		return;
+	}
+	m_pattern.swap(m_newPattern);
+	m_constraintTypes = problem.constraintTypes;
+
+	m_blocks.resize(numConstraints);
+	size_t index = 0;
+	size_t numLeadingBilaterals = 0;
+	for (size_t constraint = 0; constraint < numConstraints; ++constraint)
+	{
+		ConstraintBlock& block = m_blocks[constraint];
+		block.type = problem.constraintTypes[constraint];
+		block.index = index;
+		block.size = getNumAtomicConstraints(block.type);
+		block.coupling.clear();
+		block.enforced.clear();
+		index += block.size;
+
+		if (numLeadingBilaterals == constraint && getNumEnforcedAtomicConstraints(block.type) == 0)
+		{
+			++numLeadingBilaterals;
+		}
+	}
+
+	// The couplings, in both directions in case of round-off
+	std::vector<std::vector<size_t>> neighbors(numConstraints);
+	parallelFor(numConstraints, [this, &neighbors, numConstraints, numLeadingBilaterals](size_t, size_t begin,
+				size_t end)
+	{
+		for (size_t constraint = begin; constraint < end; ++constraint)
+		{
+			ConstraintBlock& block = m_blocks[constraint];
+			for (size_t other = 0; other < numConstraints; ++other)
+			{
+				const ConstraintBlock& otherBlock = m_blocks[other];
+				if (other != constraint && m_pattern[other * numConstraints + constraint] == 0 &&
+					m_pattern[constraint * numConstraints + other] == 0)
+				{
+					continue;
+				}
+
+				neighbors[constraint].push_back(other);
+				if (!block.coupling.empty() &&
+					block.coupling.back().first + block.coupling.back().second == otherBlock.index)
+				{
+					block.coupling.back().second += otherBlock.size;
+				}
+				else
+				{
+					block.coupling.emplace_back(otherBlock.index, otherBlock.size);
+				}
+				if (other < numLeadingBilaterals && constraint >= numLeadingBilaterals &&
+					getNumEnforcedAtomicConstraints(block.type) > 0)
+				{
+					block.enforced.push_back(other);
+				}
+			}
+		}
+	});
+
+	// Greedy coloring, a constraint writes its forces and the ones of its enforced constraints, and reads the forces
+	// coupled with them. Two constraints conflict if one reads what the other writes, which is symmetric.
+	m_colors.clear();
+	std::vector<size_t> colors(numConstraints);
+	std::vector<std::vector<size_t>> writers(numConstraints);
+	std::vector<size_t> forbidden;
+	for (size_t constraint = 0; constraint < numConstraints; ++constraint)
+	{
+		std::vector<size_t> written(1, constraint);
+		written.insert(written.end(), m_blocks[constraint].enforced.begin(), m_blocks[constraint].enforced.end());
+
+		for (size_t writtenConstraint : written)
+		{
+			for (size_t readConstraint : neighbors[writtenConstraint])
+			{
+				for (size_t writer : writers[readConstraint])
+				{
+					forbidden.push_back(colors[writer]);
+				}
+			}
+		}
+		std::sort(forbidden.begin(), forbidden.end());
+		forbidden.erase(std::unique(forbidden.begin(), forbidden.end()), forbidden.end());
+
+		size_t color = 0;
+		while (color < forbidden.size() && forbidden[color] == color)
+		{
+			++color;
+		}
+		forbidden.clear();
+
+		if (color == m_colors.size())
+		{
+			m_colors.emplace_back();
+		}
+		m_colors[color].push_back(constraint);
+		colors[constraint] = color;
+		for (size_t writtenConstraint : written)
+		{
+			writers[writtenConstraint].push_back(constraint);
+		}
+	}
+}
+
+void MlcpColoredGaussSeidelSolver::parallelFor(size_t count,
+		const std::function<void(size_t, size_t, size_t)>& function) const
+{
+	// A pool thread waiting for tasks queued behind it could wait forever
+	const size_t numTasks = std::min(count / m_minConstraintsPerTask, m_maxNumTasks);
+	if (numTasks < 2 || m_threadPool->isWorkerThread())
+	{
+		function(0, 0, count);
+		return;
+	}
+
+	std::vector<std::future<void>> tasks;
+	tasks.reserve(numTasks - 1);
+	for (size_t task = 1; task < numTasks; ++task)
+	{
+		const size_t begin = count * task / numTasks;
+		const size_t end = count * (task + 1) / numTasks;
+		tasks.push_back(m_threadPool->enqueue<void>([&function, task, begin, end]()
+		{
+			function(task, begin, end);
+		}));
+	}
+
+	// The calling thread takes the first range, and waits for the others which refer to the function
+	try
+	{
+		function(0, 0, count / numTasks);
+	}
+	catch (...)
+	{
+		for (auto& task : tasks)
+		{
+			task.wait();
+		}
+		throw;
+	}
+
+	// All the tasks are done before the first failure is rethrown
+	for (auto& task : tasks)
+	{
+		task.wait();
+	}
+	for (auto& task : tasks)
+	{
+		task.get();
+	}
+}
+
+Vector MlcpColoredGaussSeidelSolver::computeViolation(const MlcpProblem& problem, const MlcpSolution::Vector& x,
+		const ConstraintBlock& block, size_t index, size_t size) const
+{
+	Vector violation = problem.b.segment(index, size);
+	for (const auto& range : block.coupling)
+	{
+		violation += problem.A.block(index, range.first, size, range.second) * x.segment(range.first, range.second);
+	}
+	return violation;
+}
+
+void MlcpColoredGaussSeidelSolver::updateConstraint(const MlcpProblem& problem, MlcpSolution::Vector* x,
+		const ConstraintBlock& block, EnforcementSystem* system) const
+{
+	const MlcpProblem::Matrix& A = problem.A;
+	const size_t index = block.index;
+
+	switch (block.type)
+	{
+		case MLCP_BILATERAL_1D_CONSTRAINT:
+		{
+			(*x)[index] -= computeViolation(problem, *x, block, index, 1)[0] / A(index, index);
+			return;
+		}
+
+		case MLCP_BILATERAL_2D_CONSTRAINT:
+		{
+			x->segment<2>(index) -=
+				A.block<2, 2>(index, index).inverse() * computeViolation(problem, *x, block, index, 2);
+			return;
+		}
+
+		case MLCP_BILATERAL_3D_CONSTRAINT:
+		{
+			x->segment<3>(index) -=
+				A.block<3, 3>(index, index).inverse() * computeViolation(problem, *x, block, index, 3);
+			return;
+		}
+
+		default:
+			break;
+	}
+
+	// Form the local system with the enforced leading bilateral constraints, for the normal part only
+	const size_t numNormals = getNumEnforcedAtomicConstraints(block.type);
+	size_t numEnforced = 0;
+	for (size_t enforced : block.enforced)
+	{
+		numEnforced += m_blocks[enforced].size;
+	}
+	system->lhs.resize(numEnforced + numNormals, numEnforced + numNormals);
+	system->rhs.resize(numEnforced + numNormals);
+
+	size_t row = 0;
+	for (size_t enforced : block.enforced)
+	{
+		const ConstraintBlock& rowBlock = m_blocks[enforced];
+		system->rhs.segment(row, rowBlock.size) = computeViolation(problem, *x, rowBlock, rowBlock.index,
+												  rowBlock.size);
+		size_t column = 0;
+		for (size_t other : block.enforced)
+		{
+			const ConstraintBlock& columnBlock = m_blocks[other];
+			system->lhs.block(row, column, rowBlock.size, columnBlock.size) =
+				A.block(rowBlock.index, columnBlock.index, rowBlock.size, columnBlock.size);
+			column += columnBlock.size;
+		}
+		system->lhs.block(row, numEnforced, rowBlock.size, numNormals) =
+			A.block(rowBlock.index, index, rowBlock.size, numNormals);
+		system->lhs.block(numEnforced, row, numNormals, rowBlock.size) =
+			A.block(index, rowBlock.index, numNormals, rowBlock.size);
+		row += rowBlock.size;
+	}
+	system->rhs.tail(numNormals) = computeViolation(problem, *x, block, index, numNormals);
+	system->lhs.bottomRightCorner(numNormals, numNormals) = A.block(index, index, numNormals, numNormals);
+
+	// Solve A.f = violation, and correct the forces accordingly
+	system->correction = system->lhs.partialPivLu().solve(system->rhs);
+	row = 0;
+	for (size_t enforced : block.enforced)
+	{
+		const ConstraintBlock& rowBlock = m_blocks[enforced];
+		x->segment(rowBlock.index, rowBlock.size) -= system->correction.segment(row, rowBlock.size);
+		row += rowBlock.size;
+	}
+	x->segment(index, numNormals) -= system->correction.tail(numNormals);
+
+	bool inactive = false;
+	switch (block.type)
+	{
+		case MLCP_UNILATERAL_3D_FRICTIONLESS_CONSTRAINT:
+		{
+			if ((*x)[index] < 0.0)
+			{
+				(*x)[index] = 0.0;      // inactive contact on normal
+				inactive = true;
+			}
+			break;
+		}
+
+		case MLCP_UNILATERAL_3D_FRICTIONAL_CONSTRAINT:
+		{
+			double& Fn = (*x)[index];
+			Eigen::VectorBlock<MlcpSolution::Vector, 2> Ft = x->segment<2>(index + 1);
+			if (Fn > 0.0)
+			{
+				// Compute the frictions violation
+				Ft -= 2.0 * computeViolation(problem, *x, block, index + 1, 2) /
+					  (A(index + 1, index + 1) + A(index + 2, index + 2));
+
+				const double maxFriction = problem.mu[index] * Fn;
+				if (Ft.norm() > maxFriction)
+				{
+					// Here, the Friction is too strong, we keep the direction, but modulate its length
+					// to verify the Coulomb's law: |Ft| = mu |Fn|
+					Ft = Ft.normalized() * maxFriction;
+				}
+			}
+			else
+			{
+				Fn = 0.0;      // inactive contact on normal
+				Ft.setZero();  // inactive contact on tangent
+				inactive = true;
+			}
+			break;
+		}
+
+		case MLCP_BILATERAL_FRICTIONAL_SLIDING_CONSTRAINT:
+		{
+			// No Signorini to verify here, complete the violation of the friction along t
+			double& Ft = (*x)[index + 2];
+			Ft -= computeViolation(problem, *x, block, index + 2, 1)[0] / A(index + 2, index + 2);
+
+			const double maxFriction = problem.mu[index] * x->segment<2>(index).norm();
+			const double ftNorm = fabs(Ft);
+			if (ftNorm > maxFriction)
+			{
+				// Here, the Friction is too strong, we keep the direction, but modulate its length
+				// to verify the Coulomb's law: |Ft| = mu |Fn|
+				Ft *= maxFriction / ftNorm;
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	// The correction of the enforced constraints assumed an active contact, enforce them again without it
+	if (inactive && numEnforced > 0)
+	{
+		row = 0;
+		for (size_t enforced : block.enforced)
+		{
+			const ConstraintBlock& rowBlock = m_blocks[enforced];
+			system->rhs.segment(row, rowBlock.size) = computeViolation(problem, *x, rowBlock, rowBlock.index,
+													  rowBlock.size);
+			row += rowBlock.size;
+		}
+		system->correction = system->lhs.topLeftCorner(numEnforced, numEnforced).partialPivLu().solve(
+								 system->rhs.head(numEnforced));
+		row = 0;
+		for (size_t enforced : block.enforced)
+		{
+			const ConstraintBlock& rowBlock = m_blocks[enforced];
+			x->segment(rowBlock.index, rowBlock.size) -= system->correction.segment(row, rowBlock.size);
+			row += rowBlock.size;
+		}
+	}
+}
+
+void MlcpColoredGaussSeidelSolver::calculateConvergenceCriteria(const MlcpProblem& problem,
+		const MlcpSolution::Vector& x, double constraintConvergenceCriteria[MLCP_NUM_CONSTRAINT_TYPES],
+		double* convergenceCriteria, bool* validSignorini)
+{
+	const size_t numConstraints = m_blocks.size();
+	m_criteria.assign(numConstraints, 0.0);
+	m_signorini.assign(numConstraints, 1);
+
+	parallelFor(numConstraints, [this, &problem, &x](size_t, size_t begin, size_t end)
+	{
+		for (size_t constraint = begin; constraint < end; ++constraint)
+		{
+			const ConstraintBlock& block = m_blocks[constraint];
+			switch (block.type)
+			{
+				case MLCP_UNILATERAL_3D_FRICTIONLESS_CONSTRAINT:
+				case MLCP_UNILATERAL_3D_FRICTIONAL_CONSTRAINT:
+				{
+					const double violation = computeViolation(problem, x, block, block.index, 1)[0];
+					// Enforce orthogonality condition
+					if (!SurgSim::Math::isValid(violation) || violation < -m_contactTolerance ||
+						(x[block.index] > m_epsilonConvergence && violation > m_contactTolerance))
+					{
+						m_signorini[constraint] = 0;
+					}
+					break;
+				}
+
+				case MLCP_BILATERAL_FRICTIONAL_SLIDING_CONSTRAINT:
+				{
+					// We verify that the sliding point is on the line...no matter what the friction violation is
+					m_criteria[constraint] = computeViolation(problem, x, block, block.index, 2).norm();
+					break;
+				}
+
+				default:
+				{
+					m_criteria[constraint] = computeViolation(problem, x, block, block.index, block.size).norm();
+					break;
+				}
+			}
+		}
+	});
+
+	for (size_t type = 0; type < MLCP_NUM_CONSTRAINT_TYPES; ++type)
+	{
+		constraintConvergenceCriteria[type] = 0.0;
+	}
+	*convergenceCriteria = 0.0;
+	*validSignorini = true;
+	size_t nbNonContactConstraints = 0;
+	for (size_t constraint = 0; constraint < numConstraints; ++constraint)
+	{
+		const MlcpConstraintType type = m_blocks[constraint].type;
+		if (type == MLCP_UNILATERAL_3D_FRICTIONLESS_CONSTRAINT || type == MLCP_UNILATERAL_3D_FRICTIONAL_CONSTRAINT)
+		{
+			*validSignorini = *validSignorini && (m_signorini[constraint] != 0);
+		}
+		else
+		{
+			*convergenceCriteria += m_criteria[constraint];
+			constraintConvergenceCriteria[type] += m_criteria[constraint];
+			++nbNonContactConstraints;
+		}
+	}
+
+	if (nbNonContactConstraints > 0)
+	{
+		*convergenceCriteria /= nbNonContactConstraints;    // normalize if necessary
+	}
+}
+
+};  // namespace Math
+};  // namespace SurgSim
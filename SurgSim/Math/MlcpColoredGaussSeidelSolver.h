@@ -0,0 +1,233 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_MATH_MLCPCOLOREDGAUSSSEIDELSOLVER_H
+#define SURGSIM_MATH_MLCPCOLOREDGAUSSSEIDELSOLVER_H
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SurgSim/Math/Matrix.h"
+#include "SurgSim/Math/MlcpProblem.h"
+#include "SurgSim/Math/MlcpSolver.h"
+#include "SurgSim/Math/MlcpSolution.h"
+#include "SurgSim/Math/Vector.h"
+
+namespace SurgSim
+{
+namespace Framework
+{
+class Logger;
+class ThreadPool;
+}
+
+namespace Math
+{
+
+/// A solver for mixed LCP problems using a colored (multi-color ordered) Gauss-Seidel iterative method, which updates
+/// the constraints concurrently on the runtime thread pool.
+///
+/// The problem and the per-constraint updates are the same as the ones of MlcpGaussSeidelSolver, including the
+/// Coulomb friction of the frictional unilateral and frictional sliding constraints, but the constraints are not
+/// updated in the same order. Two constraints with a zero coupling block in A (e.g. acting on different
+/// representations) can't see each other's forces, so they can be updated at the same time.
+/// The constraints are colored greedily such that the constraints of a color don't read the forces written by the
+/// others, the colors are swept in order, and the constraints of a color are split in tasks for the thread pool.
+/// The products A.x are also only computed over the coupled blocks of A.
+///
+/// The coupling pattern of A is found by one pass over A per solve, the couplings and the colors are only rebuilt
+/// when this pattern or the constraint types change.
+///
+/// Unlike MlcpGaussSeidelSolver, which enforces the unilateral and sliding constraints together with all the leading
+/// bilateral constraints (the 1D, 2D and 3D bilateral constraints appearing first in the list), a constraint is only
+/// enforced together with the leading bilateral constraints it is coupled with in A. When a contact turns out to be
+/// inactive, its enforced constraints are enforced again without it, instead of keeping the correction computed
+/// with its (clamped) negative force.
+/// \note The serial and parallel updates of the colors give the same results, but because of the update order the
+/// iterates and the number of iterations differ from the ones of MlcpGaussSeidelSolver. The solutions only agree
+/// within the precision (around 1e-6 on the unit tests), and the frictional contacts of a problem with several
+/// solutions can converge toward another one.
+/// \note The tasks are run on Framework::Runtime::getThreadPool(). When solving from one of its tasks, everything is
+/// run on the calling thread instead.
+/// \sa MlcpGaussSeidelSolver
+class MlcpColoredGaussSeidelSolver : public MlcpSolver
+{
+public:
+	/// Constructor.
+	MlcpColoredGaussSeidelSolver();
+
+	/// Constructor.
+	/// \param epsilonConvergence The precision.
+	/// \param contactTolerance The contact tolerance.
+	/// \param maxIterations The max iterations.
+	MlcpColoredGaussSeidelSolver(double epsilonConvergence, double contactTolerance, size_t maxIterations);
+
+	/// Destructor.
+	virtual ~MlcpColoredGaussSeidelSolver();
+
+	/// Resolution of a given MLCP (colored Gauss Seidel iterative solver)
+	/// \param problem The mlcp problem
+	/// \param [out] solution The mlcp solution
+	/// \return true if successfully converged.
+	bool solve(const MlcpProblem& problem, MlcpSolution* solution) override;
+
+	/// \return The precision.
+	double getEpsilonConvergence() const;
+
+	/// Set the precision.
+	/// \param precision The precision.
+	void setEpsilonConvergence(double precision);
+
+	/// \return The contact tolerance.
+	double getContactTolerance() const;
+
+	/// Set the contact tolerance.
+	/// \param tolerance The contact tolerance.
+	void setContactTolerance(double tolerance);
+
+	/// \return The max number of iterations.
+	size_t getMaxIterations() const;
+
+	/// Set the max number of iterations.
+	/// \param maxIterations The max number of iterations.
+	void setMaxIterations(size_t maxIterations);
+
+	/// \return The minimum number of constraints per task.
+	size_t getMinConstraintsPerTask() const;
+
+	/// Set the minimum number of constraints updated by a task, a color with fewer constraints than twice this number
+	/// is updated on the calling thread.
+	/// \param numConstraints The minimum number of constraints per task, has to be positive.
+	void setMinConstraintsPerTask(size_t numConstraints);
+
+	/// \return The maximum number of tasks updating a color at once.
+	size_t getMaxNumTasks() const;
+
+	/// Set the maximum number of tasks updating a color at once, the calling thread running one of them.
+	/// \param numTasks The maximum number of tasks, has to be positive, defaults to the number of hardware threads.
+	void setMaxNumTasks(size_t numTasks);
+
+	/// \return The number of colors of the last solved problem.
+	size_t getNumColors() const;
+
+private:
+	/// A constraint of the problem, with its coupling to the other constraints
+	struct ConstraintBlock
+	{
+		/// The type of the constraint
+		MlcpConstraintType type;
+
+		/// The index of the first atomic constraint
+		size_t index;
+
+		/// The number of atomic constraints
+		size_t size;
+
+		/// The ranges of atomic constraints (first index, size) coupled with this constraint in A, itself included
+		std::vector<std::pair<size_t, size_t>> coupling;
+
+		/// The leading bilateral constraints enforced with this constraint
+		std::vector<size_t> enforced;
+	};
+
+	/// The local system of an enforced constraint
+	struct EnforcementSystem
+	{
+		/// The left-hand side matrix.
+		Matrix lhs;
+
+		/// The right-hand side vector.
+		Vector rhs;
+
+		/// The correction of the forces.
+		Vector correction;
+	};
+
+	/// Build the constraint blocks and the coupling pattern of A, and if they changed, rebuild the couplings and the
+	/// colors.
+	/// \param problem The mlcp problem
+	void buildColors(const MlcpProblem& problem);
+
+	/// Run a function on the ranges [begin, end) of the items [0, count), split in tasks for the thread pool.
+	/// \param count The number of items
+	/// \param function The function to run on each range, taking the index of the task in [0, m_maxNumTasks), begin
+	/// and end
+	void parallelFor(size_t count, const std::function<void(size_t, size_t, size_t)>& function) const;
+
+	/// \return The violation of the rows [index, index + size) of the given constraint, b + A.x
+	Vector computeViolation(const MlcpProblem& problem, const MlcpSolution::Vector& x,
+							const ConstraintBlock& block, size_t index, size_t size) const;
+
+	/// Update the force of a constraint, and of the leading bilateral constraints it is enforced with.
+	void updateConstraint(const MlcpProblem& problem, MlcpSolution::Vector* x, const ConstraintBlock& block,
+						  EnforcementSystem* system) const;
+
+	void calculateConvergenceCriteria(const MlcpProblem& problem, const MlcpSolution::Vector& x,
+									  double constraintConvergenceCriteria[MLCP_NUM_CONSTRAINT_TYPES],
+									  double* convergenceCriteria, bool* validSignorini);
+
+	/// The precision.
+	double m_epsilonConvergence;
+
+	/// The contact tolerance.
+	double m_contactTolerance;
+
+	/// The maximum number of iterations
+	size_t m_maxIterations;
+
+	/// The minimum number of constraints per task
+	size_t m_minConstraintsPerTask;
+
+	/// The maximum number of tasks run at once
+	size_t m_maxNumTasks;
+
+	/// The constraints of the last solved problem
+	std::vector<ConstraintBlock> m_blocks;
+
+	/// The colors, each one holding the indices of its constraints
+	std::vector<std::vector<size_t>> m_colors;
+
+	/// The constraint types of the last solved problem
+	std::vector<MlcpConstraintType> m_constraintTypes;
+
+	/// The coupling pattern of the last solved problem, non zero if the block (row, column) of A is, stored in
+	/// column-major order, as char to be written concurrently
+	std::vector<char> m_pattern;
+
+	/// The coupling pattern of the problem being solved
+	std::vector<char> m_newPattern;
+
+	/// The local systems of the enforced constraints, one per task
+	std::vector<EnforcementSystem> m_systems;
+
+	/// The convergence criteria of each constraint
+	std::vector<double> m_criteria;
+
+	/// The Signorini condition of each constraint, as char to be written concurrently
+	std::vector<char> m_signorini;
+
+	/// The thread pool
+	std::shared_ptr<SurgSim::Framework::ThreadPool> m_threadPool;
+
+	/// The logger.
+	std::shared_ptr<SurgSim::Framework::Logger> m_logger;
+};
+
+};  // namespace Math
+};  // namespace SurgSim
+
+#endif // SURGSIM_MATH_MLCPCOLOREDGAUSSSEIDELSOLVER_H
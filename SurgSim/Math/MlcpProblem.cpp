@@ -15,6 +15,21 @@
 
 #include "SurgSim/Math/MlcpProblem.h"
 
+#include <cstdint>
+
+#include "SurgSim/DataStructures/BinaryCache.h"
+
+namespace
+{
+
+/// Type name identifying the binary files of the problems
+const char* const typeName = "SurgSim::Math::MlcpProblem";
+
+/// The problems are not cached from a source file, their files have no source hash
+const uint64_t noSourceHash = 0;
+
+}
+
 namespace SurgSim
 {
 namespace Math
@@ -42,5 +57,47 @@ MlcpProblem MlcpProblem::Zero(size_t numDof, size_t numConstraintDof, size_t num
 
 }
 
+bool MlcpProblem::save(const std::string& fileName) const
+{
+	DataStructures::BinaryCacheWriter writer(typeName, noSourceHash);
+	writer.write(static_cast<uint64_t>(A.rows()));
+	writer.write(std::vector<double>(A.data(), A.data() + A.size()));
+	writer.write(std::vector<double>(b.data(), b.data() + b.size()));
+	writer.write(std::vector<double>(mu.data(), mu.data() + mu.size()));
+	writer.write(std::vector<int32_t>(constraintTypes.begin(), constraintTypes.end()));
+	return writer.save(fileName);
+}
+
+bool MlcpProblem::load(const std::string& fileName)
+{
+	DataStructures::BinaryCacheReader reader(fileName, typeName, noSourceHash);
+	uint64_t size;
+	std::vector<double> matrix, vector, frictions;
+	std::vector<int32_t> types;
+	if (!reader.isValid() || !reader.read(&size) || !reader.read(&matrix) || !reader.read(&vector) ||
+		!reader.read(&frictions) || !reader.read(&types) || !reader.isAtEnd() ||
+		matrix.size() != size * size || vector.size() != size)
+	{
+		return false;
+	}
+
+	std::vector<MlcpConstraintType> constraints;
+	for (int32_t type : types)
+	{
+		if (type < 0 || type >= MLCP_NUM_CONSTRAINT_TYPES)
+		{
+			return false;
+		}
+		constraints.push_back(static_cast<MlcpConstraintType>(type));
+	}
+
+	const Eigen::Index n = static_cast<Eigen::Index>(size);
+	A = Eigen::Map<const Matrix>(matrix.data(), n, n);
+	b = Eigen::Map<const Vector>(vector.data(), n);
+	mu = Eigen::Map<const Vector>(frictions.data(), static_cast<Eigen::Index>(frictions.size()));
+	constraintTypes.swap(constraints);
+	return isConsistent();
+}
+
 } // namespace SurgSim
 } // namespace Math
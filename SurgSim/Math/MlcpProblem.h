@@ -16,6 +16,7 @@
 #ifndef SURGSIM_MATH_MLCPPROBLEM_H
 #define SURGSIM_MATH_MLCPPROBLEM_H
 
+#include <string>
 #include <vector>
 #include <Eigen/Core>
 #include "SurgSim/Math/MlcpConstraintType.h"
@@ -110,6 +111,17 @@ struct MlcpProblem
 	/// \param numConstraints the number of constraints for the MlcpProblem to be constructed.
 	/// \return An MlcpProblem appropriately sized and initialized to zero.
 	static MlcpProblem Zero(size_t numDof, size_t numConstraintDof, size_t numConstraints);
+
+	/// Writes the system (\f$\mathbf{A}\f$, \f$b\f$, \f$\mu\f$ and the constraint types) to a compact binary file,
+	/// e.g. to capture the problems of a live simulation and replay them offline.
+	/// \param fileName Name of the file
+	/// \return true if the file was written successfully, false otherwise
+	bool save(const std::string& fileName) const;
+
+	/// Reads a system written by save()
+	/// \param fileName Name of the file
+	/// \return true if the file could be read and the system is consistent, false otherwise
+	bool load(const std::string& fileName);
 };
 
 };  // namespace Math
@@ -45,6 +45,7 @@ enum IntegrationScheme
 	INTEGRATIONSCHEME_LINEAR_EULER_IMPLICIT,
 	INTEGRATIONSCHEME_RUNGE_KUTTA_4,
 	INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4,
+	INTEGRATIONSCHEME_EULER_IMPLICIT_QUASI_NEWTON,
 	MAX_INTEGRATIONSCHEMES
 };
 
@@ -59,7 +60,8 @@ const std::unordered_map<IntegrationScheme, std::string, std::hash<int>> Integra
 			(INTEGRATIONSCHEME_EULER_IMPLICIT, "INTEGRATIONSCHEME_EULER_IMPLICIT")
 			(INTEGRATIONSCHEME_LINEAR_EULER_IMPLICIT, "INTEGRATIONSCHEME_LINEAR_EULER_IMPLICIT")
 			(INTEGRATIONSCHEME_RUNGE_KUTTA_4, "INTEGRATIONSCHEME_RUNGE_KUTTA_4")
-			(INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4, "INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4");
+			(INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4, "INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4")
+			(INTEGRATIONSCHEME_EULER_IMPLICIT_QUASI_NEWTON, "INTEGRATIONSCHEME_EULER_IMPLICIT_QUASI_NEWTON");
 
 /// Base class for all solvers of ode equation of order 2 of the form \f$M(x(t), v(t)).a(t) = f(t, x(t), v(t))\f$. <br>
 /// This ode equation is solved as an ode of order 1 by defining the state vector
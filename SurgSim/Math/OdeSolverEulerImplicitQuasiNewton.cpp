@@ -0,0 +1,105 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Math/OdeSolverEulerImplicitQuasiNewton.h"
+#include "SurgSim/Math/OdeState.h"
+
+namespace SurgSim
+{
+
+namespace Math
+{
+
+OdeSolverEulerImplicitQuasiNewton::OdeSolverEulerImplicitQuasiNewton(OdeEquation* equation)
+	: OdeSolverEulerImplicit(equation), m_dt(0.0), m_numIterations(0)
+{
+	m_name = "Ode Solver Euler Implicit Quasi-Newton";
+
+	// The iterations being cheap, use a few of them by default to handle the non-linearities.
+	setNewtonRaphsonMaximumIteration(5);
+}
+
+size_t OdeSolverEulerImplicitQuasiNewton::getNumIterations() const
+{
+	return m_numIterations;
+}
+
+void OdeSolverEulerImplicitQuasiNewton::solve(double dt, const OdeState& currentState, OdeState* newState,
+		bool computeCompliance)
+{
+	// The system matrix is factorized on the first iteration if the time step changed.
+	const bool factorize = (dt != m_dt);
+
+	*newState = currentState;
+
+	m_numIterations = 0;
+	while (m_numIterations < m_maximumIteration)
+	{
+		// Local step: evaluate the forces on the current estimate and assemble the RHS
+		assembleLinearSystem(dt, currentState, *newState);
+
+		// Global step: solve the prefactorized system for the correction of the velocities
+		m_solution = m_linearSolver->solve(m_rhs);
+
+		newState->getVelocities() += m_solution;
+		newState->getPositions()  = currentState.getPositions() + dt * newState->getVelocities();
+
+		m_numIterations++;
+
+		// Use the infinity norm, to treat models with small or large number of dof the same way.
+		if (m_solution.lpNorm<Eigen::Infinity>() < m_epsilonConvergence)
+		{
+			break;
+		}
+	}
+
+	if (factorize)
+	{
+		computeComplianceMatrixFromSystemMatrix(currentState);
+	}
+}
+
+void OdeSolverEulerImplicitQuasiNewton::assembleLinearSystem(double dt, const OdeState& state,
+		const OdeState& newState, bool computeRHS)
+{
+	if (dt != m_dt)
+	{
+		m_equation.updateFMDK(newState, ODEEQUATIONUPDATE_FMDK);
+
+		m_constantM = m_equation.getM().pruned();
+		m_constantK = m_equation.getK().pruned();
+
+		m_systemMatrix = m_constantM * (1.0 / dt) + m_equation.getD() + m_constantK * dt;
+		state.applyBoundaryConditionsToMatrix(&m_systemMatrix);
+		m_linearSolver->setMatrix(m_systemMatrix);
+		m_dt = dt;
+	}
+	else if (computeRHS)
+	{
+		m_equation.updateFMDK(newState, ODEEQUATIONUPDATE_F);
+	}
+
+	if (computeRHS)
+	{
+		m_rhs = m_equation.getF();
+		m_rhs += m_constantK * (newState.getPositions() - state.getPositions() - newState.getVelocities() * dt);
+		m_rhs -= (m_constantM * (newState.getVelocities() - state.getVelocities())) / dt;
+		state.applyBoundaryConditionsToVector(&m_rhs);
+	}
+}
+
+}; // namespace Math
+
+}; // namespace SurgSim
@@ -0,0 +1,79 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_MATH_ODESOLVEREULERIMPLICITQUASINEWTON_H
+#define SURGSIM_MATH_ODESOLVEREULERIMPLICITQUASINEWTON_H
+
+#include "SurgSim/Math/OdeSolverEulerImplicit.h"
+#include "SurgSim/Math/SparseMatrix.h"
+
+namespace SurgSim
+{
+
+namespace Math
+{
+
+/// Quasi-Newton version of the Euler implicit ode solver, in the spirit of projective dynamics.
+/// The system matrix (M/dt + D + dt.K) is assembled and factorized once, on the first state solved (or when the time
+/// step changes), and kept constant. Each iteration then only evaluates the forces f(x, v) on the current estimate
+/// (the local step) and solves the prefactored system for the correction of the velocities (the global step):
+/// \f[
+///   (M_0/dt + D_0 + dt.K_0).\Delta v = f(x_n, v_n) + K_0.(x_n - x(t) - dt.v_n) - M_0.(v_n - v(t))/dt
+/// \f]
+/// A fixed point of these iterations is the exact implicit Euler solution, they converge linearly (rather than
+/// quadratically for Newton-Raphson) but at a predictable per-frame cost: no matrix is assembled nor factorized after
+/// the first time step, and the compliance matrix is constant.
+/// \note The iterations stop after the maximum number of iterations or once the correction \f$\Delta v\f$ is below the
+///       epsilon convergence (infinity norm).
+/// \note The boundary conditions are supposed to be constant.
+class OdeSolverEulerImplicitQuasiNewton : public OdeSolverEulerImplicit
+{
+public:
+	/// Constructor
+	/// \param equation The ode equation to be solved
+	explicit OdeSolverEulerImplicitQuasiNewton(OdeEquation* equation);
+
+	/// The parameter computeCompliance is irrelevant as the compliance matrix is constant.
+	/// It is computed whenever the system matrix is factorized, no matter the parameter value.
+	void solve(double dt, const OdeState& currentState, OdeState* newState, bool computeCompliance = true) override;
+
+	/// \return The number of iterations used by the last call to solve
+	size_t getNumIterations() const;
+
+protected:
+	/// \note The system matrix is only assembled from state the first time or when the time step changes, otherwise
+	///       only the forces are evaluated on newState to compute the RHS.
+	void assembleLinearSystem(double dt, const OdeState& state, const OdeState& newState,
+		bool computeRHS = true) override;
+
+private:
+	/// The constant mass matrix
+	SparseMatrix m_constantM;
+
+	/// The constant stiffness matrix
+	SparseMatrix m_constantK;
+
+	/// The time step the system matrix has been factorized with, 0 if it has not been factorized yet
+	double m_dt;
+
+	/// The number of iterations used by the last call to solve
+	size_t m_numIterations;
+};
+
+}; // namespace Math
+
+}; // namespace SurgSim
+
+#endif // SURGSIM_MATH_ODESOLVEREULERIMPLICITQUASINEWTON_H
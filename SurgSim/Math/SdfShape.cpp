@@ -0,0 +1,588 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Math/SdfShape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include "SurgSim/DataStructures/BinaryCache.h"
+#include "SurgSim/Framework/ApplicationData.h"
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Math/Geometry.h"
+#include "SurgSim/Math/MeshShape.h"
+
+namespace
+{
+/// The brick offset of the bricks that are not stored
+const size_t emptyBrick = std::numeric_limits<size_t>::max();
+}
+
+namespace SurgSim
+{
+
+namespace Math
+{
+SURGSIM_REGISTER(SurgSim::Math::Shape, SurgSim::Math::SdfShape, SdfShape);
+
+SdfShape::SdfShape() :
+	m_cellSize(0.001),
+	m_narrowBandWidth(0.005),
+	m_needsBuild(false),
+	m_origin(Vector3d::Zero()),
+	m_volume(0.0),
+	m_center(Vector3d::Zero()),
+	m_secondMomentOfVolume(Matrix33d::Zero())
+{
+	m_numNodes.fill(0);
+	m_numBricks.fill(0);
+
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(SdfShape, double, CellSize, getCellSize, setCellSize);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(SdfShape, double, NarrowBandWidth, getNarrowBandWidth, setNarrowBandWidth);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(SdfShape, std::string, MeshFileName, getMeshFileName, setMeshFileName);
+}
+
+int SdfShape::getType() const
+{
+	return SHAPE_TYPE_SDF;
+}
+
+double SdfShape::getVolume() const
+{
+	buildIfNeeded();
+	return m_volume;
+}
+
+Vector3d SdfShape::getCenter() const
+{
+	buildIfNeeded();
+	return m_center;
+}
+
+Matrix33d SdfShape::getSecondMomentOfVolume() const
+{
+	buildIfNeeded();
+	return m_secondMomentOfVolume;
+}
+
+bool SdfShape::isValid() const
+{
+	buildIfNeeded();
+	return !m_brickOffsets.empty();
+}
+
+const Math::Aabbd& SdfShape::getBoundingBox() const
+{
+	buildIfNeeded();
+	return m_boundingBox;
+}
+
+void SdfShape::setCellSize(double size)
+{
+	SURGSIM_ASSERT(size > 0.0) << "The cell size of a SdfShape needs to be strictly positive, it is " << size;
+	if (size != m_cellSize)
+	{
+		m_cellSize = size;
+		// The properties may be set in any order, a field loaded from a file is rebuilt when queried
+		m_needsBuild = !m_meshFileName.empty();
+	}
+}
+
+double SdfShape::getCellSize() const
+{
+	return m_cellSize;
+}
+
+void SdfShape::setNarrowBandWidth(double width)
+{
+	SURGSIM_ASSERT(width >= 0.0) << "The narrow band width of a SdfShape cannot be negative, it is " << width;
+	if (width != m_narrowBandWidth)
+	{
+		m_narrowBandWidth = width;
+		m_needsBuild = !m_meshFileName.empty();
+	}
+}
+
+double SdfShape::getNarrowBandWidth() const
+{
+	return m_narrowBandWidth;
+}
+
+void SdfShape::buildFromMesh(const MeshShape& mesh)
+{
+	boost::lock_guard<boost::mutex> lock(m_buildMutex);
+	buildField(mesh);
+	m_meshFileName.clear();
+	m_needsBuild = false;
+}
+
+void SdfShape::buildField(const MeshShape& mesh) const
+{
+	SURGSIM_ASSERT(mesh.getNumTriangles() > 0) << "Cannot build a SdfShape from a mesh without triangles";
+
+	Aabbd meshBox;
+	for (const auto& vertex : mesh.getVertices())
+	{
+		meshBox.extend(vertex.position);
+	}
+
+	const double padding = std::max(2.0 * m_cellSize, m_narrowBandWidth);
+	m_origin = meshBox.min() - Vector3d::Constant(padding);
+	const Vector3d sizes = meshBox.sizes() + Vector3d::Constant(2.0 * padding);
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		m_numNodes[axis] = static_cast<size_t>(std::ceil(sizes[axis] / m_cellSize)) + 1;
+		m_numBricks[axis] = (m_numNodes[axis] + BrickSize - 1) / BrickSize;
+	}
+	const size_t numNodes = m_numNodes[0] * m_numNodes[1] * m_numNodes[2];
+
+	// The nodes further than the narrow band width of all the triangles keep the narrow band width as distance
+	const bool isDense = (m_narrowBandWidth == 0.0);
+	std::vector<double> distances(numNodes, isDense ? std::numeric_limits<double>::max() : m_narrowBandWidth);
+	auto nodeRange = [this, isDense](double min, double max, size_t axis, size_t* first, size_t* last)
+	{
+		if (isDense)
+		{
+			*first = 0;
+			*last = m_numNodes[axis] - 1;
+			return;
+		}
+		const double low = std::floor((min - m_narrowBandWidth - m_origin[axis]) / m_cellSize);
+		const double high = std::ceil((max + m_narrowBandWidth - m_origin[axis]) / m_cellSize);
+		*first = static_cast<size_t>(std::max(low, 0.0));
+		*last = std::min(static_cast<size_t>(std::max(high, 0.0)), m_numNodes[axis] - 1);
+	};
+
+	// Sign by ray parity: the rays go along x through the (y, z) of the nodes, slightly shifted for the rays not to
+	// go through the edges of the mesh. The shift only affects the sign of nodes within the shift of the surface.
+	const double rayShiftY = 1.234567e-4 * m_cellSize;
+	const double rayShiftZ = 2.345678e-4 * m_cellSize;
+	std::vector<std::vector<double>> crossings(m_numNodes[1] * m_numNodes[2]);
+
+	Vector3d closestPoint;
+	const auto& triangles = mesh.getTriangles();
+	for (size_t triangleId = 0; triangleId < triangles.size(); ++triangleId)
+	{
+		if (!triangles[triangleId].isValid)
+		{
+			continue;
+		}
+		const auto vertices = mesh.getTrianglePositions(triangleId);
+		const Vector3d min = vertices[0].cwiseMin(vertices[1]).cwiseMin(vertices[2]);
+		const Vector3d max = vertices[0].cwiseMax(vertices[1]).cwiseMax(vertices[2]);
+
+		std::array<size_t, 3> first, last;
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			nodeRange(min[axis], max[axis], axis, &first[axis], &last[axis]);
+		}
+		for (size_t k = first[2]; k <= last[2]; ++k)
+		{
+			for (size_t j = first[1]; j <= last[1]; ++j)
+			{
+				for (size_t i = first[0]; i <= last[0]; ++i)
+				{
+					const Vector3d node = m_origin + m_cellSize * Vector3d(i, j, k);
+					const double distance = distancePointTriangle(node, vertices[0], vertices[1], vertices[2],
+											&closestPoint);
+					double& nodeDistance = distances[i + m_numNodes[0] * (j + m_numNodes[1] * k)];
+					nodeDistance = std::min(nodeDistance, distance);
+				}
+			}
+		}
+
+		// Intersections of the triangle with the rays, in the (y, z) plane
+		const Vector2d a(vertices[0][1], vertices[0][2]);
+		const Vector2d b(vertices[1][1], vertices[1][2]);
+		const Vector2d c(vertices[2][1], vertices[2][2]);
+		auto cross = [](const Vector2d& u, const Vector2d& v)
+		{
+			return u[0] * v[1] - u[1] * v[0];
+		};
+		const double area = cross(b - a, c - a);
+		if (std::abs(area) < std::numeric_limits<double>::epsilon() * (max - min).squaredNorm())
+		{
+			continue;
+		}
+		const double firstJ = std::ceil((min[1] - m_origin[1] - rayShiftY) / m_cellSize);
+		const double lastJ = std::floor((max[1] - m_origin[1] - rayShiftY) / m_cellSize);
+		const double firstK = std::ceil((min[2] - m_origin[2] - rayShiftZ) / m_cellSize);
+		const double lastK = std::floor((max[2] - m_origin[2] - rayShiftZ) / m_cellSize);
+		for (double k = std::max(firstK, 0.0); k <= lastK && k < m_numNodes[2]; ++k)
+		{
+			for (double j = std::max(firstJ, 0.0); j <= lastJ && j < m_numNodes[1]; ++j)
+			{
+				const Vector2d p(m_origin[1] + j * m_cellSize + rayShiftY, m_origin[2] + k * m_cellSize + rayShiftZ);
+				const double wa = cross(b - p, c - p) / area;
+				const double wb = cross(c - p, a - p) / area;
+				const double wc = 1.0 - wa - wb;
+				if (wa >= 0.0 && wb >= 0.0 && wc >= 0.0)
+				{
+					crossings[static_cast<size_t>(j) + m_numNodes[1] * static_cast<size_t>(k)].push_back(
+						wa * vertices[0][0] + wb * vertices[1][0] + wc * vertices[2][0]);
+				}
+			}
+		}
+	}
+
+	for (size_t k = 0; k < m_numNodes[2]; ++k)
+	{
+		for (size_t j = 0; j < m_numNodes[1]; ++j)
+		{
+			auto& rowCrossings = crossings[j + m_numNodes[1] * k];
+			std::sort(rowCrossings.begin(), rowCrossings.end());
+			size_t numCrossings = 0;
+			for (size_t i = 0; i < m_numNodes[0]; ++i)
+			{
+				const double x = m_origin[0] + i * m_cellSize;
+				while (numCrossings < rowCrossings.size() && rowCrossings[numCrossings] < x)
+				{
+					++numCrossings;
+				}
+				if (numCrossings % 2 == 1)
+				{
+					double& distance = distances[i + m_numNodes[0] * (j + m_numNodes[1] * k)];
+					distance = -distance;
+				}
+			}
+		}
+	}
+
+	// Compress the grid into bricks, dropping the bricks outside of the narrow band
+	m_brickOffsets.assign(m_numBricks[0] * m_numBricks[1] * m_numBricks[2], emptyBrick);
+	m_brickConstants.assign(m_brickOffsets.size(), 0.0f);
+	m_values.clear();
+	std::vector<float> brickValues(BrickSize * BrickSize * BrickSize);
+	const float narrowBandWidth = static_cast<float>(m_narrowBandWidth);
+	for (size_t brickK = 0; brickK < m_numBricks[2]; ++brickK)
+	{
+		for (size_t brickJ = 0; brickJ < m_numBricks[1]; ++brickJ)
+		{
+			for (size_t brickI = 0; brickI < m_numBricks[0]; ++brickI)
+			{
+				bool isFar = !isDense;
+				auto value = brickValues.begin();
+				for (size_t k = 0; k < BrickSize; ++k)
+				{
+					// The nodes beyond the grid replicate the last nodes, they are never queried
+					const size_t nodeK = std::min(brickK * BrickSize + k, m_numNodes[2] - 1);
+					for (size_t j = 0; j < BrickSize; ++j)
+					{
+						const size_t nodeJ = std::min(brickJ * BrickSize + j, m_numNodes[1] - 1);
+						for (size_t i = 0; i < BrickSize; ++i, ++value)
+						{
+							const size_t nodeI = std::min(brickI * BrickSize + i, m_numNodes[0] - 1);
+							const size_t node = nodeI + m_numNodes[0] * (nodeJ + m_numNodes[1] * nodeK);
+							*value = static_cast<float>(distances[node]);
+							isFar = isFar && (std::abs(*value) >= narrowBandWidth) &&
+									((*value < 0.0f) == (brickValues[0] < 0.0f));
+						}
+					}
+				}
+
+				const size_t brick = brickI + m_numBricks[0] * (brickJ + m_numBricks[1] * brickK);
+				if (isFar)
+				{
+					m_brickConstants[brick] = brickValues[0];
+				}
+				else
+				{
+					m_brickOffsets[brick] = m_values.size();
+					m_values.insert(m_values.end(), brickValues.begin(), brickValues.end());
+				}
+			}
+		}
+	}
+
+	m_boundingBox = Aabbd(m_origin, m_origin + m_cellSize * Vector3d(m_numNodes[0] - 1, m_numNodes[1] - 1,
+						  m_numNodes[2] - 1));
+	computeVolumeIntegrals();
+}
+
+void SdfShape::setMeshFileName(const std::string& fileName)
+{
+	m_meshFileName = fileName;
+	m_needsBuild = !m_meshFileName.empty();
+}
+
+void SdfShape::loadMesh(const std::string& fileName)
+{
+	setMeshFileName(fileName);
+	buildIfNeeded();
+}
+
+void SdfShape::buildIfNeeded() const
+{
+	if (!m_needsBuild)
+	{
+		return;
+	}
+
+	boost::lock_guard<boost::mutex> lock(m_buildMutex);
+	if (!m_needsBuild)
+	{
+		return;
+	}
+
+	auto data = Framework::Runtime::getApplicationData();
+	const std::string path = data->findFile(m_meshFileName);
+	SURGSIM_ASSERT(!path.empty()) << "Can not locate file " << m_meshFileName;
+
+	const bool result = DataStructures::loadWithBinaryCache(path, getClassName(),
+		std::bind(&SdfShape::readBinaryCache, this, std::placeholders::_1),
+		[this, &data]()
+		{
+			auto mesh = std::make_shared<MeshShape>();
+			mesh->load(m_meshFileName, *data);
+			buildField(*mesh);
+			return true;
+		},
+		std::bind(&SdfShape::writeBinaryCache, this, std::placeholders::_1));
+	SURGSIM_ASSERT(result) << "Failed to build the distance field of " << m_meshFileName;
+
+	m_needsBuild = false;
+}
+
+const std::string& SdfShape::getMeshFileName() const
+{
+	return m_meshFileName;
+}
+
+const Vector3d& SdfShape::getOrigin() const
+{
+	buildIfNeeded();
+	return m_origin;
+}
+
+const std::array<size_t, 3>& SdfShape::getNumNodes() const
+{
+	buildIfNeeded();
+	return m_numNodes;
+}
+
+size_t SdfShape::getNumStoredBricks() const
+{
+	buildIfNeeded();
+	return m_values.size() / (BrickSize * BrickSize * BrickSize);
+}
+
+double SdfShape::getDistance(const Vector3d& point) const
+{
+	return getDistance(point, nullptr);
+}
+
+double SdfShape::getDistance(const Vector3d& point, Vector3d* gradient) const
+{
+	SURGSIM_ASSERT(isValid()) << "The distance field has not been built";
+
+	const Vector3d gridPoint = (point - m_origin) / m_cellSize;
+	Vector3d clamped;
+	std::array<size_t, 3> cell;
+	Vector3d t;
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		const double last = static_cast<double>(m_numNodes[axis] - 1);
+		clamped[axis] = std::min(std::max(gridPoint[axis], 0.0), last);
+		cell[axis] = std::min(static_cast<size_t>(clamped[axis]), m_numNodes[axis] - 2);
+		t[axis] = clamped[axis] - static_cast<double>(cell[axis]);
+	}
+
+	const double v000 = getNodeValue(cell[0], cell[1], cell[2]);
+	const double v100 = getNodeValue(cell[0] + 1, cell[1], cell[2]);
+	const double v010 = getNodeValue(cell[0], cell[1] + 1, cell[2]);
+	const double v110 = getNodeValue(cell[0] + 1, cell[1] + 1, cell[2]);
+	const double v001 = getNodeValue(cell[0], cell[1], cell[2] + 1);
+	const double v101 = getNodeValue(cell[0] + 1, cell[1], cell[2] + 1);
+	const double v011 = getNodeValue(cell[0], cell[1] + 1, cell[2] + 1);
+	const double v111 = getNodeValue(cell[0] + 1, cell[1] + 1, cell[2] + 1);
+
+	// Interpolate along x, then y, then z
+	const double v00 = v000 + t[0] * (v100 - v000);
+	const double v10 = v010 + t[0] * (v110 - v010);
+	const double v01 = v001 + t[0] * (v101 - v001);
+	const double v11 = v011 + t[0] * (v111 - v011);
+	const double v0 = v00 + t[1] * (v10 - v00);
+	const double v1 = v01 + t[1] * (v11 - v01);
+	double distance = v0 + t[2] * (v1 - v0);
+
+	const Vector3d outside = gridPoint - clamped;
+	const double outsideDistance = outside.norm() * m_cellSize;
+	distance += outsideDistance;
+
+	if (gradient != nullptr)
+	{
+		if (outsideDistance > 0.0)
+		{
+			*gradient = outside.normalized();
+		}
+		else
+		{
+			const double dx0 = (1.0 - t[1]) * (v100 - v000) + t[1] * (v110 - v010);
+			const double dx1 = (1.0 - t[1]) * (v101 - v001) + t[1] * (v111 - v011);
+			const double dy0 = (1.0 - t[0]) * (v010 - v000) + t[0] * (v110 - v100);
+			const double dy1 = (1.0 - t[0]) * (v011 - v001) + t[0] * (v111 - v101);
+			(*gradient)[0] = (1.0 - t[2]) * dx0 + t[2] * dx1;
+			(*gradient)[1] = (1.0 - t[2]) * dy0 + t[2] * dy1;
+			(*gradient)[2] = v1 - v0;
+			*gradient /= m_cellSize;
+		}
+	}
+
+	return distance;
+}
+
+double SdfShape::getSegmentDistance(const Vector3d& start, const Vector3d& end, Vector3d* point) const
+{
+	const size_t numSamples = std::max(static_cast<size_t>(std::ceil((end - start).norm() / (0.5 * m_cellSize))),
+									   static_cast<size_t>(1));
+	double minDistance = std::numeric_limits<double>::max();
+	for (size_t sample = 0; sample <= numSamples; ++sample)
+	{
+		const Vector3d samplePoint = start + (end - start) * (static_cast<double>(sample) / numSamples);
+		const double distance = getDistance(samplePoint);
+		if (distance < minDistance)
+		{
+			minDistance = distance;
+			*point = samplePoint;
+		}
+	}
+	return minDistance;
+}
+
+double SdfShape::getNodeValue(size_t i, size_t j, size_t k) const
+{
+	const size_t brick = i / BrickSize + m_numBricks[0] * (j / BrickSize + m_numBricks[1] * (k / BrickSize));
+	const size_t offset = m_brickOffsets[brick];
+	if (offset == emptyBrick)
+	{
+		return m_brickConstants[brick];
+	}
+	return m_values[offset + i % BrickSize + BrickSize * (j % BrickSize + BrickSize * (k % BrickSize))];
+}
+
+void SdfShape::computeVolumeIntegrals() const
+{
+	// Each node inside the shape stands for a cube of the size of a cell
+	const double cellVolume = m_cellSize * m_cellSize * m_cellSize;
+	size_t numInside = 0;
+	Vector3d sum = Vector3d::Zero();
+	Matrix33d sumOuterProducts = Matrix33d::Zero();
+	for (size_t k = 0; k < m_numNodes[2]; ++k)
+	{
+		for (size_t j = 0; j < m_numNodes[1]; ++j)
+		{
+			for (size_t i = 0; i < m_numNodes[0]; ++i)
+			{
+				if (getNodeValue(i, j, k) < 0.0)
+				{
+					const Vector3d node = m_origin + m_cellSize * Vector3d(i, j, k);
+					++numInside;
+					sum += node;
+					sumOuterProducts += node * node.transpose();
+				}
+			}
+		}
+	}
+
+	m_volume = numInside * cellVolume;
+	if (numInside == 0)
+	{
+		m_center.setZero();
+		m_secondMomentOfVolume.setZero();
+		return;
+	}
+	m_center = sum / numInside;
+
+	// Second moment of volume, about the center: sum of (|r|^2.I - r.r^t) over the cells, each cell adding its own
+	// moment (cellVolume.cellSize^2/6 on the diagonal)
+	const Matrix33d covariance = (sumOuterProducts - numInside * m_center * m_center.transpose()) * cellVolume;
+	m_secondMomentOfVolume = covariance.trace() * Matrix33d::Identity() - covariance;
+	m_secondMomentOfVolume.diagonal().array() += m_volume * m_cellSize * m_cellSize / 6.0;
+}
+
+bool SdfShape::readBinaryCache(DataStructures::BinaryCacheReader* reader) const
+{
+	double cellSize, narrowBandWidth;
+	std::array<double, 3> origin;
+	std::array<uint64_t, 3> numNodes;
+	std::vector<size_t> brickOffsets;
+	std::vector<float> brickConstants, values;
+	if (!reader->read(&cellSize) || !reader->read(&narrowBandWidth) || !reader->read(&origin) ||
+		!reader->read(&numNodes) || !reader->read(&brickOffsets) || !reader->read(&brickConstants) ||
+		!reader->read(&values))
+	{
+		return false;
+	}
+
+	if (cellSize != m_cellSize || narrowBandWidth != m_narrowBandWidth || brickOffsets.empty() ||
+		brickConstants.size() != brickOffsets.size())
+	{
+		return false;
+	}
+
+	std::array<size_t, 3> numBricks;
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		if (numNodes[axis] < 2)
+		{
+			return false;
+		}
+		numBricks[axis] = (static_cast<size_t>(numNodes[axis]) + BrickSize - 1) / BrickSize;
+	}
+	if (brickOffsets.size() != numBricks[0] * numBricks[1] * numBricks[2])
+	{
+		return false;
+	}
+	for (auto offset : brickOffsets)
+	{
+		if (offset != emptyBrick && offset + BrickSize * BrickSize * BrickSize > values.size())
+		{
+			return false;
+		}
+	}
+
+	m_origin = Vector3d(origin[0], origin[1], origin[2]);
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		m_numNodes[axis] = static_cast<size_t>(numNodes[axis]);
+	}
+	m_numBricks = numBricks;
+	m_brickOffsets = std::move(brickOffsets);
+	m_brickConstants = std::move(brickConstants);
+	m_values = std::move(values);
+
+	m_boundingBox = Aabbd(m_origin, m_origin + m_cellSize * Vector3d(m_numNodes[0] - 1, m_numNodes[1] - 1,
+						  m_numNodes[2] - 1));
+	computeVolumeIntegrals();
+	return true;
+}
+
+void SdfShape::writeBinaryCache(DataStructures::BinaryCacheWriter* writer) const
+{
+	writer->write(m_cellSize);
+	writer->write(m_narrowBandWidth);
+	writer->write(std::array<double, 3>({{m_origin[0], m_origin[1], m_origin[2]}}));
+	writer->write(std::array<uint64_t, 3>({{m_numNodes[0], m_numNodes[1], m_numNodes[2]}}));
+	writer->write(m_brickOffsets);
+	writer->write(m_brickConstants);
+	writer->write(m_values);
+}
+
+}; // namespace Math
+
+}; // namespace SurgSim
@@ -0,0 +1,218 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_MATH_SDFSHAPE_H
+#define SURGSIM_MATH_SDFSHAPE_H
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include "SurgSim/Framework/ObjectFactory.h"
+#include "SurgSim/Math/Shape.h"
+
+namespace SurgSim
+{
+
+namespace DataStructures
+{
+class BinaryCacheReader;
+class BinaryCacheWriter;
+}
+
+namespace Math
+{
+SURGSIM_STATIC_REGISTRATION(SdfShape);
+
+class MeshShape;
+
+/// Signed distance field shape.
+/// The signed distance to a closed triangle mesh (negative inside, positive outside) is sampled on the nodes of a
+/// regular grid, and queried with a trilinear interpolation, making distance and gradient queries O(1) whatever the
+/// complexity of the mesh. It is meant for static (rigid) geometry, the field being expressed in the local frame of
+/// the shape.
+/// The grid is stored in bricks of BrickSize^3 nodes. With a narrow band, the bricks that are entirely further than
+/// the narrow band width from the surface are not stored, only their sign is kept (their distance being clamped to
+/// the narrow band width), which makes the memory footprint proportional to the area of the surface rather than to
+/// the volume of the grid.
+/// When loaded from a file, the field is built once, on its first query after the mesh file name, the cell size or
+/// the narrow band width have been set, so that these properties can be set (or decoded) in any order. The built
+/// field is cached (see DataStructures::loadWithBinaryCache).
+/// \note The mesh needs to be closed and consistently oriented for the sign to be meaningful.
+/// \note Without narrow band, the exact distance is computed on all the nodes, whose cost is proportional to the
+///       number of nodes times the number of triangles.
+class SdfShape : public Shape
+{
+public:
+	/// The number of nodes on each side of a brick
+	static const size_t BrickSize = 8;
+
+	/// Constructor
+	SdfShape();
+
+	SURGSIM_CLASSNAME(SurgSim::Math::SdfShape);
+
+	int getType() const override;
+
+	/// \note The volume is approximated by the nodes of the grid that are inside the shape
+	double getVolume() const override;
+
+	/// \note The center is approximated by the nodes of the grid that are inside the shape
+	Vector3d getCenter() const override;
+
+	/// \note The second moment of volume is approximated by the nodes of the grid that are inside the shape
+	Matrix33d getSecondMomentOfVolume() const override;
+
+	/// \return True if the distance field has been built; Otherwise, false.
+	bool isValid() const override;
+
+	const Math::Aabbd& getBoundingBox() const override;
+
+	/// Set the size of the cells of the grid, a field loaded from a file is rebuilt on its next query
+	/// \param size The size of the cells (in m)
+	void setCellSize(double size);
+
+	/// \return The size of the cells of the grid (in m)
+	double getCellSize() const;
+
+	/// Set the width of the narrow band, a field loaded from a file is rebuilt on its next query
+	/// \param width The distance from the surface under which the field is exact (in m), 0 for a dense field
+	void setNarrowBandWidth(double width);
+
+	/// \return The width of the narrow band (in m), 0 for a dense field, defaults to 5 mm
+	double getNarrowBandWidth() const;
+
+	/// Build the distance field of a closed triangle mesh, using the current cell size and narrow band width
+	/// \param mesh The mesh, in the local frame of the shape
+	/// \note The field does not come from a mesh file anymore, the mesh file name is cleared
+	void buildFromMesh(const MeshShape& mesh);
+
+	/// Set the closed triangle mesh file to build the distance field from, on its next query
+	/// \param fileName The name of the mesh file, relative to the application data
+	void setMeshFileName(const std::string& fileName);
+
+	/// Load a closed triangle mesh and build its distance field now, using the current cell size and narrow band
+	/// width
+	/// \param fileName The name of the mesh file, relative to the application data
+	void loadMesh(const std::string& fileName);
+
+	/// \return The name of the mesh file the field has been loaded from, empty if it has not been loaded from a file
+	const std::string& getMeshFileName() const;
+
+	/// \return The position of the first node of the grid
+	const Vector3d& getOrigin() const;
+
+	/// \return The number of nodes of the grid along each axis
+	const std::array<size_t, 3>& getNumNodes() const;
+
+	/// \return The number of bricks that are stored, i.e. that are within the narrow band
+	size_t getNumStoredBricks() const;
+
+	/// Query the signed distance
+	/// \param point The point, in the local frame of the shape
+	/// \return The signed distance of the point (negative inside the shape)
+	/// \note Outside of the grid, the distance to the grid is added to the distance of the closest point of the grid
+	double getDistance(const Vector3d& point) const;
+
+	/// Query the signed distance and its gradient
+	/// \param point The point, in the local frame of the shape
+	/// \param [out] gradient The gradient of the distance at point, i.e. the direction away from the surface
+	/// \return The signed distance of the point (negative inside the shape)
+	double getDistance(const Vector3d& point, Vector3d* gradient) const;
+
+	/// Find the point of a segment with the smallest signed distance.
+	/// The segment is sampled at half the cell size, which is the resolution of the field.
+	/// \param start, end The segment extremities, in the local frame of the shape
+	/// \param [out] point The point of the segment with the smallest signed distance
+	/// \return The smallest signed distance along the segment
+	double getSegmentDistance(const Vector3d& start, const Vector3d& end, Vector3d* point) const;
+
+private:
+	/// Build the field from the mesh file if it has not been built with the current parameters
+	void buildIfNeeded() const;
+
+	/// Build the field of a mesh, with the current parameters
+	/// \param mesh The mesh, in the local frame of the shape
+	void buildField(const MeshShape& mesh) const;
+
+	/// \return The value of a node of the grid
+	double getNodeValue(size_t i, size_t j, size_t k) const;
+
+	/// Compute the volume integrals from the nodes inside the shape
+	void computeVolumeIntegrals() const;
+
+	/// Read the field from a binary cache
+	/// \param reader The cache reader
+	/// \return true if the cache matches the current cell size and narrow band width, false otherwise
+	bool readBinaryCache(DataStructures::BinaryCacheReader* reader) const;
+
+	/// Write the field into a binary cache
+	/// \param writer The cache writer
+	void writeBinaryCache(DataStructures::BinaryCacheWriter* writer) const;
+
+	/// The size of the cells
+	double m_cellSize;
+
+	/// The width of the narrow band, 0 for a dense field
+	double m_narrowBandWidth;
+
+	/// The name of the mesh file the field is loaded from
+	std::string m_meshFileName;
+
+	/// True if the field needs to be built from the mesh file before being queried
+	mutable std::atomic<bool> m_needsBuild;
+
+	/// Mutex for building the field from the const queries
+	mutable boost::mutex m_buildMutex;
+
+	// The field is mutable, to be built by the first const query
+
+	/// The position of the first node
+	mutable Vector3d m_origin;
+
+	/// The number of nodes along each axis
+	mutable std::array<size_t, 3> m_numNodes;
+
+	/// The number of bricks along each axis
+	mutable std::array<size_t, 3> m_numBricks;
+
+	/// For each brick, the offset of its values in m_values, or the maximum size_t for the bricks that are not stored
+	mutable std::vector<size_t> m_brickOffsets;
+
+	/// For each brick that is not stored, the value of all its nodes
+	mutable std::vector<float> m_brickConstants;
+
+	/// The values of the stored bricks, BrickSize^3 per brick, x varying first
+	mutable std::vector<float> m_values;
+
+	/// The bounding box of the grid
+	mutable Aabbd m_boundingBox;
+
+	///@{
+	/// The volume integrals
+	mutable double m_volume;
+	mutable Vector3d m_center;
+	mutable Matrix33d m_secondMomentOfVolume;
+	///@}
+};
+
+}; // namespace Math
+
+}; // namespace SurgSim
+
+#endif // SURGSIM_MATH_SDFSHAPE_H
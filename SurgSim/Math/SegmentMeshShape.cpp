@@ -128,6 +128,16 @@ std::shared_ptr<const DataStructures::AabbTree> SegmentMeshShape::getAabbTree()
 	return m_aabbTree;
 }
 
+void SegmentMeshShape::setSweptAabbTree(std::shared_ptr<const DataStructures::AabbTree> tree)
+{
+	m_sweptAabbTree = tree;
+}
+
+std::shared_ptr<const DataStructures::AabbTree> SegmentMeshShape::getSweptAabbTree() const
+{
+	return m_sweptAabbTree;
+}
+
 std::shared_ptr<Shape> SegmentMeshShape::getTransformed(const RigidTransform3d& pose) const
 {
 	auto transformed = std::make_shared<SegmentMeshShape>(*this);
@@ -69,6 +69,16 @@ class SegmentMeshShape : public VerticesShape, public DataStructures::SegmentMes
 	/// \return The object's associated AabbTree
 	std::shared_ptr<const DataStructures::AabbTree> getAabbTree() const;
 
+	/// Set the AabbTree over the volume swept by the segments during the motion ending with this shape, so that the
+	/// continuous collision detection does not rebuild it for every pair (see buildSweptAabbTree())
+	/// \param tree The swept tree, its items expanded by the radius and kept up to date by the owner of the motion,
+	///        nullptr if there is none
+	void setSweptAabbTree(std::shared_ptr<const DataStructures::AabbTree> tree);
+
+	/// \return The AabbTree over the volume swept by the segments during the motion ending with this shape, nullptr
+	///         if none was set
+	std::shared_ptr<const DataStructures::AabbTree> getSweptAabbTree() const;
+
 	std::shared_ptr<Shape> getTransformed(const RigidTransform3d& pose) const override;
 
 	void setPose(const RigidTransform3d& pose) override;
@@ -96,6 +106,9 @@ class SegmentMeshShape : public VerticesShape, public DataStructures::SegmentMes
 	std::shared_ptr<DataStructures::AabbTree> m_aabbTree;
 	std::vector<SurgSim::Math::Aabbd> m_aabbCache;
 
+	/// The aabb tree over the swept volume of the segments, used by the continuous collision detection
+	std::shared_ptr<const DataStructures::AabbTree> m_sweptAabbTree;
+
 	/// Half extent of the AABB of the sphere at one of the segment end.
 	Vector3d m_segmentEndBoundingBoxHalfExtent;
 };
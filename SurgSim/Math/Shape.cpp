@@ -61,6 +61,12 @@ const Math::Aabbd& Shape::getBoundingBox() const
 	return m_aabb;
 }
 
+Vector3d Shape::getSupportPoint(const Vector3d& direction) const
+{
+	SURGSIM_FAILURE() << "getSupportPoint not implemented for " << getClassName();
+	return Vector3d::Zero();
+}
+
 void Shape::updateShape()
 {
 }
@@ -56,6 +56,7 @@ typedef enum
 	SHAPE_TYPE_SURFACEMESH,
 	SHAPE_TYPE_SEGMENTMESH,
 	SHAPE_TYPE_COMPOUNDSHAPE,
+	SHAPE_TYPE_SDF,
 	SHAPE_TYPE_COUNT
 } ShapeType;
 
@@ -119,6 +120,13 @@ class Shape : virtual public SurgSim::Framework::Accessible, public Framework::F
 	/// \return the bounding box for the shape
 	virtual const Math::Aabbd& getBoundingBox() const;
 
+	/// Get the support point of a convex shape, i.e. its furthest point in a given direction.
+	/// It is used by the generic convex collision detection (see calculateGjkEpaPenetration), only the convex shapes
+	/// implement it.
+	/// \param direction The direction, in the shape local frame (it does not need to be normalized)
+	/// \return The support point, in the shape local frame
+	virtual Vector3d getSupportPoint(const Vector3d& direction) const;
+
 protected:
 	Math::Aabbd m_aabb;
 };
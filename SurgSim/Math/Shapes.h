@@ -26,6 +26,7 @@
 #include "SurgSim/Math/OctreeShape.h"
 #include "SurgSim/Math/ParticlesShape.h"
 #include "SurgSim/Math/PlaneShape.h"
+#include "SurgSim/Math/SdfShape.h"
 #include "SurgSim/Math/SphereShape.h"
 #include "SurgSim/Math/SurfaceMeshShape.h"
 
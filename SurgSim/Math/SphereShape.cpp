@@ -78,6 +78,12 @@ bool SphereShape::isValid() const
 	return m_radius >= 0;
 }
 
+Vector3d SphereShape::getSupportPoint(const Vector3d& direction) const
+{
+	const double norm = direction.norm();
+	return (norm > 0.0) ? Vector3d(direction * (m_radius / norm)) : Vector3d(m_radius, 0.0, 0.0);
+}
+
 
 }; // namespace Math
 }; // namespace SurgSim
@@ -0,0 +1,191 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Math/SweptAabbTree.h"
+
+#include <algorithm>
+
+#include "SurgSim/DataStructures/AabbTree.h"
+#include "SurgSim/DataStructures/AabbTreeData.h"
+#include "SurgSim/DataStructures/AabbTreeNode.h"
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Math/Aabb.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/SegmentMeshShape.h"
+
+namespace SurgSim
+{
+namespace Math
+{
+
+namespace
+{
+
+/// Compute the swept AABBs of the triangles of a mesh, indexed by triangle id
+/// \param shapeAtTime0 The mesh at the start of the motion
+/// \param shapeAtTime1 The mesh at the end of the motion
+/// \param [out] bounds The AABBs of the triangles valid at both times, empty for the others
+/// \param [out] ids The ids of the triangles valid at both times
+void computeSweptBounds(const MeshShape& shapeAtTime0, const MeshShape& shapeAtTime1, std::vector<Aabbd>* bounds,
+						std::vector<size_t>* ids)
+{
+	const auto& triangles0 = shapeAtTime0.getTriangles();
+	const auto& triangles1 = shapeAtTime1.getTriangles();
+	SURGSIM_ASSERT(triangles0.size() == triangles1.size())
+			<< "The meshes at time 0 and time 1 have different numbers of triangles.";
+
+	bounds->assign(triangles0.size(), Aabbd());
+	ids->clear();
+	for (size_t id = 0; id < triangles0.size(); ++id)
+	{
+		if (triangles0[id].isValid && triangles1[id].isValid)
+		{
+			Aabbd& aabb = (*bounds)[id];
+			for (size_t vertexId : triangles0[id].verticesId)
+			{
+				aabb.extend(shapeAtTime0.getVertexPosition(vertexId));
+				aabb.extend(shapeAtTime1.getVertexPosition(vertexId));
+			}
+			ids->push_back(id);
+		}
+	}
+}
+
+/// Compute the swept AABBs of the edges of a segment mesh, indexed by edge id
+/// \param shapeAtTime0 The segment mesh at the start of the motion
+/// \param shapeAtTime1 The segment mesh at the end of the motion
+/// \param expansion Distance the AABBs are expanded by in every direction
+/// \param [out] bounds The AABBs of the edges valid at both times, empty for the others
+/// \param [out] ids The ids of the edges valid at both times
+void computeSweptBounds(const SegmentMeshShape& shapeAtTime0, const SegmentMeshShape& shapeAtTime1,
+						double expansion, std::vector<Aabbd>* bounds, std::vector<size_t>* ids)
+{
+	const auto& edges0 = shapeAtTime0.getEdges();
+	const auto& edges1 = shapeAtTime1.getEdges();
+	SURGSIM_ASSERT(edges0.size() == edges1.size())
+			<< "The segment meshes at time 0 and time 1 have different numbers of edges.";
+
+	const Vector3d halfExtent = Vector3d::Constant(expansion);
+	bounds->assign(edges0.size(), Aabbd());
+	ids->clear();
+	for (size_t id = 0; id < edges0.size(); ++id)
+	{
+		if (edges0[id].isValid && edges1[id].isValid)
+		{
+			Aabbd& aabb = (*bounds)[id];
+			for (size_t vertexId : edges0[id].verticesId)
+			{
+				aabb.extend(shapeAtTime0.getVertexPosition(vertexId));
+				aabb.extend(shapeAtTime1.getVertexPosition(vertexId));
+			}
+			aabb.min() -= halfExtent;
+			aabb.max() += halfExtent;
+			ids->push_back(id);
+		}
+	}
+}
+
+/// Build a tree over the given items
+std::shared_ptr<DataStructures::AabbTree> buildTree(const std::vector<Aabbd>& bounds, const std::vector<size_t>& ids)
+{
+	DataStructures::AabbTreeData::ItemList items;
+	for (size_t id : ids)
+	{
+		items.emplace_back(bounds[id], id);
+	}
+
+	auto tree = std::make_shared<DataStructures::AabbTree>();
+	tree->set(std::move(items));
+	return tree;
+}
+
+}
+
+std::shared_ptr<DataStructures::AabbTree> buildSweptAabbTree(const MeshShape& shapeAtTime0,
+		const MeshShape& shapeAtTime1)
+{
+	std::vector<Aabbd> bounds;
+	std::vector<size_t> ids;
+	computeSweptBounds(shapeAtTime0, shapeAtTime1, &bounds, &ids);
+	return buildTree(bounds, ids);
+}
+
+std::shared_ptr<DataStructures::AabbTree> buildSweptAabbTree(const SegmentMeshShape& shapeAtTime0,
+		const SegmentMeshShape& shapeAtTime1, double expansion)
+{
+	std::vector<Aabbd> bounds;
+	std::vector<size_t> ids;
+	computeSweptBounds(shapeAtTime0, shapeAtTime1, expansion, &bounds, &ids);
+	return buildTree(bounds, ids);
+}
+
+void updateSweptAabbTree(const MeshShape& shapeAtTime0, const MeshShape& shapeAtTime1,
+						 DataStructures::AabbTree* tree)
+{
+	std::vector<Aabbd> bounds;
+	std::vector<size_t> ids;
+	computeSweptBounds(shapeAtTime0, shapeAtTime1, &bounds, &ids);
+	tree->updateBounds(bounds);
+}
+
+void updateSweptAabbTree(const SegmentMeshShape& shapeAtTime0, const SegmentMeshShape& shapeAtTime1,
+						 double expansion, DataStructures::AabbTree* tree)
+{
+	std::vector<Aabbd> bounds;
+	std::vector<size_t> ids;
+	computeSweptBounds(shapeAtTime0, shapeAtTime1, expansion, &bounds, &ids);
+	tree->updateBounds(bounds);
+}
+
+std::shared_ptr<const DataStructures::AabbTree> getSweptAabbTree(const MeshShape& shapeAtTime0,
+		const MeshShape& shapeAtTime1)
+{
+	auto tree = shapeAtTime1.getSweptAabbTree();
+	return (tree != nullptr) ? tree : buildSweptAabbTree(shapeAtTime0, shapeAtTime1);
+}
+
+std::shared_ptr<const DataStructures::AabbTree> getSweptAabbTree(const SegmentMeshShape& shapeAtTime0,
+		const SegmentMeshShape& shapeAtTime1)
+{
+	auto tree = shapeAtTime1.getSweptAabbTree();
+	return (tree != nullptr) ? tree : buildSweptAabbTree(shapeAtTime0, shapeAtTime1, shapeAtTime1.getRadius());
+}
+
+void getSweptCandidates(const DataStructures::AabbTree& tree1, const DataStructures::AabbTree& tree2,
+						std::vector<std::pair<size_t, size_t>>* candidates)
+{
+	candidates->clear();
+	for (const auto& intersection : tree1.spatialJoin(tree2))
+	{
+		auto& items1 = static_cast<DataStructures::AabbTreeData*>(intersection.first->getData().get())->getData();
+		auto& items2 = static_cast<DataStructures::AabbTreeData*>(intersection.second->getData().get())->getData();
+		for (const auto& item1 : items1)
+		{
+			for (const auto& item2 : items2)
+			{
+				if (doAabbIntersect(item1.first, item2.first))
+				{
+					candidates->emplace_back(item1.second, item2.second);
+				}
+			}
+		}
+	}
+
+	// Every item is in a single leaf, so the pairs are unique, the sort restores the order of the ids
+	std::sort(candidates->begin(), candidates->end());
+}
+
+}; // namespace Math
+}; // namespace SurgSim
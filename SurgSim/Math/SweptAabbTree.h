@@ -0,0 +1,97 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_MATH_SWEPTAABBTREE_H
+#define SURGSIM_MATH_SWEPTAABBTREE_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace SurgSim
+{
+
+namespace DataStructures
+{
+class AabbTree;
+}
+
+namespace Math
+{
+class MeshShape;
+class SegmentMeshShape;
+
+/// Build an AabbTree over the volume swept by the triangles of a mesh between two time points, the item of each
+/// triangle bounds its positions at both times, and thus the whole triangle when its vertices move linearly.
+/// The continuous collision detection uses this single tree for both time points, the shapes don't need their own
+/// AabbTree or normals to be up to date.
+/// \param shapeAtTime0 The mesh at the start of the motion
+/// \param shapeAtTime1 The mesh at the end of the motion, it has to have the same topology
+/// \return The tree, with the ids of the triangles valid at both times as items
+std::shared_ptr<DataStructures::AabbTree> buildSweptAabbTree(const MeshShape& shapeAtTime0,
+		const MeshShape& shapeAtTime1);
+
+/// Build an AabbTree over the volume swept by the segments of a mesh between two time points, the item of each
+/// segment bounds its positions at both times.
+/// \param shapeAtTime0 The segment mesh at the start of the motion
+/// \param shapeAtTime1 The segment mesh at the end of the motion, it has to have the same topology
+/// \param expansion Distance the items are expanded by in every direction, e.g. the radius of the segments
+/// \return The tree, with the ids of the edges valid at both times as items
+std::shared_ptr<DataStructures::AabbTree> buildSweptAabbTree(const SegmentMeshShape& shapeAtTime0,
+		const SegmentMeshShape& shapeAtTime1, double expansion);
+
+/// Refit a tree built by buildSweptAabbTree() to new positions of the meshes, without rebuilding its hierarchy
+/// \param shapeAtTime0 The mesh at the start of the motion
+/// \param shapeAtTime1 The mesh at the end of the motion
+/// \param [in,out] tree The tree, built for meshes with the same triangles
+void updateSweptAabbTree(const MeshShape& shapeAtTime0, const MeshShape& shapeAtTime1,
+						 DataStructures::AabbTree* tree);
+
+/// Refit a tree built by buildSweptAabbTree() to new positions of the segment meshes, without rebuilding its hierarchy
+/// \param shapeAtTime0 The segment mesh at the start of the motion
+/// \param shapeAtTime1 The segment mesh at the end of the motion
+/// \param expansion Distance the items are expanded by in every direction, e.g. the radius of the segments
+/// \param [in,out] tree The tree, built for segment meshes with the same edges
+void updateSweptAabbTree(const SegmentMeshShape& shapeAtTime0, const SegmentMeshShape& shapeAtTime1,
+						 double expansion, DataStructures::AabbTree* tree);
+
+/// Get the swept tree of a motion, the one kept up to date in shapeAtTime1 by the owner of the motion (see
+/// MeshShape::setSweptAabbTree()) or a new one if there is none.
+/// \param shapeAtTime0 The mesh at the start of the motion
+/// \param shapeAtTime1 The mesh at the end of the motion
+/// \return The tree over the volume swept by the triangles
+std::shared_ptr<const DataStructures::AabbTree> getSweptAabbTree(const MeshShape& shapeAtTime0,
+		const MeshShape& shapeAtTime1);
+
+/// Get the swept tree of a motion, the one kept up to date in shapeAtTime1 by the owner of the motion (see
+/// SegmentMeshShape::setSweptAabbTree()) or a new one if there is none. The items are expanded by the segment radius.
+/// \param shapeAtTime0 The segment mesh at the start of the motion
+/// \param shapeAtTime1 The segment mesh at the end of the motion
+/// \return The tree over the volume swept by the segments
+std::shared_ptr<const DataStructures::AabbTree> getSweptAabbTree(const SegmentMeshShape& shapeAtTime0,
+		const SegmentMeshShape& shapeAtTime1);
+
+/// Find all the pairs of items whose swept volumes overlap in two swept AabbTrees
+/// \param tree1 The first tree
+/// \param tree2 The second tree
+/// \param [out] candidates The pairs of ids (item in tree1, item in tree2) with overlapping AABBs, sorted in
+///        increasing order
+void getSweptCandidates(const DataStructures::AabbTree& tree1, const DataStructures::AabbTree& tree2,
+						std::vector<std::pair<size_t, size_t>>* candidates);
+
+}; // namespace Math
+}; // namespace SurgSim
+
+#endif // SURGSIM_MATH_SWEPTAABBTREE_H
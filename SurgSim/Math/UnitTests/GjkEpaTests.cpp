@@ -0,0 +1,179 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Math/BoxShape.h"
+#include "SurgSim/Math/CapsuleShape.h"
+#include "SurgSim/Math/CylinderShape.h"
+#include "SurgSim/Math/GjkEpa.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/Quaternion.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/SphereShape.h"
+
+namespace
+{
+const double epsilon = 1e-8;
+}
+
+namespace SurgSim
+{
+namespace Math
+{
+
+TEST(GjkEpaTests, SupportPointTest)
+{
+	SphereShape sphere(0.5);
+	EXPECT_TRUE(sphere.getSupportPoint(Vector3d(0.0, 2.0, 0.0)).isApprox(Vector3d(0.0, 0.5, 0.0)));
+	EXPECT_TRUE(sphere.getSupportPoint(Vector3d::Zero()).allFinite());
+
+	BoxShape box(1.0, 2.0, 3.0);
+	EXPECT_TRUE(box.getSupportPoint(Vector3d(1.0, -1.0, 0.5)).isApprox(Vector3d(0.5, -1.0, 1.5)));
+
+	CapsuleShape capsule(2.0, 0.5);
+	EXPECT_TRUE(capsule.getSupportPoint(Vector3d(1.0, 1.0, 0.0)).isApprox(
+					Vector3d(0.0, 1.0, 0.0) + 0.5 * Vector3d(1.0, 1.0, 0.0).normalized()));
+
+	CylinderShape cylinder(2.0, 0.5);
+	EXPECT_TRUE(cylinder.getSupportPoint(Vector3d(3.0, -1.0, 4.0)).isApprox(Vector3d(0.3, -1.0, 0.4)));
+	EXPECT_TRUE(cylinder.getSupportPoint(Vector3d(0.0, 1.0, 0.0)).isApprox(Vector3d(0.0, 1.0, 0.0)));
+
+	MeshShape mesh;
+	EXPECT_THROW(mesh.getSupportPoint(Vector3d::UnitX()), SurgSim::Framework::AssertionFailure);
+}
+
+TEST(GjkEpaTests, DistanceTest)
+{
+	SphereShape sphere1(1.0);
+	SphereShape sphere2(0.5);
+	const RigidTransform3d pose1 = makeRigidTransform(makeRotationQuaternion(0.3, Vector3d::UnitZ().eval()),
+								   Vector3d(1.0, 2.0, 3.0));
+	const RigidTransform3d pose2 = makeRigidTranslation(Vector3d(4.0, 2.0, 3.0));
+
+	Vector3d point1, point2;
+	EXPECT_NEAR(1.5, calculateGjkDistance(sphere1, pose1, sphere2, pose2, &point1, &point2), 1e-6);
+	EXPECT_TRUE((pose1 * point1).isApprox(Vector3d(2.0, 2.0, 3.0), 1e-6));
+	EXPECT_TRUE(point2.isApprox(Vector3d(-0.5, 0.0, 0.0), 1e-6));
+
+	// Box to box, edge against face
+	BoxShape box(1.0, 1.0, 1.0);
+	const RigidTransform3d boxPose = makeRigidTransform(makeRotationQuaternion(M_PI_4, Vector3d::UnitZ().eval()),
+									 Vector3d(2.0, 0.0, 0.0));
+	EXPECT_NEAR(1.5 - std::sqrt(0.5), calculateGjkDistance(box, RigidTransform3d::Identity(), box, boxPose,
+				&point1, &point2), epsilon);
+	EXPECT_NEAR(0.5, point1[0], epsilon);
+	EXPECT_TRUE((boxPose * point2).isApprox(Vector3d(2.0 - std::sqrt(0.5), 0.0, point1[2]), epsilon));
+
+	// Intersecting shapes
+	EXPECT_DOUBLE_EQ(0.0, calculateGjkDistance(box, RigidTransform3d::Identity(), sphere1,
+					 RigidTransform3d::Identity(), &point1, &point2));
+}
+
+TEST(GjkEpaTests, PenetrationTest)
+{
+	Vector3d normal, point1, point2;
+	double depth;
+
+	{
+		SCOPED_TRACE("Separated shapes");
+		BoxShape box(1.0, 1.0, 1.0);
+		EXPECT_FALSE(calculateGjkEpaPenetration(box, RigidTransform3d::Identity(), box,
+					 makeRigidTranslation(Vector3d(1.1, 0.0, 0.0)), &normal, &depth, &point1, &point2));
+	}
+
+	{
+		SCOPED_TRACE("Box/box");
+		BoxShape box(1.0, 1.0, 1.0);
+		// The whole configuration is rotated and translated
+		const RigidTransform3d transform = makeRigidTransform(
+											   makeRotationQuaternion(0.5, Vector3d(1.0, 2.0, 0.0).normalized()),
+											   Vector3d(0.3, -0.2, 0.1));
+		const RigidTransform3d pose2 = transform * makeRigidTranslation(Vector3d(0.9, 0.2, 0.1));
+		ASSERT_TRUE(calculateGjkEpaPenetration(box, transform, box, pose2, &normal, &depth, &point1, &point2));
+		EXPECT_NEAR(0.1, depth, epsilon);
+		EXPECT_TRUE(normal.isApprox(-(transform.linear() * Vector3d::UnitX()), epsilon));
+		EXPECT_NEAR(0.5, point1[0], epsilon);
+		EXPECT_NEAR(-0.5, point2[0], epsilon);
+		EXPECT_TRUE((transform * point1 - pose2 * point2).isApprox(-depth * normal, epsilon));
+	}
+
+	{
+		SCOPED_TRACE("Sphere/sphere");
+		SphereShape sphere(1.0);
+		const RigidTransform3d pose2 = makeRigidTranslation(Vector3d(1.5, 0.0, 0.0));
+		ASSERT_TRUE(calculateGjkEpaPenetration(sphere, RigidTransform3d::Identity(), sphere, pose2,
+											   &normal, &depth, &point1, &point2));
+		EXPECT_NEAR(0.5, depth, 1e-3);
+		EXPECT_TRUE(normal.isApprox(-Vector3d::UnitX(), 1e-2));
+		EXPECT_TRUE(point1.isApprox(Vector3d::UnitX(), 1e-2));
+		EXPECT_TRUE(point2.isApprox(-Vector3d::UnitX(), 1e-2));
+	}
+
+	{
+		SCOPED_TRACE("Cylinder/capsule");
+		CylinderShape cylinder(2.0, 0.5);
+		CapsuleShape capsule(1.0, 0.2);
+		const RigidTransform3d pose2 = makeRigidTransform(makeRotationQuaternion(0.1, Vector3d::UnitX().eval()),
+									   Vector3d(0.6, 0.0, 0.0));
+		ASSERT_TRUE(calculateGjkEpaPenetration(cylinder, RigidTransform3d::Identity(), capsule, pose2,
+											   &normal, &depth, &point1, &point2));
+		EXPECT_NEAR(0.1, depth, 1e-4);
+		EXPECT_TRUE(normal.isApprox(-Vector3d::UnitX(), 1e-2));
+		EXPECT_NEAR(0.5, Vector3d(point1[0], 0.0, point1[2]).norm(), 1e-4);
+	}
+}
+
+TEST(GjkEpaTests, WarmStartTest)
+{
+	BoxShape box(1.0, 0.5, 0.2);
+	CylinderShape cylinder(0.4, 0.3);
+	const RigidTransform3d pose1 = makeRigidTransform(
+									   makeRotationQuaternion(0.2, Vector3d(1.0, 2.0, 3.0).normalized()),
+									   Vector3d(0.1, 0.0, 0.0));
+
+	GjkSimplex simplex;
+	for (double x = 1.2; x > 0.3; x -= 0.05)
+	{
+		const RigidTransform3d pose2 = makeRigidTransform(makeRotationQuaternion(x, Vector3d::UnitZ().eval()),
+									   Vector3d(x, 0.1, 0.0));
+		Vector3d normal, point1, point2;
+		double depth;
+		Vector3d warmNormal, warmPoint1, warmPoint2;
+		double warmDepth;
+		const bool intersect = calculateGjkEpaPenetration(box, pose1, cylinder, pose2, &normal, &depth,
+							   &point1, &point2);
+		ASSERT_EQ(intersect, calculateGjkEpaPenetration(box, pose1, cylinder, pose2, &warmNormal, &warmDepth,
+				  &warmPoint1, &warmPoint2, &simplex));
+		EXPECT_FALSE(simplex.empty());
+		if (intersect)
+		{
+			EXPECT_NEAR(depth, warmDepth, 1e-4);
+			EXPECT_TRUE(normal.isApprox(warmNormal, 1e-2));
+		}
+		else
+		{
+			Vector3d closest1, closest2;
+			GjkSimplex distanceSimplex = simplex;
+			EXPECT_NEAR(calculateGjkDistance(box, pose1, cylinder, pose2, &closest1, &closest2),
+						calculateGjkDistance(box, pose1, cylinder, pose2, &point1, &point2, &distanceSimplex),
+						epsilon);
+		}
+	}
+}
+
+}; // namespace Math
+}; // namespace SurgSim
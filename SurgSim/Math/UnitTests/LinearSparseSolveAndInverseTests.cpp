@@ -192,6 +192,264 @@ TEST_F(LinearSparseSolveAndInverseTests, SparseCGMatrixComponentsTest)
 
 };
 
+TEST_F(LinearSparseSolveAndInverseTests, SparsePCGSetGetTests)
+{
+	LinearSparseSolveAndInversePCG solveAndInverse;
+
+	EXPECT_EQ(SurgSim::Math::PRECONDITIONER_BLOCK_JACOBI, solveAndInverse.getPreconditioner());
+	solveAndInverse.setPreconditioner(SurgSim::Math::PRECONDITIONER_INCOMPLETE_CHOLESKY);
+	EXPECT_EQ(SurgSim::Math::PRECONDITIONER_INCOMPLETE_CHOLESKY, solveAndInverse.getPreconditioner());
+
+	EXPECT_EQ(3u, solveAndInverse.getBlockSize());
+	solveAndInverse.setBlockSize(6);
+	EXPECT_EQ(6u, solveAndInverse.getBlockSize());
+	EXPECT_THROW(solveAndInverse.setBlockSize(0), SurgSim::Framework::AssertionFailure);
+
+	EXPECT_EQ(100, solveAndInverse.getMaxIterations());
+	solveAndInverse.setMaxIterations(50);
+	EXPECT_EQ(50, solveAndInverse.getMaxIterations());
+	EXPECT_THROW(solveAndInverse.setMaxIterations(-1), SurgSim::Framework::AssertionFailure);
+
+	EXPECT_EQ(1.0e-06, solveAndInverse.getTolerance());
+	solveAndInverse.setTolerance(1.0e-03);
+	EXPECT_EQ(1.0e-03, solveAndInverse.getTolerance());
+	EXPECT_THROW(solveAndInverse.setTolerance(-1.0), SurgSim::Framework::AssertionFailure);
+
+	EXPECT_TRUE(solveAndInverse.isWarmStarting());
+	solveAndInverse.setWarmStart(false);
+	EXPECT_FALSE(solveAndInverse.isWarmStarting());
+};
+
+TEST_F(LinearSparseSolveAndInverseTests, SparsePCGInitializationTests)
+{
+	SparseMatrix nonSquare(9, 18);
+	SparseMatrix square(18, 18);
+	nonSquare.setZero();
+
+	for (SparseMatrix::Index counter = 0; counter < 18; ++counter)
+	{
+		square.insert(counter, counter) = 1.0;
+	}
+	square.makeCompressed();
+
+	LinearSparseSolveAndInversePCG solveAndInverse;
+	EXPECT_THROW(solveAndInverse.setMatrix(nonSquare), SurgSim::Framework::AssertionFailure);
+	EXPECT_NO_THROW(solveAndInverse.setMatrix(square));
+
+	solveAndInverse.setBlockSize(4);
+	EXPECT_THROW(solveAndInverse.setMatrix(square), SurgSim::Framework::AssertionFailure);
+
+	solveAndInverse.setBlockSize(3);
+	clearMatrix(&square);
+	EXPECT_THROW(solveAndInverse.setMatrix(square), SurgSim::Framework::AssertionFailure);
+};
+
+TEST_F(LinearSparseSolveAndInverseTests, SparsePCGMatrixComponentsTest)
+{
+	// The conjugate gradient needs a symmetric positive definite matrix
+	Matrix spdMatrix = denseMatrix.transpose() * denseMatrix + 18.0 * Matrix::Identity(18, 18);
+	SparseMatrix spdSparseMatrix = spdMatrix.sparseView();
+	Vector expected = spdMatrix.inverse() * b;
+
+	for (auto preconditioner : {SurgSim::Math::PRECONDITIONER_BLOCK_JACOBI,
+								SurgSim::Math::PRECONDITIONER_INCOMPLETE_CHOLESKY})
+	{
+		SCOPED_TRACE(preconditioner);
+		LinearSparseSolveAndInversePCG solveAndInverse;
+		solveAndInverse.setPreconditioner(preconditioner);
+		solveAndInverse.setTolerance(1.0e-12);
+		solveAndInverse.setMatrix(spdSparseMatrix);
+
+		x = solveAndInverse.solve(b);
+		EXPECT_TRUE(x.isApprox(expected, 1.0e-10)) << std::endl << "x: " << x.transpose() << std::endl <<
+				"Expected: " << expected.transpose() << std::endl;
+		EXPECT_LT(0, solveAndInverse.getIterations());
+		EXPECT_GE(1.0e-12, solveAndInverse.getError());
+
+		inverseMatrix = solveAndInverse.solve(spdMatrix);
+		EXPECT_TRUE(inverseMatrix.isApprox(Matrix::Identity(18, 18), 1.0e-10));
+
+		// The previous single right-hand side solution is the initial guess, it is already converged
+		x = solveAndInverse.solve(b);
+		EXPECT_EQ(0, solveAndInverse.getIterations());
+		EXPECT_TRUE(x.isApprox(expected, 1.0e-10));
+
+		solveAndInverse.resetWarmStart();
+		x = solveAndInverse.solve(b);
+		EXPECT_LT(0, solveAndInverse.getIterations());
+	}
+};
+
+TEST_F(LinearSparseSolveAndInverseTests, SparsePCGFixedIterationsTest)
+{
+	Matrix spdMatrix = denseMatrix.transpose() * denseMatrix + 18.0 * Matrix::Identity(18, 18);
+	Vector expected = spdMatrix.inverse() * b;
+
+	LinearSparseSolveAndInversePCG solveAndInverse;
+	solveAndInverse.setWarmStart(false);
+	solveAndInverse.setTolerance(0.0);
+	solveAndInverse.setMaxIterations(2);
+	solveAndInverse.setMatrix(spdMatrix.sparseView());
+
+	x = solveAndInverse.solve(b);
+	EXPECT_EQ(2, solveAndInverse.getIterations());
+	EXPECT_LT(0.0, solveAndInverse.getError());
+	EXPECT_FALSE(x.isApprox(expected, 1.0e-10));
+
+	// Each warm started solve continues from the previous solution, so the error decreases with the same budget
+	solveAndInverse.setWarmStart(true);
+	x = solveAndInverse.solve(b);
+	double previousError = solveAndInverse.getError();
+	for (int i = 0; i < 20; ++i)
+	{
+		x = solveAndInverse.solve(b);
+		EXPECT_GE(2, solveAndInverse.getIterations());
+	}
+	EXPECT_GT(previousError, solveAndInverse.getError());
+};
+
+namespace
+{
+/// Build a diagonally dominant block banded matrix
+/// \param size The matrix size
+/// \param blockSize The block size
+/// \param bandwidth The number of non-zero blocks on each side of the diagonal
+SparseMatrix makeBlockBandedMatrix(Eigen::Index size, Eigen::Index blockSize, Eigen::Index bandwidth)
+{
+	Matrix dense = Matrix::Zero(size, size);
+	for (Eigen::Index row = 0; row < size; ++row)
+	{
+		for (Eigen::Index col = 0; col < size; ++col)
+		{
+			if (std::abs(row / blockSize - col / blockSize) <= bandwidth)
+			{
+				dense(row, col) = std::fmod((10.3 * std::cos(static_cast<double>(row * col)) + 3.24), 10.0);
+			}
+		}
+		dense(row, row) += 10.0 * static_cast<double>(size);
+	}
+	return dense.sparseView();
+}
+};
+
+TEST_F(LinearSparseSolveAndInverseTests, SparseTriDiagonalBlockSetGetTests)
+{
+	LinearSparseSolveAndInverseTriDiagonalBlock solveAndInverse;
+
+	EXPECT_EQ(3u, solveAndInverse.getBlockSize());
+	solveAndInverse.setBlockSize(6);
+	EXPECT_EQ(6u, solveAndInverse.getBlockSize());
+	EXPECT_THROW(solveAndInverse.setBlockSize(0), SurgSim::Framework::AssertionFailure);
+	EXPECT_EQ(0u, solveAndInverse.getBandwidth());
+};
+
+TEST_F(LinearSparseSolveAndInverseTests, SparseTriDiagonalBlockInitializationTests)
+{
+	SparseMatrix nonSquare(9, 18);
+	SparseMatrix notMultipleOfBlockSize(10, 10);
+	notMultipleOfBlockSize.setIdentity();
+
+	LinearSparseSolveAndInverseTriDiagonalBlock solveAndInverse;
+	EXPECT_THROW(solveAndInverse.setMatrix(nonSquare), SurgSim::Framework::AssertionFailure);
+	EXPECT_THROW(solveAndInverse.setMatrix(notMultipleOfBlockSize), SurgSim::Framework::AssertionFailure);
+
+	SparseMatrix singular(9, 9);
+	singular.setIdentity();
+	singular.coeffRef(4, 4) = 0.0;
+	EXPECT_THROW(solveAndInverse.setMatrix(singular), SurgSim::Framework::AssertionFailure);
+};
+
+TEST_F(LinearSparseSolveAndInverseTests, SparseTriDiagonalBlockMatrixComponentsTest)
+{
+	// Block tri-diagonal, e.g. a beam
+	{
+		SparseMatrix banded = makeBlockBandedMatrix(24, 6, 1);
+		Matrix expectedBandedInverse = banded.toDense().inverse();
+
+		LinearSparseSolveAndInverseTriDiagonalBlock solveAndInverse;
+		solveAndInverse.setBlockSize(6);
+		solveAndInverse.setMatrix(banded);
+		EXPECT_EQ(1u, solveAndInverse.getBandwidth());
+
+		Vector rhs = Vector::LinSpaced(24, -1.0, 2.0);
+		EXPECT_TRUE(solveAndInverse.solve(rhs).isApprox(expectedBandedInverse * rhs));
+		EXPECT_TRUE(solveAndInverse.getInverse().isApprox(expectedBandedInverse));
+
+		// A few compliance columns at once
+		Matrix columns = Matrix::Identity(24, 24).middleCols(5, 3);
+		EXPECT_TRUE(solveAndInverse.solve(columns).isApprox(expectedBandedInverse.middleCols(5, 3)));
+	}
+
+	// Block banded, e.g. a mass-spring chain with bending springs, whose size is not a multiple of the bandwidth
+	{
+		SparseMatrix banded = makeBlockBandedMatrix(21, 3, 2);
+		Matrix expectedBandedInverse = banded.toDense().inverse();
+
+		LinearSparseSolveAndInverseTriDiagonalBlock solveAndInverse;
+		solveAndInverse.setMatrix(banded);
+		EXPECT_EQ(2u, solveAndInverse.getBandwidth());
+		EXPECT_TRUE(solveAndInverse.getInverse().isApprox(expectedBandedInverse));
+	}
+
+	// Any invertible matrix can be handled, as a single block if necessary
+	{
+		setupSparseMatrixTest();
+
+		LinearSparseSolveAndInverseTriDiagonalBlock solveAndInverse;
+		solveAndInverse.setMatrix(matrix);
+		EXPECT_EQ(5u, solveAndInverse.getBandwidth());
+		x = solveAndInverse.solve(b);
+		EXPECT_TRUE(x.isApprox(expectedX));
+		EXPECT_TRUE(solveAndInverse.getInverse().isApprox(expectedInverse));
+	}
+};
+
+TEST_F(LinearSparseSolveAndInverseTests, SparseMixedPrecisionLUSetGetTests)
+{
+	LinearSparseSolveAndInverseMixedPrecisionLU solveAndInverse;
+
+	EXPECT_EQ(1u, solveAndInverse.getRefinementIterations());
+	solveAndInverse.setRefinementIterations(3);
+	EXPECT_EQ(3u, solveAndInverse.getRefinementIterations());
+};
+
+TEST_F(LinearSparseSolveAndInverseTests, SparseMixedPrecisionLUMatrixComponentsTest)
+{
+	SparseMatrix nonSquare(9, 18);
+	LinearSparseSolveAndInverseMixedPrecisionLU solveAndInverse;
+	EXPECT_THROW(solveAndInverse.setMatrix(nonSquare), SurgSim::Framework::AssertionFailure);
+
+	Matrix spdMatrix = denseMatrix.transpose() * denseMatrix + 18.0 * Matrix::Identity(18, 18);
+	Matrix expectedSpdInverse = spdMatrix.inverse();
+	Vector expected = expectedSpdInverse * b;
+	solveAndInverse.setMatrix(spdMatrix.sparseView());
+
+	// The single precision solution is only accurate to single precision
+	solveAndInverse.setRefinementIterations(0);
+	x = solveAndInverse.solve(b);
+	EXPECT_TRUE(x.isApprox(expected, 1.0e-4));
+	EXPECT_FALSE(x.isApprox(expected, 1.0e-12));
+
+	// The iterative refinement recovers the double precision
+	solveAndInverse.setRefinementIterations(4);
+	x = solveAndInverse.solve(b);
+	EXPECT_TRUE(x.isApprox(expected, 1.0e-12));
+
+	// The inverse is not refined
+	EXPECT_TRUE(solveAndInverse.getInverse().isApprox(expectedSpdInverse, 1.0e-4));
+
+	// New values with the same pattern are only factorized, a new pattern is analyzed again
+	Matrix scaledMatrix = 2.0 * spdMatrix;
+	solveAndInverse.setMatrix(scaledMatrix.sparseView());
+	x = solveAndInverse.solve(b);
+	EXPECT_TRUE(x.isApprox(0.5 * expected, 1.0e-12));
+
+	Matrix diagonalMatrix = spdMatrix.diagonal().asDiagonal();
+	solveAndInverse.setMatrix(diagonalMatrix.sparseView());
+	x = solveAndInverse.solve(b);
+	EXPECT_TRUE(x.isApprox(diagonalMatrix.inverse() * b, 1.0e-12));
+};
+
 }; // namespace Math
 
 }; // namespace SurgSim
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string>
 #include <time.h>
 
 #include <gtest/gtest.h>
@@ -431,6 +432,53 @@ TEST_F(MeshShapeTest, NormalTest)
 	EXPECT_FALSE(meshWithNormal->update());
 }
 
+TEST_F(MeshShapeTest, UpdateMovedVerticesTest)
+{
+	// Move a few vertices, then all of them, both the refit of the moved triangles and the fallback to the full refit
+	// have to match the full update
+	for (size_t stride : {127, 1})
+	{
+		SCOPED_TRACE("Every " + std::to_string(stride) + " vertices moved");
+		auto meshShape = std::make_shared<MeshShape>();
+		ASSERT_NO_THROW(meshShape->load("Geometry/staple_collision.ply"));
+		auto expected = std::make_shared<MeshShape>(*meshShape);
+
+		std::vector<size_t> moved;
+		for (size_t id = 0; id < meshShape->getNumVertices(); id += stride)
+		{
+			Vector3d position = meshShape->getVertexPosition(id) + Vector3d(0.001, -0.002, 0.0005);
+			meshShape->setVertexPosition(id, position);
+			expected->setVertexPosition(id, position);
+			moved.push_back(id);
+		}
+		EXPECT_TRUE(meshShape->updateMovedVertices(moved));
+		expected->updateAabbTree();
+		EXPECT_TRUE(expected->calculateNormals());
+
+		for (size_t id = 0; id < meshShape->getNumTriangles(); ++id)
+		{
+			EXPECT_TRUE(expected->getNormal(id).isApprox(meshShape->getNormal(id))) << "Triangle " << id;
+		}
+		EXPECT_TRUE(expected->getBoundingBox().isApprox(meshShape->getBoundingBox()));
+
+		// Every node of the tree was refit
+		std::vector<std::pair<DataStructures::AabbTreeNode*, DataStructures::AabbTreeNode*>> nodes;
+		nodes.emplace_back(static_cast<DataStructures::AabbTreeNode*>(expected->getAabbTree()->getRoot().get()),
+						   static_cast<DataStructures::AabbTreeNode*>(meshShape->getAabbTree()->getRoot().get()));
+		while (!nodes.empty())
+		{
+			auto node = nodes.back();
+			nodes.pop_back();
+			EXPECT_TRUE(node.first->getAabb().isApprox(node.second->getAabb()));
+			ASSERT_EQ(node.first->getNumChildren(), node.second->getNumChildren());
+			for (size_t i = 0; i < node.first->getNumChildren(); ++i)
+			{
+				nodes.emplace_back(static_cast<DataStructures::AabbTreeNode*>(node.first->getChild(i).get()),
+								   static_cast<DataStructures::AabbTreeNode*>(node.second->getChild(i).get()));
+			}
+		}
+	}
+}
 
 TEST_F(MeshShapeTest, DoLoadTest)
 {
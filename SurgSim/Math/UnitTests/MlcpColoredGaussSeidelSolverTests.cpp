@@ -0,0 +1,309 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// Tests for the colored Gauss-Seidel implementation of the MLCP solver.
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Framework/ThreadPool.h"
+#include "SurgSim/Math/MlcpColoredGaussSeidelSolver.h"
+#include "SurgSim/Math/MlcpGaussSeidelSolver.h"
+#include "SurgSim/Math/MlcpSolution.h"
+#include "SurgSim/Math/Valid.h"
+#include "SurgSim/Testing/MlcpIO/MlcpTestData.h"
+#include "SurgSim/Testing/MlcpIO/ReadText.h"
+
+using SurgSim::Math::MlcpColoredGaussSeidelSolver;
+using SurgSim::Math::MlcpGaussSeidelSolver;
+using SurgSim::Math::MlcpProblem;
+using SurgSim::Math::MlcpSolution;
+
+namespace
+{
+
+/// Build a problem made of independent bodies, each one with a bilateral 3D constraint and frictional contacts, the
+/// bilateral constraints come first as in the physics pipeline.
+/// \param numBodies The number of bodies
+/// \param numContacts The number of frictional contacts per body
+/// \param penetration The penetration added to the random violations of the contacts, a small one leaves some
+/// contacts inactive
+MlcpProblem makeFrictionalProblem(size_t numBodies, size_t numContacts, double penetration = 2.0)
+{
+	const size_t numAtomicPerBody = 3 + 3 * numContacts;
+	const size_t numDofPerBody = 2 * numAtomicPerBody;
+	const size_t size = numBodies * numAtomicPerBody;
+
+	MlcpProblem problem;
+	problem.A.setZero(size, size);
+	problem.b.setZero(size);
+	problem.mu.setZero(size);
+	problem.constraintTypes.assign(numBodies, SurgSim::Math::MLCP_BILATERAL_3D_CONSTRAINT);
+	problem.constraintTypes.insert(problem.constraintTypes.end(), numBodies * numContacts,
+								   SurgSim::Math::MLCP_UNILATERAL_3D_FRICTIONAL_CONSTRAINT);
+
+	std::srand(1234);
+	for (size_t body = 0; body < numBodies; ++body)
+	{
+		// The rows of the body, bilateral then contacts, and the matching A = H.M^-1.H^t
+		std::vector<size_t> rows;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			rows.push_back(3 * body + i);
+		}
+		for (size_t contact = 0; contact < numContacts; ++contact)
+		{
+			for (size_t i = 0; i < 3; ++i)
+			{
+				rows.push_back(3 * numBodies + 3 * (body * numContacts + contact) + i);
+			}
+		}
+		const Eigen::MatrixXd H = Eigen::MatrixXd::Random(numAtomicPerBody, numDofPerBody) +
+			Eigen::MatrixXd::Identity(numAtomicPerBody, numDofPerBody);
+		const Eigen::MatrixXd localA = H * H.transpose() + 0.1 * Eigen::MatrixXd::Identity(numAtomicPerBody,
+									   numAtomicPerBody);
+		const Eigen::VectorXd localB = Eigen::VectorXd::Random(numAtomicPerBody);
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			problem.b[rows[i]] = localB[i] - ((i >= 3 && (i % 3) == 0) ? penetration : 0.0);
+			problem.mu[rows[i]] = 0.3;
+			for (size_t j = 0; j < rows.size(); ++j)
+			{
+				problem.A(rows[i], rows[j]) = localA(i, j);
+			}
+		}
+	}
+	return problem;
+}
+
+void solveAndCompareResult(const std::string& fileName, double precision = 1e-9)
+{
+	SCOPED_TRACE("while running test " + fileName);
+
+	const std::shared_ptr<MlcpTestData> data = loadTestData(fileName);
+	ASSERT_TRUE(data != nullptr) << "Failed to load " << fileName;
+
+	const size_t size = data->getSize();
+	MlcpSolution solution;
+	solution.x.setZero(size);
+
+	MlcpColoredGaussSeidelSolver mlcpSolver(precision, precision, 100);
+	mlcpSolver.solve(data->problem, &solution);
+
+	ASSERT_EQ(static_cast<Eigen::Index>(size), solution.x.rows());
+	if (size > 0)
+	{
+		ASSERT_TRUE(SurgSim::Math::isValid(solution.x)) << solution.x;
+		EXPECT_TRUE(solution.validSignorini);
+		EXPECT_TRUE(solution.validConvergence);
+	}
+	EXPECT_NEAR(0.0, (solution.x - data->expectedLambda).norm(), precision * data->expectedLambda.norm()) <<
+		"lambda:" << std::endl << solution.x << std::endl << "expected:" << std::endl << data->expectedLambda;
+}
+
+}
+
+TEST(MlcpColoredGaussSeidelSolverTests, CanConstruct)
+{
+	MlcpColoredGaussSeidelSolver mlcpSolver(1.0, 1.0, 100);
+	EXPECT_DOUBLE_EQ(1.0, mlcpSolver.getEpsilonConvergence());
+	EXPECT_DOUBLE_EQ(1.0, mlcpSolver.getContactTolerance());
+	EXPECT_EQ(100u, mlcpSolver.getMaxIterations());
+	EXPECT_EQ(0u, mlcpSolver.getNumColors());
+}
+
+TEST(MlcpColoredGaussSeidelSolverTests, Accessors)
+{
+	MlcpColoredGaussSeidelSolver mlcpSolver;
+	MlcpGaussSeidelSolver gaussSeidelSolver;
+	EXPECT_DOUBLE_EQ(gaussSeidelSolver.getEpsilonConvergence(), mlcpSolver.getEpsilonConvergence());
+	EXPECT_DOUBLE_EQ(gaussSeidelSolver.getContactTolerance(), mlcpSolver.getContactTolerance());
+	EXPECT_EQ(gaussSeidelSolver.getMaxIterations(), mlcpSolver.getMaxIterations());
+
+	mlcpSolver.setEpsilonConvergence(1e-6);
+	EXPECT_DOUBLE_EQ(1e-6, mlcpSolver.getEpsilonConvergence());
+	mlcpSolver.setContactTolerance(1e-7);
+	EXPECT_DOUBLE_EQ(1e-7, mlcpSolver.getContactTolerance());
+	mlcpSolver.setMaxIterations(12);
+	EXPECT_EQ(12u, mlcpSolver.getMaxIterations());
+	mlcpSolver.setMinConstraintsPerTask(4);
+	EXPECT_EQ(4u, mlcpSolver.getMinConstraintsPerTask());
+	EXPECT_THROW(mlcpSolver.setMinConstraintsPerTask(0), SurgSim::Framework::AssertionFailure);
+	EXPECT_LE(1u, mlcpSolver.getMaxNumTasks());
+	mlcpSolver.setMaxNumTasks(3);
+	EXPECT_EQ(3u, mlcpSolver.getMaxNumTasks());
+	EXPECT_THROW(mlcpSolver.setMaxNumTasks(0), SurgSim::Framework::AssertionFailure);
+}
+
+TEST(MlcpColoredGaussSeidelSolverTests, SolveOriginal)
+{
+	// The frictional contacts converge toward another solution than the Gauss-Seidel solver, within the friction cone
+	const std::shared_ptr<MlcpTestData> data = loadTestData("mlcpOriginalTest.txt");
+	ASSERT_TRUE(data != nullptr);
+	MlcpSolution solution;
+	solution.x.setZero(data->getSize());
+
+	MlcpColoredGaussSeidelSolver mlcpSolver(1e-9, 1e-9, 100);
+	EXPECT_TRUE(mlcpSolver.solve(data->problem, &solution));
+	EXPECT_TRUE(solution.validSignorini);
+	EXPECT_EQ(4u, mlcpSolver.getNumColors());
+
+	// The last two constraints are frictional contacts
+	for (size_t index = data->getSize() - 6; index < data->getSize(); index += 3)
+	{
+		EXPECT_GE(solution.x[index], 0.0);
+		EXPECT_LE(solution.x.segment<2>(index + 1).norm(), data->problem.mu[index] * solution.x[index] + 1e-12);
+	}
+}
+
+TEST(MlcpColoredGaussSeidelSolverTests, SolveSequence)
+{
+	for (int i = 0;  i <= 9;  ++i)
+	{
+		solveAndCompareResult(getTestFileName("mlcpTest", i, ".txt"));
+	}
+}
+
+TEST(MlcpColoredGaussSeidelSolverTests, Colors)
+{
+	const size_t numBodies = 50;
+	const size_t numContacts = 4;
+	const MlcpProblem problem = makeFrictionalProblem(numBodies, numContacts);
+	MlcpSolution solution;
+	solution.x.setZero(problem.getSize());
+
+	// The bodies are independent, a color per bilateral constraint and contact of a body
+	MlcpColoredGaussSeidelSolver mlcpSolver;
+	mlcpSolver.solve(problem, &solution);
+	EXPECT_EQ(1 + numContacts, mlcpSolver.getNumColors());
+
+	// A chain of bilateral constraints, the contacts of neighbor bodies are enforced with coupled constraints
+	MlcpProblem coupled = problem;
+	for (size_t body = 1; body < numBodies; ++body)
+	{
+		coupled.A(3 * (body - 1), 3 * body) = 0.01;
+		coupled.A(3 * body, 3 * (body - 1)) = 0.01;
+	}
+	solution.x.setZero(problem.getSize());
+	mlcpSolver.solve(coupled, &solution);
+	EXPECT_EQ(2 + 2 * numContacts, mlcpSolver.getNumColors());
+
+	// The colors only depend on the pattern of A, not on its values
+	coupled.A *= 2.0;
+	solution.x.setZero(problem.getSize());
+	mlcpSolver.solve(coupled, &solution);
+	EXPECT_EQ(2 + 2 * numContacts, mlcpSolver.getNumColors());
+	solution.x.setZero(problem.getSize());
+	mlcpSolver.solve(problem, &solution);
+	EXPECT_EQ(1 + numContacts, mlcpSolver.getNumColors());
+
+	MlcpProblem empty;
+	solution.x.resize(0);
+	EXPECT_TRUE(mlcpSolver.solve(empty, &solution));
+	EXPECT_EQ(0u, mlcpSolver.getNumColors());
+}
+
+TEST(MlcpColoredGaussSeidelSolverTests, SolveFrictional)
+{
+	const MlcpProblem problem = makeFrictionalProblem(20, 4);
+	const double precision = 1e-8;
+	const double contactTolerance = 1e-8;
+	const size_t maxIterations = 200;
+
+	MlcpSolution expected;
+	expected.x.setZero(problem.getSize());
+	MlcpGaussSeidelSolver gaussSeidelSolver(precision, contactTolerance, maxIterations);
+	gaussSeidelSolver.solve(problem, &expected);
+
+	// Serial and parallel updates of the colors give the exact same solution
+	MlcpSolution serial;
+	serial.x.setZero(problem.getSize());
+	MlcpColoredGaussSeidelSolver mlcpSolver(precision, contactTolerance, maxIterations);
+	mlcpSolver.setMinConstraintsPerTask(problem.getSize());
+	mlcpSolver.solve(problem, &serial);
+
+	MlcpSolution parallel;
+	parallel.x.setZero(problem.getSize());
+	mlcpSolver.setMinConstraintsPerTask(1);
+	mlcpSolver.setMaxNumTasks(4);
+	mlcpSolver.solve(problem, &parallel);
+
+	EXPECT_TRUE(parallel.x == serial.x);
+	EXPECT_EQ(serial.numIterations, parallel.numIterations);
+	EXPECT_EQ(serial.validSignorini, parallel.validSignorini);
+	EXPECT_DOUBLE_EQ(serial.convergenceCriteria, parallel.convergenceCriteria);
+
+	// Same solution as the Gauss-Seidel solver, within the precision, with active and inactive contacts
+	ASSERT_TRUE(SurgSim::Math::isValid(parallel.x));
+	EXPECT_TRUE(parallel.validSignorini);
+	EXPECT_TRUE(parallel.validConvergence);
+	EXPECT_NEAR(0.0, (parallel.x - expected.x).cwiseAbs().maxCoeff(), 1e-6);
+	EXPECT_GT(parallel.x.maxCoeff(), 0.0);
+	EXPECT_LT(parallel.x.minCoeff(), 0.0);
+}
+
+TEST(MlcpColoredGaussSeidelSolverTests, SolveInactiveContacts)
+{
+	const MlcpProblem problem = makeFrictionalProblem(20, 4, 0.5);
+	const double precision = 1e-8;
+
+	MlcpSolution solution;
+	solution.x.setZero(problem.getSize());
+	MlcpColoredGaussSeidelSolver mlcpSolver(precision, precision, 200);
+	EXPECT_TRUE(mlcpSolver.solve(problem, &solution));
+	EXPECT_TRUE(solution.validSignorini);
+	EXPECT_LT(solution.numIterations, 200u);
+
+	// Complementarity of the normal forces, with active and inactive contacts
+	const Eigen::VectorXd violation = problem.A * solution.x + problem.b;
+	size_t numInactive = 0;
+	for (size_t index = 3 * 20; index < problem.getSize(); index += 3)
+	{
+		EXPECT_GE(solution.x[index], 0.0);
+		EXPECT_GE(violation[index], -precision);
+		EXPECT_NEAR(0.0, solution.x[index] * violation[index], precision);
+		numInactive += (solution.x[index] == 0.0) ? 1 : 0;
+	}
+	EXPECT_LT(0u, numInactive);
+	EXPECT_GT(20u * 4u, numInactive);
+}
+
+TEST(MlcpColoredGaussSeidelSolverTests, SolveFromThreadPool)
+{
+	const MlcpProblem problem = makeFrictionalProblem(20, 4);
+	MlcpColoredGaussSeidelSolver mlcpSolver(1e-8, 1e-8, 200);
+	mlcpSolver.setMinConstraintsPerTask(1);
+	mlcpSolver.setMaxNumTasks(4);
+
+	MlcpSolution expected;
+	expected.x.setZero(problem.getSize());
+	mlcpSolver.solve(problem, &expected);
+
+	// From one of its tasks, the solver doesn't wait for tasks queued behind it on the thread pool
+	MlcpSolution solution;
+	solution.x.setZero(problem.getSize());
+	std::future<bool> result = SurgSim::Framework::Runtime::getThreadPool()->enqueue<bool>(
+		[&mlcpSolver, &problem, &solution]() { return mlcpSolver.solve(problem, &solution); });
+	ASSERT_EQ(std::future_status::ready, result.wait_for(std::chrono::seconds(10)));
+	EXPECT_EQ(expected.numIterations, solution.numIterations);
+	EXPECT_TRUE(solution.x == expected.x);
+}
@@ -0,0 +1,75 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <memory>
+#include <string>
+
+#include "SurgSim/Math/MlcpGaussSeidelSolver.h"
+#include "SurgSim/Math/MlcpProblem.h"
+#include "SurgSim/Math/MlcpSolution.h"
+#include "SurgSim/Testing/MlcpIO/MlcpTestData.h"
+#include "SurgSim/Testing/MlcpIO/ReadText.h"
+
+using SurgSim::Math::MlcpGaussSeidelSolver;
+using SurgSim::Math::MlcpProblem;
+using SurgSim::Math::MlcpSolution;
+
+TEST(MlcpProblemTests, SaveAndLoad)
+{
+	const std::string fileName = "MlcpProblemTests.mlcp";
+	for (int i = 0; i <= 9; ++i)
+	{
+		SCOPED_TRACE(getTestFileName("mlcpTest", i, ".txt"));
+		std::shared_ptr<MlcpTestData> data = loadTestData(getTestFileName("mlcpTest", i, ".txt"));
+		ASSERT_NE(nullptr, data);
+		ASSERT_TRUE(data->problem.save(fileName));
+
+		MlcpProblem problem;
+		ASSERT_TRUE(problem.load(fileName));
+		EXPECT_TRUE(problem.isConsistent());
+		EXPECT_EQ(data->problem.A, problem.A);
+		EXPECT_EQ(data->problem.b, problem.b);
+		EXPECT_EQ(data->problem.mu, problem.mu);
+		EXPECT_EQ(data->problem.constraintTypes, problem.constraintTypes);
+
+		// The replayed problem is solved exactly as the original one
+		MlcpGaussSeidelSolver solver(1e-9, 1e-9, 100);
+		MlcpSolution original, replayed;
+		original.x.setZero(data->problem.getSize());
+		replayed.x.setZero(problem.getSize());
+		solver.solve(data->problem, &original);
+		solver.solve(problem, &replayed);
+		EXPECT_EQ(original.x, replayed.x);
+		EXPECT_EQ(original.numIterations, replayed.numIterations);
+	}
+	boost::filesystem::remove(fileName);
+}
+
+TEST(MlcpProblemTests, LoadInvalid)
+{
+	MlcpProblem problem;
+	EXPECT_FALSE(problem.load("MlcpProblemTestsMissing.mlcp"));
+	EXPECT_FALSE(problem.load("MlcpTestData/mlcpTest000.txt"));
+
+	// An empty problem can be saved and loaded
+	const std::string fileName = "MlcpProblemTestsEmpty.mlcp";
+	ASSERT_TRUE(MlcpProblem::Zero(0, 0, 0).save(fileName));
+	EXPECT_TRUE(problem.load(fileName));
+	EXPECT_EQ(0u, problem.getSize());
+	boost::filesystem::remove(fileName);
+}
@@ -22,6 +22,7 @@
 #include <gtest/gtest.h>
 
 #include "SurgSim/Math/OdeSolverEulerImplicit.h"
+#include "SurgSim/Math/OdeSolverEulerImplicitQuasiNewton.h"
 #include "SurgSim/Math/OdeSolverLinearEulerImplicit.h"
 #include "SurgSim/Math/UnitTests/MockObject.h"
 
@@ -51,6 +52,10 @@ TEST(OdeSolverEulerImplicit, ConstructorTest)
 		SCOPED_TRACE("LinearEulerImplicit");
 		doConstructorTest<OdeSolverLinearEulerImplicit>();
 	}
+	{
+		SCOPED_TRACE("EulerImplicitQuasiNewton");
+		doConstructorTest<OdeSolverEulerImplicitQuasiNewton>();
+	}
 }
 
 namespace
@@ -134,6 +139,15 @@ TEST(OdeSolverEulerImplicit, SolveTest)
 		SCOPED_TRACE("LinearEulerImplicit not computing the compliance matrix");
 		doSolveTest<OdeSolverLinearEulerImplicit>(false);
 	}
+
+	{
+		SCOPED_TRACE("EulerImplicitQuasiNewton computing the compliance matrix");
+		doSolveTest<OdeSolverEulerImplicitQuasiNewton>(true);
+	}
+	{
+		SCOPED_TRACE("EulerImplicitQuasiNewton not computing the compliance matrix");
+		doSolveTest<OdeSolverEulerImplicitQuasiNewton>(false);
+	}
 }
 
 namespace
@@ -217,6 +231,19 @@ TEST(OdeSolverEulerImplicit, VerifyComplexNonLinearOdeTest)
 
 		doComplexNonLinearOdeTest<OdeSolverLinearEulerImplicit>(10, false);
 	}
+
+	// OdeSolverEulerImplicitQuasiNewton converges more slowly than the Newton-Raphson, but converges
+	{
+		SCOPED_TRACE("A single iteration, using OdeSolverEulerImplicitQuasiNewton");
+
+		doComplexNonLinearOdeTest<OdeSolverEulerImplicitQuasiNewton>(1, false);
+	}
+
+	{
+		SCOPED_TRACE("Multiple iterations, using OdeSolverEulerImplicitQuasiNewton");
+
+		doComplexNonLinearOdeTest<OdeSolverEulerImplicitQuasiNewton>(100, true);
+	}
 }
 
 namespace
@@ -249,6 +276,45 @@ TEST(OdeSolverEulerImplicit, ComputeMatricesTest)
 		SCOPED_TRACE("LinearEulerImplicit");
 		doComputeMatricesTest<OdeSolverLinearEulerImplicit>();
 	}
+
+	{
+		SCOPED_TRACE("EulerImplicitQuasiNewton");
+		doComputeMatricesTest<OdeSolverEulerImplicitQuasiNewton>();
+	}
+}
+
+TEST(OdeSolverEulerImplicit, QuasiNewtonConstantMatrixTest)
+{
+	OdeComplexNonLinear odeEquation;
+	MassPointState state0, state1, state2;
+	state0.getPositions().setLinSpaced(1.4, 5.67);
+	state0.getVelocities().setLinSpaced(-0.4, -0.3);
+	double dt = 1e-3;
+	auto solver = std::make_shared<OdeSolverEulerImplicitQuasiNewton>(&odeEquation);
+	odeEquation.setOdeSolver(solver);
+	EXPECT_EQ(5u, solver->getNewtonRaphsonMaximumIteration());
+	solver->setNewtonRaphsonMaximumIteration(100);
+	solver->setNewtonRaphsonEpsilonConvergence(1e-13);
+
+	// The system matrix is assembled on the first state and kept constant
+	odeEquation.updateFMDK(state0, ODEEQUATIONUPDATE_M | ODEEQUATIONUPDATE_D | ODEEQUATIONUPDATE_K);
+	Matrix expectedSystemMatrix = odeEquation.getM() / dt + odeEquation.getD() + dt * odeEquation.getK();
+
+	ASSERT_NO_THROW(solver->solve(dt, state0, &state1));
+	EXPECT_TRUE(solver->getSystemMatrix().isApprox(expectedSystemMatrix));
+	EXPECT_TRUE(solver->getComplianceMatrix().isApprox(expectedSystemMatrix.inverse()));
+	EXPECT_LT(1u, solver->getNumIterations());
+	EXPECT_GT(100u, solver->getNumIterations());
+
+	ASSERT_NO_THROW(solver->solve(dt, state1, &state2));
+	EXPECT_TRUE(solver->getSystemMatrix().isApprox(expectedSystemMatrix));
+	EXPECT_TRUE(solver->getComplianceMatrix().isApprox(expectedSystemMatrix.inverse()));
+
+	// Changing the time step triggers a new factorization
+	odeEquation.updateFMDK(state2, ODEEQUATIONUPDATE_M | ODEEQUATIONUPDATE_D | ODEEQUATIONUPDATE_K);
+	expectedSystemMatrix = odeEquation.getM() / (2.0 * dt) + odeEquation.getD() + 2.0 * dt * odeEquation.getK();
+	ASSERT_NO_THROW(solver->solve(2.0 * dt, state2, &state1));
+	EXPECT_TRUE(solver->getSystemMatrix().isApprox(expectedSystemMatrix));
 }
 
 }; // Math
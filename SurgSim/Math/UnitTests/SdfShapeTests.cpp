@@ -0,0 +1,228 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+#include "SurgSim/DataStructures/BinaryCache.h"
+#include "SurgSim/DataStructures/TriangleMesh.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Math/BoxShape.h"
+#include "SurgSim/Math/MathConvert.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/SdfShape.h"
+#include "SurgSim/Math/Vector.h"
+
+using SurgSim::DataStructures::TriangleMeshPlain;
+using SurgSim::Math::MeshShape;
+using SurgSim::Math::SdfShape;
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+
+/// \return A closed mesh of a unit cube centered on the origin, with outward normals
+std::shared_ptr<MeshShape> makeCubeMesh()
+{
+	auto mesh = std::make_shared<TriangleMeshPlain>();
+	for (int i = 0; i < 8; ++i)
+	{
+		mesh->addVertex(TriangleMeshPlain::VertexType(Vector3d((i & 1) - 0.5, ((i >> 1) & 1) - 0.5,
+						((i >> 2) & 1) - 0.5)));
+	}
+	const std::array<std::array<size_t, 3>, 12> triangles = {{
+			{{0, 2, 1}}, {{1, 2, 3}}, {{4, 5, 6}}, {{5, 7, 6}}, {{0, 1, 4}}, {{1, 5, 4}},
+			{{2, 6, 3}}, {{3, 6, 7}}, {{0, 4, 2}}, {{2, 4, 6}}, {{1, 3, 5}}, {{3, 7, 5}}
+		}
+	};
+	for (const auto& triangle : triangles)
+	{
+		mesh->addTriangle(TriangleMeshPlain::TriangleType(triangle));
+	}
+	return std::make_shared<MeshShape>(*mesh);
+}
+
+}
+
+namespace SurgSim
+{
+
+namespace Math
+{
+
+TEST(SdfShapeTests, InitTest)
+{
+	SdfShape shape;
+	EXPECT_EQ(SHAPE_TYPE_SDF, shape.getType());
+	EXPECT_FALSE(shape.isValid());
+	EXPECT_FALSE(shape.isTransformable());
+
+	shape.setCellSize(0.1);
+	EXPECT_DOUBLE_EQ(0.1, shape.getCellSize());
+	EXPECT_DOUBLE_EQ(0.1, shape.getValue<double>("CellSize"));
+	EXPECT_THROW(shape.setCellSize(0.0), SurgSim::Framework::AssertionFailure);
+
+	EXPECT_DOUBLE_EQ(0.005, shape.getNarrowBandWidth());
+	shape.setNarrowBandWidth(0.2);
+	EXPECT_DOUBLE_EQ(0.2, shape.getNarrowBandWidth());
+	EXPECT_THROW(shape.setNarrowBandWidth(-1.0), SurgSim::Framework::AssertionFailure);
+
+	EXPECT_THROW(shape.getDistance(Vector3d::Zero()), SurgSim::Framework::AssertionFailure);
+
+	std::shared_ptr<Shape> factoryShape;
+	ASSERT_NO_THROW(factoryShape = Shape::getFactory().create("SurgSim::Math::SdfShape"));
+	EXPECT_EQ(SHAPE_TYPE_SDF, factoryShape->getType());
+}
+
+TEST(SdfShapeTests, DenseCubeTest)
+{
+	const double cellSize = 0.05;
+	SdfShape shape;
+	shape.setCellSize(cellSize);
+	shape.setNarrowBandWidth(0.0);
+	shape.buildFromMesh(*makeCubeMesh());
+	ASSERT_TRUE(shape.isValid());
+
+	// The field covers the cube with some padding
+	EXPECT_TRUE(shape.getBoundingBox().contains(Aabbd(Vector3d::Constant(-0.6), Vector3d::Constant(0.6))));
+	EXPECT_EQ(shape.getBoundingBox().min(), shape.getOrigin());
+
+	// The distance is piecewise linear near the faces, so exactly interpolated
+	Vector3d gradient;
+	EXPECT_NEAR(0.2, shape.getDistance(Vector3d(0.7, 0.1, -0.05), &gradient), 1e-6);
+	EXPECT_TRUE(gradient.isApprox(Vector3d::UnitX(), 1e-6));
+	EXPECT_NEAR(-0.1, shape.getDistance(Vector3d(0.0, -0.4, 0.05), &gradient), 1e-6);
+	EXPECT_TRUE(gradient.isApprox(-Vector3d::UnitY(), 1e-6));
+	EXPECT_NEAR(0.01, shape.getDistance(Vector3d(0.1, 0.2, 0.51)), 1e-6);
+
+	// Close to the center, the interpolation is within a cell of the exact distance
+	EXPECT_NEAR(-0.5, shape.getDistance(Vector3d(0.01, -0.02, 0.03)), cellSize);
+
+	// Outside of the grid
+	EXPECT_NEAR(4.5, shape.getDistance(Vector3d(5.0, 0.0, 0.0), &gradient), 1e-6);
+	EXPECT_TRUE(gradient.isApprox(Vector3d::UnitX()));
+
+	// The volume integrals are approximated within about a cell
+	BoxShape box(1.0, 1.0, 1.0);
+	EXPECT_NEAR(box.getVolume(), shape.getVolume(), 0.2);
+	EXPECT_TRUE(shape.getCenter().isZero(cellSize));
+	EXPECT_TRUE(shape.getSecondMomentOfVolume().isApprox(box.getSecondMomentOfVolume(), 0.3));
+
+	// The segment distance finds the deepest point of a segment
+	Vector3d point;
+	EXPECT_NEAR(-0.1, shape.getSegmentDistance(Vector3d(0.4, 0.8, 0.0), Vector3d(0.4, -0.8, 0.0), &point), 1e-6);
+	EXPECT_NEAR(0.4, point[0], 1e-9);
+	EXPECT_NEAR(0.2, shape.getSegmentDistance(Vector3d(0.7, 0.0, 0.0), Vector3d(0.9, 0.0, 0.0), &point), 1e-6);
+	EXPECT_TRUE(point.isApprox(Vector3d(0.7, 0.0, 0.0)));
+}
+
+TEST(SdfShapeTests, NarrowBandCubeTest)
+{
+	const double cellSize = 0.02;
+	SdfShape dense;
+	dense.setCellSize(cellSize);
+	dense.setNarrowBandWidth(0.0);
+	dense.buildFromMesh(*makeCubeMesh());
+
+	SdfShape narrow;
+	narrow.setCellSize(cellSize);
+	narrow.setNarrowBandWidth(0.06);
+	narrow.buildFromMesh(*makeCubeMesh());
+	ASSERT_TRUE(narrow.isValid());
+
+	auto countBricks = [](const SdfShape& shape)
+	{
+		const auto& numNodes = shape.getNumNodes();
+		return ((numNodes[0] + SdfShape::BrickSize - 1) / SdfShape::BrickSize) *
+			   ((numNodes[1] + SdfShape::BrickSize - 1) / SdfShape::BrickSize) *
+			   ((numNodes[2] + SdfShape::BrickSize - 1) / SdfShape::BrickSize);
+	};
+	EXPECT_EQ(countBricks(dense), dense.getNumStoredBricks());
+	EXPECT_LT(narrow.getNumStoredBricks(), countBricks(narrow));
+
+	// Within the narrow band, the fields match
+	for (double x = -0.54; x <= -0.46; x += 0.013)
+	{
+		const Vector3d point(x, 0.11, -0.23);
+		Vector3d denseGradient, narrowGradient;
+		EXPECT_NEAR(dense.getDistance(point, &denseGradient), narrow.getDistance(point, &narrowGradient), 1e-6);
+		EXPECT_TRUE(narrowGradient.isApprox(denseGradient, 1e-6));
+	}
+
+	// Beyond it, only the sign is kept
+	EXPECT_NEAR(-0.06, narrow.getDistance(Vector3d::Zero()), 1e-6);
+	EXPECT_NEAR(0.06, narrow.getDistance(Vector3d(0.55, 0.55, 0.55)), 1e-6);
+
+	// The nodes lying on the faces of the cube can be classified either way
+	EXPECT_NEAR(dense.getVolume(), narrow.getVolume(), 1e-3);
+}
+
+TEST(SdfShapeTests, LoadMeshTest)
+{
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+	const bool isCacheEnabled = SurgSim::DataStructures::isBinaryCacheEnabled();
+	SurgSim::DataStructures::setBinaryCacheEnabled(false);
+
+	// A sphere of radius 0.05
+	auto shape = std::make_shared<SdfShape>();
+	shape->setCellSize(0.005);
+	shape->setNarrowBandWidth(0.01);
+	ASSERT_NO_THROW(shape->loadMesh("Geometry/sphere.ply"));
+	EXPECT_EQ("Geometry/sphere.ply", shape->getMeshFileName());
+	ASSERT_TRUE(shape->isValid());
+
+	EXPECT_NEAR(-0.01, shape->getDistance(Vector3d::Zero()), 1e-6);
+	EXPECT_NEAR(0.005, shape->getDistance(Vector3d(0.0, 0.055, 0.0)), 1e-3);
+	EXPECT_NEAR(-0.005, shape->getDistance(Vector3d(0.0, 0.0, -0.045)), 1e-3);
+	EXPECT_NEAR(4.0 / 3.0 * M_PI * 0.05 * 0.05 * 0.05, shape->getVolume(), 1e-4);
+
+	// Changing the cell size rebuilds the field, when queried
+	const size_t numNodes = shape->getNumNodes()[0];
+	shape->setCellSize(0.0025);
+	EXPECT_LT(numNodes, shape->getNumNodes()[0]);
+
+	// The parameters are only stored, the field is built once all of them are set
+	auto lazyShape = std::make_shared<SdfShape>();
+	ASSERT_NO_THROW(lazyShape->setMeshFileName("Geometry/DoesNotExist.ply"));
+	lazyShape->setCellSize(0.0025);
+	EXPECT_THROW(lazyShape->isValid(), SurgSim::Framework::AssertionFailure);
+	lazyShape->setMeshFileName("Geometry/sphere.ply");
+	lazyShape->setNarrowBandWidth(0.01);
+	EXPECT_TRUE(lazyShape->isValid());
+	EXPECT_EQ(shape->getNumNodes(), lazyShape->getNumNodes());
+	EXPECT_EQ(shape->getNumStoredBricks(), lazyShape->getNumStoredBricks());
+
+	// Serialization, through the base class
+	std::shared_ptr<Shape> baseShape = shape;
+	YAML::Node node;
+	ASSERT_NO_THROW(node = baseShape);
+	std::shared_ptr<SdfShape> newShape;
+	ASSERT_NO_THROW(newShape = std::dynamic_pointer_cast<SdfShape>(node.as<std::shared_ptr<Shape>>()));
+	ASSERT_NE(nullptr, newShape);
+	EXPECT_DOUBLE_EQ(0.0025, newShape->getCellSize());
+	EXPECT_DOUBLE_EQ(0.01, newShape->getNarrowBandWidth());
+	EXPECT_EQ(shape->getNumNodes(), newShape->getNumNodes());
+	EXPECT_NEAR(shape->getDistance(Vector3d(0.01, 0.02, 0.03)), newShape->getDistance(Vector3d(0.01, 0.02, 0.03)),
+				1e-9);
+
+	EXPECT_THROW(shape->loadMesh("Geometry/DoesNotExist.ply"), SurgSim::Framework::AssertionFailure);
+	SurgSim::DataStructures::setBinaryCacheEnabled(isCacheEnabled);
+}
+
+}; // namespace Math
+
+}; // namespace SurgSim
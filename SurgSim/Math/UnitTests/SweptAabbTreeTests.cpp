@@ -0,0 +1,244 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "SurgSim/DataStructures/AabbTree.h"
+#include "SurgSim/DataStructures/SegmentMesh.h"
+#include "SurgSim/DataStructures/TriangleMesh.h"
+#include "SurgSim/Math/Aabb.h"
+#include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/SegmentMeshShape.h"
+#include "SurgSim/Math/SweptAabbTree.h"
+#include "SurgSim/Math/Vector.h"
+
+using SurgSim::DataStructures::SegmentMeshPlain;
+using SurgSim::DataStructures::TriangleMeshPlain;
+
+namespace
+{
+
+/// Build a grid of triangles in the plane y = 0
+std::shared_ptr<SurgSim::Math::MeshShape> buildGrid(const SurgSim::Math::Vector3d& origin, size_t size)
+{
+	TriangleMeshPlain mesh;
+	for (size_t i = 0; i <= size; ++i)
+	{
+		for (size_t j = 0; j <= size; ++j)
+		{
+			mesh.addVertex(TriangleMeshPlain::VertexType(
+							   origin + SurgSim::Math::Vector3d(static_cast<double>(i), 0.0, static_cast<double>(j))));
+		}
+	}
+	for (size_t i = 0; i < size; ++i)
+	{
+		for (size_t j = 0; j < size; ++j)
+		{
+			size_t v0 = i * (size + 1) + j;
+			std::array<size_t, 3> triangle0 = {{v0, v0 + 1, v0 + size + 1}};
+			std::array<size_t, 3> triangle1 = {{v0 + 1, v0 + size + 2, v0 + size + 1}};
+			mesh.addTriangle(TriangleMeshPlain::TriangleType(triangle0));
+			mesh.addTriangle(TriangleMeshPlain::TriangleType(triangle1));
+		}
+	}
+	return std::make_shared<SurgSim::Math::MeshShape>(mesh);
+}
+
+/// Move all the vertices of a mesh
+void translate(const SurgSim::Math::Vector3d& translation, SurgSim::Math::MeshShape* mesh)
+{
+	for (size_t id = 0; id < mesh->getNumVertices(); ++id)
+	{
+		mesh->setVertexPosition(id, mesh->getVertexPosition(id) + translation);
+	}
+}
+
+/// \return The AABB of a triangle at both time points
+SurgSim::Math::Aabbd sweptAabb(const SurgSim::Math::MeshShape& meshAtTime0, const SurgSim::Math::MeshShape& meshAtTime1,
+							   size_t id)
+{
+	SurgSim::Math::Aabbd aabb;
+	for (size_t vertexId : meshAtTime0.getTriangle(id).verticesId)
+	{
+		aabb.extend(meshAtTime0.getVertexPosition(vertexId));
+		aabb.extend(meshAtTime1.getVertexPosition(vertexId));
+	}
+	return aabb;
+}
+
+}
+
+namespace SurgSim
+{
+namespace Math
+{
+
+TEST(SweptAabbTreeTests, MeshTest)
+{
+	auto meshAtTime0 = buildGrid(Vector3d::Zero(), 3);
+	auto meshAtTime1 = std::make_shared<MeshShape>(*meshAtTime0);
+	translate(Vector3d(0.5, 1.0, 0.0), meshAtTime1.get());
+
+	auto tree = buildSweptAabbTree(*meshAtTime0, *meshAtTime1);
+	ASSERT_NE(nullptr, tree);
+	EXPECT_TRUE(Aabbd(Vector3d::Zero(), Vector3d(3.5, 1.0, 3.0)).isApprox(tree->getAabb())) << tree->getAabb();
+
+	auto other = buildGrid(Vector3d(0.0, 2.0, 0.0), 2);
+	EXPECT_THROW(buildSweptAabbTree(*meshAtTime0, *other), SurgSim::Framework::AssertionFailure);
+}
+
+TEST(SweptAabbTreeTests, MeshCandidatesTest)
+{
+	// A static grid, and a smaller grid moving through a part of it
+	auto mesh1 = buildGrid(Vector3d::Zero(), 8);
+	auto mesh2AtTime0 = buildGrid(Vector3d(2.2, 1.0, 3.3), 2);
+	auto mesh2AtTime1 = std::make_shared<MeshShape>(*mesh2AtTime0);
+	translate(Vector3d(0.3, -2.0, 0.1), mesh2AtTime1.get());
+
+	std::vector<std::pair<size_t, size_t>> candidates;
+	getSweptCandidates(*buildSweptAabbTree(*mesh1, *mesh1), *buildSweptAabbTree(*mesh2AtTime0, *mesh2AtTime1),
+					   &candidates);
+
+	// Same pairs as testing all the swept volumes against each other, in the same order
+	std::vector<std::pair<size_t, size_t>> expected;
+	for (size_t id1 = 0; id1 < mesh1->getNumTriangles(); ++id1)
+	{
+		for (size_t id2 = 0; id2 < mesh2AtTime0->getNumTriangles(); ++id2)
+		{
+			if (doAabbIntersect(sweptAabb(*mesh1, *mesh1, id1), sweptAabb(*mesh2AtTime0, *mesh2AtTime1, id2)))
+			{
+				expected.emplace_back(id1, id2);
+			}
+		}
+	}
+	EXPECT_FALSE(expected.empty());
+	EXPECT_EQ(expected, candidates);
+
+	// No overlap once the motion misses the static grid
+	translate(Vector3d(0.0, 3.0, 0.0), mesh2AtTime0.get());
+	translate(Vector3d(0.0, 3.0, 0.0), mesh2AtTime1.get());
+	getSweptCandidates(*buildSweptAabbTree(*mesh1, *mesh1), *buildSweptAabbTree(*mesh2AtTime0, *mesh2AtTime1),
+					   &candidates);
+	EXPECT_TRUE(candidates.empty());
+}
+
+TEST(SweptAabbTreeTests, SegmentMeshTest)
+{
+	SegmentMeshPlain mesh;
+	mesh.addVertex(SegmentMeshPlain::VertexType(Vector3d(0.0, 0.0, 0.0)));
+	mesh.addVertex(SegmentMeshPlain::VertexType(Vector3d(1.0, 0.0, 0.0)));
+	std::array<size_t, 2> edge = {{0, 1}};
+	mesh.addEdge(SegmentMeshPlain::EdgeType(edge));
+
+	SegmentMeshShape segmentAtTime0(mesh, 0.01);
+	SegmentMeshShape segmentAtTime1(mesh, 0.01);
+	segmentAtTime1.setVertexPosition(1, Vector3d(1.0, 0.5, 0.0));
+
+	auto tree = buildSweptAabbTree(segmentAtTime0, segmentAtTime1, 0.01);
+	EXPECT_TRUE(Aabbd(Vector3d(-0.01, -0.01, -0.01), Vector3d(1.01, 0.51, 0.01)).isApprox(tree->getAabb()))
+			<< tree->getAabb();
+
+	// A parallel static segment, 0.1 away, only overlaps when the expansion covers the gap
+	SegmentMeshShape other(mesh, 0.01);
+	for (size_t id = 0; id < 2; ++id)
+	{
+		other.setVertexPosition(id, other.getVertexPosition(id) + Vector3d(0.0, 0.0, 0.1));
+	}
+
+	std::vector<std::pair<size_t, size_t>> candidates;
+	getSweptCandidates(*tree, *buildSweptAabbTree(other, other, 0.01), &candidates);
+	EXPECT_TRUE(candidates.empty());
+
+	getSweptCandidates(*buildSweptAabbTree(segmentAtTime0, segmentAtTime1, 0.06),
+					   *buildSweptAabbTree(other, other, 0.06), &candidates);
+	ASSERT_EQ(1u, candidates.size());
+	EXPECT_EQ(std::make_pair(static_cast<size_t>(0), static_cast<size_t>(0)), candidates[0]);
+}
+
+TEST(SweptAabbTreeTests, UpdateTest)
+{
+	auto mesh1 = buildGrid(Vector3d::Zero(), 8);
+	auto mesh2AtTime0 = buildGrid(Vector3d(2.2, 1.0, 3.3), 2);
+	auto mesh2AtTime1 = std::make_shared<MeshShape>(*mesh2AtTime0);
+	auto tree1 = buildSweptAabbTree(*mesh1, *mesh1);
+	auto tree2 = buildSweptAabbTree(*mesh2AtTime0, *mesh2AtTime1);
+
+	std::vector<std::pair<size_t, size_t>> candidates;
+	getSweptCandidates(*tree1, *tree2, &candidates);
+	EXPECT_TRUE(candidates.empty());
+
+	// The refit tree finds the same pairs as a new one
+	translate(Vector3d(0.3, -2.0, 0.1), mesh2AtTime1.get());
+	updateSweptAabbTree(*mesh2AtTime0, *mesh2AtTime1, tree2.get());
+	EXPECT_TRUE(buildSweptAabbTree(*mesh2AtTime0, *mesh2AtTime1)->getAabb().isApprox(tree2->getAabb()));
+
+	std::vector<std::pair<size_t, size_t>> expected;
+	getSweptCandidates(*tree1, *buildSweptAabbTree(*mesh2AtTime0, *mesh2AtTime1), &expected);
+	getSweptCandidates(*tree1, *tree2, &candidates);
+	EXPECT_FALSE(expected.empty());
+	EXPECT_EQ(expected, candidates);
+
+	SegmentMeshPlain mesh;
+	mesh.addVertex(SegmentMeshPlain::VertexType(Vector3d(0.0, 0.0, 0.0)));
+	mesh.addVertex(SegmentMeshPlain::VertexType(Vector3d(1.0, 0.0, 0.0)));
+	std::array<size_t, 2> edge = {{0, 1}};
+	mesh.addEdge(SegmentMeshPlain::EdgeType(edge));
+	SegmentMeshShape segmentAtTime0(mesh, 0.01);
+	SegmentMeshShape segmentAtTime1(mesh, 0.01);
+	auto segmentTree = buildSweptAabbTree(segmentAtTime0, segmentAtTime1, 0.01);
+
+	segmentAtTime1.setVertexPosition(1, Vector3d(1.0, 0.5, 0.0));
+	updateSweptAabbTree(segmentAtTime0, segmentAtTime1, 0.01, segmentTree.get());
+	EXPECT_TRUE(Aabbd(Vector3d(-0.01, -0.01, -0.01), Vector3d(1.01, 0.51, 0.01)).isApprox(segmentTree->getAabb()))
+			<< segmentTree->getAabb();
+}
+
+TEST(SweptAabbTreeTests, GetSweptAabbTreeTest)
+{
+	auto meshAtTime0 = buildGrid(Vector3d::Zero(), 3);
+	auto meshAtTime1 = std::make_shared<MeshShape>(*meshAtTime0);
+	translate(Vector3d(0.5, 1.0, 0.0), meshAtTime1.get());
+
+	// Without a tree in the mesh, a new one is built
+	auto tree = getSweptAabbTree(*meshAtTime0, *meshAtTime1);
+	ASSERT_NE(nullptr, tree);
+	EXPECT_TRUE(Aabbd(Vector3d::Zero(), Vector3d(3.5, 1.0, 3.0)).isApprox(tree->getAabb())) << tree->getAabb();
+
+	// Otherwise the tree of the mesh at time 1 is used, and not copied along with the mesh
+	auto cached = buildSweptAabbTree(*meshAtTime0, *meshAtTime1);
+	meshAtTime1->setSweptAabbTree(cached);
+	EXPECT_EQ(cached, getSweptAabbTree(*meshAtTime0, *meshAtTime1));
+	EXPECT_EQ(nullptr, MeshShape(*meshAtTime1).getSweptAabbTree());
+
+	SegmentMeshPlain mesh;
+	mesh.addVertex(SegmentMeshPlain::VertexType(Vector3d(0.0, 0.0, 0.0)));
+	mesh.addVertex(SegmentMeshPlain::VertexType(Vector3d(1.0, 0.0, 0.0)));
+	std::array<size_t, 2> edge = {{0, 1}};
+	mesh.addEdge(SegmentMeshPlain::EdgeType(edge));
+	SegmentMeshShape segment(mesh, 0.01);
+
+	// The segments are expanded by their radius
+	auto segmentTree = getSweptAabbTree(segment, segment);
+	EXPECT_TRUE(Aabbd(Vector3d(-0.01, -0.01, -0.01), Vector3d(1.01, 0.01, 0.01)).isApprox(segmentTree->getAabb()))
+			<< segmentTree->getAabb();
+	auto cachedSegmentTree = buildSweptAabbTree(segment, segment, 0.01);
+	segment.setSweptAabbTree(cachedSegmentTree);
+	EXPECT_EQ(cachedSegmentTree, getSweptAabbTree(segment, segment));
+}
+
+}; // namespace Math
+}; // namespace SurgSim
@@ -109,6 +109,7 @@ double ParticlesCollisionRepresentation::getParticleRadius() const
 void ParticlesCollisionRepresentation::updateShapeData()
 {
 	*m_shape = getParticleRepresentation()->getParticles().unsafeGet();
+	markShapeChanged();
 	SurgSim::Collision::Representation::updateShapeData();
 }
 
@@ -25,6 +25,54 @@ using Eigen::VectorXd;
 #include "SurgSim/Physics/PhysicsManagerState.h"
 #include "SurgSim/Physics/Representation.h"
 
+namespace
+{
+
+/// Bring the contribution of a proxy representation to the time step of the problem.
+/// The compliance of the proxy was computed for the time step of its own update, it is scaled linearly with the time
+/// step, which requires the response of the proxy to be dominated by its inertia (see
+/// Representation::isInertiaDominated()). The violations were computed with the state at the end of the proxy
+/// update, they are moved along the velocity of the proxy to the end of the time step.
+/// \param dt The time step of the problem
+/// \param proxy The proxy representation
+/// \param timing The timing of the last update of the proxy
+/// \param indexOfRepresentation The index of the first dof of the proxy in the problem
+/// \param [in,out] problem The problem, built for all the constraints
+void bringProxyToTimeStep(double dt, const SurgSim::Physics::Representation& proxy,
+						  const SurgSim::Physics::ProxyTiming& timing, ptrdiff_t indexOfRepresentation,
+						  SurgSim::Physics::MlcpPhysicsProblem* problem)
+{
+	const ptrdiff_t numDof = static_cast<ptrdiff_t>(proxy.getNumDof());
+	if (numDof == 0 || problem->getSize() == 0)
+	{
+		return;
+	}
+
+	const double complianceScale = dt / timing.timeStep;
+	const SurgSim::Math::Vector velocity = proxy.getDofVelocity();
+	const auto& H = problem->H;
+	for (ptrdiff_t row = 0; row < H.outerSize(); ++row)
+	{
+		for (Eigen::SparseMatrix<double, Eigen::RowMajor, ptrdiff_t>::InnerIterator it(H, row); it; ++it)
+		{
+			const ptrdiff_t dof = it.col() - indexOfRepresentation;
+			if (dof >= 0 && dof < numDof)
+			{
+				SURGSIM_ASSERT(complianceScale == 1.0 || proxy.isInertiaDominated())
+					<< proxy.getFullName() << " is constrained as a proxy with a time step of " << dt << " instead of "
+					<< timing.timeStep << ", but its compliance can't be scaled as it is not dominated by its "
+					<< "inertia. Use the same rate divider for the representations it interacts with.";
+				// H is scaled by dt, so H.v / dt is the velocity of the proxy along the constraint
+				problem->b[row] += it.value() * velocity[dof] * timing.timeOffset / dt;
+				problem->A.row(row) += ((complianceScale - 1.0) * it.value()) * problem->CHt.row(it.col());
+			}
+		}
+	}
+	problem->CHt.middleRows(indexOfRepresentation, numDof) *= complianceScale;
+}
+
+}
+
 namespace SurgSim
 {
 namespace Physics
@@ -63,6 +111,20 @@ BuildMlcp::doUpdate(const double& dt, const std::shared_ptr<PhysicsManagerState>
 		representationsMapping.setValue((*it).get(), numDof);
 		numDof += (*it)->getNumDof();
 	}
+
+	// The proxy representations take part in the constraint resolution, but they are not corrected
+	const auto& proxies = result->getProxyRepresentations();
+	const auto& proxyTimings = result->getProxyTimings();
+	SURGSIM_ASSERT(proxyTimings.empty() || proxyTimings.size() == proxies.size())
+		<< "There are " << proxyTimings.size() << " proxy timings for " << proxies.size() << " proxies";
+	for (const auto& proxy : proxies)
+	{
+		if (proxy->isActive())
+		{
+			representationsMapping.setValue(proxy.get(), numDof);
+			numDof += proxy->getNumDof();
+		}
+	}
 	result->setRepresentationsMapping(representationsMapping);
 
 	// Resize the Mlcp problem
@@ -102,6 +164,15 @@ BuildMlcp::doUpdate(const double& dt, const std::shared_ptr<PhysicsManagerState>
 		(*it)->build(dt, &result->getMlcpProblem(), indexRepresentation0, indexRepresentation1, indexConstraint);
 	}
 
+	for (size_t i = 0; i < proxyTimings.size(); ++i)
+	{
+		if (proxies[i]->isActive())
+		{
+			const ptrdiff_t index = result->getRepresentationsMapping().getValue(proxies[i].get());
+			bringProxyToTimeStep(dt, *proxies[i], proxyTimings[i], index, &result->getMlcpProblem());
+		}
+	}
+
 	return result;
 }
 
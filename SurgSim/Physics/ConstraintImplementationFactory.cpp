@@ -13,6 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <boost/thread/locks.hpp>
+
 #include "SurgSim/Blocks/MassSpring1DRepresentation.h"
 #include "SurgSim/Blocks/MassSpring2DRepresentation.h"
 #include "SurgSim/Blocks/MassSpring3DRepresentation.h"
@@ -20,6 +22,7 @@
 #include "SurgSim/Physics/ConstraintImplementationFactory.h"
 #include "SurgSim/Physics/Fem1DRepresentation.h"
 #include "SurgSim/Physics/Fem2DRepresentation.h"
+#include "SurgSim/Physics/Fem3DModalRepresentation.h"
 #include "SurgSim/Physics/Fem3DRepresentation.h"
 #include "SurgSim/Physics/FemConstraintFixedPoint.h"
 #include "SurgSim/Physics/FemConstraintFixedRotationVector.h"
@@ -66,6 +69,12 @@ ConstraintImplementationFactory::ConstraintImplementationFactory()
 	addImplementation(typeid(Fem2DRepresentation), std::make_shared<FemConstraintFrictionalSliding>());
 	addImplementation(typeid(Fem3DRepresentation), std::make_shared<FemConstraintFrictionalSliding>());
 
+	// The modal constraints only go through the localizations, the full state and the compliance matrix
+	addImplementation(typeid(Fem3DModalRepresentation), std::make_shared<FemConstraintFrictionlessContact>());
+	addImplementation(typeid(Fem3DModalRepresentation), std::make_shared<FemConstraintFixedPoint>());
+	addImplementation(typeid(Fem3DModalRepresentation), std::make_shared<FemConstraintFrictionlessSliding>());
+	addImplementation(typeid(Fem3DModalRepresentation), std::make_shared<FemConstraintFrictionalSliding>());
+
 	addImplementation(typeid(FixedRepresentation), std::make_shared<FixedConstraintFixedRotationVector>());
 	addImplementation(typeid(RigidRepresentation), std::make_shared<RigidConstraintFixedRotationVector>());
 	addImplementation(typeid(Fem1DRepresentation), std::make_shared<FemConstraintFixedRotationVector>());
@@ -90,7 +99,15 @@ std::shared_ptr<ConstraintImplementation> ConstraintImplementationFactory::getIm
 	SURGSIM_ASSERT(constraintType >= 0 && constraintType < NUM_CONSTRAINT_TYPES) <<
 		"Invalid constraint type " << constraintType;
 
-	auto implementation = m_implementations[representationType][constraintType];
+	std::shared_ptr<ConstraintImplementation> implementation;
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		auto implementations = m_implementations.find(representationType);
+		if (implementations != m_implementations.end())
+		{
+			implementation = implementations->second[constraintType];
+		}
+	}
 	SURGSIM_LOG_IF(implementation == nullptr, SurgSim::Framework::Logger::getDefaultLogger(), WARNING) <<
 		"No constraint implementation for representation type (" << representationType.name() <<
 		") and constraint type (" << constraintType << ")";
@@ -101,6 +118,7 @@ std::shared_ptr<ConstraintImplementation> ConstraintImplementationFactory::getIm
 void ConstraintImplementationFactory::addImplementation(
 	std::type_index typeIndex, std::shared_ptr<ConstraintImplementation> implementation)
 {
+	boost::lock_guard<boost::mutex> lock(m_mutex);
 	m_implementations[typeIndex][implementation->getConstraintType()] =
 		implementation;
 }
@@ -17,6 +17,7 @@
 #define SURGSIM_PHYSICS_CONSTRAINTIMPLEMENTATIONFACTORY_H
 
 #include <array>
+#include <boost/thread/mutex.hpp>
 #include <memory>
 #include <typeindex>
 #include <unordered_map>
@@ -35,6 +36,7 @@ class ConstraintImplementation;
 /// by representation and constraint type.
 /// The only maintenance that needs to be done right now when a new
 /// ConstraintImplementation is added is to add a call into the constructor.
+/// Implementations can be looked up and added concurrently, e.g. while scene elements are decoded in parallel.
 class ConstraintImplementationFactory
 {
 public:
@@ -65,6 +67,9 @@ class ConstraintImplementationFactory
 	std::unordered_map<std::type_index,
 		std::array<std::shared_ptr<ConstraintImplementation>, NUM_CONSTRAINT_TYPES>>
 		m_implementations;
+
+	/// Guards m_implementations
+	mutable boost::mutex m_mutex;
 };
 
 }; // Physics
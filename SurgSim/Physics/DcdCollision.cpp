@@ -33,7 +33,9 @@ namespace Physics
 {
 
 DcdCollision::DcdCollision(bool doCopyState) :
-	Computation(doCopyState)
+	Computation(doCopyState),
+	m_contactCachingEnabled(false),
+	m_skippedPairsFraction(0.0)
 {
 }
 
@@ -41,6 +43,21 @@ DcdCollision::~DcdCollision()
 {
 }
 
+void DcdCollision::setContactCachingEnabled(bool enabled)
+{
+	m_contactCachingEnabled = enabled;
+}
+
+bool DcdCollision::isContactCachingEnabled() const
+{
+	return m_contactCachingEnabled;
+}
+
+double DcdCollision::getSkippedPairsFraction() const
+{
+	return m_skippedPairsFraction;
+}
+
 std::shared_ptr<PhysicsManagerState> DcdCollision::doUpdate(
 	const double& dt,
 	const std::shared_ptr<PhysicsManagerState>& state)
@@ -51,20 +68,36 @@ std::shared_ptr<PhysicsManagerState> DcdCollision::doUpdate(
 
 	const auto& calculations = ContactCalculation::getDcdContactTable();
 
+	const bool cacheContacts = m_contactCachingEnabled;
+	size_t numPairs = 0;
+	size_t numSkippedPairs = 0;
 	for (auto& pair : result->getCollisionPairs())
 	{
 		if (pair->getType() == Collision::COLLISION_DETECTION_TYPE_DISCRETE)
 		{
-			tasks.push_back(threadPool->enqueue<void>([&calculations, &pair]()
+			++numPairs;
+			if (cacheContacts && pair->restoreCachedContacts())
+			{
+				++numSkippedPairs;
+				continue;
+			}
+
+			tasks.push_back(threadPool->enqueue<void>([&calculations, &pair, cacheContacts]()
 			{
 				calculations[pair->getFirst()->getShapeType()]
 				[pair->getSecond()->getShapeType()]->calculateContact(pair);
+				if (cacheContacts)
+				{
+					pair->cacheContacts();
+				}
 			}));
 		}
 	}
 
 	std::for_each(tasks.begin(), tasks.end(), [](std::future<void>& p){p.get();});
 
+	m_skippedPairsFraction = (numPairs > 0) ? static_cast<double>(numSkippedPairs) / numPairs : 0.0;
+
 	return result;
 }
 
@@ -16,6 +16,7 @@
 #ifndef SURGSIM_PHYSICS_DCDCOLLISION_H
 #define SURGSIM_PHYSICS_DCDCOLLISION_H
 
+#include <atomic>
 #include <memory>
 
 #include "SurgSim/Framework/Macros.h"
@@ -40,6 +41,11 @@ class PhysicsManagerState;
 /// function objects (ContactCalculation) to determine how to calculate a contact between the two
 /// members of each pair, if no specific function exists a default function will be used.
 /// will update the collision pairs accordingly.
+/// The pairs are kept across the frames (see PrepareCollisionPairs), when neither representation of a pair has changed
+/// since its contacts were last calculated (see Collision::Representation::getShapeVersion), the previous contacts
+/// are reused and the contact calculation is skipped, e.g. for an instrument resting on a table. This contact
+/// caching is off by default, as a shape modified in place without Collision::Representation::markShapeChanged() would
+/// keep its stale contacts.
 /// \note When a new ContactCalculation type gets implemented, the type needs to be registered with the table
 /// inside of ContactCalculation
 class DcdCollision : public Computation
@@ -55,6 +61,16 @@ class DcdCollision : public Computation
 	/// Destructor
 	virtual ~DcdCollision();
 
+	/// \param enabled Whether the contacts of the unchanged pairs are reused from the previous frame (false by default)
+	void setContactCachingEnabled(bool enabled);
+
+	/// \return Whether the contacts of the unchanged pairs are reused from the previous frame
+	bool isContactCachingEnabled() const;
+
+	/// \return The fraction of the discrete collision pairs whose contact calculation was skipped during the last
+	/// update, the contacts being reused from the previous frame
+	double getSkippedPairsFraction() const;
+
 protected:
 
 	/// Executes the update operation, overridden from Computation.
@@ -62,6 +78,13 @@ class DcdCollision : public Computation
 	/// \param state The PhysicsManagerState from previous computation.
 	std::shared_ptr<PhysicsManagerState> doUpdate(const double& dt, const std::shared_ptr<PhysicsManagerState>& state)
 	override;
+
+private:
+	/// Whether the contacts of the unchanged pairs are reused
+	std::atomic<bool> m_contactCachingEnabled;
+
+	/// The fraction of the pairs skipped during the last update
+	std::atomic<double> m_skippedPairsFraction;
 };
 
 }; // Physics
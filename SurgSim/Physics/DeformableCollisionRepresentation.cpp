@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "SurgSim/DataStructures/AabbTree.h"
 #include "SurgSim/DataStructures/TriangleMesh.h"
 #include "SurgSim/Framework/ObjectFactory.h"
 #include "SurgSim/Framework/Runtime.h"
@@ -24,6 +25,7 @@
 #include "SurgSim/Math/SegmentMeshShape.h"
 #include "SurgSim/Math/Shape.h"
 #include "SurgSim/Math/SurfaceMeshShape.h"
+#include "SurgSim/Math/SweptAabbTree.h"
 #include "SurgSim/Physics/DeformableCollisionRepresentation.h"
 #include "SurgSim/Physics/DeformableRepresentation.h"
 
@@ -37,11 +39,13 @@ SURGSIM_REGISTER(SurgSim::Framework::Component, SurgSim::Physics::DeformableColl
 DeformableCollisionRepresentation::DeformableCollisionRepresentation(const std::string& name) :
 	SurgSim::Collision::Representation(name),
 	m_oldVolume(0.0),
-	m_previousOldVolume(0.0),
-	m_aabbThreshold(0.1)
+	m_aabbThreshold(0.1),
+	m_updateTolerance(0.0)
 {
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableCollisionRepresentation, std::shared_ptr<SurgSim::Math::Shape>,
 									  Shape, getShape, setShape);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableCollisionRepresentation, double, UpdateTolerance,
+									  getUpdateTolerance, setUpdateTolerance);
 }
 
 DeformableCollisionRepresentation::~DeformableCollisionRepresentation()
@@ -52,26 +56,45 @@ namespace
 {
 
 /// Call update on the shape if the AABB tree has changed significantly, otherwise just update the AABB tree.
+/// Only the vertices whose node moved farther than the tolerance are updated, for triangle meshes only the triangles
+/// using them are then recomputed.
 /// \param odeState The state.
 /// \param [in,out] shape The shape to update.
 /// \param [in,out] oldVolume The previous volume of the AABB tree.
 /// \param threshold The aabb volume threshold that triggers a tree rebuild.
+/// \param tolerance The distance a node has to move for its vertex to be updated.
+/// \param [out] movedNodes The nodes whose vertex was updated.
 void updateShapeFromOdeState(const Math::OdeState& odeState, SurgSim::Math::Shape* shape,
-	double* oldVolume, double threshold)
+	double* oldVolume, double threshold, double tolerance, std::vector<size_t>* movedNodes)
 {
+	auto vertices = dynamic_cast<DataStructures::VerticesPlain*>(shape);
+	SURGSIM_ASSERT(vertices != nullptr)
+			<< "The shape object is not inherited from DataStructures::VerticesPlain, but should be.";
+	const size_t numNodes = odeState.getNumNodes();
+	SURGSIM_ASSERT(vertices->getNumVertices() == numNodes) <<
+		"The number of nodes in the deformable does not match the number of vertices in the shape.";
+
+	const double squaredTolerance = tolerance * tolerance;
+	movedNodes->clear();
+	for (size_t nodeId = 0; nodeId < numNodes; ++nodeId)
+	{
+		const Math::Vector3d position = odeState.getPosition(nodeId);
+		if ((position - vertices->getVertexPosition(nodeId)).squaredNorm() > squaredTolerance)
+		{
+			vertices->setVertexPosition(nodeId, position);
+			movedNodes->push_back(nodeId);
+		}
+	}
+	if (movedNodes->empty())
+	{
+		return;
+	}
+
 	if (shape->getType() == SurgSim::Math::SHAPE_TYPE_MESH ||
 		shape->getType() == SurgSim::Math::SHAPE_TYPE_SURFACEMESH)
 	{
 		auto meshShape = dynamic_cast<SurgSim::Math::MeshShape*>(shape);
 		SURGSIM_ASSERT(meshShape != nullptr) << "The shape is neither a mesh nor a surface mesh";
-		const size_t numNodes = odeState.getNumNodes();
-		SURGSIM_ASSERT(meshShape->getNumVertices() == numNodes) <<
-			"The number of nodes in the deformable does not match the number of vertices in the shape.";
-
-		for (size_t nodeId = 0; nodeId < numNodes; ++nodeId)
-		{
-			meshShape->setVertexPosition(nodeId, odeState.getPosition(nodeId));
-		}
 
 		if (std::abs(*oldVolume - meshShape->getBoundingBox().volume()) >(*oldVolume) * threshold)
 		{
@@ -80,22 +103,13 @@ void updateShapeFromOdeState(const Math::OdeState& odeState, SurgSim::Math::Shap
 		}
 		else
 		{
-			meshShape->updateAabbTree();
-			meshShape->calculateNormals();
+			meshShape->updateMovedVertices(*movedNodes);
 		}
 	}
 	else if (shape->getType() == SurgSim::Math::SHAPE_TYPE_SEGMENTMESH)
 	{
 		auto meshShape = dynamic_cast<SurgSim::Math::SegmentMeshShape*>(shape);
 		SURGSIM_ASSERT(meshShape != nullptr) << "The shape is of type SegmentMeshShape but the dynamic cast failed.";
-		const size_t numNodes = odeState.getNumNodes();
-		SURGSIM_ASSERT(meshShape->getNumVertices() == numNodes) <<
-			"The number of nodes in the deformable does not match the number of vertices in the shape.";
-
-		for (size_t nodeId = 0; nodeId < numNodes; ++nodeId)
-		{
-			meshShape->setVertexPosition(nodeId, odeState.getPosition(nodeId));
-		}
 
 		if (std::abs(*oldVolume - meshShape->getBoundingBox().volume()) > (*oldVolume) * threshold)
 		{
@@ -108,6 +122,66 @@ void updateShapeFromOdeState(const Math::OdeState& odeState, SurgSim::Math::Shap
 		}
 	}
 }
+
+/// Only update the vertex positions of a shape, its normals and AabbTree are left untouched.
+/// \param odeState The state.
+/// \param [in,out] shape The shape to update.
+/// \return The bounding box of the vertices.
+Math::Aabbd updateVerticesFromOdeState(const Math::OdeState& odeState, SurgSim::Math::Shape* shape)
+{
+	auto vertices = dynamic_cast<DataStructures::VerticesPlain*>(shape);
+	SURGSIM_ASSERT(vertices != nullptr)
+			<< "The shape object is not inherited from DataStructures::VerticesPlain, but should be.";
+	const size_t numNodes = odeState.getNumNodes();
+	SURGSIM_ASSERT(vertices->getNumVertices() == numNodes) <<
+		"The number of nodes in the deformable does not match the number of vertices in the shape.";
+
+	Math::Aabbd aabb;
+	for (size_t nodeId = 0; nodeId < numNodes; ++nodeId)
+	{
+		vertices->setVertexPosition(nodeId, odeState.getPosition(nodeId));
+		aabb.extend(vertices->getVertexPosition(nodeId));
+	}
+	return aabb;
+}
+
+/// Build the swept tree of a shape motion the first time, refit it afterwards, and hand it to the shape at the end of
+/// the motion, so that the continuous contact calculations don't rebuild it for every pair.
+/// \param previousShape The shape at the start of the motion.
+/// \param [in,out] shape The shape at the end of the motion, with the same topology.
+/// \param [in,out] tree The swept tree, nullptr to build a new one.
+void updateSweptTree(const Math::Shape& previousShape, Math::Shape* shape,
+					 std::shared_ptr<DataStructures::AabbTree>* tree)
+{
+	if (shape->getType() == Math::SHAPE_TYPE_SEGMENTMESH)
+	{
+		auto& previousMesh = dynamic_cast<const Math::SegmentMeshShape&>(previousShape);
+		auto mesh = dynamic_cast<Math::SegmentMeshShape*>(shape);
+		if (*tree == nullptr)
+		{
+			*tree = Math::buildSweptAabbTree(previousMesh, *mesh, mesh->getRadius());
+		}
+		else
+		{
+			Math::updateSweptAabbTree(previousMesh, *mesh, mesh->getRadius(), tree->get());
+		}
+		mesh->setSweptAabbTree(*tree);
+	}
+	else
+	{
+		auto& previousMesh = dynamic_cast<const Math::MeshShape&>(previousShape);
+		auto mesh = dynamic_cast<Math::MeshShape*>(shape);
+		if (*tree == nullptr)
+		{
+			*tree = Math::buildSweptAabbTree(previousMesh, *mesh);
+		}
+		else
+		{
+			Math::updateSweptAabbTree(previousMesh, *mesh, tree->get());
+		}
+		mesh->setSweptAabbTree(*tree);
+	}
+}
 }
 
 bool DeformableCollisionRepresentation::doInitialize()
@@ -194,6 +268,7 @@ void DeformableCollisionRepresentation::setShape(std::shared_ptr<SurgSim::Math::
 		") or SurfaceMeshShape(" << SurgSim::Math::SHAPE_TYPE_SURFACEMESH << "), but it is " << m_shape->getType();
 
 	m_shape = shape;
+	m_sweptAabbTree.reset();
 
 	if ((getCollisionDetectionType() == Collision::COLLISION_DETECTION_TYPE_CONTINUOUS) ||
 		(getSelfCollisionDetectionType() == Collision::COLLISION_DETECTION_TYPE_CONTINUOUS))
@@ -234,6 +309,17 @@ DeformableCollisionRepresentation::getDeformableRepresentation() const
 }
 
 
+void DeformableCollisionRepresentation::setUpdateTolerance(double tolerance)
+{
+	SURGSIM_ASSERT(tolerance >= 0.0) << "The update tolerance can't be negative on " << getFullName();
+	m_updateTolerance = tolerance;
+}
+
+double DeformableCollisionRepresentation::getUpdateTolerance() const
+{
+	return m_updateTolerance;
+}
+
 void DeformableCollisionRepresentation::updateShapeData()
 {
 	auto physicsRepresentation = m_deformable.lock();
@@ -242,14 +328,19 @@ void DeformableCollisionRepresentation::updateShapeData()
 			"Physics::Representation or the Physics::Representation has expired.";
 
 	updateShapeFromOdeState(*physicsRepresentation->getCurrentState().get(), m_shape.get(),
-		&m_oldVolume, m_aabbThreshold);
+		&m_oldVolume, m_aabbThreshold, m_updateTolerance, &m_movedNodes);
 	m_aabb = m_shape->getBoundingBox();
+	if (!m_movedNodes.empty())
+	{
+		markShapeChanged();
+	}
 
 	if (m_previousShape != nullptr)
 	{
-		updateShapeFromOdeState(*physicsRepresentation->getPreviousState().get(), m_previousShape.get(),
-			&m_previousOldVolume, m_aabbThreshold);
-		m_aabb.extend(m_previousShape->getBoundingBox());
+		// The continuous collision detection only uses the positions of the previous shape, the swept volumes are
+		// bounded by their own AabbTree, so the normals and the AabbTree of the previous shape are not updated
+		m_aabb.extend(updateVerticesFromOdeState(*physicsRepresentation->getPreviousState().get(),
+						m_previousShape.get()));
 	}
 }
 
@@ -268,21 +359,22 @@ void DeformableCollisionRepresentation::updateCcdData(double interval)
 
 	// We should only need to update the previous state's shape & AABB once per CCD loop, right?
 	// And we already did so in updateShapeData, above.
-	//updateShapeFromOdeState(*physicsRepresentation->getPreviousState().get(), m_previousShape.get(),
-	//	&m_previousOldVolume, m_aabbThreshold);
+	//updateVerticesFromOdeState(*physicsRepresentation->getPreviousState().get(), m_previousShape.get());
 
 	updateShapeFromOdeState(*physicsRepresentation->getCurrentState().get(), m_shape.get(),
-		&m_oldVolume, m_aabbThreshold);
+		&m_oldVolume, m_aabbThreshold, m_updateTolerance, &m_movedNodes);
 	m_aabb.extend(m_shape->getBoundingBox());
+	if (!m_movedNodes.empty())
+	{
+		markShapeChanged();
+	}
+	updateSweptTree(*m_previousShape, m_shape.get(), &m_sweptAabbTree);
 
 	Math::PosedShape<std::shared_ptr<Math::Shape>> posedShapeFirst(m_previousShape, Math::RigidTransform3d::Identity());
 	Math::PosedShape<std::shared_ptr<Math::Shape>> posedShapeSecond(m_shape, Math::RigidTransform3d::Identity());
 	Math::PosedShapeMotion<std::shared_ptr<Math::Shape>> posedShapeMotion(posedShapeFirst, posedShapeSecond);
 	setPosedShapeMotion(posedShapeMotion);
 
-	// HS-2-Mar-2016
-	// #todo Add AABB tree for the posedShapeMotion (i.e. that is the tree where each bounding box consists of the
-	// corresponding elements from posedShape1 and posedShape2
 }
 
 SurgSim::Math::Aabbd DeformableCollisionRepresentation::getBoundingBox() const
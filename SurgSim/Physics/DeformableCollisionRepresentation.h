@@ -18,12 +18,18 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "SurgSim/Collision/Representation.h"
 #include "SurgSim/Framework/ObjectFactory.h"
 
 namespace SurgSim
 {
+namespace DataStructures
+{
+class AabbTree;
+}
+
 namespace Math
 {
 class Shape;
@@ -39,6 +45,9 @@ SURGSIM_STATIC_REGISTRATION(DeformableCollisionRepresentation);
 /// A collision representation that can be attached to a deformable, when this contains a mesh with the same number
 /// of vertices as the deformable has nodes, the mesh vertices will move to match the positions of the nodes in
 /// the deformable.
+/// With the continuous collision detection, the posed shape motion starts with a copy of the shape that follows the
+/// previous state of the deformable. Only the vertex positions of that copy are updated, its AabbTree, normals and
+/// bounding box are left as they were when it was created (see Collision::Representation::getPosedShapeMotion()).
 class DeformableCollisionRepresentation : public SurgSim::Collision::Representation
 {
 public:
@@ -80,12 +89,25 @@ class DeformableCollisionRepresentation : public SurgSim::Collision::Representat
 
 	Math::Aabbd getBoundingBox() const override;
 
+	/// Set the distance a node has to move before its vertex, and the triangles using it, are updated in the shape.
+	/// Only these triangles get their normals and bounding boxes recomputed, and only the paths of their nodes in the
+	/// AabbTree are refit, which is much cheaper when a tool deforms a small patch of a large mesh.
+	/// \param tolerance The distance (in m), 0 (default) updates every node that moved at all
+	void setUpdateTolerance(double tolerance);
+
+	/// \return The distance (in m) a node has to move before its vertex is updated in the shape
+	double getUpdateTolerance() const;
+
 private:
 	bool doInitialize() override;
 	bool doWakeUp() override;
 
 	/// Shape used for collision detection
-	std::shared_ptr<SurgSim::Math::Shape> m_shape, m_previousShape;
+	std::shared_ptr<SurgSim::Math::Shape> m_shape;
+
+	/// Shape at the previous state of the deformable, for the continuous collision detection only, nullptr otherwise.
+	/// Only its vertex positions are updated.
+	std::shared_ptr<SurgSim::Math::Shape> m_previousShape;
 
 	/// Stores the bounding box for the shape.  If this collision rep uses CCD, the bounding box encompasses both
 	/// the previous state and the current state.
@@ -95,8 +117,17 @@ class DeformableCollisionRepresentation : public SurgSim::Collision::Representat
 	std::weak_ptr<SurgSim::Physics::DeformableRepresentation> m_deformable;
 
 	double m_oldVolume;
-	double m_previousOldVolume;
 	double m_aabbThreshold;
+
+	/// The distance a node has to move before its vertex is updated
+	double m_updateTolerance;
+
+	/// The nodes that moved during the last update, kept to avoid reallocations
+	std::vector<size_t> m_movedNodes;
+
+	/// The tree over the volume swept by the shape between the previous and the current state, built once and refit
+	/// in every updateCcdData(), it is handed to the current shape for the continuous collision detection
+	std::shared_ptr<DataStructures::AabbTree> m_sweptAabbTree;
 };
 
 } // namespace Physics
@@ -22,6 +22,7 @@
 #include "SurgSim/Math/OdeSolverEulerExplicit.h"
 #include "SurgSim/Math/OdeSolverEulerExplicitModified.h"
 #include "SurgSim/Math/OdeSolverEulerImplicit.h"
+#include "SurgSim/Math/OdeSolverEulerImplicitQuasiNewton.h"
 #include "SurgSim/Math/OdeSolverRungeKutta4.h"
 #include "SurgSim/Math/OdeSolverLinearEulerExplicit.h"
 #include "SurgSim/Math/OdeSolverLinearEulerExplicitModified.h"
@@ -49,12 +50,24 @@ DeformableRepresentation::DeformableRepresentation(const std::string& name) :
 	SurgSim::Math::OdeEquation(),
 	m_numDofPerNode(0),
 	m_integrationScheme(SurgSim::Math::INTEGRATIONSCHEME_EULER_EXPLICIT),
-	m_linearSolver(SurgSim::Math::LINEARSOLVER_LU)
+	m_linearSolver(SurgSim::Math::LINEARSOLVER_LU),
+	m_pcgPreconditioner(SurgSim::Math::PRECONDITIONER_BLOCK_JACOBI),
+	m_pcgTolerance(1.0e-6),
+	m_pcgMaxIterations(100),
+	m_pcgWarmStart(true)
 {
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableRepresentation, SurgSim::Math::IntegrationScheme, IntegrationScheme,
 									  getIntegrationScheme, setIntegrationScheme);
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableRepresentation, SurgSim::Math::LinearSolver, LinearSolver,
 									  getLinearSolver, setLinearSolver);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableRepresentation, SurgSim::Math::PcgPreconditioner, PcgPreconditioner,
+									  getPcgPreconditioner, setPcgPreconditioner);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableRepresentation, double, PcgTolerance,
+									  getPcgTolerance, setPcgTolerance);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableRepresentation, size_t, PcgMaxIterations,
+									  getPcgMaxIterations, setPcgMaxIterations);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableRepresentation, bool, PcgWarmStart,
+									  isPcgWarmStarting, setPcgWarmStart);
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(DeformableRepresentation, std::shared_ptr<SurgSim::Collision::Representation>,
 									  CollisionRepresentation, getCollisionRepresentation, setCollisionRepresentation);
 }
@@ -156,6 +169,55 @@ SurgSim::Math::LinearSolver DeformableRepresentation::getLinearSolver() const
 	return m_linearSolver;
 }
 
+void DeformableRepresentation::setPcgPreconditioner(SurgSim::Math::PcgPreconditioner preconditioner)
+{
+	SURGSIM_ASSERT(!isInitialized()) <<
+									 "You cannot set the preconditioner after the component has been initialized";
+	m_pcgPreconditioner = preconditioner;
+}
+
+SurgSim::Math::PcgPreconditioner DeformableRepresentation::getPcgPreconditioner() const
+{
+	return m_pcgPreconditioner;
+}
+
+void DeformableRepresentation::setPcgTolerance(double tolerance)
+{
+	SURGSIM_ASSERT(!isInitialized()) <<
+									 "You cannot set the solver tolerance after the component has been initialized";
+	SURGSIM_ASSERT(tolerance >= 0.0) << "The solver tolerance cannot be negative";
+	m_pcgTolerance = tolerance;
+}
+
+double DeformableRepresentation::getPcgTolerance() const
+{
+	return m_pcgTolerance;
+}
+
+void DeformableRepresentation::setPcgMaxIterations(size_t iterations)
+{
+	SURGSIM_ASSERT(!isInitialized()) <<
+									 "You cannot set the solver iterations after the component has been initialized";
+	m_pcgMaxIterations = iterations;
+}
+
+size_t DeformableRepresentation::getPcgMaxIterations() const
+{
+	return m_pcgMaxIterations;
+}
+
+void DeformableRepresentation::setPcgWarmStart(bool warmStart)
+{
+	SURGSIM_ASSERT(!isInitialized()) <<
+									 "You cannot set the solver warm start after the component has been initialized";
+	m_pcgWarmStart = warmStart;
+}
+
+bool DeformableRepresentation::isPcgWarmStarting() const
+{
+	return m_pcgWarmStart;
+}
+
 const SurgSim::Math::Vector& DeformableRepresentation::getExternalGeneralizedForce() const
 {
 	return m_externalGeneralizedForce;
@@ -273,6 +335,11 @@ void DeformableRepresentation::applyCorrection(double dt,
 	}
 }
 
+SurgSim::Math::Vector DeformableRepresentation::getDofVelocity() const
+{
+	return m_currentState->getVelocities();
+}
+
 void DeformableRepresentation::deactivateAndReset()
 {
 	SURGSIM_LOG(SurgSim::Framework::Logger::getDefaultLogger(), DEBUG)
@@ -362,6 +429,9 @@ bool DeformableRepresentation::doInitialize()
 		case SurgSim::Math::INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4:
 			m_odeSolver = std::make_shared<SurgSim::Math::OdeSolverLinearRungeKutta4>(this);
 			break;
+		case SurgSim::Math::INTEGRATIONSCHEME_EULER_IMPLICIT_QUASI_NEWTON:
+			m_odeSolver = std::make_shared<SurgSim::Math::OdeSolverEulerImplicitQuasiNewton>(this);
+			break;
 		default:
 			SURGSIM_LOG_WARNING(SurgSim::Framework::Logger::getDefaultLogger())
 					<< "Ode solver (integration scheme) not initialized, the integration scheme is invalid";
@@ -377,6 +447,27 @@ bool DeformableRepresentation::doInitialize()
 		case SurgSim::Math::LINEARSOLVER_CONJUGATEGRADIENT:
 			m_odeSolver->setLinearSolver(std::make_shared<SurgSim::Math::LinearSparseSolveAndInverseCG>());
 			break;
+		case SurgSim::Math::LINEARSOLVER_PRECONDITIONEDCONJUGATEGRADIENT:
+		{
+			auto linearSolver = std::make_shared<SurgSim::Math::LinearSparseSolveAndInversePCG>();
+			linearSolver->setBlockSize(getNumDofPerNode());
+			linearSolver->setPreconditioner(m_pcgPreconditioner);
+			linearSolver->setTolerance(m_pcgTolerance);
+			linearSolver->setMaxIterations(static_cast<Eigen::Index>(m_pcgMaxIterations));
+			linearSolver->setWarmStart(m_pcgWarmStart);
+			m_odeSolver->setLinearSolver(linearSolver);
+			break;
+		}
+		case SurgSim::Math::LINEARSOLVER_TRIDIAGONALBLOCK:
+		{
+			auto linearSolver = std::make_shared<SurgSim::Math::LinearSparseSolveAndInverseTriDiagonalBlock>();
+			linearSolver->setBlockSize(getNumDofPerNode());
+			m_odeSolver->setLinearSolver(linearSolver);
+			break;
+		}
+		case SurgSim::Math::LINEARSOLVER_MIXEDPRECISIONLU:
+			m_odeSolver->setLinearSolver(std::make_shared<SurgSim::Math::LinearSparseSolveAndInverseMixedPrecisionLU>());
+			break;
 		default:
 			SURGSIM_LOG_WARNING(SurgSim::Framework::Logger::getDefaultLogger())
 					<< "Linear solver not initialized, the linear solver is invalid";
@@ -110,6 +110,43 @@ class DeformableRepresentation :
 	/// \note Default is SurgSim::Math::LINEARSOLVER_LU
 	SurgSim::Math::LinearSolver getLinearSolver() const;
 
+	/// Sets the preconditioner of the preconditioned conjugate gradient linear solver
+	/// \param preconditioner The preconditioner to use
+	/// \exception SurgSim::Framework::AssertionFailure raised if called after the component has been initialized.
+	void setPcgPreconditioner(SurgSim::Math::PcgPreconditioner preconditioner);
+
+	/// \return The preconditioner of the preconditioned conjugate gradient linear solver
+	/// \note Default is SurgSim::Math::PRECONDITIONER_BLOCK_JACOBI
+	SurgSim::Math::PcgPreconditioner getPcgPreconditioner() const;
+
+	/// Sets the convergence tolerance of the preconditioned conjugate gradient linear solver
+	/// \param tolerance The tolerance, relative to the norm of the right-hand side
+	/// \exception SurgSim::Framework::AssertionFailure raised if called after the component has been initialized.
+	void setPcgTolerance(double tolerance);
+
+	/// \return The convergence tolerance of the preconditioned conjugate gradient linear solver
+	/// \note Default is 1e-6
+	double getPcgTolerance() const;
+
+	/// Sets the maximum number of iterations of the preconditioned conjugate gradient linear solver
+	/// \param iterations The maximum number of iterations, 0 to use twice the number of degrees of freedom
+	/// \exception SurgSim::Framework::AssertionFailure raised if called after the component has been initialized.
+	void setPcgMaxIterations(size_t iterations);
+
+	/// \return The maximum number of iterations of the preconditioned conjugate gradient linear solver
+	/// \note Default is 100
+	size_t getPcgMaxIterations() const;
+
+	/// Enables the warm start of the preconditioned conjugate gradient linear solver, i.e. the use of the previous
+	/// solution as initial guess
+	/// \param warmStart True to warm start the solver
+	/// \exception SurgSim::Framework::AssertionFailure raised if called after the component has been initialized.
+	void setPcgWarmStart(bool warmStart);
+
+	/// \return True if the preconditioned conjugate gradient linear solver is warm started
+	/// \note Default is true
+	bool isPcgWarmStarting() const;
+
 	/// Add an external generalized force applied on a specific localization
 	/// \param localization where the generalized force is applied
 	/// \param generalizedForce The force to apply (of dimension getNumDofPerNode())
@@ -140,6 +177,8 @@ class DeformableRepresentation :
 
 	void applyCorrection(double dt, const Eigen::VectorBlock<SurgSim::Math::Vector>& deltaVelocity) override;
 
+	SurgSim::Math::Vector getDofVelocity() const override;
+
 	/// Deactivate and call resetState
 	void deactivateAndReset();
 
@@ -198,6 +237,14 @@ class DeformableRepresentation :
 	/// Linear algebraic solver used
 	SurgSim::Math::LinearSolver m_linearSolver;
 
+	///@{
+	/// Settings of the preconditioned conjugate gradient linear solver
+	SurgSim::Math::PcgPreconditioner m_pcgPreconditioner;
+	double m_pcgTolerance;
+	size_t m_pcgMaxIterations;
+	bool m_pcgWarmStart;
+	///@}
+
 	/// Ode solver (its type depends on the numerical integration scheme)
 	std::shared_ptr<SurgSim::Math::OdeSolver> m_odeSolver;
 
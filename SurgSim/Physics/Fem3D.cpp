@@ -14,6 +14,9 @@
 // limitations under the License.
 
 #include "SurgSim/Physics/Fem3D.h"
+
+#include <algorithm>
+
 #include "SurgSim/Physics/Fem3DPlyReaderDelegate.h"
 
 namespace SurgSim
@@ -30,7 +33,98 @@ Fem3D::Fem3D()
 
 bool Fem3D::doLoad(const std::string& filePath)
 {
-	return loadFemFile<Fem3DPlyReaderDelegate, Fem3D>(filePath);
+	return SurgSim::DataStructures::loadWithBinaryCache(filePath, getClassName(),
+		std::bind(&Fem3D::loadBinaryCache, this, std::placeholders::_1),
+		[this, &filePath]()
+		{
+			return loadFemFile<Fem3DPlyReaderDelegate, Fem3D>(filePath);
+		},
+		std::bind(&Fem3D::saveBinaryCache, this, std::placeholders::_1));
+}
+
+void Fem3D::saveBinaryCache(SurgSim::DataStructures::BinaryCacheWriter* writer) const
+{
+	const auto& vertices = getVertices();
+	std::vector<double> positions;
+	positions.reserve(3 * vertices.size());
+	for (const auto& vertex : vertices)
+	{
+		positions.insert(positions.end(), vertex.position.data(), vertex.position.data() + 3);
+	}
+
+	// Elements are stored as their node count, followed by their node ids, the materials as
+	// (youngModulus, poissonRatio, massDensity) triplets.
+	std::vector<size_t> elements;
+	std::vector<double> materials;
+	materials.reserve(3 * m_elements.size());
+	for (const auto& element : m_elements)
+	{
+		elements.push_back(element->nodeIds.size());
+		elements.insert(elements.end(), element->nodeIds.begin(), element->nodeIds.end());
+		materials.push_back(element->youngModulus);
+		materials.push_back(element->poissonRatio);
+		materials.push_back(element->massDensity);
+	}
+
+	writer->write(positions);
+	writer->write(elements);
+	writer->write(materials);
+	writer->write(m_boundaryConditions);
+}
+
+bool Fem3D::loadBinaryCache(SurgSim::DataStructures::BinaryCacheReader* reader)
+{
+	std::vector<double> positions;
+	std::vector<size_t> elements;
+	std::vector<double> materials;
+	std::vector<size_t> boundaryConditions;
+	if (!reader->read(&positions) || !reader->read(&elements) || !reader->read(&materials) ||
+		!reader->read(&boundaryConditions) || positions.size() % 3 != 0 || materials.size() % 3 != 0)
+	{
+		return false;
+	}
+
+	const size_t numVertices = positions.size() / 3;
+	std::vector<std::shared_ptr<FemElementStructs::FemElement3DParameter>> parameters;
+	parameters.reserve(materials.size() / 3);
+	for (size_t i = 0; i < elements.size(); i += elements[i] + 1)
+	{
+		const size_t numNodes = elements[i];
+		const size_t index = parameters.size();
+		if ((numNodes != 4 && numNodes != 8) || elements.size() - i - 1 < numNodes || 3 * index >= materials.size())
+		{
+			return false;
+		}
+
+		auto parameter = std::make_shared<FemElementStructs::FemElement3DParameter>();
+		parameter->nodeIds.assign(elements.begin() + i + 1, elements.begin() + i + 1 + numNodes);
+		if (std::any_of(parameter->nodeIds.begin(), parameter->nodeIds.end(),
+						[numVertices](size_t id) {return id >= numVertices;}))
+		{
+			return false;
+		}
+		parameter->youngModulus = materials[3 * index];
+		parameter->poissonRatio = materials[3 * index + 1];
+		parameter->massDensity = materials[3 * index + 2];
+		parameters.push_back(parameter);
+	}
+	if (3 * parameters.size() != materials.size())
+	{
+		return false;
+	}
+
+	clear();
+	getVertices().reserve(numVertices);
+	for (size_t i = 0; i < positions.size(); i += 3)
+	{
+		addVertex(VertexType(SurgSim::Math::Vector3d(positions[i], positions[i + 1], positions[i + 2])));
+	}
+	m_elements = std::move(parameters);
+	m_boundaryConditions = std::move(boundaryConditions);
+
+	// Matches the parsing of the .ply file, which updates the mesh at the end of the file
+	update();
+	return true;
 }
 
 } // namespace Physics
@@ -17,6 +17,7 @@
 #define SURGSIM_PHYSICS_FEM3D_H
 
 #include "SurgSim/DataStructures/EmptyData.h"
+#include "SurgSim/DataStructures/BinaryCache.h"
 #include "SurgSim/Physics/Fem.h"
 
 namespace SurgSim
@@ -39,6 +40,17 @@ class Fem3D : public Fem<SurgSim::DataStructures::EmptyData, FemElementStructs::
 protected:
 	// Asset API override
 	bool doLoad(const std::string& filePath) override;
+
+private:
+	/// Write the vertices, the element table and the boundary conditions into a binary cache
+	/// \param writer The cache writer
+	void saveBinaryCache(SurgSim::DataStructures::BinaryCacheWriter* writer) const;
+
+	/// Restore the vertices, the element table and the boundary conditions from a binary cache written by
+	/// saveBinaryCache(), the mesh is only modified if the content of the cache is consistent.
+	/// \param reader The cache reader
+	/// \return true if the content of the cache was consistent, false otherwise
+	bool loadBinaryCache(SurgSim::DataStructures::BinaryCacheReader* reader);
 };
 
 } // namespace Physics
@@ -0,0 +1,341 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Physics/Fem3DCorotationalTetrahedronBatch.h"
+
+#include <algorithm>
+
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Math/OdeState.h"
+#include "SurgSim/Math/Quaternion.h"
+#include "SurgSim/Physics/Fem3DElementCorotationalTetrahedron.h"
+
+namespace
+{
+/// Convergence threshold on the rotation angle of the polar decomposition iterations
+const double rotationEpsilon = 1e-9;
+}
+
+namespace SurgSim
+{
+
+namespace Physics
+{
+
+Fem3DCorotationalTetrahedronBatch::Fem3DCorotationalTetrahedronBatch() :
+	m_numElements(0),
+	m_maxRotationIterations(20)
+{
+}
+
+void Fem3DCorotationalTetrahedronBatch::initialize(
+	const std::vector<std::shared_ptr<Fem3DElementCorotationalTetrahedron>>& elements,
+	const SurgSim::Math::OdeState& restState)
+{
+	SURGSIM_ASSERT(restState.getNumDof() == 3 * restState.getNumNodes()) <<
+		"Co-rotational tetrahedra expect 3 dofs per node, the state has " << restState.getNumDof() << " dofs for " <<
+		restState.getNumNodes() << " nodes";
+
+	m_numElements = elements.size();
+	m_packets.clear();
+	m_packets.resize((m_numElements + PacketSize - 1) / PacketSize);
+
+	for (size_t packetId = 0; packetId < m_packets.size(); ++packetId)
+	{
+		ElementPacket& packet = m_packets[packetId];
+		packet.numElements = std::min(PacketSize, m_numElements - packetId * PacketSize);
+
+		for (size_t lane = 0; lane < PacketSize; ++lane)
+		{
+			// The unused lanes replicate the last element of the packet, to keep the computations valid
+			const auto& element = elements[packetId * PacketSize + std::min(lane, packet.numElements - 1)];
+			SURGSIM_ASSERT(element != nullptr) << "Cannot batch a null element";
+
+			SurgSim::Math::Matrix44d V;
+			for (size_t node = 0; node < 4; ++node)
+			{
+				packet.nodeIds[lane][node] = element->getNodeId(node);
+				V.col(node).segment<3>(0) = restState.getPosition(packet.nodeIds[lane][node]);
+			}
+			V.row(3).setOnes();
+			SurgSim::Math::Matrix44d Vinverse;
+			double determinant;
+			bool invertible;
+			V.computeInverseAndDetWithCheck(Vinverse, determinant, invertible);
+			SURGSIM_ASSERT(invertible) << "Trying to batch a degenerated co-rotational tetrahedron";
+
+			const Eigen::Matrix<double, 12, 12>& K = element->getLinearStiffnessMatrix();
+			for (size_t node = 0; node < 4; ++node)
+			{
+				for (size_t axis = 0; axis < 3; ++axis)
+				{
+					packet.restShape[3 * node + axis][lane] = Vinverse(node, axis);
+					packet.x0[3 * node + axis][lane] = V(axis, node);
+				}
+			}
+			for (size_t row = 0; row < 12; ++row)
+			{
+				for (size_t col = 0; col < 12; ++col)
+				{
+					packet.stiffness[12 * row + col][lane] = K(row, col);
+				}
+			}
+		}
+
+		packet.rotation[0].setOnes();
+		packet.rotation[1].setZero();
+		packet.rotation[2].setZero();
+		packet.rotation[3].setZero();
+	}
+}
+
+size_t Fem3DCorotationalTetrahedronBatch::getNumElements() const
+{
+	return m_numElements;
+}
+
+void Fem3DCorotationalTetrahedronBatch::setMaxRotationIterations(size_t iterations)
+{
+	m_maxRotationIterations = iterations;
+}
+
+size_t Fem3DCorotationalTetrahedronBatch::getMaxRotationIterations() const
+{
+	return m_maxRotationIterations;
+}
+
+void Fem3DCorotationalTetrahedronBatch::updateRotations(const SurgSim::Math::OdeState& state)
+{
+	const SurgSim::Math::Vector& positions = state.getPositions();
+	std::array<Packet, 12> x;
+	std::array<Packet, 9> B;
+	std::array<Packet, 9> R;
+
+	for (auto& packet : m_packets)
+	{
+		gather(packet, positions, &x);
+
+		// Deformation gradient B = sum_k x_k.n_k^t, n_k being the first 3 entries of the k^th row of V^-1
+		for (size_t i = 0; i < 3; ++i)
+		{
+			for (size_t j = 0; j < 3; ++j)
+			{
+				Packet& b = B[3 * i + j];
+				b = x[i] * packet.restShape[j];
+				for (size_t node = 1; node < 4; ++node)
+				{
+					b += x[3 * node + i] * packet.restShape[3 * node + j];
+				}
+			}
+		}
+
+		// Polar decomposition of B, iterating on the quaternion q of the rotation:
+		// omega = sum_i (r_i x b_i) / (|sum_i r_i.b_i| + eps) with r_i, b_i the columns of R and B,
+		// q <- quaternion(angle |omega|, axis omega) * q
+		Packet& qw = packet.rotation[0];
+		Packet& qx = packet.rotation[1];
+		Packet& qy = packet.rotation[2];
+		Packet& qz = packet.rotation[3];
+		for (size_t iteration = 0; iteration < m_maxRotationIterations; ++iteration)
+		{
+			computeRotationMatrices(packet.rotation, &R);
+
+			Packet omegaX = Packet::Zero();
+			Packet omegaY = Packet::Zero();
+			Packet omegaZ = Packet::Zero();
+			Packet dot = Packet::Zero();
+			for (size_t col = 0; col < 3; ++col)
+			{
+				const Packet& r0 = R[col];
+				const Packet& r1 = R[3 + col];
+				const Packet& r2 = R[6 + col];
+				const Packet& b0 = B[col];
+				const Packet& b1 = B[3 + col];
+				const Packet& b2 = B[6 + col];
+				omegaX += r1 * b2 - r2 * b1;
+				omegaY += r2 * b0 - r0 * b2;
+				omegaZ += r0 * b1 - r1 * b0;
+				dot += r0 * b0 + r1 * b1 + r2 * b2;
+			}
+			const Packet inverseDot = 1.0 / (dot.abs() + 1e-9);
+			omegaX *= inverseDot;
+			omegaY *= inverseDot;
+			omegaZ *= inverseDot;
+
+			const Packet angle = (omegaX * omegaX + omegaY * omegaY + omegaZ * omegaZ).sqrt();
+			if (angle.maxCoeff() < rotationEpsilon)
+			{
+				break;
+			}
+
+			// dq = (cos(angle/2), sin(angle/2).omega/angle), with sin(angle/2)/angle -> 1/2 for small angles
+			const Packet halfAngle = 0.5 * angle;
+			const Packet dw = halfAngle.cos();
+			const Packet s = (angle > 1e-12).select(halfAngle.sin() / angle, Packet::Constant(0.5));
+			const Packet dx = s * omegaX;
+			const Packet dy = s * omegaY;
+			const Packet dz = s * omegaZ;
+
+			const Packet w = dw * qw - dx * qx - dy * qy - dz * qz;
+			const Packet nx = dw * qx + dx * qw + dy * qz - dz * qy;
+			const Packet ny = dw * qy - dx * qz + dy * qw + dz * qx;
+			const Packet nz = dw * qz + dx * qy - dy * qx + dz * qw;
+			const Packet inverseNorm = (w * w + nx * nx + ny * ny + nz * nz).rsqrt();
+			qw = w * inverseNorm;
+			qx = nx * inverseNorm;
+			qy = ny * inverseNorm;
+			qz = nz * inverseNorm;
+		}
+	}
+}
+
+SurgSim::Math::Matrix33d Fem3DCorotationalTetrahedronBatch::getRotation(size_t elementId) const
+{
+	SURGSIM_ASSERT(elementId < m_numElements) <<
+		"Invalid element id " << elementId << ", the batch has " << m_numElements << " elements";
+
+	const ElementPacket& packet = m_packets[elementId / PacketSize];
+	const size_t lane = elementId % PacketSize;
+	SurgSim::Math::Quaterniond q(packet.rotation[0][lane], packet.rotation[1][lane],
+								 packet.rotation[2][lane], packet.rotation[3][lane]);
+	return q.toRotationMatrix();
+}
+
+void Fem3DCorotationalTetrahedronBatch::addForce(const SurgSim::Math::OdeState& state, SurgSim::Math::Vector* F,
+		double scale) const
+{
+	std::array<Packet, 12> x;
+	std::array<Packet, 12> result;
+	for (const auto& packet : m_packets)
+	{
+		gather(packet, state.getPositions(), &x);
+		applyRotatedStiffness(packet, x, true, &result);
+		scatter(packet, result, -scale, F);
+	}
+}
+
+void Fem3DCorotationalTetrahedronBatch::addMatVec(double scale, const SurgSim::Math::Vector& x,
+		SurgSim::Math::Vector* F) const
+{
+	std::array<Packet, 12> xElement;
+	std::array<Packet, 12> result;
+	for (const auto& packet : m_packets)
+	{
+		gather(packet, x, &xElement);
+		applyRotatedStiffness(packet, xElement, false, &result);
+		scatter(packet, result, scale, F);
+	}
+}
+
+void Fem3DCorotationalTetrahedronBatch::gather(const ElementPacket& packet, const SurgSim::Math::Vector& x,
+		std::array<Packet, 12>* result) const
+{
+	for (size_t lane = 0; lane < PacketSize; ++lane)
+	{
+		for (size_t node = 0; node < 4; ++node)
+		{
+			const size_t index = 3 * packet.nodeIds[lane][node];
+			(*result)[3 * node][lane] = x[index];
+			(*result)[3 * node + 1][lane] = x[index + 1];
+			(*result)[3 * node + 2][lane] = x[index + 2];
+		}
+	}
+}
+
+void Fem3DCorotationalTetrahedronBatch::scatter(const ElementPacket& packet, const std::array<Packet, 12>& values,
+		double scale, SurgSim::Math::Vector* F) const
+{
+	for (size_t lane = 0; lane < packet.numElements; ++lane)
+	{
+		for (size_t node = 0; node < 4; ++node)
+		{
+			const size_t index = 3 * packet.nodeIds[lane][node];
+			(*F)[index] += scale * values[3 * node][lane];
+			(*F)[index + 1] += scale * values[3 * node + 1][lane];
+			(*F)[index + 2] += scale * values[3 * node + 2][lane];
+		}
+	}
+}
+
+void Fem3DCorotationalTetrahedronBatch::applyRotatedStiffness(const ElementPacket& packet,
+		const std::array<Packet, 12>& x, bool subtractRestPositions, std::array<Packet, 12>* result) const
+{
+	std::array<Packet, 9> R;
+	computeRotationMatrices(packet.rotation, &R);
+
+	// u = R^t.x (- x0), in the rest frame of the elements
+	std::array<Packet, 12> u;
+	for (size_t node = 0; node < 4; ++node)
+	{
+		const Packet& x0 = x[3 * node];
+		const Packet& x1 = x[3 * node + 1];
+		const Packet& x2 = x[3 * node + 2];
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			u[3 * node + axis] = R[axis] * x0 + R[3 + axis] * x1 + R[6 + axis] * x2;
+			if (subtractRestPositions)
+			{
+				u[3 * node + axis] -= packet.x0[3 * node + axis];
+			}
+		}
+	}
+
+	// g = Ke.u
+	std::array<Packet, 12> g;
+	for (size_t row = 0; row < 12; ++row)
+	{
+		const Packet* stiffnessRow = &packet.stiffness[12 * row];
+		Packet sum = stiffnessRow[0] * u[0];
+		for (size_t col = 1; col < 12; ++col)
+		{
+			sum += stiffnessRow[col] * u[col];
+		}
+		g[row] = sum;
+	}
+
+	// result = R.g, back in the current frame
+	for (size_t node = 0; node < 4; ++node)
+	{
+		const Packet& g0 = g[3 * node];
+		const Packet& g1 = g[3 * node + 1];
+		const Packet& g2 = g[3 * node + 2];
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			(*result)[3 * node + axis] = R[3 * axis] * g0 + R[3 * axis + 1] * g1 + R[3 * axis + 2] * g2;
+		}
+	}
+}
+
+void Fem3DCorotationalTetrahedronBatch::computeRotationMatrices(const std::array<Packet, 4>& q,
+		std::array<Packet, 9>* R)
+{
+	const Packet& qw = q[0];
+	const Packet& qx = q[1];
+	const Packet& qy = q[2];
+	const Packet& qz = q[3];
+	(*R)[0] = 1.0 - 2.0 * (qy * qy + qz * qz);
+	(*R)[1] = 2.0 * (qx * qy - qw * qz);
+	(*R)[2] = 2.0 * (qx * qz + qw * qy);
+	(*R)[3] = 2.0 * (qx * qy + qw * qz);
+	(*R)[4] = 1.0 - 2.0 * (qx * qx + qz * qz);
+	(*R)[5] = 2.0 * (qy * qz - qw * qx);
+	(*R)[6] = 2.0 * (qx * qz - qw * qy);
+	(*R)[7] = 2.0 * (qy * qz + qw * qx);
+	(*R)[8] = 1.0 - 2.0 * (qx * qx + qy * qy);
+}
+
+} // namespace Physics
+
+} // namespace SurgSim
@@ -0,0 +1,174 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_PHYSICS_FEM3DCOROTATIONALTETRAHEDRONBATCH_H
+#define SURGSIM_PHYSICS_FEM3DCOROTATIONALTETRAHEDRONBATCH_H
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+
+#include "SurgSim/Math/Matrix.h"
+#include "SurgSim/Math/Vector.h"
+
+namespace SurgSim
+{
+
+namespace Math
+{
+class OdeState;
+}
+
+namespace Physics
+{
+
+class Fem3DElementCorotationalTetrahedron;
+
+/// Batched evaluation of co-rotational tetrahedra.
+/// The elements are grouped in packets of PacketSize elements stored in a structure of arrays layout, every value
+/// of a packet (a stiffness coefficient, a rest position coordinate...) holding one entry per element. All the
+/// computations are then written on whole packets of Eigen fixed-size arrays instead of going element by element
+/// through virtual calls. There is no explicit SIMD code, whether the packets are vectorized (one element per lane)
+/// is left to Eigen and the compiler.
+/// The batch is used by Fem3DCorotationalTetrahedronRepresentation when element batching is turned on.
+/// For each packet, the kernel:
+/// - extracts the element rotations from the deformation gradients with a polar decomposition, computed by the
+///   iterative quaternion method of "A Robust Method to Extract the Rotational Part of Deformations", Muller et al.
+///   MIG 2016, warm started with the rotations of the previous call;
+/// - computes the co-rotational forces f = -R.Ke.(R^t.x - x0);
+/// - computes matrix free products with the co-rotated stiffness R.Ke.R^t, without forming the 12x12 rotated
+///   element matrices.
+/// \note The stiffness used here is the co-rotated stiffness R.Ke.R^t, without the rotation derivative terms of the
+///       exact co-rotational stiffness computed by Fem3DElementCorotationalTetrahedron.
+/// \note The packets hold 4 doubles, which only fill a vector register on builds with SURGSIM_USE_AVX2.
+class Fem3DCorotationalTetrahedronBatch
+{
+public:
+	/// The number of elements processed together
+	static const size_t PacketSize = 4;
+
+	/// Constructor
+	Fem3DCorotationalTetrahedronBatch();
+
+	/// Build the packets from a set of elements
+	/// \param elements The co-rotational tetrahedra, initialized with restState
+	/// \param restState The rest state the elements have been initialized with
+	void initialize(const std::vector<std::shared_ptr<Fem3DElementCorotationalTetrahedron>>& elements,
+					const SurgSim::Math::OdeState& restState);
+
+	/// \return The number of elements in the batch
+	size_t getNumElements() const;
+
+	/// Set the maximum number of iterations of the polar decomposition
+	/// \param iterations The maximum number of iterations, a few are usually enough as they are warm started
+	void setMaxRotationIterations(size_t iterations);
+
+	/// \return The maximum number of iterations of the polar decomposition
+	size_t getMaxRotationIterations() const;
+
+	/// Extract the rotations of all the elements from the given state
+	/// \param state The state to compute the rotations for
+	void updateRotations(const SurgSim::Math::OdeState& state);
+
+	/// \param elementId The index of the element, in the order given to initialize
+	/// \return The rotation of the element, as computed by the last call to updateRotations
+	SurgSim::Math::Matrix33d getRotation(size_t elementId) const;
+
+	/// Add the co-rotational forces of all the elements, f = -R.Ke.(R^t.x - x0), into a complete system force vector
+	/// \param state The state to compute the forces for, updateRotations needs to be called with it first
+	/// \param[in,out] F The complete system force vector to add the forces into
+	/// \param scale The scaling factor to apply to the forces
+	void addForce(const SurgSim::Math::OdeState& state, SurgSim::Math::Vector* F, double scale = 1.0) const;
+
+	/// Add the product of the co-rotated stiffness matrices with a vector, F += scale.R.Ke.R^t.x, into a complete
+	/// system vector
+	/// \param scale The scaling factor to apply to the product
+	/// \param x The complete system vector to multiply
+	/// \param[in,out] F The complete system vector to add the product into
+	void addMatVec(double scale, const SurgSim::Math::Vector& x, SurgSim::Math::Vector* F) const;
+
+private:
+	/// One value per element of a packet
+	typedef Eigen::Array<double, PacketSize, 1> Packet;
+
+	/// The data of PacketSize elements, in structure of arrays layout
+	struct ElementPacket
+	{
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+		/// The number of actual elements, the remaining lanes replicate the last element and are never scattered
+		size_t numElements;
+
+		/// The node ids of each element
+		std::array<std::array<size_t, 4>, PacketSize> nodeIds;
+
+		/// The first 3 columns of V^-1, V being the rest positions in homogeneous coordinates (4 rows of 3)
+		std::array<Packet, 12> restShape;
+
+		/// The rest positions
+		std::array<Packet, 12> x0;
+
+		/// The linear stiffness matrices, row major
+		std::array<Packet, 144> stiffness;
+
+		/// The rotations, as quaternions (w, x, y, z)
+		std::array<Packet, 4> rotation;
+	};
+
+	/// Gather the dofs of the elements of a packet
+	/// \param packet The packet
+	/// \param x The complete system vector to gather from
+	/// \param[out] result The 12 dofs of the elements
+	void gather(const ElementPacket& packet, const SurgSim::Math::Vector& x, std::array<Packet, 12>* result) const;
+
+	/// Scatter the dofs of the elements of a packet
+	/// \param packet The packet
+	/// \param values The 12 dofs of the elements
+	/// \param scale The scaling factor to apply to the values
+	/// \param[in,out] F The complete system vector to add the values into
+	void scatter(const ElementPacket& packet, const std::array<Packet, 12>& values, double scale,
+				 SurgSim::Math::Vector* F) const;
+
+	/// Compute R.Ke.(R^t.x - x0) or R.Ke.R^t.x for the elements of a packet
+	/// \param packet The packet
+	/// \param x The 12 dofs of the elements
+	/// \param subtractRestPositions True to compute R.Ke.(R^t.x - x0), False to compute R.Ke.R^t.x
+	/// \param[out] result The 12 resulting values of the elements
+	void applyRotatedStiffness(const ElementPacket& packet, const std::array<Packet, 12>& x,
+							   bool subtractRestPositions, std::array<Packet, 12>* result) const;
+
+	/// Compute the rotation matrices of the elements of a packet from their quaternions
+	/// \param q The quaternions (w, x, y, z)
+	/// \param[out] R The rotation matrices, row major
+	static void computeRotationMatrices(const std::array<Packet, 4>& q, std::array<Packet, 9>* R);
+
+	/// The packets of elements
+	std::vector<ElementPacket, Eigen::aligned_allocator<ElementPacket>> m_packets;
+
+	/// The number of elements
+	size_t m_numElements;
+
+	/// The maximum number of iterations of the polar decomposition
+	size_t m_maxRotationIterations;
+};
+
+} // namespace Physics
+
+} // namespace SurgSim
+
+#endif // SURGSIM_PHYSICS_FEM3DCOROTATIONALTETRAHEDRONBATCH_H
@@ -19,6 +19,7 @@
 #include "SurgSim/Math/LinearSolveAndInverse.h"
 #include "SurgSim/Math/OdeState.h"
 #include "SurgSim/Physics/ConstraintImplementation.h"
+#include "SurgSim/Physics/Fem3DCorotationalTetrahedronBatch.h"
 #include "SurgSim/Physics/FemConstraintFixedPoint.h"
 #include "SurgSim/Physics/FemConstraintFixedRotationVector.h"
 #include "SurgSim/Physics/FemConstraintFrictionalSliding.h"
@@ -39,7 +40,9 @@ SURGSIM_REGISTER(SurgSim::Framework::Component,
 				 Fem3DCorotationalTetrahedronRepresentation);
 
 Fem3DCorotationalTetrahedronRepresentation::Fem3DCorotationalTetrahedronRepresentation(const std::string& name)
-		: Fem3DRepresentation(name)
+		: Fem3DRepresentation(name),
+		  m_useElementBatching(false),
+		  m_isBatchUpdated(false)
 {
 	using SurgSim::Physics::ConstraintImplementation;
 	using SurgSim::Physics::FemConstraintFixedPoint;
@@ -53,6 +56,9 @@ Fem3DCorotationalTetrahedronRepresentation::Fem3DCorotationalTetrahedronRepresen
 
 	setComplianceWarping(true);
 
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(Fem3DCorotationalTetrahedronRepresentation, bool, ElementBatching,
+									  getElementBatching, setElementBatching);
+
 	// Register all the constraint for this representation in the ConstraintImplementation factory
 	// Because Fem3DCorotationalTetrahedronRepresentation derives from Fem3DRepresentation, it can use the exact
 	// same constraint implementation. The constraint expression is exactly the same and the compliance
@@ -82,18 +88,104 @@ void Fem3DCorotationalTetrahedronRepresentation::setFemElementType(const std::st
 	Fem3DRepresentation::setFemElementType(type);
 }
 
+void Fem3DCorotationalTetrahedronRepresentation::setElementBatching(bool useElementBatching)
+{
+	SURGSIM_ASSERT(!isInitialized()) << "Element batching cannot be modified once the component is initialized";
+	m_useElementBatching = useElementBatching;
+}
+
+bool Fem3DCorotationalTetrahedronRepresentation::getElementBatching() const
+{
+	return m_useElementBatching;
+}
+
+bool Fem3DCorotationalTetrahedronRepresentation::doInitialize()
+{
+	if (!Fem3DRepresentation::doInitialize())
+	{
+		return false;
+	}
+
+	if (m_useElementBatching)
+	{
+		std::vector<std::shared_ptr<Fem3DElementCorotationalTetrahedron>> elements;
+		elements.reserve(m_femElements.size());
+		for (auto& element : m_femElements)
+		{
+			auto tetrahedron = std::dynamic_pointer_cast<Fem3DElementCorotationalTetrahedron>(element);
+			SURGSIM_ASSERT(tetrahedron != nullptr) << "Element batching requires co-rotational tetrahedra, " <<
+				getName() << " has other elements.";
+			elements.push_back(tetrahedron);
+		}
+		m_batch.reset(new Fem3DCorotationalTetrahedronBatch());
+		m_batch->initialize(elements, *m_initialState);
+	}
+
+	return true;
+}
+
+void Fem3DCorotationalTetrahedronRepresentation::updateFMDK(const Math::OdeState& state, int options)
+{
+	// The batch only computes the forces. The Rayleigh stiffness damping needs the element stiffnesses of this state
+	// unless it uses the global stiffness matrix.
+	const bool useBatch = (m_batch != nullptr) && (options & Math::ODEEQUATIONUPDATE_F) != 0 &&
+		(options & (Math::ODEEQUATIONUPDATE_D | Math::ODEEQUATIONUPDATE_K)) == 0 &&
+		(getRayleighDampingStiffness() == 0.0 || hasK());
+
+	if (!useBatch)
+	{
+		m_isBatchUpdated = false;
+		Fem3DRepresentation::updateFMDK(state, options);
+		return;
+	}
+
+	m_batch->updateRotations(state);
+	m_isBatchUpdated = true;
+	if (options & Math::ODEEQUATIONUPDATE_M)
+	{
+		for (auto& element : m_femElements)
+		{
+			element->updateFMDK(state, Math::ODEEQUATIONUPDATE_M);
+		}
+	}
+
+	Math::OdeEquation::updateFMDK(state, options);
+}
+
+void Fem3DCorotationalTetrahedronRepresentation::addFemElementsForce(Math::Vector* f, const Math::OdeState& state,
+		double scale)
+{
+	if (m_isBatchUpdated)
+	{
+		m_batch->addForce(state, f, scale);
+	}
+	else
+	{
+		Fem3DRepresentation::addFemElementsForce(f, state, scale);
+	}
+}
+
+Math::Matrix33d Fem3DCorotationalTetrahedronRepresentation::getElementRotation(size_t elementId) const
+{
+	if (m_isBatchUpdated)
+	{
+		return m_batch->getRotation(elementId);
+	}
+	return std::static_pointer_cast<Fem3DElementCorotationalTetrahedron>(m_femElements[elementId])->
+		getRotationMatrix();
+}
+
 Math::Matrix Fem3DCorotationalTetrahedronRepresentation::getNodeTransformation(
 		const Math::OdeState& state, size_t nodeId) const
 {
 	std::vector<Math::Matrix33d> elementRotations;
 
-	for (auto const& element : m_femElements)
+	for (size_t elementId = 0; elementId < m_femElements.size(); ++elementId)
 	{
-		auto node = std::find(element->getNodeIds().begin(), element->getNodeIds().end(), nodeId);
-		if (node != element->getNodeIds().end())
+		const auto& nodeIds = m_femElements[elementId]->getNodeIds();
+		if (std::find(nodeIds.begin(), nodeIds.end(), nodeId) != nodeIds.end())
 		{
-			elementRotations.push_back(std::static_pointer_cast<Fem3DElementCorotationalTetrahedron>(element)->
-					getRotationMatrix());
+			elementRotations.push_back(getElementRotation(elementId));
 		}
 	}
 
@@ -115,19 +207,26 @@ void Fem3DCorotationalTetrahedronRepresentation::calculateComplianceWarpingTrans
 	const Eigen::Index numNodes = static_cast<Eigen::Index>(state.getNumNodes());
 	Math::Matrix33d R3x3;
 
-	for (Eigen::Index nodeId = 0; nodeId < numNodes; ++nodeId)
+	if (m_elementsPerNode.size() != state.getNumNodes())
 	{
-		std::vector<Math::Matrix33d> elementRotations;
-
-		for (auto const& element : m_femElements)
+		m_elementsPerNode.assign(state.getNumNodes(), std::vector<size_t>());
+		for (size_t elementId = 0; elementId < m_femElements.size(); ++elementId)
 		{
-			auto node = std::find(element->getNodeIds().begin(), element->getNodeIds().end(), nodeId);
-			if (node != element->getNodeIds().end())
+			for (auto nodeId : m_femElements[elementId]->getNodeIds())
 			{
-				elementRotations.push_back(std::static_pointer_cast<Fem3DElementCorotationalTetrahedron>(element)->
-					getRotationMatrix());
+				m_elementsPerNode[nodeId].push_back(elementId);
 			}
 		}
+	}
+
+	std::vector<Math::Matrix33d> elementRotations;
+	for (Eigen::Index nodeId = 0; nodeId < numNodes; ++nodeId)
+	{
+		elementRotations.clear();
+		for (auto elementId : m_elementsPerNode[nodeId])
+		{
+			elementRotations.push_back(getElementRotation(elementId));
+		}
 
 		SURGSIM_ASSERT(elementRotations.size() > 0) << "Node " << nodeId << " happens to not belong to any FemElements";
 
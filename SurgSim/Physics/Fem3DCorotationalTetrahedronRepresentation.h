@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "SurgSim/Math/Matrix.h"
 #include "SurgSim/Math/Quaternion.h"
@@ -29,12 +30,17 @@ namespace SurgSim
 
 namespace Physics
 {
+class Fem3DCorotationalTetrahedronBatch;
+
 SURGSIM_STATIC_REGISTRATION(Fem3DCorotationalTetrahedronRepresentation);
 
 /// Co-rotational Tetrahedron Finite Element Model 3D is a fem built with co-rotational tetrahedron 3D FemElement
 /// It derives from Fem3DRepresentation from which it uses most functionalities.
 /// The only difference comes in the initialization and update to take a special care of
 /// the FemElement's rotation.
+/// With element batching turned on, the updates that only need the forces (explicit and Runge-Kutta solvers, the
+/// linearized solvers in between stiffness updates...) go through a Fem3DCorotationalTetrahedronBatch instead of
+/// updating the elements one by one. The updates needing the stiffness or the damping matrix still use the elements.
 class Fem3DCorotationalTetrahedronRepresentation : public SurgSim::Physics::Fem3DRepresentation
 {
 public:
@@ -49,10 +55,43 @@ class Fem3DCorotationalTetrahedronRepresentation : public SurgSim::Physics::Fem3
 
 	void setFemElementType(const std::string& type) override;
 
+	/// Turn the batched evaluation of the element forces on or off, off by default
+	/// \param useElementBatching True to compute the forces with a Fem3DCorotationalTetrahedronBatch
+	/// \exception SurgSim::Framework::AssertionFailure if called after initialization
+	void setElementBatching(bool useElementBatching);
+
+	/// \return True if the forces are computed with a Fem3DCorotationalTetrahedronBatch
+	bool getElementBatching() const;
+
+	void updateFMDK(const SurgSim::Math::OdeState& state, int options) override;
+
 protected:
+	bool doInitialize() override;
+
+	void addFemElementsForce(SurgSim::Math::Vector* f, const SurgSim::Math::OdeState& state,
+							 double scale = 1.0) override;
+
 	SurgSim::Math::Matrix getNodeTransformation(const SurgSim::Math::OdeState& state, size_t nodeId) const override;
 
 	void calculateComplianceWarpingTransformation(const SurgSim::Math::OdeState& state) override;
+
+private:
+	/// \param elementId The id of the element
+	/// \return The rotation of the element from the last update, computed by the batch or by the element
+	SurgSim::Math::Matrix33d getElementRotation(size_t elementId) const;
+
+	/// Are the forces computed with the batch
+	bool m_useElementBatching;
+
+	/// The batched elements, only created when element batching is on
+	std::unique_ptr<Fem3DCorotationalTetrahedronBatch> m_batch;
+
+	/// Did the last update go through the batch, in which case the elements have not been updated
+	bool m_isBatchUpdated;
+
+	/// The ids of the elements connected to each node, built on the first compliance warping update so that
+	/// gathering the rotations of a node does not go through all the elements
+	std::vector<std::vector<size_t>> m_elementsPerNode;
 };
 
 } // namespace Physics
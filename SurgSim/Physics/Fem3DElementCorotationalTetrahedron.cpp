@@ -292,6 +292,11 @@ void Fem3DElementCorotationalTetrahedron::computeRotationMassAndStiffness(const
 		return m_R;
 	}
 
+const Eigen::Matrix<double, 12, 12>& Fem3DElementCorotationalTetrahedron::getLinearStiffnessMatrix() const
+{
+	return m_KLinear;
+}
+
 }; // namespace Physics
 
 }; // namespace SurgSim
@@ -67,6 +67,9 @@ class Fem3DElementCorotationalTetrahedron : public Fem3DElementTetrahedron
 	/// Gets the current rotation of the element
 	const SurgSim::Math::Matrix33d& getRotationMatrix() const;
 
+	/// Gets the stiffness matrix of the linear tetrahedron, i.e. the stiffness of the element in its rest frame
+	const Eigen::Matrix<double, 12, 12>& getLinearStiffnessMatrix() const;
+
 protected:
 	/// Compute the rotation, mass and stiffness matrices of the element from the given state
 	/// \param state The state to compute the rotation and jacobians from
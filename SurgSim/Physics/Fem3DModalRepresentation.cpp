@@ -0,0 +1,442 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SurgSim/Physics/Fem3DModalRepresentation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/SparseCholesky>
+
+#include "SurgSim/DataStructures/BinaryCache.h"
+#include "SurgSim/Framework/ApplicationData.h"
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Framework/Log.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Math/OdeEquation.h"
+#include "SurgSim/Math/OdeState.h"
+#include "SurgSim/Math/SparseMatrix.h"
+#include "SurgSim/Physics/Fem3D.h"
+
+namespace
+{
+
+/// Maximum number of subspace iterations when computing the modes
+const size_t MAX_SUBSPACE_ITERATIONS = 500;
+
+/// Relative convergence tolerance on the eigenvalues of the modes
+const double EIGENVALUE_TOLERANCE = 1e-8;
+
+}
+
+namespace SurgSim
+{
+
+namespace Physics
+{
+
+SURGSIM_REGISTER(SurgSim::Framework::Component, SurgSim::Physics::Fem3DModalRepresentation,
+				 Fem3DModalRepresentation);
+
+Fem3DModalRepresentation::Fem3DModalRepresentation(const std::string& name) :
+	Fem3DRepresentation(name),
+	m_numModes(30),
+	m_modalComplianceDt(0.0),
+	m_hasModalComplianceExternalTerms(false),
+	m_isFullComplianceValid(false)
+{
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(Fem3DModalRepresentation, size_t, NumModes, getNumModes, setNumModes);
+}
+
+Fem3DModalRepresentation::~Fem3DModalRepresentation()
+{
+}
+
+void Fem3DModalRepresentation::setNumModes(size_t numModes)
+{
+	SURGSIM_ASSERT(!isInitialized()) << "The number of modes cannot be changed after initialization";
+	SURGSIM_ASSERT(numModes > 0) << "The number of modes cannot be 0";
+	m_numModes = numModes;
+}
+
+size_t Fem3DModalRepresentation::getNumModes() const
+{
+	return m_numModes;
+}
+
+const SurgSim::Math::Matrix& Fem3DModalRepresentation::getModalBasis() const
+{
+	return m_modes;
+}
+
+const SurgSim::Math::Vector& Fem3DModalRepresentation::getModalEigenvalues() const
+{
+	return m_eigenvalues;
+}
+
+const SurgSim::Math::Vector& Fem3DModalRepresentation::getModalCoordinates() const
+{
+	return m_q;
+}
+
+const SurgSim::Math::Vector& Fem3DModalRepresentation::getModalVelocities() const
+{
+	return m_v;
+}
+
+bool Fem3DModalRepresentation::doInitialize()
+{
+	SURGSIM_ASSERT(!getComplianceWarping()) << getClassName() << " does not support compliance warping";
+
+	// The modes are cached in the local frame of the fem, the initial pose is embedded in the state by the
+	// initialization
+	const Math::Matrix33d rotation = getPose().linear();
+
+	if (!Fem3DRepresentation::doInitialize())
+	{
+		return false;
+	}
+
+	std::string path;
+	if (!getFem()->getFileName().empty())
+	{
+		path = Framework::Runtime::getApplicationData()->findFile(getFem()->getFileName());
+	}
+
+	bool result;
+	if (path.empty())
+	{
+		result = computeModes();
+	}
+	else
+	{
+		result = DataStructures::loadWithBinaryCache(path, getClassName(),
+			[this, &rotation](DataStructures::BinaryCacheReader* reader)
+			{
+				if (!readModes(reader))
+				{
+					return false;
+				}
+				rotateModes(rotation);
+				return true;
+			},
+			std::bind(&Fem3DModalRepresentation::computeModes, this),
+			[this, &rotation](DataStructures::BinaryCacheWriter* writer)
+			{
+				rotateModes(rotation.transpose());
+				writeModes(writer);
+				rotateModes(rotation);
+			});
+	}
+
+	if (!result)
+	{
+		return false;
+	}
+
+	// The corrections are projected on the modes with the mass matrix, which is not assembled when the modes come
+	// from the cache
+	updateFMDK(*m_initialState, Math::ODEEQUATIONUPDATE_M);
+
+	Math::Vector gravity = Math::Vector::Zero(getNumDof());
+	addGravityForce(&gravity, *m_initialState);
+	m_modalGravityForce = m_modes.transpose() * gravity;
+
+	m_q.setZero(m_modes.cols());
+	m_v.setZero(m_modes.cols());
+	m_modalComplianceDt = 0.0;
+	m_isFullComplianceValid = false;
+
+	return true;
+}
+
+bool Fem3DModalRepresentation::computeModes()
+{
+	using Eigen::Index;
+	using Math::Matrix;
+	using Math::SparseMatrix;
+	using Math::Vector;
+
+	const Index numDof = static_cast<Index>(getNumDof());
+	std::vector<bool> isFixed(getNumDof(), false);
+	for (auto dof : m_initialState->getBoundaryConditions())
+	{
+		isFixed[dof] = true;
+	}
+	const Index numFreeDof = static_cast<Index>(std::count(isFixed.begin(), isFixed.end(), false));
+	const Index numModes = static_cast<Index>(m_numModes);
+	SURGSIM_ASSERT(numModes <= numFreeDof) << getName() << " cannot have " << numModes << " modes, it only has " <<
+		numFreeDof << " free degrees of freedom";
+
+	// The fixed dofs are removed from the eigen problem K.u = lambda.M.u by clearing their rows and columns,
+	// K gets a unit diagonal so that it stays invertible and the modes remain zero on these dofs.
+	updateFMDK(*m_initialState, Math::ODEEQUATIONUPDATE_M | Math::ODEEQUATIONUPDATE_K);
+	SparseMatrix M = getM();
+	SparseMatrix K = getK();
+	auto isFree = [&isFixed](const Index& row, const Index& col, const double&)
+	{
+		return !isFixed[row] && !isFixed[col];
+	};
+	M.prune(isFree);
+	K.prune(isFree);
+	SparseMatrix fixedDiagonal(numDof, numDof);
+	for (auto dof : m_initialState->getBoundaryConditions())
+	{
+		fixedDiagonal.insert(dof, dof) = 1.0;
+	}
+
+	// Shifting by a small multiple of M keeps the factorization valid for unconstrained meshes (rigid modes)
+	const double massTrace = M.diagonal().sum();
+	SURGSIM_ASSERT(massTrace > 0.0) << getName() << " has no mass, its modes cannot be computed";
+	const double shift = 1e-6 * K.diagonal().sum() / massTrace;
+	SparseMatrix shifted = K + fixedDiagonal + shift * M;
+	Eigen::SimplicialLDLT<SparseMatrix> solver(shifted);
+	SURGSIM_ASSERT(solver.info() == Eigen::Success) << getName() << " failed to factorize its stiffness matrix";
+
+	// Subspace iteration with a Rayleigh-Ritz projection at each step, on a subspace larger than the number of modes
+	// for faster convergence
+	const Index subspaceSize = std::min(numFreeDof, std::max(2 * numModes, numModes + 8));
+	Matrix subspace(numDof, subspaceSize);
+	for (Index row = 0; row < numDof; ++row)
+	{
+		for (Index col = 0; col < subspaceSize; ++col)
+		{
+			subspace(row, col) = isFixed[row] ? 0.0 : std::cos(static_cast<double>((row + 1) * (col + 1)));
+		}
+	}
+
+	Vector eigenvalues = Vector::Constant(subspaceSize, std::numeric_limits<double>::max());
+	bool isConverged = false;
+	Matrix reducedK, reducedM;
+	for (size_t iteration = 0; iteration < MAX_SUBSPACE_ITERATIONS && !isConverged; ++iteration)
+	{
+		Matrix y = solver.solve(M * subspace);
+
+		// The columns converge at very different rates, normalizing them keeps the reduced mass well conditioned
+		for (Index col = 0; col < subspaceSize; ++col)
+		{
+			y.col(col) /= std::sqrt(y.col(col).dot(M * y.col(col)));
+		}
+		reducedK = y.transpose() * (K * y);
+		reducedM = y.transpose() * (M * y);
+
+		Eigen::GeneralizedSelfAdjointEigenSolver<Matrix> eigenSolver(reducedK, reducedM);
+		SURGSIM_ASSERT(eigenSolver.info() == Eigen::Success) << getName() << " failed to compute its modes";
+		subspace = y * eigenSolver.eigenvectors();
+
+		const Vector& newEigenvalues = eigenSolver.eigenvalues();
+		isConverged = true;
+		for (Index mode = 0; mode < numModes; ++mode)
+		{
+			const double scale = std::max(std::abs(newEigenvalues[mode]), shift);
+			if (std::abs(newEigenvalues[mode] - eigenvalues[mode]) > EIGENVALUE_TOLERANCE * scale)
+			{
+				isConverged = false;
+				break;
+			}
+		}
+		eigenvalues = newEigenvalues;
+	}
+
+	SURGSIM_LOG_IF(!isConverged, SurgSim::Framework::Logger::getDefaultLogger(), WARNING) << getName() <<
+		" modes did not converge in " << MAX_SUBSPACE_ITERATIONS << " iterations";
+
+	m_modes = subspace.leftCols(numModes);
+	m_eigenvalues = eigenvalues.head(numModes).cwiseMax(0.0);
+
+	return true;
+}
+
+bool Fem3DModalRepresentation::readModes(SurgSim::DataStructures::BinaryCacheReader* reader)
+{
+	uint64_t numModes, numDof;
+	uint32_t massLumping;
+	std::vector<size_t> boundaryConditions;
+	std::vector<double> eigenvalues, modes;
+	if (!reader->read(&numModes) || !reader->read(&numDof) || !reader->read(&massLumping) ||
+		!reader->read(&boundaryConditions) || !reader->read(&eigenvalues) || !reader->read(&modes))
+	{
+		return false;
+	}
+
+	if (numModes != m_numModes || numDof != getNumDof() || (massLumping != 0) != getMassLumping() ||
+		boundaryConditions != m_initialState->getBoundaryConditions() || eigenvalues.size() != numModes ||
+		modes.size() != numModes * numDof)
+	{
+		return false;
+	}
+
+	m_eigenvalues = Eigen::Map<const Math::Vector>(eigenvalues.data(), eigenvalues.size());
+	m_modes = Eigen::Map<const Math::Matrix>(modes.data(), numDof, numModes);
+	return true;
+}
+
+void Fem3DModalRepresentation::writeModes(SurgSim::DataStructures::BinaryCacheWriter* writer) const
+{
+	writer->write(static_cast<uint64_t>(m_modes.cols()));
+	writer->write(static_cast<uint64_t>(m_modes.rows()));
+	writer->write(static_cast<uint32_t>(getMassLumping() ? 1 : 0));
+	writer->write(m_initialState->getBoundaryConditions());
+	writer->write(std::vector<double>(m_eigenvalues.data(), m_eigenvalues.data() + m_eigenvalues.size()));
+	writer->write(std::vector<double>(m_modes.data(), m_modes.data() + m_modes.size()));
+}
+
+void Fem3DModalRepresentation::rotateModes(const SurgSim::Math::Matrix33d& rotation)
+{
+	if (rotation.isIdentity())
+	{
+		return;
+	}
+
+	for (Eigen::Index row = 0; row < m_modes.rows(); row += 3)
+	{
+		m_modes.middleRows(row, 3) = rotation * m_modes.middleRows(row, 3);
+	}
+}
+
+void Fem3DModalRepresentation::updateModalCompliance(double dt)
+{
+	// With mass orthonormal modes, the reduced mass is the identity and the reduced stiffness is diagonal
+	const Math::Vector diagonal = Math::Vector::Constant(m_eigenvalues.size(), 1.0 / dt + getRayleighDampingMass()) +
+		(getRayleighDampingStiffness() + dt) * m_eigenvalues;
+	if (m_hasExternalGeneralizedForce)
+	{
+		Math::Matrix system = m_modes.transpose() *
+			((m_externalGeneralizedDamping + dt * m_externalGeneralizedStiffness) * m_modes);
+		system.diagonal() += diagonal;
+		m_modalCompliance = system.ldlt().solve(Math::Matrix::Identity(system.rows(), system.cols()));
+	}
+	else
+	{
+		m_modalCompliance = diagonal.cwiseInverse().asDiagonal();
+	}
+
+	m_modalComplianceDt = dt;
+	m_hasModalComplianceExternalTerms = m_hasExternalGeneralizedForce;
+	m_isFullComplianceValid = false;
+}
+
+void Fem3DModalRepresentation::expandState(SurgSim::Math::OdeState* state) const
+{
+	state->getPositions() = m_initialState->getPositions() + m_modes * m_q;
+	state->getVelocities() = m_modes * m_v;
+}
+
+void Fem3DModalRepresentation::resetState()
+{
+	Fem3DRepresentation::resetState();
+	m_q.setZero(m_modes.cols());
+	m_v.setZero(m_modes.cols());
+}
+
+void Fem3DModalRepresentation::update(double dt)
+{
+	if (!isActive())
+	{
+		return;
+	}
+
+	SURGSIM_ASSERT(m_modes.cols() > 0) << "The modes of " << getName() << " have not been computed, " <<
+		"was the representation initialized ?";
+
+	if (dt != m_modalComplianceDt || m_hasExternalGeneralizedForce || m_hasModalComplianceExternalTerms)
+	{
+		updateModalCompliance(dt);
+	}
+
+	// Linear implicit Euler in the modal space: (I/dt + D_r + dt.K_r).deltaV = F - dt.K_r.v
+	Math::Vector force = m_modalGravityForce - m_eigenvalues.cwiseProduct(m_q + dt * m_v) -
+		(getRayleighDampingMass() * m_v + getRayleighDampingStiffness() * m_eigenvalues.cwiseProduct(m_v));
+	if (m_hasExternalGeneralizedForce)
+	{
+		force += m_modes.transpose() *
+			(m_externalGeneralizedForce - dt * (m_externalGeneralizedStiffness * (m_modes * m_v)));
+	}
+	m_v += m_modalCompliance * force;
+	m_q += dt * m_v;
+
+	expandState(m_newState.get());
+
+	// Back up the current state into the previous state (by swapping)
+	m_currentState.swap(m_previousState);
+	// Make the new state, the current state (by swapping)
+	m_currentState.swap(m_newState);
+
+	if (!m_currentState->isValid())
+	{
+		SURGSIM_LOG(SurgSim::Framework::Logger::getDefaultLogger(), DEBUG)
+				<< getName() << " deactivated :" << std::endl
+				<< "modal coordinates=(" << m_q.transpose() << ")" << std::endl
+				<< "modal velocities=(" << m_v.transpose() << ")" << std::endl;
+
+		setLocalActive(false);
+	}
+}
+
+void Fem3DModalRepresentation::applyCorrection(double dt,
+		const Eigen::VectorBlock<SurgSim::Math::Vector>& deltaVelocity)
+{
+	if (!isActive())
+	{
+		return;
+	}
+
+	// The correction comes from the compliance U.C.U^t, it lies in the span of the modes, so that projecting it with
+	// the mass orthonormal basis is exact
+	const Math::Vector modalDeltaVelocity = m_modes.transpose() * (getM() * deltaVelocity);
+	m_v += modalDeltaVelocity;
+	m_q += dt * modalDeltaVelocity;
+
+	expandState(m_currentState.get());
+
+	if (!m_currentState->isValid())
+	{
+		SURGSIM_LOG(SurgSim::Framework::Logger::getDefaultLogger(), DEBUG)
+				<< getName() << " deactivated :" << std::endl
+				<< "modal coordinates=(" << m_q.transpose() << ")" << std::endl
+				<< "modal velocities=(" << m_v.transpose() << ")" << std::endl;
+
+		setLocalActive(false);
+	}
+}
+
+Math::Matrix Fem3DModalRepresentation::applyCompliance(const Math::OdeState& state, const Math::Matrix& b)
+{
+	SURGSIM_ASSERT(m_modalComplianceDt > 0.0) << "The compliance of " << getName() <<
+		" is only available after its first update";
+
+	// The modes are zero on the boundary conditions, so is the result
+	return m_modes * (m_modalCompliance * (m_modes.transpose() * b));
+}
+
+const SurgSim::Math::Matrix& Fem3DModalRepresentation::getComplianceMatrix() const
+{
+	SURGSIM_ASSERT(m_modalComplianceDt > 0.0) << "The compliance of " << getName() <<
+		" is only available after its first update";
+
+	if (!m_isFullComplianceValid)
+	{
+		m_fullCompliance = m_modes * m_modalCompliance * m_modes.transpose();
+		m_isFullComplianceValid = true;
+	}
+	return m_fullCompliance;
+}
+
+} // namespace Physics
+
+} // namespace SurgSim
@@ -0,0 +1,160 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SURGSIM_PHYSICS_FEM3DMODALREPRESENTATION_H
+#define SURGSIM_PHYSICS_FEM3DMODALREPRESENTATION_H
+
+#include <memory>
+#include <string>
+
+#include "SurgSim/Math/Matrix.h"
+#include "SurgSim/Math/Vector.h"
+#include "SurgSim/Physics/Fem3DRepresentation.h"
+
+namespace SurgSim
+{
+
+namespace DataStructures
+{
+class BinaryCacheReader;
+class BinaryCacheWriter;
+}
+
+namespace Physics
+{
+SURGSIM_STATIC_REGISTRATION(Fem3DModalRepresentation);
+
+/// Reduced order (modal) Finite Element Model 3D.
+/// The displacement of the mesh is restricted to the span of its lowest vibration modes, u = U.q, with U the
+/// numDof x r matrix of the mass orthonormal modes of the linear fem around its initial state. The simulation is
+/// carried out on the r modal coordinates q with a linear implicit Euler scheme, at a cost independent of the mesh
+/// size, and the displacements are expanded back to the full mesh after each update and correction, for collision,
+/// graphics and constraints.
+/// The modes are computed on initialization by subspace iteration (honoring the boundary conditions of the initial
+/// state) and cached next to the fem file, so that they are only computed once per mesh.
+/// \note This model is linear, it suits mostly linear organs undergoing small rotations. Compliance warping is not
+///       supported.
+/// \note The constraint implementations use the full compliance matrix U.C.U^t, which is built lazily, in
+///       O(numDof^2.r), the first time it is requested after a change.
+class Fem3DModalRepresentation : public Fem3DRepresentation
+{
+public:
+	/// Constructor
+	/// \param name The name of the Fem3DModalRepresentation
+	explicit Fem3DModalRepresentation(const std::string& name);
+
+	/// Destructor
+	virtual ~Fem3DModalRepresentation();
+
+	SURGSIM_CLASSNAME(SurgSim::Physics::Fem3DModalRepresentation);
+
+	/// Set the number of modes to simulate, needs to be called before initialization
+	/// \param numModes The number of modes r, typically 30 to 100
+	void setNumModes(size_t numModes);
+
+	/// \return The number of modes to simulate
+	size_t getNumModes() const;
+
+	/// \return The modal basis U, one mass orthonormal mode per column (numDof x r)
+	const SurgSim::Math::Matrix& getModalBasis() const;
+
+	/// \return The eigenvalues of the modes (squared angular frequencies), in increasing order
+	const SurgSim::Math::Vector& getModalEigenvalues() const;
+
+	/// \return The current modal coordinates q
+	const SurgSim::Math::Vector& getModalCoordinates() const;
+
+	/// \return The current modal velocities
+	const SurgSim::Math::Vector& getModalVelocities() const;
+
+	void resetState() override;
+
+	void update(double dt) override;
+
+	void applyCorrection(double dt, const Eigen::VectorBlock<SurgSim::Math::Vector>& deltaVelocity) override;
+
+	Math::Matrix applyCompliance(const Math::OdeState& state, const Math::Matrix& b) override;
+
+	const SurgSim::Math::Matrix& getComplianceMatrix() const override;
+
+protected:
+	bool doInitialize() override;
+
+private:
+	/// Compute the modal basis and eigenvalues of the linear fem around the initial state
+	/// \return true if the modes have been computed
+	bool computeModes();
+
+	/// Restore the modal basis and eigenvalues from a binary cache
+	/// \param reader The cache reader
+	/// \return true if the cache matches the current fem, numbers of modes and boundary conditions
+	bool readModes(SurgSim::DataStructures::BinaryCacheReader* reader);
+
+	/// Write the modal basis and eigenvalues to a binary cache
+	/// \param writer The cache writer
+	void writeModes(SurgSim::DataStructures::BinaryCacheWriter* writer) const;
+
+	/// Rotate the 3 dof blocks of the modal basis
+	/// \param rotation The rotation to apply to each node
+	void rotateModes(const SurgSim::Math::Matrix33d& rotation);
+
+	/// Update the modal compliance matrix (I/dt + D_r + dt.K_r)^-1 for the given time step and external
+	/// stiffness and damping
+	/// \param dt The time step
+	void updateModalCompliance(double dt);
+
+	/// Expand the modal coordinates and velocities into a full state
+	/// \param [out] state The state to fill, its positions are the initial positions displaced by U.q
+	void expandState(SurgSim::Math::OdeState* state) const;
+
+	/// Number of modes to simulate
+	size_t m_numModes;
+
+	/// The mass orthonormal modal basis (numDof x r)
+	SurgSim::Math::Matrix m_modes;
+
+	/// The eigenvalues of the modes, i.e. the diagonal of the reduced stiffness matrix
+	SurgSim::Math::Vector m_eigenvalues;
+
+	/// The gravity force projected on the modes
+	SurgSim::Math::Vector m_modalGravityForce;
+
+	///@{
+	/// The modal coordinates and velocities
+	SurgSim::Math::Vector m_q;
+	SurgSim::Math::Vector m_v;
+	///@}
+
+	/// The modal compliance matrix (r x r)
+	SurgSim::Math::Matrix m_modalCompliance;
+
+	/// The time step the modal compliance matrix was computed with, 0 if it needs to be recomputed
+	double m_modalComplianceDt;
+
+	/// Whether the modal compliance matrix includes external stiffness and damping
+	bool m_hasModalComplianceExternalTerms;
+
+	///@{
+	/// The full compliance matrix U.C.U^t, built on request
+	mutable SurgSim::Math::Matrix m_fullCompliance;
+	mutable bool m_isFullComplianceValid;
+	///@}
+};
+
+} // namespace Physics
+
+} // namespace SurgSim
+
+#endif // SURGSIM_PHYSICS_FEM3DMODALREPRESENTATION_H
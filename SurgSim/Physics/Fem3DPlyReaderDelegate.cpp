@@ -64,6 +64,23 @@ void Fem3DPlyReaderDelegate::endParseFile()
 	m_mesh->update();
 }
 
+void Fem3DPlyReaderDelegate::beginVertices(const std::string& elementName, size_t vertexCount)
+{
+	FemPlyReaderDelegate::beginVertices(elementName, vertexCount);
+	m_mesh->getVertices().reserve(m_mesh->getNumVertices() + vertexCount);
+}
+
+void Fem3DPlyReaderDelegate::processVertices(const std::string& elementName, size_t first, size_t count,
+		const void* records)
+{
+	const Vertex6DData* vertexData = static_cast<const Vertex6DData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		Fem3D::VertexType vertex(SurgSim::Math::Vector3d(vertexData[i].x, vertexData[i].y, vertexData[i].z));
+		m_mesh->addVertex(vertex);
+	}
+}
+
 void Fem3DPlyReaderDelegate::processVertex(const std::string& elementName)
 {
 	Fem3D::VertexType vertex(SurgSim::Math::Vector3d(m_vertexData.x, m_vertexData.y, m_vertexData.z));
@@ -71,25 +88,61 @@ void Fem3DPlyReaderDelegate::processVertex(const std::string& elementName)
 	m_mesh->addVertex(vertex);
 }
 
+void Fem3DPlyReaderDelegate::beginFemElements(const std::string& elementName, size_t elementCount)
+{
+	FemPlyReaderDelegate::beginFemElements(elementName, elementCount);
+	m_mesh->getElements().reserve(m_mesh->getNumElements() + elementCount);
+}
+
+void Fem3DPlyReaderDelegate::processFemElements(const std::string& elementName, size_t first, size_t count,
+		const void* records)
+{
+	const ElementData* elementData = static_cast<const ElementData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		addFemElement(elementData[i]);
+	}
+}
+
 void Fem3DPlyReaderDelegate::processFemElement(const std::string& elementName)
 {
-	SURGSIM_ASSERT(m_elementData.vertexCount == 4 || m_elementData.vertexCount == 8) <<
-			"Cannot process 3D Element with " << m_elementData.vertexCount << " vertices.";
+	addFemElement(m_elementData);
+}
+
+void Fem3DPlyReaderDelegate::addFemElement(const ElementData& data)
+{
+	SURGSIM_ASSERT(data.vertexCount == 4 || data.vertexCount == 8) <<
+			"Cannot process 3D Element with " << data.vertexCount << " vertices.";
 
 	auto femElement = std::make_shared<FemElementStructs::FemElement3DParameter>();
-	femElement->nodeIds.resize(m_elementData.vertexCount);
-	std::copy(m_elementData.indices, m_elementData.indices + m_elementData.vertexCount, femElement->nodeIds.data());
+	femElement->nodeIds.resize(data.vertexCount);
+	std::copy(data.indices, data.indices + data.vertexCount, femElement->nodeIds.data());
 
 	if (m_hasPerElementMaterial)
 	{
-		femElement->massDensity = m_elementData.massDensity;
-		femElement->poissonRatio = m_elementData.poissonRatio;
-		femElement->youngModulus = m_elementData.youngModulus;
+		femElement->massDensity = data.massDensity;
+		femElement->poissonRatio = data.poissonRatio;
+		femElement->youngModulus = data.youngModulus;
 	}
 
 	m_mesh->addElement(femElement);
 }
 
+void Fem3DPlyReaderDelegate::beginBoundaryConditions(const std::string& elementName, size_t boundaryConditionCount)
+{
+	m_mesh->getBoundaryConditions().reserve(m_mesh->getBoundaryConditions().size() + boundaryConditionCount);
+}
+
+void Fem3DPlyReaderDelegate::processBoundaryConditions(const std::string& elementName, size_t first, size_t count,
+		const void* records)
+{
+	const unsigned int* boundaryConditions = static_cast<const unsigned int*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_mesh->addBoundaryCondition(static_cast<size_t>(boundaryConditions[i]));
+	}
+}
+
 void Fem3DPlyReaderDelegate::processBoundaryCondition(const std::string& elementName)
 {
 	m_mesh->addBoundaryCondition(static_cast<size_t>(m_boundaryConditionData));
@@ -46,16 +46,34 @@ class Fem3DPlyReaderDelegate : public FemPlyReaderDelegate
 
 	void endParseFile() override;
 
+	void beginVertices(const std::string& elementName, size_t vertexCount) override;
+
+	void processVertices(const std::string& elementName, size_t first, size_t count, const void* records) override;
+
 	void processVertex(const std::string& elementName) override;
 
+	void beginFemElements(const std::string& elementName, size_t elementCount) override;
+
+	void processFemElements(const std::string& elementName, size_t first, size_t count,
+							const void* records) override;
+
 	void processFemElement(const std::string& elementName) override;
 
+	void beginBoundaryConditions(const std::string& elementName, size_t boundaryConditionCount) override;
+
+	void processBoundaryConditions(const std::string& elementName, size_t first, size_t count,
+								   const void* records) override;
+
 	void processBoundaryCondition(const std::string& elementName) override;
 
 	/// End file callback
 	void endFile();
 
 private:
+	/// Add a 3D element to the mesh
+	/// \param data The data of the element, as read from the file
+	void addFemElement(const ElementData& data);
+
 	/// Fem3D mesh asset to contain the ply file information
 	std::shared_ptr<Fem3D> m_mesh;
 };
@@ -31,13 +31,15 @@ FemPlyReaderDelegate::FemPlyReaderDelegate()
 bool FemPlyReaderDelegate::registerDelegate(PlyReader* reader)
 {
 	// Element Processing
-	reader->requestElement(
+	reader->requestElementBlocks(
 		getElementName(),
+		sizeof(ElementData),
 		std::bind(&FemPlyReaderDelegate::beginFemElements,
 				  this,
 				  std::placeholders::_1,
 				  std::placeholders::_2),
-		std::bind(&FemPlyReaderDelegate::processFemElement, this, std::placeholders::_1),
+		std::bind(&FemPlyReaderDelegate::processFemElements, this, std::placeholders::_1, std::placeholders::_2,
+				  std::placeholders::_3, std::placeholders::_4),
 		std::bind(&FemPlyReaderDelegate::endFemElements, this, std::placeholders::_1));
 
 	reader->requestListProperty(getElementName(),
@@ -48,11 +50,12 @@ bool FemPlyReaderDelegate::registerDelegate(PlyReader* reader)
 								offsetof(ElementData, vertexCount));
 
 	// Vertex processing
-	reader->requestElement("vertex",
-						   std::bind(&FemPlyReaderDelegate::beginVertices, this,
-									 std::placeholders::_1, std::placeholders::_2),
-						   std::bind(&FemPlyReaderDelegate::processVertex, this, std::placeholders::_1),
-						   std::bind(&FemPlyReaderDelegate::endVertices, this, std::placeholders::_1));
+	reader->requestElementBlocks("vertex", sizeof(Vertex6DData),
+								 std::bind(&FemPlyReaderDelegate::beginVertices, this,
+										   std::placeholders::_1, std::placeholders::_2),
+								 std::bind(&FemPlyReaderDelegate::processVertices, this, std::placeholders::_1,
+										   std::placeholders::_2, std::placeholders::_3, std::placeholders::_4),
+								 std::bind(&FemPlyReaderDelegate::endVertices, this, std::placeholders::_1));
 
 	reader->requestScalarProperty("vertex", "x", PlyReader::TYPE_DOUBLE, offsetof(Vertex6DData, x));
 	reader->requestScalarProperty("vertex", "y", PlyReader::TYPE_DOUBLE, offsetof(Vertex6DData, y));
@@ -69,13 +72,15 @@ bool FemPlyReaderDelegate::registerDelegate(PlyReader* reader)
 	// Boundary Condition Processing
 	if (m_hasBoundaryConditions)
 	{
-		reader->requestElement(
+		reader->requestElementBlocks(
 			"boundary_condition",
+			sizeof(m_boundaryConditionData),
 			std::bind(&FemPlyReaderDelegate::beginBoundaryConditions,
 					  this,
 					  std::placeholders::_1,
 					  std::placeholders::_2),
-			std::bind(&FemPlyReaderDelegate::processBoundaryCondition, this, std::placeholders::_1),
+			std::bind(&FemPlyReaderDelegate::processBoundaryConditions, this, std::placeholders::_1,
+					  std::placeholders::_2, std::placeholders::_3, std::placeholders::_4),
 			nullptr);
 		reader->requestScalarProperty("boundary_condition", "vertex_index", PlyReader::TYPE_UNSIGNED_INT, 0);
 	}
@@ -144,10 +149,20 @@ bool FemPlyReaderDelegate::fileIsAcceptable(const PlyReader& reader)
 	return result;
 }
 
-void* FemPlyReaderDelegate::beginVertices(const std::string& elementName, size_t vertexCount)
+void FemPlyReaderDelegate::beginVertices(const std::string& elementName, size_t vertexCount)
 {
 	m_vertexData.overrun1 = 0l;
-	return &m_vertexData;
+}
+
+void FemPlyReaderDelegate::processVertices(const std::string& elementName, size_t first, size_t count,
+		const void* records)
+{
+	const Vertex6DData* vertexData = static_cast<const Vertex6DData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_vertexData = vertexData[i];
+		processVertex(elementName);
+	}
 }
 
 void FemPlyReaderDelegate::endVertices(const std::string& elementName)
@@ -157,11 +172,21 @@ void FemPlyReaderDelegate::endVertices(const std::string& elementName)
 			"has become corrupted.";
 }
 
-void* FemPlyReaderDelegate::beginFemElements(const std::string& elementName, size_t elementCount)
+void FemPlyReaderDelegate::beginFemElements(const std::string& elementName, size_t elementCount)
 {
 	m_elementData.overrun1 = 0l;
 	m_elementData.overrun2 = 0l;
-	return &m_elementData;
+}
+
+void FemPlyReaderDelegate::processFemElements(const std::string& elementName, size_t first, size_t count,
+		const void* records)
+{
+	const ElementData* elementData = static_cast<const ElementData*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_elementData = elementData[i];
+		processFemElement(elementName);
+	}
 }
 
 void FemPlyReaderDelegate::endFemElements(const std::string& elementName)
@@ -185,10 +210,20 @@ void FemPlyReaderDelegate::endMaterials(const std::string& elementName)
 			"has become corrupted.";
 }
 
-void* FemPlyReaderDelegate::beginBoundaryConditions(const std::string& elementName,
+void FemPlyReaderDelegate::beginBoundaryConditions(const std::string& elementName,
 		size_t boundaryConditionCount)
 {
-	return &m_boundaryConditionData;
+}
+
+void FemPlyReaderDelegate::processBoundaryConditions(const std::string& elementName, size_t first, size_t count,
+		const void* records)
+{
+	const unsigned int* boundaryConditions = static_cast<const unsigned int*>(records);
+	for (size_t i = 0; i < count; ++i)
+	{
+		m_boundaryConditionData = boundaryConditions[i];
+		processBoundaryCondition(elementName);
+	}
 }
 
 } // namespace SurgSim
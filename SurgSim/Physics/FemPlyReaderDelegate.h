@@ -49,10 +49,16 @@ class FemPlyReaderDelegate : public SurgSim::DataStructures::PlyReaderDelegate
 	/// Callback function, begin the processing of vertices.
 	/// \param elementName Name of the element.
 	/// \param vertexCount Number of vertices.
-	/// \return memory for vertex data to the reader.
-	virtual void* beginVertices(const std::string& elementName, size_t vertexCount);
+	virtual void beginVertices(const std::string& elementName, size_t vertexCount);
 
-	/// Callback function to process one vertex.
+	/// Callback function to process a block of vertices, by default calls processVertex() for each one of them.
+	/// \param elementName Name of the element.
+	/// \param first Index of the first vertex in the block.
+	/// \param count Number of vertices in the block.
+	/// \param records The Vertex6DData records for the vertices.
+	virtual void processVertices(const std::string& elementName, size_t first, size_t count, const void* records);
+
+	/// Process one vertex, the data for the vertex is in m_vertexData.
 	/// \param elementName Name of the element.
 	virtual void processVertex(const std::string& elementName) = 0;
 
@@ -63,10 +69,17 @@ class FemPlyReaderDelegate : public SurgSim::DataStructures::PlyReaderDelegate
 	/// Callback function, begin the processing of FemElements.
 	/// \param elementName Name of the element.
 	/// \param elementCount Number of elements.
-	/// \return memory for FemElement data to the reader.
-	void* beginFemElements(const std::string& elementName, size_t elementCount);
+	virtual void beginFemElements(const std::string& elementName, size_t elementCount);
+
+	/// Callback function to process a block of FemElements, by default calls processFemElement() for each one of
+	/// them.
+	/// \param elementName Name of the element.
+	/// \param first Index of the first FemElement in the block.
+	/// \param count Number of FemElements in the block.
+	/// \param records The ElementData records for the FemElements.
+	virtual void processFemElements(const std::string& elementName, size_t first, size_t count, const void* records);
 
-	/// Callback function to process one FemElement.
+	/// Process one FemElement, the data for the element is in m_elementData.
 	/// \param elementName Name of the element.
 	virtual void processFemElement(const std::string& elementName) = 0;
 
@@ -87,10 +100,18 @@ class FemPlyReaderDelegate : public SurgSim::DataStructures::PlyReaderDelegate
 	/// Callback function, begin the processing of boundary conditions.
 	/// \param elementName Name of the element.
 	/// \param boundaryConditionCount Number of boundary conditions.
-	/// \return memory for boundary conditions data to the reader.
-	void* beginBoundaryConditions(const std::string& elementName, size_t boundaryConditionCount);
+	virtual void beginBoundaryConditions(const std::string& elementName, size_t boundaryConditionCount);
+
+	/// Callback function to process a block of boundary conditions, by default calls processBoundaryCondition() for
+	/// each one of them.
+	/// \param elementName Name of the element.
+	/// \param first Index of the first boundary condition in the block.
+	/// \param count Number of boundary conditions in the block.
+	/// \param records The vertex indices of the boundary conditions, as unsigned int.
+	virtual void processBoundaryConditions(const std::string& elementName, size_t first, size_t count,
+										   const void* records);
 
-	/// Callback function to process one boundary condition.
+	/// Process one boundary condition, the data for the boundary condition is in m_boundaryConditionData.
 	/// \param elementName Name of the element.
 	virtual void processBoundaryCondition(const std::string& elementName) = 0;
 
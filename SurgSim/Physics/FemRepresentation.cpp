@@ -13,6 +13,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
 #include "SurgSim/DataStructures/IndexedLocalCoordinate.h"
 #include "SurgSim/DataStructures/PlyReader.h"
 #include "SurgSim/Framework/Assert.h"
@@ -31,6 +35,102 @@ using SurgSim::Math::Matrix;
 using SurgSim::Math::OdeState;
 using SurgSim::Math::SparseMatrix;
 
+namespace
+{
+
+/// Calculates the largest rotation angle between two node transformations, compared per 3x3 diagonal block
+/// \param a, b The node transformations, numDofPerNode x numDofPerNode
+/// \return The largest angle between corresponding rotations, or the norm of the difference if the transformations
+///         are not made of 3x3 blocks
+double rotationChange(const Eigen::Ref<const Matrix>& a, const Eigen::Ref<const Matrix>& b)
+{
+	if (a.rows() % 3 != 0)
+	{
+		return (a - b).norm();
+	}
+
+	double angle = 0.0;
+	for (Eigen::Index i = 0; i < a.rows(); i += 3)
+	{
+		const SurgSim::Math::Matrix33d relative = a.block<3, 3>(i, i).transpose() * b.block<3, 3>(i, i);
+		// The skew symmetric part keeps small angles accurate, where acos of the trace alone would not
+		const double sine = (relative - relative.transpose()).norm() / (2.0 * std::sqrt(2.0));
+		const double cosine = 0.5 * (relative.trace() - 1.0);
+		angle = std::max(angle, std::atan2(sine, cosine));
+	}
+	return angle;
+}
+
+/// Recomputes the blocks of a compliance warping matrix W = R.C.R^t that belong to the given nodes, i.e. their block
+/// rows and block columns, using only products of node sized blocks
+/// \tparam B The number of dof per node, Eigen::Dynamic if not known at compile time
+/// \param compliance The compliance matrix C
+/// \param transformations The node transformations (the diagonal blocks of R) side by side
+/// \param nodes The nodes to update
+/// \param [in,out] warped The compliance warping matrix W
+template <int B>
+void warpComplianceBlocks(const Matrix& compliance, const Matrix& transformations, const std::vector<size_t>& nodes,
+						  Matrix* warped)
+{
+	const Eigen::Index size = transformations.rows();
+	const Eigen::Index numNodes = transformations.cols() / size;
+
+	std::vector<bool> isUpdated(numNodes, false);
+	for (size_t node : nodes)
+	{
+		isUpdated[node] = true;
+	}
+
+	for (size_t node : nodes)
+	{
+		const Eigen::Index i = static_cast<Eigen::Index>(node) * size;
+		for (Eigen::Index j = 0; j < numNodes * size; j += size)
+		{
+			warped->block<B, B>(i, j, size, size).noalias() = transformations.block<B, B>(0, i, size, size) *
+					compliance.block<B, B>(i, j, size, size) *
+					transformations.block<B, B>(0, j, size, size).transpose();
+		}
+	}
+
+	for (size_t node : nodes)
+	{
+		const Eigen::Index j = static_cast<Eigen::Index>(node) * size;
+		for (Eigen::Index i = 0; i < numNodes * size; i += size)
+		{
+			if (!isUpdated[i / size])
+			{
+				warped->block<B, B>(i, j, size, size).noalias() = transformations.block<B, B>(0, i, size, size) *
+						compliance.block<B, B>(i, j, size, size) *
+						transformations.block<B, B>(0, j, size, size).transpose();
+			}
+		}
+	}
+}
+
+/// Recomputes the blocks of a compliance warping matrix that belong to the given nodes
+/// \param compliance The compliance matrix
+/// \param transformations The node transformations side by side
+/// \param nodes The nodes to update
+/// \param [in,out] warped The compliance warping matrix
+void warpComplianceMatrix(const Matrix& compliance, const Matrix& transformations, const std::vector<size_t>& nodes,
+						  Matrix* warped)
+{
+	switch (transformations.rows())
+	{
+	case 3:
+		warpComplianceBlocks<3>(compliance, transformations, nodes, warped);
+		break;
+	case 6:
+		warpComplianceBlocks<6>(compliance, transformations, nodes, warped);
+		break;
+	default:
+		warpComplianceBlocks<Eigen::Dynamic>(compliance, transformations, nodes, warped);
+		break;
+	}
+}
+
+}
+
 namespace SurgSim
 {
 
@@ -42,7 +142,10 @@ FemRepresentation::FemRepresentation(const std::string& name) :
 	m_useMassLumping(false),
 	m_useComplianceWarping(false),
 	m_isComplianceWarpingSynchronous(true),
-	m_isInitialComplianceMatrixComputed(false)
+	m_isInitialComplianceMatrixComputed(false),
+	m_complianceWarpingThreshold(0.0),
+	m_complianceWarpingStatistics(),
+	m_taskAge(0)
 {
 	m_rayleighDamping.massCoefficient = 0.0;
 	m_rayleighDamping.stiffnessCoefficient = 0.0;
@@ -50,6 +153,9 @@ FemRepresentation::FemRepresentation(const std::string& name) :
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(FemRepresentation, bool, ComplianceWarping,
 									  getComplianceWarping, setComplianceWarping);
 
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(FemRepresentation, double, ComplianceWarpingThreshold,
+									  getComplianceWarpingThreshold, setComplianceWarpingThreshold);
+
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(FemRepresentation, bool, MassLumping,
 									  getMassLumping, setMassLumping);
 
@@ -251,23 +357,8 @@ void FemRepresentation::update(double dt)
 			m_odeSolver->computeMatrices(dt, *m_initialState, true);
 			setIsInitialComplianceMatrixComputed(true);
 
-			if (!m_isComplianceWarpingSynchronous)
-			{
-				auto shared = std::dynamic_pointer_cast<FemRepresentation>(getSharedPtr());
-				auto calculation = [shared]()
-				{
-					return (shared->m_complianceWarpingTransformationForCalculation *
-						shared->m_odeSolver->getComplianceMatrix() *
-						shared->m_complianceWarpingTransformationForCalculation.transpose()).eval();
-				};
-
-				// Then, transform the initial compliance matrix to get the current compliance warping matrix
-				m_complianceWarpingMatrix.noalias() = m_complianceWarpingTransformation *
-					m_odeSolver->getComplianceMatrix() * m_complianceWarpingTransformation.transpose();
-
-				m_complianceWarpingTransformationForCalculation = m_complianceWarpingTransformation;
-				m_task = Framework::Runtime::getThreadPool()->enqueue<Math::Matrix>(calculation);
-			}
+			// All the blocks of the compliance warping matrix need to be computed for the new compliance matrix
+			m_warpedNodeTransformations.resize(0, 0);
 		}
 		m_odeSolver->solve(dt, *m_currentState, m_newState.get(), false);
 
@@ -318,6 +409,22 @@ bool FemRepresentation::isComplianceWarpingSynchronous() const
 	return m_isComplianceWarpingSynchronous;
 }
 
+void FemRepresentation::setComplianceWarpingThreshold(double threshold)
+{
+	SURGSIM_ASSERT(threshold >= 0.0) << "The compliance warping threshold cannot be negative, " << threshold;
+	m_complianceWarpingThreshold = threshold;
+}
+
+double FemRepresentation::getComplianceWarpingThreshold() const
+{
+	return m_complianceWarpingThreshold;
+}
+
+const FemRepresentation::ComplianceWarpingStatistics& FemRepresentation::getComplianceWarpingStatistics() const
+{
+	return m_complianceWarpingStatistics;
+}
+
 
 void FemRepresentation::setMassLumping(bool useMassLumping) {
 	SURGSIM_ASSERT(!isInitialized()) << "Can't change mass lumping after initialization.";
@@ -367,32 +474,130 @@ void FemRepresentation::calculateComplianceWarpingTransformation(const SurgSim::
 		"store the proper compliance warping transformation";
 }
 
+std::vector<size_t> FemRepresentation::updateWarpedNodeTransformations()
+{
+	using Eigen::Index;
+	const Index numDofPerNode = static_cast<Index>(getNumDofPerNode());
+	const Index numDof = static_cast<Index>(getNumDof());
+	const size_t numNodes = getNumDof() / getNumDofPerNode();
+
+	std::vector<size_t> nodes;
+	m_complianceWarpingStatistics.maxRotationError = 0.0;
+
+	if (m_warpedNodeTransformations.cols() != numDof)
+	{
+		m_warpedNodeTransformations.resize(numDofPerNode, numDof);
+		nodes.reserve(numNodes);
+		for (size_t node = 0; node < numNodes; ++node)
+		{
+			const Index index = static_cast<Index>(node) * numDofPerNode;
+			m_warpedNodeTransformations.block(0, index, numDofPerNode, numDofPerNode) =
+				m_complianceWarpingTransformation.block(index, index, numDofPerNode, numDofPerNode);
+			nodes.push_back(node);
+		}
+		return nodes;
+	}
+
+	Matrix current(numDofPerNode, numDofPerNode);
+	for (size_t node = 0; node < numNodes; ++node)
+	{
+		const Index index = static_cast<Index>(node) * numDofPerNode;
+		auto warped = m_warpedNodeTransformations.block(0, index, numDofPerNode, numDofPerNode);
+		current = m_complianceWarpingTransformation.block(index, index, numDofPerNode, numDofPerNode);
+		if (current == warped)
+		{
+			continue;
+		}
+
+		const double change = (m_complianceWarpingThreshold > 0.0) ? rotationChange(current, warped) : 0.0;
+		if (m_complianceWarpingThreshold <= 0.0 || change > m_complianceWarpingThreshold)
+		{
+			warped = current;
+			nodes.push_back(node);
+		}
+		else
+		{
+			Math::assignSubMatrixNoInitialize(warped, static_cast<Index>(node), static_cast<Index>(node),
+											  &m_complianceWarpingTransformation);
+			m_complianceWarpingStatistics.maxRotationError =
+				std::max(m_complianceWarpingStatistics.maxRotationError, change);
+		}
+	}
+	return nodes;
+}
+
 void FemRepresentation::updateComplianceMatrix(const SurgSim::Math::OdeState& state)
 {
+	auto start = std::chrono::steady_clock::now();
+	auto& statistics = m_complianceWarpingStatistics;
+
 	calculateComplianceWarpingTransformation(state);
 
-	if (m_isComplianceWarpingSynchronous)
+	// The first update after the compliance matrix has been computed is always synchronous
+	const bool isFirstUpdate = (m_warpedNodeTransformations.cols() != static_cast<Eigen::Index>(getNumDof()));
+	if (m_isComplianceWarpingSynchronous || isFirstUpdate)
 	{
-		m_complianceWarpingMatrix.noalias() = m_complianceWarpingTransformation *
-			m_odeSolver->getComplianceMatrix() * m_complianceWarpingTransformation.transpose();
+		if (isFirstUpdate)
+		{
+			m_complianceWarpingMatrix.resize(getNumDof(), getNumDof());
+		}
+		std::vector<size_t> nodes = updateWarpedNodeTransformations();
+		warpComplianceMatrix(m_odeSolver->getComplianceMatrix(), m_warpedNodeTransformations, nodes,
+							 &m_complianceWarpingMatrix);
+
+		++statistics.numUpdates;
+		statistics.numNodesUpdated = nodes.size();
+		statistics.numNodesUpdatedTotal += nodes.size();
+		statistics.staleUpdates = 0;
 	}
 	else
 	{
-		auto shared = std::dynamic_pointer_cast<FemRepresentation>(getSharedPtr());
-		auto calculation = [shared]()
+		++m_taskAge;
+		++statistics.staleUpdates;
+		if (!m_task.valid() || m_task.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
 		{
-			return (shared->m_complianceWarpingTransformationForCalculation *
-				shared->m_odeSolver->getComplianceMatrix() *
-				shared->m_complianceWarpingTransformationForCalculation.transpose()).eval();
-		};
+			// The finished matrix becomes the current one, the previous one is reused by the next calculation
+			std::vector<size_t> outdatedNodes;
+			if (m_task.valid())
+			{
+				m_task.get();
+				m_complianceWarpingMatrix.swap(m_complianceWarpingBackMatrix);
+				statistics.staleUpdates = m_taskAge;
+				outdatedNodes.swap(m_taskNodes);
+			}
+			if (m_complianceWarpingBackMatrix.rows() != m_complianceWarpingMatrix.rows())
+			{
+				m_complianceWarpingBackMatrix = m_complianceWarpingMatrix;
+				outdatedNodes.clear();
+			}
 
-		if (m_task.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
-		{
-			m_complianceWarpingMatrix = m_task.get();
-			m_complianceWarpingTransformationForCalculation = m_complianceWarpingTransformation;
-			m_task = Framework::Runtime::getThreadPool()->enqueue<Math::Matrix>(calculation);
+			// The calculation only updates the blocks of the nodes whose transformation changed, in the back matrix
+			// these also include the nodes updated by the last calculation
+			std::vector<size_t> nodes = updateWarpedNodeTransformations();
+			m_taskNodes = nodes;
+			outdatedNodes.insert(outdatedNodes.end(), nodes.begin(), nodes.end());
+			std::sort(outdatedNodes.begin(), outdatedNodes.end());
+			outdatedNodes.erase(std::unique(outdatedNodes.begin(), outdatedNodes.end()), outdatedNodes.end());
+
+			auto shared = std::dynamic_pointer_cast<FemRepresentation>(getSharedPtr());
+			Matrix transformations = m_warpedNodeTransformations;
+			auto calculation = [shared, transformations, outdatedNodes]()
+			{
+				warpComplianceMatrix(shared->m_odeSolver->getComplianceMatrix(), transformations, outdatedNodes,
+									 &shared->m_complianceWarpingBackMatrix);
+			};
+			m_task = Framework::Runtime::getThreadPool()->enqueue<void>(calculation);
+			m_taskAge = 0;
+
+			++statistics.numUpdates;
+			statistics.numNodesUpdated = nodes.size();
+			statistics.numNodesUpdatedTotal += nodes.size();
 		}
 	}
+
+	statistics.lastUpdateDuration =
+		std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	statistics.totalUpdateDuration += statistics.lastUpdateDuration;
 }
 
 void FemRepresentation::computeF(const SurgSim::Math::OdeState& state)
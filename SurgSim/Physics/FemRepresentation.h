@@ -18,6 +18,7 @@
 
 #include <future>
 #include <memory>
+#include <vector>
 
 #include "SurgSim/DataStructures/IndexedLocalCoordinate.h"
 #include "SurgSim/Math/Matrix.h"
@@ -134,6 +135,41 @@ class FemRepresentation : public DeformableRepresentation
 	/// \return True if compliance warping is calculated synchronously.
 	bool isComplianceWarpingSynchronous() const;
 
+	/// Set the rotation threshold of the compliance warping update.
+	/// Only the blocks of the compliance warping matrix that belong to nodes whose transformation changed by more than
+	/// this angle since they were last warped are recomputed, the other nodes keep their previous transformation.
+	/// The default of 0 recomputes the blocks of every node that moved, which gives the exact result.
+	/// \param threshold The rotation angle (in radians) above which the blocks of a node are recomputed
+	void setComplianceWarpingThreshold(double threshold);
+
+	/// \return The rotation angle (in radians) above which the compliance warping blocks of a node are recomputed
+	double getComplianceWarpingThreshold() const;
+
+	/// Statistics of the compliance warping updates, to weigh the staleness of the compliance warping matrix
+	/// against the cost of keeping it up to date
+	struct ComplianceWarpingStatistics
+	{
+		/// Number of updates of the compliance warping matrix
+		size_t numUpdates;
+		/// Number of nodes whose blocks were recomputed during the last update
+		size_t numNodesUpdated;
+		/// Number of nodes whose blocks were recomputed, over all the updates
+		size_t numNodesUpdatedTotal;
+		/// Largest rotation (in radians) of a node that is not reflected in the compliance warping matrix
+		double maxRotationError;
+		/// Number of updates since the transformations used in the compliance warping matrix were captured,
+		/// always 0 for synchronous compliance warping
+		size_t staleUpdates;
+		/// Time spent on the last update (in seconds), for asynchronous compliance warping this does not include
+		/// the calculation on the ThreadPool
+		double lastUpdateDuration;
+		/// Time spent on all the updates (in seconds)
+		double totalUpdateDuration;
+	};
+
+	/// \return The statistics of the compliance warping updates
+	const ComplianceWarpingStatistics& getComplianceWarpingStatistics() const;
+
 	/// Enable mass lumping for the mass matrix, currently we use the row sum i.e.
 	/// \f$M_{ii}^{(lumped)} = \sum_{j} M_{ji}\f$
 	/// \param useMassLumping whether to enable or disable lumped masses
@@ -168,7 +204,8 @@ class FemRepresentation : public DeformableRepresentation
 	/// \param[in,out] f The force vector to cumulate the FemElements forces into
 	/// \param state The state vector containing positions and velocities
 	/// \param scale A scaling factor to scale the FemElements forces with
-	void addFemElementsForce(SurgSim::Math::Vector* f, const SurgSim::Math::OdeState& state, double scale = 1.0);
+	virtual void addFemElementsForce(SurgSim::Math::Vector* f, const SurgSim::Math::OdeState& state,
+									 double scale = 1.0);
 
 	/// Adds the gravity force to f (given a state)
 	/// \param[in,out] f The force vector to cumulate the gravity force into
@@ -195,6 +232,12 @@ class FemRepresentation : public DeformableRepresentation
 	/// \param state The state to extract the node transformation from
 	virtual void calculateComplianceWarpingTransformation(const SurgSim::Math::OdeState& state);
 
+	/// Compare the transformation of each node with the transformation it was last warped with, the nodes that
+	/// changed by more than the threshold get their new transformation, the other nodes get their previous
+	/// transformation written back to m_complianceWarpingTransformation, so that it matches the warped matrix.
+	/// \return The ids of the nodes whose compliance warping blocks need to be recomputed
+	std::vector<size_t> updateWarpedNodeTransformations();
+
 	/// Gets the flag keeping track of the initial compliance matrix calculation (compliance warping case)
 	/// \return True if the initial compliance matrix has been computed, False otherwise
 	bool isInitialComplianceMatrixComputed() const;
@@ -237,10 +280,24 @@ class FemRepresentation : public DeformableRepresentation
 	/// The system-size transformation matrix. It contains nodes transformation on the diagonal blocks.
 	Eigen::SparseMatrix<double> m_complianceWarpingTransformation;
 
+	/// The node transformations the compliance warping matrix was computed with, stored side by side, i.e.
+	/// a numDofPerNode x (numNodes * numDofPerNode) matrix
+	SurgSim::Math::Matrix m_warpedNodeTransformations;
+
+	/// Rotation angle above which the compliance warping blocks of a node are recomputed
+	double m_complianceWarpingThreshold;
+
+	/// Statistics of the compliance warping updates
+	ComplianceWarpingStatistics m_complianceWarpingStatistics;
+
 	///@{
-	/// For the asynchronous compliance matrix multiplication.
-	Eigen::SparseMatrix<double> m_complianceWarpingTransformationForCalculation;
-	std::future<SurgSim::Math::Matrix> m_task;
+	/// For the asynchronous compliance matrix multiplication. The task updates m_complianceWarpingBackMatrix, which is
+	/// swapped with m_complianceWarpingMatrix once the task is done, so that neither matrix is copied.
+	std::future<void> m_task;
+	size_t m_taskAge;
+	SurgSim::Math::Matrix m_complianceWarpingBackMatrix;
+	/// The nodes updated by the last task, their blocks are outdated in the back matrix after the swap
+	std::vector<size_t> m_taskNodes;
 	///@}
 
 private:
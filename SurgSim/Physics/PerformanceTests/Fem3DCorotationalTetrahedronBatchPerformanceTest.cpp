@@ -0,0 +1,302 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include "SurgSim/Framework/Timer.h"
+#include "SurgSim/Math/Matrix.h"
+#include "SurgSim/Math/OdeEquation.h"
+#include "SurgSim/Math/OdeState.h"
+#include "SurgSim/Math/Vector.h"
+#include "SurgSim/Physics/Fem3DCorotationalTetrahedronBatch.h"
+#include "SurgSim/Physics/Fem3DElementCorotationalTetrahedron.h"
+
+using SurgSim::Math::Vector;
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+static const int frameCount = 10;
+
+/// A 20x20x21 lattice of cubes, each cut in 6 tetrahedra, i.e. 50400 tetrahedra
+static const size_t numCubes[3] = {20, 20, 21};
+
+/// The 6 tetrahedra of a cube, its corners being indexed by their (x, y, z) bits
+static const std::array<std::array<size_t, 4>, 6> cubeTetrahedra = {{
+		{{0, 1, 3, 7}}, {{0, 1, 5, 7}}, {{0, 2, 3, 7}}, {{0, 2, 6, 7}}, {{0, 4, 5, 7}}, {{0, 4, 6, 7}}
+	}
+};
+}
+
+namespace SurgSim
+{
+
+namespace Physics
+{
+
+class Fem3DCorotationalTetrahedronBatchPerformanceTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		const size_t numNodes[3] = {numCubes[0] + 1, numCubes[1] + 1, numCubes[2] + 1};
+		m_restState.setNumDof(3, numNodes[0] * numNodes[1] * numNodes[2]);
+		m_state.setNumDof(3, m_restState.getNumNodes());
+		const Math::Matrix33d rotation = Math::makeRotationMatrix(0.7, Vector3d(1.0, 1.0, 0.0).normalized());
+		for (size_t k = 0; k < numNodes[2]; ++k)
+		{
+			for (size_t j = 0; j < numNodes[1]; ++j)
+			{
+				for (size_t i = 0; i < numNodes[0]; ++i)
+				{
+					const size_t nodeId = i + numNodes[0] * (j + numNodes[1] * k);
+					Vector3d p = 0.01 * Vector3d(i, j, k);
+					m_restState.getPositions().segment<3>(3 * nodeId) = p;
+					m_state.getPositions().segment<3>(3 * nodeId) =
+						rotation * (p + Vector3d(0.1 * p[2] * p[2], 0.0, -0.05 * p[0]));
+				}
+			}
+		}
+
+		for (size_t k = 0; k < numCubes[2]; ++k)
+		{
+			for (size_t j = 0; j < numCubes[1]; ++j)
+			{
+				for (size_t i = 0; i < numCubes[0]; ++i)
+				{
+					for (const auto& tetrahedron : cubeTetrahedra)
+					{
+						std::array<size_t, 4> nodeIds;
+						for (size_t node = 0; node < 4; ++node)
+						{
+							const size_t corner = tetrahedron[node];
+							const size_t nodeI = i + (corner & 1);
+							const size_t nodeJ = j + ((corner >> 1) & 1);
+							const size_t nodeK = k + (corner >> 2);
+							nodeIds[node] = nodeI + numNodes[0] * (nodeJ + numNodes[1] * nodeK);
+						}
+						addElement(nodeIds);
+					}
+				}
+			}
+		}
+	}
+
+	void addElement(std::array<size_t, 4> nodeIds)
+	{
+		Vector3d a = m_restState.getPosition(nodeIds[0]);
+		Vector3d b = m_restState.getPosition(nodeIds[1]);
+		Vector3d c = m_restState.getPosition(nodeIds[2]);
+		Vector3d d = m_restState.getPosition(nodeIds[3]);
+		if ((b - a).cross(c - a).dot(d - a) < 0.0)
+		{
+			std::swap(nodeIds[2], nodeIds[3]);
+		}
+
+		auto element = std::make_shared<Fem3DElementCorotationalTetrahedron>(nodeIds);
+		element->setMassDensity(1000.0);
+		element->setPoissonRatio(0.45);
+		element->setYoungModulus(1e6);
+		element->initialize(m_restState);
+		m_elements.push_back(element);
+	}
+
+	/// The data an element needs to compute its co-rotational force, gathered from the elements
+	struct ElementData
+	{
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+		std::array<size_t, 4> nodeIds;
+		Math::Matrix44d Vinverse;
+		Eigen::Matrix<double, 12, 1> x0;
+		Eigen::Matrix<double, 12, 12> stiffness;
+		Math::Matrix33d rotation;
+	};
+
+	std::vector<ElementData, Eigen::aligned_allocator<ElementData>> getElementData() const
+	{
+		std::vector<ElementData, Eigen::aligned_allocator<ElementData>> result(m_elements.size());
+		for (size_t i = 0; i < m_elements.size(); ++i)
+		{
+			ElementData& data = result[i];
+			Math::Matrix44d V;
+			V.row(3).setOnes();
+			for (size_t node = 0; node < 4; ++node)
+			{
+				data.nodeIds[node] = m_elements[i]->getNodeId(node);
+				data.x0.segment<3>(3 * node) = m_restState.getPosition(data.nodeIds[node]);
+				V.col(node).segment<3>(0) = data.x0.segment<3>(3 * node);
+			}
+			data.Vinverse = V.inverse();
+			data.stiffness = m_elements[i]->getLinearStiffnessMatrix();
+			data.rotation = m_elements[i]->getRotationMatrix();
+		}
+		return result;
+	}
+
+protected:
+	Math::OdeState m_restState;
+	Math::OdeState m_state;
+	std::vector<std::shared_ptr<Fem3DElementCorotationalTetrahedron>> m_elements;
+};
+
+TEST_F(Fem3DCorotationalTetrahedronBatchPerformanceTest, ForceTest)
+{
+	// The reference does the same work as the batch, element by element: the rest data is gathered beforehand, each
+	// element extracts its rotation with a polar decomposition and computes f = -R.Ke.(R^t.x - x0)
+	std::vector<ElementData, Eigen::aligned_allocator<ElementData>> elementData = getElementData();
+	Vector F = Vector::Zero(m_state.getNumDof());
+
+	Framework::Timer referenceTimer;
+	referenceTimer.setMaxNumberOfFrames(frameCount);
+	for (int i = 0; i < frameCount; i++)
+	{
+		referenceTimer.beginFrame();
+		F.setZero();
+		for (const auto& data : elementData)
+		{
+			Math::Matrix44d P;
+			P.row(3).setOnes();
+			for (size_t node = 0; node < 4; ++node)
+			{
+				P.col(node).segment<3>(0) = m_state.getPosition(data.nodeIds[node]);
+			}
+			Eigen::Transform<double, 3, Eigen::Affine> deformation(P * data.Vinverse);
+			Math::Matrix33d R, scaling;
+			deformation.computeRotationScaling(&R, &scaling);
+
+			Eigen::Matrix<double, 12, 1> local;
+			for (size_t node = 0; node < 4; ++node)
+			{
+				local.segment<3>(3 * node) = R.transpose() * P.col(node).segment<3>(0) - data.x0.segment<3>(3 * node);
+			}
+			const Eigen::Matrix<double, 12, 1> stiffnessForce = data.stiffness * local;
+			for (size_t node = 0; node < 4; ++node)
+			{
+				F.segment<3>(3 * data.nodeIds[node]) -= R * stiffnessForce.segment<3>(3 * node);
+			}
+		}
+		referenceTimer.endFrame();
+	}
+
+	// The elements also build their complete co-rotational stiffness when updating their forces
+	Vector elementF = Vector::Zero(m_state.getNumDof());
+	Framework::Timer elementTimer;
+	elementTimer.setMaxNumberOfFrames(frameCount);
+	for (int i = 0; i < frameCount; i++)
+	{
+		elementTimer.beginFrame();
+		elementF.setZero();
+		for (auto& element : m_elements)
+		{
+			element->updateFMDK(m_state, Math::ODEEQUATIONUPDATE_F);
+			element->addForce(&elementF);
+		}
+		elementTimer.endFrame();
+	}
+
+	Fem3DCorotationalTetrahedronBatch batch;
+	batch.initialize(m_elements, m_restState);
+	Vector batchF = Vector::Zero(m_state.getNumDof());
+
+	Framework::Timer batchTimer;
+	batchTimer.setMaxNumberOfFrames(frameCount);
+	for (int i = 0; i < frameCount; i++)
+	{
+		batchTimer.beginFrame();
+		batchF.setZero();
+		batch.updateRotations(m_state);
+		batch.addForce(m_state, &batchF);
+		batchTimer.endFrame();
+	}
+
+	EXPECT_TRUE(batchF.isApprox(F, 1e-8));
+	EXPECT_TRUE(batchF.isApprox(elementF, 1e-8));
+
+	RecordProperty("NumElements", boost::lexical_cast<std::string>(m_elements.size()));
+	RecordProperty("ReferenceDuration", boost::lexical_cast<std::string>(referenceTimer.getCumulativeTime()));
+	RecordProperty("ElementUpdateDuration", boost::lexical_cast<std::string>(elementTimer.getCumulativeTime()));
+	RecordProperty("BatchDuration", boost::lexical_cast<std::string>(batchTimer.getCumulativeTime()));
+	RecordProperty("Speedup", boost::lexical_cast<std::string>(referenceTimer.getCumulativeTime() /
+				   batchTimer.getCumulativeTime()));
+}
+
+TEST_F(Fem3DCorotationalTetrahedronBatchPerformanceTest, MatVecTest)
+{
+	// Both multiply with the co-rotated stiffness R.Ke.R^t, the operation used by iterative solvers on a matrix-free
+	// system, the reference element by element with the rotations of the elements
+	for (auto& element : m_elements)
+	{
+		element->updateFMDK(m_state, Math::ODEEQUATIONUPDATE_F);
+	}
+	std::vector<ElementData, Eigen::aligned_allocator<ElementData>> elementData = getElementData();
+	Fem3DCorotationalTetrahedronBatch batch;
+	batch.initialize(m_elements, m_restState);
+	batch.updateRotations(m_state);
+
+	const Vector x = Vector::LinSpaced(m_state.getNumDof(), -1.0, 1.0);
+	Vector F = Vector::Zero(m_state.getNumDof());
+
+	Framework::Timer referenceTimer;
+	referenceTimer.setMaxNumberOfFrames(frameCount);
+	for (int i = 0; i < frameCount; i++)
+	{
+		referenceTimer.beginFrame();
+		F.setZero();
+		for (const auto& data : elementData)
+		{
+			Eigen::Matrix<double, 12, 1> local;
+			for (size_t node = 0; node < 4; ++node)
+			{
+				local.segment<3>(3 * node) = data.rotation.transpose() * x.segment<3>(3 * data.nodeIds[node]);
+			}
+			const Eigen::Matrix<double, 12, 1> product = data.stiffness * local;
+			for (size_t node = 0; node < 4; ++node)
+			{
+				F.segment<3>(3 * data.nodeIds[node]) += data.rotation * product.segment<3>(3 * node);
+			}
+		}
+		referenceTimer.endFrame();
+	}
+
+	Vector batchF = Vector::Zero(m_state.getNumDof());
+	Framework::Timer batchTimer;
+	batchTimer.setMaxNumberOfFrames(frameCount);
+	for (int i = 0; i < frameCount; i++)
+	{
+		batchTimer.beginFrame();
+		batchF.setZero();
+		batch.addMatVec(1.0, x, &batchF);
+		batchTimer.endFrame();
+	}
+
+	EXPECT_TRUE(batchF.isApprox(F, 1e-8));
+
+	RecordProperty("NumElements", boost::lexical_cast<std::string>(m_elements.size()));
+	RecordProperty("ReferenceDuration", boost::lexical_cast<std::string>(referenceTimer.getCumulativeTime()));
+	RecordProperty("BatchDuration", boost::lexical_cast<std::string>(batchTimer.getCumulativeTime()));
+	RecordProperty("Speedup", boost::lexical_cast<std::string>(referenceTimer.getCumulativeTime() /
+				   batchTimer.getCumulativeTime()));
+}
+
+}; // namespace Physics
+
+}; // namespace SurgSim
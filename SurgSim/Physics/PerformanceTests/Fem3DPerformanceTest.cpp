@@ -55,6 +55,7 @@ static std::unordered_map<SurgSim::Math::IntegrationScheme, std::string, std::ha
 	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::INTEGRATIONSCHEME_LINEAR_STATIC);
 	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::INTEGRATIONSCHEME_RUNGE_KUTTA_4);
 	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4);
+	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::INTEGRATIONSCHEME_EULER_IMPLICIT_QUASI_NEWTON);
 #undef FEM3DPERFORMANCETEST_MAP_NAME
 
 	return result;
@@ -67,6 +68,9 @@ static std::unordered_map<SurgSim::Math::LinearSolver, std::string, std::hash<in
 #define FEM3DPERFORMANCETEST_MAP_NAME(map, name) (map)[name] = #name
 	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::LINEARSOLVER_LU);
 	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::LINEARSOLVER_CONJUGATEGRADIENT);
+	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::LINEARSOLVER_PRECONDITIONEDCONJUGATEGRADIENT);
+	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::LINEARSOLVER_TRIDIAGONALBLOCK);
+	FEM3DPERFORMANCETEST_MAP_NAME(result, SurgSim::Math::LINEARSOLVER_MIXEDPRECISIONLU);
 #undef FEM3DPERFORMANCETEST_MAP_NAME
 
 	return result;
@@ -219,9 +223,12 @@ INSTANTIATE_TEST_CASE_P(Fem3DPerformanceTest,
 								SurgSim::Math::INTEGRATIONSCHEME_STATIC,
 								SurgSim::Math::INTEGRATIONSCHEME_LINEAR_STATIC,
 								SurgSim::Math::INTEGRATIONSCHEME_RUNGE_KUTTA_4,
-								SurgSim::Math::INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4),
+								SurgSim::Math::INTEGRATIONSCHEME_LINEAR_RUNGE_KUTTA_4,
+								SurgSim::Math::INTEGRATIONSCHEME_EULER_IMPLICIT_QUASI_NEWTON),
 								::testing::Values(SurgSim::Math::LINEARSOLVER_LU,
-										SurgSim::Math::LINEARSOLVER_CONJUGATEGRADIENT)));
+										SurgSim::Math::LINEARSOLVER_CONJUGATEGRADIENT,
+										SurgSim::Math::LINEARSOLVER_PRECONDITIONEDCONJUGATEGRADIENT,
+										SurgSim::Math::LINEARSOLVER_MIXEDPRECISIONLU)));
 
 INSTANTIATE_TEST_CASE_P(
 	Fem3DPerformanceTest,
@@ -15,6 +15,11 @@
 
 #include "SurgSim/Physics/PhysicsManager.h"
 
+#include <functional>
+#include <iterator>
+#include <map>
+#include <unordered_set>
+
 #include "SurgSim/Framework/Component.h"
 #include "SurgSim/Physics/BuildMlcp.h"
 #include "SurgSim/Physics/CcdCollision.h"
@@ -36,13 +41,190 @@
 #include "SurgSim/Physics/UpdateCollisionRepresentations.h"
 #include "SurgSim/Physics/UpdateDcdData.h"
 
+namespace
+{
+
+/// Merge the final states of the rate groups, so that the final state covers all the representations. The constraint
+/// problems of the groups are assembled block by block, on the degrees of freedom of all the active representations.
+/// \param states The final states of the rate groups, the fastest group last
+/// \return The merged state, with the collision and particle data of the fastest group
+SurgSim::Physics::PhysicsManagerState mergeStates(
+	const std::vector<std::shared_ptr<SurgSim::Physics::PhysicsManagerState>>& states)
+{
+	using SurgSim::Physics::Constraint;
+	using SurgSim::Physics::MlcpMapping;
+	using SurgSim::Physics::Representation;
+
+	SurgSim::Physics::PhysicsManagerState merged(*states.back());
+
+	std::vector<std::shared_ptr<Representation>> representations;
+	std::vector<std::shared_ptr<Representation>> activeRepresentations;
+	std::vector<std::shared_ptr<SurgSim::Collision::CollisionPair>> collisionPairs;
+	std::unordered_set<const SurgSim::Collision::CollisionPair*> knownCollisionPairs;
+	std::vector<std::vector<std::shared_ptr<Constraint>>> constraints(SurgSim::Physics::CONSTRAINT_GROUP_TYPE_COUNT);
+	std::vector<std::shared_ptr<Constraint>> activeConstraints;
+	std::unordered_set<const Constraint*> knownConstraints;
+	std::unordered_set<const Constraint*> knownActiveConstraints;
+	MlcpMapping<Representation> representationsMapping;
+	MlcpMapping<Constraint> constraintsMapping;
+	size_t numDof = 0;
+	size_t numAtomicConstraint = 0;
+	for (const auto& state : states)
+	{
+		representations.insert(representations.end(), state->getRepresentations().begin(),
+							   state->getRepresentations().end());
+		for (const auto& representation : state->getActiveRepresentations())
+		{
+			activeRepresentations.push_back(representation);
+			representationsMapping.setValue(representation.get(), numDof);
+			numDof += representation->getNumDof();
+		}
+		for (const auto& pair : state->getCollisionPairs())
+		{
+			if (knownCollisionPairs.insert(pair.get()).second)
+			{
+				collisionPairs.push_back(pair);
+			}
+		}
+		// The scene constraints are known to all the groups, the last group that solved a constraint is kept
+		for (size_t type = 0; type < constraints.size(); ++type)
+		{
+			for (const auto& constraint : state->getConstraintGroup(static_cast<int>(type)))
+			{
+				if (knownConstraints.insert(constraint.get()).second)
+				{
+					constraints[type].push_back(constraint);
+				}
+			}
+		}
+		for (const auto& constraint : state->getActiveConstraints())
+		{
+			if (knownActiveConstraints.insert(constraint.get()).second)
+			{
+				activeConstraints.push_back(constraint);
+			}
+			const ptrdiff_t index = state->getConstraintsMapping().getValue(constraint.get());
+			if (index >= 0)
+			{
+				constraintsMapping.setValue(constraint.get(), numAtomicConstraint + index);
+			}
+		}
+		numAtomicConstraint += state->getMlcpProblem().getSize();
+	}
+
+	auto& problem = merged.getMlcpProblem();
+	auto& solution = merged.getMlcpSolution();
+	problem.A.setZero(numAtomicConstraint, numAtomicConstraint);
+	problem.b.setZero(numAtomicConstraint);
+	problem.mu.setZero(numAtomicConstraint);
+	problem.constraintTypes.clear();
+	problem.CHt.setZero(numDof, numAtomicConstraint);
+	solution.x.setZero(numAtomicConstraint);
+	solution.dofCorrection.setZero(numDof);
+
+	std::vector<Eigen::Triplet<double, ptrdiff_t>> triplets;
+	size_t offset = 0;
+	for (const auto& state : states)
+	{
+		const auto& groupProblem = state->getMlcpProblem();
+		const auto& groupSolution = state->getMlcpSolution();
+		const auto& groupMapping = state->getRepresentationsMapping();
+
+		// The dofs of the group, its proxies included, in the merged problem
+		std::vector<ptrdiff_t> dofs(groupProblem.H.cols(), -1);
+		for (const auto* groupRepresentations : {&state->getActiveRepresentations(), &state->getProxyRepresentations()})
+		{
+			for (const auto& representation : *groupRepresentations)
+			{
+				const ptrdiff_t groupIndex = groupMapping.getValue(representation.get());
+				const ptrdiff_t index = representationsMapping.getValue(representation.get());
+				if (groupIndex >= 0 && index >= 0 && groupIndex < static_cast<ptrdiff_t>(dofs.size()))
+				{
+					for (size_t dof = 0; dof < representation->getNumDof(); ++dof)
+					{
+						dofs[groupIndex + dof] = index + dof;
+					}
+				}
+			}
+		}
+
+		const size_t size = groupProblem.getSize();
+		if (size > 0)
+		{
+			problem.A.block(offset, offset, size, size) = groupProblem.A;
+			problem.b.segment(offset, size) = groupProblem.b;
+			problem.mu.segment(offset, size) = groupProblem.mu;
+			problem.constraintTypes.insert(problem.constraintTypes.end(), groupProblem.constraintTypes.begin(),
+										   groupProblem.constraintTypes.end());
+			if (static_cast<size_t>(groupSolution.x.size()) == size)
+			{
+				solution.x.segment(offset, size) = groupSolution.x;
+			}
+			for (ptrdiff_t row = 0; row < groupProblem.H.outerSize(); ++row)
+			{
+				for (Eigen::SparseMatrix<double, Eigen::RowMajor, ptrdiff_t>::InnerIterator it(groupProblem.H, row);
+					 it; ++it)
+				{
+					if (dofs[it.col()] >= 0)
+					{
+						triplets.emplace_back(offset + row, dofs[it.col()], it.value());
+					}
+				}
+			}
+			for (size_t dof = 0; dof < dofs.size(); ++dof)
+			{
+				if (dofs[dof] >= 0)
+				{
+					problem.CHt.block(dofs[dof], offset, 1, size) = groupProblem.CHt.row(dof);
+				}
+			}
+		}
+
+		// Only the representations updated by the group are corrected
+		for (const auto& representation : state->getActiveRepresentations())
+		{
+			const ptrdiff_t groupIndex = groupMapping.getValue(representation.get());
+			const ptrdiff_t numRepresentationDof = static_cast<ptrdiff_t>(representation->getNumDof());
+			if (groupIndex >= 0 && groupIndex + numRepresentationDof <= groupSolution.dofCorrection.size())
+			{
+				solution.dofCorrection.segment(representationsMapping.getValue(representation.get()),
+											   numRepresentationDof) =
+					groupSolution.dofCorrection.segment(groupIndex, numRepresentationDof);
+			}
+		}
+
+		offset += size;
+	}
+	problem.H.resize(numAtomicConstraint, numDof);
+	problem.H.setFromTriplets(triplets.begin(), triplets.end());
+
+	merged.setRepresentations(representations);
+	merged.setProxyRepresentations(std::vector<std::shared_ptr<Representation>>());
+	merged.setProxyTimings(std::vector<SurgSim::Physics::ProxyTiming>());
+	merged.setActiveRepresentations(activeRepresentations);
+	merged.setCollisionPairs(collisionPairs);
+	for (size_t type = 0; type < constraints.size(); ++type)
+	{
+		merged.setConstraintGroup(static_cast<SurgSim::Physics::ConstraintGroupType>(type), constraints[type]);
+	}
+	merged.setActiveConstraints(activeConstraints);
+	merged.setRepresentationsMapping(representationsMapping);
+	merged.setConstraintsMapping(constraintsMapping);
+
+	return merged;
+}
+
+}
+
 namespace SurgSim
 {
 namespace Physics
 {
 
 PhysicsManager::PhysicsManager() :
-	ComponentManager("Physics Manager")
+	ComponentManager("Physics Manager"),
+	m_contactCachingEnabled(false),
+	m_numUpdates(0)
 {
 	setRate(1000.0);
 }
@@ -63,6 +245,7 @@ bool PhysicsManager::doInitialize()
 	{
 		setComputations(createDcdPipeline(false));
 	}
+	setContactCachingEnabled(m_contactCachingEnabled);
 	return true;
 }
 
@@ -78,6 +261,37 @@ void PhysicsManager::setComputations(std::vector<std::shared_ptr<Physics::Comput
 	m_computations = computations;
 }
 
+void PhysicsManager::setContactCachingEnabled(bool enabled)
+{
+	m_contactCachingEnabled = enabled;
+	for (const auto& computation : m_computations)
+	{
+		auto dcdCollision = std::dynamic_pointer_cast<DcdCollision>(computation);
+		if (dcdCollision != nullptr)
+		{
+			dcdCollision->setContactCachingEnabled(enabled);
+		}
+	}
+}
+
+bool PhysicsManager::isContactCachingEnabled() const
+{
+	return m_contactCachingEnabled;
+}
+
+double PhysicsManager::getSkippedPairsFraction() const
+{
+	for (const auto& computation : m_computations)
+	{
+		auto dcdCollision = std::dynamic_pointer_cast<DcdCollision>(computation);
+		if (dcdCollision != nullptr)
+		{
+			return dcdCollision->getSkippedPairsFraction();
+		}
+	}
+	return 0.0;
+}
+
 bool PhysicsManager::doStartUp()
 {
 	return true;
@@ -85,7 +299,21 @@ bool PhysicsManager::doStartUp()
 
 void PhysicsManager::getFinalState(SurgSim::Physics::PhysicsManagerState* s) const
 {
-	m_finalState.get(s);
+	// The states of the rate groups are only merged on request, not at every update of the fastest group
+	std::vector<std::shared_ptr<PhysicsManagerState>> states;
+	m_finalStates.get(&states);
+	if (states.size() == 1)
+	{
+		*s = *states.front();
+	}
+	else if (!states.empty())
+	{
+		*s = mergeStates(states);
+	}
+	else
+	{
+		*s = PhysicsManagerState();
+	}
 }
 
 bool PhysicsManager::executeAdditions(const std::shared_ptr<SurgSim::Framework::Component>& component)
@@ -114,18 +342,50 @@ bool PhysicsManager::doUpdate(double dt)
 	processBehaviors(dt);
 	processComponents();
 
-	auto state = std::make_shared<PhysicsManagerState>();
-	std::list<std::shared_ptr<PhysicsManagerState>> stateList(1, state);
-	state->setRepresentations(m_representations);
-	state->setCollisionRepresentations(m_collisionRepresentations);
-	state->setContactFilters(m_contactFilters);
-	state->setParticleRepresentations(m_particleRepresentations);
-	state->setConstraintComponents(m_constraintComponents);
+	// Group the representations by rate divider, the slowest group first
+	std::map<size_t, std::vector<std::shared_ptr<Representation>>, std::greater<size_t>> groups;
+	for (const auto& representation : m_representations)
+	{
+		groups[representation->getRateDivider()].push_back(representation);
+	}
+	if (groups.empty())
+	{
+		groups[1];
+	}
+	for (auto it = m_rateGroups.begin(); it != m_rateGroups.end();)
+	{
+		it = (groups.count(it->first) == 0) ? m_rateGroups.erase(it) : std::next(it);
+	}
 
-	for (const auto& computation : m_computations)
+	for (const auto& group : groups)
 	{
-		stateList.push_back(computation->update(dt, stateList.back()));
+		const size_t divider = group.first;
+		if (m_numUpdates % divider == 0)
+		{
+			const size_t end = m_numUpdates + divider;
+			std::vector<std::shared_ptr<Representation>> proxies;
+			std::vector<ProxyTiming> proxyTimings;
+			for (const auto& other : groups)
+			{
+				if (other.first != divider)
+				{
+					// A group that was never updated is at the current time
+					auto found = m_rateGroups.find(other.first);
+					const size_t otherEnd = (found != m_rateGroups.end()) ? found->second.end : m_numUpdates;
+					ProxyTiming timing;
+					timing.timeStep = dt * other.first;
+					timing.timeOffset = dt * (static_cast<double>(end) - static_cast<double>(otherEnd));
+					proxies.insert(proxies.end(), other.second.begin(), other.second.end());
+					proxyTimings.insert(proxyTimings.end(), other.second.size(), timing);
+				}
+			}
+			auto& rateGroup = m_rateGroups[divider];
+			rateGroup.end = end;
+			rateGroup.state = updateRepresentations(dt * divider, group.second, proxies, proxyTimings,
+													divider == groups.rbegin()->first);
+		}
 	}
+	++m_numUpdates;
 
 	if (m_logger->getThreshold() <= SURGSIM_LOG_LEVEL(DEBUG))
 	{
@@ -151,15 +411,49 @@ bool PhysicsManager::doUpdate(double dt)
 		}
 	}
 
-	m_finalState.set(*(stateList.back()));
+	// The states are not modified after their update, they are shared rather than copied
+	std::vector<std::shared_ptr<PhysicsManagerState>> states;
+	for (const auto& rateGroup : m_rateGroups)
+	{
+		states.push_back(rateGroup.second.state);
+	}
+	m_finalStates.set(std::move(states));
 
 	return true;
 }
 
+std::shared_ptr<PhysicsManagerState> PhysicsManager::updateRepresentations(double dt,
+		const std::vector<std::shared_ptr<Representation>>& representations,
+		const std::vector<std::shared_ptr<Representation>>& proxies,
+		const std::vector<ProxyTiming>& proxyTimings,
+		bool doUpdateParticles)
+{
+	auto state = std::make_shared<PhysicsManagerState>();
+	std::list<std::shared_ptr<PhysicsManagerState>> stateList(1, state);
+	state->setRepresentations(representations);
+	state->setProxyRepresentations(proxies);
+	state->setProxyTimings(proxyTimings);
+	state->setCollisionRepresentations(m_collisionRepresentations);
+	state->setContactFilters(m_contactFilters);
+	if (doUpdateParticles)
+	{
+		state->setParticleRepresentations(m_particleRepresentations);
+	}
+	state->setConstraintComponents(m_constraintComponents);
+
+	for (const auto& computation : m_computations)
+	{
+		stateList.push_back(computation->update(dt, stateList.back()));
+	}
+
+	return stateList.back();
+}
+
 void PhysicsManager::doBeforeStop()
 {
 	// Empty the physics manager state
-	m_finalState.set(PhysicsManagerState());
+	m_finalStates.set(std::vector<std::shared_ptr<PhysicsManagerState>>());
+	m_rateGroups.clear();
 
 	// Give all known components a chance to untangle themselves
 	retireComponents(m_representations);
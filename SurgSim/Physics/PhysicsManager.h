@@ -18,7 +18,10 @@
 
 #include <boost/thread/mutex.hpp>
 
+#include <atomic>
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -56,6 +59,12 @@ class Computation;
 /// separate the algorithmic steps into smaller pieces.
 /// The PhysicsManager pipeline can be configured, using the
 /// addComputation/setComputaton method.
+/// The representations are grouped by rate divider (see Representation::setRateDivider()), the slower groups are
+/// updated first. When a group is updated, the representations of the other groups are proxies (see
+/// PhysicsManagerState::setProxyRepresentations()), they are not updated but they take part in the constraint
+/// resolution, using the state and compliance of their last update brought to the time step of the group. The
+/// compliance is scaled with the time step, so the constrained proxies must be dominated by their inertia (see
+/// Representation::isInertiaDominated()).
 class PhysicsManager : public SurgSim::Framework::ComponentManager
 {
 public:
@@ -70,6 +79,8 @@ class PhysicsManager : public SurgSim::Framework::ComponentManager
 	friend class PhysicsManagerTest;
 
 	/// Get the last PhysicsManagerState from the previous PhysicsManager update.
+	/// With several rate groups (see Representation::setRateDivider()), the last states of the groups are merged by
+	/// this call, so that the final state covers all the representations.
 	/// \param [out] s pointer to an allocated PhysicsManagerState object.
 	/// \warning The state contains many pointers.  The objects pointed to are not thread-safe.
 	void getFinalState(SurgSim::Physics::PhysicsManagerState* s) const;
@@ -84,6 +95,18 @@ class PhysicsManager : public SurgSim::Framework::ComponentManager
 	/// \param computations The computations that you want to set on the physics manager
 	void setComputations(std::vector<std::shared_ptr<Physics::Computation>> computations);
 
+	/// Set whether the DcdCollision computations reuse the contacts of the pairs that have not changed since the
+	/// previous frame, see DcdCollision::setContactCachingEnabled()
+	/// \param enabled Whether the contacts are cached (false by default)
+	void setContactCachingEnabled(bool enabled);
+
+	/// \return Whether the DcdCollision computations reuse the contacts of the unchanged pairs
+	bool isContactCachingEnabled() const;
+
+	/// \return The fraction of the discrete collision pairs whose contact calculation was skipped during the last
+	/// update, see DcdCollision::getSkippedPairsFraction(), 0 if there is no DcdCollision computation
+	double getSkippedPairsFraction() const;
+
 protected:
 	bool executeAdditions(const std::shared_ptr<SurgSim::Framework::Component>& component) override;
 
@@ -101,6 +124,19 @@ class PhysicsManager : public SurgSim::Framework::ComponentManager
 
 	void doBeforeStop() override;
 
+	/// Run the computations on a group of representations
+	/// \param dt The time step
+	/// \param representations The representations to update
+	/// \param proxies The representations that take part in the constraint resolution without being updated
+	/// \param proxyTimings The timings of the last updates of the proxies
+	/// \param doUpdateParticles Whether the particle representations are updated
+	/// \return The final state
+	std::shared_ptr<PhysicsManagerState> updateRepresentations(double dt,
+			const std::vector<std::shared_ptr<Representation>>& representations,
+			const std::vector<std::shared_ptr<Representation>>& proxies,
+			const std::vector<ProxyTiming>& proxyTimings,
+			bool doUpdateParticles);
+
 	std::vector<std::shared_ptr<Representation>> m_representations;
 
 	std::vector<std::shared_ptr<Collision::Representation>> m_collisionRepresentations;
@@ -115,8 +151,27 @@ class PhysicsManager : public SurgSim::Framework::ComponentManager
 	/// A list of computations, to perform the physics update.
 	std::vector<std::shared_ptr<SurgSim::Physics::Computation>> m_computations;
 
-	/// A thread-safe copy of the last PhysicsManagerState in the previous update.
-	SurgSim::Framework::LockedContainer<SurgSim::Physics::PhysicsManagerState> m_finalState;
+	/// Whether the DcdCollision computations cache their contacts
+	std::atomic<bool> m_contactCachingEnabled;
+
+	/// The number of updates, to schedule the rate groups
+	size_t m_numUpdates;
+
+	/// The last update of the representations with the same rate divider, see Representation::setRateDivider()
+	struct RateGroup
+	{
+		/// The manager update at which the last update of the group ends
+		size_t end;
+		/// The final state of the last update of the group
+		std::shared_ptr<PhysicsManagerState> state;
+	};
+
+	/// The last updates of the rate groups, by rate divider, the slowest group first
+	std::map<size_t, RateGroup, std::greater<size_t>> m_rateGroups;
+
+	/// A thread-safe copy of the last PhysicsManagerStates of the rate groups in the previous update, the slowest
+	/// group first
+	SurgSim::Framework::LockedContainer<std::vector<std::shared_ptr<PhysicsManagerState>>> m_finalStates;
 };
 
 /// Creates default DCD pipeline, this currently does basic DCD without regard to CCD
@@ -41,16 +41,44 @@ PhysicsManagerState::~PhysicsManagerState()
 void PhysicsManagerState::setRepresentations(const std::vector<std::shared_ptr<Representation>>& val)
 {
 	m_representations = val;
+	updateCollisionToPhysicsMap();
+}
+
+void PhysicsManagerState::setProxyRepresentations(const std::vector<std::shared_ptr<Representation>>& val)
+{
+	m_proxyRepresentations = val;
+	updateCollisionToPhysicsMap();
+}
+
+const std::vector<std::shared_ptr<Representation>>& PhysicsManagerState::getProxyRepresentations() const
+{
+	return m_proxyRepresentations;
+}
 
+void PhysicsManagerState::setProxyTimings(const std::vector<ProxyTiming>& val)
+{
+	m_proxyTimings = val;
+}
+
+const std::vector<ProxyTiming>& PhysicsManagerState::getProxyTimings() const
+{
+	return m_proxyTimings;
+}
+
+void PhysicsManagerState::updateCollisionToPhysicsMap()
+{
 	m_collisionsToPhysicsMap.clear();
-	for (auto it = m_representations.begin(); it != m_representations.end(); it++)
+	for (const auto* representations : {&m_representations, &m_proxyRepresentations})
 	{
-		if ((*it)->isActive())
+		for (auto it = representations->begin(); it != representations->end(); it++)
 		{
-			auto collision = (*it)->getCollisionRepresentation();
-			if (collision != nullptr)
+			if ((*it)->isActive())
 			{
-				m_collisionsToPhysicsMap[collision] = (*it);
+				auto collision = (*it)->getCollisionRepresentation();
+				if (collision != nullptr)
+				{
+					m_collisionsToPhysicsMap[collision] = (*it);
+				}
 			}
 		}
 	}
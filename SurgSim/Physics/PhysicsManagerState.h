@@ -45,6 +45,16 @@ enum ConstraintGroupType
 	CONSTRAINT_GROUP_TYPE_COUNT
 };
 
+/// The timing of the last update of a proxy representation, relative to the time step being computed
+struct ProxyTiming
+{
+	/// The time step of the last update of the proxy
+	double timeStep;
+	/// The time from the end of the last update of the proxy to the end of the time step being computed, negative
+	/// if the proxy is ahead
+	double timeOffset;
+};
+
 class PhysicsManagerState
 {
 public:
@@ -70,6 +80,26 @@ class PhysicsManagerState
 	/// \return	The active physics representations that are known to the state.
 	const std::vector<std::shared_ptr<Representation>>& getActiveRepresentations() const;
 
+	/// Sets the proxy representations, for multi-rate simulations. These representations are not updated by the
+	/// computations, but they take part in the constraint resolution with their current state and compliance, e.g.
+	/// a deformable that is updated at a lower rate, as seen from the representations updated at a higher rate.
+	/// \param val The list of proxy representations.
+	void setProxyRepresentations(const std::vector<std::shared_ptr<Representation>>& val);
+
+	/// Gets the proxy representations.
+	/// \return The proxy representations that are known to the state.
+	const std::vector<std::shared_ptr<Representation>>& getProxyRepresentations() const;
+
+	/// Sets the timings of the proxy representations, in the same order as the proxy representations. They are used
+	/// to bring the compliance and the constraint violations of the proxies to the time step being computed, without
+	/// timings the proxies are used as they are.
+	/// \param val The timings of the proxy representations.
+	void setProxyTimings(const std::vector<ProxyTiming>& val);
+
+	/// Gets the timings of the proxy representations.
+	/// \return The timings of the proxy representations, empty if they were not set.
+	const std::vector<ProxyTiming>& getProxyTimings() const;
+
 	/// Sets the collision representations for the state.
 	/// \param val collection of all collision representations.
 	void setCollisionRepresentations(const std::vector<std::shared_ptr<SurgSim::Collision::Representation>>& val);
@@ -199,6 +229,8 @@ class PhysicsManagerState
 	void setAbortGroup(bool val);
 
 private:
+	/// Build the mapping of the collision representations to the physics and proxy representations
+	void updateCollisionToPhysicsMap();
 
 	///@{
 	/// Local state data structures, please note that the physics state may get copied, these data structures
@@ -210,6 +242,12 @@ class PhysicsManagerState
 	/// The list of active representations.
 	std::vector<std::shared_ptr<Representation>> m_activeRepresentations;
 
+	/// The list of proxy representations.
+	std::vector<std::shared_ptr<Representation>> m_proxyRepresentations;
+
+	/// The timings of the proxy representations.
+	std::vector<ProxyTiming> m_proxyTimings;
+
 	/// List of all the collision representations known to the state
 	std::vector<std::shared_ptr<SurgSim::Collision::Representation>> m_collisionRepresentations;
 
@@ -13,6 +13,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <tuple>
+#include <unordered_set>
 #include <vector>
 
 #include "SurgSim/Collision/CollisionPair.h"
@@ -20,6 +22,7 @@
 #include "SurgSim/Framework/Log.h"
 #include "SurgSim/Physics/PhysicsManagerState.h"
 #include "SurgSim/Physics/PrepareCollisionPairs.h"
+#include "SurgSim/Physics/Representation.h"
 #include "SurgSim/Math/Aabb.h"
 
 namespace SurgSim
@@ -46,6 +49,28 @@ std::shared_ptr<PhysicsManagerState> PrepareCollisionPairs::doUpdate(
 	auto& representations = result->getActiveCollisionRepresentations();
 
 	std::vector<std::shared_ptr<Collision::CollisionPair>> pairs;
+	PairMap currentPairs;
+
+	// In multi-rate simulations, each rate group has its own pairs, so that the contacts of a group are not cleared by
+	// the update of another group. The pairs involving a proxy are only needed against an updated representation.
+	const size_t rateDivider = result->getRepresentations().empty() ?
+							   1 : result->getRepresentations().front()->getRateDivider();
+	PairMap& lastPairs = m_pairs[rateDivider];
+	std::unordered_set<const Collision::Representation*> proxies;
+	for (const auto& proxy : result->getProxyRepresentations())
+	{
+		proxies.insert(proxy->getCollisionRepresentation().get());
+	}
+	const auto& collisionToPhysicsMap = result->getCollisionToPhysicsMap();
+	auto isProxy = [&proxies](const std::shared_ptr<Collision::Representation>& representation)
+	{
+		return proxies.find(representation.get()) != proxies.end();
+	};
+	auto isUpdated = [&collisionToPhysicsMap, &isProxy](
+						 const std::shared_ptr<Collision::Representation>& representation)
+	{
+		return !isProxy(representation) && collisionToPhysicsMap.find(representation) != collisionToPhysicsMap.end();
+	};
 
 	auto end = std::end(representations);
 	for (auto first = std::begin(representations); first != end; ++first)
@@ -54,14 +79,40 @@ std::shared_ptr<PhysicsManagerState> PrepareCollisionPairs::doUpdate(
 		{
 			if (!(*first)->isIgnoring(*second) && !(*second)->isIgnoring(*first))
 			{
-				auto pair = std::make_shared<Collision::CollisionPair>(*first, *second);
+				// Reuse the pair from the last frame, unless the collision detection types have changed
+				const PairKey key((*first).get(), (*second).get());
+				if ((isProxy(*first) || isProxy(*second)) && !isUpdated(*first) && !isUpdated(*second))
+				{
+					continue;
+				}
+
+				const auto types = (first == second) ?
+								   std::make_pair((*first)->getSelfCollisionDetectionType(),
+												  (*first)->getSelfCollisionDetectionType()) :
+								   std::make_pair((*first)->getCollisionDetectionType(),
+												  (*second)->getCollisionDetectionType());
+				std::shared_ptr<Collision::CollisionPair> pair;
+				auto found = lastPairs.find(key);
+				if (found != lastPairs.end() && std::get<1>(found->second) == types.first &&
+					std::get<2>(found->second) == types.second)
+				{
+					pair = std::get<0>(found->second);
+					pair->clearContacts();
+				}
+				else
+				{
+					pair = std::make_shared<Collision::CollisionPair>(*first, *second);
+				}
+
 				if (pair->getType() != Collision::COLLISION_DETECTION_TYPE_NONE && pair->mayIntersect())
 				{
 					pairs.push_back(pair);
+					currentPairs.emplace(key, std::make_tuple(pair, types.first, types.second));
 				}
 			}
 		}
 	}
+	lastPairs = std::move(currentPairs);
 
 	result->setCollisionPairs(pairs);
 
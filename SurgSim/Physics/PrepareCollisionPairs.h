@@ -17,7 +17,13 @@
 #define SURGSIM_PHYSICS_PREPARECOLLISIONPAIRS_H
 
 #include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 
+#include <boost/functional/hash.hpp>
+
+#include "SurgSim/Collision/Representation.h"
 #include "SurgSim/Framework/Macros.h"
 #include "SurgSim/Physics/Computation.h"
 
@@ -26,6 +32,7 @@ namespace SurgSim
 
 namespace Collision
 {
+class CollisionPair;
 class ContactCalculation;
 }
 
@@ -40,10 +47,12 @@ class PhysicsManagerState;
 
 /// Computation to determine the contacts between a list of CollisionPairs.
 /// This Computation class takes a list of representations, it will generate a list of collision pairs
-/// from this list on every frame, for each CollisionPair, it uses a two dimensional table of
-/// function objects (ContactCalculation) to determine how to calculate a contact between the two
-/// members of each pair, if no specific function exists a default function will be used.
-/// will update the collision pairs accordingly.
+/// from this list on every frame. The pairs are kept from one frame to the next as long as their bounding boxes
+/// overlap, so that the contact calculations can reuse some data across the frames (e.g. the contact manifold, see
+/// CollisionPair::getContactManifold). In multi-rate simulations, the rate groups do not share their pairs. For each
+/// CollisionPair, it uses a two dimensional table of function objects (ContactCalculation) to determine how to
+/// calculate a contact between the two members of each pair, if no specific function exists a default function will
+/// be used. will update the collision pairs accordingly.
 /// \note When a new ContactCalculation type gets implemented, the type needs to be registered with the table
 /// inside of ContactCalculation
 class PrepareCollisionPairs : public Computation
@@ -63,6 +72,19 @@ class PrepareCollisionPairs : public Computation
 		override;
 
 private:
+	/// The key of a pair of representations
+	typedef std::pair<const Collision::Representation*, const Collision::Representation*> PairKey;
+
+	/// A collision pair, with the collision detection types of its representations when it was created
+	typedef std::tuple<std::shared_ptr<Collision::CollisionPair>, Collision::CollisionDetectionType,
+			Collision::CollisionDetectionType> PairEntry;
+
+	/// The collision pairs of a frame
+	typedef std::unordered_map<PairKey, PairEntry, boost::hash<PairKey>> PairMap;
+
+	/// The collision pairs of the last frame of each rate group, by rate divider (see Representation::setRateDivider)
+	std::unordered_map<size_t, PairMap> m_pairs;
+
 	/// The time since the collision pairs were last logged.
 	double m_timeSinceLog;
 
@@ -36,12 +36,14 @@ Representation::Representation(const std::string& name) :
 	m_gravity(0.0, -9.81, 0.0),
 	m_numDof(0),
 	m_isGravityEnabled(true),
-	m_isDrivingSceneElementPose(true)
+	m_isDrivingSceneElementPose(true),
+	m_rateDivider(1)
 {
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(Representation, size_t, NumDof, getNumDof, setNumDof);
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(Representation, bool, IsGravityEnabled, isGravityEnabled, setIsGravityEnabled);
 	SURGSIM_ADD_SERIALIZABLE_PROPERTY(Representation, bool, IsDrivingSceneElementPose,
 									  isDrivingSceneElementPose, setIsDrivingSceneElementPose);
+	SURGSIM_ADD_SERIALIZABLE_PROPERTY(Representation, size_t, RateDivider, getRateDivider, setRateDivider);
 }
 
 Representation::~Representation()
@@ -77,6 +79,19 @@ bool Representation::isDrivingSceneElementPose()
 	return m_isDrivingSceneElementPose;
 }
 
+void Representation::setRateDivider(size_t divider)
+{
+	SURGSIM_ASSERT(!isInitialized()) << "The rate divider of " << getFullName() <<
+		" can't be changed after initialization";
+	SURGSIM_ASSERT(divider > 0) << "The rate divider of " << getFullName() << " has to be positive";
+	m_rateDivider = divider;
+}
+
+size_t Representation::getRateDivider() const
+{
+	return m_rateDivider;
+}
+
 void Representation::beforeUpdate(double dt)
 {
 }
@@ -98,6 +113,16 @@ void Representation::applyCorrection(double dt, const Eigen::VectorBlock<SurgSim
 {
 }
 
+SurgSim::Math::Vector Representation::getDofVelocity() const
+{
+	return SurgSim::Math::Vector::Zero(getNumDof());
+}
+
+bool Representation::isInertiaDominated() const
+{
+	return false;
+}
+
 void Representation::setNumDof(size_t numDof)
 {
 	m_numDof = numDof;
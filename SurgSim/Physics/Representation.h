@@ -85,6 +85,15 @@ class Representation : public SurgSim::Framework::Representation
 	/// \return true if this Representation is controlling the pose of the SceneElement
 	bool isDrivingSceneElementPose();
 
+	/// Set the rate divider, for multi-rate simulations. The PhysicsManager groups the representations by rate
+	/// divider, each group is only updated every 'divider' updates of the manager, with a time step multiplied by
+	/// the divider. This can't be changed after initialization.
+	/// \param divider The rate divider, 1 (default) to be updated at the rate of the PhysicsManager
+	void setRateDivider(size_t divider);
+
+	/// \return The rate divider, see setRateDivider()
+	size_t getRateDivider() const;
+
 	/// Preprocessing done before the update call
 	/// This needs to be called from the outside usually from a Computation
 	/// \param dt The time step (in seconds)
@@ -113,6 +122,17 @@ class Representation : public SurgSim::Framework::Representation
 	/// \param deltaVelocity The block of a vector containing the correction to be applied to the velocity
 	virtual void applyCorrection(double dt, const Eigen::VectorBlock<SurgSim::Math::Vector>& deltaVelocity);
 
+	/// Get the velocity of the degrees of freedom, in the space of the constraint Jacobians and of applyCorrection()
+	/// \return The velocity of the degrees of freedom, zero by default
+	virtual SurgSim::Math::Vector getDofVelocity() const;
+
+	/// Whether the response of the representation over a time step is dominated by its inertia, so that its
+	/// compliance is proportional to the time step. Only such representations can take part in the constraint
+	/// resolution of a rate group that is not their own (see setRateDivider()), their compliance being scaled to the
+	/// time step of that group.
+	/// \return true if the compliance is proportional to the time step, false by default
+	virtual bool isInertiaDominated() const;
+
 	/// \return the collision representation for this physics representation.
 	std::shared_ptr<SurgSim::Collision::Representation> getCollisionRepresentation() const;
 
@@ -166,6 +186,9 @@ class Representation : public SurgSim::Framework::Representation
 
 	/// Is this representation driving the sceneElement pose
 	bool m_isDrivingSceneElementPose;
+
+	/// The rate divider, for multi-rate simulations
+	size_t m_rateDivider;
 };
 
 };  // namespace Physics
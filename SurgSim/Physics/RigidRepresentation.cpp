@@ -400,6 +400,18 @@ void RigidRepresentation::applyCorrection(double dt,
 	computeComplianceMatrix(dt);
 }
 
+SurgSim::Math::Vector RigidRepresentation::getDofVelocity() const
+{
+	SurgSim::Math::Vector velocity(6);
+	velocity << m_currentState.getLinearVelocity(), m_currentState.getAngularVelocity();
+	return velocity;
+}
+
+bool RigidRepresentation::isInertiaDominated() const
+{
+	return true;
+}
+
 const Eigen::Matrix <double, 6, 6, Eigen::RowMajor>&
 SurgSim::Physics::RigidRepresentation::getComplianceMatrix() const
 {
@@ -100,6 +100,10 @@ class RigidRepresentation : public RigidRepresentationBase
 
 	void applyCorrection(double dt, const Eigen::VectorBlock<SurgSim::Math::Vector>& deltaVelocity) override;
 
+	SurgSim::Math::Vector getDofVelocity() const override;
+
+	bool isInertiaDominated() const override;
+
 	/// Retrieve the rigid body 6x6 compliance matrix
 	/// \return the 6x6 compliance matrix
 	const SurgSim::Math::Matrix66d& getComplianceMatrix() const;
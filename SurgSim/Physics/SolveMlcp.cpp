@@ -15,6 +15,9 @@
 
 #include "SurgSim/Physics/SolveMlcp.h"
 
+#include <iomanip>
+#include <sstream>
+
 #include "SurgSim/Framework/Log.h"
 #include "SurgSim/Physics/Constraint.h"
 #include "SurgSim/Physics/ContactConstraintData.h"
@@ -25,7 +28,11 @@ namespace SurgSim
 namespace Physics
 {
 
-SolveMlcp::SolveMlcp(bool doCopyState) : Computation(doCopyState)
+SolveMlcp::SolveMlcp(bool doCopyState) :
+	Computation(doCopyState),
+	m_parallel(false),
+	m_capturePeriod(0),
+	m_captureCount(0)
 {
 }
 
@@ -37,8 +44,31 @@ std::shared_ptr<PhysicsManagerState> SolveMlcp::doUpdate(const double& dt,
 {
 	std::shared_ptr<PhysicsManagerState> result = state;
 
+	const auto& problem = result->getMlcpProblem();
+	if (m_capturePeriod > 0 && problem.getSize() > 0)
+	{
+		if (m_captureCount % m_capturePeriod == 0)
+		{
+			std::ostringstream fileName;
+			fileName << m_capturePrefix << std::setfill('0') << std::setw(6) << m_captureCount << ".mlcp";
+			if (!problem.save(fileName.str()))
+			{
+				SURGSIM_LOG_WARNING(Framework::Logger::getLogger("Physics/SolveMlcp")) <<
+					"Could not capture the MLCP problem to " << fileName.str();
+			}
+		}
+		++m_captureCount;
+	}
+
 	// Solve the Mlcp using a Gauss-Seidel solver
-	m_gaussSeidelSolver.solve(result->getMlcpProblem(), &(result->getMlcpSolution()));
+	if (m_parallel)
+	{
+		m_coloredGaussSeidelSolver.solve(result->getMlcpProblem(), &(result->getMlcpSolution()));
+	}
+	else
+	{
+		m_gaussSeidelSolver.solve(result->getMlcpProblem(), &(result->getMlcpSolution()));
+	}
 
 	// lambda
 	const Eigen::VectorXd& lambda = result->getMlcpSolution().x;
@@ -75,6 +105,7 @@ std::shared_ptr<PhysicsManagerState> SolveMlcp::doUpdate(const double& dt,
 void SolveMlcp::setMaxIterations(size_t maxIterations)
 {
 	m_gaussSeidelSolver.setMaxIterations(maxIterations);
+	m_coloredGaussSeidelSolver.setMaxIterations(maxIterations);
 }
 
 size_t SolveMlcp::getMaxIterations() const
@@ -85,6 +116,7 @@ size_t SolveMlcp::getMaxIterations() const
 void SolveMlcp::setPrecision(double epsilon)
 {
 	m_gaussSeidelSolver.setEpsilonConvergence(epsilon);
+	m_coloredGaussSeidelSolver.setEpsilonConvergence(epsilon);
 }
 
 double SolveMlcp::getPrecision() const
@@ -95,6 +127,7 @@ double SolveMlcp::getPrecision() const
 void SolveMlcp::setContactTolerance(double epsilon)
 {
 	m_gaussSeidelSolver.setContactTolerance(epsilon);
+	m_coloredGaussSeidelSolver.setContactTolerance(epsilon);
 }
 
 double SolveMlcp::getContactTolerance() const
@@ -102,5 +135,32 @@ double SolveMlcp::getContactTolerance() const
 	return m_gaussSeidelSolver.getContactTolerance();
 }
 
+void SolveMlcp::setParallel(bool parallel)
+{
+	m_parallel = parallel;
+}
+
+bool SolveMlcp::isParallel() const
+{
+	return m_parallel;
+}
+
+void SolveMlcp::setCapture(const std::string& prefix, size_t period)
+{
+	m_capturePrefix = prefix;
+	m_capturePeriod = period;
+	m_captureCount = 0;
+}
+
+const std::string& SolveMlcp::getCapturePrefix() const
+{
+	return m_capturePrefix;
+}
+
+size_t SolveMlcp::getCapturePeriod() const
+{
+	return m_capturePeriod;
+}
+
 }; // Physics
 }; // SurgSim
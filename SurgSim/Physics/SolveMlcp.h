@@ -17,8 +17,10 @@
 #define SURGSIM_PHYSICS_SOLVEMLCP_H
 
 #include <memory>
+#include <string>
 
 #include "SurgSim/Framework/Macros.h"
+#include "SurgSim/Math/MlcpColoredGaussSeidelSolver.h"
 #include "SurgSim/Math/MlcpGaussSeidelSolver.h"
 #include "SurgSim/Physics/Computation.h"
 
@@ -64,6 +66,27 @@ class SolveMlcp : public Computation
 	/// \return The contact tolerance.
 	double getContactTolerance() const;
 
+	/// Select the MLCP solver, the colored Gauss-Seidel solver updates the constraints not coupled with each other in
+	/// parallel on the runtime thread pool. \sa Math::MlcpColoredGaussSeidelSolver
+	/// \param parallel true to use the colored Gauss-Seidel solver, false (default) for the Gauss-Seidel solver
+	void setParallel(bool parallel);
+
+	/// \return true if the colored Gauss-Seidel solver is used
+	bool isParallel() const;
+
+	/// Capture the live problems to binary files, to replay them offline through any MlcpSolver (see the MlcpReplay
+	/// tool). Only the problems with constraints are counted, the files are named <prefix><index>.mlcp with the
+	/// index of the problem written on 6 digits. \sa Math::MlcpProblem::save()
+	/// \param prefix The prefix of the file names, e.g. a directory and a scene name
+	/// \param period Every period-th problem is written, starting with the first one, 0 disables the capture
+	void setCapture(const std::string& prefix, size_t period);
+
+	/// \return The prefix of the captured file names
+	const std::string& getCapturePrefix() const;
+
+	/// \return The period of the capture, 0 if it is disabled
+	size_t getCapturePeriod() const;
+
 protected:
 
 	/// Override doUpdate from superclass
@@ -77,6 +100,21 @@ class SolveMlcp : public Computation
 
 	/// The Gauss-Seidel Mlcp solver
 	SurgSim::Math::MlcpGaussSeidelSolver m_gaussSeidelSolver;
+
+	/// The colored Gauss-Seidel Mlcp solver
+	SurgSim::Math::MlcpColoredGaussSeidelSolver m_coloredGaussSeidelSolver;
+
+	/// True if the colored Gauss-Seidel solver is used
+	bool m_parallel;
+
+	/// The prefix of the captured file names
+	std::string m_capturePrefix;
+
+	/// The period of the capture, 0 if disabled
+	size_t m_capturePeriod;
+
+	/// The number of problems with constraints since the capture was set
+	size_t m_captureCount;
 };
 
 }; // Physics
@@ -136,6 +136,140 @@ TEST_F(BuildMlcpTests, TwoRepresentationsNoConstraintTest)
 			  m_physicsManagerState->getRepresentationsMapping().getValue(m_allRepresentations[1].get()));
 }
 
+TEST_F(BuildMlcpTests, OneRepresentationOneProxyOneConstraintTest)
+{
+	// Prep the list of representations: use 1 representation, and a proxy
+	m_usedRepresentations.push_back(m_allRepresentations[0]);
+	std::vector<std::shared_ptr<Representation>> proxies(1, m_allRepresentations[1]);
+	m_physicsManagerState->setRepresentations(m_usedRepresentations);
+	m_physicsManagerState->setProxyRepresentations(proxies);
+
+	// A constraint between the representation and the proxy
+	{
+		std::shared_ptr<ContactConstraintData> data = std::make_shared<ContactConstraintData>();
+		data->setPlaneEquation(SurgSim::Math::Vector3d(0.0, 1.0, 0.0), 0.0);
+
+		std::shared_ptr<Constraint> constraint = std::make_shared<Constraint>(SurgSim::Physics::FRICTIONLESS_3DCONTACT,
+			data, m_allRepresentations[0],
+			SurgSim::DataStructures::Location(SurgSim::Math::Vector3d::Zero()),
+			m_allRepresentations[1],
+			SurgSim::DataStructures::Location(SurgSim::Math::Vector3d::Zero()));
+		m_usedConstraints.push_back(constraint);
+	}
+	m_physicsManagerState->setConstraintGroup(CONSTRAINT_GROUP_TYPE_CONTACT, m_usedConstraints);
+
+	// Run the BuildMlcp computation...
+	m_buildMlcpComputation->update(dt, m_physicsManagerState);
+	MlcpPhysicsProblem& mlcpProblem = m_physicsManagerState->getMlcpProblem();
+	MlcpPhysicsSolution& mlcpSolution = m_physicsManagerState->getMlcpSolution();
+
+	// The proxy takes part in the Mlcp, after the updated representations
+	EXPECT_EQ(1u, mlcpProblem.getSize());
+	EXPECT_EQ(12, mlcpProblem.CHt.rows());
+	EXPECT_EQ(12, mlcpProblem.H.cols());
+	EXPECT_TRUE(mlcpProblem.isConsistent());
+	EXPECT_EQ(12, mlcpSolution.dofCorrection.rows());
+
+	// Both representations contribute to the constraint compliance
+	EXPECT_LT(0.0, mlcpProblem.A(0, 0));
+	EXPECT_FALSE(Eigen::MatrixXd(mlcpProblem.H).block(0, 0, 1, 6).isZero());
+	EXPECT_FALSE(Eigen::MatrixXd(mlcpProblem.H).block(0, 6, 1, 6).isZero());
+
+	EXPECT_EQ(0, m_physicsManagerState->getRepresentationsMapping().getValue(m_allRepresentations[0].get()));
+	EXPECT_EQ(static_cast<int>(m_allRepresentations[0]->getNumDof()),
+			  m_physicsManagerState->getRepresentationsMapping().getValue(m_allRepresentations[1].get()));
+}
+
+TEST_F(BuildMlcpTests, ProxyTimingsTest)
+{
+	m_usedRepresentations.push_back(m_allRepresentations[0]);
+	std::vector<std::shared_ptr<Representation>> proxies(1, m_allRepresentations[1]);
+	m_physicsManagerState->setRepresentations(m_usedRepresentations);
+	m_physicsManagerState->setProxyRepresentations(proxies);
+	auto proxy = std::static_pointer_cast<RigidRepresentation>(m_allRepresentations[1]);
+	proxy->setLinearVelocity(SurgSim::Math::Vector3d(0.1, 0.2, 0.3));
+	proxy->setAngularVelocity(SurgSim::Math::Vector3d(0.4, 0.5, 0.6));
+
+	std::shared_ptr<ContactConstraintData> data = std::make_shared<ContactConstraintData>();
+	data->setPlaneEquation(SurgSim::Math::Vector3d(0.0, 1.0, 0.0), 0.0);
+	m_usedConstraints.push_back(std::make_shared<Constraint>(SurgSim::Physics::FRICTIONLESS_3DCONTACT,
+		data, m_allRepresentations[0], SurgSim::DataStructures::Location(SurgSim::Math::Vector3d(0.0, 0.01, 0.0)),
+		m_allRepresentations[1], SurgSim::DataStructures::Location(SurgSim::Math::Vector3d(0.0, -0.01, 0.0))));
+	m_physicsManagerState->setConstraintGroup(CONSTRAINT_GROUP_TYPE_CONTACT, m_usedConstraints);
+
+	m_buildMlcpComputation->update(dt, m_physicsManagerState);
+	const MlcpPhysicsProblem expected = m_physicsManagerState->getMlcpProblem();
+
+	// The proxy was updated with a time step 4 times larger, which ends 3 time steps ahead
+	ProxyTiming timing;
+	timing.timeStep = 4.0 * dt;
+	timing.timeOffset = -3.0 * dt;
+	m_physicsManagerState->setProxyTimings(std::vector<ProxyTiming>(1, timing));
+	m_buildMlcpComputation->update(dt, m_physicsManagerState);
+	const MlcpPhysicsProblem& mlcpProblem = m_physicsManagerState->getMlcpProblem();
+
+	const Eigen::MatrixXd H = expected.H;
+	EXPECT_TRUE(H.isApprox(Eigen::MatrixXd(mlcpProblem.H)));
+	EXPECT_TRUE(expected.CHt.topRows(6).isApprox(mlcpProblem.CHt.topRows(6)));
+	EXPECT_TRUE((0.25 * expected.CHt.bottomRows(6)).isApprox(mlcpProblem.CHt.bottomRows(6)));
+	EXPECT_TRUE((H * mlcpProblem.CHt).isApprox(mlcpProblem.A));
+	EXPECT_NEAR(expected.b[0] - 3.0 * H.rightCols(6).row(0).dot(proxy->getDofVelocity()), mlcpProblem.b[0], 1e-12);
+
+	m_physicsManagerState->setProxyTimings(std::vector<ProxyTiming>(2, timing));
+	EXPECT_THROW(m_buildMlcpComputation->update(dt, m_physicsManagerState), SurgSim::Framework::AssertionFailure);
+}
+
+namespace
+{
+/// A rigid representation whose compliance is not considered proportional to the time step
+class StiffRigidRepresentation : public RigidRepresentation
+{
+public:
+	explicit StiffRigidRepresentation(const std::string& name) : RigidRepresentation(name) {}
+
+	bool isInertiaDominated() const override
+	{
+		return false;
+	}
+};
+}
+
+TEST_F(BuildMlcpTests, ProxyNotInertiaDominatedTest)
+{
+	ConstraintImplementation::getFactory().addImplementation(typeid(StiffRigidRepresentation),
+			std::make_shared<RigidConstraintFrictionlessContact>());
+	auto proxy = std::make_shared<StiffRigidRepresentation>("Proxy");
+	proxy->setShape(std::make_shared<SphereShape>(1e-2));
+	proxy->setDensity(1000);
+	proxy->setIsGravityEnabled(false);
+	proxy->beforeUpdate(dt);
+	proxy->update(dt);
+	proxy->afterUpdate(dt);
+
+	m_usedRepresentations.push_back(m_allRepresentations[0]);
+	m_physicsManagerState->setRepresentations(m_usedRepresentations);
+	m_physicsManagerState->setProxyRepresentations(std::vector<std::shared_ptr<Representation>>(1, proxy));
+
+	std::shared_ptr<ContactConstraintData> data = std::make_shared<ContactConstraintData>();
+	data->setPlaneEquation(SurgSim::Math::Vector3d(0.0, 1.0, 0.0), 0.0);
+	m_usedConstraints.push_back(std::make_shared<Constraint>(SurgSim::Physics::FRICTIONLESS_3DCONTACT,
+		data, m_allRepresentations[0], SurgSim::DataStructures::Location(SurgSim::Math::Vector3d::Zero()),
+		proxy, SurgSim::DataStructures::Location(SurgSim::Math::Vector3d::Zero())));
+	m_physicsManagerState->setConstraintGroup(CONSTRAINT_GROUP_TYPE_CONTACT, m_usedConstraints);
+
+	// At the time step of its own update, the compliance of the proxy is used as is
+	ProxyTiming timing;
+	timing.timeStep = dt;
+	timing.timeOffset = 0.0;
+	m_physicsManagerState->setProxyTimings(std::vector<ProxyTiming>(1, timing));
+	EXPECT_NO_THROW(m_buildMlcpComputation->update(dt, m_physicsManagerState));
+
+	// It can't be scaled to another time step
+	timing.timeStep = 4.0 * dt;
+	m_physicsManagerState->setProxyTimings(std::vector<ProxyTiming>(1, timing));
+	EXPECT_THROW(m_buildMlcpComputation->update(dt, m_physicsManagerState), SurgSim::Framework::AssertionFailure);
+}
+
 TEST_F(BuildMlcpTests, OneRepresentationOneConstraintTest)
 {
 	// Prep the list of representations: use only 1 rigid representation + 1 fixed
@@ -22,6 +22,7 @@
 #include "SurgSim/Blocks/MassSpring3DRepresentation.h"
 #include "SurgSim/Physics/Fem1DRepresentation.h"
 #include "SurgSim/Physics/Fem2DRepresentation.h"
+#include "SurgSim/Physics/Fem3DModalRepresentation.h"
 #include "SurgSim/Physics/Fem3DRepresentation.h"
 #include "SurgSim/Physics/FixedConstraintFrictionlessContact.h"
 #include "SurgSim/Physics/FixedRepresentation.h"
@@ -58,6 +59,14 @@ TEST(ConstraintImplementationFactoryTest, GetImplementationTest)
 		!= nullptr);
 	EXPECT_TRUE(factory.getImplementation(typeid(Fem3DRepresentation), FRICTIONLESS_SLIDING)
 		!= nullptr);
+	EXPECT_TRUE(factory.getImplementation(typeid(Fem3DModalRepresentation), FRICTIONLESS_3DCONTACT)
+		!= nullptr);
+	EXPECT_TRUE(factory.getImplementation(typeid(Fem3DModalRepresentation), FIXED_3DPOINT)
+		!= nullptr);
+	EXPECT_TRUE(factory.getImplementation(typeid(Fem3DModalRepresentation), FRICTIONLESS_SLIDING)
+		!= nullptr);
+	EXPECT_TRUE(factory.getImplementation(typeid(Fem3DModalRepresentation), FRICTIONAL_SLIDING)
+		!= nullptr);
 
 	EXPECT_TRUE(factory.getImplementation(typeid(MassSpringRepresentation), FRICTIONLESS_3DCONTACT)
 		!= nullptr);
@@ -120,5 +120,62 @@ TEST(DcdCollisionTest, Deactivate)
 	runtime->stop();
 }
 
+TEST(DcdCollisionTest, ContactCachingTest)
+{
+	auto runtime = std::make_shared<Framework::Runtime>();
+
+	auto sphere1 = std::make_shared<Collision::ShapeCollisionRepresentation>("Sphere1");
+	sphere1->setShape(std::make_shared<Math::SphereShape>(1.0));
+	auto sphere2 = std::make_shared<Collision::ShapeCollisionRepresentation>("Sphere2");
+	sphere2->setShape(std::make_shared<Math::SphereShape>(1.0));
+	sphere2->setLocalPose(Math::makeRigidTranslation(Vector3d(0.0, 0.0, 0.5)));
+
+	auto element = std::make_shared<Framework::BasicSceneElement>("Element");
+	element->addComponent(sphere1);
+	element->addComponent(sphere2);
+	runtime->getScene()->addSceneElement(element);
+
+	std::vector<std::shared_ptr<Collision::Representation>> collisionRepresentations;
+	collisionRepresentations.push_back(sphere1);
+	collisionRepresentations.push_back(sphere2);
+
+	auto prepareCollisionPairs = std::make_shared<PrepareCollisionPairs>(false);
+	auto dcdCollision = std::make_shared<DcdCollision>(false);
+	EXPECT_FALSE(dcdCollision->isContactCachingEnabled());
+	dcdCollision->setContactCachingEnabled(true);
+	EXPECT_TRUE(dcdCollision->isContactCachingEnabled());
+	auto update = [&]()
+	{
+		auto state = std::make_shared<PhysicsManagerState>();
+		state->setCollisionRepresentations(collisionRepresentations);
+		return dcdCollision->update(1.0, prepareCollisionPairs->update(1.0, state));
+	};
+
+	auto state = update();
+	ASSERT_EQ(1u, state->getCollisionPairs().size());
+	ASSERT_EQ(1u, state->getCollisionPairs()[0]->getContacts().size());
+	const double depth = state->getCollisionPairs()[0]->getContacts().front()->depth;
+	EXPECT_DOUBLE_EQ(0.0, dcdCollision->getSkippedPairsFraction());
+
+	// Nothing has moved, the contacts are reused
+	state = update();
+	ASSERT_EQ(1u, state->getCollisionPairs()[0]->getContacts().size());
+	EXPECT_DOUBLE_EQ(depth, state->getCollisionPairs()[0]->getContacts().front()->depth);
+	EXPECT_DOUBLE_EQ(1.0, dcdCollision->getSkippedPairsFraction());
+
+	// One sphere moves, the contacts are recalculated
+	sphere2->setLocalPose(Math::makeRigidTranslation(Vector3d(0.0, 0.0, 1.0)));
+	state = update();
+	ASSERT_EQ(1u, state->getCollisionPairs()[0]->getContacts().size());
+	EXPECT_NEAR(depth - 0.5, state->getCollisionPairs()[0]->getContacts().front()->depth, 1e-10);
+	EXPECT_DOUBLE_EQ(0.0, dcdCollision->getSkippedPairsFraction());
+
+	// Without caching, the contacts are always recalculated
+	dcdCollision->setContactCachingEnabled(false);
+	state = update();
+	ASSERT_EQ(1u, state->getCollisionPairs()[0]->getContacts().size());
+	EXPECT_DOUBLE_EQ(0.0, dcdCollision->getSkippedPairsFraction());
+}
+
 };
 };
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 
+#include "SurgSim/DataStructures/AabbTree.h"
 #include "SurgSim/Framework/ApplicationData.h"
 #include "SurgSim/Framework/FrameworkConvert.h"
 #include "SurgSim/Framework/Runtime.h"
@@ -147,5 +148,65 @@ TEST_F(DeformableCollisionRepresentationTest, UpdateAndInitializationTest)
 	EXPECT_TRUE(m_deformableCollisionRepresentation->isActive());
 }
 
+TEST_F(DeformableCollisionRepresentationTest, UpdateToleranceTest)
+{
+	EXPECT_DOUBLE_EQ(0.0, m_deformableCollisionRepresentation->getUpdateTolerance());
+	EXPECT_THROW(m_deformableCollisionRepresentation->setUpdateTolerance(-1.0), Framework::AssertionFailure);
+	m_deformableCollisionRepresentation->setValue("UpdateTolerance", 0.01);
+	EXPECT_DOUBLE_EQ(0.01, m_deformableCollisionRepresentation->getValue<double>("UpdateTolerance"));
+
+	auto fem3DRepresentation = std::make_shared<SurgSim::Physics::Fem3DRepresentation>("Fem3DRepresentation");
+	fem3DRepresentation->loadFem(m_filename);
+	ASSERT_TRUE(fem3DRepresentation->initialize(m_runtime));
+	fem3DRepresentation->setCollisionRepresentation(m_deformableCollisionRepresentation);
+	m_deformableCollisionRepresentation->setShape(m_meshShape);
+	ASSERT_TRUE(m_deformableCollisionRepresentation->initialize(m_runtime));
+	ASSERT_TRUE(m_deformableCollisionRepresentation->wakeUp());
+
+	auto state = fem3DRepresentation->getCurrentState();
+	m_deformableCollisionRepresentation->updateShapeData();
+	const Math::Vector3d initial = m_meshShape->getVertexPosition(0);
+	const size_t version = m_deformableCollisionRepresentation->getShapeVersion();
+
+	// Nodes moving less than the tolerance are not updated, the shape did not change
+	state->getPositions().segment<3>(0) += Math::Vector3d(0.005, 0.0, 0.0);
+	m_deformableCollisionRepresentation->updateShapeData();
+	EXPECT_TRUE(initial.isApprox(m_meshShape->getVertexPosition(0)));
+	EXPECT_EQ(version, m_deformableCollisionRepresentation->getShapeVersion());
+
+	// Once they moved farther than the tolerance, their vertex, normals and bounding boxes are updated
+	state->getPositions().segment<3>(0) += Math::Vector3d(0.01, 0.0, 0.0);
+	m_deformableCollisionRepresentation->updateShapeData();
+	EXPECT_TRUE(state->getPosition(0).isApprox(m_meshShape->getVertexPosition(0)));
+	EXPECT_NE(version, m_deformableCollisionRepresentation->getShapeVersion());
+	EXPECT_TRUE(m_meshShape->getBoundingBox().contains(state->getPosition(0)));
+	EXPECT_TRUE(m_meshShape->getAabbTree()->getAabb().contains(state->getPosition(0)));
+}
+
+TEST_F(DeformableCollisionRepresentationTest, SweptAabbTreeTest)
+{
+	auto fem3DRepresentation = std::make_shared<SurgSim::Physics::Fem3DRepresentation>("Fem3DRepresentation");
+	fem3DRepresentation->loadFem(m_filename);
+	ASSERT_TRUE(fem3DRepresentation->initialize(m_runtime));
+	fem3DRepresentation->setCollisionRepresentation(m_deformableCollisionRepresentation);
+	m_deformableCollisionRepresentation->setCollisionDetectionType(Collision::COLLISION_DETECTION_TYPE_CONTINUOUS);
+	m_deformableCollisionRepresentation->setShape(m_meshShape);
+	ASSERT_TRUE(m_deformableCollisionRepresentation->initialize(m_runtime));
+	ASSERT_TRUE(m_deformableCollisionRepresentation->wakeUp());
+	EXPECT_EQ(nullptr, m_meshShape->getSweptAabbTree());
+
+	// The swept tree is built once, and refit in the following updates
+	auto state = fem3DRepresentation->getCurrentState();
+	m_deformableCollisionRepresentation->updateShapeData();
+	m_deformableCollisionRepresentation->updateCcdData(1.0);
+	auto tree = m_meshShape->getSweptAabbTree();
+	ASSERT_NE(nullptr, tree);
+
+	state->getPositions().segment<3>(0) += Math::Vector3d(1.0, 0.0, 0.0);
+	m_deformableCollisionRepresentation->updateCcdData(1.0);
+	EXPECT_EQ(tree, m_meshShape->getSweptAabbTree());
+	EXPECT_TRUE(tree->getAabb().contains(state->getPosition(0)));
+}
+
 } // namespace Physics
 } // namespace SurgSim
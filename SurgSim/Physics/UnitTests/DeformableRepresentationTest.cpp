@@ -163,6 +163,21 @@ TEST_F(DeformableRepresentationTest, SetGetTest)
 	}
 	setLinearSolver(SurgSim::Math::LINEARSOLVER_CONJUGATEGRADIENT);
 
+	/// Set/Get the preconditioned conjugate gradient settings
+	EXPECT_EQ(SurgSim::Math::PRECONDITIONER_BLOCK_JACOBI, getPcgPreconditioner());
+	setPcgPreconditioner(SurgSim::Math::PRECONDITIONER_INCOMPLETE_CHOLESKY);
+	EXPECT_EQ(SurgSim::Math::PRECONDITIONER_INCOMPLETE_CHOLESKY, getPcgPreconditioner());
+	EXPECT_DOUBLE_EQ(1.0e-6, getPcgTolerance());
+	setPcgTolerance(1.0e-4);
+	EXPECT_DOUBLE_EQ(1.0e-4, getPcgTolerance());
+	EXPECT_THROW(setPcgTolerance(-1.0), SurgSim::Framework::AssertionFailure);
+	EXPECT_EQ(100u, getPcgMaxIterations());
+	setPcgMaxIterations(20);
+	EXPECT_EQ(20u, getPcgMaxIterations());
+	EXPECT_TRUE(isPcgWarmStarting());
+	setPcgWarmStart(false);
+	EXPECT_FALSE(isPcgWarmStarting());
+
 	initialize(std::make_shared<SurgSim::Framework::Runtime>());
 
 	EXPECT_NE(nullptr, getOdeSolver());
@@ -172,6 +187,11 @@ TEST_F(DeformableRepresentationTest, SetGetTest)
 	EXPECT_THROW(setIntegrationScheme(SurgSim::Math::INTEGRATIONSCHEME_EULER_EXPLICIT),
 		SurgSim::Framework::AssertionFailure);
 	EXPECT_THROW(setLinearSolver(SurgSim::Math::LINEARSOLVER_LU), SurgSim::Framework::AssertionFailure);
+	EXPECT_THROW(setPcgPreconditioner(SurgSim::Math::PRECONDITIONER_BLOCK_JACOBI),
+				 SurgSim::Framework::AssertionFailure);
+	EXPECT_THROW(setPcgTolerance(1.0e-6), SurgSim::Framework::AssertionFailure);
+	EXPECT_THROW(setPcgMaxIterations(100), SurgSim::Framework::AssertionFailure);
+	EXPECT_THROW(setPcgWarmStart(true), SurgSim::Framework::AssertionFailure);
 
 	wakeUp();
 
@@ -525,6 +545,27 @@ TEST_F(DeformableRepresentationTest, DoWakeUpTest)
 	ASSERT_EQ(nullptr, staticLinearSolver);
 }
 
+TEST_F(DeformableRepresentationTest, PcgSettingsTest)
+{
+	setInitialState(m_localInitialState);
+	setLinearSolver(SurgSim::Math::LINEARSOLVER_PRECONDITIONEDCONJUGATEGRADIENT);
+	setPcgPreconditioner(SurgSim::Math::PRECONDITIONER_INCOMPLETE_CHOLESKY);
+	setPcgTolerance(1.0e-4);
+	setPcgMaxIterations(20);
+	setPcgWarmStart(false);
+
+	EXPECT_NO_THROW(EXPECT_TRUE(initialize(std::make_shared<SurgSim::Framework::Runtime>())));
+
+	auto linearSolver =
+		std::dynamic_pointer_cast<SurgSim::Math::LinearSparseSolveAndInversePCG>(getOdeSolver()->getLinearSolver());
+	ASSERT_NE(nullptr, linearSolver);
+	EXPECT_EQ(SurgSim::Math::PRECONDITIONER_INCOMPLETE_CHOLESKY, linearSolver->getPreconditioner());
+	EXPECT_EQ(getNumDofPerNode(), linearSolver->getBlockSize());
+	EXPECT_DOUBLE_EQ(1.0e-4, linearSolver->getTolerance());
+	EXPECT_EQ(20, linearSolver->getMaxIterations());
+	EXPECT_FALSE(linearSolver->isWarmStarting());
+}
+
 TEST_F(DeformableRepresentationTest, SerializationTest)
 {
 	{
@@ -542,7 +583,7 @@ TEST_F(DeformableRepresentationTest, SerializationTest)
 		EXPECT_EQ(1u, node.size());
 
 		YAML::Node data = node["SurgSim::Physics::MockDeformableRepresentation"];
-		EXPECT_EQ(10u, data.size());
+		EXPECT_EQ(15u, data.size());
 
 		std::shared_ptr<MockDeformableRepresentation> newRepresentation;
 		newRepresentation = std::dynamic_pointer_cast<MockDeformableRepresentation>
@@ -559,5 +600,8 @@ TEST_F(DeformableRepresentationTest, SerializationTest)
 		EXPECT_EQ(newRepresentation, newDeformableCollisionRepresentation->getDeformableRepresentation());
 		EXPECT_EQ(SurgSim::Math::INTEGRATIONSCHEME_LINEAR_STATIC,
 				  newRepresentation->getValue<SurgSim::Math::IntegrationScheme>("IntegrationScheme"));
+		EXPECT_EQ(SurgSim::Math::PRECONDITIONER_BLOCK_JACOBI,
+				  newRepresentation->getValue<SurgSim::Math::PcgPreconditioner>("PcgPreconditioner"));
+		EXPECT_EQ(100u, newRepresentation->getValue<size_t>("PcgMaxIterations"));
 	}
 }
@@ -16,10 +16,14 @@
 /// \file Fem1DRepresentationTests.cpp
 /// This file tests the functionalities of the class Fem1DRepresentation.
 
+#include <array>
+
 #include <gtest/gtest.h>
 
 #include "SurgSim/Framework/FrameworkConvert.h"
 #include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Math/LinearSparseSolveAndInverse.h"
+#include "SurgSim/Math/OdeSolver.h"
 #include "SurgSim/Math/Quaternion.h"
 #include "SurgSim/Math/RigidTransform.h"
 #include "SurgSim/Math/Vector.h"
@@ -406,6 +410,74 @@ TEST(Fem1DRepresentationTests, SerializationTest)
 	EXPECT_EQ(filename, newRepresentation->getFem()->getValue<std::string>("FileName"));
 }
 
+namespace
+{
+/// Create a straight beam made of numNodes - 1 beam elements, clamped on its first node
+std::shared_ptr<Fem1DRepresentation> createClampedBeam(const std::string& name, size_t numNodes)
+{
+	auto fem = std::make_shared<Fem1DRepresentation>(name);
+	auto initialState = std::make_shared<SurgSim::Math::OdeState>();
+	initialState->setNumDof(fem->getNumDofPerNode(), numNodes);
+	for (size_t nodeId = 0; nodeId < numNodes; ++nodeId)
+	{
+		initialState->getPositions().segment<3>(fem->getNumDofPerNode() * nodeId) =
+			SurgSim::Math::Vector3d(0.01 * static_cast<double>(nodeId), 0.0, 0.0);
+	}
+	for (size_t dof = 0; dof < fem->getNumDofPerNode(); ++dof)
+	{
+		initialState->addBoundaryCondition(0, dof);
+	}
+	fem->setInitialState(initialState);
+
+	for (size_t nodeId = 0; nodeId < numNodes - 1; ++nodeId)
+	{
+		std::array<size_t, 2> nodeIds = {{nodeId, nodeId + 1}};
+		auto beam = std::make_shared<Fem1DElementBeam>(nodeIds);
+		beam->setRadius(0.001);
+		beam->setMassDensity(3000.0);
+		beam->setPoissonRatio(0.45);
+		beam->setYoungModulus(1e7);
+		fem->addFemElement(beam);
+	}
+	fem->setIntegrationScheme(SurgSim::Math::INTEGRATIONSCHEME_EULER_IMPLICIT);
+
+	return fem;
+}
+};
+
+TEST(Fem1DRepresentationTests, TriDiagonalBlockLinearSolverTest)
+{
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>();
+	const double dt = 1e-3;
+
+	auto reference = createClampedBeam("Reference", 30);
+	reference->setLinearSolver(SurgSim::Math::LINEARSOLVER_LU);
+	ASSERT_TRUE(reference->initialize(runtime));
+	ASSERT_TRUE(reference->wakeUp());
+
+	auto fem = createClampedBeam("TriDiagonalBlock", 30);
+	fem->setLinearSolver(SurgSim::Math::LINEARSOLVER_TRIDIAGONALBLOCK);
+	ASSERT_TRUE(fem->initialize(runtime));
+	ASSERT_TRUE(fem->wakeUp());
+
+	for (int step = 0; step < 5; ++step)
+	{
+		reference->update(dt);
+		fem->update(dt);
+	}
+
+	auto linearSolver = std::dynamic_pointer_cast<SurgSim::Math::LinearSparseSolveAndInverseTriDiagonalBlock>(
+		fem->getOdeSolver()->getLinearSolver());
+	ASSERT_NE(nullptr, linearSolver);
+	EXPECT_EQ(fem->getNumDofPerNode(), linearSolver->getBlockSize());
+	EXPECT_EQ(1u, linearSolver->getBandwidth());
+
+	ASSERT_FALSE(fem->getCurrentState()->getPositions().isApprox(fem->getInitialState()->getPositions()));
+	EXPECT_TRUE(fem->getCurrentState()->getPositions().isApprox(reference->getCurrentState()->getPositions()));
+	EXPECT_TRUE(fem->getCurrentState()->getVelocities().isApprox(reference->getCurrentState()->getVelocities()));
+	EXPECT_TRUE(fem->getComplianceMatrix().isApprox(reference->getComplianceMatrix()));
+}
+
 } // namespace Physics
 
 } // namespace SurgSim
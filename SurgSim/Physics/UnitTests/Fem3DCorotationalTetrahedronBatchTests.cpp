@@ -0,0 +1,256 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "SurgSim/Framework/Assert.h"
+#include "SurgSim/Math/Matrix.h"
+#include "SurgSim/Math/OdeEquation.h"
+#include "SurgSim/Math/OdeState.h"
+#include "SurgSim/Math/Quaternion.h"
+#include "SurgSim/Math/Vector.h"
+#include "SurgSim/Physics/Fem3DCorotationalTetrahedronBatch.h"
+#include "SurgSim/Physics/Fem3DElementCorotationalTetrahedron.h"
+
+using SurgSim::Math::Matrix33d;
+using SurgSim::Math::Vector;
+using SurgSim::Math::Vector3d;
+
+namespace
+{
+const double epsilon = 1e-8;
+
+/// The 6 tetrahedra of a cube, its corners being indexed by their (x, y, z) bits
+const std::array<std::array<size_t, 4>, 6> cubeTetrahedra = {{
+		{{0, 1, 3, 7}}, {{0, 1, 5, 7}}, {{0, 2, 3, 7}}, {{0, 2, 6, 7}}, {{0, 4, 5, 7}}, {{0, 4, 6, 7}}
+	}
+};
+}
+
+namespace SurgSim
+{
+
+namespace Physics
+{
+
+class Fem3DCorotationalTetrahedronBatchTests : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		// A 3x1x1 lattice of cubes, i.e. 18 tetrahedra, which does not fill the last packet
+		const size_t numCubes[3] = {3, 1, 1};
+		const size_t numNodes[3] = {numCubes[0] + 1, numCubes[1] + 1, numCubes[2] + 1};
+		m_restState.setNumDof(3, numNodes[0] * numNodes[1] * numNodes[2]);
+		for (size_t k = 0; k < numNodes[2]; ++k)
+		{
+			for (size_t j = 0; j < numNodes[1]; ++j)
+			{
+				for (size_t i = 0; i < numNodes[0]; ++i)
+				{
+					const size_t nodeId = i + numNodes[0] * (j + numNodes[1] * k);
+					m_restState.getPositions().segment<3>(3 * nodeId) = 0.1 * Vector3d(i, j, k);
+				}
+			}
+		}
+
+		for (size_t k = 0; k < numCubes[2]; ++k)
+		{
+			for (size_t j = 0; j < numCubes[1]; ++j)
+			{
+				for (size_t i = 0; i < numCubes[0]; ++i)
+				{
+					for (const auto& tetrahedron : cubeTetrahedra)
+					{
+						std::array<size_t, 4> nodeIds;
+						for (size_t node = 0; node < 4; ++node)
+						{
+							const size_t corner = tetrahedron[node];
+							const size_t nodeI = i + (corner & 1);
+							const size_t nodeJ = j + ((corner >> 1) & 1);
+							const size_t nodeK = k + (corner >> 2);
+							nodeIds[node] = nodeI + numNodes[0] * (nodeJ + numNodes[1] * nodeK);
+						}
+						addElement(nodeIds);
+					}
+				}
+			}
+		}
+
+		// Rotate, translate and deform the lattice
+		m_rotation = SurgSim::Math::makeRotationMatrix(1.2, Vector3d(1.0, 2.0, -0.5).normalized());
+		m_state = m_restState;
+		for (size_t nodeId = 0; nodeId < m_state.getNumNodes(); ++nodeId)
+		{
+			Vector3d p = m_restState.getPosition(nodeId);
+			Vector3d deformation(0.02 * std::sin(10.0 * p[1]), -0.01 * p[0], 0.03 * p[0] * p[2]);
+			m_state.getPositions().segment<3>(3 * nodeId) =
+				m_rotation * (p + deformation) + Vector3d(0.3, -0.2, 1.0);
+		}
+	}
+
+	void addElement(std::array<size_t, 4> nodeIds)
+	{
+		Vector3d a = m_restState.getPosition(nodeIds[0]);
+		Vector3d b = m_restState.getPosition(nodeIds[1]);
+		Vector3d c = m_restState.getPosition(nodeIds[2]);
+		Vector3d d = m_restState.getPosition(nodeIds[3]);
+		if ((b - a).cross(c - a).dot(d - a) < 0.0)
+		{
+			std::swap(nodeIds[2], nodeIds[3]);
+		}
+
+		auto element = std::make_shared<Fem3DElementCorotationalTetrahedron>(nodeIds);
+		element->setMassDensity(1000.0);
+		element->setPoissonRatio(0.45);
+		element->setYoungModulus(1e6);
+		element->initialize(m_restState);
+		m_elements.push_back(element);
+	}
+
+protected:
+	SurgSim::Math::OdeState m_restState;
+	SurgSim::Math::OdeState m_state;
+	Matrix33d m_rotation;
+	std::vector<std::shared_ptr<Fem3DElementCorotationalTetrahedron>> m_elements;
+};
+
+TEST_F(Fem3DCorotationalTetrahedronBatchTests, InitializeTest)
+{
+	Fem3DCorotationalTetrahedronBatch batch;
+	EXPECT_EQ(0u, batch.getNumElements());
+	EXPECT_EQ(20u, batch.getMaxRotationIterations());
+	batch.setMaxRotationIterations(5);
+	EXPECT_EQ(5u, batch.getMaxRotationIterations());
+
+	ASSERT_NO_THROW(batch.initialize(m_elements, m_restState));
+	EXPECT_EQ(m_elements.size(), batch.getNumElements());
+	EXPECT_NE(0u, m_elements.size() % Fem3DCorotationalTetrahedronBatch::PacketSize);
+
+	// The rotations start as identity
+	for (size_t elementId = 0; elementId < batch.getNumElements(); ++elementId)
+	{
+		EXPECT_TRUE(batch.getRotation(elementId).isIdentity());
+	}
+	EXPECT_THROW(batch.getRotation(m_elements.size()), SurgSim::Framework::AssertionFailure);
+
+	// At rest, there are no forces
+	batch.updateRotations(m_restState);
+	Vector F = Vector::Zero(m_restState.getNumDof());
+	batch.addForce(m_restState, &F);
+	EXPECT_TRUE(F.isZero(epsilon));
+}
+
+TEST_F(Fem3DCorotationalTetrahedronBatchTests, RotationTest)
+{
+	Fem3DCorotationalTetrahedronBatch batch;
+	batch.initialize(m_elements, m_restState);
+	batch.updateRotations(m_state);
+
+	for (size_t elementId = 0; elementId < m_elements.size(); ++elementId)
+	{
+		m_elements[elementId]->updateFMDK(m_state, SurgSim::Math::ODEEQUATIONUPDATE_F);
+		EXPECT_TRUE(batch.getRotation(elementId).isApprox(m_elements[elementId]->getRotationMatrix(), 1e-6)) <<
+			"Element " << elementId << std::endl << batch.getRotation(elementId) << std::endl <<
+			m_elements[elementId]->getRotationMatrix();
+	}
+
+	// The iterations are warm started, a second call converges right away
+	batch.setMaxRotationIterations(1);
+	batch.updateRotations(m_state);
+	for (size_t elementId = 0; elementId < m_elements.size(); ++elementId)
+	{
+		EXPECT_TRUE(batch.getRotation(elementId).isApprox(m_elements[elementId]->getRotationMatrix(), 1e-6));
+	}
+}
+
+TEST_F(Fem3DCorotationalTetrahedronBatchTests, RigidMotionTest)
+{
+	Fem3DCorotationalTetrahedronBatch batch;
+	batch.initialize(m_elements, m_restState);
+
+	SurgSim::Math::OdeState state(m_restState);
+	for (size_t nodeId = 0; nodeId < state.getNumNodes(); ++nodeId)
+	{
+		state.getPositions().segment<3>(3 * nodeId) = m_rotation * m_restState.getPosition(nodeId) +
+				Vector3d(1.0, 2.0, 3.0);
+	}
+	batch.updateRotations(state);
+
+	for (size_t elementId = 0; elementId < m_elements.size(); ++elementId)
+	{
+		EXPECT_TRUE(batch.getRotation(elementId).isApprox(m_rotation, 1e-8));
+	}
+	Vector F = Vector::Zero(state.getNumDof());
+	batch.addForce(state, &F);
+	EXPECT_TRUE(F.isZero(1e-6));
+}
+
+TEST_F(Fem3DCorotationalTetrahedronBatchTests, AddForceTest)
+{
+	Fem3DCorotationalTetrahedronBatch batch;
+	batch.initialize(m_elements, m_restState);
+	batch.updateRotations(m_state);
+
+	Vector expectedF = Vector::Zero(m_state.getNumDof());
+	for (auto& element : m_elements)
+	{
+		element->updateFMDK(m_state, SurgSim::Math::ODEEQUATIONUPDATE_F);
+		element->addForce(&expectedF, 0.5);
+	}
+	ASSERT_FALSE(expectedF.isZero());
+
+	Vector F = Vector::Ones(m_state.getNumDof());
+	batch.addForce(m_state, &F, 0.5);
+	EXPECT_TRUE((F - Vector::Ones(m_state.getNumDof())).isApprox(expectedF, epsilon));
+}
+
+TEST_F(Fem3DCorotationalTetrahedronBatchTests, AddMatVecTest)
+{
+	Fem3DCorotationalTetrahedronBatch batch;
+	batch.initialize(m_elements, m_restState);
+	batch.updateRotations(m_state);
+
+	Vector x = Vector::LinSpaced(m_state.getNumDof(), -1.0, 2.0);
+	Vector expected = Vector::Zero(m_state.getNumDof());
+	for (auto& element : m_elements)
+	{
+		element->updateFMDK(m_state, SurgSim::Math::ODEEQUATIONUPDATE_F);
+		Eigen::Matrix<double, 12, 12> R = Eigen::Matrix<double, 12, 12>::Zero();
+		Eigen::Matrix<double, 12, 1> xElement;
+		for (size_t node = 0; node < 4; ++node)
+		{
+			R.block<3, 3>(3 * node, 3 * node) = element->getRotationMatrix();
+			xElement.segment<3>(3 * node) = x.segment<3>(3 * element->getNodeId(node));
+		}
+		Eigen::Matrix<double, 12, 1> result = R * element->getLinearStiffnessMatrix() * R.transpose() * xElement;
+		for (size_t node = 0; node < 4; ++node)
+		{
+			expected.segment<3>(3 * element->getNodeId(node)) += -2.0 * result.segment<3>(3 * node);
+		}
+	}
+
+	Vector F = Vector::Zero(m_state.getNumDof());
+	batch.addMatVec(-2.0, x, &F);
+	EXPECT_TRUE(F.isApprox(expected, epsilon));
+}
+
+}; // namespace Physics
+
+}; // namespace SurgSim
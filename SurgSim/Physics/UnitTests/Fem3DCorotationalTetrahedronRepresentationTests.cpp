@@ -18,10 +18,13 @@
 
 #include <gtest/gtest.h>
 
+#include <boost/thread.hpp>
+
 #include "SurgSim/DataStructures/Location.h"
 #include "SurgSim/Framework/ApplicationData.h"
 #include "SurgSim/Framework/Runtime.h" ///< Used to initialize the Component Fem3DCorotationalTetrahedronRepresentation
 #include "SurgSim/Math/MeshShape.h"
+#include "SurgSim/Math/OdeSolver.h"
 #include "SurgSim/Math/OdeState.h"
 #include "SurgSim/Math/Quaternion.h"
 #include "SurgSim/Math/RigidTransform.h"
@@ -667,6 +670,105 @@ TEST_F(Fem3DCorotationalTetrahedronRepresentationTests, NodeTransformationTest)
 	}
 }
 
+TEST_F(Fem3DCorotationalTetrahedronRepresentationTests, ElementBatchingTest)
+{
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+	auto fem = std::make_shared<MockFem3DCorotationalTetrahedronRepresentation>("Elements");
+	auto batchedFem = std::make_shared<MockFem3DCorotationalTetrahedronRepresentation>("Batched");
+
+	EXPECT_FALSE(batchedFem->getElementBatching());
+	batchedFem->setElementBatching(true);
+	EXPECT_TRUE(batchedFem->getElementBatching());
+	EXPECT_TRUE(batchedFem->getValue<bool>("ElementBatching"));
+
+	for (auto& representation : {fem, batchedFem})
+	{
+		representation->loadFem("PlyReaderTests/Tetrahedron.ply");
+		representation->setRayleighDampingStiffness(0.0);
+		ASSERT_TRUE(representation->initialize(runtime));
+	}
+	EXPECT_ANY_THROW(batchedFem->setElementBatching(false));
+
+	// Rotate and stretch the rest state
+	SurgSim::Math::OdeState state(*fem->getInitialState());
+	const SurgSim::Math::Matrix33d rotation =
+		SurgSim::Math::makeRotationMatrix(0.4, SurgSim::Math::Vector3d(1.0, 2.0, 3.0).normalized());
+	for (size_t nodeId = 0; nodeId < state.getNumNodes(); ++nodeId)
+	{
+		SurgSim::Math::Vector3d position = state.getPosition(nodeId);
+		position[0] *= 1.0 + 0.1 * position[1];
+		state.getPositions().segment<3>(3 * nodeId) = rotation * position;
+	}
+
+	{
+		SCOPED_TRACE("The forces are computed by the batch");
+		fem->updateFMDK(state, SurgSim::Math::ODEEQUATIONUPDATE_F);
+		batchedFem->updateFMDK(state, SurgSim::Math::ODEEQUATIONUPDATE_F);
+		EXPECT_TRUE(fem->getF().isApprox(batchedFem->getF(), 1e-8));
+		EXPECT_FALSE(fem->getF().isZero());
+
+		*fem->getCurrentState() = state;
+		*batchedFem->getCurrentState() = state;
+		for (size_t nodeId = 0; nodeId < state.getNumNodes(); ++nodeId)
+		{
+			EXPECT_TRUE(fem->getTransformation(nodeId).isApprox(batchedFem->getTransformation(nodeId), 1e-8));
+		}
+	}
+
+	{
+		SCOPED_TRACE("The stiffness updates go through the elements");
+		fem->updateFMDK(state, SurgSim::Math::ODEEQUATIONUPDATE_FMDK);
+		batchedFem->updateFMDK(state, SurgSim::Math::ODEEQUATIONUPDATE_FMDK);
+		EXPECT_TRUE(fem->getF().isApprox(batchedFem->getF()));
+		EXPECT_TRUE(fem->getK().isApprox(batchedFem->getK()));
+	}
+}
+
+TEST_F(Fem3DCorotationalTetrahedronRepresentationTests, AsynchronousComplianceWarpingTest)
+{
+	auto runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+	auto fem = std::make_shared<MockFem3DCorotationalTetrahedronRepresentation>("Synchronous");
+	auto asynchronousFem = std::make_shared<MockFem3DCorotationalTetrahedronRepresentation>("Asynchronous");
+	asynchronousFem->setComplianceWarpingSynchronous(false);
+
+	for (auto& representation : {fem, asynchronousFem})
+	{
+		representation->setComplianceWarping(true);
+		representation->setIntegrationScheme(SurgSim::Math::INTEGRATIONSCHEME_LINEAR_EULER_IMPLICIT);
+		representation->loadFem("PlyReaderTests/Tetrahedron.ply");
+		ASSERT_TRUE(representation->initialize(runtime));
+		ASSERT_TRUE(representation->wakeUp());
+		representation->update(1e-3);
+	}
+	EXPECT_TRUE(fem->getComplianceMatrix().isApprox(asynchronousFem->getComplianceMatrix()));
+
+	auto warp = [](MockFem3DCorotationalTetrahedronRepresentation* representation, const SurgSim::Math::OdeState& state)
+	{
+		representation->updateFMDK(state, SurgSim::Math::ODEEQUATIONUPDATE_F);
+		representation->updateComplianceMatrix(state);
+	};
+
+	// The asynchronous matrix catches up after a few updates, whether the rotation changes once or repeatedly
+	for (double angle : {0.4, 0.9})
+	{
+		SurgSim::Math::OdeState state(*fem->getInitialState());
+		const SurgSim::Math::Matrix33d rotation =
+			SurgSim::Math::makeRotationMatrix(angle, SurgSim::Math::Vector3d(1.0, 2.0, 3.0).normalized());
+		for (size_t nodeId = 0; nodeId < state.getNumNodes(); ++nodeId)
+		{
+			state.getPositions().segment<3>(3 * nodeId) = rotation * state.getPosition(nodeId);
+		}
+
+		warp(fem.get(), state);
+		for (int update = 0; update < 3; ++update)
+		{
+			warp(asynchronousFem.get(), state);
+			boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+		}
+		EXPECT_FALSE(fem->getComplianceMatrix().isApprox(fem->getOdeSolver()->getComplianceMatrix()));
+		EXPECT_TRUE(fem->getComplianceMatrix().isApprox(asynchronousFem->getComplianceMatrix()));
+	}
+}
 
 } // namespace Physics
 } // namespace SurgSim
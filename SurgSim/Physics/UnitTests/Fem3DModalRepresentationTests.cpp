@@ -0,0 +1,261 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <Eigen/Eigenvalues>
+
+#include "SurgSim/DataStructures/BinaryCache.h"
+#include "SurgSim/Framework/ApplicationData.h"
+#include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Math/OdeState.h"
+#include "SurgSim/Math/Vector.h"
+#include "SurgSim/Physics/Fem3DModalRepresentation.h"
+#include "SurgSim/Physics/Fem3DRepresentation.h"
+
+using SurgSim::Math::Matrix;
+using SurgSim::Math::Vector;
+
+namespace
+{
+
+/// Remove the rows and columns of the boundary conditions from a square matrix
+Matrix removeBoundaryConditions(const Matrix& matrix, const std::vector<size_t>& boundaryConditions)
+{
+	std::vector<Eigen::Index> freeDofs;
+	for (Eigen::Index dof = 0; dof < matrix.rows(); ++dof)
+	{
+		if (std::find(boundaryConditions.begin(), boundaryConditions.end(), static_cast<size_t>(dof)) ==
+			boundaryConditions.end())
+		{
+			freeDofs.push_back(dof);
+		}
+	}
+
+	Matrix result(freeDofs.size(), freeDofs.size());
+	for (size_t row = 0; row < freeDofs.size(); ++row)
+	{
+		for (size_t col = 0; col < freeDofs.size(); ++col)
+		{
+			result(row, col) = matrix(freeDofs[row], freeDofs[col]);
+		}
+	}
+	return result;
+}
+
+}
+
+namespace SurgSim
+{
+
+namespace Physics
+{
+
+class Fem3DModalRepresentationTests : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		m_runtime = std::make_shared<SurgSim::Framework::Runtime>("config.txt");
+		m_isCacheEnabled = SurgSim::DataStructures::isBinaryCacheEnabled();
+		SurgSim::DataStructures::setBinaryCacheEnabled(false);
+	}
+
+	void TearDown() override
+	{
+		SurgSim::DataStructures::setBinaryCacheEnabled(m_isCacheEnabled);
+	}
+
+	std::shared_ptr<Fem3DModalRepresentation> createModalFem(size_t numModes)
+	{
+		auto fem = std::make_shared<Fem3DModalRepresentation>("Modal");
+		fem->loadFem("PlyReaderTests/Tetrahedron.ply");
+		fem->setNumModes(numModes);
+		return fem;
+	}
+
+protected:
+	std::shared_ptr<SurgSim::Framework::Runtime> m_runtime;
+	bool m_isCacheEnabled;
+};
+
+TEST_F(Fem3DModalRepresentationTests, SetGetTest)
+{
+	auto fem = std::make_shared<Fem3DModalRepresentation>("Modal");
+	EXPECT_EQ(30u, fem->getNumModes());
+	fem->setNumModes(12);
+	EXPECT_EQ(12u, fem->getNumModes());
+	EXPECT_EQ(12u, fem->getValue<size_t>("NumModes"));
+	EXPECT_THROW(fem->setNumModes(0), SurgSim::Framework::AssertionFailure);
+}
+
+TEST_F(Fem3DModalRepresentationTests, ModesTest)
+{
+	const size_t numModes = 10;
+	auto fem = createModalFem(numModes);
+	ASSERT_TRUE(fem->initialize(m_runtime));
+
+	const Matrix& modes = fem->getModalBasis();
+	const Vector& eigenvalues = fem->getModalEigenvalues();
+	ASSERT_EQ(static_cast<Eigen::Index>(fem->getNumDof()), modes.rows());
+	ASSERT_EQ(static_cast<Eigen::Index>(numModes), modes.cols());
+	ASSERT_EQ(static_cast<Eigen::Index>(numModes), eigenvalues.size());
+
+	// The modes are mass orthonormal and diagonalize the stiffness
+	Matrix M = fem->getM();
+	Matrix K = fem->getK();
+	EXPECT_TRUE((modes.transpose() * M * modes).isApprox(Matrix::Identity(numModes, numModes), 1e-8));
+	Matrix reducedK = modes.transpose() * K * modes;
+	EXPECT_TRUE(reducedK.isApprox(Matrix(eigenvalues.asDiagonal()), 1e-6));
+
+	// The modes do not move the boundary conditions
+	for (auto dof : fem->getInitialState()->getBoundaryConditions())
+	{
+		EXPECT_TRUE(modes.row(dof).isZero());
+	}
+
+	// They are the lowest modes of the fem
+	const auto& boundaryConditions = fem->getInitialState()->getBoundaryConditions();
+	Eigen::GeneralizedSelfAdjointEigenSolver<Matrix> solver(removeBoundaryConditions(K, boundaryConditions),
+															removeBoundaryConditions(M, boundaryConditions));
+	for (size_t mode = 0; mode < numModes; ++mode)
+	{
+		EXPECT_NEAR(solver.eigenvalues()[mode], eigenvalues[mode], 1e-6 * solver.eigenvalues()[mode]);
+	}
+}
+
+TEST_F(Fem3DModalRepresentationTests, TooManyModesTest)
+{
+	auto fem = createModalFem(1000);
+	EXPECT_THROW(fem->initialize(m_runtime), SurgSim::Framework::AssertionFailure);
+}
+
+TEST_F(Fem3DModalRepresentationTests, FullBasisMatchesFullFemTest)
+{
+	const double dt = 1e-3;
+
+	auto full = std::make_shared<Fem3DRepresentation>("Full");
+	full->loadFem("PlyReaderTests/Tetrahedron.ply");
+	full->setIntegrationScheme(SurgSim::Math::INTEGRATIONSCHEME_LINEAR_EULER_IMPLICIT);
+	ASSERT_TRUE(full->initialize(m_runtime));
+	ASSERT_TRUE(full->wakeUp());
+
+	// With as many modes as free dofs, the modal fem spans the complete space and gives the same results
+	const size_t numFreeDof = full->getNumDof() - full->getInitialState()->getNumBoundaryConditions();
+	auto modal = createModalFem(numFreeDof);
+	ASSERT_TRUE(modal->initialize(m_runtime));
+	ASSERT_TRUE(modal->wakeUp());
+
+	const Vector& initialPositions = full->getInitialState()->getPositions();
+	for (int step = 0; step < 5; ++step)
+	{
+		full->beforeUpdate(dt);
+		full->update(dt);
+		full->afterUpdate(dt);
+		modal->beforeUpdate(dt);
+		modal->update(dt);
+		modal->afterUpdate(dt);
+
+		Vector fullDisplacement = full->getCurrentState()->getPositions() - initialPositions;
+		Vector modalDisplacement = modal->getCurrentState()->getPositions() - initialPositions;
+		ASSERT_LT(0.0, fullDisplacement.norm());
+		EXPECT_TRUE(modalDisplacement.isApprox(fullDisplacement, 1e-6));
+		EXPECT_TRUE(modal->getCurrentState()->getVelocities().isApprox(full->getCurrentState()->getVelocities(),
+					1e-6));
+	}
+
+	const auto& boundaryConditions = full->getInitialState()->getBoundaryConditions();
+	Matrix fullCompliance = removeBoundaryConditions(full->getComplianceMatrix(), boundaryConditions);
+	Matrix modalCompliance = removeBoundaryConditions(modal->getComplianceMatrix(), boundaryConditions);
+	EXPECT_TRUE(modalCompliance.isApprox(fullCompliance, 1e-6));
+
+	Matrix b = Matrix::Identity(modal->getNumDof(), 3);
+	EXPECT_TRUE(modal->applyCompliance(*modal->getCurrentState(), b).isApprox(modal->getComplianceMatrix() * b));
+}
+
+TEST_F(Fem3DModalRepresentationTests, CorrectionTest)
+{
+	const double dt = 1e-3;
+	auto fem = createModalFem(10);
+	ASSERT_TRUE(fem->initialize(m_runtime));
+	ASSERT_TRUE(fem->wakeUp());
+	fem->setIsGravityEnabled(false);
+	fem->update(dt);
+
+	// A correction coming from the compliance is represented exactly by the modes
+	Vector force = Vector::Zero(fem->getNumDof());
+	force[0] = 1.0;
+	Vector deltaVelocity = fem->getComplianceMatrix() * force;
+	Vector positions = fem->getCurrentState()->getPositions();
+	Vector velocities = fem->getCurrentState()->getVelocities();
+	Vector correction = deltaVelocity;
+	fem->applyCorrection(dt, correction.segment(0, correction.size()));
+
+	EXPECT_TRUE(fem->getCurrentState()->getVelocities().isApprox(velocities + deltaVelocity));
+	EXPECT_TRUE(fem->getCurrentState()->getPositions().isApprox(positions + dt * deltaVelocity));
+
+	fem->resetState();
+	EXPECT_TRUE(fem->getModalCoordinates().isZero());
+	EXPECT_TRUE(fem->getCurrentState()->getPositions().isApprox(fem->getInitialState()->getPositions()));
+}
+
+TEST_F(Fem3DModalRepresentationTests, CachedModesCorrectionTest)
+{
+	const double dt = 1e-3;
+	const std::string directory = "Fem3DModalRepresentationTestsCache";
+	SurgSim::DataStructures::setBinaryCacheEnabled(true);
+	SurgSim::DataStructures::setBinaryCacheDirectory(directory);
+
+	// The first fem computes the modes and writes the cache, the second one reads them from the cache
+	auto computed = createModalFem(10);
+	ASSERT_TRUE(computed->initialize(m_runtime));
+	const std::string path =
+		SurgSim::Framework::Runtime::getApplicationData()->findFile("PlyReaderTests/Tetrahedron.ply");
+	EXPECT_TRUE(boost::filesystem::exists(
+					SurgSim::DataStructures::getBinaryCacheFileName(path, computed->getClassName())));
+	auto cached = createModalFem(10);
+	ASSERT_TRUE(cached->initialize(m_runtime));
+
+	SurgSim::DataStructures::setBinaryCacheDirectory("");
+	boost::filesystem::remove_all(directory);
+
+	ASSERT_TRUE(computed->getModalBasis().isApprox(cached->getModalBasis()));
+	ASSERT_TRUE(computed->getM().isApprox(cached->getM()));
+
+	// The corrections of the fem restored from the cache are not dropped
+	for (auto& fem : {computed, cached})
+	{
+		ASSERT_TRUE(fem->wakeUp());
+		fem->setIsGravityEnabled(false);
+		fem->update(dt);
+	}
+	Vector force = Vector::Zero(cached->getNumDof());
+	force[0] = 1.0;
+	Vector correction = cached->getComplianceMatrix() * force;
+	const Vector modalVelocities = cached->getModalVelocities();
+	computed->applyCorrection(dt, correction.segment(0, correction.size()));
+	cached->applyCorrection(dt, correction.segment(0, correction.size()));
+
+	EXPECT_FALSE(cached->getModalVelocities().isApprox(modalVelocities));
+	EXPECT_TRUE(cached->getModalVelocities().isApprox(computed->getModalVelocities()));
+}
+
+}; // namespace Physics
+
+}; // namespace SurgSim
@@ -526,6 +526,56 @@ TEST_F(FemRepresentationTests, ComplianceWarpingTest)
 	}
 }
 
+TEST_F(FemRepresentationTests, ComplianceWarpingStatisticsTest)
+{
+	auto fem = std::make_shared<MockFemRepresentationValidComplianceWarping>("fem");
+	fem->setComplianceWarping(true);
+
+	EXPECT_DOUBLE_EQ(0.0, fem->getComplianceWarpingThreshold());
+	EXPECT_THROW(fem->setComplianceWarpingThreshold(-0.1), SurgSim::Framework::AssertionFailure);
+	EXPECT_NO_THROW(fem->setComplianceWarpingThreshold(0.01));
+	EXPECT_DOUBLE_EQ(0.01, fem->getComplianceWarpingThreshold());
+
+	auto initialState = std::make_shared<SurgSim::Math::OdeState>();
+	initialState->setNumDof(fem->getNumDofPerNode(), 3);
+	fem->setInitialState(initialState);
+
+	std::shared_ptr<MockFemElement> element = std::make_shared<MockFemElement>();
+	element->setMassDensity(m_rho);
+	element->setPoissonRatio(m_nu);
+	element->setYoungModulus(m_E);
+	element->addNode(0);
+	element->addNode(1);
+	element->addNode(2);
+	fem->addFemElement(element);
+
+	fem->initialize(std::make_shared<SurgSim::Framework::Runtime>());
+	fem->wakeUp();
+
+	EXPECT_EQ(0u, fem->getComplianceWarpingStatistics().numUpdates);
+
+	// The first update warps the blocks of all the nodes
+	ASSERT_NO_THROW(fem->update(1e-3));
+	auto statistics = fem->getComplianceWarpingStatistics();
+	EXPECT_EQ(1u, statistics.numUpdates);
+	EXPECT_EQ(3u, statistics.numNodesUpdated);
+	EXPECT_EQ(3u, statistics.numNodesUpdatedTotal);
+	EXPECT_EQ(0u, statistics.staleUpdates);
+	EXPECT_DOUBLE_EQ(0.0, statistics.maxRotationError);
+	Matrix compliance = fem->applyCompliance(*initialState,
+						Matrix::Identity(initialState->getNumDof(), initialState->getNumDof()));
+
+	// The node transformations did not change, no block needs to be recomputed
+	ASSERT_NO_THROW(fem->update(1e-3));
+	statistics = fem->getComplianceWarpingStatistics();
+	EXPECT_EQ(2u, statistics.numUpdates);
+	EXPECT_EQ(0u, statistics.numNodesUpdated);
+	EXPECT_EQ(3u, statistics.numNodesUpdatedTotal);
+	EXPECT_LE(statistics.lastUpdateDuration, statistics.totalUpdateDuration);
+	EXPECT_TRUE(compliance.isApprox(fem->applyCompliance(*initialState,
+									Matrix::Identity(initialState->getNumDof(), initialState->getNumDof()))));
+}
+
 TEST_F(FemRepresentationTests, MassLumpingTest)
 {
 		SCOPED_TRACE("MockFemRepresentation complete for compliance warping");
@@ -574,6 +624,10 @@ TEST_F(FemRepresentationTests, SerializationTest)
 	EXPECT_FALSE(fem->getComplianceWarping());
 	EXPECT_FALSE(fem->getValue<bool>("ComplianceWarping"));
 
+	EXPECT_NO_THROW(fem->setValue("ComplianceWarpingThreshold", 0.05));
+	EXPECT_DOUBLE_EQ(0.05, fem->getComplianceWarpingThreshold());
+	EXPECT_DOUBLE_EQ(0.05, fem->getValue<double>("ComplianceWarpingThreshold"));
+
 	EXPECT_NO_THROW(fem->setValue("RayleighDampingMass", 1.1));
 	EXPECT_NO_THROW(fem->getValue<double>("RayleighDampingMass"));
 	EXPECT_DOUBLE_EQ(1.1, fem->getValue<double>("RayleighDampingMass"));
@@ -351,6 +351,8 @@ class MockFem3DCorotationalTetrahedronRepresentation
 	explicit MockFem3DCorotationalTetrahedronRepresentation(const std::string& name);
 
 	SurgSim::Math::Matrix getTransformation(size_t nodeId);
+
+	using Fem3DCorotationalTetrahedronRepresentation::updateComplianceMatrix;
 };
 
 class MockFixedConstraintFixedPoint : public ConstraintImplementation
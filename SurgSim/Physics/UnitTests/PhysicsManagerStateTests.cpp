@@ -132,6 +132,34 @@ TEST(PhysicsManagerStateTest, SetGetActiveRepresentations)
 	EXPECT_EQ(rigid2, actualRepresentations.back());
 }
 
+TEST(PhysicsManagerStateTest, SetGetProxyRepresentations)
+{
+	auto physicsState = std::make_shared<PhysicsManagerState>();
+	EXPECT_TRUE(physicsState->getProxyRepresentations().empty());
+
+	auto rigid1 = std::make_shared<RigidRepresentation>("rigid1");
+	auto collision1 = std::make_shared<SurgSim::Physics::RigidCollisionRepresentation>("rigid1 collision");
+	rigid1->setCollisionRepresentation(collision1);
+	auto rigid2 = std::make_shared<RigidRepresentation>("rigid2");
+	auto collision2 = std::make_shared<SurgSim::Physics::RigidCollisionRepresentation>("rigid2 collision");
+	rigid2->setCollisionRepresentation(collision2);
+
+	std::vector<std::shared_ptr<Representation>> representations(1, rigid1);
+	std::vector<std::shared_ptr<Representation>> proxies(1, rigid2);
+	physicsState->setRepresentations(representations);
+	physicsState->setProxyRepresentations(proxies);
+
+	ASSERT_EQ(1u, physicsState->getProxyRepresentations().size());
+	EXPECT_EQ(rigid2, physicsState->getProxyRepresentations().back());
+	ASSERT_EQ(1u, physicsState->getRepresentations().size());
+
+	// The collision representations of the proxies are mapped too
+	const auto& collisionsToPhysicsMap = physicsState->getCollisionToPhysicsMap();
+	ASSERT_EQ(2u, collisionsToPhysicsMap.size());
+	EXPECT_EQ(rigid1, collisionsToPhysicsMap.at(collision1));
+	EXPECT_EQ(rigid2, collisionsToPhysicsMap.at(collision2));
+}
+
 TEST(PhysicsManagerStateTest, SetGetCollisionRepresentations)
 {
 	auto physicsState = std::make_shared<PhysicsManagerState>();
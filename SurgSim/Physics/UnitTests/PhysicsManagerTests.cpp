@@ -26,14 +26,20 @@
 #include <memory>
 
 #include "SurgSim/Collision/ShapeCollisionRepresentation.h"
+#include "SurgSim/Framework/BasicSceneElement.h"
 #include "SurgSim/Framework/Runtime.h"
+#include "SurgSim/Framework/Scene.h"
 #include "SurgSim/Particles/SphRepresentation.h"
 #include "SurgSim/Physics/ConstraintComponent.h"
+#include "SurgSim/Physics/DcdCollision.h"
 #include "SurgSim/Physics/DeformableCollisionRepresentation.h"
 #include "SurgSim/Physics/PhysicsManager.h"
+#include "SurgSim/Physics/PrepareCollisionPairs.h"
 #include "SurgSim/Physics/Representation.h"
 #include "SurgSim/Physics/FixedRepresentation.h"
 #include "SurgSim/Physics/UnitTests/MockObjects.h"
+#include "SurgSim/Math/RigidTransform.h"
+#include "SurgSim/Math/SphereShape.h"
 #include "SurgSim/Math/Vector.h"
 
 using SurgSim::Framework::Runtime;
@@ -87,6 +93,11 @@ class PhysicsManagerTest : public ::testing::Test
 		return physicsManager->executeRemovals(component);
 	}
 
+	bool testDoUpdate(double dt)
+	{
+		return physicsManager->doUpdate(dt);
+	}
+
 	std::shared_ptr<PhysicsManager> physicsManager;
 };
 
@@ -183,6 +194,69 @@ TEST_F(PhysicsManagerTest, SetComputations)
 	EXPECT_ANY_THROW(physicsManager->setComputations(createDcdPipeline()));
 }
 
+TEST_F(PhysicsManagerTest, ContactCaching)
+{
+	auto sphere1 = std::make_shared<Collision::ShapeCollisionRepresentation>("Sphere1");
+	sphere1->setShape(std::make_shared<Math::SphereShape>(1.0));
+	auto sphere2 = std::make_shared<Collision::ShapeCollisionRepresentation>("Sphere2");
+	sphere2->setShape(std::make_shared<Math::SphereShape>(1.0));
+	sphere2->setLocalPose(Math::makeRigidTranslation(Vector3d(0.0, 0.0, 0.5)));
+	auto runtime = std::make_shared<Runtime>();
+	auto element = std::make_shared<Framework::BasicSceneElement>("Element");
+	element->addComponent(sphere1);
+	element->addComponent(sphere2);
+	runtime->getScene()->addSceneElement(element);
+
+	auto dcdCollision = std::make_shared<DcdCollision>();
+	physicsManager->addComputation(std::make_shared<PrepareCollisionPairs>());
+	physicsManager->addComputation(dcdCollision);
+	EXPECT_TRUE(testDoAddComponent(sphere1));
+	EXPECT_TRUE(testDoAddComponent(sphere2));
+
+	EXPECT_FALSE(physicsManager->isContactCachingEnabled());
+	EXPECT_TRUE(testDoUpdate(1e-3));
+	EXPECT_TRUE(testDoUpdate(1e-3));
+	EXPECT_DOUBLE_EQ(0.0, physicsManager->getSkippedPairsFraction());
+
+	physicsManager->setContactCachingEnabled(true);
+	EXPECT_TRUE(physicsManager->isContactCachingEnabled());
+	EXPECT_TRUE(dcdCollision->isContactCachingEnabled());
+	EXPECT_TRUE(testDoUpdate(1e-3));
+	EXPECT_TRUE(testDoUpdate(1e-3));
+	EXPECT_DOUBLE_EQ(1.0, physicsManager->getSkippedPairsFraction());
+
+	physicsManager->setContactCachingEnabled(false);
+	EXPECT_FALSE(dcdCollision->isContactCachingEnabled());
+	EXPECT_TRUE(testDoUpdate(1e-3));
+	EXPECT_DOUBLE_EQ(0.0, physicsManager->getSkippedPairsFraction());
+}
+
+TEST_F(PhysicsManagerTest, RateDivider)
+{
+	auto representation1 = std::make_shared<FixedRepresentation>("Rep1");
+	auto representation2 = std::make_shared<FixedRepresentation>("Rep2");
+	representation2->setRateDivider(4);
+	physicsManager->setComputations(createDcdPipeline());
+	EXPECT_TRUE(testDoAddComponent(representation1));
+	EXPECT_TRUE(testDoAddComponent(representation2));
+
+	// The final state covers the representations of all the rate groups
+	PhysicsManagerState state;
+	for (int i = 0; i < 5; ++i)
+	{
+		EXPECT_TRUE(testDoUpdate(1e-3));
+		physicsManager->getFinalState(&state);
+		EXPECT_EQ(2u, state.getRepresentations().size());
+		EXPECT_TRUE(state.getProxyRepresentations().empty());
+	}
+
+	EXPECT_TRUE(testDoRemoveComponent(representation2));
+	EXPECT_TRUE(testDoUpdate(1e-3));
+	physicsManager->getFinalState(&state);
+	ASSERT_EQ(1u, state.getRepresentations().size());
+	EXPECT_EQ(representation1, state.getRepresentations().front());
+}
+
 TEST_F(PhysicsManagerTest, RunCcd)
 {
 	std::shared_ptr<Runtime> runtime = std::make_shared<Runtime>();
@@ -28,6 +28,8 @@
 #include "SurgSim/Math/Quaternion.h"
 #include "SurgSim/Physics/PhysicsManagerState.h"
 #include "SurgSim/Physics/PrepareCollisionPairs.h"
+#include "SurgSim/Physics/Representation.h"
+#include "SurgSim/Physics/UnitTests/MockObjects.h"
 
 using SurgSim::Math::Vector3d;
 
@@ -213,5 +215,75 @@ TEST_F(PrepareCollisionPairsTest, SingleSelfCollisionPair)
 	ASSERT_EQ(1u, newState->getCollisionPairs().size());
 }
 
+TEST_F(PrepareCollisionPairsTest, PersistentPairs)
+{
+	sphere2->setPose(Math::makeRigidTransform(Math::Quaterniond::Identity(), Vector3d(0.0, 0.0, 0.5)));
+
+	prepareState();
+	ASSERT_EQ(1u, state->getCollisionPairs().size());
+	auto pair = state->getCollisionPairs()[0];
+	pair->addDcdContact(0.1, Vector3d::UnitX(), std::make_pair(DataStructures::Location(Vector3d::Zero()),
+						DataStructures::Location(Vector3d::Zero())));
+
+	// The pair is kept across the updates, without its contacts
+	std::shared_ptr<PhysicsManagerState> newState = computation->update(1.0, state);
+	ASSERT_EQ(1u, newState->getCollisionPairs().size());
+	EXPECT_EQ(pair, newState->getCollisionPairs()[0]);
+	EXPECT_FALSE(pair->hasContacts());
+
+	// A change of collision detection type creates a new pair
+	sphere1Collision->setCollisionDetectionType(Collision::COLLISION_DETECTION_TYPE_CONTINUOUS);
+	sphere2Collision->setCollisionDetectionType(Collision::COLLISION_DETECTION_TYPE_CONTINUOUS);
+	newState = computation->update(1.0, newState);
+	ASSERT_EQ(1u, newState->getCollisionPairs().size());
+	EXPECT_NE(pair, newState->getCollisionPairs()[0]);
+	EXPECT_EQ(Collision::COLLISION_DETECTION_TYPE_CONTINUOUS, newState->getCollisionPairs()[0]->getType());
+}
+
+TEST_F(PrepareCollisionPairsTest, RateGroupPairs)
+{
+	sphere2->setPose(Math::makeRigidTransform(Math::Quaterniond::Identity(), Vector3d(0.0, 0.0, 0.5)));
+
+	// The rate divider of the spheres can't be changed once they are initialized, the slow group is led by another
+	// representation
+	auto slowGroup = std::make_shared<MockRepresentation>("SlowGroup");
+	slowGroup->setRateDivider(4);
+
+	auto update = [this, &slowGroup](size_t updated)
+	{
+		auto groupState = std::make_shared<PhysicsManagerState>();
+		std::vector<std::shared_ptr<Representation>> representations;
+		if (updated == 1)
+		{
+			representations.push_back(slowGroup);
+		}
+		representations.push_back(physicsRepresentations[updated]);
+		groupState->setRepresentations(representations);
+		groupState->setProxyRepresentations(std::vector<std::shared_ptr<Representation>>(1,
+											physicsRepresentations[1 - updated]));
+		groupState->setCollisionRepresentations(collisionRepresentations);
+		return computation->update(1.0, groupState);
+	};
+
+	auto slowState = update(1);
+	ASSERT_EQ(1u, slowState->getCollisionPairs().size());
+	auto slowPair = slowState->getCollisionPairs()[0];
+	slowPair->addDcdContact(0.1, Vector3d::UnitX(), std::make_pair(DataStructures::Location(Vector3d::Zero()),
+							DataStructures::Location(Vector3d::Zero())));
+
+	// Each group has its own pairs, the fast group does not clear the contacts of the slow group
+	for (int i = 0; i < 3; ++i)
+	{
+		auto fastState = update(0);
+		ASSERT_EQ(1u, fastState->getCollisionPairs().size());
+		EXPECT_NE(slowPair, fastState->getCollisionPairs()[0]);
+		EXPECT_TRUE(slowPair->hasContacts());
+	}
+
+	slowState = update(1);
+	ASSERT_EQ(1u, slowState->getCollisionPairs().size());
+	EXPECT_EQ(slowPair, slowState->getCollisionPairs()[0]);
+}
+
 };
 };
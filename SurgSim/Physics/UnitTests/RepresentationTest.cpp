@@ -68,6 +68,12 @@ TEST(RepresentationTest, SetGetAndDefaultValueTest)
 	ASSERT_FALSE(representation->isDrivingSceneElementPose());
 	representation->setIsDrivingSceneElementPose(true);
 	ASSERT_TRUE(representation->isDrivingSceneElementPose());
+
+	/// Set/Get rateDivider [default = 1]
+	EXPECT_EQ(1u, representation->getRateDivider());
+	representation->setRateDivider(10);
+	EXPECT_EQ(10u, representation->getRateDivider());
+	EXPECT_THROW(representation->setRateDivider(0), SurgSim::Framework::AssertionFailure);
 }
 
 TEST(RepresentationTest, SetGetCollisionRepresentationTest)
@@ -86,6 +92,7 @@ TEST(RepresentationTest, SerializationTest)
 		std::shared_ptr<Representation> representation = std::make_shared<MockRepresentation>("MockRepresentation");
 		size_t numDof = 1;
 		representation->setValue("NumDof", numDof);
+		representation->setValue("RateDivider", static_cast<size_t>(10));
 
 		YAML::Node node;
 		ASSERT_NO_THROW(node = YAML::convert<SurgSim::Framework::Component>::encode(*representation));
@@ -93,7 +100,7 @@ TEST(RepresentationTest, SerializationTest)
 		EXPECT_EQ(1u, node.size());
 
 		YAML::Node data = node["SurgSim::Physics::MockRepresentation"];
-		EXPECT_EQ(7u, data.size());
+		EXPECT_EQ(8u, data.size());
 
 		std::shared_ptr<MockRepresentation> newRepresentation;
 		ASSERT_NO_THROW(newRepresentation =
@@ -105,6 +112,7 @@ TEST(RepresentationTest, SerializationTest)
 		EXPECT_TRUE(newRepresentation->getValue<bool>("IsGravityEnabled"));
 		EXPECT_TRUE(newRepresentation->getValue<bool>("IsDrivingSceneElementPose"));
 		EXPECT_EQ(1u, newRepresentation->getValue<size_t>("NumDof"));
+		EXPECT_EQ(10u, newRepresentation->getValue<size_t>("RateDivider"));
 	}
 
 	{
@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 
+#include <boost/filesystem.hpp>
 #include <memory>
 #include <string>
 
@@ -40,7 +41,8 @@ TEST(SolveMlcpTest, CanConstruct)
 	ASSERT_NO_THROW({std::shared_ptr<SolveMlcp> solveMlcpComputation = std::make_shared<SolveMlcp>();});
 }
 
-static void testMlcp(const std::string& filename, double contactTolerance, double solverPrecision, size_t maxIteration)
+static void testMlcp(const std::string& filename, double contactTolerance, double solverPrecision, size_t maxIteration,
+					 bool parallel = false, double precision = epsilon)
 {
 	std::shared_ptr<MlcpTestData> data = loadTestData(filename);
 	ASSERT_NE(nullptr, data) << "Could not load data file 'mlcpOriginalTest.txt'";
@@ -56,6 +58,8 @@ static void testMlcp(const std::string& filename, double contactTolerance, doubl
 	EXPECT_NEAR(solverPrecision, solveMlcpComputation->getPrecision(), 1e-10);
 	solveMlcpComputation->setMaxIterations(maxIteration);
 	EXPECT_EQ(maxIteration, solveMlcpComputation->getMaxIterations());
+	solveMlcpComputation->setParallel(parallel);
+	EXPECT_EQ(parallel, solveMlcpComputation->isParallel());
 
 	// Copy the MlcpProblem data over into the input state
 	state->getMlcpProblem().A = data->problem.A;
@@ -71,7 +75,7 @@ static void testMlcp(const std::string& filename, double contactTolerance, doubl
 	state = solveMlcpComputation->update(dt, state);
 
 	// Compare the mlcp solution with the expected one
-	EXPECT_TRUE(state->getMlcpSolution().x.isApprox(data->expectedLambda, epsilon)) <<
+	EXPECT_TRUE(state->getMlcpSolution().x.isApprox(data->expectedLambda, precision)) <<
 		"lambda:" << std::endl << state->getMlcpSolution().x.transpose() << std::endl <<
 		"expected:" << std::endl << data->expectedLambda.transpose() << std::endl;
 }
@@ -92,3 +96,61 @@ TEST(SolveMlcpTest, TestSequenceMlcps)
 		testMlcp(getTestFileName("mlcpTest", i, ".txt"), 1e-9, 1e-9, 100);
 	}
 }
+
+TEST(SolveMlcpTest, TestSequenceMlcpsParallel)
+{
+	// The updates are done in another order, the solutions only match within the precision of the solver
+	for (int i = 1;  i <= 9;  ++i)
+	{
+		std::ostringstream scopeName;
+		scopeName << "Testing Mlcp " << i;
+		SCOPED_TRACE(scopeName.str());
+
+		testMlcp(getTestFileName("mlcpTest", i, ".txt"), 1e-9, 1e-9, 100, true, 1e-6);
+	}
+}
+
+TEST(SolveMlcpTest, Capture)
+{
+	std::shared_ptr<MlcpTestData> data = loadTestData("mlcpOriginalTest.txt");
+	ASSERT_NE(nullptr, data);
+
+	auto solveMlcpComputation = std::make_shared<SolveMlcp>(false);
+	EXPECT_EQ(0u, solveMlcpComputation->getCapturePeriod());
+	solveMlcpComputation->setCapture("SolveMlcpTestCapture", 2);
+	EXPECT_EQ("SolveMlcpTestCapture", solveMlcpComputation->getCapturePrefix());
+	EXPECT_EQ(2u, solveMlcpComputation->getCapturePeriod());
+
+	// Problems without constraints are not counted
+	auto state = std::make_shared<PhysicsManagerState>();
+	state = solveMlcpComputation->update(1e-3, state);
+
+	for (int i = 0; i < 5; ++i)
+	{
+		state->getMlcpProblem().A = data->problem.A;
+		state->getMlcpProblem().b = data->problem.b;
+		state->getMlcpProblem().constraintTypes = data->problem.constraintTypes;
+		state->getMlcpProblem().mu = data->problem.mu;
+		state->getMlcpSolution().x.setZero(data->problem.getSize());
+		state = solveMlcpComputation->update(1e-3, state);
+	}
+
+	for (int i = 0; i < 5; ++i)
+	{
+		const std::string fileName = getTestFileName("SolveMlcpTestCapture000", i, ".mlcp");
+		SCOPED_TRACE(fileName);
+		SurgSim::Math::MlcpProblem problem;
+		if (i % 2 == 0)
+		{
+			ASSERT_TRUE(problem.load(fileName));
+			EXPECT_EQ(data->problem.A, problem.A);
+			EXPECT_EQ(data->problem.b, problem.b);
+			EXPECT_EQ(data->problem.constraintTypes, problem.constraintTypes);
+			boost::filesystem::remove(fileName);
+		}
+		else
+		{
+			EXPECT_FALSE(boost::filesystem::exists(fileName));
+		}
+	}
+}
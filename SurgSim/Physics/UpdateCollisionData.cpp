@@ -19,6 +19,9 @@
 #include "SurgSim/Framework/ThreadPool.h"
 #include "SurgSim/Physics/PhysicsManagerState.h"
 #include "SurgSim/Collision/Representation.h"
+#include "SurgSim/Physics/Representation.h"
+
+#include <unordered_set>
 
 namespace SurgSim
 {
@@ -46,9 +49,20 @@ std::shared_ptr<PhysicsManagerState> UpdateCollisionData::doUpdate(
 
 	auto threadPool = Framework::Runtime::getThreadPool();
 	std::vector<std::future<void>> tasks;
+	// The shape data of the proxy representations is updated with the proxies themselves
+	std::unordered_set<Collision::Representation*> proxies;
+	for (const auto& proxy : result->getProxyRepresentations())
+	{
+		proxies.insert(proxy->getCollisionRepresentation().get());
+	}
+
 	auto& representations = result->getActiveCollisionRepresentations();
 	for (auto& representation : representations)
 	{
+		if (proxies.find(representation.get()) != proxies.end())
+		{
+			continue;
+		}
 		tasks.push_back(threadPool->enqueue<void>([dt, &representation]()
 		{
 			representation->updateShapeData();
@@ -19,6 +19,7 @@
 #include "SurgSim/Framework/ThreadPool.h"
 #include "SurgSim/Physics/PhysicsManagerState.h"
 #include "SurgSim/Collision/Representation.h"
+#include "SurgSim/Physics/Representation.h"
 
 #include <unordered_set>
 
@@ -61,6 +62,12 @@ std::shared_ptr<PhysicsManagerState> UpdateDcdData::doUpdate(
 		}
 	}
 
+	// The data of the proxy representations is updated with the proxies themselves
+	for (const auto& proxy : result->getProxyRepresentations())
+	{
+		representations.erase(proxy->getCollisionRepresentation().get());
+	}
+
 	for (auto representation : representations)
 	{
 		tasks.push_back(threadPool->enqueue<void>([dt, representation]()
@@ -0,0 +1,255 @@
+// This file is a part of the OpenSurgSim project.
+// Copyright 2013-2016, SimQuest Solutions Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file MlcpReplay.cpp
+/// Replays a corpus of MLCP problems captured from live simulations (see Physics::SolveMlcp::setCapture()) through
+/// an MlcpSolver, and reports for each problem its size, the iterations, a solver independent residual and the
+/// solve time, followed by a summary of the corpus. This allows to compare solvers and their settings on the
+/// problems of real scenes.
+/// As in the live simulation, the solver starts from a zero initial guess.
+
+#include <algorithm>
+#include <boost/chrono.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SurgSim/Math/MlcpColoredGaussSeidelSolver.h"
+#include "SurgSim/Math/MlcpGaussSeidelSolver.h"
+#include "SurgSim/Math/MlcpProblem.h"
+#include "SurgSim/Math/MlcpSolution.h"
+#include "SurgSim/Math/MlcpSolver.h"
+
+using SurgSim::Math::MlcpProblem;
+using SurgSim::Math::MlcpSolution;
+using SurgSim::Math::MlcpSolver;
+
+namespace
+{
+
+/// Creates a solver from its precision, contact tolerance and maximum number of iterations
+typedef std::function<std::shared_ptr<MlcpSolver>(double, double, size_t)> SolverFactory;
+
+/// \return The solvers that can be replayed, by name
+std::map<std::string, SolverFactory> getSolverFactories()
+{
+	std::map<std::string, SolverFactory> result;
+	result["GaussSeidel"] = [](double precision, double contactTolerance, size_t maxIterations)
+	{
+		return std::make_shared<SurgSim::Math::MlcpGaussSeidelSolver>(precision, contactTolerance, maxIterations);
+	};
+	result["ColoredGaussSeidel"] = [](double precision, double contactTolerance, size_t maxIterations)
+	{
+		return std::make_shared<SurgSim::Math::MlcpColoredGaussSeidelSolver>(precision, contactTolerance,
+				maxIterations);
+	};
+	return result;
+}
+
+/// Computes a solver independent residual of a solution, the largest violation of the equality conditions of the
+/// bilateral constraints and of the complementarity conditions of the contacts, \f$|min(x_i, c_i)|\f$.
+/// The friction rows are not checked.
+/// \param problem The problem
+/// \param x The solution
+/// \return The residual
+double computeResidual(const MlcpProblem& problem, const MlcpSolution::Vector& x)
+{
+	const MlcpProblem::Vector c = problem.A * x + problem.b;
+	double residual = 0.0;
+	auto bilateral = [&c, &residual](size_t row, size_t numRows)
+	{
+		residual = std::max(residual, c.segment(row, numRows).cwiseAbs().maxCoeff());
+	};
+	auto unilateral = [&c, &x, &residual](size_t row)
+	{
+		residual = std::max(residual, std::abs(std::min(x[row], c[row])));
+	};
+
+	size_t row = 0;
+	for (auto type : problem.constraintTypes)
+	{
+		switch (type)
+		{
+		case SurgSim::Math::MLCP_BILATERAL_1D_CONSTRAINT:
+			bilateral(row, 1);
+			row += 1;
+			break;
+		case SurgSim::Math::MLCP_BILATERAL_2D_CONSTRAINT:
+			bilateral(row, 2);
+			row += 2;
+			break;
+		case SurgSim::Math::MLCP_BILATERAL_3D_CONSTRAINT:
+			bilateral(row, 3);
+			row += 3;
+			break;
+		case SurgSim::Math::MLCP_UNILATERAL_3D_FRICTIONLESS_CONSTRAINT:
+			unilateral(row);
+			row += 1;
+			break;
+		case SurgSim::Math::MLCP_UNILATERAL_3D_FRICTIONAL_CONSTRAINT:
+			unilateral(row);
+			row += 3;
+			break;
+		case SurgSim::Math::MLCP_BILATERAL_FRICTIONLESS_SLIDING_CONSTRAINT:
+			bilateral(row, 2);
+			row += 2;
+			break;
+		case SurgSim::Math::MLCP_BILATERAL_FRICTIONAL_SLIDING_CONSTRAINT:
+			bilateral(row, 2);
+			row += 3;
+			break;
+		default:
+			break;
+		}
+	}
+	return residual;
+}
+
+/// Lists the captured problems, the directories are replaced by the .mlcp files they contain, in order
+std::vector<std::string> listProblems(const std::vector<std::string>& inputs)
+{
+	std::vector<std::string> result;
+	for (const auto& input : inputs)
+	{
+		if (boost::filesystem::is_directory(input))
+		{
+			std::vector<std::string> files;
+			for (boost::filesystem::directory_iterator it(input); it != boost::filesystem::directory_iterator(); ++it)
+			{
+				if (it->path().extension() == ".mlcp")
+				{
+					files.push_back(it->path().string());
+				}
+			}
+			std::sort(files.begin(), files.end());
+			result.insert(result.end(), files.begin(), files.end());
+		}
+		else
+		{
+			result.push_back(input);
+		}
+	}
+	return result;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+	namespace po = boost::program_options;
+
+	const auto factories = getSolverFactories();
+	std::string solverNames;
+	for (const auto& factory : factories)
+	{
+		solverNames += (solverNames.empty() ? "" : ", ") + factory.first;
+	}
+	const SurgSim::Math::MlcpGaussSeidelSolver defaults;
+
+	po::options_description commandLine("Allowed options");
+	commandLine.add_options()("help", "produce help message")
+	("input", po::value<std::vector<std::string>>(), "Captured problems (.mlcp files or directories of them)")
+	("solver", po::value<std::string>()->default_value("GaussSeidel"), ("The solver, one of " + solverNames).c_str())
+	("precision", po::value<double>()->default_value(defaults.getEpsilonConvergence()), "Precision of the solver")
+	("contactTolerance", po::value<double>()->default_value(defaults.getContactTolerance()),
+									"Contact tolerance of the solver")
+	("maxIterations", po::value<size_t>()->default_value(defaults.getMaxIterations()),
+									"Maximum number of iterations of the solver")
+	("repeat", po::value<size_t>()->default_value(1), "Number of solves of each problem, to average the timings");
+
+	po::positional_options_description positional;
+	positional.add("input", -1);
+
+	po::variables_map variables;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(commandLine).positional(positional).run(), variables);
+	}
+	catch (po::error& e)
+	{
+		std::cerr << "ERROR: " << e.what() << std::endl << std::endl;
+		std::cerr << commandLine << std::endl;
+		return 1;
+	}
+
+	if (variables.count("help") || !variables.count("input"))
+	{
+		std::cout << "Usage: MlcpReplay [options] input..." << std::endl << commandLine << std::endl;
+		return 1;
+	}
+
+	auto factory = factories.find(variables["solver"].as<std::string>());
+	if (factory == factories.end())
+	{
+		std::cerr << "ERROR: Unknown solver " << variables["solver"].as<std::string>() << ", the solvers are "
+				  << solverNames << std::endl;
+		return 1;
+	}
+	auto solver = factory->second(variables["precision"].as<double>(), variables["contactTolerance"].as<double>(),
+								  variables["maxIterations"].as<size_t>());
+	const size_t repeat = std::max(variables["repeat"].as<size_t>(), static_cast<size_t>(1));
+
+	std::cout << "file,size,constraints,iterations,converged,residual,time (us)" << std::endl;
+	size_t numProblems = 0, numConverged = 0, totalIterations = 0;
+	double maxResidual = 0.0, totalTime = 0.0;
+	for (const auto& fileName : listProblems(variables["input"].as<std::vector<std::string>>()))
+	{
+		MlcpProblem problem;
+		if (!problem.load(fileName))
+		{
+			std::cerr << "WARNING: Could not read the MLCP problem " << fileName << std::endl;
+			continue;
+		}
+
+		MlcpSolution solution;
+		boost::chrono::duration<double> time(0.0);
+		for (size_t i = 0; i < repeat; ++i)
+		{
+			solution.x.setZero(problem.getSize());
+			auto start = boost::chrono::high_resolution_clock::now();
+			solver->solve(problem, &solution);
+			time += boost::chrono::high_resolution_clock::now() - start;
+		}
+		const double microseconds = 1.0e6 * time.count() / static_cast<double>(repeat);
+		const double residual = computeResidual(problem, solution.x);
+
+		std::cout << fileName << "," << problem.getSize() << "," << problem.constraintTypes.size() << ","
+				  << solution.numIterations << "," << solution.validConvergence << "," << residual << ","
+				  << microseconds << std::endl;
+
+		++numProblems;
+		numConverged += solution.validConvergence ? 1 : 0;
+		totalIterations += solution.numIterations;
+		maxResidual = std::max(maxResidual, residual);
+		totalTime += microseconds;
+	}
+
+	std::cout << std::endl << "Solver: " << factory->first << std::endl;
+	std::cout << "Problems: " << numProblems << ", converged: " << numConverged << std::endl;
+	if (numProblems > 0)
+	{
+		std::cout << "Mean iterations: " << static_cast<double>(totalIterations) / numProblems << std::endl;
+		std::cout << "Max residual: " << maxResidual << std::endl;
+		std::cout << "Total time (us): " << totalTime << ", mean: " << totalTime / numProblems << std::endl;
+	}
+	return (numProblems > 0) ? 0 : 1;
+}